@@ -46,6 +46,31 @@ typedef struct
 	STL_SIGNATURE_T signature;
 } STL_FAILED_TEST_T;
 
+/**
+ * @brief Configuration of an STL context.
+ * @ingroup STL
+ * @struct STL_CONTEXT_CFG_T
+ * @var STL_CONTEXT_CFG_T::rt_routines
+ * Runtime test routines, STL_TOT_RT_ROUTINE per CPU, CPU after CPU.
+ * @var STL_CONTEXT_CFG_T::bt_routines
+ * Boot-time test routines, STL_TOT_BT_ROUTINE per CPU, CPU after CPU.
+ * @var STL_CONTEXT_CFG_T::rt_chunk
+ * Runtime tests executed per call of the chunk-based scheduler.
+ */
+typedef struct
+{
+	const STL_FUNCT_PTR_T *rt_routines;
+	const STL_FUNCT_PTR_T *bt_routines;
+	STL_SIZE_T rt_chunk;
+} STL_CONTEXT_CFG_T;
+
+/**
+ * @brief STL context: results, scheduler cursors and configuration of an independent instance.
+ * The layout is in stl_context.h, which is needed only to allocate contexts.
+ * @ingroup STL
+ */
+typedef struct STL_CONTEXT STL_CONTEXT_T;
+
 /**
  * @brief STL API function declarations.
  * This section contains the function declarations for the STL API.
@@ -95,6 +120,16 @@ STLLIB_PUBLIC void STL_init(STL_ERROR_T *err);
  */
 STLLIB_PUBLIC void STL_deinit(STL_ERROR_T *err);
 
+#if (STL_USE_ISA_DISPATCH > 0u)
+/**
+ * @brief Returns the ISA extensions detected by STL_init.
+ * The runtime routines of SBST_RT are the widest variants that only use these extensions.
+ * @return Mask of the STL_CPU_ISA_* extensions of the CPU port.
+ * @ingroup STL_API
+ */
+STLLIB_PUBLIC STL_ISA_FEATURES_T STL_get_isa_features(void);
+#endif /*STL_USE_ISA_DISPATCH*/
+
 /**
  * @brief Schedules runtime tests for a specific CPU.
  * This function schedules the runtime tests for the specified CPU.
@@ -119,6 +154,45 @@ STLLIB_PUBLIC void STL_schedule_runtime(STL_CPUS cpu, STL_ERROR_T *err);
  */
 STLLIB_PUBLIC void STL_schedule_bootime(STL_CPUS cpu, STL_ERROR_T *err);
 
+/**
+ * @brief Initializes an STL context.
+ * The context is cleared and configured; its results read as not run. The STL itself must have
+ * been initialized with STL_init (the hardware services are shared by all the contexts).
+ * When the software deadline monitor, the trace, the overlay, the throttle, the redundancy or
+ * the synchronized windows are compiled in, their per-CPU state is shared too and only
+ * STL_default_context is accepted (STL_ERROR_CONTEXT otherwise).
+ * @param ctx The context.
+ * @param cfg Configuration, or STL_NULL for the routines SBST_RT/SBST_BT and STL_TEST_CHUNK_SIZE.
+ * @param err Pointer to an STL_ERROR_T variable to store any error.
+ * @ingroup STL_API
+ */
+STLLIB_PUBLIC void STL_context_init(STL_CONTEXT_T *ctx, const STL_CONTEXT_CFG_T *cfg, STL_ERROR_T *err);
+/**
+ * @brief Deinitializes an STL context: its results are cleared.
+ * @param ctx The context.
+ * @param err Pointer to an STL_ERROR_T variable to store any error.
+ * @ingroup STL_API
+ */
+STLLIB_PUBLIC void STL_context_deinit(STL_CONTEXT_T *ctx, STL_ERROR_T *err);
+/**
+ * @brief Schedules the runtime tests of a CPU in a context (see STL_schedule_runtime).
+ * The custom scheduler (STL_SCHEDULER_TYPE 2) has no context: only STL_default_context is
+ * accepted with it (STL_ERROR_CONTEXT otherwise).
+ * @param ctx The context.
+ * @param cpu The CPU for which the runtime tests are to be scheduled.
+ * @param err Pointer to an STL_ERROR_T variable to store any error that occurs during scheduling.
+ * @ingroup STL_API
+ */
+STLLIB_PUBLIC void STL_ctx_schedule_runtime(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_ERROR_T *err);
+/**
+ * @brief Schedules the boot-time tests of a CPU in a context (see STL_schedule_bootime).
+ * @param ctx The context.
+ * @param cpu The CPU for which the boot-time tests are to be scheduled.
+ * @param err Pointer to an STL_ERROR_T variable to store any error that occurs during scheduling.
+ * @ingroup STL_API
+ */
+STLLIB_PUBLIC void STL_ctx_schedule_bootime(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_ERROR_T *err);
+
 #if STL_RELOCATED
 /**
  * @brief Relocates runtime tests.
@@ -131,6 +205,44 @@ STLLIB_PUBLIC void STL_schedule_bootime(STL_CPUS cpu, STL_ERROR_T *err);
  * @see STL_init
  */
 STLLIB_PUBLIC void STL_relocate_runtime_tests(STL_ERROR_T *err);
+
+#if STL_USE_DMA
+/**
+ * @brief Starts the asynchronous relocation of the runtime tests.
+ * The relocation blocks are handed to the DMA and the function returns immediately,
+ * so that the boot-time tests (executed from flash) can run while the runtime image
+ * streams into RAM.
+ * @param err Pointer to an STL_ERROR_T variable to store any error that occurs while starting the relocation.
+ * @return void
+ * @see STL_relocate_runtime_tests_poll, STL_relocate_runtime_tests_wait
+ */
+STLLIB_PUBLIC void STL_relocate_runtime_tests_async(STL_ERROR_T *err);
+
+/**
+ * @brief Checks whether the asynchronous relocation is complete.
+ * On completion the relocated blocks are verified against their build-time checksums
+ * and the instruction stream is synchronized.
+ * @param err Pointer to an STL_ERROR_T variable to store the relocation status (valid on completion).
+ * @return STL_TRUE when the relocation is complete, STL_FALSE while it is running.
+ */
+STLLIB_PUBLIC STL_BOOL STL_relocate_runtime_tests_poll(STL_ERROR_T *err);
+
+/**
+ * @brief Waits for the completion of the asynchronous relocation.
+ * The runtime tests can be executed from RAM once this function returns without error.
+ * @param err Pointer to an STL_ERROR_T variable to store the relocation status.
+ * @return void
+ */
+STLLIB_PUBLIC void STL_relocate_runtime_tests_wait(STL_ERROR_T *err);
+
+/**
+ * @brief Retrieves the overlap achieved by the last asynchronous relocation.
+ * @param stats Pointer to the statistics to fill.
+ * @param err Pointer to an STL_ERROR_T variable to store any error that occurs.
+ * @return void
+ */
+STLLIB_PUBLIC void STL_relocate_get_stats(STL_RELOCATION_STATS_T *stats, STL_ERROR_T *err);
+#endif /*STL_USE_DMA*/
 #endif /*__STL_RELOCATED__*/
 
 #if STL_OS_PRESENT
@@ -174,6 +286,14 @@ STLLIB_PUBLIC EXTERN_KEYWORD void STL_em_init(STL_ERROR_T *err);
  * @param err Pointer to the error structure to initialize.
  */
 STLLIB_PUBLIC EXTERN_KEYWORD void STL_em_deinit(STL_ERROR_T *err);
+
+/**
+ * @brief Starts a new diagnostic cycle on a CPU: its results read as not run (constant time).
+ *
+ * @param cpu The CPU identifier.
+ * @param err Pointer to the error structure to update.
+ */
+STLLIB_PUBLIC EXTERN_KEYWORD void STL_em_reset(STL_CPUS cpu, STL_ERROR_T *err);
 /**
  * @brief Handles a runtime failure for a specific CPU.
  *
@@ -221,6 +341,187 @@ STLLIB_PUBLIC EXTERN_KEYWORD STL_SIGNATURE_T STL_em_bt_get_signature(STL_CPUS cp
  */
 STLLIB_PUBLIC EXTERN_KEYWORD STL_SIGNATURE_T STL_em_rt_get_signature(STL_CPUS cpu, STL_SIZE_T index, STL_ERROR_T *err);
 
+/**
+ * @brief Retrieves the runtime verdict (pass, fail, timeout) for a specific CPU and index.
+ *
+ * @param cpu The CPU identifier.
+ * @param index The index of the verdict to retrieve.
+ * @param err Pointer to the error structure to update.
+ * @return The runtime verdict.
+ */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_VERDICT_T STL_em_rt_get_verdict(STL_CPUS cpu, STL_SIZE_T index, STL_ERROR_T *err);
+
+/**
+ * @brief Copies the signatures, verdicts and timestamps (cycle counter of the verdicts) of a range of
+ * runtime tests of a CPU in one call. Outputs that are not needed can be STL_NULL.
+ *
+ * @param cpu The CPU identifier.
+ * @param first Index of the first test.
+ * @param count Number of tests (capacity of the outputs).
+ * @param sig Signatures, or STL_NULL.
+ * @param verdict Verdicts, or STL_NULL.
+ * @param updated Cycle counter of the verdicts, or STL_NULL.
+ * @param err Pointer to the error structure to update.
+ * @return The number of tests copied (the range is clipped to the last test).
+ */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_SIZE_T STL_em_rt_get_range(STL_CPUS cpu, STL_SIZE_T first, STL_SIZE_T count,
+															STL_SIGNATURE_T *sig, STL_VERDICT_T *verdict,
+															STL_CYCLES_T *updated, STL_ERROR_T *err);
+
+/**
+ * @brief Retrieves the verdict of a cooperative runtime test (coherence SBST) run by a range of
+ * CPUs. The test passes when all the CPUs passed with the same signature, fails when one of them
+ * failed or timed out or when their signatures differ, and has not run otherwise.
+ *
+ * @param index The index of the runtime test.
+ * @param first The first CPU running the test.
+ * @param count The number of CPUs running the test.
+ * @param sig The common signature, or STL_NULL (written only when the test passes).
+ * @param err Pointer to the error structure to update.
+ * @return The verdict of the test on the range of CPUs.
+ */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_VERDICT_T STL_em_rt_get_combined(STL_SIZE_T index, STL_CPUS first, STL_CPUS count,
+																  STL_SIGNATURE_T *sig, STL_ERROR_T *err);
+
+/**
+ * @brief Copies the signatures, verdicts and timestamps of a range of boot-time tests of a CPU.
+ *
+ * @param cpu The CPU identifier.
+ * @param first Index of the first test.
+ * @param count Number of tests (capacity of the outputs).
+ * @param sig Signatures, or STL_NULL.
+ * @param verdict Verdicts, or STL_NULL.
+ * @param updated Cycle counter of the verdicts, or STL_NULL.
+ * @param err Pointer to the error structure to update.
+ * @return The number of tests copied (the range is clipped to the last test).
+ */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_SIZE_T STL_em_bt_get_range(STL_CPUS cpu, STL_SIZE_T first, STL_SIZE_T count,
+															STL_SIGNATURE_T *sig, STL_VERDICT_T *verdict,
+															STL_CYCLES_T *updated, STL_ERROR_T *err);
+
+/**
+ * @brief Copies the signatures, verdicts and timestamps of the runtime tests of all the CPUs.
+ * Element cpu * STL_TOT_RT_ROUTINE + index of each output describes test index of CPU cpu.
+ *
+ * @param sig Signatures, or STL_NULL.
+ * @param verdict Verdicts, or STL_NULL.
+ * @param updated Cycle counter of the verdicts, or STL_NULL.
+ * @param err Pointer to the error structure to update.
+ * @return The number of elements written in each output.
+ */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_INT32U_T STL_em_rt_get_all(STL_SIGNATURE_T *sig, STL_VERDICT_T *verdict,
+															 STL_CYCLES_T *updated, STL_ERROR_T *err);
+
+/**
+ * @brief Copies the signatures, verdicts and timestamps of the boot-time tests of all the CPUs.
+ * Element cpu * STL_TOT_BT_ROUTINE + index of each output describes test index of CPU cpu.
+ *
+ * @param sig Signatures, or STL_NULL.
+ * @param verdict Verdicts, or STL_NULL.
+ * @param updated Cycle counter of the verdicts, or STL_NULL.
+ * @param err Pointer to the error structure to update.
+ * @return The number of elements written in each output.
+ */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_INT32U_T STL_em_bt_get_all(STL_SIGNATURE_T *sig, STL_VERDICT_T *verdict,
+															 STL_CYCLES_T *updated, STL_ERROR_T *err);
+
+/**
+ * @brief Lists the failed runtime tests (fail or timeout) of a CPU, compacted from vect[0].
+ *
+ * @param cpu The CPU identifier.
+ * @param vect List of the failed tests.
+ * @param max Capacity of the list.
+ * @param err Pointer to the error structure to update.
+ * @return The number of failed tests (only the first max are listed).
+ */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_SIZE_T STL_em_rt_get_failed(STL_CPUS cpu, STL_FAILED_TEST_T *vect, STL_SIZE_T max,
+															 STL_ERROR_T *err);
+
+/**
+ * @brief Lists the failed boot-time tests of a CPU, compacted from vect[0].
+ *
+ * @param cpu The CPU identifier.
+ * @param vect List of the failed tests.
+ * @param max Capacity of the list.
+ * @param err Pointer to the error structure to update.
+ * @return The number of failed tests (only the first max are listed).
+ */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_SIZE_T STL_em_bt_get_failed(STL_CPUS cpu, STL_FAILED_TEST_T *vect, STL_SIZE_T max,
+															 STL_ERROR_T *err);
+
+#if (STL_USE_PMU > 0u)
+/**
+ * @brief Retrieves the performance counters aggregated for a runtime test (see STL_USE_PMU).
+ *
+ * @param cpu The CPU identifier.
+ * @param index The index of the runtime test.
+ * @param stats Pointer to the aggregate to fill.
+ * @param err Pointer to the error structure to update.
+ */
+STLLIB_PUBLIC EXTERN_KEYWORD void STL_em_rt_get_pmu(STL_CPUS cpu, STL_SIZE_T index, STL_PMU_STATS_T *stats,
+												   STL_ERROR_T *err);
+#endif /*STL_USE_PMU*/
+
+/*
+ * The functions below are the error management queries on an explicit context: each one
+ * behaves as the function without _ctx on STL_default_context.
+ */
+
+/** @brief STL_em_reset on a context. */
+STLLIB_PUBLIC EXTERN_KEYWORD void STL_em_ctx_reset(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_ERROR_T *err);
+/** @brief STL_em_runtime_failed on a context. */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_SIZE_T STL_em_ctx_runtime_failed(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_ERROR_T *err);
+/** @brief STL_em_failed_runtime_all on a context. */
+STLLIB_PUBLIC EXTERN_KEYWORD void STL_em_ctx_failed_runtime_all(STL_CONTEXT_T *ctx, STL_CPUS cpu,
+																STL_FAILED_TEST_T *vect, STL_ERROR_T *err);
+/** @brief STL_em_failed_bootime_all on a context. */
+STLLIB_PUBLIC EXTERN_KEYWORD void STL_em_ctx_failed_bootime_all(STL_CONTEXT_T *ctx, STL_CPUS cpu,
+																STL_FAILED_TEST_T *vect, STL_ERROR_T *err);
+/** @brief STL_em_bt_get_signature on a context. */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_SIGNATURE_T STL_em_ctx_bt_get_signature(STL_CONTEXT_T *ctx, STL_CPUS cpu,
+																		 STL_SIZE_T index, STL_ERROR_T *err);
+/** @brief STL_em_rt_get_signature on a context. */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_SIGNATURE_T STL_em_ctx_rt_get_signature(STL_CONTEXT_T *ctx, STL_CPUS cpu,
+																		 STL_SIZE_T index, STL_ERROR_T *err);
+/** @brief STL_em_rt_get_verdict on a context. */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_VERDICT_T STL_em_ctx_rt_get_verdict(STL_CONTEXT_T *ctx, STL_CPUS cpu,
+																	 STL_SIZE_T index, STL_ERROR_T *err);
+/** @brief STL_em_rt_get_range on a context. */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_SIZE_T STL_em_ctx_rt_get_range(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_SIZE_T first,
+																STL_SIZE_T count, STL_SIGNATURE_T *sig,
+																STL_VERDICT_T *verdict, STL_CYCLES_T *updated,
+																STL_ERROR_T *err);
+/** @brief STL_em_rt_get_combined on a context. */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_VERDICT_T STL_em_ctx_rt_get_combined(STL_CONTEXT_T *ctx, STL_SIZE_T index,
+																	  STL_CPUS first, STL_CPUS count,
+																	  STL_SIGNATURE_T *sig, STL_ERROR_T *err);
+/** @brief STL_em_bt_get_range on a context. */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_SIZE_T STL_em_ctx_bt_get_range(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_SIZE_T first,
+																STL_SIZE_T count, STL_SIGNATURE_T *sig,
+																STL_VERDICT_T *verdict, STL_CYCLES_T *updated,
+																STL_ERROR_T *err);
+/** @brief STL_em_rt_get_all on a context. */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_INT32U_T STL_em_ctx_rt_get_all(STL_CONTEXT_T *ctx, STL_SIGNATURE_T *sig,
+																 STL_VERDICT_T *verdict, STL_CYCLES_T *updated,
+																 STL_ERROR_T *err);
+/** @brief STL_em_bt_get_all on a context. */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_INT32U_T STL_em_ctx_bt_get_all(STL_CONTEXT_T *ctx, STL_SIGNATURE_T *sig,
+																 STL_VERDICT_T *verdict, STL_CYCLES_T *updated,
+																 STL_ERROR_T *err);
+/** @brief STL_em_rt_get_failed on a context. */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_SIZE_T STL_em_ctx_rt_get_failed(STL_CONTEXT_T *ctx, STL_CPUS cpu,
+																 STL_FAILED_TEST_T *vect, STL_SIZE_T max,
+																 STL_ERROR_T *err);
+/** @brief STL_em_bt_get_failed on a context. */
+STLLIB_PUBLIC EXTERN_KEYWORD STL_SIZE_T STL_em_ctx_bt_get_failed(STL_CONTEXT_T *ctx, STL_CPUS cpu,
+																 STL_FAILED_TEST_T *vect, STL_SIZE_T max,
+																 STL_ERROR_T *err);
+#if (STL_USE_PMU > 0u)
+/** @brief STL_em_rt_get_pmu on a context. */
+STLLIB_PUBLIC EXTERN_KEYWORD void STL_em_ctx_rt_get_pmu(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_SIZE_T index,
+														STL_PMU_STATS_T *stats, STL_ERROR_T *err);
+#endif /*STL_USE_PMU*/
+
 #endif /*STL_ERROR_MANAGEMENT_ENABLED*/
 
 #endif /* __STL_H__ */
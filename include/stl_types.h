@@ -49,6 +49,9 @@
  * @var STL_ERROR_T::STL_ERROR_RELOCATION
  * Error occurred during relocation.
  *
+ * @var STL_ERROR_T::STL_ERROR_RELOCATION_CRC
+ * A relocated block does not match its build-time checksum.
+ *
  * @var STL_ERROR_T::STL_ERROR_SIG_MISMATCH
  * Signature mismatch error.
  *
@@ -72,6 +75,38 @@
  *
  * @var STL_ERROR_T::STL_ERROR_CUSTOM_SCHEDULER_NOT_IMPLEMENTED
  * Custom scheduler is not implemented.
+ *
+ * @var STL_ERROR_T::STL_ERROR_TIMEOUT
+ * The test exceeded its execution budget and was aborted.
+ *
+ * @var STL_ERROR_T::STL_ERROR_MPU
+ * The MPU profile does not fit in the regions of the MPU.
+ *
+ * @var STL_ERROR_T::STL_ERROR_TRACE
+ * The trace sink refused the drained records.
+ *
+ * @var STL_ERROR_T::STL_ERROR_HEALTH
+ * The health export region cannot be mapped.
+ *
+ * @var STL_ERROR_T::STL_ERROR_CACHE
+ * The cache test buffer cannot be mapped or is too small for the cache geometry.
+ */
+
+/**
+ * @enum STL_VERDICT_T
+ * @brief Enumeration of the verdicts recorded for each executed test.
+ *
+ * @var STL_VERDICT_T::STL_VERDICT_NOT_RUN
+ * The test has not been executed yet.
+ *
+ * @var STL_VERDICT_T::STL_VERDICT_PASS
+ * The computed signature matches the golden one.
+ *
+ * @var STL_VERDICT_T::STL_VERDICT_FAIL
+ * The computed signature differs from the golden one.
+ *
+ * @var STL_VERDICT_T::STL_VERDICT_TIMEOUT
+ * The test has been aborted because it exceeded its execution budget.
  */
 
 /**
@@ -94,6 +129,11 @@
  * @brief Type used to represent addresses in STL operations.
  */
 
+/**
+ * @typedef STL_CYCLES_T
+ * @brief Type used to represent CPU cycle counts (timestamps and budgets).
+ */
+
 /**
  * @typedef STL_CPUS
  * @brief Type used to define the CPU number in a multicore system.
@@ -132,7 +172,8 @@ typedef enum
 	STL_ERROR_NOT_IMPLEMENTED = 2,	// Feature not implemented
 	STL_ERROR_TASK_ALLOCATION = 10, // Task allocation error
 
-	STL_ERROR_RELOCATION = 20, // Relocation error
+	STL_ERROR_RELOCATION = 20,	   // Relocation error
+	STL_ERROR_RELOCATION_CRC = 21, // Relocated block checksum mismatch
 
 	STL_ERROR_SIG_MISMATCH = 30, // Signature mismatch error
 
@@ -146,9 +187,30 @@ typedef enum
 	STL_NO_RT_ROUTINE = 80, // No runtime routine available
 	STL_NO_BT_ROUTINE = 90, // No boot-time routine available
 
-	STL_ERROR_CUSTOM_SCHEDULER_NOT_IMPLEMENTED = 100 // Custom scheduler not implemented
+	STL_ERROR_CUSTOM_SCHEDULER_NOT_IMPLEMENTED = 100, // Custom scheduler not implemented
+
+	STL_ERROR_TIMEOUT = 110, // Test aborted by the watchdog
+
+	STL_ERROR_MPU = 120, // Invalid MPU profile
+
+	STL_ERROR_TRACE = 130, // Trace sink refused the records
+
+	STL_ERROR_HEALTH = 140, // Health export region not available
+
+	STL_ERROR_CONTEXT = 150, // Invalid context configuration
+
+	STL_ERROR_CACHE = 160 // Cache test buffer not available
 } STL_ERROR_T;
 
+// Verdicts of the executed tests
+typedef enum
+{
+	STL_VERDICT_NOT_RUN = 0, // Test not executed yet
+	STL_VERDICT_PASS = 1,	 // Signature matches the golden one
+	STL_VERDICT_FAIL = 2,	 // Signature mismatch
+	STL_VERDICT_TIMEOUT = 3	 // Test aborted, budget exceeded
+} STL_VERDICT_T;
+
 // Boolean type
 typedef char STL_BOOL;
 
@@ -161,6 +223,9 @@ typedef uint32_t STL_INT32U_T;
 // Address type
 typedef uint32_t STL_ADDR_T;
 
+// Cycle counter type
+typedef uint64_t STL_CYCLES_T;
+
 /**
  * @brief STL_CPUS is used to define the CPU number in a multicore system.
  * It is used to identify the CPU on which the test is running.
@@ -171,4 +236,27 @@ typedef uint8_t STL_CPUS;
 // Function pointer type for STL functions
 typedef STL_SIGNATURE_T (*STL_FUNCT_PTR_T)(void);
 
+/**
+ * @brief Overlap achieved by the asynchronous relocation.
+ *
+ * @var STL_RELOCATION_STATS_T::bytes
+ * Number of bytes relocated.
+ * @var STL_RELOCATION_STATS_T::transfer_cycles
+ * Cycles from the start of the request to the completion of the DMA.
+ * @var STL_RELOCATION_STATS_T::wait_cycles
+ * Cycles the CPU spent blocked waiting for the DMA.
+ * @var STL_RELOCATION_STATS_T::overlap_cycles
+ * Cycles of the transfer hidden behind other work (transfer_cycles - wait_cycles).
+ * @var STL_RELOCATION_STATS_T::verify_cycles
+ * Cycles spent verifying the relocated blocks against their build-time checksums.
+ */
+typedef struct
+{
+	STL_INT32U_T bytes;
+	STL_CYCLES_T transfer_cycles;
+	STL_CYCLES_T wait_cycles;
+	STL_CYCLES_T overlap_cycles;
+	STL_CYCLES_T verify_cycles;
+} STL_RELOCATION_STATS_T;
+
 #endif /* __STL_TYPES_H__ */
@@ -0,0 +1,295 @@
+#!/usr/bin/env python3
+"""Generate the STL relocation table from a linked ELF image.
+
+The runtime SBSTs placed in RAM are linked with a load address in ROM (LMA) and a run
+address in RAM (VMA). This script reads the section headers, the program headers and
+the symbol table of the linked image and emits the relocation table used by
+STL_relocate_runtime_tests:
+
+  - every allocated section whose name matches --section and whose LMA differs from its
+    VMA is a block; --block START:END[:LOAD] adds a block delimited by linker symbols;
+  - blocks are sorted by load address, so that the ROM is read sequentially;
+  - blocks adjacent in both ROM and RAM are merged; blocks separated by the same gap in
+    ROM and RAM are merged too when the gap is backed by the image and the RAM gap is not
+    used by any other section (e.g. the alignment padding between output sections);
+  - the size of each block is rounded up to --align under the same condition, so that
+    the copy runs by whole words; misaligned addresses are reported;
+  - the CRC-32C of each block is computed on the ROM image.
+
+The table is placed in the .stl_relocation_table section, which the linker script puts
+after every other ROM section, and stl.c reads the number of entries from memory. The
+table can then be regenerated and relinked without moving any other code or data:
+
+    link -> gen_relocation_table.py image.elf -o stl_rt_relocation_table.c -> relink
+    gen_relocation_table.py --check image.elf -o stl_rt_relocation_table.c
+
+--check exits with status 1 if the table of the relinked image differs from the file. An
+image without any relocated block is an error: no table is written.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+SHT_SYMTAB = 2
+PT_LOAD = 1
+
+
+def crc32c_table():
+    table = []
+    for i in range(256):
+        crc = i
+        for _ in range(8):
+            crc = (crc >> 1) ^ 0x82F63B78 if crc & 1 else crc >> 1
+        table.append(crc)
+    return table
+
+
+CRC32C_TABLE = crc32c_table()
+
+
+def crc32c(data):
+    crc = 0xFFFFFFFF
+    for b in data:
+        crc = CRC32C_TABLE[(crc ^ b) & 0xFF] ^ (crc >> 8)
+    return crc ^ 0xFFFFFFFF
+
+
+class Elf:
+    """Minimal ELF reader: sections, load segments and symbols."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF':
+            raise ValueError('%s: not an ELF file' % path)
+        self.is64 = self.data[4] == 2
+        self.endian = '<' if self.data[5] == 1 else '>'
+        if self.is64:
+            (phoff, shoff) = self.unpack('Q', 0x20), self.unpack('Q', 0x28)
+            (phentsize, phnum, shentsize, shnum, shstrndx) = struct.unpack_from(self.endian + 'HHHHH', self.data, 0x36)
+        else:
+            (phoff, shoff) = self.unpack('I', 0x1C), self.unpack('I', 0x20)
+            (phentsize, phnum, shentsize, shnum, shstrndx) = struct.unpack_from(self.endian + 'HHHHH', self.data, 0x2A)
+
+        self.segments = []
+        for i in range(phnum):
+            off = phoff + i * phentsize
+            if self.is64:
+                (p_type, _, p_offset, p_vaddr, p_paddr, p_filesz) = struct.unpack_from(self.endian + 'IIQQQQ', self.data, off)
+            else:
+                (p_type, p_offset, p_vaddr, p_paddr, p_filesz) = struct.unpack_from(self.endian + 'IIIII', self.data, off)
+            if p_type == PT_LOAD:
+                self.segments.append((p_offset, p_vaddr, p_paddr, p_filesz))
+
+        raw = []
+        for i in range(shnum):
+            off = shoff + i * shentsize
+            if self.is64:
+                (name, sh_type, flags, addr, offset, size, link) = struct.unpack_from(self.endian + 'IIQQQQI', self.data, off)
+            else:
+                (name, sh_type, flags, addr, offset, size, link) = struct.unpack_from(self.endian + 'IIIIIII', self.data, off)
+            raw.append((name, sh_type, flags, addr, offset, size, link))
+        strtab = raw[shstrndx][4]
+        self.sections = []
+        for (name, sh_type, flags, addr, offset, size, link) in raw:
+            self.sections.append({
+                'name': self.cstr(strtab + name),
+                'type': sh_type,
+                'flags': flags,
+                'vma': addr,
+                'offset': offset,
+                'size': size,
+                'link': link,
+                'lma': self.lma_of(offset, addr) if sh_type != SHT_NOBITS else addr,
+            })
+
+        self.symbols = {}
+        self.symbol_table = []
+        for sec in self.sections:
+            if sec['type'] != SHT_SYMTAB:
+                continue
+            names = self.sections[sec['link']]['offset']
+            entsize = 24 if self.is64 else 16
+            for off in range(sec['offset'], sec['offset'] + sec['size'], entsize):
+                if self.is64:
+                    (name, info, _, shndx, value, size) = struct.unpack_from(self.endian + 'IBBHQQ', self.data, off)
+                else:
+                    (name, value, size, info, _, shndx) = struct.unpack_from(self.endian + 'IIIBBH', self.data, off)
+                if name:
+                    self.symbols[self.cstr(names + name)] = value
+                    self.symbol_table.append({'name': self.cstr(names + name), 'value': value, 'size': size,
+                                              'type': info & 0xF, 'shndx': shndx})
+
+    def unpack(self, fmt, off):
+        return struct.unpack_from(self.endian + fmt, self.data, off)[0]
+
+    def cstr(self, off):
+        return self.data[off:self.data.index(b'\0', off)].decode()
+
+    def lma_of(self, offset, vma):
+        for (p_offset, p_vaddr, p_paddr, p_filesz) in self.segments:
+            if p_offset <= offset < p_offset + p_filesz and p_vaddr <= vma:
+                return p_paddr + (offset - p_offset)
+        return vma
+
+    def read_lma(self, lma, size):
+        """Bytes of the ROM image at [lma, lma + size), None if not backed by the image."""
+        for (p_offset, _, p_paddr, p_filesz) in self.segments:
+            if p_paddr <= lma and lma + size <= p_paddr + p_filesz:
+                start = p_offset + (lma - p_paddr)
+                return self.data[start:start + size]
+        return None
+
+    def vma_used(self, start, end, exclude):
+        """True if an allocated section other than the excluded ones overlaps [start, end)."""
+        for sec in self.sections:
+            if sec['flags'] & SHF_ALLOC and sec['size'] and sec['name'] not in exclude:
+                if sec['vma'] < end and start < sec['vma'] + sec['size']:
+                    return True
+        return False
+
+
+def collect_blocks(elf, section_re, symbol_blocks):
+    blocks = []
+    for sec in elf.sections:
+        if not sec['flags'] & SHF_ALLOC or sec['type'] == SHT_NOBITS or sec['size'] == 0:
+            continue
+        if section_re.search(sec['name']) and sec['lma'] != sec['vma']:
+            blocks.append({'names': [sec['name']], 'lma': sec['lma'], 'vma': sec['vma'], 'size': sec['size']})
+
+    for spec in symbol_blocks:
+        parts = spec.split(':')
+        try:
+            start = elf.symbols[parts[0]]
+            end = elf.symbols[parts[1]]
+            load = elf.symbols[parts[2]] if len(parts) > 2 else None
+        except KeyError as e:
+            raise SystemExit('symbol %s not found' % e)
+        if load is None:
+            owner = [s for s in elf.sections if s['flags'] & SHF_ALLOC and s['vma'] <= start < s['vma'] + s['size']]
+            if not owner:
+                raise SystemExit('%s: no section at 0x%x' % (parts[0], start))
+            load = owner[0]['lma'] + (start - owner[0]['vma'])
+        if end > start:
+            blocks.append({'names': [parts[0]], 'lma': load, 'vma': start, 'size': end - start})
+    return sorted(blocks, key=lambda b: b['lma'])
+
+
+def can_extend(elf, block, size):
+    """A block can grow to size if the extra bytes are in the image and the RAM is free."""
+    if elf.read_lma(block['lma'], size) is None:
+        return False
+    return not elf.vma_used(block['vma'] + block['size'], block['vma'] + size, block['names'])
+
+
+def compact(elf, blocks, align, warn):
+    merged = []
+    for block in blocks:
+        if merged:
+            last = merged[-1]
+            gap = block['lma'] - (last['lma'] + last['size'])
+            if gap >= 0 and block['vma'] - (last['vma'] + last['size']) == gap and \
+                    (gap == 0 or can_extend(elf, last, last['size'] + gap)):
+                last['size'] += gap + block['size']
+                last['names'] += block['names']
+                continue
+        merged.append(dict(block))
+
+    for block in merged:
+        padded = (block['size'] + align - 1) // align * align
+        if padded != block['size'] and can_extend(elf, block, padded):
+            block['size'] = padded
+        if block['lma'] % align or block['vma'] % align or block['size'] % align:
+            warn('%s: not aligned to %d bytes (copied byte-wise)' % ('+'.join(block['names']), align))
+        data = elf.read_lma(block['lma'], block['size'])
+        if data is None:
+            raise SystemExit('%s: load image not found in the ELF file' % '+'.join(block['names']))
+        block['crc'] = crc32c(data)
+    return merged
+
+
+def render(elf, blocks, source):
+    digits = 16 if elf.is64 else 8
+    suffix = 'ull' if elf.is64 else 'u'
+    lines = [
+        '#if __STL__',
+        '',
+        '/**',
+        ' * @file stl_rt_relocation_table.c',
+        ' * @brief Relocation table of the runtime tests.',
+        ' *',
+        ' * Generated by scripts/gen_relocation_table.py from %s. Do not edit.' % source,
+        ' */',
+        '',
+        '#include "stl_rt_relocation.h"',
+        '',
+        '#if (STL_RELOCATED > 0u && STL_RELOCATION_TABLE > 0u)',
+        '',
+        'STL_RELOCATION_TABLE_SECTION const STL_RelocationEntry_T STL_relocation_table[] = {',
+    ]
+    for b in blocks:
+        lines.append('\t{(const void *)0x%0*X%s, (void *)0x%0*X%s, 0x%08Xu, 0x%08Xu}, /* %s */' %
+                     (digits, b['lma'], suffix, digits, b['vma'], suffix, b['size'], b['crc'], ' + '.join(b['names'])))
+    lines += [
+        '};',
+        '',
+        'STL_RELOCATION_TABLE_SECTION const STL_INT32U_T STL_relocation_table_size = %du;' % len(blocks),
+        '',
+        '#endif /* STL_RELOCATED && STL_RELOCATION_TABLE */',
+        '',
+        '#endif /* __STL__ */',
+        '',
+    ]
+    return '\n'.join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('elf', help='linked ELF image')
+    parser.add_argument('-o', '--output', help='generated C file (default: stdout)')
+    parser.add_argument('--section', default=r'^\.stl_runtime',
+                        help='regular expression selecting the relocated sections (default: %(default)s)')
+    parser.add_argument('--block', action='append', default=[], metavar='START:END[:LOAD]',
+                        help='block delimited by linker symbols (LOAD defaults to the load address of START)')
+    parser.add_argument('--align', type=int, default=4, help='copy alignment in bytes (default: %(default)s)')
+    parser.add_argument('--check', action='store_true', help='compare with the output file instead of writing it')
+    args = parser.parse_args()
+
+    def warn(msg):
+        sys.stderr.write('gen_relocation_table: warning: %s\n' % msg)
+
+    elf = Elf(args.elf)
+    blocks = compact(elf, collect_blocks(elf, re.compile(args.section), args.block), args.align, warn)
+    if not blocks:
+        raise SystemExit('%s: no relocated block found' % args.elf)
+    text = render(elf, blocks, args.elf.replace('\\', '/').split('/')[-1])
+
+    for b in blocks:
+        sys.stderr.write('  0x%08X -> 0x%08X %8d bytes crc 0x%08X  %s\n' %
+                         (b['lma'], b['vma'], b['size'], b['crc'], ' + '.join(b['names'])))
+
+    if args.check:
+        try:
+            with open(args.output, 'rb') as f:
+                current = f.read().decode()
+        except OSError:
+            current = None
+        if current != text:
+            sys.stderr.write('gen_relocation_table: %s is out of date, relink\n' % args.output)
+            return 1
+        return 0
+
+    if args.output:
+        with open(args.output, 'wb') as f:
+            f.write(text.encode())
+    else:
+        sys.stdout.write(text)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""Report the ROM/RAM footprint of a linked STL image.
+
+The footprint is computed from the section headers of the linked ELF image:
+
+  - an allocated section stored in the image (code, constants, initialized data) uses ROM;
+  - a writable section (data, bss) uses RAM, and so does a section linked in RAM with a
+    load address in ROM (the relocated runtime SBSTs use both);
+  - non-allocated sections (debug information, comments) are not counted.
+
+The report has three parts:
+
+  - the totals of each allocated output section;
+  - the breakdown per module (object file), read from the link map of GNU ld (-Wl,-Map);
+  - the breakdown per SBST: the sized symbols (functions and objects) of the .stl_*
+    sections of the linker scripts (bootime/runtime code and data, test headers, signatures,
+    exception table and handlers, relocation table).
+
+    stl_size_report.py ptlix_lib                       # sections and SBSTs
+    stl_size_report.py --map ptlix_lib.map ptlix_lib   # ... and modules
+    stl_size_report.py --map ptlix_lib.map --csv size.csv ptlix_lib
+
+The CSV file has one row per section, module and SBST, so that two builds can be diffed.
+"""
+
+import argparse
+import csv
+import os
+import re
+import sys
+
+from gen_relocation_table import Elf, SHF_ALLOC, SHT_NOBITS
+
+SHF_WRITE = 0x1
+STT_OBJECT = 1
+STT_FUNC = 2
+
+
+def section_usage(elf):
+    """ROM and RAM bytes of each allocated section of the image."""
+    usage = {}
+    for sec in elf.sections:
+        if not sec['flags'] & SHF_ALLOC or sec['size'] == 0:
+            continue
+        rom = sec['size'] if sec['type'] != SHT_NOBITS else 0
+        ram = sec['size'] if sec['flags'] & SHF_WRITE or sec['lma'] != sec['vma'] else 0
+        usage[sec['name']] = (rom, ram)
+    return usage
+
+
+def module_name(path):
+    """Module of an input file of the map: the archive member or the object file."""
+    member = re.match(r'^.*\((.+)\)$', path)
+    name = os.path.basename(member.group(1) if member else path)
+    return re.sub(r'\.(o|obj)$', '', name)
+
+
+def parse_map(path):
+    """Input sections of a GNU ld map file, as (output section, module, size)."""
+    entries = []
+    started = False
+    output = None
+    pending = None
+    with open(path) as f:
+        for line in f:
+            line = line.rstrip('\n')
+            if not started:
+                started = line.startswith('Linker script and memory map')
+                continue
+            if line and not line[0].isspace():
+                output = line.split()[0] if line.startswith('.') else None
+                pending = None
+                continue
+            if output is None:
+                continue
+            # Input section: " .name addr size file", or " .name" wrapped onto the next line
+            m = re.match(r'^ (\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$', line)
+            if m:
+                if m.group(1) != '*fill*':
+                    entries.append((output, module_name(m.group(4).strip()), int(m.group(3), 16)))
+                pending = None
+                continue
+            m = re.match(r'^ (\.\S+|COMMON)\s*$', line)
+            if m:
+                pending = m.group(1)
+                continue
+            m = re.match(r'^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$', line)
+            if m and pending:
+                entries.append((output, module_name(m.group(3).strip()), int(m.group(2), 16)))
+            pending = None
+    return entries
+
+
+def module_usage(entries, usage):
+    """ROM and RAM bytes of each module, from the input sections of the allocated output sections."""
+    modules = {}
+    for (output, module, size) in entries:
+        if output not in usage:
+            continue
+        (rom, ram) = usage[output]
+        (mod_rom, mod_ram) = modules.get(module, (0, 0))
+        modules[module] = (mod_rom + (size if rom else 0), mod_ram + (size if ram else 0))
+    return modules
+
+
+def sbst_usage(elf, usage, section_re):
+    """ROM and RAM bytes of the sized symbols of the selected sections, as (symbol, section, rom, ram)."""
+    sbsts = []
+    for sym in elf.symbol_table:
+        if sym['type'] not in (STT_FUNC, STT_OBJECT) or sym['size'] == 0 or sym['shndx'] >= len(elf.sections):
+            continue
+        section = elf.sections[sym['shndx']]['name']
+        if not section_re.search(section) or section not in usage:
+            continue
+        (rom, ram) = usage[section]
+        sbsts.append((sym['name'], section, sym['size'] if rom else 0, sym['size'] if ram else 0))
+    return sorted(sbsts, key=lambda s: (s[1], -(s[2] + s[3]), s[0]))
+
+
+def print_table(title, rows, width):
+    print('%-*s %10s %10s' % (width, title, 'ROM', 'RAM'))
+    for (name, rom, ram) in rows:
+        print('%-*s %10d %10d' % (width, name, rom, ram))
+    print('%-*s %10d %10d' % (width, 'total', sum(r[1] for r in rows), sum(r[2] for r in rows)))
+    print('')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('elf', help='linked ELF image')
+    parser.add_argument('--map', help='link map of GNU ld, for the breakdown per module')
+    parser.add_argument('--section', default=r'^\.stl_',
+                        help='regular expression selecting the SBST sections (default: %(default)s)')
+    parser.add_argument('--csv', help='write the report to a CSV file')
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    usage = section_usage(elf)
+    sections = [(name, rom, ram) for (name, (rom, ram)) in usage.items()]
+    modules = []
+    if args.map:
+        modules = sorted(((name, rom, ram) for (name, (rom, ram)) in module_usage(parse_map(args.map), usage).items()
+                          if rom or ram), key=lambda m: (-(m[1] + m[2]), m[0]))
+    sbsts = sbst_usage(elf, usage, re.compile(args.section))
+
+    width = max([len(r[0]) for r in sections + modules] + [len('%s (%s)' % (s[0], s[1])) for s in sbsts] + [20])
+    print_table('Section', sections, width)
+    if args.map:
+        print_table('Module', modules, width)
+    if sbsts:
+        print_table('SBST', [('%s (%s)' % (s[0], s[1]), s[2], s[3]) for s in sbsts], width)
+    else:
+        print('No sized symbol in the sections matching %s' % args.section)
+
+    if args.csv:
+        with open(args.csv, 'w', newline='') as f:
+            writer = csv.writer(f)
+            writer.writerow(['kind', 'name', 'section', 'rom', 'ram'])
+            for (name, rom, ram) in sections:
+                writer.writerow(['section', name, name, rom, ram])
+            for (name, rom, ram) in modules:
+                writer.writerow(['module', name, '', rom, ram])
+            for (name, section, rom, ram) in sbsts:
+                writer.writerow(['sbst', name, section, rom, ram])
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
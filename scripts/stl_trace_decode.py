@@ -0,0 +1,207 @@
+#!/usr/bin/env python3
+"""Decode the STL binary trace.
+
+The trace is the stream written by STL_trace_drain (see src/trace/stl_trace.h): a flat
+sequence of 12-byte records {delta:u32, data:u32, index:u16, event:u8, arg:u8} in the byte
+order of the target. Each drain starts with a BLOCK record naming the CPU of the records
+that follow; the timestamp of a record is the sum of the deltas of the previous records
+of its CPU (a TIME_EXT record carries the high half of the next delta).
+
+The decoder prints the timeline of each CPU and/or the per-test statistics: number of
+runs, verdicts, and the duration of the test (from TEST_START to TEST_STOP):
+
+    stl_trace_decode.py trace.bin                  # per-test statistics
+    stl_trace_decode.py --timeline trace.bin       # one line per event
+    stl_trace_decode.py --mhz 400 --csv stats.csv trace.bin
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+RECORD_SIZE = 12
+
+EV_BLOCK = 0
+EV_TIME_EXT = 1
+EV_TEST_START = 2
+EV_TEST_STOP = 3
+EV_SETUP = 4
+EV_RESTORE = 5
+EV_VERDICT = 6
+EV_WATCHDOG = 7
+EV_RELOCATION = 8
+EV_THROTTLE = 9
+EV_SYNC = 10
+EV_REDUNDANCY = 11
+
+EVENTS = {
+    EV_BLOCK: 'block',
+    EV_TIME_EXT: 'time',
+    EV_TEST_START: 'start',
+    EV_TEST_STOP: 'stop',
+    EV_SETUP: 'setup',
+    EV_RESTORE: 'restore',
+    EV_VERDICT: 'verdict',
+    EV_WATCHDOG: 'watchdog',
+    EV_RELOCATION: 'relocation',
+    EV_THROTTLE: 'throttle',
+    EV_SYNC: 'sync',
+    EV_REDUNDANCY: 'redundancy',
+}
+KINDS = {0: 'rt', 1: 'bt'}
+SETUPS = {0: 'config', 1: 'mpu'}
+VERDICTS = {0: 'not-run', 1: 'pass', 2: 'fail', 3: 'timeout'}
+WATCHDOG = {0: 'arm', 1: 'expire', 2: 'kick'}
+RELOCATION = {0: 'start', 1: 'done', 2: 'fail'}
+SYNC = {0: 'enter', 1: 'leave', 2: 'enter-timeout', 3: 'leave-timeout'}
+
+
+class Event:
+    __slots__ = ('cpu', 'time', 'event', 'index', 'arg', 'data')
+
+    def __init__(self, cpu, time, event, index, arg, data):
+        self.cpu = cpu
+        self.time = time
+        self.event = event
+        self.index = index
+        self.arg = arg
+        self.data = data
+
+    def describe(self):
+        ev = self.event
+        if ev in (EV_TEST_START, EV_TEST_STOP):
+            text = '%s test %s%d' % (EVENTS[ev], KINDS.get(self.arg, '?'), self.index)
+            if ev == EV_TEST_STOP:
+                text += ' signature 0x%08x' % self.data
+            return text
+        if ev in (EV_SETUP, EV_RESTORE):
+            return '%s test %d %s (%d)' % (EVENTS[ev], self.index, SETUPS.get(self.arg, self.arg), self.data)
+        if ev == EV_VERDICT:
+            return 'verdict test %d %s signature 0x%08x' % (self.index, VERDICTS.get(self.arg, self.arg), self.data)
+        if ev == EV_WATCHDOG:
+            return 'watchdog test %d %s %d' % (self.index, WATCHDOG.get(self.arg, self.arg), self.data)
+        if ev == EV_RELOCATION:
+            return 'relocation block %d %s 0x%08x' % (self.index, RELOCATION.get(self.arg, self.arg), self.data)
+        if ev == EV_THROTTLE:
+            return 'throttle test %d deferred (%d bytes)' % (self.index, self.data)
+        if ev == EV_SYNC:
+            return 'sync test %d %s after %d cycles' % (self.index, SYNC.get(self.arg, self.arg), self.data)
+        if ev == EV_REDUNDANCY:
+            return 'redundancy test %d %s against 0x%08x' % (self.index, VERDICTS.get(self.arg, self.arg), self.data)
+        return 'event %d index %d arg %d data 0x%08x' % (ev, self.index, self.arg, self.data)
+
+
+def decode(data, endian, warn):
+    """Yield the events of the stream with their absolute timestamps."""
+    fmt = struct.Struct(endian + 'IIHBB')
+    clock = {}
+    ext = {}
+    cpu = 0
+    if len(data) % RECORD_SIZE:
+        warn('%d trailing bytes ignored' % (len(data) % RECORD_SIZE))
+    for off in range(0, len(data) - RECORD_SIZE + 1, RECORD_SIZE):
+        (delta, value, index, event, arg) = fmt.unpack_from(data, off)
+        if event == EV_BLOCK:
+            cpu = arg
+            if value:
+                warn('cpu %d: %d records dropped before offset %d' % (cpu, value, off))
+            continue
+        if event == EV_TIME_EXT:
+            ext[cpu] = ext.get(cpu, 0) + (value << 32)
+            continue
+        clock[cpu] = clock.get(cpu, 0) + ext.pop(cpu, 0) + delta
+        yield Event(cpu, clock[cpu], event, index, arg, value)
+
+
+def statistics(events):
+    """Per-test runs, verdicts and durations, keyed by (cpu, kind, index)."""
+    tests = {}
+    running = {}
+    for e in events:
+        if e.event == EV_TEST_START:
+            running[e.cpu] = e
+        elif e.event == EV_TEST_STOP:
+            start = running.pop(e.cpu, None)
+            key = (e.cpu, e.arg, e.index)
+            t = tests.setdefault(key, {'runs': 0, 'durations': [], 'verdicts': {}, 'signature': None})
+            t['runs'] += 1
+            t['signature'] = e.data
+            if start is not None and start.index == e.index:
+                t['durations'].append(e.time - start.time)
+        elif e.event == EV_VERDICT:
+            # Verdicts are recorded for the runtime tests
+            key = (e.cpu, 0, e.index)
+            t = tests.setdefault(key, {'runs': 0, 'durations': [], 'verdicts': {}, 'signature': None})
+            name = VERDICTS.get(e.arg, str(e.arg))
+            t['verdicts'][name] = t['verdicts'].get(name, 0) + 1
+    return tests
+
+
+def percentile(values, p):
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(p * len(ordered)))]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('trace', nargs='+', help='trace files (concatenated in order)')
+    parser.add_argument('--big-endian', action='store_true', help='the target is big-endian')
+    parser.add_argument('--timeline', action='store_true', help='print one line per event')
+    parser.add_argument('--mhz', type=float, help='cycle counter frequency, to print times in microseconds')
+    parser.add_argument('--csv', help='write the per-test statistics to a CSV file')
+    args = parser.parse_args()
+
+    def warn(msg):
+        sys.stderr.write('stl_trace_decode: warning: %s\n' % msg)
+
+    def fmt_time(cycles):
+        if args.mhz:
+            return '%.3f us' % (cycles / args.mhz)
+        return '%d cy' % cycles
+
+    data = b''
+    for path in args.trace:
+        with open(path, 'rb') as f:
+            data += f.read()
+    events = list(decode(data, '>' if args.big_endian else '<', warn))
+
+    if args.timeline:
+        for e in sorted(events, key=lambda e: (e.time, e.cpu)):
+            print('%16s  cpu%d  %s' % (fmt_time(e.time), e.cpu, e.describe()))
+
+    tests = statistics(events)
+    rows = []
+    for (cpu, kind, index), t in sorted(tests.items()):
+        d = t['durations']
+        rows.append({
+            'cpu': cpu,
+            'test': '%s%d' % (KINDS.get(kind, '?'), index),
+            'runs': t['runs'],
+            'pass': t['verdicts'].get('pass', 0),
+            'fail': t['verdicts'].get('fail', 0),
+            'timeout': t['verdicts'].get('timeout', 0),
+            'min': min(d) if d else '',
+            'avg': sum(d) // len(d) if d else '',
+            'p99': percentile(d, 0.99) if d else '',
+            'max': max(d) if d else '',
+            'signature': '0x%08x' % t['signature'] if t['signature'] is not None else '',
+        })
+
+    print('%-4s %-6s %8s %8s %6s %8s %14s %14s %14s %14s  %s' %
+          ('cpu', 'test', 'runs', 'pass', 'fail', 'timeout', 'min', 'avg', 'p99', 'max', 'signature'))
+    for r in rows:
+        print('%-4d %-6s %8d %8d %6d %8d %14s %14s %14s %14s  %s' %
+              (r['cpu'], r['test'], r['runs'], r['pass'], r['fail'], r['timeout'],
+               *[fmt_time(r[k]) if r[k] != '' else '-' for k in ('min', 'avg', 'p99', 'max')], r['signature']))
+
+    if args.csv:
+        with open(args.csv, 'w', newline='') as f:
+            writer = csv.DictWriter(f, fieldnames=list(rows[0].keys()) if rows else ['cpu'])
+            writer.writeheader()
+            writer.writerows(rows)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
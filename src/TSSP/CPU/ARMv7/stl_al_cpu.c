@@ -0,0 +1,663 @@
+#if __STL__
+#include "stl_al_cpu.h"
+#include "stl_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+#if (STL_RELOCATED > 0u || STL_USE_OVERLAY > 0u)
+#include "stl_crc.h"
+#endif /*STL_RELOCATED || STL_USE_OVERLAY*/
+
+#ifndef STL_AL_CPU_MODULE
+#define STL_AL_CPU_MODULE
+
+/**
+ * @brief Start of the prebuilt STL exception table.
+ * The symbol is defined by the linker script at the beginning of the
+ * .stl_exception_table output section, aligned as required by VTOR/VBAR.
+ */
+extern const STL_ADDR_T __stl_exception_table_start__;
+
+/**
+ * @brief Vector base of the application, saved by the swap.
+ */
+STATIC_KEYWORD STL_ADDR_T cpu_saved_vbar;
+
+/**
+ * @brief Cycle measurements of the swap and restore.
+ */
+STATIC_KEYWORD STL_CPU_IVOR_STATS_T cpu_ivor_stats;
+
+/**
+ * @brief Software extension of the 32-bit hardware cycle counter.
+ */
+STATIC_KEYWORD STL_INT32U_T cpu_cycles_last;
+STATIC_KEYWORD STL_INT32U_T cpu_cycles_high;
+
+/**
+ * @brief Read the vector base register.
+ * @return The current vector base.
+ */
+STATIC_KEYWORD INLINE_KEYWORD STL_ADDR_T STL_TSSP_CPU_read_vbar(void)
+{
+#if (STL_CPU_ARMV7M == 1u)
+	return STL_CPU_SCB_VTOR;
+#else
+	STL_ADDR_T vbar;
+
+	__asm__ volatile("mrc p15, 0, %0, c12, c0, 0" : "=r"(vbar));
+	return vbar;
+#endif
+}
+
+/**
+ * @brief Write the vector base register.
+ * The barriers guarantee that the next exception uses the new table.
+ * @param vbar New vector base.
+ */
+STATIC_KEYWORD INLINE_KEYWORD void STL_TSSP_CPU_write_vbar(STL_ADDR_T vbar)
+{
+#if (STL_CPU_ARMV7M == 1u)
+	STL_CPU_SCB_VTOR = vbar;
+	__asm__ volatile("dsb\n\tisb" : : : "memory");
+#else
+	__asm__ volatile("mcr p15, 0, %0, c12, c0, 0\n\tisb" : : "r"(vbar) : "memory");
+#endif
+}
+
+/**
+ * @brief Restore the interrupt vector table or save the current state.
+ * The vector base register is retargeted to the application vector table saved by the swap.
+ * @return void
+ */
+void STL_TSSP_CPU_restore_ivor(void)
+{
+	STL_CYCLES_T start = STL_TSSP_CPU_get_cycles();
+
+	STL_TSSP_CPU_write_vbar(cpu_saved_vbar);
+
+	cpu_ivor_stats.last_restore_cycles = STL_TSSP_CPU_get_cycles() - start;
+	if (cpu_ivor_stats.last_restore_cycles > cpu_ivor_stats.max_restore_cycles)
+	{
+		cpu_ivor_stats.max_restore_cycles = cpu_ivor_stats.last_restore_cycles;
+	}
+	return;
+}
+/**
+ * @brief Swap the interrupt vector table or restore the previous state.
+ * The vector base register (VTOR on Armv7-M, VBAR on Armv7-A/R) is retargeted to the
+ * prebuilt STL exception table. No table is copied.
+ * @return void
+ */
+void STL_TSSP_CPU_swap_ivor(void)
+{
+	STL_CYCLES_T start = STL_TSSP_CPU_get_cycles();
+
+	cpu_saved_vbar = STL_TSSP_CPU_read_vbar();
+	STL_TSSP_CPU_write_vbar((STL_ADDR_T)(uintptr_t)&__stl_exception_table_start__);
+
+	cpu_ivor_stats.swaps++;
+	cpu_ivor_stats.last_swap_cycles = STL_TSSP_CPU_get_cycles() - start;
+	if (cpu_ivor_stats.last_swap_cycles > cpu_ivor_stats.max_swap_cycles)
+	{
+		cpu_ivor_stats.max_swap_cycles = cpu_ivor_stats.last_swap_cycles;
+	}
+	return;
+}
+
+/**
+ * @brief Retrieve the cycle measurements of the exception vector swap and restore.
+ * @param stats Pointer to the statistics to fill.
+ * @return void
+ */
+void STL_TSSP_CPU_get_ivor_stats(STL_CPU_IVOR_STATS_T *stats)
+{
+	*stats = cpu_ivor_stats;
+}
+
+/**
+ * @brief Read the free-running CPU cycle counter.
+ * The 32-bit DWT (Armv7-M) or PMU (Armv7-A/R) cycle counter is enabled at the first call
+ * and extended to 64 bits in software; the counter must be read at least once per wrap period.
+ * @return The current value of the cycle counter.
+ */
+STL_CYCLES_T STL_TSSP_CPU_get_cycles(void)
+{
+	STL_INT32U_T cycles;
+
+#if (STL_CPU_ARMV7M == 1u)
+	if ((STL_CPU_DWT_CTRL & STL_CPU_DWT_CYCCNTENA) == 0u)
+	{
+		STL_CPU_SCB_DEMCR |= STL_CPU_DEMCR_TRCENA;
+		STL_CPU_DWT_CYCCNT = 0u;
+		STL_CPU_DWT_CTRL |= STL_CPU_DWT_CYCCNTENA;
+	}
+	cycles = STL_CPU_DWT_CYCCNT;
+#else
+	STL_INT32U_T enabled;
+
+	__asm__ volatile("mrc p15, 0, %0, c9, c12, 1" : "=r"(enabled));
+	if ((enabled & (1u << 31)) == 0u)
+	{
+		STL_INT32U_T pmcr;
+
+		__asm__ volatile("mrc p15, 0, %0, c9, c12, 0" : "=r"(pmcr));
+		__asm__ volatile("mcr p15, 0, %0, c9, c12, 0" : : "r"(pmcr | 1u));
+		__asm__ volatile("mcr p15, 0, %0, c9, c12, 1" : : "r"(1u << 31));
+	}
+	__asm__ volatile("mrc p15, 0, %0, c9, c13, 0" : "=r"(cycles));
+#endif
+
+	if (cycles < cpu_cycles_last)
+	{
+		cpu_cycles_high++;
+	}
+	cpu_cycles_last = cycles;
+	return ((STL_CYCLES_T)cpu_cycles_high << 32) | cycles;
+}
+
+#if (STL_MULTICORE_SOC > 0u)
+/**
+ * @brief Hint the CPU that it is spinning on a shared variable.
+ * yield is a hint for the multithreading extension; it executes as a nop elsewhere.
+ * @return void
+ */
+void STL_TSSP_CPU_relax(void)
+{
+	__asm__ volatile("yield" ::: "memory");
+}
+#endif /*STL_MULTICORE_SOC*/
+
+#if (STL_RELOCATED > 0u || STL_USE_OVERLAY > 0u)
+/**
+ * @brief Relocate a block of code or data and compute its CRC-32C in the same pass.
+ * The block is copied by bursts of four words and the CRC is accumulated on the loaded
+ * words. The barriers afterward make the relocated code visible to the instruction fetch.
+ * @param src Source address.
+ * @param dst Destination address.
+ * @param size Size of the block in bytes.
+ * @param err Pointer to a variable to store error status.
+ * @return The CRC-32C of the copied block.
+ * @note On cores with an instruction cache, the relocated range must also be invalidated.
+ */
+STL_INT32U_T STL_TSSP_CPU_relocate(const void *src, void *dst, STL_INT32U_T size, STL_ERROR_T *err)
+{
+	STL_INT32U_T crc = STL_crc32c_copy(dst, src, size, STL_CRC32C_INIT);
+
+	STL_TSSP_CPU_sync_icache(dst, size);
+	*err = STL_ERROR_NONE;
+	return STL_CRC32C_FINAL(crc);
+}
+#endif /*STL_RELOCATED || STL_USE_OVERLAY*/
+
+/**
+ * @brief Synchronize the instruction stream with code written to memory.
+ * On Armv7-A/R the instruction cache is invalidated (ICIALLU); the barriers make the
+ * written code visible to the instruction fetch.
+ * @param addr Start of the written range (unused, the whole instruction cache is invalidated).
+ * @param size Size of the written range in bytes (unused).
+ * @return void
+ */
+void STL_TSSP_CPU_sync_icache(const void *addr, STL_INT32U_T size)
+{
+	(void)addr;
+	(void)size;
+#if (STL_CPU_ARMV7M == 1u)
+	__asm__ volatile("dsb\n\tisb" : : : "memory");
+#else
+	__asm__ volatile("dsb\n\tmcr p15, 0, %0, c7, c5, 0\n\tdsb\n\tisb" : : "r"(0) : "memory");
+#endif
+}
+
+#if (STL_USE_MPU > 0u)
+#if (STL_CPU_ARMV7M == 1u)
+#define STL_CPU_MPU_RBAR_VALID (1u << 4) /* RBAR.REGION selects the region */
+#define STL_CPU_MPU_RASR_ENABLE 1u		 /* Region enable */
+#define STL_CPU_MPU_RASR_XN (1u << 28)	 /* Execute never */
+#define STL_CPU_MPU_RASR_AP_RO (6u << 24) /* Read-only */
+#define STL_CPU_MPU_RASR_AP_RW (3u << 24) /* Read/write */
+
+/**
+ * @brief Shadow copy of the RBAR and RASR registers, used to write only what differs.
+ */
+STATIC_KEYWORD STL_INT32U_T cpu_mpu_shadow[STL_CPU_MPU_NUM_REGIONS][2];
+
+/**
+ * @brief Flag indicating that the shadow copy reflects the registers.
+ */
+STATIC_KEYWORD STL_BOOL cpu_mpu_shadow_valid = STL_FALSE;
+#endif /*STL_CPU_ARMV7M*/
+
+/**
+ * @brief Cost of the MPU profile switches.
+ */
+STATIC_KEYWORD STL_CPU_MPU_STATS_T cpu_mpu_stats;
+
+/**
+ * @brief Configure the Memory Protection Unit (MPU).
+ * The regions of the profile are encoded as RBAR/RASR pairs and compared with the
+ * shadow copy; only the registers that differ are written. A base change is written
+ * through RBAR.VALID, which also selects the region, so that a region costs at most
+ * two writes; an attribute-only change selects the region through RNR.
+ * The regions beyond the profile are disabled.
+ * @param profile Pointer to the MPU profile.
+ * @param err Pointer to a variable to store error status.
+ * @return void
+ * @note Only the Armv7-M PMSA is supported; on Armv7-A/R STL_ERROR_NOT_IMPLEMENTED is returned.
+ */
+void STL_TSSP_CPU_configure_mpu(const STL_CPU_MPU_PROFILE_T *profile, STL_ERROR_T *err)
+{
+#if (STL_CPU_ARMV7M == 1u)
+	STL_CYCLES_T start = STL_TSSP_CPU_get_cycles();
+	const STL_CPU_MPU_CFG_t *region;
+	STL_INT32U_T rbar;
+	STL_INT32U_T rasr;
+	STL_SIZE_T i;
+
+	if (profile->num_regions > STL_CPU_MPU_NUM_REGIONS)
+	{
+		*err = STL_ERROR_MPU;
+		return;
+	}
+	*err = STL_ERROR_NONE;
+
+	cpu_mpu_stats.last_writes = 0u;
+	for (i = 0; i < STL_CPU_MPU_NUM_REGIONS; i++)
+	{
+		rbar = 0u;
+		rasr = 0u;
+		if (i < profile->num_regions)
+		{
+			region = &profile->regions[i];
+			rbar = region->base_address;
+			rasr = ((STL_INT32U_T)(31 - __builtin_clz(region->size) - 1) << 1) | STL_CPU_MPU_RASR_ENABLE;
+			if ((region->access & STL_CPU_MPU_ACCESS_EXECUTE) == 0u)
+			{
+				rasr |= STL_CPU_MPU_RASR_XN;
+			}
+			if ((region->access & STL_CPU_MPU_ACCESS_WRITE) != 0u)
+			{
+				rasr |= STL_CPU_MPU_RASR_AP_RW;
+			}
+			else if ((region->access & STL_CPU_MPU_ACCESS_READ) != 0u)
+			{
+				rasr |= STL_CPU_MPU_RASR_AP_RO;
+			}
+		}
+
+		if ((cpu_mpu_shadow_valid == STL_FALSE) || (cpu_mpu_shadow[i][0] != rbar))
+		{
+			STL_CPU_MPU_RBAR = rbar | STL_CPU_MPU_RBAR_VALID | (STL_INT32U_T)i;
+			cpu_mpu_shadow[i][0] = rbar;
+			cpu_mpu_stats.last_writes++;
+			if ((cpu_mpu_shadow_valid == STL_FALSE) || (cpu_mpu_shadow[i][1] != rasr))
+			{
+				STL_CPU_MPU_RASR = rasr;
+				cpu_mpu_shadow[i][1] = rasr;
+				cpu_mpu_stats.last_writes++;
+			}
+		}
+		else if (cpu_mpu_shadow[i][1] != rasr)
+		{
+			STL_CPU_MPU_RNR = (STL_INT32U_T)i;
+			STL_CPU_MPU_RASR = rasr;
+			cpu_mpu_shadow[i][1] = rasr;
+			cpu_mpu_stats.last_writes += 2u;
+		}
+	}
+	cpu_mpu_shadow_valid = STL_TRUE;
+	__asm__ volatile("dsb\n\tisb" : : : "memory");
+
+	cpu_mpu_stats.switches++;
+	cpu_mpu_stats.reg_writes += cpu_mpu_stats.last_writes;
+	cpu_mpu_stats.last_cycles = STL_TSSP_CPU_get_cycles() - start;
+	if (cpu_mpu_stats.last_cycles > cpu_mpu_stats.max_cycles)
+	{
+		cpu_mpu_stats.max_cycles = cpu_mpu_stats.last_cycles;
+	}
+#else
+	(void)profile;
+	*err = STL_ERROR_NOT_IMPLEMENTED;
+#endif /*STL_CPU_ARMV7M*/
+}
+
+/**
+ * @brief Retrieve the cost of the MPU profile switches.
+ * @param stats Pointer to the statistics to fill.
+ * @return void
+ */
+void STL_TSSP_CPU_get_mpu_stats(STL_CPU_MPU_STATS_T *stats)
+{
+	*stats = cpu_mpu_stats;
+}
+#endif /*STL_USE_MPU*/
+
+#if (STL_USE_PMU > 0u)
+STATIC_KEYWORD const STL_PMU_EVENT_T cpu_pmu_events[STL_PMU_NUM_COUNTERS] = STL_PMU_EVENTS;
+
+#define STL_CPU_PMU_NONE 0xFFu	 /* Event not counted */
+#define STL_CPU_PMU_CYCLES 0xFEu /* Event counted by the cycle counter */
+
+/**
+ * @brief Hardware counter of each configured event: PMU event counter number,
+ * STL_CPU_PMU_CYCLES or STL_CPU_PMU_NONE.
+ */
+STATIC_KEYWORD uint8_t cpu_pmu_counter[STL_PMU_NUM_COUNTERS];
+
+#if (STL_CPU_ARMV7M == 0u)
+/**
+ * @brief Software extension of the 32-bit event counters (see STL_TSSP_CPU_get_cycles).
+ */
+STATIC_KEYWORD STL_INT32U_T cpu_pmu_last[STL_PMU_NUM_COUNTERS];
+STATIC_KEYWORD STL_INT32U_T cpu_pmu_high[STL_PMU_NUM_COUNTERS];
+#endif /*STL_CPU_ARMV7M*/
+
+/**
+ * @brief Program the performance counters with the events of STL_PMU_EVENTS and start them.
+ * The cycles are read from the cycle counter of STL_TSSP_CPU_get_cycles. On Armv7-A/R the other
+ * events are programmed in the PMU event counters, as many as the PMU implements (PMCR.N);
+ * on Armv7-M only the cycles are available.
+ * @param err Pointer to a variable to store error status.
+ * @return Mask of the available counters.
+ */
+STL_INT32U_T STL_TSSP_CPU_pmu_init(STL_ERROR_T *err)
+{
+	STL_INT32U_T mask = 0u;
+	STL_SIZE_T i;
+#if (STL_CPU_ARMV7M == 0u)
+	STL_INT32U_T pmcr;
+	STL_INT32U_T enable = 0u;
+	STL_INT32U_T next = 0u;
+
+	(void)STL_TSSP_CPU_get_cycles(); /* Enables the PMU and the cycle counter */
+	__asm__ volatile("mrc p15, 0, %0, c9, c12, 0" : "=r"(pmcr));
+#endif /*STL_CPU_ARMV7M*/
+
+	for (i = 0u; i < STL_PMU_NUM_COUNTERS; i++)
+	{
+		cpu_pmu_counter[i] = STL_CPU_PMU_NONE;
+		if (cpu_pmu_events[i] == STL_PMU_EVENT_CYCLES)
+		{
+			cpu_pmu_counter[i] = STL_CPU_PMU_CYCLES;
+			mask |= 1u << i;
+		}
+#if (STL_CPU_ARMV7M == 0u)
+		else if (next < ((pmcr >> 11) & 0x1Fu))
+		{
+			STL_INT32U_T type;
+
+			switch (cpu_pmu_events[i])
+			{
+			case STL_PMU_EVENT_INSTRUCTIONS:
+				type = STL_CPU_PMU_EVENT_INST_RETIRED;
+				break;
+			case STL_PMU_EVENT_CACHE_MISSES:
+				type = STL_CPU_PMU_EVENT_L1D_REFILL;
+				break;
+			case STL_PMU_EVENT_BRANCH_MISSES:
+				type = STL_CPU_PMU_EVENT_BR_MIS_PRED;
+				break;
+			default:
+				type = STL_CPU_PMU_EVENT_EXC_TAKEN;
+				break;
+			}
+			__asm__ volatile("mcr p15, 0, %0, c9, c12, 5\n\tisb" : : "r"(next));
+			__asm__ volatile("mcr p15, 0, %0, c9, c13, 1" : : "r"(type));
+			__asm__ volatile("mcr p15, 0, %0, c9, c13, 2" : : "r"(0u));
+			cpu_pmu_counter[i] = (uint8_t)next;
+			cpu_pmu_last[i] = 0u;
+			cpu_pmu_high[i] = 0u;
+			enable |= 1u << next;
+			next++;
+			mask |= 1u << i;
+		}
+#endif /*STL_CPU_ARMV7M*/
+	}
+
+#if (STL_CPU_ARMV7M == 0u)
+	__asm__ volatile("mcr p15, 0, %0, c9, c12, 1\n\tisb" : : "r"(enable));
+#endif /*STL_CPU_ARMV7M*/
+	*err = STL_ERROR_NONE;
+	return mask;
+}
+
+/**
+ * @brief Read the configured performance counters.
+ * @param sample Pointer to the snapshot to fill.
+ * @return void
+ */
+void STL_TSSP_CPU_pmu_read(STL_PMU_SAMPLE_T *sample)
+{
+	STL_SIZE_T i;
+
+	for (i = 0u; i < STL_PMU_NUM_COUNTERS; i++)
+	{
+		if (cpu_pmu_counter[i] == STL_CPU_PMU_CYCLES)
+		{
+			sample->count[i] = STL_TSSP_CPU_get_cycles();
+		}
+#if (STL_CPU_ARMV7M == 0u)
+		else if (cpu_pmu_counter[i] != STL_CPU_PMU_NONE)
+		{
+			STL_INT32U_T count;
+
+			__asm__ volatile("mcr p15, 0, %0, c9, c12, 5\n\tisb" : : "r"((STL_INT32U_T)cpu_pmu_counter[i]));
+			__asm__ volatile("mrc p15, 0, %0, c9, c13, 2" : "=r"(count));
+			if (count < cpu_pmu_last[i])
+			{
+				cpu_pmu_high[i]++;
+			}
+			cpu_pmu_last[i] = count;
+			sample->count[i] = ((STL_CYCLES_T)cpu_pmu_high[i] << 32) | count;
+		}
+#endif /*STL_CPU_ARMV7M*/
+		else
+		{
+			sample->count[i] = 0u;
+		}
+	}
+}
+
+/**
+ * @brief Stop the performance counters and release them.
+ * The cycle counter is left running (it is shared with STL_TSSP_CPU_get_cycles).
+ * @return void
+ */
+void STL_TSSP_CPU_pmu_deinit(void)
+{
+	STL_SIZE_T i;
+#if (STL_CPU_ARMV7M == 0u)
+	STL_INT32U_T disable = 0u;
+#endif /*STL_CPU_ARMV7M*/
+
+	for (i = 0u; i < STL_PMU_NUM_COUNTERS; i++)
+	{
+#if (STL_CPU_ARMV7M == 0u)
+		if (cpu_pmu_counter[i] < STL_CPU_PMU_CYCLES)
+		{
+			disable |= 1u << cpu_pmu_counter[i];
+		}
+#endif /*STL_CPU_ARMV7M*/
+		cpu_pmu_counter[i] = STL_CPU_PMU_NONE;
+	}
+#if (STL_CPU_ARMV7M == 0u)
+	/* PMCNTENCLR */
+	__asm__ volatile("mcr p15, 0, %0, c9, c12, 2" : : "r"(disable));
+#endif /*STL_CPU_ARMV7M*/
+}
+#endif /*STL_USE_PMU*/
+
+#if (STL_USE_ISA_DISPATCH > 0u)
+/**
+ * @brief Detect the ISA extensions the core can execute.
+ * The port has no SBST variant beyond the baseline ISA: nothing is reported.
+ * @return 0 (baseline ISA).
+ */
+STL_ISA_FEATURES_T STL_TSSP_CPU_get_isa_features(void)
+{
+	return 0u;
+}
+#endif /*STL_USE_ISA_DISPATCH*/
+
+#if (STL_USE_CACHE_TEST > 0u)
+#define STL_CPU_CLIDR_CTYPE_DATA 2u	   /* CLIDR.Ctype: data cache only */
+#define STL_CPU_CLIDR_CTYPE_SPLIT 3u	   /* CLIDR.Ctype: separate instruction and data caches */
+#define STL_CPU_CLIDR_CTYPE_UNIFIED 4u /* CLIDR.Ctype: unified cache */
+
+/**
+ * @brief Select a data cache level and read its CCSIDR.
+ * @param level Cache level, from 0 (L1).
+ * @return CCSIDR of the data or unified cache of the level.
+ */
+STATIC_KEYWORD STL_INT32U_T STL_TSSP_CPU_read_ccsidr(STL_INT32U_T level)
+{
+	STL_INT32U_T ccsidr;
+
+#if (STL_CPU_ARMV7M == 1u)
+	STL_CPU_SCB_CSSELR = level << 1;
+	__asm__ volatile("dsb\n\tisb" : : : "memory");
+	ccsidr = STL_CPU_SCB_CCSIDR;
+#else
+	__asm__ volatile("mcr p15, 2, %0, c0, c0, 0\n\tisb" : : "r"(level << 1) : "memory");
+	__asm__ volatile("mrc p15, 1, %0, c0, c0, 0" : "=r"(ccsidr));
+#endif
+	return ccsidr;
+}
+
+/**
+ * @brief Smallest data cache line of the hierarchy (CTR.DminLine), in bytes.
+ */
+STATIC_KEYWORD STL_INT32U_T STL_TSSP_CPU_dcache_line(void)
+{
+	STL_INT32U_T ctr;
+
+#if (STL_CPU_ARMV7M == 1u)
+	ctr = STL_CPU_SCB_CTR;
+#else
+	__asm__ volatile("mrc p15, 0, %0, c0, c0, 1" : "=r"(ctr));
+#endif
+	return 4u << ((ctr >> 16) & 0xFu);
+}
+
+/**
+ * @brief Read the geometry of a data cache level.
+ * CLIDR tells whether the level has a data cache; its geometry is read from CCSIDR.
+ * @param level Cache level.
+ * @param info Pointer to the geometry to fill (size 0 if the level has no data cache).
+ * @param err Pointer to a variable to store error status.
+ * @return void
+ */
+void STL_TSSP_CPU_cache_get_info(STL_CPU_CACHE_LEVEL_T level, STL_CPU_CACHE_INFO_T *info, STL_ERROR_T *err)
+{
+	STL_INT32U_T clidr;
+	STL_INT32U_T ctype;
+	STL_INT32U_T ccsidr;
+
+	info->size = 0u;
+	info->line = 0u;
+	info->ways = 0u;
+	info->sets = 0u;
+	if (level >= STL_CPU_CACHE_LEVELS)
+	{
+		*err = STL_INDEX_OUT_OF_BOUNDS;
+		return;
+	}
+#if (STL_CPU_ARMV7M == 1u)
+	clidr = STL_CPU_SCB_CLIDR;
+#else
+	__asm__ volatile("mrc p15, 1, %0, c0, c0, 1" : "=r"(clidr));
+#endif
+	ctype = (clidr >> (3u * (STL_INT32U_T)level)) & 0x7u;
+	if (ctype == STL_CPU_CLIDR_CTYPE_DATA || ctype == STL_CPU_CLIDR_CTYPE_SPLIT || ctype == STL_CPU_CLIDR_CTYPE_UNIFIED)
+	{
+		ccsidr = STL_TSSP_CPU_read_ccsidr((STL_INT32U_T)level);
+		info->line = 16u << (ccsidr & 0x7u);
+		info->ways = ((ccsidr >> 3) & 0x3FFu) + 1u;
+		info->sets = ((ccsidr >> 13) & 0x7FFFu) + 1u;
+		info->size = info->line * info->ways * info->sets;
+	}
+	*err = STL_ERROR_NONE;
+}
+
+/**
+ * @brief Write back and invalidate the data cache lines of a range, at every level.
+ * Each line is cleaned and invalidated to the point of coherency (DCCIMVAC).
+ * @param addr Start of the range.
+ * @param size Size of the range in bytes.
+ * @return void
+ */
+void STL_TSSP_CPU_cache_flush(const void *addr, STL_INT32U_T size)
+{
+	STL_INT32U_T step = STL_TSSP_CPU_dcache_line();
+	uintptr_t line = (uintptr_t)addr & ~(uintptr_t)(step - 1u);
+
+	__asm__ volatile("dsb" : : : "memory");
+	for (; line < (uintptr_t)addr + size; line += step)
+	{
+#if (STL_CPU_ARMV7M == 1u)
+		STL_CPU_SCB_DCCIMVAC = (STL_INT32U_T)line;
+#else
+		__asm__ volatile("mcr p15, 0, %0, c7, c14, 1" : : "r"(line) : "memory");
+#endif
+	}
+	__asm__ volatile("dsb\n\tisb" : : : "memory");
+}
+
+/**
+ * @brief Invalidate the data cache lines of a range, at every level.
+ * Each line is invalidated to the point of coherency (DCIMVAC): dirty data is discarded.
+ * @param addr Start of the range.
+ * @param size Size of the range in bytes.
+ * @param err Pointer to a variable to store error status.
+ * @return void
+ */
+void STL_TSSP_CPU_cache_invalidate(void *addr, STL_INT32U_T size, STL_ERROR_T *err)
+{
+	STL_INT32U_T step = STL_TSSP_CPU_dcache_line();
+	uintptr_t line = (uintptr_t)addr & ~(uintptr_t)(step - 1u);
+
+	__asm__ volatile("dsb" : : : "memory");
+	for (; line < (uintptr_t)addr + size; line += step)
+	{
+#if (STL_CPU_ARMV7M == 1u)
+		STL_CPU_SCB_DCIMVAC = (STL_INT32U_T)line;
+#else
+		__asm__ volatile("mcr p15, 0, %0, c7, c6, 1" : : "r"(line) : "memory");
+#endif
+	}
+	__asm__ volatile("dsb\n\tisb" : : : "memory");
+	*err = STL_ERROR_NONE;
+}
+
+/**
+ * @brief Lock the data cache lines of a range.
+ * Cache lockdown is implementation defined in Armv7 and not supported by this port.
+ * @param addr Start of the range (unused).
+ * @param size Size of the range in bytes (unused).
+ * @param err Pointer to a variable to store error status (always STL_ERROR_NOT_IMPLEMENTED).
+ * @return void
+ */
+void STL_TSSP_CPU_cache_lock(const void *addr, STL_INT32U_T size, STL_ERROR_T *err)
+{
+	(void)addr;
+	(void)size;
+	*err = STL_ERROR_NOT_IMPLEMENTED;
+}
+
+/**
+ * @brief Unlock the data cache lines of a range.
+ * @param addr Start of the range (unused).
+ * @param size Size of the range in bytes (unused).
+ * @param err Pointer to a variable to store error status (always STL_ERROR_NOT_IMPLEMENTED).
+ * @return void
+ */
+void STL_TSSP_CPU_cache_unlock(const void *addr, STL_INT32U_T size, STL_ERROR_T *err)
+{
+	(void)addr;
+	(void)size;
+	*err = STL_ERROR_NOT_IMPLEMENTED;
+}
+#endif /*STL_USE_CACHE_TEST*/
+
+#endif /* STL_AL_CPU_MODULE */
+#endif /*__STL__*/
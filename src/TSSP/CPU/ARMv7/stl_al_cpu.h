@@ -0,0 +1,71 @@
+#if __STL__
+#ifndef __STL_AL_CPU_H__
+#define __STL_AL_CPU_H__
+
+/**
+ * @file stl_al_cpu.h
+ * @brief CPU services for the Test Setup Support Package (TSSP) on Armv7 cores.
+ * This file provides functions for CPU-specific operations such as restoring and swapping the interrupt vector table,
+ * configuring the Memory Protection Unit (MPU), and reading the cycle counter.
+ * Both profiles are supported: Armv7-M (VTOR, DWT cycle counter) and Armv7-A/R (VBAR, PMU cycle counter).
+ *
+ * @note This file is part of the Test Setup Support Package (TSSP) and is intended for use in embedded systems.
+ * It is designed to be included in the TSSP implementation files.
+ */
+
+/**
+ * STL_NUM_CPU
+ * @brief Number of CPUs in the system.
+ * This macro defines the number of CPUs available in the system.
+ * @note This value may need to be adjusted based on the actual number of CPUs in the system.
+ *       The build configuration (meson option num_cpus) takes precedence.
+ */
+#ifndef STL_NUM_CPU
+#define STL_NUM_CPU 2u
+#endif /*STL_NUM_CPU*/
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+/**
+ * STL_CPU_ARMV7M
+ * @brief Set when building for an Armv7-M core (vector table offset register in the SCB).
+ */
+#define STL_CPU_ARMV7M 1u
+
+#define STL_CPU_SCB_VTOR (*(volatile STL_INT32U_T *)0xE000ED08u)	/* Vector table offset register */
+#define STL_CPU_SCB_DEMCR (*(volatile STL_INT32U_T *)0xE000EDFCu) /* Debug exception and monitor control */
+#define STL_CPU_DWT_CTRL (*(volatile STL_INT32U_T *)0xE0001000u)	/* DWT control register */
+#define STL_CPU_DWT_CYCCNT (*(volatile STL_INT32U_T *)0xE0001004u) /* DWT cycle counter */
+#define STL_CPU_DEMCR_TRCENA (1u << 24)
+#define STL_CPU_DWT_CYCCNTENA (1u << 0)
+
+#define STL_CPU_MPU_RNR (*(volatile STL_INT32U_T *)0xE000ED98u)  /* MPU region number register */
+#define STL_CPU_MPU_RBAR (*(volatile STL_INT32U_T *)0xE000ED9Cu) /* MPU region base address register */
+#define STL_CPU_MPU_RASR (*(volatile STL_INT32U_T *)0xE000EDA0u) /* MPU region attribute and size register */
+
+#define STL_CPU_SCB_CLIDR (*(volatile STL_INT32U_T *)0xE000ED78u)	/* Cache level ID register */
+#define STL_CPU_SCB_CTR (*(volatile STL_INT32U_T *)0xE000ED7Cu)		/* Cache type register */
+#define STL_CPU_SCB_CCSIDR (*(volatile STL_INT32U_T *)0xE000ED80u)	/* Cache size ID register */
+#define STL_CPU_SCB_CSSELR (*(volatile STL_INT32U_T *)0xE000ED84u)	/* Cache size selection register */
+#define STL_CPU_SCB_DCIMVAC (*(volatile STL_INT32U_T *)0xE000EF5Cu)	/* D-cache invalidate by address */
+#define STL_CPU_SCB_DCCIMVAC (*(volatile STL_INT32U_T *)0xE000EF70u) /* D-cache clean and invalidate by address */
+
+/**
+ * STL_CPU_MPU_NUM_REGIONS
+ * @brief Number of regions of the MPU used for the MPU profiles.
+ */
+#define STL_CPU_MPU_NUM_REGIONS 8u
+#else
+#define STL_CPU_ARMV7M 0u
+
+/**
+ * STL_CPU_PMU_EVENT_*
+ * @brief Common architectural events of the Armv7-A/R PMU (PMXEVTYPER encodings).
+ */
+#define STL_CPU_PMU_EVENT_L1D_REFILL 0x03u	 /* Level 1 data cache refill */
+#define STL_CPU_PMU_EVENT_INST_RETIRED 0x08u /* Instruction architecturally executed */
+#define STL_CPU_PMU_EVENT_EXC_TAKEN 0x09u	 /* Exception taken */
+#define STL_CPU_PMU_EVENT_BR_MIS_PRED 0x10u	 /* Mispredicted or not predicted branch */
+#endif
+
+#endif /*__STL_AL_CPU_H__*/
+#endif /*__STL__*/
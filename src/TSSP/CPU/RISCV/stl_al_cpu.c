@@ -4,74 +4,643 @@
 #include "stl_tssp.h"
 #include "stl_types.h"
 
+#if (STL_RELOCATED > 0u || STL_USE_OVERLAY > 0u)
+#include "stl_crc.h"
+#endif /*STL_RELOCATED || STL_USE_OVERLAY*/
+
 #ifndef STL_AL_CPU_MODULE
 #define STL_AL_CPU_MODULE
 
+/**
+ * @brief Start of the prebuilt STL exception table.
+ * The symbol is defined by the linker script at the beginning of the
+ * STL_CODE_SECTION_MODIFIED_EXCEPTION output section.
+ */
+extern const STL_ADDR_T __stl_exception_table_start__;
+
+/**
+ * @brief mtvec value of the application, saved by the swap.
+ */
+STATIC_KEYWORD uintptr_t cpu_saved_mtvec;
+
+/**
+ * @brief Cycle measurements of the swap and restore.
+ */
+STATIC_KEYWORD STL_CPU_IVOR_STATS_T cpu_ivor_stats;
+
 /**
  * @brief Restore the interrupt vector table or save the current state.
- * This function is typically used in systems where
- * the interrupt vector table can be restored
- * or saved to handle different interrupt contexts.
- * The actual implementation will depend on the specific CPU architecture.
+ * mtvec is retargeted to the application vector table saved by the swap.
  * @return void
- * @note This function may involve low-level operations
- * to manipulate the CPU's interrupt vector table.
  */
 void STL_TSSP_CPU_restore_ivor(void)
 {
-	// Implementation of IVOR restore logic
-	// This function is typically used to restore the interrupt vector table
-	// or to save the current state of the interrupt vector table.
-	// The actual implementation will depend on the specific CPU architecture.
+	STL_CYCLES_T start = STL_TSSP_CPU_get_cycles();
+
+	__asm__ volatile("csrw mtvec, %0" : : "r"(cpu_saved_mtvec) : "memory");
+
+	cpu_ivor_stats.last_restore_cycles = STL_TSSP_CPU_get_cycles() - start;
+	if (cpu_ivor_stats.last_restore_cycles > cpu_ivor_stats.max_restore_cycles)
+	{
+		cpu_ivor_stats.max_restore_cycles = cpu_ivor_stats.last_restore_cycles;
+	}
 	return;
 }
 /**
  * @brief Swap the interrupt vector table or restore the previous state.
- * This function is typically used in systems where
- * the interrupt vector table can be swapped
- * or restored to handle different interrupt contexts.
- * The actual implementation will depend on the specific CPU architecture.
+ * mtvec is atomically exchanged (csrrw) with the address of the prebuilt STL exception
+ * table, in the mode selected by STL_CPU_MTVEC_MODE. No table is copied.
  * @return void
- * @note This function may involve low-level operations
- * to manipulate the CPU's interrupt vector table.
- * It is crucial to ensure that the
- * interrupt vector table is correctly set up before calling this function.
+ * @note The STL exception table must be aligned as required by mtvec (see the linker script).
  */
 void STL_TSSP_CPU_swap_ivor(void)
 {
-	// Implementation of IVOR swap logic
-	// This function is typically used to swap the interrupt vector table
-	// or to restore the previous state of the interrupt vector table.
-	// The actual implementation will depend on the specific CPU architecture.
+	STL_CYCLES_T start = STL_TSSP_CPU_get_cycles();
+	uintptr_t stl_mtvec = (uintptr_t)&__stl_exception_table_start__ | STL_CPU_MTVEC_MODE;
+
+	__asm__ volatile("csrrw %0, mtvec, %1" : "=r"(cpu_saved_mtvec) : "r"(stl_mtvec) : "memory");
+
+	cpu_ivor_stats.swaps++;
+	cpu_ivor_stats.last_swap_cycles = STL_TSSP_CPU_get_cycles() - start;
+	if (cpu_ivor_stats.last_swap_cycles > cpu_ivor_stats.max_swap_cycles)
+	{
+		cpu_ivor_stats.max_swap_cycles = cpu_ivor_stats.last_swap_cycles;
+	}
 	return;
 }
 
+/**
+ * @brief Retrieve the cycle measurements of the exception vector swap and restore.
+ * @param stats Pointer to the statistics to fill.
+ * @return void
+ */
+void STL_TSSP_CPU_get_ivor_stats(STL_CPU_IVOR_STATS_T *stats)
+{
+	*stats = cpu_ivor_stats;
+}
+
+/**
+ * @brief Read the free-running CPU cycle counter.
+ * On RV32 the 64-bit counter is read as two halves; the high half is read twice
+ * to detect a carry between the two reads.
+ * @return The current value of the cycle counter.
+ */
+STL_CYCLES_T STL_TSSP_CPU_get_cycles(void)
+{
+#if (__riscv_xlen == 32)
+	uint32_t hi;
+	uint32_t lo;
+	uint32_t hi2;
+
+	do
+	{
+		__asm__ volatile("rdcycleh %0" : "=r"(hi));
+		__asm__ volatile("rdcycle %0" : "=r"(lo));
+		__asm__ volatile("rdcycleh %0" : "=r"(hi2));
+	} while (hi != hi2);
+
+	return ((STL_CYCLES_T)hi << 32) | lo;
+#else
+	uint64_t cycles;
+
+	__asm__ volatile("rdcycle %0" : "=r"(cycles));
+	return cycles;
+#endif /*__riscv_xlen*/
+}
+
+#if (STL_MULTICORE_SOC > 0u)
+/**
+ * @brief Hint the CPU that it is spinning on a shared variable.
+ * pause (Zihintpause) is encoded as a fence with a null predecessor set, so that it
+ * executes as a nop on the cores without the extension.
+ * @return void
+ */
+void STL_TSSP_CPU_relax(void)
+{
+	__asm__ volatile(".insn i 0x0F, 0, x0, x0, 0x010" ::: "memory");
+}
+#endif /*STL_MULTICORE_SOC*/
+
+#if (STL_RELOCATED > 0u || STL_USE_OVERLAY > 0u)
+/**
+ * @brief Relocate a block of code or data and compute its CRC-32C in the same pass.
+ * The block is copied by bursts of four words (unrolled lw/sw) and the CRC is accumulated
+ * on the loaded words. The instruction stream is synchronized (fence.i) afterward,
+ * so that relocated code can be executed.
+ * @param src Source address.
+ * @param dst Destination address.
+ * @param size Size of the block in bytes.
+ * @param err Pointer to a variable to store error status.
+ * @return The CRC-32C of the copied block.
+ * @note Both addresses should be word aligned; otherwise the block is copied byte by byte.
+ */
+STL_INT32U_T STL_TSSP_CPU_relocate(const void *src, void *dst, STL_INT32U_T size, STL_ERROR_T *err)
+{
+	STL_INT32U_T crc = STL_crc32c_copy(dst, src, size, STL_CRC32C_INIT);
+
+	STL_TSSP_CPU_sync_icache(dst, size);
+	*err = STL_ERROR_NONE;
+	return STL_CRC32C_FINAL(crc);
+}
+#endif /*STL_RELOCATED || STL_USE_OVERLAY*/
+
+/**
+ * @brief Synchronize the instruction stream with code written to memory.
+ * fence.i orders the previous stores before the following instruction fetches of this hart.
+ * @param addr Start of the written range (unused, the whole instruction cache is synchronized).
+ * @param size Size of the written range in bytes (unused).
+ * @return void
+ */
+void STL_TSSP_CPU_sync_icache(const void *addr, STL_INT32U_T size)
+{
+	(void)addr;
+	(void)size;
+	__asm__ volatile("fence.i" : : : "memory");
+}
+
 #if (STL_USE_MPU > 0u)
+/**
+ * The MPU profiles are programmed in the Physical Memory Protection (PMP) unit.
+ * Each region is a NAPOT entry; the access rights of STL_CPU_MPU_ACCESS_t have the
+ * same encoding as the R/W/X bits of pmpcfg.
+ */
+#define STL_CPU_PMP_A_NAPOT (3u << 3)						   /* Naturally aligned power-of-two region */
+#define STL_CPU_PMP_CFG_PER_REG (__riscv_xlen / 8)			   /* Entries per pmpcfg register */
+#define STL_CPU_PMP_CFG_REGS (STL_CPU_MPU_NUM_REGIONS / STL_CPU_PMP_CFG_PER_REG) /* pmpcfg registers used */
+
+#define STL_CPU_PMP_ADDR_CASE(n)                                                                                       \
+	case n:                                                                                                            \
+		__asm__ volatile("csrw pmpaddr" #n ", %0" : : "r"(value) : "memory");                                         \
+		break
+
+/**
+ * @brief Shadow copy of the pmpaddr and pmpcfg registers, used to write only what differs.
+ */
+STATIC_KEYWORD unsigned long cpu_pmp_addr_shadow[STL_CPU_MPU_NUM_REGIONS];
+STATIC_KEYWORD unsigned long cpu_pmp_cfg_shadow[STL_CPU_PMP_CFG_REGS];
+
+/**
+ * @brief Flag indicating that the shadow copy reflects the registers.
+ */
+STATIC_KEYWORD STL_BOOL cpu_pmp_shadow_valid = STL_FALSE;
+
+/**
+ * @brief Cost of the MPU profile switches.
+ */
+STATIC_KEYWORD STL_CPU_MPU_STATS_T cpu_mpu_stats;
+
+/**
+ * @brief Write a pmpaddr register.
+ * @param entry PMP entry.
+ * @param value Value to write.
+ */
+STATIC_KEYWORD void STL_TSSP_CPU_pmp_write_addr(STL_SIZE_T entry, unsigned long value)
+{
+	switch (entry)
+	{
+		STL_CPU_PMP_ADDR_CASE(0);
+		STL_CPU_PMP_ADDR_CASE(1);
+		STL_CPU_PMP_ADDR_CASE(2);
+		STL_CPU_PMP_ADDR_CASE(3);
+		STL_CPU_PMP_ADDR_CASE(4);
+		STL_CPU_PMP_ADDR_CASE(5);
+		STL_CPU_PMP_ADDR_CASE(6);
+		STL_CPU_PMP_ADDR_CASE(7);
+		STL_CPU_PMP_ADDR_CASE(8);
+		STL_CPU_PMP_ADDR_CASE(9);
+		STL_CPU_PMP_ADDR_CASE(10);
+		STL_CPU_PMP_ADDR_CASE(11);
+		STL_CPU_PMP_ADDR_CASE(12);
+		STL_CPU_PMP_ADDR_CASE(13);
+		STL_CPU_PMP_ADDR_CASE(14);
+		STL_CPU_PMP_ADDR_CASE(15);
+	default:
+		break;
+	}
+	cpu_pmp_addr_shadow[entry] = value;
+	cpu_mpu_stats.last_writes++;
+}
+
+/**
+ * @brief Write a pmpcfg register.
+ * On RV64 only the even pmpcfg registers exist.
+ * @param reg Index of the pmpcfg register among the used ones.
+ * @param value Value to write.
+ */
+STATIC_KEYWORD void STL_TSSP_CPU_pmp_write_cfg(STL_SIZE_T reg, unsigned long value)
+{
+	switch (reg)
+	{
+#if (__riscv_xlen == 32)
+	case 0:
+		__asm__ volatile("csrw pmpcfg0, %0" : : "r"(value) : "memory");
+		break;
+	case 1:
+		__asm__ volatile("csrw pmpcfg1, %0" : : "r"(value) : "memory");
+		break;
+	case 2:
+		__asm__ volatile("csrw pmpcfg2, %0" : : "r"(value) : "memory");
+		break;
+	case 3:
+		__asm__ volatile("csrw pmpcfg3, %0" : : "r"(value) : "memory");
+		break;
+#else
+	case 0:
+		__asm__ volatile("csrw pmpcfg0, %0" : : "r"(value) : "memory");
+		break;
+	case 1:
+		__asm__ volatile("csrw pmpcfg2, %0" : : "r"(value) : "memory");
+		break;
+#endif /*__riscv_xlen*/
+	default:
+		break;
+	}
+	cpu_pmp_cfg_shadow[reg] = value;
+	cpu_mpu_stats.last_writes++;
+}
+
 /**
  * @brief Configure the Memory Protection Unit (MPU).
- * This function is typically used to set up the MPU with the specified configuration parameters.
- * @param mpu_cfg Pointer to the MPU configuration structure.
- * @note The MPU configuration structure should contain the base address,
- * size, and access permissions for the memory region.
- * The actual implementation will depend on the specific CPU architecture.
+ * The regions of the profile are encoded as PMP NAPOT entries and compared with the
+ * shadow copy; only the pmpaddr and pmpcfg registers that differ are written.
+ * The addresses are written before the configurations, so that an entry is never
+ * enabled on a stale address. The entries beyond the profile are disabled.
+ * @param profile Pointer to the MPU profile.
+ * @param err Pointer to a variable to store error status.
  * @return void
- * @note Ensure that the mpu_cfg pointer is not NULL before accessing its members.
  */
-void STL_TSSP_CPU_configure_mpu(STL_CPU_MPU_CFG_t *mpu_cfg)
+void STL_TSSP_CPU_configure_mpu(const STL_CPU_MPU_PROFILE_T *profile, STL_ERROR_T *err)
 {
-	// Implementation of MPU configuration logic
-	// This function is typically used to configure the Memory Protection Unit (MPU)
-	// with the specified configuration parameters.
-	// The actual implementation will depend on the specific CPU architecture.
-	// Ensure that the mpu_cfg pointer is not NULL before accessing its members.
-	if (mpu_cfg != NULL)
+	STL_CYCLES_T start = STL_TSSP_CPU_get_cycles();
+	unsigned long cfg[STL_CPU_PMP_CFG_REGS] = {0u};
+	unsigned long addr;
+	STL_SIZE_T i;
+
+	if (profile->num_regions > STL_CPU_MPU_NUM_REGIONS)
 	{
-		// Configure the MPU with the provided base address, size, and access permissions
-		// The actual implementation will depend on the specific CPU architecture.
+		*err = STL_ERROR_MPU;
+		return;
 	}
-	return;
+	*err = STL_ERROR_NONE;
+
+	cpu_mpu_stats.last_writes = 0u;
+	for (i = 0; i < profile->num_regions; i++)
+	{
+		addr = ((unsigned long)profile->regions[i].base_address | ((profile->regions[i].size >> 1) - 1u)) >> 2;
+		if ((cpu_pmp_shadow_valid == STL_FALSE) || (cpu_pmp_addr_shadow[i] != addr))
+		{
+			STL_TSSP_CPU_pmp_write_addr(i, addr);
+		}
+		cfg[i / STL_CPU_PMP_CFG_PER_REG] |= ((unsigned long)profile->regions[i].access | STL_CPU_PMP_A_NAPOT)
+											<< (8u * (i % STL_CPU_PMP_CFG_PER_REG));
+	}
+
+	for (i = 0; i < STL_CPU_PMP_CFG_REGS; i++)
+	{
+		if ((cpu_pmp_shadow_valid == STL_FALSE) || (cpu_pmp_cfg_shadow[i] != cfg[i]))
+		{
+			STL_TSSP_CPU_pmp_write_cfg(i, cfg[i]);
+		}
+	}
+	cpu_pmp_shadow_valid = STL_TRUE;
+
+	cpu_mpu_stats.switches++;
+	cpu_mpu_stats.reg_writes += cpu_mpu_stats.last_writes;
+	cpu_mpu_stats.last_cycles = STL_TSSP_CPU_get_cycles() - start;
+	if (cpu_mpu_stats.last_cycles > cpu_mpu_stats.max_cycles)
+	{
+		cpu_mpu_stats.max_cycles = cpu_mpu_stats.last_cycles;
+	}
+}
+
+/**
+ * @brief Retrieve the cost of the MPU profile switches.
+ * @param stats Pointer to the statistics to fill.
+ * @return void
+ */
+void STL_TSSP_CPU_get_mpu_stats(STL_CPU_MPU_STATS_T *stats)
+{
+	*stats = cpu_mpu_stats;
 }
 #endif /*STL_USE_MPU*/
 
+#if (STL_USE_PMU > 0u)
+/**
+ * Read a 64-bit counter: on RV32 the high half is read twice to detect a carry between the reads.
+ */
+#if (__riscv_xlen == 32)
+#define STL_CPU_CSR_READ64(csr, value)                                                                                 \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		uint32_t hi_;                                                                                                  \
+		uint32_t lo_;                                                                                                  \
+		uint32_t hi2_;                                                                                                 \
+		do                                                                                                             \
+		{                                                                                                              \
+			__asm__ volatile("csrr %0, " #csr "h" : "=r"(hi_));                                                        \
+			__asm__ volatile("csrr %0, " #csr : "=r"(lo_));                                                            \
+			__asm__ volatile("csrr %0, " #csr "h" : "=r"(hi2_));                                                       \
+		} while (hi_ != hi2_);                                                                                         \
+		(value) = ((STL_CYCLES_T)hi_ << 32) | lo_;                                                                     \
+	} while (0)
+#else
+#define STL_CPU_CSR_READ64(csr, value) __asm__ volatile("csrr %0, " #csr : "=r"(value))
+#endif /*__riscv_xlen*/
+
+STATIC_KEYWORD const STL_PMU_EVENT_T cpu_pmu_events[STL_PMU_NUM_COUNTERS] = STL_PMU_EVENTS;
+
+/**
+ * @brief Counter CSR of each configured event: 0 (mcycle), 2 (minstret), 3 and above
+ * (mhpmcounterN), 0xFF if the event cannot be counted.
+ */
+STATIC_KEYWORD uint8_t cpu_pmu_csr[STL_PMU_NUM_COUNTERS];
+
+#define STL_CPU_PMU_NONE 0xFFu
+
+/**
+ * @brief Reads the counter CSR number n.
+ * @param n Counter number (0, 2, or 3 to 3 + STL_CPU_HPM_COUNTERS - 1).
+ * @return The counter value.
+ */
+STATIC_KEYWORD INLINE_KEYWORD STL_CYCLES_T STL_TSSP_CPU_pmu_read_csr(uint8_t n)
+{
+	STL_CYCLES_T value = 0u;
+
+	switch (n)
+	{
+	case 0u:
+		STL_CPU_CSR_READ64(mcycle, value);
+		break;
+	case 2u:
+		STL_CPU_CSR_READ64(minstret, value);
+		break;
+#if (STL_CPU_HPM_COUNTERS > 0u)
+	case 3u:
+		STL_CPU_CSR_READ64(mhpmcounter3, value);
+		break;
+#endif /*STL_CPU_HPM_COUNTERS*/
+#if (STL_CPU_HPM_COUNTERS > 1u)
+	case 4u:
+		STL_CPU_CSR_READ64(mhpmcounter4, value);
+		break;
+#endif /*STL_CPU_HPM_COUNTERS*/
+#if (STL_CPU_HPM_COUNTERS > 2u)
+	case 5u:
+		STL_CPU_CSR_READ64(mhpmcounter5, value);
+		break;
+#endif /*STL_CPU_HPM_COUNTERS*/
+	default:
+		break;
+	}
+	return value;
+}
+
+/**
+ * @brief Programs the event selector of the counter mhpmcounterN.
+ * @param n Counter number (3 to 3 + STL_CPU_HPM_COUNTERS - 1).
+ * @param selector Event selector.
+ * @return void
+ */
+STATIC_KEYWORD void STL_TSSP_CPU_pmu_select(uint8_t n, STL_INT32U_T selector)
+{
+	switch (n)
+	{
+#if (STL_CPU_HPM_COUNTERS > 0u)
+	case 3u:
+		__asm__ volatile("csrw mhpmevent3, %0" : : "r"(selector));
+		break;
+#endif /*STL_CPU_HPM_COUNTERS*/
+#if (STL_CPU_HPM_COUNTERS > 1u)
+	case 4u:
+		__asm__ volatile("csrw mhpmevent4, %0" : : "r"(selector));
+		break;
+#endif /*STL_CPU_HPM_COUNTERS*/
+#if (STL_CPU_HPM_COUNTERS > 2u)
+	case 5u:
+		__asm__ volatile("csrw mhpmevent5, %0" : : "r"(selector));
+		break;
+#endif /*STL_CPU_HPM_COUNTERS*/
+	default:
+		(void)selector;
+		break;
+	}
+}
+
+/**
+ * @brief Program the performance counters with the events of STL_PMU_EVENTS and start them.
+ * The cycles and the retired instructions are counted by mcycle and minstret; the branches
+ * and the interrupts are assigned to the first free mhpmcounters (up to three are used).
+ * The counters are free-running, they are neither stopped nor reset.
+ * @param err Pointer to a variable to store error status.
+ * @return Mask of the available counters.
+ */
+STL_INT32U_T STL_TSSP_CPU_pmu_init(STL_ERROR_T *err)
+{
+	STL_INT32U_T mask = 0u;
+	STL_INT32U_T inhibit = 0u;
+	uint8_t next = 3u;
+	STL_SIZE_T i;
+
+	for (i = 0u; i < STL_PMU_NUM_COUNTERS; i++)
+	{
+		STL_INT32U_T selector = 0u;
+
+		cpu_pmu_csr[i] = STL_CPU_PMU_NONE;
+		switch (cpu_pmu_events[i])
+		{
+		case STL_PMU_EVENT_CYCLES:
+			cpu_pmu_csr[i] = 0u;
+			break;
+		case STL_PMU_EVENT_INSTRUCTIONS:
+			cpu_pmu_csr[i] = 2u;
+			break;
+		case STL_PMU_EVENT_BRANCH_MISSES:
+			selector = STL_CPU_HPM_EVENT_BRANCH_TAKEN;
+			break;
+		case STL_PMU_EVENT_INTERRUPTS:
+			selector = STL_CPU_HPM_EVENT_INTR_TAKEN;
+			break;
+		default:
+			break;
+		}
+		if (selector != 0u && next < 3u + STL_CPU_HPM_COUNTERS && next <= 5u)
+		{
+			STL_TSSP_CPU_pmu_select(next, selector);
+			cpu_pmu_csr[i] = next;
+			next++;
+		}
+		if (cpu_pmu_csr[i] != STL_CPU_PMU_NONE)
+		{
+			inhibit |= 1u << cpu_pmu_csr[i];
+			mask |= 1u << i;
+		}
+	}
+
+	/* Clear the inhibit bits of the counters in use */
+	__asm__ volatile("csrc mcountinhibit, %0" : : "r"(inhibit));
+	*err = STL_ERROR_NONE;
+	return mask;
+}
+
+/**
+ * @brief Read the configured performance counters.
+ * @param sample Pointer to the snapshot to fill.
+ * @return void
+ */
+void STL_TSSP_CPU_pmu_read(STL_PMU_SAMPLE_T *sample)
+{
+	STL_SIZE_T i;
+
+	for (i = 0u; i < STL_PMU_NUM_COUNTERS; i++)
+	{
+		sample->count[i] = (cpu_pmu_csr[i] != STL_CPU_PMU_NONE) ? STL_TSSP_CPU_pmu_read_csr(cpu_pmu_csr[i]) : 0u;
+	}
+}
+
+/**
+ * @brief Stop the performance counters and release them.
+ * mcycle and minstret are left running (they are shared with STL_TSSP_CPU_get_cycles).
+ * @return void
+ */
+void STL_TSSP_CPU_pmu_deinit(void)
+{
+	STL_SIZE_T i;
+
+	for (i = 0u; i < STL_PMU_NUM_COUNTERS; i++)
+	{
+		if (cpu_pmu_csr[i] != STL_CPU_PMU_NONE && cpu_pmu_csr[i] >= 3u)
+		{
+			STL_TSSP_CPU_pmu_select(cpu_pmu_csr[i], 0u);
+		}
+		cpu_pmu_csr[i] = STL_CPU_PMU_NONE;
+	}
+}
+#endif /*STL_USE_PMU*/
+
+#if (STL_USE_ISA_DISPATCH > 0u)
+#define STL_CPU_MISA_V (1u << ('V' - 'A')) /* misa: vector extension */
+#define STL_CPU_MSTATUS_VS (3u << 9)		/* mstatus: vector state (0: off) */
+
+/**
+ * @brief Detect the ISA extensions the core can execute.
+ * A core without misa (read as zero) reports the baseline ISA only.
+ * @return Mask of STL_CPU_ISA_* extensions.
+ */
+STL_ISA_FEATURES_T STL_TSSP_CPU_get_isa_features(void)
+{
+	STL_ISA_FEATURES_T features = 0u;
+	unsigned long misa;
+	unsigned long mstatus;
+
+	__asm__ volatile("csrr %0, misa" : "=r"(misa));
+	__asm__ volatile("csrr %0, mstatus" : "=r"(mstatus));
+	if ((misa & STL_CPU_MISA_V) != 0u && (mstatus & STL_CPU_MSTATUS_VS) != 0u)
+	{
+		features |= STL_CPU_ISA_V;
+	}
+	return features;
+}
+#endif /*STL_USE_ISA_DISPATCH*/
+
+#if (STL_USE_CACHE_TEST > 0u)
+/**
+ * @brief Read the geometry of a data cache level.
+ * RISC-V has no architectural cache geometry registers and the CV32E40X has no data cache:
+ * the levels are reported absent.
+ * @param level Cache level.
+ * @param info Pointer to the geometry to fill (size 0).
+ * @param err Pointer to a variable to store error status.
+ * @return void
+ */
+void STL_TSSP_CPU_cache_get_info(STL_CPU_CACHE_LEVEL_T level, STL_CPU_CACHE_INFO_T *info, STL_ERROR_T *err)
+{
+	info->size = 0u;
+	info->line = 0u;
+	info->ways = 0u;
+	info->sets = 0u;
+	*err = (level >= STL_CPU_CACHE_LEVELS) ? STL_INDEX_OUT_OF_BOUNDS : STL_ERROR_NONE;
+}
+
+/**
+ * @brief Write back and invalidate the data cache lines of a range.
+ * With Zicbom each block is flushed (cbo.flush); without data cache the fence only orders
+ * the previous accesses.
+ * @param addr Start of the range.
+ * @param size Size of the range in bytes.
+ * @return void
+ */
+void STL_TSSP_CPU_cache_flush(const void *addr, STL_INT32U_T size)
+{
+#if defined(__riscv_zicbom)
+	uintptr_t block = (uintptr_t)addr & ~(uintptr_t)(STL_CPU_CACHE_BLOCK - 1u);
+
+	for (; block < (uintptr_t)addr + size; block += STL_CPU_CACHE_BLOCK)
+	{
+		__asm__ volatile("cbo.flush (%0)" : : "r"(block) : "memory");
+	}
+#else
+	(void)addr;
+	(void)size;
+#endif /*__riscv_zicbom*/
+	__asm__ volatile("fence rw, rw" : : : "memory");
+}
+
+/**
+ * @brief Invalidate the data cache lines of a range.
+ * With Zicbom each block is invalidated (cbo.inval); without data cache the fence only orders
+ * the previous accesses.
+ * @param addr Start of the range.
+ * @param size Size of the range in bytes.
+ * @param err Pointer to a variable to store error status.
+ * @return void
+ */
+void STL_TSSP_CPU_cache_invalidate(void *addr, STL_INT32U_T size, STL_ERROR_T *err)
+{
+#if defined(__riscv_zicbom)
+	uintptr_t block = (uintptr_t)addr & ~(uintptr_t)(STL_CPU_CACHE_BLOCK - 1u);
+
+	__asm__ volatile("fence rw, rw" : : : "memory");
+	for (; block < (uintptr_t)addr + size; block += STL_CPU_CACHE_BLOCK)
+	{
+		__asm__ volatile("cbo.inval (%0)" : : "r"(block) : "memory");
+	}
+#else
+	(void)addr;
+	(void)size;
+#endif /*__riscv_zicbom*/
+	__asm__ volatile("fence rw, rw" : : : "memory");
+	*err = STL_ERROR_NONE;
+}
+
+/**
+ * @brief Lock the data cache lines of a range.
+ * Cache locking is not part of the RISC-V ISA.
+ * @param addr Start of the range (unused).
+ * @param size Size of the range in bytes (unused).
+ * @param err Pointer to a variable to store error status (always STL_ERROR_NOT_IMPLEMENTED).
+ * @return void
+ */
+void STL_TSSP_CPU_cache_lock(const void *addr, STL_INT32U_T size, STL_ERROR_T *err)
+{
+	(void)addr;
+	(void)size;
+	*err = STL_ERROR_NOT_IMPLEMENTED;
+}
+
+/**
+ * @brief Unlock the data cache lines of a range.
+ * @param addr Start of the range (unused).
+ * @param size Size of the range in bytes (unused).
+ * @param err Pointer to a variable to store error status (always STL_ERROR_NOT_IMPLEMENTED).
+ * @return void
+ */
+void STL_TSSP_CPU_cache_unlock(const void *addr, STL_INT32U_T size, STL_ERROR_T *err)
+{
+	(void)addr;
+	(void)size;
+	*err = STL_ERROR_NOT_IMPLEMENTED;
+}
+#endif /*STL_USE_CACHE_TEST*/
+
 #endif /* STL_AL_CPU_MODULE */
 #endif /*__STL__*/
\ No newline at end of file
@@ -19,11 +19,66 @@
  * It is used to determine the number of CPU-specific configurations and operations that can be performed.
  * The value is set to 2 for systems with two CPUs.
  * @note This value may need to be adjusted based on the actual number of CPUs in the system.
+ *       The build configuration (meson option num_cpus) takes precedence.
  * @see STL_CPU_MPU_CFG_t for Memory Protection Unit configuration.
  * @see STL_TSSP_CPU_configure_mpu for configuring the MPU.
  * @see STL_TSSP_CPU_restore_ivor for restoring the interrupt vector table.
  */
+#ifndef STL_NUM_CPU
 #define STL_NUM_CPU 2u
+#endif /*STL_NUM_CPU*/
+
+/**
+ * STL_CPU_MTVEC_MODE
+ * @brief mtvec mode used for the STL exception table.
+ * 0 selects the direct mode (all traps jump to the table base),
+ * 1 selects the vectored mode (interrupts jump to base + 4 * cause).
+ * @see STL_TSSP_CPU_swap_ivor
+ */
+#define STL_CPU_MTVEC_MODE 0u
+
+/**
+ * STL_CPU_MPU_NUM_REGIONS
+ * @brief Number of PMP entries used for the MPU profiles.
+ * Each region is programmed as one NAPOT entry (pmpaddrN) and one byte of pmpcfg.
+ */
+#define STL_CPU_MPU_NUM_REGIONS 16u
+
+/**
+ * STL_CPU_HPM_COUNTERS
+ * @brief Number of implemented event counters (mhpmcounter3 onward).
+ * mcycle and minstret are always used; the other events of STL_PMU_EVENTS are assigned to
+ * mhpmcounter3, mhpmcounter4, ... as long as counters are available. On the CV32E40X
+ * this is the NUM_MHPMCOUNTERS parameter of the core (0 when the counters are not implemented).
+ */
+#ifndef STL_CPU_HPM_COUNTERS
+#define STL_CPU_HPM_COUNTERS 0u
+#endif /*STL_CPU_HPM_COUNTERS*/
+
+/**
+ * STL_CPU_HPM_EVENT_*
+ * @brief mhpmevent selectors of the CV32E40X.
+ * The core has neither caches nor a branch predictor: the taken branches (which flush the
+ * prefetched instructions) stand in for the mispredictions, and the cache misses cannot be counted.
+ */
+#define STL_CPU_HPM_EVENT_BRANCH_TAKEN (1u << 5) /* Taken conditional branches */
+#define STL_CPU_HPM_EVENT_INTR_TAKEN (1u << 6)	  /* Interrupts taken */
+
+/**
+ * STL_CPU_ISA_*
+ * @brief ISA extensions reported by STL_TSSP_CPU_get_isa_features (misa, state enabled in mstatus).
+ * - V: vector extension, with the vector state not off (mstatus.VS).
+ */
+#define STL_CPU_ISA_V 0x1u
+
+/**
+ * STL_CPU_CACHE_BLOCK
+ * @brief Cache block size of the Zicbom cache-block management instructions, in bytes.
+ * The CV32E40X has no data cache: the cache services only order the memory accesses.
+ */
+#ifndef STL_CPU_CACHE_BLOCK
+#define STL_CPU_CACHE_BLOCK 64u
+#endif /*STL_CPU_CACHE_BLOCK*/
 
 #endif /*__STL_AL_CPU_H__*/
 #endif /*__STL__*/
\ No newline at end of file
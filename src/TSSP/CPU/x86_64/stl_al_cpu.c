@@ -0,0 +1,904 @@
+#if __STL__
+#include "stl_al_cpu.h"
+#include "stl_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+#if (STL_RELOCATED > 0u || STL_USE_OVERLAY > 0u)
+#include "stl_crc.h"
+#endif /*STL_RELOCATED || STL_USE_OVERLAY*/
+
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <x86intrin.h>
+
+#if (STL_USE_ISA_DISPATCH > 0u || STL_USE_CACHE_TEST > 0u)
+#include <cpuid.h>
+#endif /*STL_USE_ISA_DISPATCH || STL_USE_CACHE_TEST*/
+
+#if (STL_USE_PMU > 0u)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif /*STL_USE_PMU*/
+
+#ifndef STL_AL_CPU_MODULE
+#define STL_AL_CPU_MODULE
+
+/**
+ * Host equivalent of the exception vector table.
+ * The synchronous exceptions raised by a test (illegal instruction, memory fault, bus error,
+ * arithmetic error, breakpoint) are delivered as signals. A single dispatcher is installed
+ * once for all of them; it reads a "vector base" pointer and calls the handler of the
+ * corresponding slot. Swapping and restoring the vectors only retarget that pointer,
+ * exactly as mtvec/VBAR are retargeted on the targets: no sigaction call is issued per test.
+ * While the application table is selected, the dispatcher forwards the signal to the
+ * action the application had installed before the STL.
+ * A synchronous signal is delivered to the thread that raised it: the vector base is
+ * thread-local, as the vector base register is private to each CPU of a multicore SoC.
+ */
+STATIC_KEYWORD const int cpu_trap_signals[STL_CPU_HOST_TRAP_NUM] = {SIGILL, SIGSEGV, SIGBUS, SIGFPE, SIGTRAP};
+
+/**
+ * @brief Actions installed by the application before the STL dispatcher.
+ */
+STATIC_KEYWORD struct sigaction cpu_app_actions[STL_CPU_HOST_TRAP_NUM];
+
+/**
+ * @brief Installation of the dispatcher, done once by the first CPU swapping its vectors.
+ */
+STATIC_KEYWORD pthread_once_t cpu_dispatcher_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Current vector base of the calling CPU, STL_NULL while the application vectors are selected.
+ */
+STATIC_KEYWORD __thread const STL_CPU_HOST_TRAP_HANDLER_PTR_T *volatile cpu_vector_base = STL_NULL;
+
+/**
+ * @brief Cycle measurements of the swap and restore on the calling CPU.
+ */
+STATIC_KEYWORD __thread STL_CPU_IVOR_STATS_T cpu_ivor_stats;
+
+/**
+ * @brief Forwards a trap to the action installed by the application.
+ * An ignored signal is dropped. For the default action, the action is installed for the
+ * time of a re-raise, so that the process terminates exactly as it would have without the
+ * STL; the dispatcher is installed back if the process survives the default action.
+ * @param slot Trap slot.
+ * @param signo Signal number.
+ * @param info Signal information.
+ * @param ctx Interrupted context.
+ */
+STATIC_KEYWORD void STL_TSSP_CPU_trap_forward(STL_SIZE_T slot, int signo, siginfo_t *info, void *ctx)
+{
+	const struct sigaction *app = &cpu_app_actions[slot];
+	struct sigaction dispatcher;
+
+	if ((app->sa_flags & SA_SIGINFO) != 0)
+	{
+		app->sa_sigaction(signo, info, ctx);
+	}
+	else if (app->sa_handler == SIG_IGN)
+	{
+		return;
+	}
+	else if (app->sa_handler != SIG_DFL)
+	{
+		app->sa_handler(signo);
+	}
+	else
+	{
+		sigaction(signo, app, &dispatcher);
+		raise(signo);
+		sigaction(signo, &dispatcher, STL_NULL);
+	}
+}
+
+/**
+ * @brief Trap hook of the STL exception table.
+ * Intrusive tests that trap on purpose override this weak hook (e.g. to record the trap and
+ * resume with siglongjmp). The default forwards the trap to the application action.
+ * @param signo Signal number.
+ * @param info Signal information.
+ * @param ctx Interrupted context.
+ * @return void
+ */
+WEAK_KEYWORD void STL_TSSP_CPU_trap(int signo, siginfo_t *info, void *ctx)
+{
+	STL_SIZE_T slot;
+
+	for (slot = 0; slot < STL_CPU_HOST_TRAP_NUM; slot++)
+	{
+		if (cpu_trap_signals[slot] == signo)
+		{
+			STL_TSSP_CPU_trap_forward(slot, signo, info, ctx);
+			return;
+		}
+	}
+}
+
+/**
+ * @brief Prebuilt STL exception table.
+ * Placed in .stl_exception_table like the target tables; one entry per trap slot.
+ */
+__attribute__((section(".stl_exception_table"), used)) const STL_CPU_HOST_TRAP_HANDLER_PTR_T STL_CPU_host_exception_table[STL_CPU_HOST_TRAP_NUM] = {
+	STL_TSSP_CPU_trap, STL_TSSP_CPU_trap, STL_TSSP_CPU_trap, STL_TSSP_CPU_trap, STL_TSSP_CPU_trap};
+
+/**
+ * @brief Signal dispatcher, equivalent of the trap entry.
+ * @param signo Signal number.
+ * @param info Signal information.
+ * @param ctx Interrupted context.
+ */
+STATIC_KEYWORD void STL_TSSP_CPU_trap_dispatch(int signo, siginfo_t *info, void *ctx)
+{
+	const STL_CPU_HOST_TRAP_HANDLER_PTR_T *base = cpu_vector_base;
+	STL_SIZE_T slot;
+
+	for (slot = 0; slot < STL_CPU_HOST_TRAP_NUM; slot++)
+	{
+		if (cpu_trap_signals[slot] == signo)
+		{
+			break;
+		}
+	}
+	if (slot == STL_CPU_HOST_TRAP_NUM)
+	{
+		return;
+	}
+
+	if (base != STL_NULL)
+	{
+		base[slot](signo, info, ctx);
+	}
+	else
+	{
+		STL_TSSP_CPU_trap_forward(slot, signo, info, ctx);
+	}
+}
+
+/**
+ * @brief Installs the dispatcher once, saving the actions of the application.
+ */
+STATIC_KEYWORD void STL_TSSP_CPU_install_dispatcher(void)
+{
+	struct sigaction sa;
+	STL_SIZE_T slot;
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_sigaction = STL_TSSP_CPU_trap_dispatch;
+	sa.sa_flags = SA_SIGINFO | SA_NODEFER;
+	sigemptyset(&sa.sa_mask);
+	for (slot = 0; slot < STL_CPU_HOST_TRAP_NUM; slot++)
+	{
+		sigaction(cpu_trap_signals[slot], &sa, &cpu_app_actions[slot]);
+	}
+}
+
+/**
+ * @brief Restore the interrupt vector table or save the current state.
+ * The vector base is retargeted to the application actions.
+ * @return void
+ */
+void STL_TSSP_CPU_restore_ivor(void)
+{
+	STL_CYCLES_T start = STL_TSSP_CPU_get_cycles();
+
+	cpu_vector_base = STL_NULL;
+
+	cpu_ivor_stats.last_restore_cycles = STL_TSSP_CPU_get_cycles() - start;
+	if (cpu_ivor_stats.last_restore_cycles > cpu_ivor_stats.max_restore_cycles)
+	{
+		cpu_ivor_stats.max_restore_cycles = cpu_ivor_stats.last_restore_cycles;
+	}
+	return;
+}
+/**
+ * @brief Swap the interrupt vector table or restore the previous state.
+ * The vector base is retargeted to the prebuilt STL exception table; the dispatcher is
+ * installed at the first call only.
+ * @return void
+ */
+void STL_TSSP_CPU_swap_ivor(void)
+{
+	STL_CYCLES_T start;
+
+	pthread_once(&cpu_dispatcher_once, STL_TSSP_CPU_install_dispatcher);
+
+	start = STL_TSSP_CPU_get_cycles();
+	cpu_vector_base = STL_CPU_host_exception_table;
+
+	cpu_ivor_stats.swaps++;
+	cpu_ivor_stats.last_swap_cycles = STL_TSSP_CPU_get_cycles() - start;
+	if (cpu_ivor_stats.last_swap_cycles > cpu_ivor_stats.max_swap_cycles)
+	{
+		cpu_ivor_stats.max_swap_cycles = cpu_ivor_stats.last_swap_cycles;
+	}
+	return;
+}
+
+/**
+ * @brief Retrieve the cycle measurements of the exception vector swap and restore.
+ * The measurements are those of the calling CPU (thread).
+ * @param stats Pointer to the statistics to fill.
+ * @return void
+ */
+void STL_TSSP_CPU_get_ivor_stats(STL_CPU_IVOR_STATS_T *stats)
+{
+	*stats = cpu_ivor_stats;
+}
+
+/**
+ * @brief Read the free-running CPU cycle counter.
+ * The time-stamp counter is used; on all recent x86_64 parts it is invariant
+ * (constant rate, not affected by frequency scaling).
+ * @return The current value of the cycle counter.
+ */
+STL_CYCLES_T STL_TSSP_CPU_get_cycles(void)
+{
+	return (STL_CYCLES_T)__rdtsc();
+}
+
+#if (STL_MULTICORE_SOC > 0u)
+/**
+ * @brief Hint the CPU that it is spinning on a shared variable.
+ * pause avoids the memory-order machine clear at the exit of the loop and gives the
+ * execution resources to the SMT sibling.
+ * @return void
+ */
+void STL_TSSP_CPU_relax(void)
+{
+	_mm_pause();
+}
+#endif /*STL_MULTICORE_SOC*/
+
+#if (STL_RELOCATED > 0u || STL_USE_OVERLAY > 0u)
+/**
+ * @brief Copy-and-CRC routine selected for the host ISA.
+ */
+typedef STL_INT32U_T (*STL_CPU_RELOCATE_PTR_T)(const uint8_t *src, uint8_t *dst, STL_INT32U_T size, STL_INT32U_T crc);
+
+/**
+ * @brief Copy-and-CRC with 32-byte AVX2 bursts.
+ * The CRC is computed with the SSE4.2 crc32 instruction on the burst just loaded
+ * (the second read hits the L1 cache).
+ */
+__attribute__((target("avx2,sse4.2"))) STATIC_KEYWORD STL_INT32U_T
+STL_TSSP_CPU_relocate_avx2(const uint8_t *src, uint8_t *dst, STL_INT32U_T size, STL_INT32U_T crc)
+{
+	uint64_t c = crc;
+	uint64_t q[4];
+
+	for (; size >= sizeof(__m256i); size -= sizeof(__m256i))
+	{
+		__m256i v = _mm256_loadu_si256((const __m256i *)src);
+
+		_mm256_storeu_si256((__m256i *)dst, v);
+		memcpy(q, src, sizeof(q));
+		c = _mm_crc32_u64(c, q[0]);
+		c = _mm_crc32_u64(c, q[1]);
+		c = _mm_crc32_u64(c, q[2]);
+		c = _mm_crc32_u64(c, q[3]);
+		src += sizeof(__m256i);
+		dst += sizeof(__m256i);
+	}
+	for (; size > 0u; size--)
+	{
+		*dst++ = *src;
+		c = _mm_crc32_u8((STL_INT32U_T)c, *src++);
+	}
+	return (STL_INT32U_T)c;
+}
+
+/**
+ * @brief Copy-and-CRC with 16-byte SSE bursts.
+ */
+__attribute__((target("sse4.2"))) STATIC_KEYWORD STL_INT32U_T
+STL_TSSP_CPU_relocate_sse(const uint8_t *src, uint8_t *dst, STL_INT32U_T size, STL_INT32U_T crc)
+{
+	uint64_t c = crc;
+	uint64_t q[2];
+
+	for (; size >= sizeof(__m128i); size -= sizeof(__m128i))
+	{
+		__m128i v = _mm_loadu_si128((const __m128i *)src);
+
+		_mm_storeu_si128((__m128i *)dst, v);
+		memcpy(q, src, sizeof(q));
+		c = _mm_crc32_u64(c, q[0]);
+		c = _mm_crc32_u64(c, q[1]);
+		src += sizeof(__m128i);
+		dst += sizeof(__m128i);
+	}
+	for (; size > 0u; size--)
+	{
+		*dst++ = *src;
+		c = _mm_crc32_u8((STL_INT32U_T)c, *src++);
+	}
+	return (STL_INT32U_T)c;
+}
+
+/**
+ * @brief Portable copy-and-CRC (word bursts, table-driven CRC).
+ */
+STATIC_KEYWORD STL_INT32U_T STL_TSSP_CPU_relocate_generic(const uint8_t *src, uint8_t *dst, STL_INT32U_T size,
+														  STL_INT32U_T crc)
+{
+	return STL_crc32c_copy(dst, src, size, crc);
+}
+
+/**
+ * @brief Relocate a block of code or data and compute its CRC-32C in the same pass.
+ * The routine is selected at the first call from the ISA extensions of the host:
+ * AVX2 + SSE4.2, SSE4.2, or the portable word copy.
+ * @param src Source address.
+ * @param dst Destination address.
+ * @param size Size of the block in bytes.
+ * @param err Pointer to a variable to store error status.
+ * @return The CRC-32C of the copied block.
+ */
+STL_INT32U_T STL_TSSP_CPU_relocate(const void *src, void *dst, STL_INT32U_T size, STL_ERROR_T *err)
+{
+	STATIC_KEYWORD STL_CPU_RELOCATE_PTR_T relocate = STL_NULL;
+
+	if (relocate == STL_NULL)
+	{
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("sse4.2"))
+		{
+			relocate = STL_TSSP_CPU_relocate_avx2;
+		}
+		else if (__builtin_cpu_supports("sse4.2"))
+		{
+			relocate = STL_TSSP_CPU_relocate_sse;
+		}
+		else
+		{
+			relocate = STL_TSSP_CPU_relocate_generic;
+		}
+	}
+
+	*err = STL_ERROR_NONE;
+	return STL_CRC32C_FINAL(relocate((const uint8_t *)src, (uint8_t *)dst, size, STL_CRC32C_INIT));
+}
+#endif /*STL_RELOCATED || STL_USE_OVERLAY*/
+
+/**
+ * @brief Synchronize the instruction stream with code written to memory.
+ * The x86 instruction caches are coherent with the data writes; nothing to do.
+ * @param addr Start of the written range.
+ * @param size Size of the written range in bytes.
+ * @return void
+ */
+void STL_TSSP_CPU_sync_icache(const void *addr, STL_INT32U_T size)
+{
+	(void)addr;
+	(void)size;
+}
+
+#if (STL_USE_MPU > 0u)
+/**
+ * Host model of the MPU.
+ * There is no MPU on the host: the registers are modelled by an array, so that the
+ * register writes issued by a profile switch can be counted and checked.
+ * Each region has a base register and an attribute register (size, access, enable).
+ */
+#define STL_CPU_MPU_RASR_ENABLE 1u /* Region enable bit of the attribute register */
+#define STL_CPU_MPU_RASR_SIZE_POS 1u  /* Position of the log2(size) - 1 field */
+#define STL_CPU_MPU_RASR_ACCESS_POS 8u /* Position of the access field */
+
+/**
+ * @brief Modelled MPU registers, as seen by the hardware.
+ */
+STATIC_KEYWORD STL_INT32U_T cpu_mpu_regs[STL_CPU_MPU_NUM_REGIONS][2];
+
+/**
+ * @brief Shadow copy of the MPU registers, used to write only what differs.
+ */
+STATIC_KEYWORD STL_INT32U_T cpu_mpu_shadow[STL_CPU_MPU_NUM_REGIONS][2];
+
+/**
+ * @brief Flag indicating that the shadow copy reflects the registers.
+ */
+STATIC_KEYWORD STL_BOOL cpu_mpu_shadow_valid = STL_FALSE;
+
+/**
+ * @brief Cost of the MPU profile switches.
+ */
+STATIC_KEYWORD STL_CPU_MPU_STATS_T cpu_mpu_stats;
+
+/**
+ * @brief Write a modelled MPU register.
+ * @param region Region number.
+ * @param reg Register (0 base, 1 attributes).
+ * @param value Value to write.
+ */
+STATIC_KEYWORD INLINE_KEYWORD void STL_TSSP_CPU_mpu_write(STL_SIZE_T region, STL_SIZE_T reg, STL_INT32U_T value)
+{
+	*(volatile STL_INT32U_T *)&cpu_mpu_regs[region][reg] = value;
+	cpu_mpu_shadow[region][reg] = value;
+	cpu_mpu_stats.last_writes++;
+}
+
+/**
+ * @brief Configure the Memory Protection Unit (MPU).
+ * The regions of the profile are encoded and compared with the shadow copy; only the
+ * registers that differ are written. The regions beyond the profile are disabled.
+ * @param profile Pointer to the MPU profile.
+ * @param err Pointer to a variable to store error status.
+ * @return void
+ */
+void STL_TSSP_CPU_configure_mpu(const STL_CPU_MPU_PROFILE_T *profile, STL_ERROR_T *err)
+{
+	STL_CYCLES_T start = STL_TSSP_CPU_get_cycles();
+	STL_INT32U_T rbar;
+	STL_INT32U_T rasr;
+	STL_SIZE_T i;
+
+	if (profile->num_regions > STL_CPU_MPU_NUM_REGIONS)
+	{
+		*err = STL_ERROR_MPU;
+		return;
+	}
+	*err = STL_ERROR_NONE;
+
+	cpu_mpu_stats.last_writes = 0u;
+	for (i = 0; i < STL_CPU_MPU_NUM_REGIONS; i++)
+	{
+		if (i < profile->num_regions)
+		{
+			rbar = profile->regions[i].base_address;
+			rasr = ((STL_INT32U_T)(31 - __builtin_clz(profile->regions[i].size) - 1) << STL_CPU_MPU_RASR_SIZE_POS) |
+				   ((STL_INT32U_T)profile->regions[i].access << STL_CPU_MPU_RASR_ACCESS_POS) | STL_CPU_MPU_RASR_ENABLE;
+		}
+		else
+		{
+			rbar = 0u;
+			rasr = 0u;
+		}
+
+		/* The region is disabled before its base is moved, and enabled afterward */
+		if ((cpu_mpu_shadow_valid == STL_FALSE) || (cpu_mpu_shadow[i][0] != rbar))
+		{
+			if ((cpu_mpu_shadow[i][1] & STL_CPU_MPU_RASR_ENABLE) != 0u)
+			{
+				STL_TSSP_CPU_mpu_write(i, 1u, 0u);
+			}
+			STL_TSSP_CPU_mpu_write(i, 0u, rbar);
+		}
+		if ((cpu_mpu_shadow_valid == STL_FALSE) || (cpu_mpu_shadow[i][1] != rasr))
+		{
+			STL_TSSP_CPU_mpu_write(i, 1u, rasr);
+		}
+	}
+	cpu_mpu_shadow_valid = STL_TRUE;
+
+	cpu_mpu_stats.switches++;
+	cpu_mpu_stats.reg_writes += cpu_mpu_stats.last_writes;
+	cpu_mpu_stats.last_cycles = STL_TSSP_CPU_get_cycles() - start;
+	if (cpu_mpu_stats.last_cycles > cpu_mpu_stats.max_cycles)
+	{
+		cpu_mpu_stats.max_cycles = cpu_mpu_stats.last_cycles;
+	}
+}
+
+/**
+ * @brief Retrieve the cost of the MPU profile switches.
+ * @param stats Pointer to the statistics to fill.
+ * @return void
+ */
+void STL_TSSP_CPU_get_mpu_stats(STL_CPU_MPU_STATS_T *stats)
+{
+	*stats = cpu_mpu_stats;
+}
+#endif /*STL_USE_MPU*/
+
+#if (STL_USE_PMU > 0u)
+/**
+ * Host performance counters.
+ * The events are opened with perf_event_open as a single group (the first event opened is
+ * the leader), counting the calling thread in user mode only, so that the whole group is
+ * read with one read() and all the counters are scheduled on the PMU together.
+ * STL_PMU_EVENT_INTERRUPTS is mapped onto the context switches of the thread: on the host,
+ * the interrupts that disturb a test show up as preemptions.
+ * When the PMU is not exposed (virtual machines, containers), the hardware events cannot be
+ * opened: the cycles are then read from the time-stamp counter and the other counters read zero.
+ */
+STATIC_KEYWORD const STL_PMU_EVENT_T cpu_pmu_events[STL_PMU_NUM_COUNTERS] = STL_PMU_EVENTS;
+
+/**
+ * @brief File descriptor of the group leader, -1 if no event could be opened.
+ */
+STATIC_KEYWORD int cpu_pmu_leader = -1;
+
+/**
+ * @brief File descriptors of the events, -1 for the events that could not be opened.
+ */
+STATIC_KEYWORD int cpu_pmu_fd[STL_PMU_NUM_COUNTERS];
+
+/**
+ * @brief Position of each counter in the group read buffer, -1 if the counter is not opened.
+ */
+STATIC_KEYWORD int cpu_pmu_slot[STL_PMU_NUM_COUNTERS];
+
+/**
+ * @brief Number of events in the group.
+ */
+STATIC_KEYWORD STL_SIZE_T cpu_pmu_opened = 0u;
+
+/**
+ * @brief Set if the cycles are read from the time-stamp counter.
+ */
+STATIC_KEYWORD STL_BOOL cpu_pmu_tsc_cycles = STL_FALSE;
+
+/**
+ * @brief Opens one event in the group.
+ * @param event Event to open.
+ * @return The file descriptor of the event, -1 if the event is not available.
+ */
+STATIC_KEYWORD int STL_TSSP_CPU_pmu_open(STL_PMU_EVENT_T event)
+{
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HARDWARE;
+	switch (event)
+	{
+	case STL_PMU_EVENT_CYCLES:
+		attr.config = PERF_COUNT_HW_CPU_CYCLES;
+		break;
+	case STL_PMU_EVENT_INSTRUCTIONS:
+		attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+		break;
+	case STL_PMU_EVENT_CACHE_MISSES:
+		attr.config = PERF_COUNT_HW_CACHE_MISSES;
+		break;
+	case STL_PMU_EVENT_BRANCH_MISSES:
+		attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+		break;
+	default:
+		attr.type = PERF_TYPE_SOFTWARE;
+		attr.config = PERF_COUNT_SW_CONTEXT_SWITCHES;
+		break;
+	}
+	attr.read_format = PERF_FORMAT_GROUP;
+	attr.disabled = (cpu_pmu_leader == -1) ? 1u : 0u;
+	attr.exclude_kernel = 1u;
+	attr.exclude_hv = 1u;
+
+	return (int)syscall(SYS_perf_event_open, &attr, 0, -1, cpu_pmu_leader, 0);
+}
+
+/**
+ * @brief Program the performance counters with the events of STL_PMU_EVENTS and start them.
+ * @param err Pointer to a variable to store error status.
+ * @return Mask of the available counters.
+ */
+STL_INT32U_T STL_TSSP_CPU_pmu_init(STL_ERROR_T *err)
+{
+	STL_INT32U_T mask = 0u;
+	STL_SIZE_T i;
+
+	STL_TSSP_CPU_pmu_deinit();
+	for (i = 0u; i < STL_PMU_NUM_COUNTERS; i++)
+	{
+		cpu_pmu_fd[i] = STL_TSSP_CPU_pmu_open(cpu_pmu_events[i]);
+		cpu_pmu_slot[i] = -1;
+		if (cpu_pmu_fd[i] >= 0)
+		{
+			if (cpu_pmu_leader == -1)
+			{
+				cpu_pmu_leader = cpu_pmu_fd[i];
+			}
+			cpu_pmu_slot[i] = (int)cpu_pmu_opened;
+			cpu_pmu_opened++;
+			mask |= 1u << i;
+		}
+		else if (cpu_pmu_events[i] == STL_PMU_EVENT_CYCLES)
+		{
+			cpu_pmu_tsc_cycles = STL_TRUE;
+			mask |= 1u << i;
+		}
+	}
+
+	if (cpu_pmu_leader != -1)
+	{
+		ioctl(cpu_pmu_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(cpu_pmu_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+	*err = STL_ERROR_NONE;
+	return mask;
+}
+
+/**
+ * @brief Read the configured performance counters.
+ * The group is read with a single system call: {nr, value[nr]} in the order the events were opened.
+ * @param sample Pointer to the snapshot to fill.
+ * @return void
+ */
+void STL_TSSP_CPU_pmu_read(STL_PMU_SAMPLE_T *sample)
+{
+	uint64_t values[STL_PMU_NUM_COUNTERS + 1u];
+	STL_CYCLES_T tsc = __rdtsc();
+	STL_SIZE_T i;
+
+	if (cpu_pmu_leader == -1 ||
+		read(cpu_pmu_leader, values, (cpu_pmu_opened + 1u) * sizeof(uint64_t)) !=
+			(ssize_t)((cpu_pmu_opened + 1u) * sizeof(uint64_t)))
+	{
+		values[0] = 0u;
+	}
+
+	for (i = 0u; i < STL_PMU_NUM_COUNTERS; i++)
+	{
+		if (cpu_pmu_slot[i] >= 0 && values[0] != 0u)
+		{
+			sample->count[i] = values[1 + cpu_pmu_slot[i]];
+		}
+		else if (cpu_pmu_tsc_cycles == STL_TRUE && cpu_pmu_events[i] == STL_PMU_EVENT_CYCLES)
+		{
+			sample->count[i] = tsc;
+		}
+		else
+		{
+			sample->count[i] = 0u;
+		}
+	}
+}
+
+/**
+ * @brief Stop the performance counters and release them.
+ * @return void
+ */
+void STL_TSSP_CPU_pmu_deinit(void)
+{
+	STL_SIZE_T i;
+
+	if (cpu_pmu_leader != -1)
+	{
+		for (i = 0u; i < STL_PMU_NUM_COUNTERS; i++)
+		{
+			if (cpu_pmu_fd[i] >= 0 && cpu_pmu_fd[i] != cpu_pmu_leader)
+			{
+				close(cpu_pmu_fd[i]);
+			}
+		}
+		close(cpu_pmu_leader);
+	}
+	cpu_pmu_leader = -1;
+	cpu_pmu_opened = 0u;
+	cpu_pmu_tsc_cycles = STL_FALSE;
+	for (i = 0u; i < STL_PMU_NUM_COUNTERS; i++)
+	{
+		cpu_pmu_fd[i] = -1;
+		cpu_pmu_slot[i] = -1;
+	}
+}
+#endif /*STL_USE_PMU*/
+
+#if (STL_USE_ISA_DISPATCH > 0u)
+#define STL_CPU_CPUID_SSE41 (1u << 19)	 /* CPUID.1:ECX */
+#define STL_CPU_CPUID_SSE42 (1u << 20)	 /* CPUID.1:ECX */
+#define STL_CPU_CPUID_FMA (1u << 12)	 /* CPUID.1:ECX */
+#define STL_CPU_CPUID_OSXSAVE (1u << 27) /* CPUID.1:ECX */
+#define STL_CPU_CPUID_AVX (1u << 28)	 /* CPUID.1:ECX */
+#define STL_CPU_CPUID_AVX2 (1u << 5)	 /* CPUID.7.0:EBX */
+#define STL_CPU_CPUID_AVX512                                                                                           \
+	((1u << 16) | (1u << 17) | (1u << 30) | (1u << 31)) /* CPUID.7.0:EBX: AVX-512 F, DQ, BW, VL */
+#define STL_CPU_XCR0_YMM 0x06u	 /* XCR0: SSE and AVX state */
+#define STL_CPU_XCR0_ZMM 0xE0u	 /* XCR0: opmask, ZMM_Hi256 and Hi16_ZMM state */
+
+/**
+ * @brief Read the extended control register XCR0 (state components enabled by the OS).
+ * Only called when CPUID reports OSXSAVE.
+ */
+STATIC_KEYWORD STL_INT32U_T STL_TSSP_CPU_xgetbv(void)
+{
+	STL_INT32U_T eax;
+	STL_INT32U_T edx;
+
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0u));
+	(void)edx;
+	return eax;
+}
+
+/**
+ * @brief Detect the ISA extensions the host CPU can execute.
+ * The extensions are read from CPUID; the AVX-class ones are only reported when the OS
+ * has enabled their register state in XCR0 (otherwise they raise #UD even on capable silicon).
+ * @return Mask of STL_CPU_ISA_* extensions.
+ */
+STL_ISA_FEATURES_T STL_TSSP_CPU_get_isa_features(void)
+{
+	STL_ISA_FEATURES_T features = 0u;
+	unsigned int eax;
+	unsigned int ebx;
+	unsigned int ecx;
+	unsigned int edx;
+	unsigned int leaf7_ebx = 0u;
+	STL_INT32U_T xcr0 = 0u;
+
+	if (__get_cpuid(1u, &eax, &ebx, &ecx, &edx) == 0)
+	{
+		return features;
+	}
+	if ((ecx & (STL_CPU_CPUID_SSE41 | STL_CPU_CPUID_SSE42)) == (STL_CPU_CPUID_SSE41 | STL_CPU_CPUID_SSE42))
+	{
+		features |= STL_CPU_ISA_SSE42;
+	}
+	if ((ecx & STL_CPU_CPUID_OSXSAVE) != 0u)
+	{
+		xcr0 = STL_TSSP_CPU_xgetbv();
+	}
+	if ((xcr0 & STL_CPU_XCR0_YMM) != STL_CPU_XCR0_YMM || (ecx & STL_CPU_CPUID_AVX) == 0u)
+	{
+		return features;
+	}
+	if ((ecx & STL_CPU_CPUID_FMA) != 0u)
+	{
+		features |= STL_CPU_ISA_FMA;
+	}
+	if (__get_cpuid_count(7u, 0u, &eax, &leaf7_ebx, &ecx, &edx) == 0)
+	{
+		return features;
+	}
+	if ((leaf7_ebx & STL_CPU_CPUID_AVX2) != 0u)
+	{
+		features |= STL_CPU_ISA_AVX2;
+	}
+	if ((leaf7_ebx & STL_CPU_CPUID_AVX512) == STL_CPU_CPUID_AVX512 && (xcr0 & STL_CPU_XCR0_ZMM) == STL_CPU_XCR0_ZMM)
+	{
+		features |= STL_CPU_ISA_AVX512;
+	}
+	return features;
+}
+#endif /*STL_USE_ISA_DISPATCH*/
+
+#if (STL_USE_CACHE_TEST > 0u)
+#define STL_CPU_CPUID_CACHE_LEAF 4u			   /* CPUID: deterministic cache parameters (Intel) */
+#define STL_CPU_CPUID_CACHE_LEAF_AMD 0x8000001Du /* CPUID: cache topology (AMD), same layout */
+#define STL_CPU_CPUID_CACHE_DATA 1u			   /* Cache type: data */
+#define STL_CPU_CPUID_CACHE_UNIFIED 3u		   /* Cache type: unified */
+#define STL_CPU_CACHE_FLUSH_LINE 64u			   /* Granule of clflush */
+
+/**
+ * @brief Read the geometry of a data cache level from a CPUID cache leaf.
+ * The sub-leaves are scanned until the null cache type; the data or unified cache of the
+ * requested level is reported.
+ * @param leaf CPUID leaf (4 or 0x8000001D).
+ * @param level Cache level (1 or 2).
+ * @param info Pointer to the geometry to fill.
+ * @return STL_TRUE if the level was found.
+ */
+STATIC_KEYWORD STL_BOOL STL_TSSP_CPU_cache_cpuid(unsigned int leaf, unsigned int level, STL_CPU_CACHE_INFO_T *info)
+{
+	unsigned int sub;
+	unsigned int eax;
+	unsigned int ebx;
+	unsigned int ecx;
+	unsigned int edx;
+	unsigned int type;
+
+	if (__get_cpuid_max(leaf & 0x80000000u, STL_NULL) < leaf)
+	{
+		return STL_FALSE;
+	}
+	for (sub = 0u; sub < 16u; sub++)
+	{
+		__cpuid_count(leaf, sub, eax, ebx, ecx, edx);
+		type = eax & 0x1Fu;
+		if (type == 0u)
+		{
+			break;
+		}
+		if (((eax >> 5) & 0x7u) == level && (type == STL_CPU_CPUID_CACHE_DATA || type == STL_CPU_CPUID_CACHE_UNIFIED))
+		{
+			info->line = (ebx & 0xFFFu) + 1u;
+			info->ways = ((ebx >> 22) & 0x3FFu) + 1u;
+			info->sets = ecx + 1u;
+			/* The physical line partitions share a set: they count as ways */
+			info->ways *= ((ebx >> 12) & 0x3FFu) + 1u;
+			info->size = info->line * info->ways * info->sets;
+			return STL_TRUE;
+		}
+	}
+	(void)edx;
+	return STL_FALSE;
+}
+
+/**
+ * @brief Read the geometry of a data cache level.
+ * CPUID leaf 4 is used on Intel, leaf 0x8000001D on AMD.
+ * @param level Cache level.
+ * @param info Pointer to the geometry to fill (size 0 if the level is not reported).
+ * @param err Pointer to a variable to store error status.
+ * @return void
+ */
+void STL_TSSP_CPU_cache_get_info(STL_CPU_CACHE_LEVEL_T level, STL_CPU_CACHE_INFO_T *info, STL_ERROR_T *err)
+{
+	info->size = 0u;
+	info->line = 0u;
+	info->ways = 0u;
+	info->sets = 0u;
+	if (level >= STL_CPU_CACHE_LEVELS)
+	{
+		*err = STL_INDEX_OUT_OF_BOUNDS;
+		return;
+	}
+	if (STL_TSSP_CPU_cache_cpuid(STL_CPU_CPUID_CACHE_LEAF, (unsigned int)level + 1u, info) == STL_FALSE)
+	{
+		(void)STL_TSSP_CPU_cache_cpuid(STL_CPU_CPUID_CACHE_LEAF_AMD, (unsigned int)level + 1u, info);
+	}
+	*err = STL_ERROR_NONE;
+}
+
+/**
+ * @brief Write back and invalidate the data cache lines of a range, at every level.
+ * clflush evicts the line from the whole cache hierarchy; the fence waits for the write-backs.
+ * @param addr Start of the range.
+ * @param size Size of the range in bytes.
+ * @return void
+ */
+void STL_TSSP_CPU_cache_flush(const void *addr, STL_INT32U_T size)
+{
+	const uint8_t *line = (const uint8_t *)((uintptr_t)addr & ~(uintptr_t)(STL_CPU_CACHE_FLUSH_LINE - 1u));
+	const uint8_t *end = (const uint8_t *)addr + size;
+
+	_mm_mfence();
+	for (; line < end; line += STL_CPU_CACHE_FLUSH_LINE)
+	{
+		_mm_clflush(line);
+	}
+	_mm_mfence();
+}
+
+/**
+ * @brief Invalidate the data cache lines of a range, at every level.
+ * x86_64 cannot discard a line from user mode (invd is privileged and whole-cache): the lines
+ * are flushed, so that dirty data is written back before the invalidation.
+ * @param addr Start of the range.
+ * @param size Size of the range in bytes.
+ * @param err Pointer to a variable to store error status.
+ * @return void
+ */
+void STL_TSSP_CPU_cache_invalidate(void *addr, STL_INT32U_T size, STL_ERROR_T *err)
+{
+	STL_TSSP_CPU_cache_flush(addr, size);
+	*err = STL_ERROR_NONE;
+}
+
+/**
+ * @brief Lock the data cache lines of a range.
+ * x86_64 caches have no line locking (way partitioning is a privileged, per-class resource).
+ * @param addr Start of the range (unused).
+ * @param size Size of the range in bytes (unused).
+ * @param err Pointer to a variable to store error status (always STL_ERROR_NOT_IMPLEMENTED).
+ * @return void
+ */
+void STL_TSSP_CPU_cache_lock(const void *addr, STL_INT32U_T size, STL_ERROR_T *err)
+{
+	(void)addr;
+	(void)size;
+	*err = STL_ERROR_NOT_IMPLEMENTED;
+}
+
+/**
+ * @brief Unlock the data cache lines of a range.
+ * @param addr Start of the range (unused).
+ * @param size Size of the range in bytes (unused).
+ * @param err Pointer to a variable to store error status (always STL_ERROR_NOT_IMPLEMENTED).
+ * @return void
+ */
+void STL_TSSP_CPU_cache_unlock(const void *addr, STL_INT32U_T size, STL_ERROR_T *err)
+{
+	(void)addr;
+	(void)size;
+	*err = STL_ERROR_NOT_IMPLEMENTED;
+}
+#endif /*STL_USE_CACHE_TEST*/
+
+#endif /* STL_AL_CPU_MODULE */
+#endif /*__STL__*/
@@ -0,0 +1,70 @@
+#if __STL__
+#ifndef __STL_AL_CPU_H__
+#define __STL_AL_CPU_H__
+
+/**
+ * @file stl_al_cpu.h
+ * @brief CPU services for the Test Setup Support Package (TSSP) on x86_64 hosts.
+ * This file provides functions for CPU-specific operations such as restoring and swapping the interrupt vector table,
+ * configuring the Memory Protection Unit (MPU), and reading the cycle counter.
+ *
+ * @note This port is used to run the STL on a Linux host (simulation, benchmarking and unit testing).
+ * It is designed to be included in the TSSP implementation files.
+ */
+
+/**
+ * STL_NUM_CPU
+ * @brief Number of CPUs in the system.
+ * This macro defines the number of CPUs available in the system.
+ * On the host each CPU is mapped onto a thread.
+ * @note This value may need to be adjusted based on the number of simulated CPUs.
+ *       The build configuration (meson option num_cpus) takes precedence.
+ */
+#ifndef STL_NUM_CPU
+#define STL_NUM_CPU 2u
+#endif /*STL_NUM_CPU*/
+
+#include <signal.h>
+
+/**
+ * STL_CPU_HOST_TRAP_NUM
+ * @brief Number of trap slots of the host exception table (SIGILL, SIGSEGV, SIGBUS, SIGFPE, SIGTRAP).
+ */
+#define STL_CPU_HOST_TRAP_NUM 5u
+
+/**
+ * STL_CPU_MPU_NUM_REGIONS
+ * @brief Number of regions of the host MPU model.
+ * The model has one base and one attribute register per region (RBAR/RASR-like).
+ */
+#define STL_CPU_MPU_NUM_REGIONS 8u
+
+/**
+ * STL_CPU_ISA_*
+ * @brief ISA extensions reported by STL_TSSP_CPU_get_isa_features (CPUID, register state enabled in XCR0).
+ * - SSE42: SSE4.1 and SSE4.2.
+ * - AVX2: AVX and AVX2, with the YMM state enabled.
+ * - FMA: FMA3, with the YMM state enabled.
+ * - AVX512: AVX-512 F, DQ, BW and VL, with the ZMM and opmask state enabled.
+ */
+#define STL_CPU_ISA_SSE42 0x1u
+#define STL_CPU_ISA_AVX2 0x2u
+#define STL_CPU_ISA_FMA 0x4u
+#define STL_CPU_ISA_AVX512 0x8u
+
+/**
+ * @typedef STL_CPU_HOST_TRAP_HANDLER_PTR_T
+ * @brief Entry of the host exception table.
+ */
+typedef void (*STL_CPU_HOST_TRAP_HANDLER_PTR_T)(int signo, siginfo_t *info, void *ctx);
+
+/**
+ * @brief Trap hook of the STL exception table, weak, overridden by intrusive tests.
+ * @param signo Signal number.
+ * @param info Signal information.
+ * @param ctx Interrupted context.
+ */
+void STL_TSSP_CPU_trap(int signo, siginfo_t *info, void *ctx);
+
+#endif /*__STL_AL_CPU_H__*/
+#endif /*__STL__*/
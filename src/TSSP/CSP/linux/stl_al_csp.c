@@ -0,0 +1,605 @@
+#if __STL__
+
+#include "stl_tssp.h"
+#include "stl_cfg.h"
+#include "stl_types.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef STL_AL_CSP_MODULE
+#define STL_AL_CSP_MODULE
+
+/**
+ * @file stl_al_csp.c
+ * @brief CSP/BSP services for the Linux host.
+ * This file provides the host stand-ins of the chip support package services,
+ * so that the STL can be validated and benchmarked without hardware.
+ */
+
+#if (STL_USE_WATCHDOG > 0u)
+/**
+ * Host stand-in of the watchdog.
+ * The watchdog window is a one-shot timerfd; start/reset (re)arm it and stop disarms it.
+ * A helper thread blocks on the timerfd and, when it expires while armed, delivers
+ * STL_CSP_WDG_BITE_SIGNAL to the thread that started the watchdog, whose handler
+ * calls STL_TSSP_CSP_watchdog_bite (the weak default exits, modelling the reset).
+ * Start, reset and stop open a new window generation in the state word. The helper claims
+ * the bite with a compare-and-swap on the generation it found expired, so that an expiration
+ * read just before a stop or a new window cannot bite the next window. A bite claimed before
+ * the change is let through first: the window expired before being stopped or reset.
+ * The stand-in models a single watchdog, owned by one thread at a time: the fine-grained
+ * watchdog, started by every CPU around its own tests, needs a single-core build.
+ */
+#if (STL_USE_FINE_GRAINED_WATCHDOG > 0u && STL_MULTICORE_SOC > 0u)
+#error "The host watchdog is a single watchdog: the fine-grained watchdog needs STL_MULTICORE_SOC == 0."
+#endif /*STL_USE_FINE_GRAINED_WATCHDOG*/
+
+#define STL_CSP_WDG_BITE_SIGNAL SIGUSR1 /* Signal delivered to the watched thread on expiration */
+#define STL_CSP_WDG_RESET_STATUS 0x57u	/* Exit status modelling the watchdog reset */
+#define STL_CSP_WDG_ARMED 1u			/* State: the window is running */
+#define STL_CSP_WDG_BITING 2u			/* State: the bite is on its way to the watched thread */
+#define STL_CSP_WDG_GENERATION 4u		/* State: increment of the window generation */
+
+/**
+ * @typedef STL_CSP_WDG_T
+ * @brief State of the host watchdog stand-in.
+ *
+ * @var STL_CSP_WDG_T::window
+ * Timeout armed by start/reset (one-shot).
+ * @var STL_CSP_WDG_T::owner
+ * Thread that started the watchdog, target of the bite signal.
+ * @var STL_CSP_WDG_T::thread
+ * Helper thread waiting for the timerfd expirations.
+ * @var STL_CSP_WDG_T::tfd
+ * Timer file descriptor, -1 until the first initialization.
+ * @var STL_CSP_WDG_T::state
+ * Window generation and STL_CSP_WDG_ARMED/STL_CSP_WDG_BITING flags.
+ */
+typedef struct
+{
+	struct itimerspec window;
+	pthread_t owner;
+	pthread_t thread;
+	int tfd;
+	STL_INT32U_T state;
+} STL_CSP_WDG_T;
+
+STATIC_KEYWORD STL_CSP_WDG_T csp_wdg = {.tfd = -1};
+
+/**
+ * @brief Claims the bite of an expired window.
+ * The window is expired if it is armed and the timer no longer runs (a start or reset after
+ * the expiration runs it again). The claim fails if the generation changed meanwhile, the
+ * check is then made again on the new window.
+ * @return STL_TRUE if the bite is to be delivered.
+ */
+STATIC_KEYWORD STL_BOOL STL_TSSP_CSP_watchdog_claim(void)
+{
+	struct itimerspec current;
+	STL_INT32U_T state = __atomic_load_n(&csp_wdg.state, __ATOMIC_ACQUIRE);
+
+	for (;;)
+	{
+		if ((state & STL_CSP_WDG_ARMED) == 0u)
+		{
+			return STL_FALSE;
+		}
+		timerfd_gettime(csp_wdg.tfd, &current);
+		if ((current.it_value.tv_sec != 0) || (current.it_value.tv_nsec != 0))
+		{
+			return STL_FALSE;
+		}
+		if (__atomic_compare_exchange_n(&csp_wdg.state, &state, (state & ~STL_CSP_WDG_ARMED) | STL_CSP_WDG_BITING,
+										STL_FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+		{
+			return STL_TRUE;
+		}
+	}
+}
+
+/**
+ * @brief Helper thread delivering the bite to the watched thread.
+ * @param arg Unused.
+ * @return Never returns.
+ */
+STATIC_KEYWORD void *STL_TSSP_CSP_watchdog_thread(void *arg)
+{
+	uint64_t expirations;
+
+	(void)arg;
+	for (;;)
+	{
+		if (read(csp_wdg.tfd, &expirations, sizeof(expirations)) != (ssize_t)sizeof(expirations))
+		{
+			continue;
+		}
+		if (STL_TSSP_CSP_watchdog_claim() == STL_TRUE)
+		{
+			pthread_kill(csp_wdg.owner, STL_CSP_WDG_BITE_SIGNAL);
+		}
+	}
+	return STL_NULL;
+}
+
+/**
+ * @brief Opens a new window generation, armed or not.
+ * Called after the timer update. A bite claimed on the previous window is delivered to this
+ * thread before the change: its handler may leave with a long jump.
+ * @param armed STL_CSP_WDG_ARMED for start/reset, 0 for stop.
+ */
+STATIC_KEYWORD void STL_TSSP_CSP_watchdog_switch(STL_INT32U_T armed)
+{
+	STL_INT32U_T state = __atomic_load_n(&csp_wdg.state, __ATOMIC_ACQUIRE);
+
+	do
+	{
+		while ((state & STL_CSP_WDG_BITING) != 0u)
+		{
+			sched_yield();
+			state = __atomic_load_n(&csp_wdg.state, __ATOMIC_ACQUIRE);
+		}
+	} while (!__atomic_compare_exchange_n(&csp_wdg.state, &state,
+										  ((state + STL_CSP_WDG_GENERATION) & ~(STL_CSP_WDG_GENERATION - 1u)) | armed,
+										  STL_FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+}
+
+/**
+ * @brief Bite signal handler, runs on the watched thread.
+ * @param signo Signal number (unused).
+ */
+STATIC_KEYWORD void STL_TSSP_CSP_watchdog_isr(int signo)
+{
+	(void)signo;
+	__atomic_and_fetch(&csp_wdg.state, ~STL_CSP_WDG_BITING, __ATOMIC_RELEASE);
+	STL_TSSP_CSP_watchdog_bite();
+}
+
+/**
+ * @brief Creates the timerfd and the helper thread at the first initialization.
+ * A failed setup is undone and made again at the next initialization.
+ * @param err Pointer to a variable to store error status.
+ */
+STATIC_KEYWORD void STL_TSSP_CSP_watchdog_setup(STL_ERROR_T *err)
+{
+	struct sigaction sa;
+
+	*err = STL_ERROR_NONE;
+	if (csp_wdg.tfd >= 0)
+	{
+		return;
+	}
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = STL_TSSP_CSP_watchdog_isr;
+	sigemptyset(&sa.sa_mask);
+	if (sigaction(STL_CSP_WDG_BITE_SIGNAL, &sa, STL_NULL) != 0)
+	{
+		*err = STL_ERROR_TASK_ALLOCATION;
+		return;
+	}
+
+	csp_wdg.tfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+	if (csp_wdg.tfd < 0)
+	{
+		*err = STL_ERROR_TASK_ALLOCATION;
+		return;
+	}
+	if (pthread_create(&csp_wdg.thread, STL_NULL, STL_TSSP_CSP_watchdog_thread, STL_NULL) != 0)
+	{
+		close(csp_wdg.tfd);
+		csp_wdg.tfd = -1;
+		*err = STL_ERROR_TASK_ALLOCATION;
+		return;
+	}
+	pthread_detach(csp_wdg.thread);
+}
+
+/**
+ * @brief Sets the one-shot window of the watchdog.
+ * @param timeout_us Timeout in microseconds (0 never expires).
+ */
+STATIC_KEYWORD void STL_TSSP_CSP_watchdog_set_window(int32_t timeout_us)
+{
+	memset(&csp_wdg.window, 0, sizeof(csp_wdg.window));
+	csp_wdg.window.it_value.tv_sec = timeout_us / 1000000;
+	csp_wdg.window.it_value.tv_nsec = (timeout_us % 1000000) * 1000;
+}
+
+#if (STL_USE_FINE_GRAINED_WATCHDOG > 0u)
+/**
+ * @brief Initialize the watchdog timer with specific timeout and reset values.
+ * On the host only the window is updated, no system call is issued.
+ * @param timeout_value Timeout period for the watchdog, in microseconds.
+ * @param reset_value Reset duration or parameters for the watchdog (unused on the host).
+ * @param err Pointer to a variable to store error status (STL_ERROR_TASK_ALLOCATION if the
+ *            timerfd or the helper thread cannot be created).
+ * @return void
+ */
+void STL_TSSP_CSP_watchdog_init(int32_t timeout_value, int32_t reset_value, STL_ERROR_T *err)
+{
+	(void)reset_value;
+	STL_TSSP_CSP_watchdog_setup(err);
+	if (*err != STL_ERROR_NONE)
+	{
+		return;
+	}
+	STL_TSSP_CSP_watchdog_set_window(timeout_value);
+	return;
+}
+#else
+/**
+ * @brief Initialize the watchdog timer with default settings.
+ * The window is STL_WATCHDOG_TIMEOUT microseconds.
+ * @param err Pointer to a variable to store error status (STL_ERROR_TASK_ALLOCATION if the
+ *            timerfd or the helper thread cannot be created).
+ * @return void
+ */
+void STL_TSSP_CSP_watchdog_init(STL_ERROR_T *err)
+{
+	STL_TSSP_CSP_watchdog_setup(err);
+	if (*err != STL_ERROR_NONE)
+	{
+		return;
+	}
+	STL_TSSP_CSP_watchdog_set_window(STL_WATCHDOG_TIMEOUT);
+	return;
+}
+#endif /*STL_USE_FINE_GRAINED_WATCHDOG*/
+/**
+ * @brief Start the watchdog timer.
+ * The calling thread becomes the target of the bite.
+ * @return void
+ */
+void STL_TSSP_CSP_watchdog_start(void)
+{
+	csp_wdg.owner = pthread_self();
+	timerfd_settime(csp_wdg.tfd, 0, &csp_wdg.window, STL_NULL);
+	STL_TSSP_CSP_watchdog_switch(STL_CSP_WDG_ARMED);
+	return;
+}
+/**
+ * @brief Stop the watchdog timer.
+ * @return void
+ */
+void STL_TSSP_CSP_watchdog_stop(void)
+{
+	struct itimerspec disarm;
+
+	memset(&disarm, 0, sizeof(disarm));
+	timerfd_settime(csp_wdg.tfd, 0, &disarm, STL_NULL);
+	STL_TSSP_CSP_watchdog_switch(0u);
+	return;
+}
+/**
+ * @brief Reset the watchdog timer.
+ * The window restarts from the full timeout.
+ * @return void
+ */
+void STL_TSSP_CSP_watchdog_reset(void)
+{
+	timerfd_settime(csp_wdg.tfd, 0, &csp_wdg.window, STL_NULL);
+	STL_TSSP_CSP_watchdog_switch(STL_CSP_WDG_ARMED);
+	return;
+}
+/**
+ * @brief Watchdog expiration hook.
+ * The weak default terminates the process with STL_CSP_WDG_RESET_STATUS, modelling the reset.
+ * @return void
+ */
+WEAK_KEYWORD void STL_TSSP_CSP_watchdog_bite(void)
+{
+	_exit(STL_CSP_WDG_RESET_STATUS);
+}
+#endif /*STL_USE_WATCHDOG*/
+
+#if (STL_USE_SW_WATCHDOG > 0u)
+/**
+ * Host stand-in of the tick timer.
+ * The tick is a periodic POSIX timer whose SIGALRM is directed to the thread that started it
+ * (SIGEV_THREAD_ID): a process-directed signal could be delivered to any thread that does not
+ * block it, such as the watchdog or DMA helper threads, and the handler would then leave
+ * through a recovery point saved by another thread.
+ */
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid /* Not exported by older C libraries */
+#endif										  /*sigev_notify_thread_id*/
+
+/**
+ * @typedef STL_CSP_TICK_T
+ * @brief State of the host tick stand-in.
+ *
+ * @var STL_CSP_TICK_T::handler
+ * Handler called at every tick (from the SIGALRM handler).
+ * @var STL_CSP_TICK_T::timer
+ * Periodic timer, directed to the thread that started the tick.
+ * @var STL_CSP_TICK_T::created
+ * Flag indicating that the timer exists.
+ */
+typedef struct
+{
+	volatile STL_TSSP_TICK_HANDLER_PTR_T handler;
+	timer_t timer;
+	STL_BOOL created;
+} STL_CSP_TICK_T;
+
+STATIC_KEYWORD STL_CSP_TICK_T csp_tick = {.handler = STL_NULL, .created = STL_FALSE};
+
+/**
+ * @brief SIGALRM handler forwarding the tick to the registered handler.
+ * @param signo Signal number (unused).
+ */
+STATIC_KEYWORD void STL_TSSP_CSP_tick_isr(int signo)
+{
+	STL_TSSP_TICK_HANDLER_PTR_T handler = csp_tick.handler;
+
+	(void)signo;
+	if (handler != STL_NULL)
+	{
+		handler();
+	}
+}
+
+/**
+ * @brief Start the periodic tick used by the software deadline monitor.
+ * On the host the tick is a periodic SIGALRM sent by a POSIX timer to the calling thread
+ * only; the handler runs in signal context on that thread, which must be the thread
+ * executing the tests.
+ * @param period_us Tick period in microseconds.
+ * @param handler Handler called at every tick.
+ * @param err Pointer to a variable to store error status.
+ * @return void
+ */
+void STL_TSSP_CSP_tick_start(STL_INT32U_T period_us, STL_TSSP_TICK_HANDLER_PTR_T handler, STL_ERROR_T *err)
+{
+	struct sigaction sa;
+	struct sigevent event;
+	struct itimerspec period;
+
+	*err = STL_ERROR_NONE;
+	csp_tick.handler = handler;
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = STL_TSSP_CSP_tick_isr;
+	sa.sa_flags = SA_RESTART;
+	sigemptyset(&sa.sa_mask);
+	if (sigaction(SIGALRM, &sa, STL_NULL) != 0)
+	{
+		*err = STL_ERROR_TASK_ALLOCATION;
+		return;
+	}
+
+	if (csp_tick.created == STL_TRUE)
+	{
+		timer_delete(csp_tick.timer);
+		csp_tick.created = STL_FALSE;
+	}
+	memset(&event, 0, sizeof(event));
+	event.sigev_notify = SIGEV_THREAD_ID;
+	event.sigev_signo = SIGALRM;
+	event.sigev_notify_thread_id = (pid_t)syscall(SYS_gettid);
+	if (timer_create(CLOCK_MONOTONIC, &event, &csp_tick.timer) != 0)
+	{
+		*err = STL_ERROR_TASK_ALLOCATION;
+		return;
+	}
+	csp_tick.created = STL_TRUE;
+
+	period.it_interval.tv_sec = period_us / 1000000u;
+	period.it_interval.tv_nsec = (long)(period_us % 1000000u) * 1000;
+	period.it_value = period.it_interval;
+	if (timer_settime(csp_tick.timer, 0, &period, STL_NULL) != 0)
+	{
+		*err = STL_ERROR_TASK_ALLOCATION;
+	}
+}
+
+/**
+ * @brief Stop the periodic tick used by the software deadline monitor.
+ * @param err Pointer to a variable to store error status.
+ * @return void
+ */
+void STL_TSSP_CSP_tick_stop(STL_ERROR_T *err)
+{
+	*err = STL_ERROR_NONE;
+	if (csp_tick.created == STL_TRUE)
+	{
+		if (timer_delete(csp_tick.timer) != 0)
+		{
+			*err = STL_ERROR_TASK_ALLOCATION;
+		}
+		csp_tick.created = STL_FALSE;
+	}
+	csp_tick.handler = STL_NULL;
+}
+#endif /*STL_USE_SW_WATCHDOG*/
+
+#if (STL_USE_DMA > 0u)
+/**
+ * Host stand-in of the DMA.
+ * A helper thread plays the DMA controller: it waits for a request, copies the descriptors
+ * with memcpy and publishes the completion (with its timestamp) with release semantics,
+ * so that the copied data are visible to the thread that observes the completion.
+ * A controller progresses while the CPU polls it; the helper thread only does so if it gets
+ * a processor, so a poll finding the request running yields (a poller spinning on the only
+ * free core would otherwise hold the copy back for a whole time slice).
+ */
+
+/**
+ * @typedef STL_CSP_DMA_T
+ * @brief State of the host DMA stand-in.
+ *
+ * @var STL_CSP_DMA_T::lock
+ * Protects the request.
+ * @var STL_CSP_DMA_T::request
+ * Signals a new request to the helper thread.
+ * @var STL_CSP_DMA_T::desc
+ * Descriptors of the pending request.
+ * @var STL_CSP_DMA_T::count
+ * Number of descriptors of the pending request, 0 when idle.
+ * @var STL_CSP_DMA_T::done
+ * Completion flag of the last request.
+ * @var STL_CSP_DMA_T::done_at
+ * Cycle counter value at the completion of the last request.
+ * @var STL_CSP_DMA_T::started
+ * Flag indicating that the helper thread has been created.
+ */
+typedef struct
+{
+	pthread_mutex_t lock;
+	pthread_cond_t request;
+	const STL_TSSP_DMA_DESC_T *desc;
+	STL_SIZE_T count;
+	STL_BOOL done;
+	STL_CYCLES_T done_at;
+	STL_BOOL started;
+} STL_CSP_DMA_T;
+
+STATIC_KEYWORD STL_CSP_DMA_T csp_dma = {
+	.lock = PTHREAD_MUTEX_INITIALIZER, .request = PTHREAD_COND_INITIALIZER, .done = STL_TRUE};
+
+/**
+ * @brief Helper thread playing the DMA controller.
+ * @param arg Unused.
+ * @return Never returns.
+ */
+STATIC_KEYWORD void *STL_TSSP_CSP_dma_thread(void *arg)
+{
+	const STL_TSSP_DMA_DESC_T *desc;
+	STL_SIZE_T count;
+	STL_SIZE_T i;
+
+	(void)arg;
+	for (;;)
+	{
+		pthread_mutex_lock(&csp_dma.lock);
+		while (csp_dma.count == 0u)
+		{
+			pthread_cond_wait(&csp_dma.request, &csp_dma.lock);
+		}
+		desc = csp_dma.desc;
+		count = csp_dma.count;
+		pthread_mutex_unlock(&csp_dma.lock);
+
+		for (i = 0; i < count; i++)
+		{
+			memcpy(desc[i].dst, desc[i].src, desc[i].size);
+		}
+
+		pthread_mutex_lock(&csp_dma.lock);
+		csp_dma.count = 0u;
+		csp_dma.done_at = STL_TSSP_CPU_get_cycles();
+		__atomic_store_n(&csp_dma.done, STL_TRUE, __ATOMIC_RELEASE);
+		pthread_mutex_unlock(&csp_dma.lock);
+	}
+	return STL_NULL;
+}
+
+/**
+ * @brief Start a memory-to-memory DMA request.
+ * The request is handed to the helper thread, created at the first request.
+ * @param desc Descriptors of the request.
+ * @param count Number of descriptors.
+ * @param err Pointer to a variable to store error status (STL_ERROR_TASK_ALLOCATION if the
+ * helper thread cannot be created, STL_ERROR_RELOCATION if a request is already running).
+ * @return void
+ */
+void STL_TSSP_CSP_dma_start(const STL_TSSP_DMA_DESC_T *desc, STL_SIZE_T count, STL_ERROR_T *err)
+{
+	pthread_t thread;
+
+	*err = STL_ERROR_NONE;
+	pthread_mutex_lock(&csp_dma.lock);
+	if (csp_dma.started == STL_FALSE)
+	{
+		if (pthread_create(&thread, STL_NULL, STL_TSSP_CSP_dma_thread, STL_NULL) != 0)
+		{
+			pthread_mutex_unlock(&csp_dma.lock);
+			*err = STL_ERROR_TASK_ALLOCATION;
+			return;
+		}
+		pthread_detach(thread);
+		csp_dma.started = STL_TRUE;
+	}
+	if (__atomic_load_n(&csp_dma.done, __ATOMIC_ACQUIRE) == STL_FALSE)
+	{
+		pthread_mutex_unlock(&csp_dma.lock);
+		*err = STL_ERROR_RELOCATION;
+		return;
+	}
+
+	if (count == 0u)
+	{
+		csp_dma.done_at = STL_TSSP_CPU_get_cycles();
+	}
+	else
+	{
+		__atomic_store_n(&csp_dma.done, STL_FALSE, __ATOMIC_RELAXED);
+		csp_dma.desc = desc;
+		csp_dma.count = count;
+		pthread_cond_signal(&csp_dma.request);
+	}
+	pthread_mutex_unlock(&csp_dma.lock);
+}
+
+/**
+ * @brief Check whether the DMA request is complete.
+ * The processor is yielded to the helper thread while the request runs.
+ * @param done_at Cycle counter value at the completion of the request (set when complete).
+ * @param err Pointer to a variable to store error status.
+ * @return STL_TRUE when the request is complete.
+ */
+STL_BOOL STL_TSSP_CSP_dma_poll(STL_CYCLES_T *done_at, STL_ERROR_T *err)
+{
+	*err = STL_ERROR_NONE;
+	if (__atomic_load_n(&csp_dma.done, __ATOMIC_ACQUIRE) == STL_FALSE)
+	{
+		sched_yield();
+		return STL_FALSE;
+	}
+	*done_at = csp_dma.done_at;
+	return STL_TRUE;
+}
+#endif /*STL_USE_DMA*/
+
+#if (STL_USE_TRACE > 0u)
+/**
+ * Host stand-in of the trace UART: the bytes are written to a file descriptor
+ * (standard error by default, redirect it to capture the trace).
+ */
+#ifndef STL_CSP_UART_FD
+#define STL_CSP_UART_FD STDERR_FILENO
+#endif /*STL_CSP_UART_FD*/
+
+/**
+ * @brief Send bytes on the trace UART.
+ * @param data Bytes to send.
+ * @param size Number of bytes.
+ * @return void
+ */
+void STL_TSSP_CSP_uart_write(const uint8_t *data, STL_INT32U_T size)
+{
+	while (size > 0u)
+	{
+		ssize_t written = write(STL_CSP_UART_FD, data, size);
+
+		if (written <= 0)
+		{
+			return;
+		}
+		data += written;
+		size -= (STL_INT32U_T)written;
+	}
+}
+#endif /*STL_USE_TRACE*/
+
+#endif /* STL_AL_CSP_MODULE */
+#endif /*__STL__*/
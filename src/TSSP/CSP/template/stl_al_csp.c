@@ -16,18 +16,20 @@
  * with the specified timeout and reset values.
  * @param timeout_value Timeout period for the watchdog.
  * @param reset_value Reset duration or parameters for the watchdog.
+ * @param err Pointer to a variable to store error status.
  * @return void
  * @note Ensure that the timeout_value and reset_value are set according to the system requirements.
  * This function may involve low-level operations
  * to configure the watchdog timer hardware.
  *
  */
-void STL_TSSP_CSP_watchdog_init(int32_t timeout_value, int32_t reset_value)
+void STL_TSSP_CSP_watchdog_init(int32_t timeout_value, int32_t reset_value, STL_ERROR_T *err)
 {
 	// Implementation of fine-grained watchdog initialization logic
 	// This function is typically used to set up the watchdog timer
 	// with the specified timeout and reset values.
 	// The actual implementation will depend on the specific hardware platform.
+	*err = STL_ERROR_NONE;
 	return;
 }
 #else
@@ -36,16 +38,18 @@ void STL_TSSP_CSP_watchdog_init(int32_t timeout_value, int32_t reset_value)
  * This function is typically used to set up the watchdog timer
  * with default settings.
  * It is used when fine-grained watchdog configuration is not required.
+ * @param err Pointer to a variable to store error status.
  * @return void
  * @note This function may involve low-level operations
  * to configure the watchdog timer hardware.
  */
-void STL_TSSP_CSP_watchdog_init(void)
+void STL_TSSP_CSP_watchdog_init(STL_ERROR_T *err)
 {
 	// Implementation of default watchdog initialization logic
 	// This function is typically used to set up the watchdog timer
 	// with default settings.
 	// It is used when fine-grained watchdog configuration is not required.
+	*err = STL_ERROR_NONE;
 	return;
 }
 
@@ -100,7 +104,111 @@ void STL_TSSP_CSP_watchdog_reset(void)
 	// The actual implementation will depend on the specific hardware platform.
 	return;
 }
+/**
+ * @brief Watchdog expiration hook.
+ * This function is called from the early-warning interrupt of the watchdog, if any.
+ * @return void
+ * @note Weak definition: overwrite it to take action before the watchdog reset.
+ */
+WEAK_KEYWORD void STL_TSSP_CSP_watchdog_bite(void)
+{
+	// Implementation of the watchdog expiration logic
+	// The actual implementation will depend on the specific hardware platform.
+	return;
+}
 #endif /*STL_USE_WATCHDOG*/
 
+#if (STL_USE_SW_WATCHDOG > 0u)
+/**
+ * @brief Start the periodic tick used by the software deadline monitor.
+ * This function is typically used to program a periodic timer interrupt
+ * whose service routine calls the given handler.
+ * @param period_us Tick period in microseconds.
+ * @param handler Handler to be called from the timer interrupt service routine.
+ * @param err Pointer to a variable to store error status.
+ * @return void
+ * @note The detection latency of a runaway test is bounded by the tick period.
+ */
+void STL_TSSP_CSP_tick_start(STL_INT32U_T period_us, STL_TSSP_TICK_HANDLER_PTR_T handler, STL_ERROR_T *err)
+{
+	// Implementation of the tick start logic
+	// This function is typically used to program a periodic timer interrupt
+	// and to register the handler in its interrupt service routine.
+	// The actual implementation will depend on the specific hardware platform.
+	(void)period_us;
+	(void)handler;
+	*err = STL_ERROR_NOT_IMPLEMENTED;
+	return;
+}
+/**
+ * @brief Stop the periodic tick used by the software deadline monitor.
+ * @param err Pointer to a variable to store error status.
+ * @return void
+ */
+void STL_TSSP_CSP_tick_stop(STL_ERROR_T *err)
+{
+	// Implementation of the tick stop logic
+	// The actual implementation will depend on the specific hardware platform.
+	*err = STL_ERROR_NOT_IMPLEMENTED;
+	return;
+}
+#endif /*STL_USE_SW_WATCHDOG*/
+
+#if (STL_USE_DMA > 0u)
+/**
+ * @brief Start a memory-to-memory DMA request.
+ * This function is typically used to program a linked-list (scatter-gather) transfer
+ * made of one DMA descriptor per block, and to start the channel.
+ * @param desc Descriptors of the request.
+ * @param count Number of descriptors.
+ * @param err Pointer to a variable to store error status.
+ * @return void
+ */
+void STL_TSSP_CSP_dma_start(const STL_TSSP_DMA_DESC_T *desc, STL_SIZE_T count, STL_ERROR_T *err)
+{
+	// Implementation of the DMA start logic
+	// The actual implementation will depend on the specific DMA controller.
+	(void)desc;
+	(void)count;
+	*err = STL_ERROR_NOT_IMPLEMENTED;
+	return;
+}
+/**
+ * @brief Check whether the DMA request is complete.
+ * This function is typically used to read the channel status (or a flag set by the
+ * transfer-complete interrupt) and the timestamp taken on completion.
+ * @param done_at Cycle counter value at the completion of the request.
+ * @param err Pointer to a variable to store error status.
+ * @return STL_TRUE when the request is complete.
+ */
+STL_BOOL STL_TSSP_CSP_dma_poll(STL_CYCLES_T *done_at, STL_ERROR_T *err)
+{
+	// Implementation of the DMA status logic
+	// The actual implementation will depend on the specific DMA controller.
+	(void)done_at;
+	*err = STL_ERROR_NOT_IMPLEMENTED;
+	return STL_TRUE;
+}
+#endif /*STL_USE_DMA*/
+
+#if (STL_USE_TRACE > 0u)
+/**
+ * @brief Send bytes on the trace UART.
+ * This function is typically used to write the bytes to the transmit data register,
+ * waiting for the transmitter to be ready before each byte (or to feed a TX FIFO or DMA).
+ * @param data Bytes to send.
+ * @param size Number of bytes.
+ * @return void
+ */
+void STL_TSSP_CSP_uart_write(const uint8_t *data, STL_INT32U_T size)
+{
+	// Implementation of the UART transmit logic
+	// The actual implementation will depend on the specific UART peripheral.
+	(void)data;
+	(void)size;
+	return;
+}
+#endif /*STL_USE_TRACE*/
+
 #endif /* STL_AL_CSP_MODULE */
 #endif /*__STL__*/
\ No newline at end of file
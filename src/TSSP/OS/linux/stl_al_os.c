@@ -0,0 +1,210 @@
+#if __STL__
+
+#include "stl_tssp.h"
+#include "stl_cfg.h"
+#include "stl_types.h"
+
+#if (STL_USE_HEALTH_EXPORT > 0u || STL_USE_CACHE_TEST > 0u)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /* STL_USE_HEALTH_EXPORT || STL_USE_CACHE_TEST */
+
+#ifndef STL_AL_OS_MODULE
+#define STL_AL_OS_MODULE
+
+/**
+ * @file stl_al_os.c
+ * @brief OS services for the Linux host.
+ * The tests run in the thread of the application: no dedicated task is created. The region
+ * shared with the supervisor is a POSIX shared-memory object. The buffer of the cache tests
+ * is backed by huge pages.
+ */
+
+#if (STL_OS_PRESENT > 0u)
+
+/**
+ * @brief Create an OS task for test support.
+ * On the host the tests run in the thread that calls the scheduler: nothing to create.
+ * @return void
+ */
+void STL_TSSP_OS_task_create(void)
+{
+	return;
+}
+/**
+ * @brief Delete an OS task.
+ * On the host no task has been created: nothing to delete.
+ * @return void
+ */
+void STL_TSSP_OS_task_delete(void)
+{
+	return;
+}
+
+#endif /* STL_OS_PRESENT */
+
+#if (STL_USE_HEALTH_EXPORT > 0u)
+/**
+ * @brief Map the region shared with the external supervisor.
+ * The shared-memory object STL_HEALTH_SHM_NAME is created (or reused) with the requested
+ * size, readable by the other users, and mapped read-write.
+ * @param size Size of the region in bytes.
+ * @param err Pointer to a variable to store error status.
+ * @return Address of the region, STL_NULL if the object cannot be created or mapped.
+ */
+void *STL_TSSP_OS_shm_map(STL_INT32U_T size, STL_ERROR_T *err)
+{
+	void *region;
+	int fd;
+
+	fd = shm_open(STL_HEALTH_SHM_NAME, O_CREAT | O_RDWR, 0644);
+	if (fd < 0)
+	{
+		*err = STL_ERROR_HEALTH;
+		return STL_NULL;
+	}
+	if (ftruncate(fd, (off_t)size) != 0)
+	{
+		close(fd);
+		*err = STL_ERROR_HEALTH;
+		return STL_NULL;
+	}
+	region = mmap(STL_NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (region == MAP_FAILED)
+	{
+		*err = STL_ERROR_HEALTH;
+		return STL_NULL;
+	}
+	*err = STL_ERROR_NONE;
+	return region;
+}
+
+/**
+ * @brief Unmap the region shared with the external supervisor.
+ * The name is removed: the supervisors that still map the object keep reading its last
+ * content, new ones do not find it.
+ * @param region Address returned by STL_TSSP_OS_shm_map.
+ * @param size Size of the region in bytes.
+ */
+void STL_TSSP_OS_shm_unmap(void *region, STL_INT32U_T size)
+{
+	(void)munmap(region, size);
+	(void)shm_unlink(STL_HEALTH_SHM_NAME);
+}
+#endif /* STL_USE_HEALTH_EXPORT */
+
+#if (STL_USE_CACHE_TEST > 0u)
+#define STL_OS_HUGE_PAGE 0x200000u			  /* Size of a huge page */
+#define STL_OS_PAGEMAP_PRESENT (1ull << 63)	  /* pagemap: page present */
+#define STL_OS_PAGEMAP_PFN ((1ull << 55) - 1u) /* pagemap: page frame number */
+
+/**
+ * @brief Check that each huge page of a mapping is backed by physically contiguous frames.
+ * The frames are read from /proc/self/pagemap; they read as zero without CAP_SYS_ADMIN, in
+ * which case the mapping is not reported contiguous.
+ * @param buffer Start of the mapping, aligned on a huge page.
+ * @param size Size of the mapping, a multiple of a huge page.
+ * @return STL_TRUE if every huge page is a contiguous, aligned block of frames.
+ */
+STATIC_KEYWORD STL_BOOL STL_TSSP_OS_huge_contiguous(const void *buffer, STL_INT32U_T size)
+{
+	STL_INT32U_T page = (STL_INT32U_T)sysconf(_SC_PAGESIZE);
+	STL_INT32U_T per_huge = STL_OS_HUGE_PAGE / page;
+	STL_INT32U_T i;
+	uint64_t entry;
+	uint64_t first = 0u;
+	STL_BOOL contiguous = STL_TRUE;
+	int fd;
+
+	fd = open("/proc/self/pagemap", O_RDONLY);
+	if (fd < 0)
+	{
+		return STL_FALSE;
+	}
+	for (i = 0u; i < size / page && contiguous == STL_TRUE; i++)
+	{
+		if (pread(fd, &entry, sizeof(entry), (off_t)(((uintptr_t)buffer / page + i) * sizeof(entry))) !=
+				(ssize_t)sizeof(entry) ||
+			(entry & STL_OS_PAGEMAP_PRESENT) == 0u || (entry & STL_OS_PAGEMAP_PFN) == 0u)
+		{
+			contiguous = STL_FALSE;
+		}
+		else if (i % per_huge == 0u)
+		{
+			first = entry & STL_OS_PAGEMAP_PFN;
+			contiguous = (first % per_huge == 0u) ? STL_TRUE : STL_FALSE;
+		}
+		else if ((entry & STL_OS_PAGEMAP_PFN) != first + i % per_huge)
+		{
+			contiguous = STL_FALSE;
+		}
+	}
+	close(fd);
+	return contiguous;
+}
+
+/**
+ * @brief Map the buffer the cache SBSTs build their eviction sets in.
+ * The buffer is first requested from the hugetlbfs pool (MAP_HUGETLB). When the pool is empty,
+ * a huge-page aligned anonymous mapping is advised for transparent huge pages and touched;
+ * the granule is then a huge page only if pagemap shows physically contiguous huge pages,
+ * and a base page otherwise.
+ * @param size Size of the buffer in bytes (rounded up to a huge page).
+ * @param page_size Pointer to the physically contiguous granule of the buffer.
+ * @param err Pointer to a variable to store error status.
+ * @return Address of the buffer, STL_NULL if it cannot be mapped.
+ */
+void *STL_TSSP_OS_cache_buffer_map(STL_INT32U_T size, STL_INT32U_T *page_size, STL_ERROR_T *err)
+{
+	STL_INT32U_T mapped = (size + STL_OS_HUGE_PAGE - 1u) & ~(STL_OS_HUGE_PAGE - 1u);
+	uint8_t *raw;
+	uint8_t *buffer;
+	STL_INT32U_T i;
+
+	buffer = mmap(STL_NULL, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	if (buffer != MAP_FAILED)
+	{
+		*page_size = STL_OS_HUGE_PAGE;
+		*err = STL_ERROR_NONE;
+		return buffer;
+	}
+	raw = mmap(STL_NULL, mapped + STL_OS_HUGE_PAGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (raw == MAP_FAILED)
+	{
+		*err = STL_ERROR_CACHE;
+		return STL_NULL;
+	}
+	/* Keep the huge-page aligned part of the mapping */
+	buffer = (uint8_t *)(((uintptr_t)raw + STL_OS_HUGE_PAGE - 1u) & ~(uintptr_t)(STL_OS_HUGE_PAGE - 1u));
+	if (buffer != raw)
+	{
+		(void)munmap(raw, (size_t)(buffer - raw));
+	}
+	(void)munmap(buffer + mapped, (size_t)(raw + STL_OS_HUGE_PAGE - buffer));
+	(void)madvise(buffer, mapped, MADV_HUGEPAGE);
+	for (i = 0u; i < mapped; i += (STL_INT32U_T)sysconf(_SC_PAGESIZE))
+	{
+		buffer[i] = 0u;
+	}
+	*page_size = (STL_TSSP_OS_huge_contiguous(buffer, mapped) == STL_TRUE) ? STL_OS_HUGE_PAGE
+																			 : (STL_INT32U_T)sysconf(_SC_PAGESIZE);
+	*err = STL_ERROR_NONE;
+	return buffer;
+}
+
+/**
+ * @brief Unmap the buffer of the cache SBSTs.
+ * @param buffer Address returned by STL_TSSP_OS_cache_buffer_map.
+ * @param size Size of the buffer in bytes.
+ */
+void STL_TSSP_OS_cache_buffer_unmap(void *buffer, STL_INT32U_T size)
+{
+	(void)munmap(buffer, (size + STL_OS_HUGE_PAGE - 1u) & ~(STL_OS_HUGE_PAGE - 1u));
+}
+#endif /* STL_USE_CACHE_TEST */
+
+#endif /* STL_AL_OS_MODULE */
+#endif /*__STL__*/
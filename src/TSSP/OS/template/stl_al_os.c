@@ -49,5 +49,99 @@ void STL_TSSP_OS_task_delete(void)
 
 #endif /* STL_OS_PRESENT */
 
+#if (STL_USE_HEALTH_EXPORT > 0u)
+
+#ifndef STL_OS_SHM_SIZE
+#define STL_OS_SHM_SIZE 4096u /* Size of the shared region buffer */
+#endif						  /*STL_OS_SHM_SIZE*/
+
+/**
+ * @var os_shm
+ * @brief Region shared with the supervisor.
+ * Without an OS the region is a RAM buffer: place it (e.g. with a section attribute) where
+ * the monitoring core or the debugger can read it, preferably on a cache line boundary.
+ */
+STATIC_KEYWORD uint64_t os_shm[STL_OS_SHM_SIZE / sizeof(uint64_t)];
+
+/**
+ * @brief Map the region shared with the external supervisor.
+ * The template returns a static buffer of STL_OS_SHM_SIZE bytes.
+ * @param size Size of the region in bytes.
+ * @param err Pointer to a variable to store error status.
+ * @return Address of the region, STL_NULL if the buffer is too small.
+ */
+void *STL_TSSP_OS_shm_map(STL_INT32U_T size, STL_ERROR_T *err)
+{
+	if (size > STL_OS_SHM_SIZE)
+	{
+		*err = STL_ERROR_HEALTH;
+		return STL_NULL;
+	}
+	*err = STL_ERROR_NONE;
+	return os_shm;
+}
+
+/**
+ * @brief Unmap the region shared with the external supervisor.
+ * The static buffer keeps its last content.
+ * @param region Address returned by STL_TSSP_OS_shm_map.
+ * @param size Size of the region in bytes.
+ */
+void STL_TSSP_OS_shm_unmap(void *region, STL_INT32U_T size)
+{
+	(void)region;
+	(void)size;
+}
+
+#endif /* STL_USE_HEALTH_EXPORT */
+
+#if (STL_USE_CACHE_TEST > 0u)
+/**
+ * @brief Buffer of the cache SBSTs.
+ * Without an MMU the buffer is physically contiguous: place it (e.g. with a section attribute)
+ * in cacheable RAM, aligned on the way size of the largest cache tested.
+ */
+STATIC_KEYWORD uint64_t os_cache_buffer[STL_CACHE_BUFFER_BYTES / sizeof(uint64_t)];
+
+/**
+ * @brief Map the buffer the cache SBSTs build their eviction sets in.
+ * The template returns a static buffer of STL_CACHE_BUFFER_BYTES bytes; its granule is the
+ * natural alignment of its address, up to its size.
+ * @param size Size of the buffer in bytes.
+ * @param page_size Pointer to the physically contiguous granule of the buffer.
+ * @param err Pointer to a variable to store error status.
+ * @return Address of the buffer, STL_NULL if the buffer is too small.
+ */
+void *STL_TSSP_OS_cache_buffer_map(STL_INT32U_T size, STL_INT32U_T *page_size, STL_ERROR_T *err)
+{
+	uintptr_t base = (uintptr_t)os_cache_buffer;
+	STL_INT32U_T granule = 1u;
+
+	if (size > STL_CACHE_BUFFER_BYTES)
+	{
+		*err = STL_ERROR_CACHE;
+		return STL_NULL;
+	}
+	while (granule < size && (base & granule) == 0u)
+	{
+		granule <<= 1;
+	}
+	*page_size = granule;
+	*err = STL_ERROR_NONE;
+	return os_cache_buffer;
+}
+
+/**
+ * @brief Unmap the buffer of the cache SBSTs.
+ * @param buffer Address returned by STL_TSSP_OS_cache_buffer_map.
+ * @param size Size of the buffer in bytes.
+ */
+void STL_TSSP_OS_cache_buffer_unmap(void *buffer, STL_INT32U_T size)
+{
+	(void)buffer;
+	(void)size;
+}
+#endif /* STL_USE_CACHE_TEST */
+
 #endif /* STL_AL_OS_MODULE */
 #endif /*__STL__*/
\ No newline at end of file
@@ -71,7 +71,11 @@ void STL_TSSP_set_test_config_runtime(STL_CPUS cpu, STL_SIZE_T test_number, STL_
 	// Implementation of runtime test configuration logic for a specific CPU
 	// This function is typically used to dynamically apply the test configuration parameters while the system is
 	// running. The actual implementation will depend on the specific hardware platform and CPU architecture.
-	tssp_rt_setup[cpu][test_number]();
+	// Runtime tests without configuration have no entry.
+	if (tssp_rt_setup[cpu][test_number] != STL_NULL)
+	{
+		tssp_rt_setup[cpu][test_number]();
+	}
 	return;
 }
 /**
@@ -89,7 +93,10 @@ void STL_TSSP_restore_test_config_runtime(STL_CPUS cpu, STL_SIZE_T test_number,
 	// Implementation of restoring runtime test configuration logic for a specific CPU
 	// This function is typically used to revert any runtime test configuration modifications for a specific CPU.
 	// The actual implementation will depend on the specific hardware platform and CPU architecture.
-	tssp_rt_restore[cpu][test_number]();
+	if (tssp_rt_restore[cpu][test_number] != STL_NULL)
+	{
+		tssp_rt_restore[cpu][test_number]();
+	}
 	return;
 }
 
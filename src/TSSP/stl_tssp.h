@@ -3,6 +3,7 @@
 #define __STL_TSSP_H__
 
 #include "stl_cfg.h"
+#include "stl_sbst_cfg.h"
 #include "stl_types.h"
 
 #if __cplusplus
@@ -19,10 +20,13 @@ extern "C"
  *
  * The functionality is conditionally compiled based on configuration macros such as:
  * - STL_USE_MPU
+ * - STL_USE_PMU
+ * - STL_USE_ISA_DISPATCH
  * - STL_USE_WATCHDOG
  * - STL_USE_FINE_GRAINED_WATCHDOG
  * - STL_MULTICORE_SOC
  * - STL_OS_PRESENT
+ * - STL_USE_HEALTH_EXPORT
  *
  * @note Ensure that the appropriate configuration macros are defined before including this header.
  *
@@ -66,12 +70,20 @@ extern "C"
  * - Access permissions (of type STL_CPU_MPU_ACCESS_t).
  */
 
+/**
+ * @brief Structure for MPU profile.
+ *
+ * A profile is a constant array of regions describing the whole MPU for a class of tests.
+ */
+
 /**
  * @brief Configures the Memory Protection Unit (MPU).
  *
- * Sets up the MPU region using the provided configuration structure.
+ * Switches the MPU to the provided profile, writing only the registers that differ
+ * from the current configuration.
  *
- * @param mpu_cfg Pointer to the MPU configuration structure.
+ * @param profile Pointer to the MPU profile.
+ * @param err Pointer to a variable to store error status.
  */
 
 /*===========================================================================
@@ -185,6 +197,7 @@ extern "C"
 	 * to manipulate the CPU's interrupt vector table.
 	 * @warning This function should be used with caution, as improper use
 	 * may lead to system instability.
+	 * @note On a multicore SoC it acts on the vector base of the calling CPU.
 	 */
 	void STL_TSSP_CPU_restore_ivor(void);
 
@@ -198,9 +211,78 @@ extern "C"
 	 * to manipulate the CPU's interrupt vector table.
 	 * @warning This function should be used with caution, as improper use
 	 * may lead to system instability.
+	 * @note On a multicore SoC it acts on the vector base of the calling CPU.
 	 */
 	void STL_TSSP_CPU_swap_ivor(void);
 
+	/**
+	 * @brief Cycle measurements of the exception vector switching.
+	 * The swap retargets the vector base register (mtvec, VBAR/VTOR, or the host dispatcher)
+	 * to the prebuilt STL table placed in STL_CODE_SECTION_MODIFIED_EXCEPTION, the restore
+	 * retargets it to the application table. No vector table is copied.
+	 */
+	typedef struct
+	{
+		STL_INT32U_T swaps;				 /* Number of swaps */
+		STL_CYCLES_T last_swap_cycles;	 /* Cycles spent in the last swap */
+		STL_CYCLES_T last_restore_cycles; /* Cycles spent in the last restore */
+		STL_CYCLES_T max_swap_cycles;	 /* Worst swap */
+		STL_CYCLES_T max_restore_cycles;	 /* Worst restore */
+	} STL_CPU_IVOR_STATS_T;
+
+	/**
+	 * @brief Retrieve the cycle measurements of the exception vector swap and restore.
+	 * @param stats Pointer to the statistics to fill.
+	 * @return void
+	 */
+	void STL_TSSP_CPU_get_ivor_stats(STL_CPU_IVOR_STATS_T *stats);
+
+	/**
+	 * @brief Read the free-running CPU cycle counter.
+	 * This function is used to timestamp the test execution and to compute deadlines.
+	 * The actual implementation will depend on the specific CPU architecture
+	 * (e.g., rdcycle on RISC-V, rdtsc on x86_64).
+	 * @return The current value of the cycle counter.
+	 */
+	STL_CYCLES_T STL_TSSP_CPU_get_cycles(void);
+
+#if (STL_MULTICORE_SOC > 0u)
+	/**
+	 * @brief Hint the CPU that it is spinning on a shared variable.
+	 * Called in the polling loops of the inter-core barriers; it releases pipeline resources
+	 * (SMT sibling, memory-order speculation) without delaying the observation of the variable.
+	 * The actual implementation will depend on the specific CPU architecture
+	 * (e.g., pause on x86_64 and RISC-V with Zihintpause, yield on Armv7).
+	 * @return void
+	 */
+	void STL_TSSP_CPU_relax(void);
+#endif /*STL_MULTICORE_SOC*/
+
+#if (STL_RELOCATED > 0u || STL_USE_OVERLAY > 0u)
+	/**
+	 * @brief Relocate a block of code or data and compute its CRC-32C in the same pass.
+	 * The block is copied by aligned word bursts (vector registers on x86_64, unrolled
+	 * loads/stores on the embedded targets); the CRC is accumulated on the loaded words,
+	 * so that the block is read only once. After the copy the instruction stream is
+	 * synchronized, so that relocated code can be executed.
+	 * @param src Source address (ROM).
+	 * @param dst Destination address (RAM).
+	 * @param size Size of the block in bytes.
+	 * @param err Pointer to a variable to store error status.
+	 * @return The CRC-32C of the copied block (see stl_crc.h).
+	 */
+	STL_INT32U_T STL_TSSP_CPU_relocate(const void *src, void *dst, STL_INT32U_T size, STL_ERROR_T *err);
+#endif /*STL_RELOCATED || STL_USE_OVERLAY*/
+
+	/**
+	 * @brief Synchronize the instruction stream with code written to memory.
+	 * It must be called before executing code copied by another master (e.g. a DMA).
+	 * @param addr Start of the written range.
+	 * @param size Size of the written range in bytes.
+	 * @return void
+	 */
+	void STL_TSSP_CPU_sync_icache(const void *addr, STL_INT32U_T size);
+
 #if (STL_USE_MPU > 0u)
 	typedef enum
 	{
@@ -218,21 +300,216 @@ extern "C"
 		STL_CPU_MPU_ACCESS_t access; /* Access permissions for the region */
 	} STL_CPU_MPU_CFG_t;
 
+	/**
+	 * @brief MPU profile.
+	 * Constant set of regions programmed for a class of tests. Region i of the profile is
+	 * programmed in MPU region i; the MPU regions beyond num_regions are disabled.
+	 * The regions must be naturally aligned powers of two (at least 32 bytes).
+	 */
+	typedef struct
+	{
+		const STL_CPU_MPU_CFG_t *regions; /* Regions of the profile */
+		STL_SIZE_T num_regions;			  /* Number of regions of the profile */
+	} STL_CPU_MPU_PROFILE_T;
+
+	/**
+	 * @brief Cost of the MPU profile switches.
+	 */
+	typedef struct
+	{
+		STL_INT32U_T switches;	   /* Number of profile switches */
+		STL_INT32U_T reg_writes;   /* Total number of MPU register writes */
+		STL_INT32U_T last_writes;  /* MPU register writes of the last switch */
+		STL_CYCLES_T last_cycles;  /* Cycles spent in the last switch */
+		STL_CYCLES_T max_cycles;   /* Worst switch */
+	} STL_CPU_MPU_STATS_T;
+
+	/**
+	 * @brief MPU profiles, indexed by the STL_MPU_PROFILE_* test classes.
+	 * The profiles are defined with the test configuration (stl_mpu_profiles.c).
+	 */
+	extern const STL_CPU_MPU_PROFILE_T STL_mpu_profiles[STL_MPU_NUM_PROFILES];
+
 	/**
 	 * @brief Configure the Memory Protection Unit (MPU).
-	 * This function is typically used to set up the MPU with the specified configuration parameters.
-	 * @param mpu_cfg Pointer to the MPU configuration structure.
-	 * @note The MPU configuration structure should contain the base address,
-	 * size, and access permissions for the memory region.
-	 * The actual implementation will depend on the specific CPU architecture.
+	 * The MPU is switched to the given profile. The regions are encoded in the register
+	 * format of the MPU and compared with a shadow copy of the registers, so that only
+	 * the registers that differ from the current configuration are written.
+	 * @param profile Pointer to the MPU profile.
+	 * @param err Pointer to a variable to store error status (STL_ERROR_MPU if the profile
+	 * has more regions than the MPU).
 	 * @return void
-	 * @note Ensure that the mpu_cfg pointer is not NULL before accessing its members.
 	 * @warning This function should be used with caution, as improper configuration
 	 * of the MPU may lead to memory access violations or system instability.
 	 */
-	void STL_TSSP_CPU_configure_mpu(STL_CPU_MPU_CFG_t *mpu_cfg);
+	void STL_TSSP_CPU_configure_mpu(const STL_CPU_MPU_PROFILE_T *profile, STL_ERROR_T *err);
+
+	/**
+	 * @brief Retrieve the cost of the MPU profile switches.
+	 * @param stats Pointer to the statistics to fill.
+	 * @return void
+	 */
+	void STL_TSSP_CPU_get_mpu_stats(STL_CPU_MPU_STATS_T *stats);
 #endif /*STL_USE_MPU*/
 
+#if (STL_USE_PMU > 0u)
+	typedef enum
+	{
+		STL_PMU_EVENT_CYCLES = 0u,		  /* CPU cycles */
+		STL_PMU_EVENT_INSTRUCTIONS = 1u,  /* Retired instructions */
+		STL_PMU_EVENT_CACHE_MISSES = 2u,  /* Data cache misses (refills) */
+		STL_PMU_EVENT_BRANCH_MISSES = 3u, /* Mispredicted branches */
+		STL_PMU_EVENT_INTERRUPTS = 4u	  /* Interrupts and exceptions taken */
+	} STL_PMU_EVENT_T;
+
+	/**
+	 * @brief Snapshot of the configured performance counters.
+	 * count[i] is the value of the counter of the event at position i of STL_PMU_EVENTS.
+	 * The counters are free-running (extended to 64 bits where the hardware is narrower):
+	 * the cost of a test is the difference between two snapshots.
+	 */
+	typedef struct
+	{
+		STL_CYCLES_T count[STL_PMU_NUM_COUNTERS]; /* Counter values */
+	} STL_PMU_SAMPLE_T;
+
+	/**
+	 * @brief Per-test aggregate of the counter differences.
+	 */
+	typedef struct
+	{
+		STL_INT32U_T runs;						/* Number of sampled executions */
+		STL_CYCLES_T last[STL_PMU_NUM_COUNTERS]; /* Counts of the last execution */
+		STL_CYCLES_T sum[STL_PMU_NUM_COUNTERS];	/* Counts accumulated over all executions */
+		STL_CYCLES_T max[STL_PMU_NUM_COUNTERS];	/* Worst execution, per counter */
+	} STL_PMU_STATS_T;
+
+	/**
+	 * @brief Program the performance counters with the events of STL_PMU_EVENTS and start them.
+	 * The events the core cannot count are left out: their counters always read zero.
+	 * @param err Pointer to a variable to store error status.
+	 * @return Mask of the available counters (bit i set if counter i counts its event).
+	 */
+	STL_INT32U_T STL_TSSP_CPU_pmu_init(STL_ERROR_T *err);
+
+	/**
+	 * @brief Read the configured performance counters.
+	 * The counters are read back to back, with as few instructions as possible in between,
+	 * so that the sampling itself does not show up in the counts of the test.
+	 * @param sample Pointer to the snapshot to fill.
+	 * @return void
+	 */
+	void STL_TSSP_CPU_pmu_read(STL_PMU_SAMPLE_T *sample);
+
+	/**
+	 * @brief Stop the performance counters and release them.
+	 * @return void
+	 */
+	void STL_TSSP_CPU_pmu_deinit(void);
+#endif /*STL_USE_PMU*/
+
+#if (STL_USE_ISA_DISPATCH > 0u)
+	/**
+	 * @brief ISA extensions executable by the CPU (bit mask).
+	 * The bits are defined by the CPU port (STL_CPU_ISA_* in stl_al_cpu.h); 0 is the baseline ISA.
+	 */
+	typedef STL_INT32U_T STL_ISA_FEATURES_T;
+
+	/**
+	 * @brief Variant of a runtime test for an ISA level.
+	 * The variants of a test are listed from the widest to the baseline; the list ends at
+	 * the first entry without routine.
+	 */
+	typedef struct
+	{
+		STL_ISA_FEATURES_T features; /* ISA extensions executed by the variant */
+		STL_FUNCT_PTR_T routine;	 /* Test routine */
+	} STL_SBST_VARIANT_T;
+
+	/**
+	 * @brief Detect the ISA extensions the CPU can execute.
+	 * An extension is only reported when the CPU implements it and its register state is
+	 * enabled (saved by the operating system), so that a variant selected from this mask
+	 * never raises an illegal instruction.
+	 * @return Mask of the STL_CPU_ISA_* extensions of the port.
+	 */
+	STL_ISA_FEATURES_T STL_TSSP_CPU_get_isa_features(void);
+#endif /*STL_USE_ISA_DISPATCH*/
+
+#if (STL_USE_CACHE_TEST > 0u)
+	/**
+	 * @brief Data cache levels covered by the cache SBSTs.
+	 */
+	typedef enum
+	{
+		STL_CPU_CACHE_L1D = 0u,	  /* Level 1 data cache */
+		STL_CPU_CACHE_L2 = 1u,	  /* Level 2 (unified or data) cache */
+		STL_CPU_CACHE_LEVELS = 2u /* Number of levels */
+	} STL_CPU_CACHE_LEVEL_T;
+
+	/**
+	 * @brief Geometry of a data cache level.
+	 * A line at address a is held in set (a / line) % sets; the way size (sets x line) is the
+	 * stride between the addresses of an eviction set.
+	 */
+	typedef struct
+	{
+		STL_INT32U_T size; /* Size in bytes, 0 if the level is absent */
+		STL_INT32U_T line; /* Line size in bytes */
+		STL_INT32U_T ways; /* Associativity */
+		STL_INT32U_T sets; /* Number of sets */
+	} STL_CPU_CACHE_INFO_T;
+
+	/**
+	 * @brief Read the geometry of a data cache level.
+	 * @param level Cache level.
+	 * @param info Pointer to the geometry to fill (size 0 if the core has no such cache).
+	 * @param err Pointer to a variable to store error status.
+	 * @return void
+	 */
+	void STL_TSSP_CPU_cache_get_info(STL_CPU_CACHE_LEVEL_T level, STL_CPU_CACHE_INFO_T *info, STL_ERROR_T *err);
+
+	/**
+	 * @brief Write back and invalidate the data cache lines of a range, at every level.
+	 * The function returns once the lines have reached memory.
+	 * @param addr Start of the range.
+	 * @param size Size of the range in bytes.
+	 * @return void
+	 */
+	void STL_TSSP_CPU_cache_flush(const void *addr, STL_INT32U_T size);
+
+	/**
+	 * @brief Invalidate the data cache lines of a range, at every level.
+	 * The next accesses to the range read memory. Where the ISA cannot discard a line without
+	 * writing it back (x86_64), dirty lines are written back first.
+	 * @param addr Start of the range.
+	 * @param size Size of the range in bytes.
+	 * @param err Pointer to a variable to store error status.
+	 * @return void
+	 */
+	void STL_TSSP_CPU_cache_invalidate(void *addr, STL_INT32U_T size, STL_ERROR_T *err);
+
+	/**
+	 * @brief Lock the data cache lines of a range, so that they are never replaced.
+	 * @param addr Start of the range.
+	 * @param size Size of the range in bytes.
+	 * @param err Pointer to a variable to store error status (STL_ERROR_NOT_IMPLEMENTED if
+	 * the cache does not support locking).
+	 * @return void
+	 */
+	void STL_TSSP_CPU_cache_lock(const void *addr, STL_INT32U_T size, STL_ERROR_T *err);
+
+	/**
+	 * @brief Unlock the data cache lines locked by STL_TSSP_CPU_cache_lock.
+	 * @param addr Start of the range.
+	 * @param size Size of the range in bytes.
+	 * @param err Pointer to a variable to store error status (STL_ERROR_NOT_IMPLEMENTED if
+	 * the cache does not support locking).
+	 * @return void
+	 */
+	void STL_TSSP_CPU_cache_unlock(const void *addr, STL_INT32U_T size, STL_ERROR_T *err);
+#endif /*STL_USE_CACHE_TEST*/
+
 	/*****************************************************************************************************/
 	/****************                    Test Setup Support Package                       ****************/
 	/****************                       CSP/BSP services                              ****************/
@@ -245,17 +522,20 @@ extern "C"
 	 * @brief Initialize the watchdog timer with specific timeout and reset values.
 	 * This function is typically used to set up the watchdog timer
 	 * with the specified timeout and reset values.
-	 *
+	 * @param err Pointer to a variable to store error status (STL_ERROR_TASK_ALLOCATION if the
+	 *            watchdog cannot be set up).
 	 */
-	void STL_TSSP_CSP_watchdog_init(int32_t timeout_value, int32_t reset_value);
+	void STL_TSSP_CSP_watchdog_init(int32_t timeout_value, int32_t reset_value, STL_ERROR_T *err);
 #else
 	/**
 	 * @brief Initialize the watchdog timer with default settings.
 	 * This function is typically used to set up the watchdog timer
 	 * with default settings.
 	 * It is used when fine-grained watchdog configuration is not required.
+	 * @param err Pointer to a variable to store error status (STL_ERROR_TASK_ALLOCATION if the
+	 *            watchdog cannot be set up).
 	 */
-	void STL_TSSP_CSP_watchdog_init(void);
+	void STL_TSSP_CSP_watchdog_init(STL_ERROR_T *err);
 #endif /*STL_USE_FINE_GRAINED_WATCHDOG*/
 	   /**
 		* @brief Start the watchdog timer.
@@ -282,8 +562,79 @@ extern "C"
 	 * may lead to system instability if the system hangs or becomes unresponsive.
 	 */
 	void STL_TSSP_CSP_watchdog_reset(void);
+	/**
+	 * @brief Watchdog expiration hook.
+	 * This function is called when the watchdog expires, from the early-warning interrupt
+	 * on targets that provide one, or from the bite signal on the host stand-in.
+	 * The weak default models the watchdog reset; it can be overwritten, for example,
+	 * to count the expirations while validating the watchdog windows.
+	 */
+	void STL_TSSP_CSP_watchdog_bite(void);
 #endif /*STL_USE_WATCHDOG*/
 
+#if (STL_USE_SW_WATCHDOG > 0u)
+	/**
+	 * @brief Pointer type for the periodic tick handler.
+	 * The handler is invoked from the timer interrupt (or host signal) context.
+	 */
+	typedef void (*STL_TSSP_TICK_HANDLER_PTR_T)(void);
+
+	/**
+	 * @brief Start the periodic tick used by the software deadline monitor.
+	 * This function is typically used to program a timer interrupt (or a host signal)
+	 * that calls the given handler every period_us microseconds.
+	 * @param period_us Tick period in microseconds.
+	 * @param handler Handler called at every tick.
+	 * @param err Pointer to a variable to store error status.
+	 */
+	void STL_TSSP_CSP_tick_start(STL_INT32U_T period_us, STL_TSSP_TICK_HANDLER_PTR_T handler, STL_ERROR_T *err);
+	/**
+	 * @brief Stop the periodic tick used by the software deadline monitor.
+	 * @param err Pointer to a variable to store error status.
+	 */
+	void STL_TSSP_CSP_tick_stop(STL_ERROR_T *err);
+#endif /*STL_USE_SW_WATCHDOG*/
+
+#if (STL_USE_DMA > 0u)
+	/**
+	 * @brief DMA transfer descriptor.
+	 * The descriptors of a request are processed in order, like a linked-list DMA transfer.
+	 */
+	typedef struct
+	{
+		const void *src;   /* Source address */
+		void *dst;		   /* Destination address */
+		STL_INT32U_T size; /* Size of the transfer in bytes */
+	} STL_TSSP_DMA_DESC_T;
+
+	/**
+	 * @brief Start a memory-to-memory DMA request.
+	 * The function returns as soon as the request is queued; the CPU is free while the
+	 * descriptors are transferred. The descriptors must stay valid until the request completes.
+	 * @param desc Descriptors of the request.
+	 * @param count Number of descriptors.
+	 * @param err Pointer to a variable to store error status.
+	 */
+	void STL_TSSP_CSP_dma_start(const STL_TSSP_DMA_DESC_T *desc, STL_SIZE_T count, STL_ERROR_T *err);
+	/**
+	 * @brief Check whether the DMA request is complete.
+	 * @param done_at Cycle counter value at the completion of the request (set when complete).
+	 * @param err Pointer to a variable to store error status (transfer error).
+	 * @return STL_TRUE when the request is complete.
+	 */
+	STL_BOOL STL_TSSP_CSP_dma_poll(STL_CYCLES_T *done_at, STL_ERROR_T *err);
+#endif /*STL_USE_DMA*/
+
+#if (STL_USE_TRACE > 0u)
+	/**
+	 * @brief Send bytes on the trace UART.
+	 * The function returns once the bytes are queued in the transmitter (or written).
+	 * @param data Bytes to send.
+	 * @param size Number of bytes.
+	 */
+	void STL_TSSP_CSP_uart_write(const uint8_t *data, STL_INT32U_T size);
+#endif /*STL_USE_TRACE*/
+
 	/**
 	 * @brief Pointer type for test setup support package setup functions.
 	 * This type is used to define pointers to functions that set up test configurations
@@ -390,6 +741,46 @@ void STL_TSSP_restore_test_config_runtime(STL_SIZE_T test_number, STL_ERROR_T *)
 	void STL_TSSP_OS_task_delete(void);
 #endif /*STL_OS_PRESENT*/
 
+#if (STL_USE_HEALTH_EXPORT > 0u)
+	/**
+	 * @brief Map the region shared with the external supervisor.
+	 * The region is readable by the supervisor while the STL writes it (a shared-memory object
+	 * on a hosted OS, a RAM buffer visible to the monitoring core on bare metal).
+	 * @param size Size of the region in bytes.
+	 * @param err Pointer to a variable to store error status.
+	 * @return Address of the region, STL_NULL if it cannot be provided.
+	 */
+	void *STL_TSSP_OS_shm_map(STL_INT32U_T size, STL_ERROR_T *err);
+	/**
+	 * @brief Unmap the region shared with the external supervisor.
+	 * Supervisors that still map the region keep reading its last content.
+	 * @param region Address returned by STL_TSSP_OS_shm_map.
+	 * @param size Size of the region in bytes.
+	 */
+	void STL_TSSP_OS_shm_unmap(void *region, STL_INT32U_T size);
+#endif /*STL_USE_HEALTH_EXPORT*/
+
+#if (STL_USE_CACHE_TEST > 0u)
+	/**
+	 * @brief Map the buffer the cache SBSTs build their eviction sets in.
+	 * The cache set of a line depends on its physical address: eviction sets are only
+	 * congruent when the way size of the cache does not exceed the physically contiguous
+	 * granule of the buffer, reported in page_size.
+	 * @param size Size of the buffer in bytes.
+	 * @param page_size Pointer to the physically contiguous, naturally aligned granule of the buffer.
+	 * @param err Pointer to a variable to store error status (STL_ERROR_CACHE if the buffer
+	 * cannot be provided).
+	 * @return Address of the buffer, aligned on page_size, STL_NULL on error.
+	 */
+	void *STL_TSSP_OS_cache_buffer_map(STL_INT32U_T size, STL_INT32U_T *page_size, STL_ERROR_T *err);
+	/**
+	 * @brief Unmap the buffer of the cache SBSTs.
+	 * @param buffer Address returned by STL_TSSP_OS_cache_buffer_map.
+	 * @param size Size of the buffer in bytes.
+	 */
+	void STL_TSSP_OS_cache_buffer_unmap(void *buffer, STL_INT32U_T size);
+#endif /*STL_USE_CACHE_TEST*/
+
 #if __cplusplus
 }
 #endif /*__cplusplus*/
@@ -9,6 +9,8 @@
  *
  * @note The macro `__STL__` must be defined at the compiler level to enable
  *       compilation of the STL.
+ * @note With meson, the main options are generated into stl_build_cfg.h (STL_BUILD_CFG),
+ *       which takes precedence over the defaults of this file.
  *
  * @section CompilerDirectives Compiler Dependent Directives
  * - Defines keywords for extended assembly, weak symbols, static, and inline
@@ -26,10 +28,11 @@
  *   - 0: Sequential SBST scheduler (runtime tests only).
  *   - 1: Chunk-based SBST scheduler (runtime tests only).
  *   - 2: Custom scheduler (user-defined).
+ * - Defines the specialization of the dispatch loops (constant routine tables, unroll factor).
 
  * @section TestSetup Test Setup Support Package
  * - Configures options for OS presence, multicore SoC, memory protection unit
- *   (MPU), and watchdog usage.
+ *   (MPU), and watchdog usage (hardware and software deadline monitor).
  * - Includes settings for OS task stack size, priority, period, and CRC.
 
  * @section SoftwareSelfTests Software-Self Tests
@@ -60,6 +63,14 @@
 #define __STL__ 1u
 #endif /*__STL__*/
 
+#ifdef STL_BUILD_CFG
+/**
+ * Configuration generated from the meson options (see meson.options).
+ * Its values take precedence over the defaults below; the compiler command line still overrides both.
+ */
+#include "stl_build_cfg.h"
+#endif /*STL_BUILD_CFG*/
+
 /************************ Compiler Dependent directives ************************/
 /**
  *   Assembly keyword for Extended assembly.
@@ -70,6 +81,28 @@
 #define STATIC_KEYWORD static
 #define INLINE_KEYWORD inline
 #define EXTERN_KEYWORD extern
+#define ALIGNED_KEYWORD(n) __attribute__((aligned(n)))
+#define ALWAYS_INLINE_KEYWORD inline __attribute__((always_inline))
+/**
+ *   Unrolling of the loop that follows (factor: integer constant, 1 disables the unrolling).
+ */
+#define STL_PRAGMA(x) _Pragma(#x)
+#define STL_UNROLL(n) STL_PRAGMA(GCC unroll n)
+/**
+ *   Atomic accesses on naturally aligned words (lock-free structures shared between contexts).
+ */
+#define STL_ATOMIC_LOAD_ACQUIRE(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define STL_ATOMIC_STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define STL_ATOMIC_FETCH_ADD(p, v) __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#define STL_ATOMIC_EXCHANGE(p, v) __atomic_exchange_n((p), (v), __ATOMIC_ACQ_REL)
+#define STL_ATOMIC_FENCE_RELEASE() __atomic_thread_fence(__ATOMIC_RELEASE)
+/**
+ *   Build-time checks. STL_INIT_ENTRIES counts the entries of the initializer of a table (the
+ *   brace-enclosed list of a configuration macro): a shorter list than the table is accepted by
+ *   the compiler, which silently zero-fills the missing entries.
+ */
+#define STL_STATIC_ASSERT(cond, msg) _Static_assert(cond, msg)
+#define STL_INIT_ENTRIES(table, init) (sizeof((__typeof__((table)[0])[])init) / sizeof((table)[0]))
 #else
 #warning "Compiler keyword not defined. Please check the compiler documentation."
 #endif /*defined(__GNUC__) || defined(__clang__)*/
@@ -103,7 +136,9 @@
 /****************                                                                     ****************/
 /*****************************************************************************************************/
 
-#define STL_TEST_CHUNK_SIZE 1u
+#ifndef STL_TEST_CHUNK_SIZE
+#define STL_TEST_CHUNK_SIZE 1u /* Runtime tests per call of the chunk-based scheduler (default of a context) */
+#endif						   /*STL_TEST_CHUNK_SIZE*/
 
 /**
  *  Note Scheduler type:
@@ -111,34 +146,109 @@
  *                       - 1 Chunk-based SBST scheduler (for runtime tests only)
  *                       - 2 Custom (overwrite the definition)
  */
+#ifndef STL_SCHEDULER_TYPE
 #define STL_SCHEDULER_TYPE 0u
+#endif /*STL_SCHEDULER_TYPE*/
+
+/**
+ * Specialization of the dispatch loops.
+ * With constant routine tables the runtime and boot-time tables are initialized at build time from
+ * STL_RT_ROUTINE_TABLE and STL_BT_ROUTINE_TABLE (stl_sbst_cfg.h) and placed in read-only memory:
+ * the sequential scheduler of the default context is then fully unrolled into direct calls.
+ */
+#ifndef STL_CONST_TEST_TABLES
+#define STL_CONST_TEST_TABLES 0u /* Routine tables of the default context fixed at build time */
+#endif							 /*STL_CONST_TEST_TABLES*/
+#ifndef STL_DISPATCH_UNROLL
+#define STL_DISPATCH_UNROLL 1u /* Unroll factor of the fixed-size dispatch loops (1: no unrolling) */
+#endif						   /*STL_DISPATCH_UNROLL*/
+
+#ifndef STL_CACHE_LINE_SIZE
+#define STL_CACHE_LINE_SIZE 64u /* Alignment of the per-CPU state of a context (no false sharing) */
+#endif							/*STL_CACHE_LINE_SIZE*/
 
 /*****************************************************************************************************/
 /****************                    Test Setup Support Package                       ****************/
 /****************                                                                     ****************/
 /*****************************************************************************************************/
 
+#ifndef STL_OS_PRESENT
 #define STL_OS_PRESENT 0u
+#endif /*STL_OS_PRESENT*/
 
-#define STL_MULTICORE_SOC 0u
+#ifndef STL_MULTICORE_SOC
+#define STL_MULTICORE_SOC 0u /* More than one CPU runs the STL (STL_NUM_CPU of the CPU port) */
+#endif						 /*STL_MULTICORE_SOC*/
 
 /* CPU related*/
 #if (STL_MULTICORE_SOC > 0u)
 #define STL_MULTICORE_EXECUTION 1u
-#define STL_USE_MPU 0u /* Use the memory protection unit */
 #else
 #define STL_MULTICORE_EXECUTION 0u
-#define STL_USE_MPU 0u /* Use the memory protection unit */
-#endif				   /*STL_MULTICORE_SOC*/
+#endif /*STL_MULTICORE_SOC*/
+#ifndef STL_USE_MPU
+#define STL_USE_MPU 0u /* Use the memory protection unit (one MPU profile per test class) */
+#endif				   /*STL_USE_MPU*/
+
+/**
+ * Performance monitoring: the configured hardware counters are sampled before and after each
+ * runtime test and the differences are aggregated per test next to its verdict (see
+ * STL_em_rt_get_pmu). Counter i counts the event at position i of STL_PMU_EVENTS; the events
+ * the core cannot count read as zero (see STL_TSSP_CPU_pmu_init).
+ */
+#ifndef STL_USE_PMU
+#define STL_USE_PMU 0u /* Sample the performance counters around each runtime test */
+#endif				   /*STL_USE_PMU*/
+#if (STL_USE_PMU > 0u)
+#ifndef STL_PMU_NUM_COUNTERS
+#define STL_PMU_NUM_COUNTERS 5u /* Number of sampled counters */
+#endif							/*STL_PMU_NUM_COUNTERS*/
+#ifndef STL_PMU_EVENTS
+#define STL_PMU_EVENTS                                                                                                 \
+	{                                                                                                                  \
+		STL_PMU_EVENT_CYCLES, STL_PMU_EVENT_INSTRUCTIONS, STL_PMU_EVENT_CACHE_MISSES, STL_PMU_EVENT_BRANCH_MISSES,     \
+			STL_PMU_EVENT_INTERRUPTS                                                                                   \
+	} /* Event counted by each counter */
+#endif /*STL_PMU_EVENTS*/
+#endif /*STL_USE_PMU*/
 
 /* CSP related*/
+#ifndef STL_USE_WATCHDOG
 #define STL_USE_WATCHDOG 0u /* Use the watchdog for test execution */
+#endif						/*STL_USE_WATCHDOG*/
+#ifndef STL_USE_FINE_GRAINED_WATCHDOG
 #define STL_USE_FINE_GRAINED_WATCHDOG                                                                                  \
 	0u /* Use the fine grained watchdog for test execution (defined for each test in the STL) */
+#endif /*STL_USE_FINE_GRAINED_WATCHDOG*/
 #if (STL_USE_WATCHDOG > 0u && STL_USE_FINE_GRAINED_WATCHDOG == 0u)
 #define STL_WATCHDOG_TIMEOUT 0x00000000u /* Watchdog timeout value */
-#define STL_WATCHDOG_RESET_VALUE 0u		 /* Watchdog reset value */
 #endif									 /*STL_USE_WATCHDOG*/
+#if (STL_USE_WATCHDOG > 0u)
+#define STL_WATCHDOG_RESET_VALUE 0u /* Watchdog reset value */
+#endif								/*STL_USE_WATCHDOG*/
+
+/**
+ * Software deadline monitor: each runtime test is armed with its own budget (in CPU cycles,
+ * see STL_RT_ROUTINE_BUDGET in stl_sbst_cfg.h) and aborted from the tick handler when it overruns.
+ */
+#ifndef STL_USE_SW_WATCHDOG
+#define STL_USE_SW_WATCHDOG 0u /* Use the software deadline monitor for test execution */
+#endif						   /*STL_USE_SW_WATCHDOG*/
+#if (STL_USE_SW_WATCHDOG > 0u)
+#define STL_SW_WATCHDOG_TICK_US 100u /* Period of the deadline check tick (timer interrupt or host signal) */
+#endif							   /*STL_USE_SW_WATCHDOG*/
+#ifndef STL_USE_DMA
+#define STL_USE_DMA 0u /* Use the DMA for the asynchronous relocation of the runtime tests */
+#endif				   /*STL_USE_DMA*/
+/**
+ * ISA dispatch: at STL_init the CPU port reports the ISA extensions the CPU can execute and
+ * each runtime routine gets the widest of its variants (STL_RT_ROUTINE_VARIANTS in
+ * stl_sbst_cfg.h) that only uses those extensions. A routine without such a variant is
+ * skipped and reads as not run.
+ */
+#ifndef STL_USE_ISA_DISPATCH
+#define STL_USE_ISA_DISPATCH 0u /* Select the SBST variants from the ISA extensions of the CPU */
+#endif							/*STL_USE_ISA_DISPATCH*/
 
 /* OS related*/
 #if (STL_OS_PRESENT > 0u)
@@ -165,13 +275,145 @@
 /*****************************************************************************************************/
 /*! mismatch value if cocmputed signature is different from the golden signature*/
 #define STL_SIGNATURE_MISMATCH 0x01010101
+/*! value returned by a test that could not run on this CPU (recorded as not run, not as a failure)*/
+#define STL_SIGNATURE_SKIPPED 0x02020202
 
 /*****************************************************************************************************/
 /*************************** Relocation related defines **********************************************/
 /*****************************************************************************************************/
 
-#define STL_RELOCATED 0u		 /* Relocation is enabled */
+#ifndef STL_RELOCATED
+#define STL_RELOCATED 0u /* Relocation is enabled */
+#endif					 /*STL_RELOCATED*/
+#ifndef STL_RELOCATION_TABLE
 #define STL_RELOCATION_TABLE 0u /* Relocation table for multiple relocations */
+#endif							/*STL_RELOCATION_TABLE*/
+#ifndef STL_RELOCATION_MAX_BLOCKS
+#define STL_RELOCATION_MAX_BLOCKS 8u /* Maximum number of blocks of an asynchronous relocation (DMA descriptors) */
+#endif								 /*STL_RELOCATION_MAX_BLOCKS*/
+#ifndef STL_RELOCATION_VERIFY
+#define STL_RELOCATION_VERIFY 1u /* Verify each relocated block against its build-time CRC-32C */
+#endif							 /*STL_RELOCATION_VERIFY*/
+#ifndef STL_USE_OVERLAY
+#define STL_USE_OVERLAY 0u /* Load the runtime tests on demand into a pool of RAM slots */
+#endif					   /*STL_USE_OVERLAY*/
+#if (STL_USE_OVERLAY > 0u)
+#ifndef STL_OVERLAY_MAX_SLOTS
+#define STL_OVERLAY_MAX_SLOTS 8u /* Maximum number of slots of the overlay pool */
+#endif							 /*STL_OVERLAY_MAX_SLOTS*/
+#ifndef STL_OVERLAY_DMA_PREFETCH
+#define STL_OVERLAY_DMA_PREFETCH 0u /* Prefetch with the DMA (STL_USE_DMA) instead of the CPU copy */
+#endif								/*STL_OVERLAY_DMA_PREFETCH*/
+#endif								/*STL_USE_OVERLAY*/
+
+#ifndef STL_USE_SCRUB
+#define STL_USE_SCRUB 0u /* Background CRC scrub of the STL code and golden values (pseudo-test) */
+#endif					 /*STL_USE_SCRUB*/
+#if (STL_USE_SCRUB > 0u)
+#ifndef STL_SCRUB_CHUNK_BYTES
+#define STL_SCRUB_CHUNK_BYTES 4096u /* Bytes checked per invocation of the scrub pseudo-test */
+#endif								/*STL_SCRUB_CHUNK_BYTES*/
+#ifndef STL_SCRUB_MAX_REGIONS
+#define STL_SCRUB_MAX_REGIONS 8u /* Maximum number of scrubbed regions */
+#endif							 /*STL_SCRUB_MAX_REGIONS*/
+#ifndef STL_SCRUB_BASELINE
+#define STL_SCRUB_BASELINE 0u /* 1: reference CRCs computed at init, 0: build-time CRCs of the region table */
+#endif						  /*STL_SCRUB_BASELINE*/
+#endif						  /*STL_USE_SCRUB*/
+
+#ifndef STL_USE_MARCH
+#define STL_USE_MARCH 0u /* Transparent March C- RAM test (pseudo-test, uncore_logic) */
+#endif					 /*STL_USE_MARCH*/
+#if (STL_USE_MARCH > 0u)
+#ifndef STL_MARCH_CHUNK_BYTES
+#define STL_MARCH_CHUNK_BYTES 1024u /* Bytes tested per invocation of the March pseudo-test (RAM of the save area) */
+#endif								/*STL_MARCH_CHUNK_BYTES*/
+#ifndef STL_MARCH_MAX_REGIONS
+#define STL_MARCH_MAX_REGIONS 8u /* Maximum number of regions tested by the March test */
+#endif							 /*STL_MARCH_MAX_REGIONS*/
+#endif							 /*STL_USE_MARCH*/
+
+/**
+ * Memory bandwidth throttle: token bucket per CPU capping the bytes touched by the memory-class
+ * runtime tests (STL_RT_ROUTINE_MEM_BYTES) per window; a test without bytes left is deferred.
+ */
+#ifndef STL_USE_THROTTLE
+#define STL_USE_THROTTLE 0u /* Cap the bytes touched by the memory tests per time window */
+#endif						/*STL_USE_THROTTLE*/
+#if (STL_USE_THROTTLE > 0u)
+#ifndef STL_THROTTLE_BYTES_PER_WINDOW
+#define STL_THROTTLE_BYTES_PER_WINDOW 65536u /* Bytes per window and per CPU (burst), 0: not throttled */
+#endif										 /*STL_THROTTLE_BYTES_PER_WINDOW*/
+#ifndef STL_THROTTLE_WINDOW_CYCLES
+#define STL_THROTTLE_WINDOW_CYCLES 1000000u /* Window of the throttle, in cycles */
+#endif										/*STL_THROTTLE_WINDOW_CYCLES*/
+#endif										/*STL_USE_THROTTLE*/
+
+/**
+ * Cache SBSTs: eviction sets of the L1D and L2 sets are filled with known patterns, checked for
+ * corruption and for their replacement behaviour, a few sets per invocation.
+ */
+#ifndef STL_USE_CACHE_TEST
+#define STL_USE_CACHE_TEST 0u /* Enable the L1D/L2 cache SBSTs and the TSSP cache services */
+#endif						  /*STL_USE_CACHE_TEST*/
+#if (STL_USE_CACHE_TEST > 0u)
+#ifndef STL_CACHE_SETS_PER_STEP
+#define STL_CACHE_SETS_PER_STEP 4u /* Cache sets tested per invocation of a cache SBST */
+#endif							   /*STL_CACHE_SETS_PER_STEP*/
+#ifndef STL_CACHE_BUFFER_BYTES
+#define STL_CACHE_BUFFER_BYTES 0x400000u /* Eviction-set buffer: at least 2 x ways x way size of the L2 */
+#endif									 /*STL_CACHE_BUFFER_BYTES*/
+#ifndef STL_CACHE_TIMING_REPEATS
+#define STL_CACHE_TIMING_REPEATS 8u /* Timed walks of an eviction set, the fastest one is kept */
+#endif								/*STL_CACHE_TIMING_REPEATS*/
+#endif								/*STL_USE_CACHE_TEST*/
+
+/**
+ * Coherence SBSTs: the CPUs of a multicore SoC hammer shared lines with atomic operations in
+ * known patterns between barriers, and each one checks the combined signature of all of them.
+ */
+#ifndef STL_USE_COHERENCE_TEST
+#define STL_USE_COHERENCE_TEST 0u /* Enable the atomic and coherence SBSTs (multicore) */
+#endif							  /*STL_USE_COHERENCE_TEST*/
+#if (STL_USE_COHERENCE_TEST > 0u)
+#ifndef STL_COHERENCE_ITERATIONS
+#define STL_COHERENCE_ITERATIONS 64u /* Atomic operations of each kind per CPU and per round */
+#endif								 /*STL_COHERENCE_ITERATIONS*/
+#ifndef STL_COHERENCE_TIMEOUT_CYCLES
+#define STL_COHERENCE_TIMEOUT_CYCLES 100000000u /* Longest wait of a CPU at a barrier of a round */
+#endif											/*STL_COHERENCE_TIMEOUT_CYCLES*/
+#endif											/*STL_USE_COHERENCE_TEST*/
+
+/**
+ * Synchronized test windows: the runtime tests flagged in STL_RT_ROUTINE_SYNC_WINDOW start and
+ * end at a barrier of all the participating CPUs, so that no core runs application code while
+ * they execute (uncore and interconnect tests).
+ */
+#ifndef STL_USE_SYNC_WINDOW
+#define STL_USE_SYNC_WINDOW 0u /* Rendezvous of the CPUs around the flagged runtime tests (multicore) */
+#endif						   /*STL_USE_SYNC_WINDOW*/
+#if (STL_USE_SYNC_WINDOW > 0u)
+#ifndef STL_SYNC_TIMEOUT_CYCLES
+#define STL_SYNC_TIMEOUT_CYCLES 10000000u /* Longest wait of a CPU at the entry or the exit of a window */
+#endif									  /*STL_SYNC_TIMEOUT_CYCLES*/
+#endif									  /*STL_USE_SYNC_WINDOW*/
+
+/**
+ * Software redundancy: the runtime tests flagged in STL_RT_ROUTINE_REDUNDANCY run on both CPUs of a
+ * pair, or twice on one CPU, and the signatures of the two executions are compared (divergence
+ * verdict, apart from the golden comparison).
+ */
+#ifndef STL_USE_REDUNDANCY
+#define STL_USE_REDUNDANCY 0u /* Dual execution of the flagged runtime tests */
+#endif						  /*STL_USE_REDUNDANCY*/
+#if (STL_USE_REDUNDANCY > 0u)
+#ifndef STL_REDUNDANCY_DIVERSITY_CYCLES
+#define STL_REDUNDANCY_DIVERSITY_CYCLES 2000u /* Delay between the two executions of a test on one CPU */
+#endif										  /*STL_REDUNDANCY_DIVERSITY_CYCLES*/
+#ifndef STL_REDUNDANCY_MAX_LAG
+#define STL_REDUNDANCY_MAX_LAG 2u /* Runs a CPU may be ahead of its partner before a timeout verdict */
+#endif							  /*STL_REDUNDANCY_MAX_LAG*/
+#endif							  /*STL_USE_REDUNDANCY*/
 
 /*****************************************************************************************************/
 /****************                  Error Management Module                            ****************/
@@ -179,7 +421,36 @@
 /*****************************************************************************************************/
 
 #define STL_ERROR_MANAGEMENT_ENABLED 1u
+#ifndef STL_ERROR_MANAGEMENT_VERBOSE
 #define STL_ERROR_MANAGEMENT_VERBOSE 0u
+#endif /*STL_ERROR_MANAGEMENT_VERBOSE*/
+
+/**
+ * Binary trace: fixed-size records of the scheduler and error management events in a
+ * lock-free ring per CPU, drained through a sink (see stl_trace.h).
+ */
+#ifndef STL_USE_TRACE
+#define STL_USE_TRACE 0u /* Record the scheduler and error management events */
+#endif					 /*STL_USE_TRACE*/
+#if (STL_USE_TRACE > 0u)
+#ifndef STL_TRACE_RECORDS
+#define STL_TRACE_RECORDS 256u /* Records of the ring of each CPU (power of two) */
+#endif						   /*STL_TRACE_RECORDS*/
+#endif						   /*STL_USE_TRACE*/
+
+/**
+ * Health export: the verdicts of the runtime tests are published in a region shared with an
+ * external supervisor (see stl_health.h). On Linux the region is the POSIX shared-memory
+ * object STL_HEALTH_SHM_NAME.
+ */
+#ifndef STL_USE_HEALTH_EXPORT
+#define STL_USE_HEALTH_EXPORT 0u /* Publish the verdicts in a shared region */
+#endif							 /*STL_USE_HEALTH_EXPORT*/
+#if (STL_USE_HEALTH_EXPORT > 0u)
+#ifndef STL_HEALTH_SHM_NAME
+#define STL_HEALTH_SHM_NAME "/stl_health" /* Name of the shared-memory object (Linux) */
+#endif									  /*STL_HEALTH_SHM_NAME*/
+#endif									  /*STL_USE_HEALTH_EXPORT*/
 
 /*****************************************************************************************************/
 /****************                    Error Check                                      ****************/
@@ -190,4 +461,16 @@
 #error "No tests selected. Please select at least one test type."
 #endif
 
+#if (STL_USE_ISA_DISPATCH > 0u && STL_CONST_TEST_TABLES > 0u)
+#error "The ISA dispatch fills the routine table at STL_init: it cannot be constant."
+#endif
+
+#if (STL_USE_SYNC_WINDOW > 0u && STL_MULTICORE_SOC == 0u)
+#error "The synchronized test windows need a multicore SoC (STL_MULTICORE_SOC)."
+#endif
+
+#if (STL_USE_REDUNDANCY > 0u && STL_REDUNDANCY_MAX_LAG < 2u)
+#error "The first CPU of a pair is always one run ahead: STL_REDUNDANCY_MAX_LAG must be 2 or more."
+#endif
+
 #endif /* __STL_CFG_H__ */
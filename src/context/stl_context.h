@@ -0,0 +1,143 @@
+#if __STL__
+
+#ifndef __STL_CONTEXT_H__
+#define __STL_CONTEXT_H__
+
+/**
+ * @file stl_context.h
+ * @brief Layout of an STL context.
+ *
+ * A context owns what the scheduler and the error management change while the tests run:
+ * the results of the tests, the scheduler cursors and the configuration of the instance
+ * (routine tables, chunk size). Independent test partitions (hypervisor partitions, host
+ * simulation threads, unit tests running in parallel) each use their own context; the API
+ * without context works on STL_default_context.
+ *
+ * The state of each CPU is a block aligned on STL_CACHE_LINE_SIZE: the fields updated by every
+ * test (epoch, cursor, last failure) share the first line, the results of a CPU are contiguous,
+ * and two CPUs or two contexts never write the same line.
+ *
+ * The hardware services (watchdogs, MPU, overlay slots, trace buffers, health export) are not
+ * part of a context and stay shared by the whole process; the health export publishes the
+ * default context only.
+ *
+ * Some modules keep the state of a CPU for the test it is running outside the contexts: the
+ * recovery point of the software deadline monitor, the trace rings, the overlay slots, the
+ * throttle buckets, the redundancy mailboxes and the synchronized windows. Two contexts
+ * running the same CPU would overwrite it, so when one of them is compiled in only the
+ * default context can be used (see STL_CONTEXT_SHARED_CPU_STATE).
+ */
+
+#include "stl.h"
+#include "stl_cfg.h"
+#include "stl_sbst_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+#if (STL_MULTICORE_EXECUTION > 0u)
+#include "stl_al_cpu.h"
+#endif /*STL_MULTICORE_EXECUTION*/
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /*__cplusplus*/
+
+/**
+ * @def STL_CONTEXT_CPUS
+ * @brief Number of CPUs whose state is held by a context.
+ */
+#if (STL_MULTICORE_EXECUTION > 0u)
+#define STL_CONTEXT_CPUS STL_NUM_CPU
+#else
+#define STL_CONTEXT_CPUS 1u
+#endif /*STL_MULTICORE_EXECUTION*/
+
+/**
+ * @def STL_CONTEXT_SHARED_CPU_STATE
+ * @brief Non-zero when a compiled-in module keeps per-CPU state outside the contexts;
+ * STL_context_init then rejects any context but STL_default_context.
+ */
+#define STL_CONTEXT_SHARED_CPU_STATE                                                                                   \
+	((STL_USE_SW_WATCHDOG > 0u) || (STL_USE_TRACE > 0u) || (STL_USE_OVERLAY > 0u) || (STL_USE_THROTTLE > 0u) ||        \
+	 (STL_USE_REDUNDANCY > 0u) || (STL_USE_SYNC_WINDOW > 0u))
+
+	/**
+	 * @typedef STL_EM_TEST_T
+	 * @brief Result of a test, as recorded by the error management.
+	 *
+	 * @var STL_EM_TEST_T::updated
+	 * Cycle counter when the verdict was recorded.
+	 * @var STL_EM_TEST_T::sig
+	 * Signature of the test.
+	 * @var STL_EM_TEST_T::mismatch
+	 * Boolean flag indicating if there is a mismatch in the test.
+	 * @var STL_EM_TEST_T::verdict
+	 * Verdict of the last execution of the test (pass, fail or timeout).
+	 * @var STL_EM_TEST_T::epoch
+	 * Epoch of the CPU when the verdict was recorded. An entry whose epoch differs from the
+	 * current epoch of its CPU is stale and reads as a test that has not run.
+	 */
+	typedef struct
+	{
+		STL_CYCLES_T updated;
+		STL_SIGNATURE_T sig;
+		STL_BOOL mismatch;
+		STL_VERDICT_T verdict;
+		STL_INT32U_T epoch;
+	} STL_EM_TEST_T;
+
+	/**
+	 * @typedef STL_CONTEXT_CPU_T
+	 * @brief State of a CPU in a context.
+	 *
+	 * @var STL_CONTEXT_CPU_T::epoch
+	 * Current epoch of the results of the CPU.
+	 * @var STL_CONTEXT_CPU_T::rt_cursor
+	 * Next runtime test of the chunk-based scheduler.
+	 * @var STL_CONTEXT_CPU_T::last_failed
+	 * Last failed runtime test.
+	 * @var STL_CONTEXT_CPU_T::rt
+	 * Results of the runtime tests.
+	 * @var STL_CONTEXT_CPU_T::pmu
+	 * Performance counters aggregated per runtime test.
+	 * @var STL_CONTEXT_CPU_T::bt
+	 * Results of the boot-time tests.
+	 */
+	typedef struct
+	{
+		STL_INT32U_T epoch;
+		STL_SIZE_T rt_cursor;
+		STL_FAILED_TEST_T last_failed;
+		STL_EM_TEST_T rt[STL_TOT_RT_ROUTINE];
+#if (STL_USE_PMU > 0u)
+		STL_PMU_STATS_T pmu[STL_TOT_RT_ROUTINE];
+#endif /*STL_USE_PMU*/
+		STL_EM_TEST_T bt[STL_TOT_BT_ROUTINE];
+	} ALIGNED_KEYWORD(STL_CACHE_LINE_SIZE) STL_CONTEXT_CPU_T;
+
+	/**
+	 * @brief STL context (declared as STL_CONTEXT_T in stl.h).
+	 *
+	 * @var STL_CONTEXT::cfg
+	 * Configuration, written by STL_context_init only.
+	 * @var STL_CONTEXT::cpu
+	 * State of each CPU.
+	 */
+	struct STL_CONTEXT
+	{
+		STL_CONTEXT_CFG_T cfg;
+		STL_CONTEXT_CPU_T cpu[STL_CONTEXT_CPUS];
+	};
+
+	/**
+	 * @brief Context of the API without context (initialized by STL_init).
+	 */
+	EXTERN_KEYWORD STL_CONTEXT_T STL_default_context;
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /*__STL_CONTEXT_H__*/
+#endif /*__STL__*/
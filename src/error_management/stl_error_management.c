@@ -9,7 +9,10 @@
 
 #include "stl_cfg.h"
 #include "stl_sbst_cfg.h"
+#include "stl_context.h"
 #include "stl_error_management.h"
+#include "stl_health.h"
+#include "stl_trace.h"
 #include "stl_types.h"
 #include "stl.h"
 
@@ -18,183 +21,243 @@
  * @brief This file contains the implementation of error management structures and variables
  *        for the STL (Self-Test Library) framework.
  *
- * The code defines structures and variables used for tracking error signatures and failed tests
- * in both single-core and multi-core execution environments.
+ * The results of the tests are held by an STL context (see stl_context.h): each function
+ * STL_em_ctx_* works on the context passed as first parameter, and the function with the
+ * same name without _ctx is a wrapper on STL_default_context.
+ *
+ * The results of a CPU are cleared in constant time by incrementing the epoch of the CPU:
+ * the entries recorded in an older epoch are not rewritten, they read as a test that has
+ * not run.
  */
 
 /**
- * @typedef STL_EM_TEST_T
- * @brief Structure to hold error management test data.
- *
- * This structure contains the signature and mismatch status for error management tests.
- *
- * @var STL_EM_TEST_T::sig
- * Signature of the test for error management.
- *
- * @var STL_EM_TEST_T::mismatch
- * Boolean flag indicating if there is a mismatch in the test.
+ * @def STL_EM_PUBLISHES
+ * @brief The health export describes the default context only.
  */
+#define STL_EM_PUBLISHES(ctx) ((ctx) == &STL_default_context)
 
 /**
- * @def STL_MULTICORE_EXECUTION
- * @brief Macro to enable or disable multi-core execution support.
- *
- * When defined, the code supports multi-core execution by maintaining separate
- * error management data for each CPU core.
+ * @var em_not_run
+ * @brief Content read in place of a stale entry.
  */
+STATIC_KEYWORD const STL_EM_TEST_T em_not_run = {0u, 0, STL_FALSE, STL_VERDICT_NOT_RUN, 0u};
 
 /**
- * @var em_bt_sign
- * @brief Array to store error management test data for background tests (BT).
+ * @brief Returns the state of a CPU in a context after checking the CPU.
  *
- * In multi-core execution mode, this array is indexed by both routine and CPU core.
- * In single-core execution mode, it is indexed only by routine.
+ * @param ctx The context.
+ * @param cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
+ * @param err Pointer to the error structure to update.
+ * @return The state of the CPU, STL_NULL on error.
  */
+STATIC_KEYWORD INLINE_KEYWORD STL_CONTEXT_CPU_T *STL_em_cpu(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_ERROR_T *err)
+{
+#if (STL_MULTICORE_EXECUTION > 0u)
+	if (cpu >= STL_CONTEXT_CPUS)
+	{
+		*err = STL_CPU_OUT_OF_BOUNDS;
+		return STL_NULL;
+	}
+	*err = STL_ERROR_NONE;
+	return &ctx->cpu[cpu];
+#else
+	(void)cpu; // Suppress unused variable warning if STL_MULTICORE_EXECUTION is not defined
+	*err = STL_ERROR_NONE;
+	return &ctx->cpu[0];
+#endif /*STL_MULTICORE_EXECUTION*/
+}
 
 /**
- * @var em_rt_sign
- * @brief Array to store error management test data for runtime tests (RT).
+ * @brief Returns the entry if it was recorded in the given epoch, the not-run entry otherwise.
  *
- * In multi-core execution mode, this array is indexed by both routine and CPU core.
- * In single-core execution mode, it is indexed only by routine.
+ * @param entry The entry of the test.
+ * @param epoch The current epoch of the CPU of the entry.
+ * @return The entry to read.
  */
+STATIC_KEYWORD INLINE_KEYWORD const STL_EM_TEST_T *STL_em_view(const STL_EM_TEST_T *entry, STL_INT32U_T epoch)
+{
+	return (entry->epoch == epoch) ? entry : &em_not_run;
+}
 
 /**
- * @var last_failed
- * @brief Variable to store the last failed test information.
+ * @brief Starts a new epoch on a CPU: all its results become stale.
  *
- * In multi-core execution mode, this is an array indexed by CPU core.
- * In single-core execution mode, it is a single variable.
+ * When the counter wraps, the entries of the CPU are stamped with epoch 0 once, so that a
+ * result recorded 2^32 epochs ago cannot look current again, and the counting restarts at 1.
  *
- * @note This variable is declared as `volatile` to ensure proper synchronization
- *       in multi-threaded or interrupt-driven environments.
+ * @param state The state of the CPU.
+ * @return None
  */
-typedef struct
+STATIC_KEYWORD void STL_em_advance_epoch(STL_CONTEXT_CPU_T *state)
 {
-	STL_SIGNATURE_T sig;
-	STL_BOOL mismatch;
-} STL_EM_TEST_T;
+	STL_SIZE_T i;
 
-#if STL_MULTICORE_EXECUTION
-STATIC_KEYWORD STL_EM_TEST_T em_bt_sign[STL_NUM_CPU][STL_TOT_BT_ROUTINE];
-STATIC_KEYWORD STL_EM_TEST_T em_rt_sign[STL_NUM_CPU][STL_TOT_RT_ROUTINE];
-#else
-STATIC_KEYWORD STL_EM_TEST_T em_bt_sign[STL_TOT_BT_ROUTINE];
-STATIC_KEYWORD STL_EM_TEST_T em_rt_sign[STL_TOT_RT_ROUTINE];
-#endif /*STL_MULTICORE_EXECUTION*/
+	state->epoch++;
+	if (state->epoch != 0u)
+	{
+		return;
+	}
+	for (i = 0; i < STL_TOT_BT_ROUTINE; i++)
+	{
+		state->bt[i].epoch = 0u;
+	}
+	for (i = 0; i < STL_TOT_RT_ROUTINE; i++)
+	{
+		state->rt[i].epoch = 0u;
+	}
+	state->epoch = 1u;
+}
 
-#if STL_MULTICORE_EXECUTION
-STATIC_KEYWORD STL_FAILED_TEST_T last_failed[STL_NUM_CPU];
-#else
-STATIC_KEYWORD STL_FAILED_TEST_T last_failed;
-#endif /*STL_MULTICORE_EXECUTION*/
+/**
+ * @brief Initializes the error management of a context.
+ *
+ * The results of every CPU are cleared by starting a new epoch, the last failed tests and
+ * the scheduler cursors are reset. The performance counter aggregates are cleared and, for
+ * the default context, the health export is published.
+ *
+ * @param ctx The context.
+ * @param err Pointer to an STL_ERROR_T variable where the error status will be updated.
+ *            It is set to STL_ERROR_NONE if no errors occur.
+ */
+void STL_em_ctx_init(STL_CONTEXT_T *ctx, STL_ERROR_T *err)
+{
+	STL_SIZE_T j;
+
+	*err = STL_ERROR_NONE;
+	/* The results of the previous epoch become stale: the tables are not rewritten */
+	for (j = 0; j < STL_CONTEXT_CPUS; j++)
+	{
+		STL_em_advance_epoch(&ctx->cpu[j]);
+		ctx->cpu[j].rt_cursor = 0;
+		memset(&ctx->cpu[j].last_failed, 0, sizeof(STL_FAILED_TEST_T));
+#if (STL_USE_PMU > 0u)
+		memset(ctx->cpu[j].pmu, 0, sizeof(ctx->cpu[j].pmu));
+#endif /*STL_USE_PMU*/
+	}
+#if (STL_USE_HEALTH_EXPORT > 0u)
+	if (STL_EM_PUBLISHES(ctx))
+	{
+		STL_health_init(err);
+	}
+#endif /*STL_USE_HEALTH_EXPORT*/
+}
 
 /**
  * @brief Initializes the error management system.
  *
- * This function initializes the error management system by setting up the
- * error management test data structures and resetting the last failed test
- * information. It is called at the beginning of the program to prepare for
- * error management operations.
+ * This function initializes the error management of the default context. It is called at
+ * the beginning of the program to prepare for error management operations.
  *
  * @param err Pointer to an STL_ERROR_T variable where the error status will be updated.
  *            It is set to STL_ERROR_NONE if no errors occur.
  */
 void STL_em_init(STL_ERROR_T *err)
 {
-	*err = STL_ERROR_NONE;
-#if STL_ERROR_MANAGEMENT_ENABLED
-	STL_SIZE_T i;
-#if STL_MULTICORE_EXECUTION
+	STL_em_ctx_init(&STL_default_context, err);
+}
+
+/**
+ * @brief Deinitializes the error management of a context.
+ *
+ * The results of every CPU are cleared by starting a new epoch and the last failed tests
+ * are reset. For the default context, the health export is withdrawn.
+ *
+ * @param ctx The context.
+ * @param err Pointer to an STL_ERROR_T variable where the error status will be updated.
+ * 		  It is set to STL_ERROR_NONE if no errors occur.
+ */
+void STL_em_ctx_deinit(STL_CONTEXT_T *ctx, STL_ERROR_T *err)
+{
 	STL_SIZE_T j;
-	for (j = 0; j < STL_NUM_CPU; j++)
-	{
-		last_failed[j] = {0};
-		for (i = 0; i < STL_BOOTTIME_ROUTINES; i++)
-		{
-			em_bt_sign[j][i].sig = 0;
-			em_bt_sign[j][i].mismatch = STL_FALSE;
-		}
 
-		for (i = 0; i < STL_RUNTIME_ROUTINES; i++)
-		{
-			em_rt_sign[j][i].sig = 0;
-			em_rt_sign[j][i].mismatch = STL_FALSE;
-		}
-	}
-#else
-	last_failed.signature = 0;
-	last_failed.index = 0;
-	for (i = 0; i < STL_TOT_BT_ROUTINE; i++)
+	*err = STL_ERROR_NONE;
+	/* Clear the boot-time and runtime results of every CPU by starting a new epoch */
+	for (j = 0; j < STL_CONTEXT_CPUS; j++)
 	{
-		em_bt_sign[i].sig = 0;
-		em_bt_sign[i].mismatch = STL_FALSE;
+		STL_em_advance_epoch(&ctx->cpu[j]);
+		memset(&ctx->cpu[j].last_failed, 0, sizeof(STL_FAILED_TEST_T));
 	}
-
-	for (i = 0; i < STL_TOT_RT_ROUTINE; i++)
+#if (STL_USE_HEALTH_EXPORT > 0u)
+	if (STL_EM_PUBLISHES(ctx))
 	{
-		em_rt_sign[i].sig = 0;
-		em_rt_sign[i].mismatch = STL_FALSE;
+		STL_health_deinit(err);
 	}
-#endif /* STL_MULTICORE_EXECUTION*/
-
-#endif /*STL_ERROR_MANAGEMENT_ENABLED*/
+#endif /* STL_USE_HEALTH_EXPORT */
 }
 
 /**
  * @brief Deinitializes the error management system.
- * This function resets the error management data structures and clears
- * the last failed test information. It is called at the end of the program
- * to clean up resources used by the error management system.
+ * This function resets the error management data of the default context. It is called at
+ * the end of the program to clean up resources used by the error management system.
  * @param err Pointer to an STL_ERROR_T variable where the error status will be updated.
  * 		  It is set to STL_ERROR_NONE if no errors occur.
  * @return void
  * @note This function should be called after all tests have been executed
  * and before the program terminates.
- * It ensures that all error management data structures are reset to their initial state.
  */
 void STL_em_deinit(STL_ERROR_T *err)
 {
-	*err = STL_ERROR_NONE;
-#if STL_ERROR_MANAGEMENT_ENABLED
-	STL_SIZE_T i;
-#if STL_MULTICORE_EXECUTION
-	STL_SIZE_T j;
-	for (j = 0; j < STL_NUM_CPU; j++)
-	{
-		/* Reset the last failed test information for each CPU */
-		memset(&last_failed[j], 0, sizeof(STL_FAILED_TEST_T));
-		/* Clear boot-time test signatures */
-		for (i = 0; i < STL_BOOTTIME_ROUTINES; i++)
-		{
-			em_bt_sign[j][i].sig = 0;
-			em_bt_sign[j][i].mismatch = STL_FALSE;
-		}
-		/* Clear runtime test signatures */
-		for (i = 0; i < STL_RUNTIME_ROUTINES; i++)
-		{
-			em_rt_sign[j][i].sig = 0;
-			em_rt_sign[j][i].mismatch = STL_FALSE;
-		}
-	}
-#else
-	/* Reset single-core last failed test information */
-	memset(&last_failed, 0, sizeof(STL_FAILED_TEST_T));
-	/* Clear boot-time test signatures */
-	for (i = 0; i < STL_TOT_BT_ROUTINE; i++)
+	STL_em_ctx_deinit(&STL_default_context, err);
+}
+
+/**
+ * @brief Starts a new diagnostic cycle on a CPU of a context.
+ *
+ * The boot-time and runtime results of the CPU and its last failed test are cleared in
+ * constant time: the epoch of the CPU is incremented and the entries recorded before read
+ * as STL_VERDICT_NOT_RUN until their test runs again. The performance counter aggregates
+ * and the verdicts already published to the health export are kept.
+ *
+ * @param ctx The context.
+ * @param cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
+ * @param err Pointer to an STL_ERROR_T variable where the error status will be updated.
+ *            It is set to STL_CPU_OUT_OF_BOUNDS if the CPU identifier is invalid.
+ */
+void STL_em_ctx_reset(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_ERROR_T *err)
+{
+	STL_CONTEXT_CPU_T *state = STL_em_cpu(ctx, cpu, err);
+
+	if (state == STL_NULL)
 	{
-		em_bt_sign[i].sig = 0;
-		em_bt_sign[i].mismatch = STL_FALSE;
+		return;
 	}
-	/* Clear runtime test signatures */
-	for (i = 0; i < STL_TOT_RT_ROUTINE; i++)
+	STL_em_advance_epoch(state);
+	memset(&state->last_failed, 0, sizeof(STL_FAILED_TEST_T));
+}
+
+/**
+ * @brief Starts a new diagnostic cycle on a CPU (default context).
+ *
+ * @see STL_em_ctx_reset
+ *
+ * @param cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
+ * @param err Pointer to an STL_ERROR_T variable where the error status will be updated.
+ */
+void STL_em_reset(STL_CPUS cpu, STL_ERROR_T *err)
+{
+	STL_em_ctx_reset(&STL_default_context, cpu, err);
+}
+
+/**
+ * @brief Retrieves the last failed test information for a specific CPU of a context.
+ *
+ * @param ctx The context.
+ * @param cpu The CPU identifier (used in multi-core execution mode).
+ * @param vect Pointer to an STL_FAILED_TEST_T structure where the failed test
+ *             information will be stored.
+ * @param err Pointer to an STL_ERROR_T variable where the error status will be updated.
+ *            It is set to STL_CPU_OUT_OF_BOUNDS if the CPU identifier is invalid
+ */
+void STL_em_ctx_get_last_failed(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_FAILED_TEST_T *vect, STL_ERROR_T *err)
+{
+	const STL_CONTEXT_CPU_T *state = STL_em_cpu(ctx, cpu, err);
+
+	if (state != STL_NULL)
 	{
-		em_rt_sign[i].sig = 0;
-		em_rt_sign[i].mismatch = STL_FALSE;
+		*vect = state->last_failed;
 	}
-#endif /* STL_MULTICORE_EXECUTION */
-#endif /* STL_ERROR_MANAGEMENT_ENABLED */
 }
+
 /**
  * @brief Retrieves the last failed test information for a specific CPU.
  *
@@ -211,19 +274,36 @@ void STL_em_deinit(STL_ERROR_T *err)
  */
 void STL_em_get_last_failed(STL_CPUS cpu, STL_FAILED_TEST_T *vect, STL_ERROR_T *err)
 {
-#if STL_MULTICORE_EXECUTION
-	if (cpu > STL_NUM_CPU)
+	STL_em_ctx_get_last_failed(&STL_default_context, cpu, vect, err);
+}
+
+/**
+ * @brief Checks for failed runtime tests of a context and returns the index of the first failure.
+ *
+ * @param ctx The context.
+ * @param cpu The CPU identifier (used in multi-core execution mode).
+ * @param err Pointer to an STL_ERROR_T variable where the error status will be updated.
+ *            It is set to STL_ERROR_NONE if no errors occur.
+ *
+ * @return The index of the first failed runtime test, or -1 if no failures are found.
+ */
+STL_SIZE_T STL_em_ctx_runtime_failed(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_ERROR_T *err)
+{
+	const STL_CONTEXT_CPU_T *state = STL_em_cpu(ctx, cpu, err);
+	STL_SIZE_T j;
+
+	if (state == STL_NULL)
 	{
-		*err = STL_CPU_OUT_OF_BOUNDS;
-		return;
+		return -1;
 	}
-	*vect = last_failed[cpu];
-#else
-	(void)cpu;	// Suppress unused variable warning if STL_MULTICORE_EXECUTION is not defined
-	*vect = last_failed;
-#endif /*STL_MULTICORE_EXECUTION*/
-*err = STL_ERROR_NONE;
-return;
+	for (j = 0; j < STL_TOT_RT_ROUTINE; j++)
+	{
+		if (STL_em_view(&state->rt[j], state->epoch)->mismatch == STL_TRUE)
+		{
+			return j;
+		}
+	}
+	return -1;
 }
 
 /**
@@ -231,7 +311,6 @@ return;
  *
  * This function iterates through the runtime test signatures and checks for
  * any mismatches. If a mismatch is found, it returns the index of the failed test.
- * In multi-core execution mode, it checks all CPUs for mismatches.
  *
  * @param cpu The CPU identifier (used in multi-core execution mode).
  * @param err Pointer to an STL_ERROR_T variable where the error status will be updated.
@@ -241,30 +320,43 @@ return;
  */
 STL_SIZE_T STL_em_runtime_failed(STL_CPUS cpu, STL_ERROR_T *err)
 {
+	return STL_em_ctx_runtime_failed(&STL_default_context, cpu, err);
+}
+
+/**
+ * @brief Checks for failed boot-time tests of a context and returns the index of the first failure.
+ *
+ * In multi-core execution mode, it checks all CPUs for mismatches.
+ *
+ * @param ctx The context.
+ * @param cpu The CPU identifier (not used: all the CPUs are checked).
+ * @param err Pointer to an STL_ERROR_T variable where the error status will be updated.
+ *            It is set to STL_ERROR_NONE if no errors occur.
+ *
+ * @return The index of the first failed boot-time test, or -1 if no failures are found.
+ */
+STL_SIZE_T STL_em_ctx_bootitme_failed(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_ERROR_T *err)
+{
+	STL_SIZE_T i;
 	STL_SIZE_T j;
-	*err = STL_ERROR_NONE;
 
-#if STL_MULTICORE_EXECUTION
-	for (j = 0; j < STL_TOT_RT_ROUTINE; j++)
+	(void)cpu;
+	*err = STL_ERROR_NONE;
+	for (i = 0; i < STL_CONTEXT_CPUS; i++)
 	{
-		if (em_rt_sign[cpu][j].mismatch == STL_TRUE)
-		{
-			return j;
-		}
-	}
-#else
-	(void)cpu; // Suppress unused variable warning if STL_MULTICORE_EXECUTION is not defined
+		const STL_CONTEXT_CPU_T *state = &ctx->cpu[i];
 
-	for (j = 0; j < STL_TOT_RT_ROUTINE; j++)
-	{
-		if (em_rt_sign[j].mismatch == STL_TRUE)
+		for (j = 0; j < STL_TOT_BT_ROUTINE; j++)
 		{
-			return j;
+			if (STL_em_view(&state->bt[j], state->epoch)->mismatch == STL_TRUE)
+			{
+				return j;
+			}
 		}
 	}
-#endif /*STL_MULTICORE_EXECUTION*/
 	return -1;
 }
+
 /**
  * @brief Checks for failed boot-time tests and returns the index of the first failure.
  *
@@ -279,35 +371,56 @@ STL_SIZE_T STL_em_runtime_failed(STL_CPUS cpu, STL_ERROR_T *err)
  * @return The index of the first failed boot-time test, or -1 if no failures are found.
  */
 STL_SIZE_T STL_em_bootitme_failed(STL_CPUS cpu, STL_ERROR_T *err)
+{
+	return STL_em_ctx_bootitme_failed(&STL_default_context, cpu, err);
+}
+
+/**
+ * @brief Writes the failed entries of a table at their index in the error vector.
+ *
+ * @param entries First entry of the table.
+ * @param total Number of entries of the table.
+ * @param epoch Current epoch of the CPU of the table.
+ * @param vect Error vector (element j describes test j when it failed).
+ * @return None
+ */
+STATIC_KEYWORD void STL_em_scatter_failed(const STL_EM_TEST_T *entries, STL_SIZE_T total, STL_INT32U_T epoch,
+										  STL_FAILED_TEST_T *vect)
 {
 	STL_SIZE_T j;
-	*err = STL_ERROR_NONE;
 
-#if STL_MULTICORE_EXECUTION
-	/*cause the master core will wait for booting the OS*/
-	for (i = 0; i < STL_NUM_CPU; i++)
+	for (j = 0; j < total; j++)
 	{
-		for (j = 0; j < STL_TOT_BT_ROUTINE; j++)
+		const STL_EM_TEST_T *entry = STL_em_view(&entries[j], epoch);
+
+		if (entry->mismatch == STL_TRUE)
 		{
-			if (em_bt_sign[i][j].mismatch == STL_TRUE)
-			{
-				return j;
-			}
+			vect[j].index = j;
+			vect[j].signature = entry->sig;
 		}
 	}
-#else
-	(void)cpu; // Suppress unused variable warning if STL_MULTICORE_EXECUTION is not defined
+}
 
-	for (j = 0; j < STL_TOT_BT_ROUTINE; j++)
+/**
+ * @brief Handles the failed runtime tests of a context and updates the error vector.
+ *
+ * @param[in] ctx The context.
+ * @param[in] cpu The CPU identifier (used in multi-core execution mode).
+ * @param[out] vect Pointer to an array of STL_FAILED_TEST_T structures where
+ *                  the failed test information will be stored.
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error status
+ *                 will be updated. It is set to STL_ERROR_NONE if no errors occur.
+ */
+void STL_em_ctx_failed_runtime_all(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_FAILED_TEST_T *vect, STL_ERROR_T *err)
+{
+	const STL_CONTEXT_CPU_T *state = STL_em_cpu(ctx, cpu, err);
+
+	if (state != STL_NULL)
 	{
-		if (em_bt_sign[j].mismatch == STL_TRUE)
-		{
-			return j;
-		}
+		STL_em_scatter_failed(state->rt, STL_TOT_RT_ROUTINE, state->epoch, vect);
 	}
-#endif /*STL_MULTICORE_EXECUTION*/
-	return -1;
 }
+
 /**
  * @brief Handles the failed runtime tests and updates the error vector.
  *
@@ -320,37 +433,30 @@ STL_SIZE_T STL_em_bootitme_failed(STL_CPUS cpu, STL_ERROR_T *err)
  *                  the failed test information will be stored.
  * @param[out] err Pointer to an STL_ERROR_T variable where the error status
  *                 will be updated. It is set to STL_ERROR_NONE if no errors occur.
- *
- * @note The behavior of this function depends on whether STL_MULTICORE_EXECUTION
- *       is defined. In multi-core mode, the function processes the runtime
- *       signatures for the specified CPU. In single-core mode, it processes
- *       the signatures for all routines.
  */
 void STL_em_failed_runtime_all(STL_CPUS cpu, STL_FAILED_TEST_T *vect, STL_ERROR_T *err)
 {
-	STL_SIZE_T j;
-	*err = STL_ERROR_NONE;
-#if STL_MULTICORE_EXECUTION
-	for (j = 0; j < STL_TOT_RT_ROUTINE; j++)
-	{
-		if (em_rt_sign[cpu][j].mismatch == STL_TRUE)
-		{
-			vect[j].index = j;
-			vect[j].signature = em_rt_sign[cpu][j].sig;
-		}
-	}
-#else
-	(void)cpu; // Suppress unused variable warning if STL_MULTICORE_EXECUTION is not defined
-	
-	for (j = 0; j < STL_TOT_RT_ROUTINE; j++)
+	STL_em_ctx_failed_runtime_all(&STL_default_context, cpu, vect, err);
+}
+
+/**
+ * @brief Handles the failed boot-time tests of a context and updates the error vector.
+ *
+ * @param[in] ctx The context.
+ * @param[in] cpu The CPU identifier (used in multi-core execution mode).
+ * @param[out] vect Pointer to an array of STL_FAILED_TEST_T structures where
+ *                  the failed test information will be stored.
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error status
+ *                 will be updated. It is set to STL_ERROR_NONE if no errors occur.
+ */
+void STL_em_ctx_failed_bootime_all(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_FAILED_TEST_T *vect, STL_ERROR_T *err)
+{
+	const STL_CONTEXT_CPU_T *state = STL_em_cpu(ctx, cpu, err);
+
+	if (state != STL_NULL)
 	{
-		if (em_rt_sign[j].mismatch == STL_TRUE)
-		{
-			vect[j].index = j;
-			vect[j].signature = em_rt_sign[j].sig;
-		}
+		STL_em_scatter_failed(state->bt, STL_TOT_BT_ROUTINE, state->epoch, vect);
 	}
-#endif /*STL_MULTICORE_EXECUTION*/
 }
 
 /**
@@ -365,85 +471,204 @@ void STL_em_failed_runtime_all(STL_CPUS cpu, STL_FAILED_TEST_T *vect, STL_ERROR_
  *                  the failed test information will be stored.
  * @param[out] err Pointer to an STL_ERROR_T variable where the error status
  *                 will be updated. It is set to STL_ERROR_NONE if no errors occur.
- *
- * @note The behavior of this function depends on whether STL_MULTICORE_EXECUTION
- *       is defined. In multi-core mode, the function processes the boot-time
- *       signatures for the specified CPU. In single-core mode, it processes
- *       the signatures for all routines.
  */
 void STL_em_failed_bootime_all(STL_CPUS cpu, STL_FAILED_TEST_T *vect, STL_ERROR_T *err)
 {
-	STL_SIZE_T j;
-	*err = STL_ERROR_NONE;
-#if STL_MULTICORE_EXECUTION
-	for (j = 0; j < STL_TOT_BT_ROUTINE; j++)
-	{
-		if (em_bt_sign[cpu][j].mismatch == STL_TRUE)
-		{
-			vect[j].index = j;
-			vect[j].signature = em_bt_sign[cpu][j].sig;
-		}
-	}
-#else
-	(void) cpu; // Suppress unused variable warning if STL_MULTICORE_EXECUTION is not defined
-
-	for (j = 0; j < STL_TOT_BT_ROUTINE; j++)
-	{
-		if (em_bt_sign[j].mismatch == STL_TRUE)
-		{
-			vect[j].index = j;
-			vect[j].signature = em_bt_sign[j].sig;
-		}
-	}
-#endif /*STL_MULTICORE_EXECUTION*/
+	STL_em_ctx_failed_bootime_all(&STL_default_context, cpu, vect, err);
 }
+
 /**
- * @brief Retrieves the signature of a backtrace routine for a given CPU and index.
+ * @brief Returns the entry of a runtime test after checking the CPU and the index.
  *
- * This function fetches the signature of a backtrace routine based on the specified
- * CPU and index. It performs boundary checks to ensure the CPU and index values
- * are within valid ranges. If the values are out of bounds, an appropriate error
- * code is set in the provided error pointer.
+ * @param ctx The context.
+ * @param cpu The CPU identifier.
+ * @param index The index of the runtime test.
+ * @param epoch Current epoch of the CPU (written only on success).
+ * @param err Pointer to the error structure to update.
+ * @return The entry, STL_NULL on error.
+ */
+STATIC_KEYWORD STL_EM_TEST_T *STL_em_rt_entry(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_SIZE_T index,
+											  STL_INT32U_T *epoch, STL_ERROR_T *err)
+{
+	STL_CONTEXT_CPU_T *state = STL_em_cpu(ctx, cpu, err);
+
+	if (state == STL_NULL)
+	{
+		return STL_NULL;
+	}
+	if (index >= STL_TOT_RT_ROUTINE)
+	{
+		*err = STL_INDEX_OUT_OF_BOUNDS;
+		return STL_NULL;
+	}
+	*epoch = state->epoch;
+	return &state->rt[index];
+}
+
+/**
+ * @brief Returns the entry of a boot-time test after checking the CPU and the index.
  *
+ * @param ctx The context.
+ * @param cpu The CPU identifier.
+ * @param index The index of the boot-time test.
+ * @param epoch Current epoch of the CPU (written only on success).
+ * @param err Pointer to the error structure to update.
+ * @return The entry, STL_NULL on error.
+ */
+STATIC_KEYWORD STL_EM_TEST_T *STL_em_bt_entry(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_SIZE_T index,
+											  STL_INT32U_T *epoch, STL_ERROR_T *err)
+{
+	STL_CONTEXT_CPU_T *state = STL_em_cpu(ctx, cpu, err);
+
+	if (state == STL_NULL)
+	{
+		return STL_NULL;
+	}
+	if (index >= STL_TOT_BT_ROUTINE)
+	{
+		*err = STL_INDEX_OUT_OF_BOUNDS;
+		return STL_NULL;
+	}
+	*epoch = state->epoch;
+	return &state->bt[index];
+}
+
+/**
+ * @brief Retrieves the signature of a runtime test of a context for a given CPU and index.
+ *
+ * @param[in] ctx The context.
  * @param[in] cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
- * @param[in] index The index of the backtrace routine.
+ * @param[in] index The index of the runtime routine.
  * @param[out] err Pointer to an STL_ERROR_T variable where the error code will be stored.
  *                 Possible error codes:
  *                 - STL_CPU_OUT_OF_BOUNDS: The CPU identifier is out of bounds.
  *                 - STL_INDEX_OUT_OF_BOUNDS: The index is out of bounds.
  *                 - STL_ERROR_NONE: No error occurred.
  *
- * @return The signature of the backtrace routine. Returns 0 if an error occurs.
+ * @return The signature of the runtime routine. Returns 0 if an error occurs.
+ */
+STL_SIGNATURE_T STL_em_ctx_rt_get_signature(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_SIZE_T index, STL_ERROR_T *err)
+{
+	STL_INT32U_T epoch = 0u;
+	const STL_EM_TEST_T *entry = STL_em_rt_entry(ctx, cpu, index, &epoch, err);
+
+	return (entry != STL_NULL) ? STL_em_view(entry, epoch)->sig : 0;
+}
+
+/**
+ * @brief Retrieves the signature of a runtime test for a given CPU and index.
+ *
+ * This function fetches the signature of a runtime routine based on the specified
+ * CPU and index. It performs boundary checks to ensure the CPU and index values
+ * are within valid ranges. If the values are out of bounds, an appropriate error
+ * code is set in the provided error pointer.
  *
- * @note If STL_MULTICORE_EXECUTION is enabled, the function checks the CPU identifier
- *       and retrieves the signature from a multi-dimensional array. Otherwise, it
- *       retrieves the signature from a single-dimensional array.
+ * @param[in] cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
+ * @param[in] index The index of the runtime routine.
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error code will be stored.
+ *                 Possible error codes:
+ *                 - STL_CPU_OUT_OF_BOUNDS: The CPU identifier is out of bounds.
+ *                 - STL_INDEX_OUT_OF_BOUNDS: The index is out of bounds.
+ *                 - STL_ERROR_NONE: No error occurred.
+ *
+ * @return The signature of the runtime routine. Returns 0 if an error occurs.
  */
 STL_SIGNATURE_T STL_em_rt_get_signature(STL_CPUS cpu, STL_SIZE_T index, STL_ERROR_T *err)
 {
-	STL_SIGNATURE_T tmp;
-#if (STL_MULTICORE_EXECUTION > 0u)
-	if (cpu >= STL_NUM_CPU)
+	return STL_em_ctx_rt_get_signature(&STL_default_context, cpu, index, err);
+}
+
+/**
+ * @brief Stores a signature in an entry and derives its verdict.
+ * A test that could not run on this CPU (STL_SIGNATURE_SKIPPED) is recorded as not run.
+ *
+ * @param entry The entry of the test.
+ * @param signature The new signature value.
+ * @param epoch The current epoch of the CPU of the entry.
+ * @return None
+ */
+STATIC_KEYWORD void STL_em_store(STL_EM_TEST_T *entry, STL_SIGNATURE_T signature, STL_INT32U_T epoch)
+{
+	entry->sig = signature;
+	entry->epoch = epoch;
+	entry->updated = STL_TSSP_CPU_get_cycles();
+	if (signature == STL_SIGNATURE_MISMATCH)
 	{
-		*err = STL_CPU_OUT_OF_BOUNDS;
-		return 0;
+		entry->mismatch = STL_TRUE;
+		entry->verdict = STL_VERDICT_FAIL;
+	}
+	else if (signature == STL_SIGNATURE_SKIPPED)
+	{
+		entry->mismatch = STL_FALSE;
+		entry->verdict = STL_VERDICT_NOT_RUN;
+	}
+	else
+	{
+		entry->mismatch = STL_FALSE;
+		entry->verdict = STL_VERDICT_PASS;
+	}
+}
+
+/**
+ * @brief Stores the signature of a runtime test and derives its verdict.
+ *
+ * @param ctx The context.
+ * @param index The index of the signature to update.
+ * @param signature The new signature value.
+ * @param cpu The CPU identifier.
+ * @param err Pointer to the error structure to update.
+ * @return The updated entry, STL_NULL on error.
+ */
+STATIC_KEYWORD STL_EM_TEST_T *STL_em_store_sig(STL_CONTEXT_T *ctx, STL_SIZE_T index, STL_SIGNATURE_T signature,
+											   STL_CPUS cpu, STL_ERROR_T *err)
+{
+	STL_CONTEXT_CPU_T *state = STL_em_cpu(ctx, cpu, err);
+	STL_EM_TEST_T *entry;
+
+	if (state == STL_NULL)
+	{
+		return STL_NULL;
 	}
-#endif /*STL_MULTICORE_EXECUTION*/
-	(void )cpu; // Suppress unused variable warning if STL_MULTICORE_EXECUTION is not defined
-	
 	if (index >= STL_TOT_RT_ROUTINE)
 	{
 		*err = STL_INDEX_OUT_OF_BOUNDS;
-		return 0;
+		return STL_NULL;
 	}
-	*err = STL_ERROR_NONE;
+	entry = &state->rt[index];
+	STL_em_store(entry, signature, state->epoch);
+	if (entry->mismatch == STL_TRUE)
+	{
+		state->last_failed.index = index;
+		state->last_failed.signature = signature;
+	}
+	return entry;
+}
 
-#if (STL_MULTICORE_EXECUTION > 0u)
-	tmp = em_rt_sign[cpu][index].sig;
-#else
-	tmp = em_rt_sign[index].sig;
-#endif /*STL_MULTICORE_EXECUTION*/
-	return tmp;
+/**
+ * @brief Updates the signature for a specific index and CPU of a context.
+ *
+ * @param ctx The context.
+ * @param index The index of the signature to update.
+ * @param signature The new signature value.
+ * @param cpu The CPU identifier.
+ * @param err Pointer to the error structure to update.
+ * @return None
+ */
+void STL_em_ctx_update_sig(STL_CONTEXT_T *ctx, STL_SIZE_T index, STL_SIGNATURE_T signature, STL_CPUS cpu,
+						   STL_ERROR_T *err)
+{
+	STL_EM_TEST_T *entry = STL_em_store_sig(ctx, index, signature, cpu, err);
+
+	if (entry != STL_NULL)
+	{
+		STL_TRACE(cpu, STL_TRACE_EV_VERDICT, index, entry->verdict, signature);
+#if (STL_USE_HEALTH_EXPORT > 0u)
+		if (STL_EM_PUBLISHES(ctx))
+		{
+			STL_health_publish(cpu, index, entry->verdict, signature);
+		}
+#endif /*STL_USE_HEALTH_EXPORT*/
+	}
 }
 
 /**
@@ -455,11 +680,744 @@ STL_SIGNATURE_T STL_em_rt_get_signature(STL_CPUS cpu, STL_SIZE_T index, STL_ERRO
  * @param err Pointer to the error structure to update.
  * @return None
  */
-void STL_em_update_sig(STL_SIZE_T index, STL_SIGNATURE_T signature, STL_CPUS cpu, STL_ERROR_T *err){
+void STL_em_update_sig(STL_SIZE_T index, STL_SIGNATURE_T signature, STL_CPUS cpu, STL_ERROR_T *err)
+{
+	STL_em_ctx_update_sig(&STL_default_context, index, signature, cpu, err);
+}
+
+/**
+ * @brief Records a timeout verdict for a specific index and CPU of a context.
+ *
+ * The test is reported as failed (mismatch) and its verdict is set to
+ * STL_VERDICT_TIMEOUT so that it can be told apart from a signature mismatch.
+ *
+ * @param ctx The context.
+ * @param index The index of the aborted test.
+ * @param cpu The CPU identifier.
+ * @param err Pointer to the error structure to update.
+ * @return None
+ */
+void STL_em_ctx_update_timeout(STL_CONTEXT_T *ctx, STL_SIZE_T index, STL_CPUS cpu, STL_ERROR_T *err)
+{
+	STL_EM_TEST_T *entry = STL_em_store_sig(ctx, index, STL_SIGNATURE_MISMATCH, cpu, err);
+
+	if (entry == STL_NULL)
+	{
+		return;
+	}
+	entry->verdict = STL_VERDICT_TIMEOUT;
+	STL_TRACE(cpu, STL_TRACE_EV_VERDICT, index, STL_VERDICT_TIMEOUT, STL_SIGNATURE_MISMATCH);
+#if (STL_USE_HEALTH_EXPORT > 0u)
+	if (STL_EM_PUBLISHES(ctx))
+	{
+		STL_health_publish(cpu, index, STL_VERDICT_TIMEOUT, STL_SIGNATURE_MISMATCH);
+	}
+#endif /*STL_USE_HEALTH_EXPORT*/
+}
+
+/**
+ * @brief Records a timeout verdict for a specific index and CPU.
+ *
+ * @see STL_em_ctx_update_timeout
+ *
+ * @param index The index of the aborted test.
+ * @param cpu The CPU identifier.
+ * @param err Pointer to the error structure to update.
+ * @return None
+ */
+void STL_em_update_timeout(STL_SIZE_T index, STL_CPUS cpu, STL_ERROR_T *err)
+{
+	STL_em_ctx_update_timeout(&STL_default_context, index, cpu, err);
+}
+
+/**
+ * @brief Updates the signature of a boot-time test for a specific index and CPU of a context.
+ *
+ * @param ctx The context.
+ * @param index The index of the boot-time test.
+ * @param signature The new signature value.
+ * @param cpu The CPU identifier.
+ * @param err Pointer to the error structure to update.
+ * @return None
+ */
+void STL_em_ctx_update_bt_sig(STL_CONTEXT_T *ctx, STL_SIZE_T index, STL_SIGNATURE_T signature, STL_CPUS cpu,
+							  STL_ERROR_T *err)
+{
+	STL_INT32U_T epoch = 0u;
+	STL_EM_TEST_T *entry = STL_em_bt_entry(ctx, cpu, index, &epoch, err);
+
+	if (entry != STL_NULL)
+	{
+		STL_em_store(entry, signature, epoch);
+	}
+}
+
+/**
+ * @brief Updates the signature of a boot-time test for a specific index and CPU.
+ *
+ * @param index The index of the boot-time test.
+ * @param signature The new signature value.
+ * @param cpu The CPU identifier.
+ * @param err Pointer to the error structure to update.
+ * @return None
+ */
+void STL_em_update_bt_sig(STL_SIZE_T index, STL_SIGNATURE_T signature, STL_CPUS cpu, STL_ERROR_T *err)
+{
+	STL_em_ctx_update_bt_sig(&STL_default_context, index, signature, cpu, err);
+}
+
+/**
+ * @brief Retrieves the runtime verdict for a specific CPU and index of a context.
+ *
+ * @param[in] ctx The context.
+ * @param[in] cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
+ * @param[in] index The index of the runtime routine.
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error code will be stored.
+ *                 Possible error codes:
+ *                 - STL_CPU_OUT_OF_BOUNDS: The CPU identifier is out of bounds.
+ *                 - STL_INDEX_OUT_OF_BOUNDS: The index is out of bounds.
+ *                 - STL_ERROR_NONE: No error occurred.
+ *
+ * @return The verdict of the runtime routine. Returns STL_VERDICT_NOT_RUN if an error occurs.
+ */
+STL_VERDICT_T STL_em_ctx_rt_get_verdict(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_SIZE_T index, STL_ERROR_T *err)
+{
+	STL_INT32U_T epoch = 0u;
+	const STL_EM_TEST_T *entry = STL_em_rt_entry(ctx, cpu, index, &epoch, err);
+
+	return (entry != STL_NULL) ? STL_em_view(entry, epoch)->verdict : STL_VERDICT_NOT_RUN;
+}
+
+/**
+ * @brief Retrieves the runtime verdict for a specific CPU and index.
+ *
+ * @param[in] cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
+ * @param[in] index The index of the runtime routine.
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error code will be stored.
+ *                 Possible error codes:
+ *                 - STL_CPU_OUT_OF_BOUNDS: The CPU identifier is out of bounds.
+ *                 - STL_INDEX_OUT_OF_BOUNDS: The index is out of bounds.
+ *                 - STL_ERROR_NONE: No error occurred.
+ *
+ * @return The verdict of the runtime routine. Returns STL_VERDICT_NOT_RUN if an error occurs.
+ */
+STL_VERDICT_T STL_em_rt_get_verdict(STL_CPUS cpu, STL_SIZE_T index, STL_ERROR_T *err)
+{
+	return STL_em_ctx_rt_get_verdict(&STL_default_context, cpu, index, err);
+}
+
+/**
+ * @brief Retrieves the signature of a boot-time test of a context for a given CPU and index.
+ *
+ * @param[in] ctx The context.
+ * @param[in] cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
+ * @param[in] index The index of the boot-time routine.
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error code will be stored.
+ *
+ * @return The signature of the boot-time routine. Returns 0 if an error occurs.
+ */
+STL_SIGNATURE_T STL_em_ctx_bt_get_signature(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_SIZE_T index, STL_ERROR_T *err)
+{
+	STL_INT32U_T epoch = 0u;
+	const STL_EM_TEST_T *entry = STL_em_bt_entry(ctx, cpu, index, &epoch, err);
+
+	return (entry != STL_NULL) ? STL_em_view(entry, epoch)->sig : 0;
+}
+
+/**
+ * @brief Retrieves the signature of a boot-time test for a given CPU and index.
+ *
+ * @param[in] cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
+ * @param[in] index The index of the boot-time routine.
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error code will be stored.
+ *                 Possible error codes:
+ *                 - STL_CPU_OUT_OF_BOUNDS: The CPU identifier is out of bounds.
+ *                 - STL_INDEX_OUT_OF_BOUNDS: The index is out of bounds.
+ *                 - STL_ERROR_NONE: No error occurred.
+ *
+ * @return The signature of the boot-time routine. Returns 0 if an error occurs.
+ */
+STL_SIGNATURE_T STL_em_bt_get_signature(STL_CPUS cpu, STL_SIZE_T index, STL_ERROR_T *err)
+{
+	return STL_em_ctx_bt_get_signature(&STL_default_context, cpu, index, err);
+}
+
+/**
+ * @brief Copies the signatures, verdicts and timestamps of consecutive entries.
+ *
+ * Each output is a separate array (structure of arrays) and may be STL_NULL when it is not
+ * needed; each array is filled by its own loop.
+ *
+ * @param entries First entry to copy.
+ * @param count Number of entries to copy.
+ * @param epoch Current epoch of the CPU of the entries.
+ * @param sig Output signatures, or STL_NULL.
+ * @param verdict Output verdicts, or STL_NULL.
+ * @param updated Output timestamps (cycle counter of the verdicts), or STL_NULL.
+ * @return None
+ */
+STATIC_KEYWORD void STL_em_copy(const STL_EM_TEST_T *entries, STL_INT32U_T count, STL_INT32U_T epoch,
+								STL_SIGNATURE_T *sig, STL_VERDICT_T *verdict, STL_CYCLES_T *updated)
+{
+	STL_INT32U_T i;
+
+	if (sig != STL_NULL)
+	{
+		for (i = 0; i < count; i++)
+		{
+			sig[i] = STL_em_view(&entries[i], epoch)->sig;
+		}
+	}
+	if (verdict != STL_NULL)
+	{
+		for (i = 0; i < count; i++)
+		{
+			verdict[i] = STL_em_view(&entries[i], epoch)->verdict;
+		}
+	}
+	if (updated != STL_NULL)
+	{
+		for (i = 0; i < count; i++)
+		{
+			updated[i] = STL_em_view(&entries[i], epoch)->updated;
+		}
+	}
+}
+
+/**
+ * @brief Builds the compacted list of the failed entries.
+ *
+ * @param entries First entry of the table of a CPU.
+ * @param total Number of entries of the table.
+ * @param vect Output list, filled from its first element.
+ * @param max Capacity of the output list.
+ * @param epoch Current epoch of the CPU of the table.
+ * @return Number of failed entries (may exceed max: only max are written).
+ */
+STATIC_KEYWORD STL_SIZE_T STL_em_collect_failed(const STL_EM_TEST_T *entries, STL_SIZE_T total,
+												STL_FAILED_TEST_T *vect, STL_SIZE_T max, STL_INT32U_T epoch)
+{
+	STL_SIZE_T j;
+	STL_SIZE_T failed = 0;
+
+	for (j = 0; j < total; j++)
+	{
+		const STL_EM_TEST_T *entry = STL_em_view(&entries[j], epoch);
+
+		if (entry->mismatch == STL_TRUE)
+		{
+			if (failed < max)
+			{
+				vect[failed].index = j;
+				vect[failed].signature = entry->sig;
+			}
+			failed++;
+		}
+	}
+	return failed;
+}
+
+/**
+ * @brief Copies the signatures, verdicts and timestamps of a range of runtime tests of a CPU
+ * of a context.
+ *
+ * The range is clipped to the last runtime test. Element i of each output describes test
+ * first + i. Outputs that are not needed can be STL_NULL.
+ *
+ * @param[in] ctx The context.
+ * @param[in] cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
+ * @param[in] first Index of the first runtime test.
+ * @param[in] count Number of tests (capacity of the outputs).
+ * @param[out] sig Signatures, or STL_NULL.
+ * @param[out] verdict Verdicts, or STL_NULL.
+ * @param[out] updated Cycle counter of the verdicts, or STL_NULL.
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error code will be stored.
+ *                 Possible error codes:
+ *                 - STL_CPU_OUT_OF_BOUNDS: The CPU identifier is out of bounds.
+ *                 - STL_INDEX_OUT_OF_BOUNDS: The first index is out of bounds.
+ *                 - STL_ERROR_NONE: No error occurred.
+ *
+ * @return The number of tests copied.
+ */
+STL_SIZE_T STL_em_ctx_rt_get_range(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_SIZE_T first, STL_SIZE_T count,
+								   STL_SIGNATURE_T *sig, STL_VERDICT_T *verdict, STL_CYCLES_T *updated,
+								   STL_ERROR_T *err)
+{
+	STL_INT32U_T epoch = 0u;
+	const STL_EM_TEST_T *entries = STL_em_rt_entry(ctx, cpu, first, &epoch, err);
+
+	if (entries == STL_NULL)
+	{
+		return 0;
+	}
+	if (count > STL_TOT_RT_ROUTINE - first)
+	{
+		count = STL_TOT_RT_ROUTINE - first;
+	}
+	STL_em_copy(entries, count, epoch, sig, verdict, updated);
+	return count;
+}
+
+/**
+ * @brief Copies the signatures, verdicts and timestamps of a range of runtime tests of a CPU.
+ *
+ * @see STL_em_ctx_rt_get_range
+ *
+ * @param[in] cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
+ * @param[in] first Index of the first runtime test.
+ * @param[in] count Number of tests (capacity of the outputs).
+ * @param[out] sig Signatures, or STL_NULL.
+ * @param[out] verdict Verdicts, or STL_NULL.
+ * @param[out] updated Cycle counter of the verdicts, or STL_NULL.
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error code will be stored.
+ *
+ * @return The number of tests copied.
+ */
+STL_SIZE_T STL_em_rt_get_range(STL_CPUS cpu, STL_SIZE_T first, STL_SIZE_T count, STL_SIGNATURE_T *sig,
+							   STL_VERDICT_T *verdict, STL_CYCLES_T *updated, STL_ERROR_T *err)
+{
+	return STL_em_ctx_rt_get_range(&STL_default_context, cpu, first, count, sig, verdict, updated, err);
+}
+
+/**
+ * @brief Retrieves the verdict of a cooperative runtime test run by a range of CPUs of a context.
+ *
+ * The CPUs of a cooperative test (coherence SBST) each record the combined signature of the
+ * round. The test passes when all the CPUs passed with the same signature; it fails when one
+ * of them failed or timed out, or when their signatures differ; otherwise it has not run on
+ * every CPU yet.
+ *
+ * @param[in] ctx The context.
+ * @param[in] index The index of the runtime test.
+ * @param[in] first The first CPU running the test.
+ * @param[in] count The number of CPUs running the test.
+ * @param[out] sig The common signature, or STL_NULL (written only when the test passes).
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error code will be stored.
+ *                 Possible error codes:
+ *                 - STL_CPU_OUT_OF_BOUNDS: The range of CPUs is empty or out of bounds.
+ *                 - STL_INDEX_OUT_OF_BOUNDS: The index is out of bounds.
+ *                 - STL_ERROR_NONE: No error occurred.
+ *
+ * @return The verdict of the test on the range of CPUs.
+ */
+STL_VERDICT_T STL_em_ctx_rt_get_combined(STL_CONTEXT_T *ctx, STL_SIZE_T index, STL_CPUS first, STL_CPUS count,
+										 STL_SIGNATURE_T *sig, STL_ERROR_T *err)
+{
+	STL_INT32U_T epoch = 0u;
+	const STL_EM_TEST_T *entry;
+	STL_VERDICT_T verdict = STL_VERDICT_PASS;
+	STL_SIGNATURE_T common = 0;
+	STL_BOOL recorded = STL_FALSE;
+	STL_CPUS cpu;
+
+	if (count == 0u || (STL_SIZE_T)first + count > STL_CONTEXT_CPUS)
+	{
+		*err = STL_CPU_OUT_OF_BOUNDS;
+		return STL_VERDICT_NOT_RUN;
+	}
+	for (cpu = first; cpu < first + count; cpu++)
+	{
+		entry = STL_em_rt_entry(ctx, cpu, index, &epoch, err);
+		if (entry == STL_NULL)
+		{
+			return STL_VERDICT_NOT_RUN;
+		}
+		entry = STL_em_view(entry, epoch);
+		if (entry->verdict == STL_VERDICT_FAIL || entry->verdict == STL_VERDICT_TIMEOUT)
+		{
+			return STL_VERDICT_FAIL;
+		}
+		if (entry->verdict == STL_VERDICT_NOT_RUN)
+		{
+			verdict = STL_VERDICT_NOT_RUN;
+		}
+		else if (recorded == STL_FALSE)
+		{
+			common = entry->sig;
+			recorded = STL_TRUE;
+		}
+		else if (entry->sig != common)
+		{
+			/* The CPUs did not see the same round */
+			return STL_VERDICT_FAIL;
+		}
+	}
+	if (verdict == STL_VERDICT_PASS && sig != STL_NULL)
+	{
+		*sig = common;
+	}
+	return verdict;
+}
+
+/**
+ * @brief Retrieves the verdict of a cooperative runtime test run by a range of CPUs.
+ *
+ * @see STL_em_ctx_rt_get_combined
+ *
+ * @param[in] index The index of the runtime test.
+ * @param[in] first The first CPU running the test.
+ * @param[in] count The number of CPUs running the test.
+ * @param[out] sig The common signature, or STL_NULL.
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error code will be stored.
+ *
+ * @return The verdict of the test on the range of CPUs.
+ */
+STL_VERDICT_T STL_em_rt_get_combined(STL_SIZE_T index, STL_CPUS first, STL_CPUS count, STL_SIGNATURE_T *sig,
+									 STL_ERROR_T *err)
+{
+	return STL_em_ctx_rt_get_combined(&STL_default_context, index, first, count, sig, err);
+}
+
+/**
+ * @brief Copies the signatures, verdicts and timestamps of a range of boot-time tests of a CPU
+ * of a context.
+ *
+ * @see STL_em_ctx_rt_get_range
+ *
+ * @param[in] ctx The context.
+ * @param[in] cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
+ * @param[in] first Index of the first boot-time test.
+ * @param[in] count Number of tests (capacity of the outputs).
+ * @param[out] sig Signatures, or STL_NULL.
+ * @param[out] verdict Verdicts, or STL_NULL.
+ * @param[out] updated Cycle counter of the verdicts, or STL_NULL.
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error code will be stored.
+ *
+ * @return The number of tests copied.
+ */
+STL_SIZE_T STL_em_ctx_bt_get_range(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_SIZE_T first, STL_SIZE_T count,
+								   STL_SIGNATURE_T *sig, STL_VERDICT_T *verdict, STL_CYCLES_T *updated,
+								   STL_ERROR_T *err)
+{
+	STL_INT32U_T epoch = 0u;
+	const STL_EM_TEST_T *entries = STL_em_bt_entry(ctx, cpu, first, &epoch, err);
+
+	if (entries == STL_NULL)
+	{
+		return 0;
+	}
+	if (count > STL_TOT_BT_ROUTINE - first)
+	{
+		count = STL_TOT_BT_ROUTINE - first;
+	}
+	STL_em_copy(entries, count, epoch, sig, verdict, updated);
+	return count;
+}
+
+/**
+ * @brief Copies the signatures, verdicts and timestamps of a range of boot-time tests of a CPU.
+ *
+ * @see STL_em_ctx_bt_get_range
+ *
+ * @param[in] cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
+ * @param[in] first Index of the first boot-time test.
+ * @param[in] count Number of tests (capacity of the outputs).
+ * @param[out] sig Signatures, or STL_NULL.
+ * @param[out] verdict Verdicts, or STL_NULL.
+ * @param[out] updated Cycle counter of the verdicts, or STL_NULL.
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error code will be stored.
+ *
+ * @return The number of tests copied.
+ */
+STL_SIZE_T STL_em_bt_get_range(STL_CPUS cpu, STL_SIZE_T first, STL_SIZE_T count, STL_SIGNATURE_T *sig,
+							   STL_VERDICT_T *verdict, STL_CYCLES_T *updated, STL_ERROR_T *err)
+{
+	return STL_em_ctx_bt_get_range(&STL_default_context, cpu, first, count, sig, verdict, updated, err);
+}
+
+/**
+ * @brief Output element of CPU cpu in an all-CPU query, or STL_NULL for an unused output.
+ */
+#define STL_EM_OUT(out, cpu, per_cpu) (((out) != STL_NULL) ? &(out)[(cpu) * (per_cpu)] : STL_NULL)
+
+/**
+ * @brief Copies the signatures, verdicts and timestamps of the runtime tests of all the CPUs
+ * of a context.
+ *
+ * The outputs hold STL_TOT_RT_ROUTINE elements per CPU, CPU after CPU: element
+ * cpu * STL_TOT_RT_ROUTINE + index describes test index of CPU cpu. Outputs that are not
+ * needed can be STL_NULL.
+ *
+ * @param[in] ctx The context.
+ * @param[out] sig Signatures, or STL_NULL.
+ * @param[out] verdict Verdicts, or STL_NULL.
+ * @param[out] updated Cycle counter of the verdicts, or STL_NULL.
+ * @param[out] err Pointer to an STL_ERROR_T variable, set to STL_ERROR_NONE.
+ *
+ * @return The number of elements written in each output.
+ */
+STL_INT32U_T STL_em_ctx_rt_get_all(STL_CONTEXT_T *ctx, STL_SIGNATURE_T *sig, STL_VERDICT_T *verdict,
+								   STL_CYCLES_T *updated, STL_ERROR_T *err)
+{
+	STL_INT32U_T c;
+
+	*err = STL_ERROR_NONE;
+	for (c = 0; c < STL_CONTEXT_CPUS; c++)
+	{
+		STL_em_copy(ctx->cpu[c].rt, STL_TOT_RT_ROUTINE, ctx->cpu[c].epoch, STL_EM_OUT(sig, c, STL_TOT_RT_ROUTINE),
+					STL_EM_OUT(verdict, c, STL_TOT_RT_ROUTINE), STL_EM_OUT(updated, c, STL_TOT_RT_ROUTINE));
+	}
+	return STL_CONTEXT_CPUS * STL_TOT_RT_ROUTINE;
+}
+
+/**
+ * @brief Copies the signatures, verdicts and timestamps of the runtime tests of all the CPUs.
+ *
+ * @see STL_em_ctx_rt_get_all
+ *
+ * @param[out] sig Signatures, or STL_NULL.
+ * @param[out] verdict Verdicts, or STL_NULL.
+ * @param[out] updated Cycle counter of the verdicts, or STL_NULL.
+ * @param[out] err Pointer to an STL_ERROR_T variable, set to STL_ERROR_NONE.
+ *
+ * @return The number of elements written in each output.
+ */
+STL_INT32U_T STL_em_rt_get_all(STL_SIGNATURE_T *sig, STL_VERDICT_T *verdict, STL_CYCLES_T *updated, STL_ERROR_T *err)
+{
+	return STL_em_ctx_rt_get_all(&STL_default_context, sig, verdict, updated, err);
+}
+
+/**
+ * @brief Copies the signatures, verdicts and timestamps of the boot-time tests of all the CPUs
+ * of a context.
+ *
+ * @see STL_em_ctx_rt_get_all
+ *
+ * @param[in] ctx The context.
+ * @param[out] sig Signatures, or STL_NULL.
+ * @param[out] verdict Verdicts, or STL_NULL.
+ * @param[out] updated Cycle counter of the verdicts, or STL_NULL.
+ * @param[out] err Pointer to an STL_ERROR_T variable, set to STL_ERROR_NONE.
+ *
+ * @return The number of elements written in each output.
+ */
+STL_INT32U_T STL_em_ctx_bt_get_all(STL_CONTEXT_T *ctx, STL_SIGNATURE_T *sig, STL_VERDICT_T *verdict,
+								   STL_CYCLES_T *updated, STL_ERROR_T *err)
+{
+	STL_INT32U_T c;
+
 	*err = STL_ERROR_NONE;
-	// TODO to implement 
+	for (c = 0; c < STL_CONTEXT_CPUS; c++)
+	{
+		STL_em_copy(ctx->cpu[c].bt, STL_TOT_BT_ROUTINE, ctx->cpu[c].epoch, STL_EM_OUT(sig, c, STL_TOT_BT_ROUTINE),
+					STL_EM_OUT(verdict, c, STL_TOT_BT_ROUTINE), STL_EM_OUT(updated, c, STL_TOT_BT_ROUTINE));
+	}
+	return STL_CONTEXT_CPUS * STL_TOT_BT_ROUTINE;
 }
-    
+
+/**
+ * @brief Copies the signatures, verdicts and timestamps of the boot-time tests of all the CPUs.
+ *
+ * @see STL_em_ctx_rt_get_all
+ *
+ * @param[out] sig Signatures, or STL_NULL.
+ * @param[out] verdict Verdicts, or STL_NULL.
+ * @param[out] updated Cycle counter of the verdicts, or STL_NULL.
+ * @param[out] err Pointer to an STL_ERROR_T variable, set to STL_ERROR_NONE.
+ *
+ * @return The number of elements written in each output.
+ */
+STL_INT32U_T STL_em_bt_get_all(STL_SIGNATURE_T *sig, STL_VERDICT_T *verdict, STL_CYCLES_T *updated, STL_ERROR_T *err)
+{
+	return STL_em_ctx_bt_get_all(&STL_default_context, sig, verdict, updated, err);
+}
+
+/**
+ * @brief Lists the failed runtime tests (fail or timeout) of a CPU of a context.
+ *
+ * Unlike STL_em_ctx_failed_runtime_all, the list is compacted: the failed tests are written
+ * from vect[0], in index order, up to max elements.
+ *
+ * @param[in] ctx The context.
+ * @param[in] cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
+ * @param[out] vect List of the failed tests.
+ * @param[in] max Capacity of the list.
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error code will be stored.
+ *
+ * @return The number of failed tests; when it exceeds max, only the first max are listed.
+ */
+STL_SIZE_T STL_em_ctx_rt_get_failed(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_FAILED_TEST_T *vect, STL_SIZE_T max,
+									STL_ERROR_T *err)
+{
+	const STL_CONTEXT_CPU_T *state = STL_em_cpu(ctx, cpu, err);
+
+	if (state == STL_NULL)
+	{
+		return 0;
+	}
+	return STL_em_collect_failed(state->rt, STL_TOT_RT_ROUTINE, vect, max, state->epoch);
+}
+
+/**
+ * @brief Lists the failed runtime tests (fail or timeout) of a CPU.
+ *
+ * @see STL_em_ctx_rt_get_failed
+ *
+ * @param[in] cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
+ * @param[out] vect List of the failed tests.
+ * @param[in] max Capacity of the list.
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error code will be stored.
+ *
+ * @return The number of failed tests; when it exceeds max, only the first max are listed.
+ */
+STL_SIZE_T STL_em_rt_get_failed(STL_CPUS cpu, STL_FAILED_TEST_T *vect, STL_SIZE_T max, STL_ERROR_T *err)
+{
+	return STL_em_ctx_rt_get_failed(&STL_default_context, cpu, vect, max, err);
+}
+
+/**
+ * @brief Lists the failed boot-time tests of a CPU of a context.
+ *
+ * @see STL_em_ctx_rt_get_failed
+ *
+ * @param[in] ctx The context.
+ * @param[in] cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
+ * @param[out] vect List of the failed tests.
+ * @param[in] max Capacity of the list.
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error code will be stored.
+ *
+ * @return The number of failed tests; when it exceeds max, only the first max are listed.
+ */
+STL_SIZE_T STL_em_ctx_bt_get_failed(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_FAILED_TEST_T *vect, STL_SIZE_T max,
+									STL_ERROR_T *err)
+{
+	const STL_CONTEXT_CPU_T *state = STL_em_cpu(ctx, cpu, err);
+
+	if (state == STL_NULL)
+	{
+		return 0;
+	}
+	return STL_em_collect_failed(state->bt, STL_TOT_BT_ROUTINE, vect, max, state->epoch);
+}
+
+/**
+ * @brief Lists the failed boot-time tests of a CPU.
+ *
+ * @see STL_em_ctx_rt_get_failed
+ *
+ * @param[in] cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
+ * @param[out] vect List of the failed tests.
+ * @param[in] max Capacity of the list.
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error code will be stored.
+ *
+ * @return The number of failed tests; when it exceeds max, only the first max are listed.
+ */
+STL_SIZE_T STL_em_bt_get_failed(STL_CPUS cpu, STL_FAILED_TEST_T *vect, STL_SIZE_T max, STL_ERROR_T *err)
+{
+	return STL_em_ctx_bt_get_failed(&STL_default_context, cpu, vect, max, err);
+}
+
+#if (STL_USE_PMU > 0u)
+/**
+ * @brief Accumulates the performance counters sampled around a runtime test of a context.
+ *
+ * The difference between the two samples is recorded as the last execution of the test,
+ * added to the running sums and compared with the worst execution, counter by counter.
+ *
+ * @param ctx The context.
+ * @param index The index of the runtime test.
+ * @param before Counters sampled before the test.
+ * @param after Counters sampled after the test.
+ * @param cpu The CPU identifier.
+ * @param err Pointer to the error structure to update.
+ * @return None
+ */
+void STL_em_ctx_update_pmu(STL_CONTEXT_T *ctx, STL_SIZE_T index, const STL_PMU_SAMPLE_T *before,
+						   const STL_PMU_SAMPLE_T *after, STL_CPUS cpu, STL_ERROR_T *err)
+{
+	STL_CONTEXT_CPU_T *state = STL_em_cpu(ctx, cpu, err);
+	STL_PMU_STATS_T *stats;
+	STL_SIZE_T i;
+
+	if (state == STL_NULL)
+	{
+		return;
+	}
+	if (index >= STL_TOT_RT_ROUTINE)
+	{
+		*err = STL_INDEX_OUT_OF_BOUNDS;
+		return;
+	}
+	stats = &state->pmu[index];
+
+	stats->runs++;
+	for (i = 0; i < STL_PMU_NUM_COUNTERS; i++)
+	{
+		STL_CYCLES_T delta = after->count[i] - before->count[i];
+
+		stats->last[i] = delta;
+		stats->sum[i] += delta;
+		if (delta > stats->max[i])
+		{
+			stats->max[i] = delta;
+		}
+	}
+}
+
+/**
+ * @brief Accumulates the performance counters sampled around a runtime test.
+ *
+ * @see STL_em_ctx_update_pmu
+ *
+ * @param index The index of the runtime test.
+ * @param before Counters sampled before the test.
+ * @param after Counters sampled after the test.
+ * @param cpu The CPU identifier.
+ * @param err Pointer to the error structure to update.
+ * @return None
+ */
+void STL_em_update_pmu(STL_SIZE_T index, const STL_PMU_SAMPLE_T *before, const STL_PMU_SAMPLE_T *after,
+					   STL_CPUS cpu, STL_ERROR_T *err)
+{
+	STL_em_ctx_update_pmu(&STL_default_context, index, before, after, cpu, err);
+}
+
+/**
+ * @brief Retrieves the performance counters aggregated for a runtime test of a context.
+ *
+ * @param[in] ctx The context.
+ * @param[in] cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
+ * @param[in] index The index of the runtime routine.
+ * @param[out] stats Pointer to the aggregate to fill (left untouched on error).
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error code will be stored.
+ *                 Possible error codes:
+ *                 - STL_CPU_OUT_OF_BOUNDS: The CPU identifier is out of bounds.
+ *                 - STL_INDEX_OUT_OF_BOUNDS: The index is out of bounds.
+ *                 - STL_ERROR_NONE: No error occurred.
+ */
+void STL_em_ctx_rt_get_pmu(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_SIZE_T index, STL_PMU_STATS_T *stats,
+						   STL_ERROR_T *err)
+{
+	const STL_CONTEXT_CPU_T *state = STL_em_cpu(ctx, cpu, err);
+
+	if (state == STL_NULL)
+	{
+		return;
+	}
+	if (index >= STL_TOT_RT_ROUTINE)
+	{
+		*err = STL_INDEX_OUT_OF_BOUNDS;
+		return;
+	}
+	*stats = state->pmu[index];
+}
+
+/**
+ * @brief Retrieves the performance counters aggregated for a runtime test.
+ *
+ * @see STL_em_ctx_rt_get_pmu
+ *
+ * @param[in] cpu The CPU identifier (only relevant if STL_MULTICORE_EXECUTION is enabled).
+ * @param[in] index The index of the runtime routine.
+ * @param[out] stats Pointer to the aggregate to fill (left untouched on error).
+ * @param[out] err Pointer to an STL_ERROR_T variable where the error code will be stored.
+ */
+void STL_em_rt_get_pmu(STL_CPUS cpu, STL_SIZE_T index, STL_PMU_STATS_T *stats, STL_ERROR_T *err)
+{
+	STL_em_ctx_rt_get_pmu(&STL_default_context, cpu, index, stats, err);
+}
+#endif /*STL_USE_PMU*/
+
 
 #endif /*STL_ERROR_MANAGEMENT_ENABLED*/
 
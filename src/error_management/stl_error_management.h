@@ -1,15 +1,13 @@
 #if __STL__
 
-#ifndef __STL_EM__MODULE__
-#define __STL_EM__MODULE__
+#ifndef __STL_ERROR_MANAGEMENT_H__
+#define __STL_ERROR_MANAGEMENT_H__
 #include "stl_cfg.h"
 
 #if STL_ERROR_MANAGEMENT_ENABLED
 
 #include "stl.h"
 
-#include "stl_al_os.h"
-#include "stl_core.h"
 #include "stl_tssp.h"
 
 /**
@@ -26,15 +24,96 @@ extern "C"
 {
 #endif /* __cplusplus */
 
+	/*
+	 * Each function exists in two forms: STL_em_ctx_* works on the context passed as first
+	 * parameter, STL_em_* on STL_default_context. The queries on a context are declared in
+	 * stl.h; the functions below are used by the scheduler and by STL_context_init.
+	 */
+
+	/**
+	 * @brief Initializes the error management of a context.
+	 *
+	 * @param ctx The context.
+	 * @param err Pointer to the error structure to initialize.
+	 */
+	void STL_em_ctx_init(STL_CONTEXT_T *ctx, STL_ERROR_T *err);
+
+	/**
+	 * @brief Deinitializes the error management of a context.
+	 *
+	 * @param ctx The context.
+	 * @param err Pointer to the error structure to initialize.
+	 */
+	void STL_em_ctx_deinit(STL_CONTEXT_T *ctx, STL_ERROR_T *err);
+
+	/**
+	 * @brief Retrieves the last failed test of a CPU of a context.
+	 *
+	 * @param ctx The context.
+	 * @param cpu The CPU identifier.
+	 * @param vect Pointer to the structure where the failed test is stored.
+	 * @param err Pointer to the error structure to update.
+	 */
+	void STL_em_ctx_get_last_failed(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_FAILED_TEST_T *vect, STL_ERROR_T *err);
+
 	/**
-	 * @struct STL_EM_TEST_T
-	 * @brief Structure representing a test for error management.
+	 * @brief Returns the index of the first failed boot-time test of a context (all the CPUs).
 	 *
-	 * @var STL_EM_TEST_T::sig
-	 * Signature of the test.
-	 * @var STL_EM_TEST_T::mismatch
-	 * Boolean indicating if there is a mismatch.
+	 * @param ctx The context.
+	 * @param cpu The CPU identifier.
+	 * @param err Pointer to the error structure to update.
+	 * @return The index of the first failed test, or -1.
+	 */
+	STL_SIZE_T STL_em_ctx_bootitme_failed(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_ERROR_T *err);
+
+	/**
+	 * @brief Updates the signature of a runtime test of a context.
+	 *
+	 * @param ctx The context.
+	 * @param index The index of the signature to update.
+	 * @param signature The new signature value.
+	 * @param cpu The CPU identifier.
+	 * @param err Pointer to the error structure to update.
+	 */
+	void STL_em_ctx_update_sig(STL_CONTEXT_T *ctx, STL_SIZE_T index, STL_SIGNATURE_T signature, STL_CPUS cpu,
+							   STL_ERROR_T *err);
+
+	/**
+	 * @brief Records a timeout verdict for a runtime test of a context.
+	 *
+	 * @param ctx The context.
+	 * @param index The index of the aborted test.
+	 * @param cpu The CPU identifier.
+	 * @param err Pointer to the error structure to update.
 	 */
+	void STL_em_ctx_update_timeout(STL_CONTEXT_T *ctx, STL_SIZE_T index, STL_CPUS cpu, STL_ERROR_T *err);
+
+	/**
+	 * @brief Updates the signature of a boot-time test of a context.
+	 *
+	 * @param ctx The context.
+	 * @param index The index of the boot-time test.
+	 * @param signature The new signature value.
+	 * @param cpu The CPU identifier.
+	 * @param err Pointer to the error structure to update.
+	 */
+	void STL_em_ctx_update_bt_sig(STL_CONTEXT_T *ctx, STL_SIZE_T index, STL_SIGNATURE_T signature, STL_CPUS cpu,
+								  STL_ERROR_T *err);
+
+#if (STL_USE_PMU > 0u)
+	/**
+	 * @brief Accumulates the performance counters sampled around a runtime test of a context.
+	 *
+	 * @param ctx The context.
+	 * @param index The index of the runtime test.
+	 * @param before Counters sampled before the test.
+	 * @param after Counters sampled after the test.
+	 * @param cpu The CPU identifier.
+	 * @param err Pointer to the error structure to update.
+	 */
+	void STL_em_ctx_update_pmu(STL_CONTEXT_T *ctx, STL_SIZE_T index, const STL_PMU_SAMPLE_T *before,
+							   const STL_PMU_SAMPLE_T *after, STL_CPUS cpu, STL_ERROR_T *err);
+#endif /*STL_USE_PMU*/
 
 	/**
 	 * @brief Initializes the error management system.
@@ -49,6 +128,23 @@ extern "C"
 	 * @param err Pointer to the error structure to initialize.
 	 */
 	void STL_em_deinit(STL_ERROR_T *err);
+
+	/**
+	 * @brief Starts a new diagnostic cycle on a CPU: its results read as not run (constant time).
+	 *
+	 * @param cpu The CPU identifier.
+	 * @param err Pointer to the error structure to update.
+	 */
+	void STL_em_reset(STL_CPUS cpu, STL_ERROR_T *err);
+
+	/**
+	 * @brief Retrieves the last failed test of a CPU.
+	 *
+	 * @param cpu The CPU identifier.
+	 * @param vect Pointer to the structure where the failed test is stored.
+	 * @param err Pointer to the error structure to update.
+	 */
+	void STL_em_get_last_failed(STL_CPUS cpu, STL_FAILED_TEST_T *vect, STL_ERROR_T *err);
 	/**
 	 * @brief Handles a runtime failure for a specific CPU.
 	 *
@@ -60,6 +156,7 @@ extern "C"
 
 	/**
 	 * @brief Handles all runtime failures for a specific CPU.
+	 * The failed test j is written at vect[j]; see STL_em_rt_get_failed for a compacted list.
 	 *
 	 * @param cpu The CPU identifier.
 	 * @param vect Pointer to the vector of failed tests.
@@ -69,6 +166,7 @@ extern "C"
 
 	/**
 	 * @brief Handles all boot-time failures for a specific CPU.
+	 * The failed test j is written at vect[j]; see STL_em_bt_get_failed for a compacted list.
 	 *
 	 * @param cpu The CPU identifier.
 	 * @param vect Pointer to the vector of failed tests.
@@ -106,10 +204,161 @@ extern "C"
 	 * @return None
 	 */
 	void STL_em_update_sig(STL_SIZE_T index, STL_SIGNATURE_T signature, STL_CPUS cpu, STL_ERROR_T *err);
-    
+
+	/**
+	 * @brief Records a timeout verdict for a specific index and CPU.
+	 * It is used when the test has been aborted by the watchdog.
+	 *
+	 * @param index The index of the aborted test.
+	 * @param cpu The CPU identifier.
+	 * @param err Pointer to the error structure to update.
+	 * @return None
+	 */
+	void STL_em_update_timeout(STL_SIZE_T index, STL_CPUS cpu, STL_ERROR_T *err);
+
+	/**
+	 * @brief Retrieves the runtime verdict for a specific CPU and index.
+	 *
+	 * @param cpu The CPU identifier.
+	 * @param index The index of the verdict to retrieve.
+	 * @param err Pointer to the error structure to update.
+	 * @return The runtime verdict.
+	 */
+	STL_VERDICT_T STL_em_rt_get_verdict(STL_CPUS cpu, STL_SIZE_T index, STL_ERROR_T *err);
+
+	/**
+	 * @brief Updates the signature of a boot-time test for a specific index and CPU.
+	 *
+	 * @param index The index of the boot-time test.
+	 * @param signature The new signature value.
+	 * @param cpu The CPU identifier.
+	 * @param err Pointer to the error structure to update.
+	 * @return None
+	 */
+	void STL_em_update_bt_sig(STL_SIZE_T index, STL_SIGNATURE_T signature, STL_CPUS cpu, STL_ERROR_T *err);
+
+	/**
+	 * @brief Copies the signatures, verdicts and timestamps of a range of runtime tests of a CPU.
+	 * Outputs that are not needed can be STL_NULL; the range is clipped to the last test.
+	 *
+	 * @param cpu The CPU identifier.
+	 * @param first Index of the first test.
+	 * @param count Number of tests (capacity of the outputs).
+	 * @param sig Signatures, or STL_NULL.
+	 * @param verdict Verdicts, or STL_NULL.
+	 * @param updated Cycle counter of the verdicts, or STL_NULL.
+	 * @param err Pointer to the error structure to update.
+	 * @return The number of tests copied.
+	 */
+	STL_SIZE_T STL_em_rt_get_range(STL_CPUS cpu, STL_SIZE_T first, STL_SIZE_T count, STL_SIGNATURE_T *sig,
+								   STL_VERDICT_T *verdict, STL_CYCLES_T *updated, STL_ERROR_T *err);
+
+	/**
+	 * @brief Retrieves the verdict of a cooperative runtime test run by a range of CPUs: pass when
+	 * all the CPUs passed with the same signature, fail when one failed or the signatures differ.
+	 *
+	 * @param index The index of the runtime test.
+	 * @param first The first CPU running the test.
+	 * @param count The number of CPUs running the test.
+	 * @param sig The common signature, or STL_NULL.
+	 * @param err Pointer to the error structure to update.
+	 * @return The verdict of the test on the range of CPUs.
+	 */
+	STL_VERDICT_T STL_em_rt_get_combined(STL_SIZE_T index, STL_CPUS first, STL_CPUS count, STL_SIGNATURE_T *sig,
+										 STL_ERROR_T *err);
+
+	/**
+	 * @brief Copies the signatures, verdicts and timestamps of a range of boot-time tests of a CPU.
+	 *
+	 * @param cpu The CPU identifier.
+	 * @param first Index of the first test.
+	 * @param count Number of tests (capacity of the outputs).
+	 * @param sig Signatures, or STL_NULL.
+	 * @param verdict Verdicts, or STL_NULL.
+	 * @param updated Cycle counter of the verdicts, or STL_NULL.
+	 * @param err Pointer to the error structure to update.
+	 * @return The number of tests copied.
+	 */
+	STL_SIZE_T STL_em_bt_get_range(STL_CPUS cpu, STL_SIZE_T first, STL_SIZE_T count, STL_SIGNATURE_T *sig,
+								   STL_VERDICT_T *verdict, STL_CYCLES_T *updated, STL_ERROR_T *err);
+
+	/**
+	 * @brief Copies the signatures, verdicts and timestamps of the runtime tests of all the CPUs.
+	 * Element cpu * STL_TOT_RT_ROUTINE + index of each output describes test index of CPU cpu.
+	 *
+	 * @param sig Signatures, or STL_NULL.
+	 * @param verdict Verdicts, or STL_NULL.
+	 * @param updated Cycle counter of the verdicts, or STL_NULL.
+	 * @param err Pointer to the error structure to update.
+	 * @return The number of elements written in each output.
+	 */
+	STL_INT32U_T STL_em_rt_get_all(STL_SIGNATURE_T *sig, STL_VERDICT_T *verdict, STL_CYCLES_T *updated,
+								   STL_ERROR_T *err);
+
+	/**
+	 * @brief Copies the signatures, verdicts and timestamps of the boot-time tests of all the CPUs.
+	 * Element cpu * STL_TOT_BT_ROUTINE + index of each output describes test index of CPU cpu.
+	 *
+	 * @param sig Signatures, or STL_NULL.
+	 * @param verdict Verdicts, or STL_NULL.
+	 * @param updated Cycle counter of the verdicts, or STL_NULL.
+	 * @param err Pointer to the error structure to update.
+	 * @return The number of elements written in each output.
+	 */
+	STL_INT32U_T STL_em_bt_get_all(STL_SIGNATURE_T *sig, STL_VERDICT_T *verdict, STL_CYCLES_T *updated,
+								   STL_ERROR_T *err);
+
+	/**
+	 * @brief Lists the failed runtime tests of a CPU from vect[0] (compacted list).
+	 *
+	 * @param cpu The CPU identifier.
+	 * @param vect List of the failed tests.
+	 * @param max Capacity of the list.
+	 * @param err Pointer to the error structure to update.
+	 * @return The number of failed tests (only the first max are listed).
+	 */
+	STL_SIZE_T STL_em_rt_get_failed(STL_CPUS cpu, STL_FAILED_TEST_T *vect, STL_SIZE_T max, STL_ERROR_T *err);
+
+	/**
+	 * @brief Lists the failed boot-time tests of a CPU from vect[0] (compacted list).
+	 *
+	 * @param cpu The CPU identifier.
+	 * @param vect List of the failed tests.
+	 * @param max Capacity of the list.
+	 * @param err Pointer to the error structure to update.
+	 * @return The number of failed tests (only the first max are listed).
+	 */
+	STL_SIZE_T STL_em_bt_get_failed(STL_CPUS cpu, STL_FAILED_TEST_T *vect, STL_SIZE_T max, STL_ERROR_T *err);
+
+#if (STL_USE_PMU > 0u)
+	/**
+	 * @brief Accumulates the performance counters sampled around a runtime test.
+	 *
+	 * @param index The index of the runtime test.
+	 * @param before Counters sampled before the test.
+	 * @param after Counters sampled after the test.
+	 * @param cpu The CPU identifier.
+	 * @param err Pointer to the error structure to update.
+	 * @return None
+	 */
+	void STL_em_update_pmu(STL_SIZE_T index, const STL_PMU_SAMPLE_T *before, const STL_PMU_SAMPLE_T *after,
+						   STL_CPUS cpu, STL_ERROR_T *err);
+
+	/**
+	 * @brief Retrieves the performance counters aggregated for a runtime test.
+	 *
+	 * @param cpu The CPU identifier.
+	 * @param index The index of the runtime test.
+	 * @param stats Pointer to the aggregate to fill.
+	 * @param err Pointer to the error structure to update.
+	 * @return None
+	 */
+	void STL_em_rt_get_pmu(STL_CPUS cpu, STL_SIZE_T index, STL_PMU_STATS_T *stats, STL_ERROR_T *err);
+#endif /*STL_USE_PMU*/
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
 #endif /* STL_ERROR_MANAGEMENT_ENABLED */
-#endif /* __STL_EM__MODULE__ */
+#endif /* __STL_ERROR_MANAGEMENT_H__ */
 #endif /* __STL__ */
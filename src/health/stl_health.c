@@ -0,0 +1,185 @@
+#if __STL__
+
+/**
+ * @file stl_health.c
+ * @brief Implementation of the STL health export.
+ *
+ * The entries of a CPU are only written by that CPU, under the sequence counter of the entry:
+ * the counter is made odd, a release fence orders it before the data, and the even value is
+ * published with a release store after the data. The counters of the header that all the CPUs
+ * update (failed, generation) are changed with atomic read-modify-writes, after the entry.
+ *
+ * The runs and failures of a test are kept in the region itself: the export is the only copy
+ * of these counters.
+ *
+ * @see stl_health.h, stl_health_layout.h
+ */
+
+#ifndef __STL_HEALTH_MODULE__
+#define __STL_HEALTH_MODULE__
+
+#include "stl_health.h"
+#include "stl_cfg.h"
+#include "stl_sbst_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+#if (STL_USE_HEALTH_EXPORT > 0u)
+
+#if (STL_MULTICORE_SOC > 0u)
+#include "stl_al_cpu.h"
+#define STL_HEALTH_CPUS STL_NUM_CPU
+#else
+#define STL_HEALTH_CPUS 1u
+#endif /*STL_MULTICORE_SOC*/
+
+/**
+ * @brief Size of the block of one CPU, rounded up to a cache line.
+ */
+#define STL_HEALTH_CPU_STRIDE                                                                                          \
+	((((STL_INT32U_T)sizeof(STL_HEALTH_TEST_T) * STL_TOT_RT_ROUTINE) + STL_HEALTH_LINE_SIZE - 1u) &                    \
+	 ~(STL_HEALTH_LINE_SIZE - 1u))
+
+/**
+ * @brief Size of the region.
+ */
+#define STL_HEALTH_SIZE ((STL_INT32U_T)sizeof(STL_HEALTH_HEADER_T) + (STL_HEALTH_CPUS * STL_HEALTH_CPU_STRIDE))
+
+typedef char STL_HEALTH_HEADER_SIZE_CHECK[(sizeof(STL_HEALTH_HEADER_T) == STL_HEALTH_LINE_SIZE) ? 1 : -1];
+typedef char STL_HEALTH_TEST_SIZE_CHECK[(sizeof(STL_HEALTH_TEST_T) == 32u) ? 1 : -1];
+typedef char STL_HEALTH_VERDICT_CHECK[(STL_HEALTH_VERDICT_NOT_RUN == STL_VERDICT_NOT_RUN &&
+										STL_HEALTH_VERDICT_PASS == STL_VERDICT_PASS &&
+										STL_HEALTH_VERDICT_FAIL == STL_VERDICT_FAIL &&
+										STL_HEALTH_VERDICT_TIMEOUT == STL_VERDICT_TIMEOUT)
+										   ? 1
+										   : -1];
+
+/**
+ * @var health_region
+ * @brief Mapped region, STL_NULL when the export is not active.
+ */
+STATIC_KEYWORD STL_HEALTH_HEADER_T *health_region = STL_NULL;
+
+/**
+ * @brief Returns the entry of a runtime test in the region.
+ *
+ * @param cpu CPU of the test
+ * @param index Index of the runtime test
+ * @return Entry of the test
+ */
+STATIC_KEYWORD INLINE_KEYWORD STL_HEALTH_TEST_T *STL_health_entry(STL_CPUS cpu, STL_SIZE_T index)
+{
+	uint8_t *block = (uint8_t *)health_region + sizeof(STL_HEALTH_HEADER_T);
+
+	block += (STL_INT32U_T)cpu * STL_HEALTH_CPU_STRIDE;
+	return &((STL_HEALTH_TEST_T *)block)[index];
+}
+
+/**
+ * @brief Maps the export region and publishes an empty state (no test run).
+ * The magic is written last, so that a reader that sees it also sees the rest of the header.
+ *
+ * @param err Error code, STL_ERROR_HEALTH if the region cannot be mapped
+ * @return None
+ */
+void STL_health_init(STL_ERROR_T *err)
+{
+	STL_HEALTH_HEADER_T *region;
+	uint8_t *bytes;
+	STL_INT32U_T i;
+
+	region = (STL_HEALTH_HEADER_T *)STL_TSSP_OS_shm_map(STL_HEALTH_SIZE, err);
+	if (region == STL_NULL)
+	{
+		*err = STL_ERROR_HEALTH;
+		return;
+	}
+
+	region->magic = 0u;
+	STL_ATOMIC_FENCE_RELEASE();
+	bytes = (uint8_t *)region;
+	for (i = (STL_INT32U_T)sizeof(region->magic); i < STL_HEALTH_SIZE; i++)
+	{
+		bytes[i] = 0u;
+	}
+	region->version_major = STL_HEALTH_VERSION_MAJOR;
+	region->version_minor = STL_HEALTH_VERSION_MINOR;
+	region->size = STL_HEALTH_SIZE;
+	region->header_size = (STL_INT32U_T)sizeof(STL_HEALTH_HEADER_T);
+	region->test_size = (STL_INT32U_T)sizeof(STL_HEALTH_TEST_T);
+	region->cpu_stride = STL_HEALTH_CPU_STRIDE;
+	region->cpus = STL_HEALTH_CPUS;
+	region->rt_tests = STL_TOT_RT_ROUTINE;
+	region->state = STL_HEALTH_STATE_RUNNING;
+	STL_ATOMIC_STORE_RELEASE(&region->magic, STL_HEALTH_MAGIC);
+
+	health_region = region;
+	*err = STL_ERROR_NONE;
+}
+
+/**
+ * @brief Publishes the verdict of a runtime test.
+ *
+ * @param cpu CPU of the test
+ * @param index Index of the runtime test
+ * @param verdict Verdict of the execution
+ * @param signature Signature of the execution
+ * @return None
+ */
+void STL_health_publish(STL_CPUS cpu, STL_SIZE_T index, STL_VERDICT_T verdict, STL_SIGNATURE_T signature)
+{
+	STL_HEALTH_TEST_T *entry;
+	STL_INT32U_T seq;
+	STL_BOOL was_failed;
+	STL_BOOL is_failed;
+
+	if (health_region == STL_NULL || cpu >= STL_HEALTH_CPUS || index >= STL_TOT_RT_ROUTINE)
+	{
+		return;
+	}
+	entry = STL_health_entry(cpu, index);
+	was_failed = (entry->verdict == STL_VERDICT_FAIL || entry->verdict == STL_VERDICT_TIMEOUT) ? STL_TRUE : STL_FALSE;
+	is_failed = (verdict == STL_VERDICT_FAIL || verdict == STL_VERDICT_TIMEOUT) ? STL_TRUE : STL_FALSE;
+
+	seq = entry->seq;
+	entry->seq = seq + 1u;
+	STL_ATOMIC_FENCE_RELEASE();
+	entry->verdict = (uint32_t)verdict;
+	entry->signature = (uint32_t)signature;
+	entry->runs = entry->runs + 1u;
+	if (is_failed == STL_TRUE)
+	{
+		entry->failures = entry->failures + 1u;
+	}
+	entry->updated = STL_TSSP_CPU_get_cycles();
+	STL_ATOMIC_STORE_RELEASE(&entry->seq, seq + 2u);
+
+	if (is_failed != was_failed)
+	{
+		(void)STL_ATOMIC_FETCH_ADD(&health_region->failed, (is_failed == STL_TRUE) ? 1u : (uint32_t)-1);
+	}
+	STL_ATOMIC_FENCE_RELEASE();
+	(void)STL_ATOMIC_FETCH_ADD(&health_region->generation, 1u);
+}
+
+/**
+ * @brief Marks the published verdicts as final and unmaps the region.
+ *
+ * @param err Error code
+ * @return None
+ */
+void STL_health_deinit(STL_ERROR_T *err)
+{
+	*err = STL_ERROR_NONE;
+	if (health_region == STL_NULL)
+	{
+		return;
+	}
+	STL_ATOMIC_STORE_RELEASE(&health_region->state, STL_HEALTH_STATE_STOPPED);
+	STL_TSSP_OS_shm_unmap(health_region, STL_HEALTH_SIZE);
+	health_region = STL_NULL;
+}
+
+#endif /*STL_USE_HEALTH_EXPORT*/
+#endif /*__STL_HEALTH_MODULE__*/
+#endif /*__STL__*/
@@ -0,0 +1,68 @@
+/**
+ * @file stl_health.h
+ * @brief Header file for the STL health export.
+ *
+ * With STL_USE_HEALTH_EXPORT the error management publishes the verdict of every runtime
+ * test in a region shared with an external supervisor, laid out as described in
+ * stl_health_layout.h. The region is provided by the OS services of the TSSP
+ * (STL_TSSP_OS_shm_map): a POSIX shared-memory object named STL_HEALTH_SHM_NAME on Linux.
+ * The supervisor maps it read-only and reads the verdicts at memory speed, without system
+ * calls or copies by the STL (see stl_health_reader.h).
+ *
+ * @details
+ * - STL_health_init: Maps the region and publishes an empty state (called by STL_em_init).
+ * - STL_health_publish: Publishes the verdict of a runtime test (called by the error management).
+ * - STL_health_deinit: Marks the verdicts as final and unmaps the region (called by STL_em_deinit).
+ */
+#if __STL__
+#ifndef __STL_HEALTH_H__
+#define __STL_HEALTH_H__
+
+#include "stl_cfg.h"
+#include "stl_types.h"
+
+#if (STL_USE_HEALTH_EXPORT > 0u)
+
+#include "stl_health_layout.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /*__cplusplus*/
+
+	/**
+	 * @brief Maps the export region and publishes an empty state (no test run).
+	 *
+	 * @param err Error code, STL_ERROR_HEALTH if the region cannot be mapped
+	 * @return None
+	 */
+	void STL_health_init(STL_ERROR_T *err);
+
+	/**
+	 * @brief Publishes the verdict of a runtime test.
+	 * It must only be called from the context that runs the tests of the CPU. It does nothing
+	 * when the region is not mapped.
+	 *
+	 * @param cpu CPU of the test
+	 * @param index Index of the runtime test
+	 * @param verdict Verdict of the execution
+	 * @param signature Signature of the execution
+	 * @return None
+	 */
+	void STL_health_publish(STL_CPUS cpu, STL_SIZE_T index, STL_VERDICT_T verdict, STL_SIGNATURE_T signature);
+
+	/**
+	 * @brief Marks the published verdicts as final and unmaps the region.
+	 *
+	 * @param err Error code
+	 * @return None
+	 */
+	void STL_health_deinit(STL_ERROR_T *err);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /*STL_USE_HEALTH_EXPORT*/
+#endif /*__STL_HEALTH_H__*/
+#endif /*__STL__*/
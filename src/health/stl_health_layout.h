@@ -0,0 +1,132 @@
+/**
+ * @file stl_health_layout.h
+ * @brief Layout of the STL health export region.
+ *
+ * The error management publishes the verdict of every runtime test in a region shared with
+ * an external supervisor (a POSIX shared-memory object on Linux, a RAM buffer otherwise).
+ * The region starts with a STL_HEALTH_HEADER_T followed, for each CPU, by one
+ * STL_HEALTH_TEST_T per runtime test:
+ *
+ *     test (cpu, index) at offset header_size + cpu * cpu_stride + index * test_size
+ *
+ * The block of each CPU starts on a cache line, so that the CPUs never write the same line.
+ *
+ * Each test entry is protected by a sequence counter written by a single CPU: the counter is
+ * odd while the entry is being updated, and a reader retries when it reads an odd value or
+ * when the counter changed during its copy. The reader never writes to the region.
+ *
+ * Versioning: the major version changes when the layout is not compatible anymore; the minor
+ * version when fields are added in reserved space. Readers check the magic and the major
+ * version and use header_size, test_size and cpu_stride instead of the sizes they were built
+ * with.
+ *
+ * This header is shared by the STL and the supervisor: it only depends on <stdint.h>.
+ */
+#ifndef __STL_HEALTH_LAYOUT_H__
+#define __STL_HEALTH_LAYOUT_H__
+
+#include <stdint.h>
+
+#define STL_HEALTH_MAGIC 0x484C5453u /* "STLH" */
+#define STL_HEALTH_VERSION_MAJOR 1u	 /* Incompatible layout changes */
+#define STL_HEALTH_VERSION_MINOR 0u	 /* Compatible additions */
+
+#define STL_HEALTH_LINE_SIZE 64u /* Alignment of the header and of the block of each CPU */
+
+/**
+ * @brief State of the publisher (STL_HEALTH_HEADER_T::state).
+ */
+#define STL_HEALTH_STATE_INIT 0u	/* Region being initialized */
+#define STL_HEALTH_STATE_RUNNING 1u /* Verdicts are being published */
+#define STL_HEALTH_STATE_STOPPED 2u /* STL deinitialized: the verdicts are final */
+
+/**
+ * @brief Verdicts (STL_HEALTH_TEST_T::verdict), same values as STL_VERDICT_T.
+ */
+#define STL_HEALTH_VERDICT_NOT_RUN 0u
+#define STL_HEALTH_VERDICT_PASS 1u
+#define STL_HEALTH_VERDICT_FAIL 2u
+#define STL_HEALTH_VERDICT_TIMEOUT 3u
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /*__cplusplus*/
+
+	/**
+	 * @brief Header of the region (64 bytes).
+	 *
+	 * @var STL_HEALTH_HEADER_T::magic
+	 * STL_HEALTH_MAGIC, written last by the initialization.
+	 * @var STL_HEALTH_HEADER_T::version_major
+	 * STL_HEALTH_VERSION_MAJOR of the publisher.
+	 * @var STL_HEALTH_HEADER_T::version_minor
+	 * STL_HEALTH_VERSION_MINOR of the publisher.
+	 * @var STL_HEALTH_HEADER_T::size
+	 * Size of the region in bytes.
+	 * @var STL_HEALTH_HEADER_T::header_size
+	 * Offset of the block of CPU 0.
+	 * @var STL_HEALTH_HEADER_T::test_size
+	 * Size of a test entry.
+	 * @var STL_HEALTH_HEADER_T::cpu_stride
+	 * Distance between the blocks of two consecutive CPUs.
+	 * @var STL_HEALTH_HEADER_T::cpus
+	 * Number of CPUs.
+	 * @var STL_HEALTH_HEADER_T::rt_tests
+	 * Number of runtime tests of each CPU.
+	 * @var STL_HEALTH_HEADER_T::state
+	 * STL_HEALTH_STATE_*.
+	 * @var STL_HEALTH_HEADER_T::failed
+	 * Number of tests whose last verdict is fail or timeout.
+	 * @var STL_HEALTH_HEADER_T::generation
+	 * Number of verdicts published since the initialization (changes on every update).
+	 */
+	typedef struct
+	{
+		uint32_t magic;
+		uint16_t version_major;
+		uint16_t version_minor;
+		uint32_t size;
+		uint32_t header_size;
+		uint32_t test_size;
+		uint32_t cpu_stride;
+		uint32_t cpus;
+		uint32_t rt_tests;
+		volatile uint32_t state;
+		volatile uint32_t failed;
+		volatile uint64_t generation;
+		uint32_t reserved[4];
+	} STL_HEALTH_HEADER_T;
+
+	/**
+	 * @brief State of a runtime test (32 bytes).
+	 *
+	 * @var STL_HEALTH_TEST_T::seq
+	 * Sequence counter, odd while the entry is being written.
+	 * @var STL_HEALTH_TEST_T::verdict
+	 * Verdict of the last execution (STL_HEALTH_VERDICT_*).
+	 * @var STL_HEALTH_TEST_T::signature
+	 * Signature of the last execution.
+	 * @var STL_HEALTH_TEST_T::runs
+	 * Number of executions.
+	 * @var STL_HEALTH_TEST_T::failures
+	 * Number of executions that failed or timed out.
+	 * @var STL_HEALTH_TEST_T::updated
+	 * Cycle counter of the CPU when the verdict was published.
+	 */
+	typedef struct
+	{
+		volatile uint32_t seq;
+		volatile uint32_t verdict;
+		volatile uint32_t signature;
+		volatile uint32_t runs;
+		volatile uint32_t failures;
+		uint32_t reserved;
+		volatile uint64_t updated;
+	} STL_HEALTH_TEST_T;
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /*__STL_HEALTH_LAYOUT_H__*/
@@ -0,0 +1,163 @@
+/**
+ * @file stl_health_reader.c
+ * @brief Implementation of the reader of the STL health export (Linux).
+ *
+ * A snapshot follows the sequence counter protocol of the writer: load the counter with
+ * acquire semantics, retry if it is odd, copy the entry, then check with an acquire fence
+ * and a second load that the counter did not change.
+ *
+ * @see stl_health_reader.h, stl_health_layout.h
+ */
+
+#include "stl_health_reader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Maps the region published by the STL and checks its layout.
+ *
+ * @param reader Reader to initialize
+ * @param name Name of the shared-memory object
+ * @return STL_HEALTH_READER_OK, STL_HEALTH_READER_NOT_FOUND or STL_HEALTH_READER_LAYOUT
+ */
+STL_HEALTH_READER_RESULT_T STL_health_reader_open(STL_HEALTH_READER_T *reader, const char *name)
+{
+	const STL_HEALTH_HEADER_T *header;
+	struct stat st;
+	void *map;
+	int fd;
+
+	reader->header = NULL;
+	reader->size = 0u;
+
+	fd = shm_open(name, O_RDONLY, 0);
+	if (fd < 0)
+	{
+		return STL_HEALTH_READER_NOT_FOUND;
+	}
+	if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(STL_HEALTH_HEADER_T))
+	{
+		close(fd);
+		return STL_HEALTH_READER_LAYOUT;
+	}
+	map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+	{
+		return STL_HEALTH_READER_NOT_FOUND;
+	}
+
+	header = (const STL_HEALTH_HEADER_T *)map;
+	if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != STL_HEALTH_MAGIC ||
+		header->version_major != STL_HEALTH_VERSION_MAJOR || header->size > (size_t)st.st_size ||
+		header->test_size < sizeof(STL_HEALTH_TEST_T) ||
+		(uint64_t)header->header_size + (uint64_t)header->cpus * header->cpu_stride > header->size ||
+		(uint64_t)header->rt_tests * header->test_size > header->cpu_stride)
+	{
+		munmap(map, (size_t)st.st_size);
+		return STL_HEALTH_READER_LAYOUT;
+	}
+
+	reader->header = header;
+	reader->size = (size_t)st.st_size;
+	return STL_HEALTH_READER_OK;
+}
+
+/**
+ * @brief Takes a consistent snapshot of a test entry.
+ *
+ * @param reader Open reader
+ * @param cpu CPU of the test
+ * @param index Index of the runtime test
+ * @param test Snapshot
+ * @return STL_HEALTH_READER_OK, STL_HEALTH_READER_RANGE or STL_HEALTH_READER_BUSY
+ */
+STL_HEALTH_READER_RESULT_T STL_health_reader_test(const STL_HEALTH_READER_T *reader, uint32_t cpu, uint32_t index,
+												  STL_HEALTH_TEST_T *test)
+{
+	const STL_HEALTH_HEADER_T *header = reader->header;
+	const STL_HEALTH_TEST_T *entry;
+	uint32_t attempt;
+
+	if (cpu >= header->cpus || index >= header->rt_tests)
+	{
+		return STL_HEALTH_READER_RANGE;
+	}
+	entry = (const STL_HEALTH_TEST_T *)((const uint8_t *)header + header->header_size +
+										(size_t)cpu * header->cpu_stride + (size_t)index * header->test_size);
+
+	for (attempt = 0u; attempt < STL_HEALTH_READER_RETRIES; attempt++)
+	{
+		uint32_t seq = __atomic_load_n(&entry->seq, __ATOMIC_ACQUIRE);
+
+		if ((seq & 1u) != 0u)
+		{
+			continue;
+		}
+		test->verdict = entry->verdict;
+		test->signature = entry->signature;
+		test->runs = entry->runs;
+		test->failures = entry->failures;
+		test->updated = entry->updated;
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&entry->seq, __ATOMIC_RELAXED) == seq)
+		{
+			test->seq = seq;
+			test->reserved = 0u;
+			return STL_HEALTH_READER_OK;
+		}
+	}
+	return STL_HEALTH_READER_BUSY;
+}
+
+/**
+ * @brief Number of verdicts published so far.
+ *
+ * @param reader Open reader
+ * @return Generation counter
+ */
+uint64_t STL_health_reader_generation(const STL_HEALTH_READER_T *reader)
+{
+	return __atomic_load_n(&reader->header->generation, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Number of tests whose last verdict is fail or timeout.
+ *
+ * @param reader Open reader
+ * @return Failed tests
+ */
+uint32_t STL_health_reader_failed(const STL_HEALTH_READER_T *reader)
+{
+	return __atomic_load_n(&reader->header->failed, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief State of the publisher.
+ *
+ * @param reader Open reader
+ * @return STL_HEALTH_STATE_*
+ */
+uint32_t STL_health_reader_state(const STL_HEALTH_READER_T *reader)
+{
+	return __atomic_load_n(&reader->header->state, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Unmaps the region.
+ *
+ * @param reader Open reader
+ * @return None
+ */
+void STL_health_reader_close(STL_HEALTH_READER_T *reader)
+{
+	if (reader->header != NULL)
+	{
+		munmap((void *)reader->header, reader->size);
+	}
+	reader->header = NULL;
+	reader->size = 0u;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file stl_health_reader.h
+ * @brief Reader of the STL health export, for the supervisor process (Linux).
+ *
+ * The reader maps the region published by the STL read-only and takes consistent snapshots
+ * of the test entries without system calls: a snapshot is retried while the entry is being
+ * written, and gives up after STL_HEALTH_READER_RETRIES attempts (e.g. if the STL process
+ * died in the middle of an update).
+ *
+ * The reader does not depend on the STL configuration: it is built with stl_health_reader.c
+ * and stl_health_layout.h only, and discovers the number of CPUs and tests from the header.
+ *
+ *     STL_HEALTH_READER_T reader;
+ *     STL_HEALTH_TEST_T test;
+ *
+ *     if (STL_health_reader_open(&reader, "/stl_health") == STL_HEALTH_READER_OK)
+ *     {
+ *         uint64_t seen = STL_health_reader_generation(&reader);
+ *         ...
+ *         if (STL_health_reader_generation(&reader) != seen &&
+ *             STL_health_reader_test(&reader, 0, 3, &test) == STL_HEALTH_READER_OK &&
+ *             test.verdict != STL_HEALTH_VERDICT_PASS) { ... }
+ *         STL_health_reader_close(&reader);
+ *     }
+ */
+#ifndef __STL_HEALTH_READER_H__
+#define __STL_HEALTH_READER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "stl_health_layout.h"
+
+#ifndef STL_HEALTH_READER_RETRIES
+#define STL_HEALTH_READER_RETRIES 1000u /* Attempts of a snapshot before giving up */
+#endif									/*STL_HEALTH_READER_RETRIES*/
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /*__cplusplus*/
+
+	/**
+	 * @brief Result of the reader functions.
+	 */
+	typedef enum
+	{
+		STL_HEALTH_READER_OK = 0,	  // Success
+		STL_HEALTH_READER_NOT_FOUND,  // The region does not exist (STL not started)
+		STL_HEALTH_READER_LAYOUT,	  // Bad magic, incompatible version or truncated region
+		STL_HEALTH_READER_RANGE,	  // CPU or test index out of range
+		STL_HEALTH_READER_BUSY		  // The entry kept changing during the snapshot
+	} STL_HEALTH_READER_RESULT_T;
+
+	/**
+	 * @brief Mapped region.
+	 *
+	 * @var STL_HEALTH_READER_T::header
+	 * Header of the region (read-only mapping).
+	 * @var STL_HEALTH_READER_T::size
+	 * Size of the mapping.
+	 */
+	typedef struct
+	{
+		const STL_HEALTH_HEADER_T *header;
+		size_t size;
+	} STL_HEALTH_READER_T;
+
+	/**
+	 * @brief Maps the region published by the STL and checks its layout.
+	 *
+	 * @param reader Reader to initialize
+	 * @param name Name of the shared-memory object (STL_HEALTH_SHM_NAME of the STL)
+	 * @return STL_HEALTH_READER_OK, STL_HEALTH_READER_NOT_FOUND or STL_HEALTH_READER_LAYOUT
+	 */
+	STL_HEALTH_READER_RESULT_T STL_health_reader_open(STL_HEALTH_READER_T *reader, const char *name);
+
+	/**
+	 * @brief Takes a consistent snapshot of a test entry.
+	 *
+	 * @param reader Open reader
+	 * @param cpu CPU of the test
+	 * @param index Index of the runtime test
+	 * @param test Snapshot (seq holds the even sequence value of the snapshot)
+	 * @return STL_HEALTH_READER_OK, STL_HEALTH_READER_RANGE or STL_HEALTH_READER_BUSY
+	 */
+	STL_HEALTH_READER_RESULT_T STL_health_reader_test(const STL_HEALTH_READER_T *reader, uint32_t cpu, uint32_t index,
+													  STL_HEALTH_TEST_T *test);
+
+	/**
+	 * @brief Number of verdicts published so far; a change means that some entry changed.
+	 *
+	 * @param reader Open reader
+	 * @return Generation counter
+	 */
+	uint64_t STL_health_reader_generation(const STL_HEALTH_READER_T *reader);
+
+	/**
+	 * @brief Number of tests whose last verdict is fail or timeout.
+	 *
+	 * @param reader Open reader
+	 * @return Failed tests
+	 */
+	uint32_t STL_health_reader_failed(const STL_HEALTH_READER_T *reader);
+
+	/**
+	 * @brief State of the publisher.
+	 *
+	 * @param reader Open reader
+	 * @return STL_HEALTH_STATE_*
+	 */
+	uint32_t STL_health_reader_state(const STL_HEALTH_READER_T *reader);
+
+	/**
+	 * @brief Unmaps the region.
+	 *
+	 * @param reader Open reader
+	 * @return None
+	 */
+	void STL_health_reader_close(STL_HEALTH_READER_T *reader);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /*__STL_HEALTH_READER_H__*/
@@ -0,0 +1,518 @@
+#if __STL__
+
+/**
+ * @file stl_overlay.c
+ * @brief Implementation of the STL overlay manager.
+ *
+ * Each CPU owns a pool of equally sized RAM slots. Two maps link the runtime tests and the
+ * slots (test -> slot, slot -> test), and a use stamp per slot orders the slots from the least
+ * to the most recently used. A slot is either free, loaded, or being loaded by the DMA
+ * (single core only, one load in flight at a time).
+ *
+ * STL_overlay_get is called by the scheduler before the test is isolated: it completes the
+ * pending DMA load if the test is the one being prefetched, loads the test on a miss, and pins
+ * the slot of the test. STL_overlay_prefetch is called right after, with the next test of the
+ * schedule: its load then runs while the current test executes.
+ *
+ * @note With a cyclic schedule longer than the pool, LRU evicts every test once per round;
+ *       the prefetch is what turns these loads into hits.
+ *
+ * @see stl_overlay.h
+ * @see stl_cfg.h
+ */
+
+#ifndef __STL_OVERLAY_MODULE__
+#define __STL_OVERLAY_MODULE__
+
+#include "stl_overlay.h"
+#include "stl_sbst_cfg.h"
+#include "stl_crc.h"
+#include "stl_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+#if (STL_USE_OVERLAY > 0u)
+
+#if (STL_MULTICORE_SOC > 0u)
+#include "stl_al_cpu.h"
+#endif /*STL_MULTICORE_SOC*/
+
+#define STL_OVERLAY_NONE 0xFFFFu /* No slot / no test */
+
+/*
+ * The DMA is shared by the cores: the prefetch uses it in single-core configurations only, and
+ * only on request. For blocks of a few hundred bytes the CPU copy costs less than handing the
+ * copy to the DMA and waiting for its completion.
+ */
+#if (STL_USE_DMA > 0u && STL_OVERLAY_DMA_PREFETCH > 0u && STL_MULTICORE_SOC == 0u)
+#define STL_OVERLAY_USE_DMA 1u
+#else
+#define STL_OVERLAY_USE_DMA 0u
+#endif /*STL_USE_DMA*/
+
+/**
+ * @typedef STL_OVERLAY_STATE_T
+ * @brief Overlay manager of one CPU.
+ *
+ * @var STL_OVERLAY_STATE_T::overlays
+ * Overlay descriptors of the runtime tests (STL_NULL until initialized).
+ * @var STL_OVERLAY_STATE_T::pool
+ * Base of the slot pool.
+ * @var STL_OVERLAY_STATE_T::slot_size
+ * Size of a slot in bytes.
+ * @var STL_OVERLAY_STATE_T::num_slots
+ * Number of slots in the pool.
+ * @var STL_OVERLAY_STATE_T::owner
+ * Test loaded in each slot, STL_OVERLAY_NONE if free.
+ * @var STL_OVERLAY_STATE_T::last_use
+ * Use stamp of each slot (higher is more recent).
+ * @var STL_OVERLAY_STATE_T::slot_of
+ * Slot holding each test, STL_OVERLAY_NONE if not loaded.
+ * @var STL_OVERLAY_STATE_T::pinned
+ * Slot of the test being dispatched, never evicted by a prefetch.
+ * @var STL_OVERLAY_STATE_T::clock
+ * Source of the use stamps.
+ * @var STL_OVERLAY_STATE_T::desc
+ * DMA descriptor of the load in flight.
+ * @var STL_OVERLAY_STATE_T::pending
+ * Slot being loaded by the DMA, STL_OVERLAY_NONE if none.
+ * @var STL_OVERLAY_STATE_T::stats
+ * Hit/miss counters and load cycles.
+ */
+typedef struct
+{
+	const STL_OVERLAY_T *overlays;
+	uint8_t *pool;
+	STL_INT32U_T slot_size;
+	STL_SIZE_T num_slots;
+	STL_SIZE_T owner[STL_OVERLAY_MAX_SLOTS];
+	STL_INT32U_T last_use[STL_OVERLAY_MAX_SLOTS];
+	STL_SIZE_T slot_of[STL_TOT_RT_ROUTINE];
+	STL_SIZE_T pinned;
+	STL_INT32U_T clock;
+#if (STL_OVERLAY_USE_DMA > 0u)
+	STL_TSSP_DMA_DESC_T desc;
+	STL_SIZE_T pending;
+#endif /*STL_OVERLAY_USE_DMA*/
+	STL_OVERLAY_STATS_T stats;
+} STL_OVERLAY_STATE_T;
+
+#if (STL_MULTICORE_SOC > 0u)
+STATIC_KEYWORD STL_OVERLAY_STATE_T overlay_state[STL_NUM_CPU];
+#define STL_OVERLAY_STATE(cpu) (&overlay_state[(cpu)])
+#else
+STATIC_KEYWORD STL_OVERLAY_STATE_T overlay_state;
+#define STL_OVERLAY_STATE(cpu) ((void)(cpu), &overlay_state)
+#endif /*STL_MULTICORE_SOC*/
+
+/**
+ * @brief Returns the address of a slot.
+ */
+STATIC_KEYWORD INLINE_KEYWORD uint8_t *STL_overlay_slot(const STL_OVERLAY_STATE_T *ovl, STL_SIZE_T slot)
+{
+	return ovl->pool + (uintptr_t)slot * ovl->slot_size;
+}
+
+/**
+ * @brief Releases a slot (the test it holds is no longer loaded).
+ */
+STATIC_KEYWORD void STL_overlay_release(STL_OVERLAY_STATE_T *ovl, STL_SIZE_T slot)
+{
+	if (ovl->owner[slot] != STL_OVERLAY_NONE)
+	{
+		ovl->slot_of[ovl->owner[slot]] = STL_OVERLAY_NONE;
+		ovl->owner[slot] = STL_OVERLAY_NONE;
+	}
+	ovl->last_use[slot] = 0u;
+}
+
+/**
+ * @brief Assigns a slot to a test: a free slot if any, otherwise the least recently used one.
+ * @param ovl Overlay manager.
+ * @param index Test to load.
+ * @param keep Slot that must not be evicted (STL_OVERLAY_NONE for none).
+ * @return The slot assigned, STL_OVERLAY_NONE if every slot is in use.
+ */
+STATIC_KEYWORD STL_SIZE_T STL_overlay_assign(STL_OVERLAY_STATE_T *ovl, STL_SIZE_T index, STL_SIZE_T keep)
+{
+	STL_SIZE_T slot;
+	STL_SIZE_T victim = STL_OVERLAY_NONE;
+
+	for (slot = 0u; slot < ovl->num_slots; slot++)
+	{
+		if (slot == keep)
+		{
+			continue;
+		}
+#if (STL_OVERLAY_USE_DMA > 0u)
+		if (slot == ovl->pending)
+		{
+			continue;
+		}
+#endif /*STL_OVERLAY_USE_DMA*/
+		if (ovl->owner[slot] == STL_OVERLAY_NONE)
+		{
+			victim = slot;
+			break;
+		}
+		if (victim == STL_OVERLAY_NONE || ovl->last_use[slot] < ovl->last_use[victim])
+		{
+			victim = slot;
+		}
+	}
+
+	if (victim != STL_OVERLAY_NONE)
+	{
+		if (ovl->owner[victim] != STL_OVERLAY_NONE)
+		{
+			ovl->stats.evictions++;
+		}
+		STL_overlay_release(ovl, victim);
+		ovl->owner[victim] = index;
+		ovl->slot_of[index] = victim;
+	}
+	return victim;
+}
+
+/**
+ * @brief Loads a test into its slot with the CPU and verifies it.
+ * The TSSP relocation service computes the CRC during the copy and synchronizes the
+ * instruction stream.
+ */
+STATIC_KEYWORD void STL_overlay_load(STL_OVERLAY_STATE_T *ovl, STL_SIZE_T slot, STL_ERROR_T *err)
+{
+	const STL_OVERLAY_T *overlay = &ovl->overlays[ovl->owner[slot]];
+	STL_INT32U_T crc;
+
+	crc = STL_TSSP_CPU_relocate(overlay->src, STL_overlay_slot(ovl, slot), overlay->size, err);
+	if (*err != STL_ERROR_NONE)
+	{
+		STL_overlay_release(ovl, slot);
+		return;
+	}
+#if (STL_RELOCATION_VERIFY > 0u)
+	if (crc != overlay->crc)
+	{
+		STL_overlay_release(ovl, slot);
+		*err = STL_ERROR_RELOCATION_CRC;
+	}
+#else
+	(void)crc;
+#endif /*STL_RELOCATION_VERIFY*/
+}
+
+#if (STL_OVERLAY_USE_DMA > 0u)
+/**
+ * @brief Completes the DMA load in flight: waits for it, verifies the block and synchronizes
+ * the instruction stream.
+ */
+STATIC_KEYWORD void STL_overlay_complete(STL_OVERLAY_STATE_T *ovl, STL_ERROR_T *err)
+{
+	STL_SIZE_T slot = ovl->pending;
+	STL_CYCLES_T done_at;
+
+	while (STL_TSSP_CSP_dma_poll(&done_at, err) == STL_FALSE)
+	{
+		if (*err != STL_ERROR_NONE)
+		{
+			break;
+		}
+	}
+	ovl->pending = STL_OVERLAY_NONE;
+	if (*err != STL_ERROR_NONE)
+	{
+		STL_overlay_release(ovl, slot);
+		return;
+	}
+
+#if (STL_RELOCATION_VERIFY > 0u)
+	if (STL_CRC32C_FINAL(STL_crc32c_update(STL_CRC32C_INIT, ovl->desc.dst, ovl->desc.size)) !=
+		ovl->overlays[ovl->owner[slot]].crc)
+	{
+		STL_overlay_release(ovl, slot);
+		*err = STL_ERROR_RELOCATION_CRC;
+		return;
+	}
+#endif /*STL_RELOCATION_VERIFY*/
+	STL_TSSP_CPU_sync_icache(ovl->desc.dst, ovl->desc.size);
+}
+#endif /*STL_OVERLAY_USE_DMA*/
+
+/**
+ * @brief Waits for the DMA load in flight, if any: the DMA must not write into a pool that is
+ * reconfigured or given back. The block is dropped if it does not verify.
+ */
+STATIC_KEYWORD void STL_overlay_drain(STL_OVERLAY_STATE_T *ovl)
+{
+#if (STL_OVERLAY_USE_DMA > 0u)
+	STL_ERROR_T err;
+
+	if (ovl->overlays != STL_NULL && ovl->pending != STL_OVERLAY_NONE)
+	{
+		STL_overlay_complete(ovl, &err);
+	}
+#else
+	(void)ovl;
+#endif /*STL_OVERLAY_USE_DMA*/
+}
+
+/**
+ * @brief Accounts the cycles added to a dispatch by the overlay manager.
+ */
+STATIC_KEYWORD INLINE_KEYWORD void STL_overlay_account(STL_OVERLAY_STATE_T *ovl, STL_CYCLES_T start)
+{
+	STL_CYCLES_T cycles = STL_TSSP_CPU_get_cycles() - start;
+
+	ovl->stats.load_cycles += cycles;
+	if (cycles > ovl->stats.max_load_cycles)
+	{
+		ovl->stats.max_load_cycles = cycles;
+	}
+}
+
+/**
+ * @brief Initializes the overlay manager of a CPU.
+ *
+ * @param cpu CPU number (not used in single core)
+ * @param overlays Overlay descriptors, one per runtime test
+ * @param pool RAM area holding the slots
+ * @param pool_size Size of the pool in bytes
+ * @param slot_size Size of a slot in bytes
+ * @param err Error code
+ * @return None
+ */
+void STL_overlay_init(STL_CPUS cpu, const STL_OVERLAY_T *overlays, void *pool, STL_INT32U_T pool_size,
+					  STL_INT32U_T slot_size, STL_ERROR_T *err)
+{
+	STL_OVERLAY_STATE_T *ovl;
+	STL_SIZE_T i;
+
+#if (STL_MULTICORE_SOC > 0u)
+	if (cpu >= STL_NUM_CPU)
+	{
+		*err = STL_CPU_OUT_OF_BOUNDS;
+		return;
+	}
+#endif /*STL_MULTICORE_SOC*/
+	ovl = STL_OVERLAY_STATE(cpu);
+
+	if (overlays == STL_NULL || pool == STL_NULL || slot_size == 0u || (slot_size & 3u) != 0u ||
+		((uintptr_t)pool & 3u) != 0u || pool_size < slot_size)
+	{
+		*err = STL_ERROR_RELOCATION;
+		return;
+	}
+	STL_overlay_drain(ovl);
+
+	ovl->overlays = overlays;
+	ovl->pool = (uint8_t *)pool;
+	ovl->slot_size = slot_size;
+	ovl->num_slots = (STL_SIZE_T)(pool_size / slot_size);
+	if (ovl->num_slots > STL_OVERLAY_MAX_SLOTS)
+	{
+		ovl->num_slots = STL_OVERLAY_MAX_SLOTS;
+	}
+	for (i = 0u; i < STL_OVERLAY_MAX_SLOTS; i++)
+	{
+		ovl->owner[i] = STL_OVERLAY_NONE;
+		ovl->last_use[i] = 0u;
+	}
+	for (i = 0u; i < STL_TOT_RT_ROUTINE; i++)
+	{
+		ovl->slot_of[i] = STL_OVERLAY_NONE;
+	}
+	ovl->pinned = STL_OVERLAY_NONE;
+	ovl->clock = 0u;
+#if (STL_OVERLAY_USE_DMA > 0u)
+	ovl->pending = STL_OVERLAY_NONE;
+#endif /*STL_OVERLAY_USE_DMA*/
+	ovl->stats.hits = 0u;
+	ovl->stats.misses = 0u;
+	ovl->stats.prefetches = 0u;
+	ovl->stats.evictions = 0u;
+	ovl->stats.load_cycles = 0u;
+	ovl->stats.max_load_cycles = 0u;
+	*err = STL_ERROR_NONE;
+}
+
+/**
+ * @brief Stops the overlay manager of a CPU.
+ *
+ * @param cpu CPU number (not used in single core)
+ * @param err Error code
+ * @return None
+ */
+void STL_overlay_deinit(STL_CPUS cpu, STL_ERROR_T *err)
+{
+	STL_OVERLAY_STATE_T *ovl;
+
+#if (STL_MULTICORE_SOC > 0u)
+	if (cpu >= STL_NUM_CPU)
+	{
+		*err = STL_CPU_OUT_OF_BOUNDS;
+		return;
+	}
+#endif /*STL_MULTICORE_SOC*/
+	ovl = STL_OVERLAY_STATE(cpu);
+
+	STL_overlay_drain(ovl);
+	ovl->overlays = STL_NULL;
+	ovl->pool = STL_NULL;
+	ovl->num_slots = 0u;
+	ovl->pinned = STL_OVERLAY_NONE;
+	*err = STL_ERROR_NONE;
+}
+
+/**
+ * @brief Returns the entry point of a runtime test, loading its code block if needed.
+ *
+ * @param cpu CPU number (not used in single core)
+ * @param index Index of the runtime test
+ * @param err Error code
+ * @return The entry point in RAM, STL_NULL if the test runs in place
+ */
+STL_FUNCT_PTR_T STL_overlay_get(STL_CPUS cpu, STL_SIZE_T index, STL_ERROR_T *err)
+{
+	STL_OVERLAY_STATE_T *ovl = STL_OVERLAY_STATE(cpu);
+	const STL_OVERLAY_T *overlay;
+	STL_CYCLES_T start;
+	STL_SIZE_T slot;
+
+	*err = STL_ERROR_NONE;
+	ovl->pinned = STL_OVERLAY_NONE;
+	if (ovl->overlays == STL_NULL || index >= STL_TOT_RT_ROUTINE)
+	{
+		return STL_NULL;
+	}
+	overlay = &ovl->overlays[index];
+	if (overlay->src == STL_NULL)
+	{
+		return STL_NULL;
+	}
+	if (overlay->size > ovl->slot_size || overlay->entry >= overlay->size)
+	{
+		*err = STL_ERROR_RELOCATION;
+		return STL_NULL;
+	}
+
+	start = STL_TSSP_CPU_get_cycles();
+	slot = ovl->slot_of[index];
+	if (slot != STL_OVERLAY_NONE)
+	{
+		ovl->stats.hits++;
+#if (STL_OVERLAY_USE_DMA > 0u)
+		if (slot == ovl->pending)
+		{
+			STL_overlay_complete(ovl, err);
+		}
+#endif /*STL_OVERLAY_USE_DMA*/
+	}
+	else
+	{
+		ovl->stats.misses++;
+#if (STL_OVERLAY_USE_DMA > 0u)
+		if (ovl->pending != STL_OVERLAY_NONE)
+		{
+			/* A wrong guess: complete it so that its slot can be reused */
+			STL_overlay_complete(ovl, err);
+			*err = STL_ERROR_NONE;
+		}
+#endif /*STL_OVERLAY_USE_DMA*/
+		slot = STL_overlay_assign(ovl, index, STL_OVERLAY_NONE);
+		STL_overlay_load(ovl, slot, err);
+	}
+	STL_overlay_account(ovl, start);
+	if (*err != STL_ERROR_NONE)
+	{
+		return STL_NULL;
+	}
+
+	ovl->last_use[slot] = ++ovl->clock;
+	ovl->pinned = slot;
+	return (STL_FUNCT_PTR_T)(uintptr_t)(STL_overlay_slot(ovl, slot) + overlay->entry);
+}
+
+/**
+ * @brief Loads the code block of an upcoming runtime test ahead of its dispatch.
+ *
+ * @param cpu CPU number (not used in single core)
+ * @param index Index of the next runtime test in the schedule
+ * @param err Error code
+ * @return None
+ */
+void STL_overlay_prefetch(STL_CPUS cpu, STL_SIZE_T index, STL_ERROR_T *err)
+{
+	STL_OVERLAY_STATE_T *ovl = STL_OVERLAY_STATE(cpu);
+	const STL_OVERLAY_T *overlay;
+	STL_CYCLES_T start;
+	STL_SIZE_T slot;
+
+	*err = STL_ERROR_NONE;
+	if (ovl->overlays == STL_NULL || index >= STL_TOT_RT_ROUTINE || ovl->slot_of[index] != STL_OVERLAY_NONE)
+	{
+		return;
+	}
+	overlay = &ovl->overlays[index];
+	if (overlay->src == STL_NULL || overlay->size > ovl->slot_size)
+	{
+		return;
+	}
+
+#if (STL_OVERLAY_USE_DMA > 0u)
+	if (ovl->pending != STL_OVERLAY_NONE)
+	{
+		/* One load in flight at a time: the test will be loaded on demand */
+		return;
+	}
+#endif /*STL_OVERLAY_USE_DMA*/
+
+	slot = STL_overlay_assign(ovl, index, ovl->pinned);
+	if (slot == STL_OVERLAY_NONE)
+	{
+		return;
+	}
+	ovl->stats.prefetches++;
+
+#if (STL_OVERLAY_USE_DMA > 0u)
+	ovl->desc.src = overlay->src;
+	ovl->desc.dst = STL_overlay_slot(ovl, slot);
+	ovl->desc.size = overlay->size;
+	STL_TSSP_CSP_dma_start(&ovl->desc, 1u, err);
+	if (*err == STL_ERROR_NONE)
+	{
+		ovl->pending = slot;
+		return;
+	}
+	/* DMA busy or not available: copy with the CPU */
+	*err = STL_ERROR_NONE;
+#endif /*STL_OVERLAY_USE_DMA*/
+
+	start = STL_TSSP_CPU_get_cycles();
+	STL_overlay_load(ovl, slot, err);
+	STL_overlay_account(ovl, start);
+}
+
+/**
+ * @brief Retrieves the statistics of the overlay manager.
+ *
+ * @param cpu CPU number (not used in single core)
+ * @param stats Pointer to the statistics to fill
+ * @param err Error code
+ * @return None
+ */
+void STL_overlay_get_stats(STL_CPUS cpu, STL_OVERLAY_STATS_T *stats, STL_ERROR_T *err)
+{
+#if (STL_MULTICORE_SOC > 0u)
+	if (cpu >= STL_NUM_CPU)
+	{
+		*err = STL_CPU_OUT_OF_BOUNDS;
+		return;
+	}
+#endif /*STL_MULTICORE_SOC*/
+	*stats = STL_OVERLAY_STATE(cpu)->stats;
+	*err = STL_ERROR_NONE;
+}
+
+#endif /*STL_USE_OVERLAY*/
+#endif /*__STL_OVERLAY_MODULE__*/
+#endif /*__STL__*/
@@ -0,0 +1,156 @@
+/**
+ * @file stl_overlay.h
+ * @brief Header file for the STL overlay manager.
+ *
+ * The overlay manager runs runtime SBSTs whose code does not fit in the relocation region.
+ * The code of each test stays in ROM and is loaded on demand into a pool of RAM slots the
+ * first time the test is scheduled; when the pool is full, the least recently used slot is
+ * evicted. The scheduler announces the next test of its order before dispatching the current
+ * one, so that the load of the next test overlaps the execution of the current one (DMA) or
+ * at least happens outside the test window, and the slots of the running and of the upcoming
+ * tests are never evicted.
+ *
+ * @details
+ * - STL_overlay_init: Registers the overlay table and the slot pool.
+ * - STL_overlay_get: Returns the entry point of a test, loading it if needed.
+ * - STL_overlay_prefetch: Loads the next test of the schedule ahead of time.
+ * - STL_overlay_get_stats: Returns the hit/miss counters and the load cycles.
+ *
+ * @note The code of an overlaid test is executed from any slot: it must be position
+ *       independent (PC-relative branches only, no absolute references to itself).
+ * @note Each block is verified against its build-time CRC-32C when STL_RELOCATION_VERIFY is set.
+ * @note The DMA is used for the prefetch with STL_OVERLAY_DMA_PREFETCH, in single-core
+ *       configurations only; the asynchronous relocation (STL_relocate_runtime_tests_async) must
+ *       be completed before the scheduler runs.
+ */
+#if __STL__
+#ifndef __STL_OVERLAY_H__
+#define __STL_OVERLAY_H__
+
+#include "stl_cfg.h"
+#include "stl_types.h"
+
+#if (STL_USE_OVERLAY > 0u)
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /*__cplusplus*/
+
+	/**
+	 * @brief Overlay descriptor of one runtime test.
+	 *
+	 * @var STL_OVERLAY_T::src
+	 * Load address of the code block in ROM; STL_NULL if the test runs in place.
+	 * @var STL_OVERLAY_T::size
+	 * Size of the code block in bytes.
+	 * @var STL_OVERLAY_T::entry
+	 * Offset of the entry point within the block (including the Thumb bit on Armv7).
+	 * @var STL_OVERLAY_T::crc
+	 * CRC-32C of the block computed at build time.
+	 */
+	typedef struct
+	{
+		const void *src;
+		STL_INT32U_T size;
+		STL_INT32U_T entry;
+		STL_INT32U_T crc;
+	} STL_OVERLAY_T;
+
+	/**
+	 * @brief Statistics of the overlay manager for one CPU.
+	 *
+	 * @var STL_OVERLAY_STATS_T::hits
+	 * Number of dispatches that found the test already loaded (or being prefetched).
+	 * @var STL_OVERLAY_STATS_T::misses
+	 * Number of dispatches that had to load the test on demand.
+	 * @var STL_OVERLAY_STATS_T::prefetches
+	 * Number of loads started ahead of the dispatch.
+	 * @var STL_OVERLAY_STATS_T::evictions
+	 * Number of slots reassigned to another test.
+	 * @var STL_OVERLAY_STATS_T::load_cycles
+	 * Cycles spent by the CPU loading the slots or waiting for the DMA.
+	 * @var STL_OVERLAY_STATS_T::max_load_cycles
+	 * Worst delay added to a single dispatch, in cycles.
+	 */
+	typedef struct
+	{
+		STL_INT32U_T hits;
+		STL_INT32U_T misses;
+		STL_INT32U_T prefetches;
+		STL_INT32U_T evictions;
+		STL_CYCLES_T load_cycles;
+		STL_CYCLES_T max_load_cycles;
+	} STL_OVERLAY_STATS_T;
+
+	/**
+	 * @brief Initializes the overlay manager of a CPU.
+	 * The pool is split into slots of slot_size bytes (at most STL_OVERLAY_MAX_SLOTS); it must
+	 * be executable and word aligned. Until this function is called, every test runs in place.
+	 * Calling it again first waits for the prefetch in flight, which writes into the previous pool.
+	 *
+	 * @param cpu CPU number (not used in single core)
+	 * @param overlays Overlay descriptors, one per runtime test (STL_TOT_RT_ROUTINE entries)
+	 * @param pool RAM area holding the slots
+	 * @param pool_size Size of the pool in bytes
+	 * @param slot_size Size of a slot in bytes (multiple of 4)
+	 * @param err Error code, set to STL_ERROR_RELOCATION if the pool cannot hold a slot
+	 * @return None
+	 */
+	void STL_overlay_init(STL_CPUS cpu, const STL_OVERLAY_T *overlays, void *pool, STL_INT32U_T pool_size,
+						  STL_INT32U_T slot_size, STL_ERROR_T *err);
+
+	/**
+	 * @brief Stops the overlay manager of a CPU.
+	 * Waits for the prefetch in flight; the pool can then be given back, and every test runs in
+	 * place until the next STL_overlay_init.
+	 *
+	 * @param cpu CPU number (not used in single core)
+	 * @param err Error code
+	 * @return None
+	 */
+	void STL_overlay_deinit(STL_CPUS cpu, STL_ERROR_T *err);
+
+	/**
+	 * @brief Returns the entry point of a runtime test, loading its code block if needed.
+	 * The slot returned stays pinned until the next call, so that it cannot be evicted by a prefetch
+	 * while the test is running.
+	 *
+	 * @param cpu CPU number (not used in single core)
+	 * @param index Index of the runtime test
+	 * @param err Error code, set to STL_ERROR_RELOCATION if the block does not fit in a slot,
+	 *            STL_ERROR_RELOCATION_CRC if the loaded block does not match its CRC
+	 * @return The entry point in RAM, STL_NULL if the test runs in place
+	 */
+	STL_FUNCT_PTR_T STL_overlay_get(STL_CPUS cpu, STL_SIZE_T index, STL_ERROR_T *err);
+
+	/**
+	 * @brief Loads the code block of an upcoming runtime test ahead of its dispatch.
+	 * The victim is the least recently used slot, excluding the pinned one. With the DMA the
+	 * load runs in the background and is completed by STL_overlay_get; when the DMA is busy or
+	 * not available, the block is copied by the CPU.
+	 *
+	 * @param cpu CPU number (not used in single core)
+	 * @param index Index of the next runtime test in the schedule
+	 * @param err Error code, set to STL_ERROR_RELOCATION_CRC if the loaded block does not match its CRC
+	 * @return None
+	 */
+	void STL_overlay_prefetch(STL_CPUS cpu, STL_SIZE_T index, STL_ERROR_T *err);
+
+	/**
+	 * @brief Retrieves the statistics of the overlay manager.
+	 *
+	 * @param cpu CPU number (not used in single core)
+	 * @param stats Pointer to the statistics to fill
+	 * @param err Error code
+	 * @return None
+	 */
+	void STL_overlay_get_stats(STL_CPUS cpu, STL_OVERLAY_STATS_T *stats, STL_ERROR_T *err);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /*STL_USE_OVERLAY*/
+#endif /*__STL_OVERLAY_H__*/
+#endif /*__STL__*/
@@ -0,0 +1,353 @@
+#if __STL__
+
+/**
+ * @file stl_redundancy.c
+ * @brief Implementation of the STL software redundancy.
+ *
+ * Each CPU owns one exchange entry per runtime test, in its own cache lines, and is the only
+ * writer of its entries: the number of runs it has published and the signature of the last
+ * one. An entry is written under a sequence counter (odd while the entry is being written), so
+ * that the partner reads a consistent run and signature without any lock; the writer never
+ * waits.
+ *
+ * After publishing a run, a CPU reads the entry of its partner: both accesses are separated by
+ * a full fence, so that of two CPUs publishing the same run at the same time at least one sees
+ * the other. The CPU that finds the same run (or a later one) published by its partner compares
+ * the signatures and records the verdict for both CPUs; otherwise the partner will compare when
+ * it publishes. The cost of an exchange on each CPU is a few stores, a fence and the reads of
+ * one line of the partner.
+ *
+ * @see stl_redundancy.h
+ */
+
+#ifndef __STL_REDUNDANCY_MODULE__
+#define __STL_REDUNDANCY_MODULE__
+
+#include "stl_redundancy.h"
+#include "stl_cfg.h"
+#include "stl_sbst_cfg.h"
+#include "stl_trace.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+#if (STL_USE_REDUNDANCY > 0u)
+
+#if (STL_MULTICORE_SOC > 0u)
+#include "stl_al_cpu.h"
+#define STL_REDUNDANCY_CPUS STL_NUM_CPU
+#else
+#define STL_REDUNDANCY_CPUS 1u
+#endif /*STL_MULTICORE_SOC*/
+
+#if (STL_MULTICORE_SOC > 0u)
+/* Partner of a CPU in the pair mode; STL_REDUNDANCY_CPUS or more: no partner */
+#define STL_REDUNDANCY_PARTNER(cpu) ((STL_CPUS)((cpu) ^ 1u))
+
+/**
+ * @typedef STL_REDUNDANCY_ENTRY_T
+ * @brief Exchange entry of a test on a CPU, only written by that CPU.
+ *
+ * @var STL_REDUNDANCY_ENTRY_T::version
+ * Sequence counter of the entry, odd while the entry is being written.
+ * @var STL_REDUNDANCY_ENTRY_T::run
+ * Runs of the test published by the CPU.
+ * @var STL_REDUNDANCY_ENTRY_T::signature
+ * Signature of the last run.
+ */
+typedef struct
+{
+	STL_INT32U_T version;
+	STL_INT32U_T run;
+	STL_SIGNATURE_T signature;
+} STL_REDUNDANCY_ENTRY_T;
+
+/**
+ * @typedef STL_REDUNDANCY_SLOT_T
+ * @brief Exchange slot of a CPU: its entries, for all the runtime tests.
+ */
+typedef struct
+{
+	STL_REDUNDANCY_ENTRY_T entry[STL_TOT_RT_ROUTINE];
+} ALIGNED_KEYWORD(STL_CACHE_LINE_SIZE) STL_REDUNDANCY_SLOT_T;
+#endif /*STL_MULTICORE_SOC*/
+
+/**
+ * @typedef STL_REDUNDANCY_CPU_T
+ * @brief Divergence verdicts and statistics of a CPU.
+ *
+ * @var STL_REDUNDANCY_CPU_T::verdict
+ * Divergence verdict of each runtime test (STL_VERDICT_T), written by both CPUs of a pair.
+ * @var STL_REDUNDANCY_CPU_T::stats
+ * Statistics, only written by the CPU.
+ */
+typedef struct
+{
+	STL_INT32U_T verdict[STL_TOT_RT_ROUTINE];
+	STL_REDUNDANCY_STATS_T stats;
+} ALIGNED_KEYWORD(STL_CACHE_LINE_SIZE) STL_REDUNDANCY_CPU_T;
+
+#if (STL_MULTICORE_SOC > 0u)
+STATIC_KEYWORD STL_REDUNDANCY_SLOT_T redundancy_slot[STL_REDUNDANCY_CPUS];
+#endif /*STL_MULTICORE_SOC*/
+STATIC_KEYWORD STL_REDUNDANCY_CPU_T redundancy_cpu[STL_REDUNDANCY_CPUS];
+
+#if (STL_MULTICORE_SOC > 0u)
+/**
+ * @brief Writes a run in an entry of the calling CPU.
+ *
+ * @param entry Entry of the CPU
+ * @param run Number of the run
+ * @param signature Signature of the run
+ * @return None
+ */
+STATIC_KEYWORD INLINE_KEYWORD void STL_redundancy_publish(STL_REDUNDANCY_ENTRY_T *entry, STL_INT32U_T run,
+														  STL_SIGNATURE_T signature)
+{
+	STL_INT32U_T version = entry->version;
+
+	__atomic_store_n(&entry->version, version + 1u, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	__atomic_store_n(&entry->run, run, __ATOMIC_RELAXED);
+	__atomic_store_n(&entry->signature, signature, __ATOMIC_RELAXED);
+	__atomic_store_n(&entry->version, version + 2u, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Reads a consistent run from an entry of the partner.
+ *
+ * @param entry Entry of the partner
+ * @param run Number of the run
+ * @param signature Signature of the run
+ * @return None
+ */
+STATIC_KEYWORD INLINE_KEYWORD void STL_redundancy_read(STL_REDUNDANCY_ENTRY_T *entry, STL_INT32U_T *run,
+													   STL_SIGNATURE_T *signature)
+{
+	STL_INT32U_T before;
+	STL_INT32U_T after;
+
+	do
+	{
+		before = __atomic_load_n(&entry->version, __ATOMIC_ACQUIRE);
+		*run = __atomic_load_n(&entry->run, __ATOMIC_RELAXED);
+		*signature = __atomic_load_n(&entry->signature, __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		after = __atomic_load_n(&entry->version, __ATOMIC_RELAXED);
+	} while ((before & 1u) != 0u || before != after);
+}
+#endif /*STL_MULTICORE_SOC*/
+
+/**
+ * @brief Records the divergence verdict of a test on a CPU and on its partner.
+ *
+ * @param cpu Calling CPU
+ * @param partner Partner CPU (cpu itself for the executions on one CPU)
+ * @param index Index of the test
+ * @param verdict Divergence verdict
+ * @param other Signature compared with the one of the calling CPU
+ * @return None
+ */
+STATIC_KEYWORD void STL_redundancy_record(STL_CPUS cpu, STL_CPUS partner, STL_SIZE_T index, STL_VERDICT_T verdict,
+										  STL_SIGNATURE_T other)
+{
+	__atomic_store_n(&redundancy_cpu[cpu].verdict[index], (STL_INT32U_T)verdict, __ATOMIC_RELAXED);
+	__atomic_store_n(&redundancy_cpu[partner].verdict[index], (STL_INT32U_T)verdict, __ATOMIC_RELAXED);
+	STL_TRACE(cpu, STL_TRACE_EV_REDUNDANCY, index, verdict, other);
+}
+
+/**
+ * @brief Initializes the redundancy.
+ *
+ * @param err Error code
+ * @return None
+ */
+void STL_redundancy_init(STL_ERROR_T *err)
+{
+	STL_CPUS cpu;
+	STL_SIZE_T i;
+
+	for (cpu = 0u; cpu < STL_REDUNDANCY_CPUS; cpu++)
+	{
+		for (i = 0u; i < STL_TOT_RT_ROUTINE; i++)
+		{
+#if (STL_MULTICORE_SOC > 0u)
+			redundancy_slot[cpu].entry[i] = (STL_REDUNDANCY_ENTRY_T){0};
+#endif /*STL_MULTICORE_SOC*/
+			redundancy_cpu[cpu].verdict[i] = (STL_INT32U_T)STL_VERDICT_NOT_RUN;
+		}
+		redundancy_cpu[cpu].stats = (STL_REDUNDANCY_STATS_T){0};
+	}
+	*err = STL_ERROR_NONE;
+}
+
+#if (STL_MULTICORE_SOC > 0u)
+/**
+ * @brief Publishes a run of a test in the exchange slot of a CPU and compares it when the
+ *        partner has published the same run.
+ *
+ * @param cpu Calling CPU
+ * @param partner Partner CPU
+ * @param index Index of the test
+ * @param signature Signature of the run
+ * @return None
+ */
+STATIC_KEYWORD void STL_redundancy_pair(STL_CPUS cpu, STL_CPUS partner, STL_SIZE_T index, STL_SIGNATURE_T signature)
+{
+	STL_REDUNDANCY_STATS_T *stats = &redundancy_cpu[cpu].stats;
+	STL_REDUNDANCY_ENTRY_T *own = &redundancy_slot[cpu].entry[index];
+	STL_CYCLES_T start = STL_TSSP_CPU_get_cycles();
+	STL_CYCLES_T elapsed;
+	STL_INT32U_T run = own->run + 1u;
+	STL_INT32U_T partner_run;
+	STL_SIGNATURE_T partner_signature;
+	int32_t lag;
+
+	STL_redundancy_publish(own, run, signature);
+	stats->published++;
+	/* Store-load ordering: of two CPUs publishing together, at least one sees the other */
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	STL_redundancy_read(&redundancy_slot[partner].entry[index], &partner_run, &partner_signature);
+
+	lag = (int32_t)(run - partner_run);
+	if (lag <= 0)
+	{
+		/* The partner has published this run, or later ones while this CPU was lagging */
+		STL_redundancy_record(cpu, partner, index,
+							  (signature == partner_signature) ? STL_VERDICT_PASS : STL_VERDICT_FAIL,
+							  partner_signature);
+		stats->compared++;
+		if (signature != partner_signature)
+		{
+			stats->diverged++;
+		}
+		if (lag < 0)
+		{
+			STL_redundancy_publish(own, partner_run, signature);
+			stats->resynced++;
+		}
+	}
+	else if ((STL_INT32U_T)lag >= STL_REDUNDANCY_MAX_LAG)
+	{
+		STL_redundancy_record(cpu, partner, index, STL_VERDICT_TIMEOUT, partner_signature);
+		stats->lost++;
+	}
+	else
+	{
+		/* First of the pair: the partner compares when it publishes this run */
+	}
+
+	elapsed = STL_TSSP_CPU_get_cycles() - start;
+	stats->exchange_cycles += elapsed;
+	if (elapsed > stats->exchange_max)
+	{
+		stats->exchange_max = elapsed;
+	}
+}
+#endif /*STL_MULTICORE_SOC*/
+
+/**
+ * @brief Publishes the signature of a test flagged for redundancy.
+ *
+ * @param cpu CPU number
+ * @param index Index of the test
+ * @param mode Redundancy of the test
+ * @param signature Signature of the execution
+ * @return STL_FALSE when the test must be executed a second time on this CPU
+ */
+STL_BOOL STL_redundancy_exchange(STL_CPUS cpu, STL_SIZE_T index, STL_INT32U_T mode, STL_SIGNATURE_T signature)
+{
+	STL_CYCLES_T start;
+
+	/* A test that did not run has nothing to compare */
+	if (signature == STL_SIGNATURE_SKIPPED)
+	{
+		return STL_TRUE;
+	}
+#if (STL_MULTICORE_SOC > 0u)
+	if (mode == STL_REDUNDANCY_PAIR && STL_REDUNDANCY_PARTNER(cpu) < STL_REDUNDANCY_CPUS)
+	{
+		STL_redundancy_pair(cpu, STL_REDUNDANCY_PARTNER(cpu), index, signature);
+		return STL_TRUE;
+	}
+#else
+	(void)cpu;
+	(void)index;
+	(void)mode;
+#endif /*STL_MULTICORE_SOC*/
+
+	/* Time diversity: the second execution starts later than the first one */
+	start = STL_TSSP_CPU_get_cycles();
+	while (STL_TSSP_CPU_get_cycles() - start < STL_REDUNDANCY_DIVERSITY_CYCLES)
+	{
+	}
+	return STL_FALSE;
+}
+
+/**
+ * @brief Compares the two executions of a test on the same CPU.
+ *
+ * @param cpu CPU number
+ * @param index Index of the test
+ * @param first Signature of the first execution
+ * @param second Signature of the second execution
+ * @return None
+ */
+void STL_redundancy_compare(STL_CPUS cpu, STL_SIZE_T index, STL_SIGNATURE_T first, STL_SIGNATURE_T second)
+{
+	STL_REDUNDANCY_STATS_T *stats = &redundancy_cpu[cpu].stats;
+
+	stats->repeated++;
+	stats->compared++;
+	if (first != second)
+	{
+		stats->diverged++;
+	}
+	STL_redundancy_record(cpu, cpu, index, (first == second) ? STL_VERDICT_PASS : STL_VERDICT_FAIL, second);
+}
+
+/**
+ * @brief Retrieves the divergence verdict of a test on a CPU.
+ *
+ * @param cpu CPU number
+ * @param index Index of the test
+ * @param err Error code
+ * @return The divergence verdict
+ */
+STL_VERDICT_T STL_redundancy_get_verdict(STL_CPUS cpu, STL_SIZE_T index, STL_ERROR_T *err)
+{
+	if (cpu >= STL_REDUNDANCY_CPUS)
+	{
+		*err = STL_CPU_OUT_OF_BOUNDS;
+		return STL_VERDICT_NOT_RUN;
+	}
+	if (index >= STL_TOT_RT_ROUTINE)
+	{
+		*err = STL_INDEX_OUT_OF_BOUNDS;
+		return STL_VERDICT_NOT_RUN;
+	}
+	*err = STL_ERROR_NONE;
+	return (STL_VERDICT_T)__atomic_load_n(&redundancy_cpu[cpu].verdict[index], __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Retrieves the statistics of the redundancy of a CPU.
+ *
+ * @param cpu CPU number
+ * @param stats Pointer to the statistics to fill
+ * @param err Error code
+ * @return None
+ */
+void STL_redundancy_get_stats(STL_CPUS cpu, STL_REDUNDANCY_STATS_T *stats, STL_ERROR_T *err)
+{
+	if (cpu >= STL_REDUNDANCY_CPUS)
+	{
+		*err = STL_CPU_OUT_OF_BOUNDS;
+		return;
+	}
+	*stats = redundancy_cpu[cpu].stats;
+	*err = STL_ERROR_NONE;
+}
+
+#endif /*STL_USE_REDUNDANCY*/
+#endif /*__STL_REDUNDANCY_MODULE__*/
+#endif /*__STL__*/
@@ -0,0 +1,146 @@
+/**
+ * @file stl_redundancy.h
+ * @brief Header file for the STL software redundancy (dual execution of the SBSTs).
+ *
+ * On SoCs without lockstep cores, a fault that corrupts the execution of a test in a way the
+ * test cannot see by itself (a wrong signature that still reads as valid, a faulty comparison
+ * with the golden signature) is caught by running the test twice and comparing the two
+ * signatures. The runtime tests flagged in STL_RT_ROUTINE_REDUNDANCY are executed:
+ *
+ *   - STL_REDUNDANCY_PAIR: once on each CPU of a pair (CPUs 2k and 2k + 1), each CPU running
+ *     its own schedule. The signatures meet in a lock-free exchange slot: each CPU publishes
+ *     its signature without waiting, and the second CPU of the pair to publish a run compares
+ *     the two. No CPU ever waits for its partner;
+ *   - STL_REDUNDANCY_TWICE: twice on the same CPU, the second execution starting
+ *     STL_REDUNDANCY_DIVERSITY_CYCLES after the first one (time diversity against transient
+ *     faults). A CPU without a partner (single core, last CPU of an odd count) runs its paired
+ *     tests this way.
+ *
+ * The comparison gives a divergence verdict, kept apart from the verdict of the error
+ * management (comparison of each execution with its golden signature): pass when the two
+ * signatures agree, fail when they diverge, timeout when a CPU of the pair has run the test
+ * STL_REDUNDANCY_MAX_LAG times more than its partner without a comparison. The lagging CPU
+ * compares its next run with the latest run of its partner and catches up with its count.
+ *
+ * @details
+ * - STL_redundancy_init: Clears the exchange slots, the verdicts and the statistics.
+ * - STL_redundancy_exchange: Publishes the signature of a paired test (called by the scheduler).
+ * - STL_redundancy_compare: Compares the two executions on one CPU (called by the scheduler).
+ * - STL_redundancy_get_verdict: Returns the divergence verdict of a test on a CPU.
+ * - STL_redundancy_get_stats: Returns the comparisons, the divergences and the overhead of a CPU.
+ *
+ * @note The paired tests must be scheduled the same number of times on both CPUs of a pair,
+ *       and should not be deferred by the throttle: a lagging CPU is reported as a timeout.
+ */
+#if __STL__
+#ifndef __STL_REDUNDANCY_H__
+#define __STL_REDUNDANCY_H__
+
+#include "stl_cfg.h"
+#include "stl_types.h"
+
+#if (STL_USE_REDUNDANCY > 0u)
+
+#define STL_REDUNDANCY_NONE 0u	/* Single execution */
+#define STL_REDUNDANCY_PAIR 1u	/* One execution on each CPU of a pair */
+#define STL_REDUNDANCY_TWICE 2u /* Two executions on the same CPU, time diversity */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /*__cplusplus*/
+
+	/**
+	 * @brief Statistics of the redundancy of a CPU.
+	 *
+	 * @var STL_REDUNDANCY_STATS_T::published
+	 * Signatures published in the exchange slot of the CPU.
+	 * @var STL_REDUNDANCY_STATS_T::repeated
+	 * Tests executed a second time on the CPU.
+	 * @var STL_REDUNDANCY_STATS_T::compared
+	 * Comparisons made by the CPU (both CPUs of a pair may compare the same run).
+	 * @var STL_REDUNDANCY_STATS_T::diverged
+	 * Comparisons that found different signatures.
+	 * @var STL_REDUNDANCY_STATS_T::lost
+	 * Runs declared lost, the partner lagging by STL_REDUNDANCY_MAX_LAG runs.
+	 * @var STL_REDUNDANCY_STATS_T::resynced
+	 * Runs compared with a later run of the partner (the CPU was lagging).
+	 * @var STL_REDUNDANCY_STATS_T::exchange_cycles
+	 * Cycles spent in the exchanges of the CPU (publication, comparison, verdict).
+	 * @var STL_REDUNDANCY_STATS_T::exchange_max
+	 * Longest exchange of the CPU.
+	 */
+	typedef struct
+	{
+		STL_INT32U_T published;
+		STL_INT32U_T repeated;
+		STL_INT32U_T compared;
+		STL_INT32U_T diverged;
+		STL_INT32U_T lost;
+		STL_INT32U_T resynced;
+		STL_CYCLES_T exchange_cycles;
+		STL_CYCLES_T exchange_max;
+	} STL_REDUNDANCY_STATS_T;
+
+	/**
+	 * @brief Initializes the redundancy: empty exchange slots, verdicts not run, statistics cleared.
+	 * No CPU may be running a test.
+	 *
+	 * @param err Error code
+	 * @return None
+	 */
+	void STL_redundancy_init(STL_ERROR_T *err);
+
+	/**
+	 * @brief Publishes the signature of a test flagged for redundancy and compares it with the
+	 *        partner CPU when the partner has published the same run.
+	 *
+	 * @param cpu CPU number (not checked, called by the scheduler)
+	 * @param index Index of the test (not checked)
+	 * @param mode Redundancy of the test (STL_REDUNDANCY_PAIR or STL_REDUNDANCY_TWICE)
+	 * @param signature Signature of the execution
+	 * @return STL_FALSE, after the time-diversity delay, when the test must be executed a second
+	 *         time on this CPU (STL_REDUNDANCY_TWICE or no partner), STL_TRUE otherwise
+	 */
+	STL_BOOL STL_redundancy_exchange(STL_CPUS cpu, STL_SIZE_T index, STL_INT32U_T mode, STL_SIGNATURE_T signature);
+
+	/**
+	 * @brief Compares the two executions of a test on the same CPU.
+	 *
+	 * @param cpu CPU number (not checked, called by the scheduler)
+	 * @param index Index of the test (not checked)
+	 * @param first Signature of the first execution
+	 * @param second Signature of the second execution
+	 * @return None
+	 */
+	void STL_redundancy_compare(STL_CPUS cpu, STL_SIZE_T index, STL_SIGNATURE_T first, STL_SIGNATURE_T second);
+
+	/**
+	 * @brief Retrieves the divergence verdict of a test on a CPU.
+	 *
+	 * @param cpu CPU number
+	 * @param index Index of the test
+	 * @param err Error code, set to STL_CPU_OUT_OF_BOUNDS for an invalid CPU and to
+	 *            STL_INDEX_OUT_OF_BOUNDS for an invalid test
+	 * @return STL_VERDICT_PASS if the executions agree, STL_VERDICT_FAIL if they diverge,
+	 *         STL_VERDICT_TIMEOUT if the partner lags, STL_VERDICT_NOT_RUN before the first comparison
+	 */
+	STL_VERDICT_T STL_redundancy_get_verdict(STL_CPUS cpu, STL_SIZE_T index, STL_ERROR_T *err);
+
+	/**
+	 * @brief Retrieves the statistics of the redundancy of a CPU.
+	 *
+	 * @param cpu CPU number
+	 * @param stats Pointer to the statistics to fill
+	 * @param err Error code, set to STL_CPU_OUT_OF_BOUNDS for an invalid CPU
+	 * @return None
+	 */
+	void STL_redundancy_get_stats(STL_CPUS cpu, STL_REDUNDANCY_STATS_T *stats, STL_ERROR_T *err);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /*STL_USE_REDUNDANCY*/
+#endif /*__STL_REDUNDANCY_H__*/
+#endif /*__STL__*/
@@ -55,33 +55,33 @@
 
 #include "stl_sbst_cfg.h"
 #include "stl_scheduler.h"
+#include "stl_context.h"
+#include "stl_error_management.h"
+#include "stl_sw_watchdog.h"
+#include "stl_overlay.h"
+#include "stl_trace.h"
+#include "stl_throttle.h"
+#include "stl_sync.h"
+#include "stl_redundancy.h"
 #include "stl_tssp.h"
 #include "stl_cfg.h"
 #include "stl_types.h"
 
-
-#if (STL_BOOT_TEST > 0u)
-/**
- * @brief Pointer to the boot test routines.
- *
- * This array contains pointers to the boot test routines.
- * It is used to call the boot tests during the boot process.
- * The array is indexed by the STL_TOT_BT_ROUTINE enum.
- */
-EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_BT[STL_TOT_BT_ROUTINE];
-#endif /* STL_BOOT_TEST */
-
+#if (STL_CONST_TEST_TABLES > 0u)
+/* Routine tables of the default context, fixed at build time (stl.c) */
 #if (STL_RUNTIME_TEST > 0u)
-/**
- * @brief Pointer to the runtime test routines.
- *
- * This array contains pointers to the runtime test routines.
- * It is used to call the runtime tests during the runtime process.
- * The array is indexed by the STL_TOT_RT_ROUTINE enum.
- */
-EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
+EXTERN_KEYWORD const STL_FUNCT_PTR_T SBST_RT[STL_CONTEXT_CPUS * STL_TOT_RT_ROUTINE];
 #endif /* STL_RUNTIME_TEST */
+#if (STL_BOOT_TEST > 0u)
+EXTERN_KEYWORD const STL_FUNCT_PTR_T SBST_BT[STL_CONTEXT_CPUS * STL_TOT_BT_ROUTINE];
+#endif /* STL_BOOT_TEST */
 
+/* Unroll factor of the sequential runtime scheduler: fully unrolled, so that each routine of a
+ * constant table is called directly */
+#define STL_RT_DISPATCH_UNROLL STL_TOT_RT_ROUTINE
+#else
+#define STL_RT_DISPATCH_UNROLL STL_DISPATCH_UNROLL
+#endif /* STL_CONST_TEST_TABLES */
 
 #if (STL_BOOT_TEST > 0u)
 /**
@@ -89,21 +89,20 @@ EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
  * It is called by the main function to execute the bootime tests, sequentially.
  * It is used to schedule the bootime tests in a sequential manner for a given CPU (in case of multicore).
  *
+ * @param ctx Context holding the routines and the results
  * @param cpu CPU number (not used in single core)
  * @param err Error code
  * @return None
  */
-void STL_scheduler_bootime(STL_CPUS cpu, STL_ERROR_T *err)
+void STL_scheduler_bootime(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_ERROR_T *err)
 {
 	STL_SIZE_T i;
 	STL_SIGNATURE_T signature;
 
-#if (STL_MULTICORE_SOC == 1u)
-	STL_TSSP_CPU_swap_ivor(cpu);
-#else
+	/* The vector base is a register of the calling CPU: swap and restore take no CPU number */
 	STL_TSSP_CPU_swap_ivor();
-#endif
 
+	STL_UNROLL(STL_DISPATCH_UNROLL)
 	for (i = 0; i < STL_TOT_BT_ROUTINE; i++)
 	{
 		/* Set test configuration */
@@ -112,24 +111,18 @@ void STL_scheduler_bootime(STL_CPUS cpu, STL_ERROR_T *err)
 #else
 		STL_TSSP_set_test_config_bootime(i, err);
 #endif
+		STL_TRACE(cpu, STL_TRACE_EV_SETUP, i, STL_TRACE_SETUP_CONFIG, *err);
 		if (*err != STL_ERROR_NONE)
 		{
-#if (STL_MULTICORE_SOC == 1u)
-			STL_TSSP_CPU_restore_ivor(cpu);
-#else
 			STL_TSSP_CPU_restore_ivor();
-#endif
 			return;
 		}
 
 		/* Execute test and update signature */
-#if (STL_MULTICORE_SOC == 1u)
-		signature = SBST_BT[cpu][i]();
-		STL_em_update_sig(i, signature, cpu, err);
-#else
-		signature = SBST_BT[i]();
-		STL_em_update_sig(i, signature, err);
-#endif
+		STL_TRACE(cpu, STL_TRACE_EV_TEST_START, i, STL_TRACE_BOOTTIME, 0u);
+		signature = ctx->cfg.bt_routines[cpu * STL_TOT_BT_ROUTINE + i]();
+		STL_TRACE(cpu, STL_TRACE_EV_TEST_STOP, i, STL_TRACE_BOOTTIME, signature);
+		STL_em_ctx_update_bt_sig(ctx, i, signature, cpu, err);
 
 		/* Restore test configuration */
 #if (STL_MULTICORE_SOC == 1u)
@@ -137,43 +130,44 @@ void STL_scheduler_bootime(STL_CPUS cpu, STL_ERROR_T *err)
 #else
 		STL_TSSP_restore_test_config_bootime(i, err);
 #endif
+		STL_TRACE(cpu, STL_TRACE_EV_RESTORE, i, STL_TRACE_SETUP_CONFIG, *err);
 
 		/* Check for errors */
 		if (*err != STL_ERROR_NONE)
 		{
-#if (STL_MULTICORE_SOC == 1u)
-			STL_TSSP_CPU_restore_ivor(cpu);
-#else
 			STL_TSSP_CPU_restore_ivor();
-#endif
 			return;
 		}
 	}
 
-#if (STL_MULTICORE_SOC == 1u)
-	STL_TSSP_CPU_restore_ivor(cpu);
-#else
 	STL_TSSP_CPU_restore_ivor();
-#endif
 }
 
 /**
  * @brief Sequential SBST scheduler for bootime tests
  *
  * This scheduler executes all bootime tests sequentially.
+ * With constant routine tables the default context runs the routines of SBST_BT directly.
  *
+ * @param ctx Context holding the routines and the results
  * @param err Error code
  * @return None
  */
-STATIC_KEYWORD void STL_scheduler_bootime_singlecore(STL_ERROR_T *err)
+STATIC_KEYWORD void STL_scheduler_bootime_singlecore(STL_CONTEXT_T *ctx, STL_ERROR_T *err)
 {
+#if (STL_CONST_TEST_TABLES > 0u)
+	const STL_FUNCT_PTR_T *routines = (ctx == &STL_default_context) ? SBST_BT : ctx->cfg.bt_routines;
+#else
+	const STL_FUNCT_PTR_T *routines = ctx->cfg.bt_routines;
+#endif /* STL_CONST_TEST_TABLES */
 	STL_SIZE_T i;
 	STL_SIGNATURE_T signature;
 
+	STL_UNROLL(STL_DISPATCH_UNROLL)
 	for (i = 0; i < STL_TOT_BT_ROUTINE; i++)
 	{
-		signature = SBST_BT[i]();
-		STL_em_update_sig(i, signature, err);
+		signature = routines[i]();
+		STL_em_ctx_update_bt_sig(ctx, i, signature, 0, err);
 
 		if (*err != STL_ERROR_NONE)
 		{
@@ -196,24 +190,311 @@ STATIC_KEYWORD void STL_scheduler_bootime_singlecore(STL_ERROR_T *err)
 
 #if (STL_RUNTIME_TEST > 0u)
 
+#if (STL_USE_SW_WATCHDOG > 0u)
+/**
+ * @brief Execution budget of each runtime test, in CPU cycles.
+ * It is used to arm the software deadline monitor before dispatching the test.
+ */
+STATIC_KEYWORD const STL_CYCLES_T rt_budget[STL_TOT_RT_ROUTINE] = STL_RT_ROUTINE_BUDGET;
+STL_STATIC_ASSERT(STL_INIT_ENTRIES(rt_budget, STL_RT_ROUTINE_BUDGET) == STL_TOT_RT_ROUTINE,
+				  "STL_RT_ROUTINE_BUDGET needs one entry per runtime routine");
+#endif /* STL_USE_SW_WATCHDOG */
+
+#if (STL_USE_WATCHDOG > 0u && STL_USE_FINE_GRAINED_WATCHDOG > 0u)
+/**
+ * @brief Watchdog timeout of each runtime test.
+ * It is used to arm the fine-grained watchdog before dispatching the test.
+ */
+STATIC_KEYWORD const int32_t rt_wdg_timeout[STL_TOT_RT_ROUTINE] = STL_RT_ROUTINE_WDG_TIMEOUT;
+STL_STATIC_ASSERT(STL_INIT_ENTRIES(rt_wdg_timeout, STL_RT_ROUTINE_WDG_TIMEOUT) == STL_TOT_RT_ROUTINE,
+				  "STL_RT_ROUTINE_WDG_TIMEOUT needs one entry per runtime routine");
+#endif /* STL_USE_FINE_GRAINED_WATCHDOG */
+
+#if (STL_USE_MPU > 0u)
+/**
+ * @brief MPU profile (test class) of each runtime test.
+ * It is used to isolate the test before dispatching it.
+ */
+STATIC_KEYWORD const STL_SIZE_T rt_mpu_profile[STL_TOT_RT_ROUTINE] = STL_RT_ROUTINE_MPU_PROFILE;
+STL_STATIC_ASSERT(STL_INIT_ENTRIES(rt_mpu_profile, STL_RT_ROUTINE_MPU_PROFILE) == STL_TOT_RT_ROUTINE,
+				  "STL_RT_ROUTINE_MPU_PROFILE needs one entry per runtime routine");
+#endif /* STL_USE_MPU */
+
+#if (STL_USE_THROTTLE > 0u)
+/**
+ * @brief Memory footprint of each runtime test, in bytes.
+ * It is taken from the token bucket of the CPU before dispatching the test.
+ */
+STATIC_KEYWORD const STL_INT32U_T rt_mem_bytes[STL_TOT_RT_ROUTINE] = STL_RT_ROUTINE_MEM_BYTES;
+STL_STATIC_ASSERT(STL_INIT_ENTRIES(rt_mem_bytes, STL_RT_ROUTINE_MEM_BYTES) == STL_TOT_RT_ROUTINE,
+				  "STL_RT_ROUTINE_MEM_BYTES needs one entry per runtime routine");
+#endif /* STL_USE_THROTTLE */
+
+#if (STL_USE_SYNC_WINDOW > 0u)
+/**
+ * @brief Synchronized window of each runtime test.
+ * The flagged tests start and end at a barrier of the participating CPUs.
+ */
+STATIC_KEYWORD const STL_BOOL rt_sync_window[STL_TOT_RT_ROUTINE] = STL_RT_ROUTINE_SYNC_WINDOW;
+STL_STATIC_ASSERT(STL_INIT_ENTRIES(rt_sync_window, STL_RT_ROUTINE_SYNC_WINDOW) == STL_TOT_RT_ROUTINE,
+				  "STL_RT_ROUTINE_SYNC_WINDOW needs one entry per runtime routine");
+#endif /* STL_USE_SYNC_WINDOW */
+
+#if (STL_USE_REDUNDANCY > 0u)
+/**
+ * @brief Redundancy of each runtime test (STL_REDUNDANCY_*).
+ * The signatures of the flagged tests are compared with a second execution.
+ */
+STATIC_KEYWORD const STL_INT32U_T rt_redundancy[STL_TOT_RT_ROUTINE] = STL_RT_ROUTINE_REDUNDANCY;
+STL_STATIC_ASSERT(STL_INIT_ENTRIES(rt_redundancy, STL_RT_ROUTINE_REDUNDANCY) == STL_TOT_RT_ROUTINE,
+				  "STL_RT_ROUTINE_REDUNDANCY needs one entry per runtime routine");
+#endif /* STL_USE_REDUNDANCY */
+
+/**
+ * @brief Executes a single runtime test and records its verdict.
+ *
+ * When the software deadline monitor is enabled, the test is armed with its own budget.
+ * A test that overruns its budget is aborted and a timeout verdict is recorded;
+ * the error code is then cleared so that the scheduler moves on to the next test.
+ *
+ * When the hardware watchdog is enabled, it is serviced at the test boundaries:
+ * the fine-grained watchdog is armed with the timeout of the test and stopped
+ * afterward, the coarse one is kicked before and after the test.
+ *
+ * When the MPU is enabled, the test runs under the MPU profile of its class and the
+ * application profile is restored afterward; only the MPU registers that differ
+ * between the two profiles are written.
+ *
+ * When the overlay manager is enabled, the code of the test is loaded into a RAM slot if
+ * needed and the next test of the schedule is prefetched before the test is isolated, so
+ * that its load overlaps the execution of the current test.
+ *
+ * When the throttle is enabled, a test with a memory footprint first takes its bytes from
+ * the token bucket of the CPU; without enough bytes it is deferred: nothing is dispatched
+ * and its previous verdict is kept.
+ *
+ * When the redundancy is enabled, the signature of a flagged test is published to the
+ * partner CPU, or the test is executed a second time on the CPU under the same isolation;
+ * the divergence verdict is recorded by the redundancy module, the error management only
+ * records the verdict of the first execution.
+ *
+ * @param ctx Context recording the verdict
+ * @param cpu CPU number (not used in single core)
+ * @param index Index of the test
+ * @param test Test routine (in place)
+ * @param err Error code
+ * @return None
+ */
+STATIC_KEYWORD INLINE_KEYWORD void STL_scheduler_execute_runtime(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_SIZE_T index,
+																 STL_FUNCT_PTR_T test, STL_ERROR_T *err)
+{
+	STL_SIGNATURE_T signature;
+#if (STL_USE_MPU > 0u)
+	STL_ERROR_T mpu_err;
+#endif /* STL_USE_MPU */
+#if (STL_USE_PMU > 0u)
+	STL_PMU_SAMPLE_T pmu_before;
+	STL_PMU_SAMPLE_T pmu_after;
+	STL_ERROR_T pmu_err;
+#endif /* STL_USE_PMU */
+#if (STL_USE_OVERLAY > 0u)
+	STL_FUNCT_PTR_T overlay;
+	STL_ERROR_T prefetch_err;
+#endif /* STL_USE_OVERLAY */
+#if (STL_USE_REDUNDANCY > 0u)
+	STL_SIGNATURE_T repeated;
+#endif /* STL_USE_REDUNDANCY */
+
+#if (STL_USE_THROTTLE > 0u)
+	if (rt_mem_bytes[index] > 0u && STL_throttle_acquire(cpu, rt_mem_bytes[index]) == STL_FALSE)
+	{
+		STL_TRACE(cpu, STL_TRACE_EV_THROTTLE, index, 0u, rt_mem_bytes[index]);
+		return;
+	}
+#endif /* STL_USE_THROTTLE */
+
+#if (STL_USE_OVERLAY > 0u)
+	overlay = STL_overlay_get(cpu, index, err);
+	if (*err != STL_ERROR_NONE)
+	{
+		return;
+	}
+	if (overlay != STL_NULL)
+	{
+		test = overlay;
+	}
+	/* A failed prefetch is retried on demand when the next test is dispatched */
+	STL_overlay_prefetch(cpu, (STL_SIZE_T)((index + 1u) % STL_TOT_RT_ROUTINE), &prefetch_err);
+#endif /* STL_USE_OVERLAY */
+
+#if (STL_USE_WATCHDOG > 0u && STL_USE_FINE_GRAINED_WATCHDOG > 0u)
+	/* The window is set up before the isolation: a failed setup leaves nothing to restore */
+	STL_TSSP_CSP_watchdog_init(rt_wdg_timeout[index], STL_WATCHDOG_RESET_VALUE, err);
+	if (*err != STL_ERROR_NONE)
+	{
+		return;
+	}
+#endif /* STL_USE_FINE_GRAINED_WATCHDOG */
+
+#if (STL_USE_MPU > 0u)
+	STL_TSSP_CPU_configure_mpu(&STL_mpu_profiles[rt_mpu_profile[index]], err);
+	if (*err != STL_ERROR_NONE)
+	{
+		return;
+	}
+	STL_TRACE(cpu, STL_TRACE_EV_SETUP, index, STL_TRACE_SETUP_MPU, rt_mpu_profile[index]);
+#endif /* STL_USE_MPU */
+
+#if (STL_USE_WATCHDOG > 0u)
+#if (STL_USE_FINE_GRAINED_WATCHDOG > 0u)
+	STL_TSSP_CSP_watchdog_start();
+	STL_TRACE(cpu, STL_TRACE_EV_WATCHDOG, index, STL_TRACE_WDG_ARM, rt_wdg_timeout[index]);
+#else
+	STL_TSSP_CSP_watchdog_reset();
+	STL_TRACE(cpu, STL_TRACE_EV_WATCHDOG, index, STL_TRACE_WDG_KICK, 0u);
+#endif /* STL_USE_FINE_GRAINED_WATCHDOG */
+#endif /* STL_USE_WATCHDOG */
+
+#if (STL_USE_SW_WATCHDOG > 0u)
+	STL_TRACE(cpu, STL_TRACE_EV_WATCHDOG, index, STL_TRACE_WDG_ARM, rt_budget[index]);
+#endif /* STL_USE_SW_WATCHDOG */
+	STL_TRACE(cpu, STL_TRACE_EV_TEST_START, index, STL_TRACE_RUNTIME, 0u);
+#if (STL_USE_PMU > 0u)
+	/* Sampled as close as possible to the test, after the setup and before the teardown */
+	STL_TSSP_CPU_pmu_read(&pmu_before);
+#endif /* STL_USE_PMU */
+#if (STL_USE_SW_WATCHDOG > 0u)
+	signature = STL_sw_wdg_run(cpu, test, rt_budget[index], err);
+#else
+	signature = test();
+#endif /* STL_USE_SW_WATCHDOG */
+#if (STL_USE_PMU > 0u)
+	STL_TSSP_CPU_pmu_read(&pmu_after);
+#endif /* STL_USE_PMU */
+	STL_TRACE(cpu, STL_TRACE_EV_TEST_STOP, index, STL_TRACE_RUNTIME, signature);
+
+#if (STL_USE_REDUNDANCY > 0u)
+	if (rt_redundancy[index] != STL_REDUNDANCY_NONE && *err == STL_ERROR_NONE &&
+		STL_redundancy_exchange(cpu, index, rt_redundancy[index], signature) == STL_FALSE)
+	{
+		STL_TRACE(cpu, STL_TRACE_EV_TEST_START, index, STL_TRACE_RUNTIME, 0u);
+#if (STL_USE_SW_WATCHDOG > 0u)
+		repeated = STL_sw_wdg_run(cpu, test, rt_budget[index], err);
+#else
+		repeated = test();
+#endif /* STL_USE_SW_WATCHDOG */
+		STL_TRACE(cpu, STL_TRACE_EV_TEST_STOP, index, STL_TRACE_RUNTIME, repeated);
+		if (*err == STL_ERROR_NONE)
+		{
+			STL_redundancy_compare(cpu, index, signature, repeated);
+		}
+	}
+#endif /* STL_USE_REDUNDANCY */
+
+#if (STL_USE_WATCHDOG > 0u)
+#if (STL_USE_FINE_GRAINED_WATCHDOG > 0u)
+	STL_TSSP_CSP_watchdog_stop();
+#else
+	STL_TSSP_CSP_watchdog_reset();
+	STL_TRACE(cpu, STL_TRACE_EV_WATCHDOG, index, STL_TRACE_WDG_KICK, 0u);
+#endif /* STL_USE_FINE_GRAINED_WATCHDOG */
+#endif /* STL_USE_WATCHDOG */
+
+#if (STL_USE_MPU > 0u)
+	STL_TSSP_CPU_configure_mpu(&STL_mpu_profiles[STL_MPU_PROFILE_APPLICATION], &mpu_err);
+	STL_TRACE(cpu, STL_TRACE_EV_RESTORE, index, STL_TRACE_SETUP_MPU, STL_MPU_PROFILE_APPLICATION);
+#endif /* STL_USE_MPU */
+
+#if (STL_USE_PMU > 0u)
+	/* Aborted tests are accounted too: their counts show where the budget went */
+	STL_em_ctx_update_pmu(ctx, index, &pmu_before, &pmu_after, cpu, &pmu_err);
+#endif /* STL_USE_PMU */
+
+#if (STL_USE_SW_WATCHDOG > 0u)
+	if (*err == STL_ERROR_TIMEOUT)
+	{
+		STL_TRACE(cpu, STL_TRACE_EV_WATCHDOG, index, STL_TRACE_WDG_EXPIRE, rt_budget[index]);
+		STL_em_ctx_update_timeout(ctx, index, cpu, err);
+		return;
+	}
+#endif /* STL_USE_SW_WATCHDOG */
+
+	STL_em_ctx_update_sig(ctx, index, signature, cpu, err);
+}
+
+/**
+ * @brief Dispatches a single runtime test and records its verdict.
+ *
+ * When the synchronized windows are enabled, a flagged test is executed once all the
+ * participating CPUs have reached it, and the CPUs wait for each other again after it. The
+ * window is entered before any step that can skip the test (throttle, overlay load,
+ * isolation) and left on every path, so that a CPU that defers or fails the test does not
+ * make the others time out. A CPU that times out at the entry does not run the test and
+ * records a timeout verdict; a timeout at the exit is only traced.
+ *
+ * @param ctx Context recording the verdict
+ * @param cpu CPU number (not used in single core)
+ * @param index Index of the test
+ * @param test Test routine (in place)
+ * @param err Error code
+ * @return None
+ */
+STATIC_KEYWORD INLINE_KEYWORD void STL_scheduler_dispatch_runtime(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_SIZE_T index,
+																  STL_FUNCT_PTR_T test, STL_ERROR_T *err)
+{
+#if (STL_USE_SYNC_WINDOW > 0u)
+	STL_CYCLES_T sync_wait;
+
+	if (rt_sync_window[index] == STL_TRUE)
+	{
+		if (STL_sync_enter(cpu, index, &sync_wait) == STL_FALSE)
+		{
+			STL_TRACE(cpu, STL_TRACE_EV_SYNC, index, STL_TRACE_SYNC_ENTER_TIMEOUT, sync_wait);
+			STL_em_ctx_update_timeout(ctx, index, cpu, err);
+			return;
+		}
+		STL_TRACE(cpu, STL_TRACE_EV_SYNC, index, STL_TRACE_SYNC_ENTER, sync_wait);
+
+		STL_scheduler_execute_runtime(ctx, cpu, index, test, err);
+
+		/* Its verdict is recorded whether the others leave with it or not */
+		if (STL_sync_leave(cpu, index, &sync_wait) == STL_TRUE)
+		{
+			STL_TRACE(cpu, STL_TRACE_EV_SYNC, index, STL_TRACE_SYNC_LEAVE, sync_wait);
+		}
+		else
+		{
+			STL_TRACE(cpu, STL_TRACE_EV_SYNC, index, STL_TRACE_SYNC_LEAVE_TIMEOUT, sync_wait);
+		}
+		return;
+	}
+#endif /* STL_USE_SYNC_WINDOW */
+
+	STL_scheduler_execute_runtime(ctx, cpu, index, test, err);
+}
+
 #if (STL_SCHEDULER_TYPE == 0u)
 /**
- * @brief Sequential SBST scheduler for runtime tests
+ * @brief Runs all runtime tests of a routine table in sequence (single core).
  *
- * This scheduler executes all runtime tests sequentially.
+ * The loop has a fixed trip count and is unrolled by STL_RT_DISPATCH_UNROLL. It is always
+ * inlined, so that with a constant table each unrolled step calls its routine directly.
  *
+ * @param ctx Context holding the results
+ * @param routines Routine table
  * @param err Error code
  * @return None
  */
-STATIC_KEYWORD void STL_scheduler_runtime_singlecore(STL_ERROR_T *err)
+STATIC_KEYWORD ALWAYS_INLINE_KEYWORD void STL_scheduler_runtime_sequence(STL_CONTEXT_T *ctx,
+																		 const STL_FUNCT_PTR_T *routines,
+																		 STL_ERROR_T *err)
 {
 	STL_SIZE_T i;
-	STL_SIGNATURE_T signature;
 
+	STL_UNROLL(STL_RT_DISPATCH_UNROLL)
 	for (i = 0; i < STL_TOT_RT_ROUTINE; i++)
 	{
-		signature = SBST_RT[i]();
-		STL_em_update_sig(i, signature, err);
+		STL_scheduler_dispatch_runtime(ctx, 0u, i, routines[i], err);
 
 		if (*err != STL_ERROR_NONE)
 		{
@@ -222,26 +503,52 @@ STATIC_KEYWORD void STL_scheduler_runtime_singlecore(STL_ERROR_T *err)
 	}
 }
 
+#if (STL_MULTICORE_SOC == 0u)
+/**
+ * @brief Sequential SBST scheduler for runtime tests
+ *
+ * This scheduler executes all runtime tests sequentially.
+ * With constant routine tables the default context runs the routines of SBST_RT directly.
+ *
+ * @param ctx Context holding the routines and the results
+ * @param err Error code
+ * @return None
+ */
+STATIC_KEYWORD void STL_scheduler_runtime_singlecore(STL_CONTEXT_T *ctx, STL_ERROR_T *err)
+{
+#if (STL_CONST_TEST_TABLES > 0u)
+	if (ctx == &STL_default_context)
+	{
+		STL_scheduler_runtime_sequence(ctx, SBST_RT, err);
+		return;
+	}
+#endif /* STL_CONST_TEST_TABLES */
+	STL_scheduler_runtime_sequence(ctx, ctx->cfg.rt_routines, err);
+}
+#endif /* STL_MULTICORE_SOC */
+
 #elif (STL_SCHEDULER_TYPE == 1u)
+#if (STL_MULTICORE_SOC == 0u)
 /**
  * @brief Chunk-based SBST scheduler for runtime tests
  *
  * This scheduler executes runtime tests in chunks, allowing partial execution
- * of the test set in each scheduling cycle.
+ * of the test set in each scheduling cycle. Each call runs up to ctx->cfg.rt_chunk
+ * tests from the cursor of the context; the cursor goes back to the first test
+ * once the last one has run.
  *
+ * @param ctx Context holding the routines, the chunk size, the cursor and the results
  * @param err Error code
  * @return None
  */
-STATIC_KEYWORD void STL_scheduler_runtime_singlecore(STL_ERROR_T *err)
+STATIC_KEYWORD void STL_scheduler_runtime_singlecore(STL_CONTEXT_T *ctx, STL_ERROR_T *err)
 {
-	static STL_SIZE_T index = 0;
-	STL_SIZE_T i;
-	STL_SIGNATURE_T signature;
+	STL_SIZE_T *index = &ctx->cpu[0].rt_cursor;
+	STL_SIZE_T n;
 
-	for (i = index; i < STL_RT_CHUNK && index < STL_TOT_RT_ROUTINE; i++, index++)
+	for (n = 0; n < ctx->cfg.rt_chunk && *index < STL_TOT_RT_ROUTINE; n++, (*index)++)
 	{
-		signature = SBST_RT[i]();
-		STL_em_update_sig(i, signature, err);
+		STL_scheduler_dispatch_runtime(ctx, 0u, *index, ctx->cfg.rt_routines[*index], err);
 
 		if (*err != STL_ERROR_NONE)
 		{
@@ -249,11 +556,12 @@ STATIC_KEYWORD void STL_scheduler_runtime_singlecore(STL_ERROR_T *err)
 		}
 	}
 
-	if (index >= STL_TOT_RT_ROUTINE)
+	if (*index >= STL_TOT_RT_ROUTINE)
 	{
-		index = 0; // Reset index after completing all tests
+		*index = 0; // Reset index after completing all tests
 	}
 }
+#endif /* STL_MULTICORE_SOC */
 
 #elif (STL_SCHEDULER_TYPE == 2u)
 /**
@@ -281,15 +589,17 @@ WEAK_KEYWORD void STL_scheduler_runtime_singlecore(STL_ERROR_T *err)
  *
  * This scheduler executes all runtime tests sequentially for a specific CPU.
  *
+ * @param ctx Context holding the routines and the results
  * @param cpu CPU number
  * @param err Error code
  * @return None
  */
-STATIC_KEYWORD void STL_scheduler_runtime_multicore(STL_CPUS cpu, STL_ERROR_T *err)
+STATIC_KEYWORD void STL_scheduler_runtime_multicore(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_ERROR_T *err)
 {
+	const STL_FUNCT_PTR_T *routines = &ctx->cfg.rt_routines[cpu * STL_TOT_RT_ROUTINE];
 	STL_SIZE_T i;
-	STL_SIGNATURE_T signature;
 
+	STL_UNROLL(STL_DISPATCH_UNROLL)
 	for (i = 0; i < STL_TOT_RT_ROUTINE; i++)
 	{
 		/* Set test configuration */
@@ -300,8 +610,7 @@ STATIC_KEYWORD void STL_scheduler_runtime_multicore(STL_CPUS cpu, STL_ERROR_T *e
 		}
 
 		/* Execute test and update signature */
-		signature = SBST_RT[cpu][i]();
-		STL_em_update_sig(i, signature, cpu, err);
+		STL_scheduler_dispatch_runtime(ctx, cpu, i, routines[i], err);
 		if (*err != STL_ERROR_NONE)
 		{
 			return;
@@ -321,46 +630,47 @@ STATIC_KEYWORD void STL_scheduler_runtime_multicore(STL_CPUS cpu, STL_ERROR_T *e
  * @brief Chunk-based SBST scheduler for runtime tests (multicore)
  *
  * This scheduler executes runtime tests in chunks for a specific CPU, allowing
- * partial execution of the test set in each scheduling cycle.
+ * partial execution of the test set in each scheduling cycle. Each CPU has its
+ * own cursor in the context.
  *
+ * @param ctx Context holding the routines, the chunk size, the cursors and the results
  * @param cpu CPU number
  * @param err Error code
  * @return None
  */
-STATIC_KEYWORD void STL_scheduler_runtime_multicore(STL_CPUS cpu, STL_ERROR_T *err)
+STATIC_KEYWORD void STL_scheduler_runtime_multicore(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_ERROR_T *err)
 {
-	static STL_SIZE_T index[STL_MULTICORE_SOC] = {0}; // Static index for each CPU
-	STL_SIZE_T i;
-	STL_SIGNATURE_T signature;
+	const STL_FUNCT_PTR_T *routines = &ctx->cfg.rt_routines[cpu * STL_TOT_RT_ROUTINE];
+	STL_SIZE_T *index = &ctx->cpu[cpu].rt_cursor;
+	STL_SIZE_T n;
 
-	for (i = index[cpu]; i < STL_RT_CHUNK && index[cpu] < STL_TOT_RT_ROUTINE; i++, index[cpu]++)
+	for (n = 0; n < ctx->cfg.rt_chunk && *index < STL_TOT_RT_ROUTINE; n++, (*index)++)
 	{
 		/* Set test configuration */
-		STL_TSSP_set_test_config_runtime(cpu, i, err);
+		STL_TSSP_set_test_config_runtime(cpu, *index, err);
 		if (*err != STL_ERROR_NONE)
 		{
 			return;
 		}
 
 		/* Execute test and update signature */
-		signature = SBST_RT[cpu][i]();
-		STL_em_update_sig(i, signature, cpu, err);
+		STL_scheduler_dispatch_runtime(ctx, cpu, *index, routines[*index], err);
 		if (*err != STL_ERROR_NONE)
 		{
 			return;
 		}
 
 		/* Restore test configuration */
-		STL_TSSP_restore_test_config_runtime(cpu, i, err);
+		STL_TSSP_restore_test_config_runtime(cpu, *index, err);
 		if (*err != STL_ERROR_NONE)
 		{
 			return;
 		}
 	}
 
-	if (index[cpu] >= STL_TOT_RT_ROUTINE)
+	if (*index >= STL_TOT_RT_ROUTINE)
 	{
-		index[cpu] = 0; // Reset index after completing all tests
+		*index = 0; // Reset index after completing all tests
 	}
 }
 
@@ -384,89 +694,137 @@ WEAK_KEYWORD void STL_scheduler_runtime_multicore(STL_CPUS cpu, STL_ERROR_T *err
 
 #endif /* STL_SCHEDULER_TYPE */
 #endif /* STL_MULTICORE_SOC */
+
+/**
+ * @brief This function is used to schedule the runtime tests
+ * It selects the single-core or multi-core scheduler of the configured type.
+ * The custom schedulers (type 2) keep their signature without context: they record their
+ * results in the default context, and any other context is rejected with STL_ERROR_CONTEXT.
+ *
+ * @param ctx Context holding the routines and the results
+ * @param cpu CPU number (not used in single core)
+ * @param err Error code
+ * @return None
+ */
+void STL_scheduler_runtime(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_ERROR_T *err)
+{
+#if (STL_SCHEDULER_TYPE == 2u)
+	if (ctx != &STL_default_context)
+	{
+		*err = STL_ERROR_CONTEXT;
+		return;
+	}
+#if (STL_MULTICORE_SOC > 0u)
+	STL_scheduler_runtime_multicore(cpu, err);
+#else
+	(void)cpu;
+	STL_scheduler_runtime_singlecore(err);
+#endif /* STL_MULTICORE_SOC */
+#else
+#if (STL_MULTICORE_SOC > 0u)
+	STL_scheduler_runtime_multicore(ctx, cpu, err);
+#else
+	(void)cpu;
+	STL_scheduler_runtime_singlecore(ctx, err);
+#endif /* STL_MULTICORE_SOC */
+#endif /* STL_SCHEDULER_TYPE */
+}
 #endif /* STL_RUNTIME_TEST */
+
 /**
- * @brief This function schedules runtime tests.
+ * @brief This function schedules the runtime tests of a CPU in a context.
  * It determines whether to use single-core or multi-core scheduling based on the configuration.
  *
+ * @param ctx Context holding the routines, the cursors and the results
  * @param cpu CPU number (used only in multi-core configurations)
  * @param err Pointer to an error code variable
  * @return None
  */
-void STL_schedule_runtime(STL_CPUS cpu, STL_ERROR_T *err)
+void STL_ctx_schedule_runtime(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_ERROR_T *err)
 {
-	static STL_SIZE_T index = 0; // Static index for chunk-based scheduling
-	STL_SIZE_T i;
-	STL_SIGNATURE_T signature;
-
 	// Initialize error code to no error
 	*err = STL_ERROR_NONE;
 
 #if (STL_RUNTIME_TEST == 0u)
 	// If runtime tests are disabled, set error and return
+	(void)ctx;
+	(void)cpu;
 	*err = STL_NO_RT_ROUTINE;
 	return;
 #else
-
-#if (STL_MULTICORE_SOC > 0u)
-	// Multi-core configuration
-	if (cpu > STL_MULTICORE_SOC)
+	// Check if the CPU number is out of bounds
+	if (cpu >= STL_CONTEXT_CPUS)
 	{
-		// Check if the CPU number is out of bounds
 		*err = STL_CPU_OUT_OF_BOUNDS;
 		return;
 	}
-	// Call the multi-core runtime scheduler
-	STL_scheduler_runtime_multicore(cpu, err);
-#else
-	// Single-core configuration
-	(void)cpu; // Suppress unused parameter warning
-	STL_scheduler_runtime_singlecore(err);
-#endif /* STL_MULTICORE_SOC */
-
+	STL_scheduler_runtime(ctx, cpu, err);
 #endif /* STL_RUNTIME_TEST */
 }
 
 /**
- * @brief This function schedules boot-time tests.
- * It determines whether to use single-core or multi-core scheduling based on the configuration.
+ * @brief This function schedules runtime tests.
+ * It runs the runtime tests of a CPU in the default context.
  *
  * @param cpu CPU number (used only in multi-core configurations)
  * @param err Pointer to an error code variable
  * @return None
  */
-void STL_schedule_bootime(STL_CPUS cpu, STL_ERROR_T *err)
+void STL_schedule_runtime(STL_CPUS cpu, STL_ERROR_T *err)
 {
-	STL_SIZE_T i;
-	STL_SIGNATURE_T signature;
+	STL_ctx_schedule_runtime(&STL_default_context, cpu, err);
+}
 
+/**
+ * @brief This function schedules the boot-time tests of a CPU in a context.
+ * It determines whether to use single-core or multi-core scheduling based on the configuration.
+ *
+ * @param ctx Context holding the routines and the results
+ * @param cpu CPU number (used only in multi-core configurations)
+ * @param err Pointer to an error code variable
+ * @return None
+ */
+void STL_ctx_schedule_bootime(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_ERROR_T *err)
+{
 	// Initialize error code to no error
 	*err = STL_ERROR_NONE;
 
 #if (STL_BOOT_TEST == 0u)
 	// If boot-time tests are disabled, set error and return
+	(void)ctx;
+	(void)cpu;
 	*err = STL_NO_BT_ROUTINE;
 	return;
 #else
-
-#if (STL_MULTICORE_SOC > 0u)
-	// Multi-core configuration
-	if (cpu > STL_MULTICORE_SOC)
+	// Check if the CPU number is out of bounds
+	if (cpu >= STL_CONTEXT_CPUS)
 	{
-		// Check if the CPU number is out of bounds
 		*err = STL_CPU_OUT_OF_BOUNDS;
 		return;
 	}
+#if (STL_MULTICORE_SOC > 0u)
 	// Call the multi-core boot-time scheduler
-	STL_scheduler_bootime_multicore(cpu, err);
+	STL_scheduler_bootime(ctx, cpu, err);
 #else
 	// Single-core configuration
-	(void)cpu; // Suppress unused parameter warning
-	STL_scheduler_bootime_singlecore(err);
+	STL_scheduler_bootime_singlecore(ctx, err);
 #endif /* STL_MULTICORE_SOC */
 
 #endif /* STL_BOOT_TEST */
 }
 
+/**
+ * @brief This function schedules boot-time tests.
+ * It runs the boot-time tests of a CPU in the default context.
+ *
+ * @param cpu CPU number (used only in multi-core configurations)
+ * @param err Pointer to an error code variable
+ * @return None
+ */
+void STL_schedule_bootime(STL_CPUS cpu, STL_ERROR_T *err)
+{
+	STL_ctx_schedule_bootime(&STL_default_context, cpu, err);
+}
+
 #endif /*__STL_SCHEDULER__MODULE__*/
-#endif /*__STL__*/
\ No newline at end of file
+#endif /*__STL__*/
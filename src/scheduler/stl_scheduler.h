@@ -22,6 +22,7 @@
 
 #include "stl.h"
 #include "stl_cfg.h"
+#include "stl_context.h"
 #include "stl_types.h"
 #include "stl_tssp.h"
 
@@ -36,11 +37,12 @@ extern "C"
  * It is called by the main function to execute the bootime tests, sequentially.
  * It is used to schedule the bootime tests in a sequential manner for a given CPU (in case of multicore).
  *
+ * @param ctx Context holding the routines and the results
  * @param cpu CPU number (not used in single core)
  * @param err Error code
  * @return None
  */
-void STL_scheduler_bootime(STL_CPUS cpu, STL_ERROR_T *err);
+void STL_scheduler_bootime(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_ERROR_T *err);
 #endif /*STL_BOOT_TEST*/
 #if (STL_RUNTIME_TEST > 0u)
 /**
@@ -48,11 +50,12 @@ void STL_scheduler_bootime(STL_CPUS cpu, STL_ERROR_T *err);
  * It is called by the main function to execute the runtime tests, sequentially.
  * It is used to schedule the runtime tests in a sequential manner for a given CPU (in case of multicore).
  *
+ * @param ctx Context holding the routines and the results
  * @param cpu CPU number (not used in single core)
  * @param err Error code
  * @return None
  */
-void STL_scheduler_runtime(STL_CPUS cpu, STL_ERROR_T *err);
+void STL_scheduler_runtime(STL_CONTEXT_T *ctx, STL_CPUS cpu, STL_ERROR_T *err);
 #endif /*STL_RUNTIME_TEST*/
 
 #ifdef __cplusplus
@@ -0,0 +1,210 @@
+#if __STL__
+
+/**
+ * @file stl_scrub.c
+ * @brief Implementation of the STL integrity scrubber.
+ *
+ * The scrubber walks the regions in order with a cursor (region, offset) and a running
+ * CRC-32C state. Each step feeds up to STL_SCRUB_CHUNK_BYTES bytes to the CRC; when a region
+ * is complete, its CRC is compared with the reference value and the cursor moves to the next
+ * region. Wrapping around the last region completes a sweep.
+ *
+ * The CRC uses the accelerated STL_crc32c_update (crc32 instruction on x86_64, table-driven
+ * elsewhere), so the cost of a step is bounded by the chunk size.
+ *
+ * @see stl_scrub.h
+ * @see stl_crc.h
+ */
+
+#ifndef __STL_SCRUB_MODULE__
+#define __STL_SCRUB_MODULE__
+
+#include "stl_scrub.h"
+#include "stl_crc.h"
+#include "stl_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+#if (STL_USE_SCRUB > 0u)
+
+/**
+ * @typedef STL_SCRUB_T
+ * @brief State of the scrubber.
+ *
+ * @var STL_SCRUB_T::regions
+ * Regions to check (STL_NULL until initialized).
+ * @var STL_SCRUB_T::count
+ * Number of regions.
+ * @var STL_SCRUB_T::expected
+ * Reference CRC of each region.
+ * @var STL_SCRUB_T::region
+ * Region under check.
+ * @var STL_SCRUB_T::offset
+ * Offset of the next byte to check in the region.
+ * @var STL_SCRUB_T::crc
+ * Running CRC state of the region.
+ * @var STL_SCRUB_T::sweep_start
+ * Cycle counter value at the first step of the sweep.
+ * @var STL_SCRUB_T::sweep_steps
+ * Steps of the sweep in progress.
+ * @var STL_SCRUB_T::sweep_busy
+ * Cycles spent in the steps of the sweep in progress.
+ * @var STL_SCRUB_T::stats
+ * Statistics of the completed sweeps.
+ */
+typedef struct
+{
+	const STL_SCRUB_REGION_T *regions;
+	STL_SIZE_T count;
+	STL_INT32U_T expected[STL_SCRUB_MAX_REGIONS];
+	STL_SIZE_T region;
+	STL_INT32U_T offset;
+	STL_INT32U_T crc;
+	STL_CYCLES_T sweep_start;
+	STL_INT32U_T sweep_steps;
+	STL_CYCLES_T sweep_busy;
+	STL_SCRUB_STATS_T stats;
+} STL_SCRUB_T;
+
+STATIC_KEYWORD STL_SCRUB_T scrub;
+
+/**
+ * @brief Initializes the scrubber.
+ *
+ * @param regions Regions to check
+ * @param count Number of regions
+ * @param err Error code
+ * @return None
+ */
+void STL_scrub_init(const STL_SCRUB_REGION_T *regions, STL_SIZE_T count, STL_ERROR_T *err)
+{
+	STL_SIZE_T i;
+
+	if (count > STL_SCRUB_MAX_REGIONS || (count > 0u && regions == STL_NULL))
+	{
+		*err = STL_INDEX_OUT_OF_BOUNDS;
+		return;
+	}
+
+	scrub.regions = regions;
+	scrub.count = count;
+	scrub.stats.sweep_bytes = 0u;
+	for (i = 0u; i < count; i++)
+	{
+#if (STL_SCRUB_BASELINE > 0u)
+		scrub.expected[i] = STL_CRC32C_FINAL(STL_crc32c_update(STL_CRC32C_INIT, regions[i].start, regions[i].size));
+#else
+		scrub.expected[i] = regions[i].crc;
+#endif /*STL_SCRUB_BASELINE*/
+		scrub.stats.sweep_bytes += regions[i].size;
+	}
+	scrub.region = 0u;
+	scrub.offset = 0u;
+	scrub.crc = STL_CRC32C_INIT;
+	scrub.sweep_steps = 0u;
+	scrub.sweep_busy = 0u;
+	scrub.stats.sweeps = 0u;
+	scrub.stats.mismatches = 0u;
+	scrub.stats.last_failed_region = 0u;
+	scrub.stats.sweep_steps = 0u;
+	scrub.stats.sweep_busy_cycles = 0u;
+	scrub.stats.sweep_time_cycles = 0u;
+	scrub.stats.max_step_cycles = 0u;
+	*err = STL_ERROR_NONE;
+}
+
+/**
+ * @brief Scrub pseudo-test: checks the next chunk of the regions.
+ *
+ * @return STL_SIGNATURE_MISMATCH if a region checked during this step is corrupted,
+ *         STL_SCRUB_SIGNATURE otherwise
+ */
+STL_SIGNATURE_T STL_scrub_test(void)
+{
+	STL_SIGNATURE_T signature = STL_SCRUB_SIGNATURE;
+	STL_INT32U_T budget = STL_SCRUB_CHUNK_BYTES;
+	STL_CYCLES_T start;
+	STL_CYCLES_T cycles;
+
+	if (scrub.count == 0u)
+	{
+		return signature;
+	}
+
+	start = STL_TSSP_CPU_get_cycles();
+	if (scrub.sweep_steps == 0u)
+	{
+		scrub.sweep_start = start;
+	}
+	scrub.sweep_steps++;
+
+	while (budget > 0u)
+	{
+		const STL_SCRUB_REGION_T *region = &scrub.regions[scrub.region];
+		STL_INT32U_T n = region->size - scrub.offset;
+
+		if (n > budget)
+		{
+			n = budget;
+		}
+		scrub.crc = STL_crc32c_update(scrub.crc, (const uint8_t *)region->start + scrub.offset, n);
+		scrub.offset += n;
+		budget -= n;
+		if (scrub.offset < region->size)
+		{
+			break;
+		}
+
+		/* Region complete */
+		if (STL_CRC32C_FINAL(scrub.crc) != scrub.expected[scrub.region])
+		{
+			scrub.stats.mismatches++;
+			scrub.stats.last_failed_region = scrub.region;
+			signature = STL_SIGNATURE_MISMATCH;
+		}
+		scrub.crc = STL_CRC32C_INIT;
+		scrub.offset = 0u;
+		scrub.region++;
+		if (scrub.region == scrub.count)
+		{
+			/* Sweep complete: the next step starts a new one */
+			scrub.region = 0u;
+			break;
+		}
+	}
+
+	cycles = STL_TSSP_CPU_get_cycles() - start;
+	scrub.sweep_busy += cycles;
+	if (cycles > scrub.stats.max_step_cycles)
+	{
+		scrub.stats.max_step_cycles = cycles;
+	}
+	if (scrub.region == 0u && scrub.offset == 0u)
+	{
+		scrub.stats.sweeps++;
+		scrub.stats.sweep_steps = scrub.sweep_steps;
+		scrub.stats.sweep_busy_cycles = scrub.sweep_busy;
+		scrub.stats.sweep_time_cycles = STL_TSSP_CPU_get_cycles() - scrub.sweep_start;
+		scrub.sweep_steps = 0u;
+		scrub.sweep_busy = 0u;
+	}
+
+	return signature;
+}
+
+/**
+ * @brief Retrieves the statistics of the scrubber.
+ *
+ * @param stats Pointer to the statistics to fill
+ * @param err Error code
+ * @return None
+ */
+void STL_scrub_get_stats(STL_SCRUB_STATS_T *stats, STL_ERROR_T *err)
+{
+	*stats = scrub.stats;
+	*err = STL_ERROR_NONE;
+}
+
+#endif /*STL_USE_SCRUB*/
+#endif /*__STL_SCRUB_MODULE__*/
+#endif /*__STL__*/
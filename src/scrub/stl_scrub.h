@@ -0,0 +1,125 @@
+/**
+ * @file stl_scrub.h
+ * @brief Header file for the STL integrity scrubber.
+ *
+ * The verdicts of the SBSTs are only as good as the test code and the golden values they
+ * are compared with. The scrubber checks the STL code, read-only data and golden-value
+ * regions against reference CRC-32C values, a few bytes at a time, so that a corruption is
+ * detected within one sweep without ever paying for a full CRC in a single cycle.
+ *
+ * The scrubber runs as a pseudo-test: STL_scrub_test is registered in the runtime test
+ * table like any SBST, gets its own entry in the budget and watchdog tables, and checks
+ * STL_SCRUB_CHUNK_BYTES bytes per invocation. It returns STL_SIGNATURE_MISMATCH when a
+ * region completed during the invocation does not match its reference CRC.
+ *
+ * @details
+ * - STL_scrub_init: Registers the regions and, optionally, computes their reference CRCs.
+ * - STL_scrub_test: Checks the next chunk (pseudo-test entry point).
+ * - STL_scrub_get_stats: Returns the sweep count and the time to a full sweep.
+ *
+ * @note The regions must not change at run time (code, constants, relocated code in RAM).
+ *       The computed signatures (.stl_signature) are not scrubbed.
+ * @note A single scrubber serves the whole system: in multicore configurations it must be
+ *       scheduled on one core only.
+ */
+#if __STL__
+#ifndef __STL_SCRUB_H__
+#define __STL_SCRUB_H__
+
+#include "stl_cfg.h"
+#include "stl_types.h"
+
+#if (STL_USE_SCRUB > 0u)
+
+#define STL_SCRUB_SIGNATURE 0x5C2B5C2Bu /* Signature of a scrub step without mismatch */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /*__cplusplus*/
+
+	/**
+	 * @brief Region checked by the scrubber.
+	 *
+	 * @var STL_SCRUB_REGION_T::start
+	 * Start address of the region.
+	 * @var STL_SCRUB_REGION_T::size
+	 * Size of the region in bytes.
+	 * @var STL_SCRUB_REGION_T::crc
+	 * Build-time CRC-32C of the region (ignored when STL_SCRUB_BASELINE is set).
+	 */
+	typedef struct
+	{
+		const void *start;
+		STL_INT32U_T size;
+		STL_INT32U_T crc;
+	} STL_SCRUB_REGION_T;
+
+	/**
+	 * @brief Statistics of the scrubber.
+	 *
+	 * @var STL_SCRUB_STATS_T::sweeps
+	 * Number of full sweeps completed.
+	 * @var STL_SCRUB_STATS_T::mismatches
+	 * Number of region checks that did not match the reference CRC.
+	 * @var STL_SCRUB_STATS_T::last_failed_region
+	 * Index of the last region found corrupted.
+	 * @var STL_SCRUB_STATS_T::sweep_bytes
+	 * Number of bytes of a full sweep.
+	 * @var STL_SCRUB_STATS_T::sweep_steps
+	 * Number of invocations of the last full sweep.
+	 * @var STL_SCRUB_STATS_T::sweep_busy_cycles
+	 * Cycles spent checking during the last full sweep.
+	 * @var STL_SCRUB_STATS_T::sweep_time_cycles
+	 * Time to a full sweep: cycles elapsed between the first and the last step of the last sweep.
+	 * @var STL_SCRUB_STATS_T::max_step_cycles
+	 * Worst duration of a single step, in cycles.
+	 */
+	typedef struct
+	{
+		STL_INT32U_T sweeps;
+		STL_INT32U_T mismatches;
+		STL_SIZE_T last_failed_region;
+		STL_INT32U_T sweep_bytes;
+		STL_INT32U_T sweep_steps;
+		STL_CYCLES_T sweep_busy_cycles;
+		STL_CYCLES_T sweep_time_cycles;
+		STL_CYCLES_T max_step_cycles;
+	} STL_SCRUB_STATS_T;
+
+	/**
+	 * @brief Initializes the scrubber.
+	 * With STL_SCRUB_BASELINE, the reference CRC of each region is computed here (one full
+	 * sweep); call it once the code has been relocated and verified.
+	 *
+	 * @param regions Regions to check
+	 * @param count Number of regions (at most STL_SCRUB_MAX_REGIONS)
+	 * @param err Error code, set to STL_INDEX_OUT_OF_BOUNDS if there are too many regions
+	 * @return None
+	 */
+	void STL_scrub_init(const STL_SCRUB_REGION_T *regions, STL_SIZE_T count, STL_ERROR_T *err);
+
+	/**
+	 * @brief Scrub pseudo-test: checks the next STL_SCRUB_CHUNK_BYTES bytes of the regions.
+	 *
+	 * @return STL_SIGNATURE_MISMATCH if a region checked during this step is corrupted,
+	 *         STL_SCRUB_SIGNATURE otherwise
+	 */
+	STL_SIGNATURE_T STL_scrub_test(void);
+
+	/**
+	 * @brief Retrieves the statistics of the scrubber.
+	 *
+	 * @param stats Pointer to the statistics to fill
+	 * @param err Error code
+	 * @return None
+	 */
+	void STL_scrub_get_stats(STL_SCRUB_STATS_T *stats, STL_ERROR_T *err);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /*STL_USE_SCRUB*/
+#endif /*__STL_SCRUB_H__*/
+#endif /*__STL__*/
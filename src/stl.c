@@ -3,10 +3,23 @@
 #ifndef __STL_MODULE__
 #define __STL_MODULE__
 
+#include <string.h>
+
 #include "stl.h"
 #include "stl_cfg.h"
 #include "stl_tssp.h"
 #include "stl_sbst_cfg.h"
+#include "stl_context.h"
+#include "stl_error_management.h"
+#include "stl_sw_watchdog.h"
+#include "stl_trace.h"
+#include "stl_throttle.h"
+#include "stl_sync.h"
+#include "stl_redundancy.h"
+
+#if (STL_USE_ISA_DISPATCH > 0u)
+#include "stl_al_cpu.h"
+#endif /* STL_USE_ISA_DISPATCH */
 
 #if STL_RELOCATED
 
@@ -16,7 +29,47 @@
  * It is used to relocate the runtime test code from ROM into RAM.
  *
  */
-#include "stl_relocation.h"
+#include "stl_rt_relocation.h"
+
+#if STL_RELOCATION_TABLE
+#define STL_RELOCATION_BLOCKS STL_RELOCATION_MAX_BLOCKS /* Capacity of the DMA descriptor list */
+#define STL_RELOCATION_COUNT STL_relocation_table_size
+#else
+#define STL_RELOCATION_BLOCKS 1u
+#define STL_RELOCATION_COUNT 1u
+#endif /* STL_RELOCATION_TABLE */
+
+#if STL_USE_DMA
+#include "stl_crc.h"
+
+/**
+ * @brief Asynchronous relocation in progress.
+ *
+ * @var STL_RELOCATION_ASYNC_T::desc
+ * DMA descriptors, one per relocation block.
+ * @var STL_RELOCATION_ASYNC_T::crc
+ * Build-time CRC-32C of each block.
+ * @var STL_RELOCATION_ASYNC_T::count
+ * Number of blocks of the request.
+ * @var STL_RELOCATION_ASYNC_T::start
+ * Cycle counter value at the start of the request.
+ * @var STL_RELOCATION_ASYNC_T::pending
+ * Flag indicating that a request is running.
+ * @var STL_RELOCATION_ASYNC_T::stats
+ * Overlap achieved by the last request.
+ */
+typedef struct
+{
+	STL_TSSP_DMA_DESC_T desc[STL_RELOCATION_BLOCKS];
+	STL_INT32U_T crc[STL_RELOCATION_BLOCKS];
+	STL_SIZE_T count;
+	STL_CYCLES_T start;
+	STL_BOOL pending;
+	STL_RELOCATION_STATS_T stats;
+} STL_RELOCATION_ASYNC_T;
+
+STATIC_KEYWORD STL_RELOCATION_ASYNC_T relocation_async;
+#endif /* STL_USE_DMA */
 
 #endif /* STL_RELOCATED */
 
@@ -26,9 +79,16 @@
  *
  * This array contains pointers to the boot test routines.
  * It is used to call the boot tests during the boot process.
- * The array is indexed by the STL_TOT_BT_ROUTINE enum.
+ * The array is indexed by the STL_TOT_BT_ROUTINE enum (STL_TOT_BT_ROUTINE entries per CPU).
+ * With STL_CONST_TEST_TABLES it is fixed at build time (STL_BT_ROUTINE_TABLE).
  */
-STL_FUNCT_PTR_T SBST_BT[STL_TOT_BT_ROUTINE];
+#if (STL_CONST_TEST_TABLES > 0u)
+const STL_FUNCT_PTR_T SBST_BT[STL_CONTEXT_CPUS * STL_TOT_BT_ROUTINE] = STL_BT_ROUTINE_TABLE;
+STL_STATIC_ASSERT(STL_INIT_ENTRIES(SBST_BT, STL_BT_ROUTINE_TABLE) == STL_CONTEXT_CPUS * STL_TOT_BT_ROUTINE,
+				  "STL_BT_ROUTINE_TABLE needs STL_TOT_BT_ROUTINE entries per CPU");
+#else
+STL_FUNCT_PTR_T SBST_BT[STL_CONTEXT_CPUS * STL_TOT_BT_ROUTINE];
+#endif /* STL_CONST_TEST_TABLES */
 #endif /* STL_BOOT_TEST */
 
 #if STL_RUNTIME_TEST
@@ -37,15 +97,111 @@ STL_FUNCT_PTR_T SBST_BT[STL_TOT_BT_ROUTINE];
  *
  * This array contains pointers to the runtime test routines.
  * It is used to call the runtime tests during the runtime process.
- * The array is indexed by the STL_TOT_RT_ROUTINE enum.
+ * The array is indexed by the STL_TOT_RT_ROUTINE enum (STL_TOT_RT_ROUTINE entries per CPU).
+ * With STL_CONST_TEST_TABLES it is fixed at build time (STL_RT_ROUTINE_TABLE).
  */
-STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
+#if (STL_CONST_TEST_TABLES > 0u)
+const STL_FUNCT_PTR_T SBST_RT[STL_CONTEXT_CPUS * STL_TOT_RT_ROUTINE] = STL_RT_ROUTINE_TABLE;
+STL_STATIC_ASSERT(STL_INIT_ENTRIES(SBST_RT, STL_RT_ROUTINE_TABLE) == STL_CONTEXT_CPUS * STL_TOT_RT_ROUTINE,
+				  "STL_RT_ROUTINE_TABLE needs STL_TOT_RT_ROUTINE entries per CPU");
+#else
+STL_FUNCT_PTR_T SBST_RT[STL_CONTEXT_CPUS * STL_TOT_RT_ROUTINE];
+#endif /* STL_CONST_TEST_TABLES */
 #endif /* STL_RUNTIME_TEST */
 
+#if STL_RUNTIME_TEST
+#define STL_DEFAULT_RT_ROUTINES SBST_RT
+#else
+#define STL_DEFAULT_RT_ROUTINES STL_NULL
+#endif /* STL_RUNTIME_TEST */
+
+#if STL_BOOT_TEST
+#define STL_DEFAULT_BT_ROUTINES SBST_BT
+#else
+#define STL_DEFAULT_BT_ROUTINES STL_NULL
+#endif /* STL_BOOT_TEST */
+
+/**
+ * @brief Context of the API without context.
+ *
+ * It runs the routines of SBST_RT and SBST_BT with the chunk size of the configuration.
+ */
+STL_CONTEXT_T STL_default_context = {.cfg = {STL_DEFAULT_RT_ROUTINES, STL_DEFAULT_BT_ROUTINES, STL_TEST_CHUNK_SIZE}};
+
+#if (STL_USE_ISA_DISPATCH > 0u)
+/**
+ * @brief ISA extensions detected at STL_init.
+ */
+STATIC_KEYWORD STL_ISA_FEATURES_T isa_features;
+
+#if (STL_RUNTIME_TEST > 0u)
+/**
+ * @brief Variants of each runtime routine, from the widest ISA level to the baseline.
+ */
+STATIC_KEYWORD const STL_SBST_VARIANT_T rt_variants[STL_TOT_RT_ROUTINE][STL_SBST_MAX_VARIANTS] =
+	STL_RT_ROUTINE_VARIANTS;
+STL_STATIC_ASSERT(STL_INIT_ENTRIES(rt_variants, STL_RT_ROUTINE_VARIANTS) == STL_TOT_RT_ROUTINE,
+				  "STL_RT_ROUTINE_VARIANTS needs one entry per runtime routine");
+
+/**
+ * @brief Stand-in of a runtime routine without variant for the ISA of the CPU.
+ * @return STL_SIGNATURE_SKIPPED (the test reads as not run).
+ */
+STATIC_KEYWORD STL_SIGNATURE_T STL_sbst_skipped(void)
+{
+	return STL_SIGNATURE_SKIPPED;
+}
+
+/**
+ * @brief Fills SBST_RT with the variants the CPU can execute.
+ *
+ * Each routine gets its first variant whose extensions are all reported by the CPU port,
+ * on every CPU (the extensions are detected once, on the calling CPU).
+ */
+STATIC_KEYWORD void STL_isa_dispatch(void)
+{
+	STL_FUNCT_PTR_T routine;
+	STL_SIZE_T i;
+	STL_SIZE_T v;
+	STL_SIZE_T cpu;
+
+	for (i = 0; i < STL_TOT_RT_ROUTINE; i++)
+	{
+		routine = STL_sbst_skipped;
+		for (v = 0; v < STL_SBST_MAX_VARIANTS && rt_variants[i][v].routine != STL_NULL; v++)
+		{
+			if ((rt_variants[i][v].features & ~isa_features) == 0u)
+			{
+				routine = rt_variants[i][v].routine;
+				break;
+			}
+		}
+		for (cpu = 0; cpu < STL_CONTEXT_CPUS; cpu++)
+		{
+			SBST_RT[cpu * STL_TOT_RT_ROUTINE + i] = routine;
+		}
+	}
+}
+#endif /* STL_RUNTIME_TEST */
+
+/**
+ * @brief Returns the ISA extensions detected by STL_init.
+ *
+ * @return Mask of the STL_CPU_ISA_* extensions of the CPU port.
+ */
+STL_ISA_FEATURES_T STL_get_isa_features(void)
+{
+	return isa_features;
+}
+#endif /* STL_USE_ISA_DISPATCH */
+
 /**
  * @brief Initialize the STL module.
  *
- * This function initializes the STL module and its error management.
+ * This function initializes the STL module, its error management and,
+ * when enabled, the software deadline monitor, the memory bandwidth
+ * throttle, the synchronized test windows and the redundancy. With the ISA dispatch, the
+ * runtime routines are selected from the ISA extensions of the CPU.
  *
  * @param[out] err Pointer to error variable.
  */
@@ -57,6 +213,53 @@ void STL_init(STL_ERROR_T *err)
 	{
 		return;
 	}
+#if (STL_USE_SW_WATCHDOG > 0u)
+	STL_sw_wdg_init(err);
+	if (*err != STL_ERROR_NONE)
+	{
+		return;
+	}
+#endif /* STL_USE_SW_WATCHDOG */
+#if (STL_USE_THROTTLE > 0u)
+	STL_throttle_init(err);
+	if (*err != STL_ERROR_NONE)
+	{
+		return;
+	}
+#endif /* STL_USE_THROTTLE */
+#if (STL_USE_SYNC_WINDOW > 0u)
+	STL_sync_init(err);
+	if (*err != STL_ERROR_NONE)
+	{
+		return;
+	}
+#endif /* STL_USE_SYNC_WINDOW */
+#if (STL_USE_REDUNDANCY > 0u)
+	STL_redundancy_init(err);
+	if (*err != STL_ERROR_NONE)
+	{
+		return;
+	}
+#endif /* STL_USE_REDUNDANCY */
+#if (STL_USE_WATCHDOG > 0u && STL_USE_FINE_GRAINED_WATCHDOG == 0u)
+	/* The coarse watchdog runs for the whole STL lifetime and is kicked at the test boundaries */
+	STL_TSSP_CSP_watchdog_init(err);
+	if (*err != STL_ERROR_NONE)
+	{
+		return;
+	}
+	STL_TSSP_CSP_watchdog_start();
+#endif /* STL_USE_WATCHDOG */
+#if (STL_USE_PMU > 0u)
+	/* The events the core cannot count read as zero, the mask is not needed here */
+	(void)STL_TSSP_CPU_pmu_init(err);
+#endif /* STL_USE_PMU */
+#if (STL_USE_ISA_DISPATCH > 0u)
+	isa_features = STL_TSSP_CPU_get_isa_features();
+#if (STL_RUNTIME_TEST > 0u)
+	STL_isa_dispatch();
+#endif /* STL_RUNTIME_TEST */
+#endif /* STL_USE_ISA_DISPATCH */
 }
 
 /**
@@ -69,6 +272,19 @@ void STL_init(STL_ERROR_T *err)
 void STL_deinit(STL_ERROR_T *err)
 {
 	*err = STL_ERROR_NONE;
+#if (STL_USE_WATCHDOG > 0u && STL_USE_FINE_GRAINED_WATCHDOG == 0u)
+	STL_TSSP_CSP_watchdog_stop();
+#endif /* STL_USE_WATCHDOG */
+#if (STL_USE_PMU > 0u)
+	STL_TSSP_CPU_pmu_deinit();
+#endif /* STL_USE_PMU */
+#if (STL_USE_SW_WATCHDOG > 0u)
+	STL_sw_wdg_deinit(err);
+	if (*err != STL_ERROR_NONE)
+	{
+		return;
+	}
+#endif /* STL_USE_SW_WATCHDOG */
 	STL_em_deinit(err);
 	if (*err != STL_ERROR_NONE)
 	{
@@ -76,12 +292,112 @@ void STL_deinit(STL_ERROR_T *err)
 	}
 }
 
+/**
+ * @brief Initialize an STL context.
+ *
+ * The context is cleared and takes the given configuration; with no configuration it runs
+ * the routines of SBST_RT and SBST_BT with STL_TEST_CHUNK_SIZE tests per call, like the
+ * default context. Only the state of the context is initialized: the services shared by
+ * all the contexts (watchdogs, MPU, performance counters) are set up by STL_init.
+ * When a module keeping per-CPU state outside the contexts is compiled in, only
+ * STL_default_context is accepted.
+ *
+ * @param[out] ctx Context to initialize.
+ * @param[in] cfg Configuration of the context, or STL_NULL.
+ * @param[out] err Pointer to error variable (STL_ERROR_CONTEXT on an invalid configuration,
+ *                 or on another context than STL_default_context with STL_CONTEXT_SHARED_CPU_STATE).
+ */
+void STL_context_init(STL_CONTEXT_T *ctx, const STL_CONTEXT_CFG_T *cfg, STL_ERROR_T *err)
+{
+	*err = STL_ERROR_NONE;
+	if (cfg != STL_NULL && cfg->rt_chunk == 0u)
+	{
+		*err = STL_ERROR_CONTEXT;
+		return;
+	}
+#if (STL_CONTEXT_SHARED_CPU_STATE > 0u)
+	/* The per-CPU state of these modules is not part of a context: a second one would share it */
+	if (ctx != &STL_default_context)
+	{
+		*err = STL_ERROR_CONTEXT;
+		return;
+	}
+#endif /* STL_CONTEXT_SHARED_CPU_STATE */
+	/* The entries of a context that was never used may hold any epoch */
+	memset(ctx, 0, sizeof(STL_CONTEXT_T));
+	if (cfg != STL_NULL)
+	{
+		ctx->cfg = *cfg;
+	}
+	else
+	{
+		ctx->cfg.rt_routines = STL_DEFAULT_RT_ROUTINES;
+		ctx->cfg.bt_routines = STL_DEFAULT_BT_ROUTINES;
+		ctx->cfg.rt_chunk = STL_TEST_CHUNK_SIZE;
+	}
+	STL_em_ctx_init(ctx, err);
+}
+
+/**
+ * @brief Deinitialize an STL context.
+ *
+ * The results of the context are cleared; the context can be initialized again.
+ *
+ * @param[in,out] ctx Context to deinitialize.
+ * @param[out] err Pointer to error variable.
+ */
+void STL_context_deinit(STL_CONTEXT_T *ctx, STL_ERROR_T *err)
+{
+	*err = STL_ERROR_NONE;
+	STL_em_ctx_deinit(ctx, err);
+}
+
+#if STL_RELOCATED
+/**
+ * @brief Relocate one block and verify it against its build-time checksum.
+ *
+ * @param[in] index Index of the block (trace only).
+ * @param[in] src Source address (ROM).
+ * @param[in] dst Destination address (RAM).
+ * @param[in] size Size of the block in bytes.
+ * @param[in] crc Build-time CRC-32C of the block.
+ * @param[out] err Pointer to error variable.
+ */
+STATIC_KEYWORD void STL_relocate_block(STL_SIZE_T index, const void *src, void *dst, STL_INT32U_T size,
+									   STL_INT32U_T crc, STL_ERROR_T *err)
+{
+	STL_INT32U_T copied_crc;
+
+	STL_TRACE(0u, STL_TRACE_EV_RELOCATION, index, STL_TRACE_RELOCATION_START, size);
+	copied_crc = STL_TSSP_CPU_relocate(src, dst, size, err);
+	if (*err != STL_ERROR_NONE)
+	{
+		STL_TRACE(0u, STL_TRACE_EV_RELOCATION, index, STL_TRACE_RELOCATION_FAIL, 0u);
+		return;
+	}
+#if (STL_RELOCATION_VERIFY > 0u)
+	if (copied_crc != crc)
+	{
+		*err = STL_ERROR_RELOCATION_CRC;
+	}
+#endif /* STL_RELOCATION_VERIFY */
+	STL_TRACE(0u, STL_TRACE_EV_RELOCATION, index,
+			  (*err == STL_ERROR_NONE) ? STL_TRACE_RELOCATION_DONE : STL_TRACE_RELOCATION_FAIL, copied_crc);
+#if (STL_RELOCATION_VERIFY == 0u)
+	(void)copied_crc;
+	(void)crc;
+#endif /* STL_RELOCATION_VERIFY */
+}
+#endif /* STL_RELOCATED */
+
 /**
  * @brief Relocate runtime test code.
  *
  * This function relocates the runtime test code from ROM into RAM.
+ * Each block is copied and checksummed in a single pass by the CPU relocation service
+ * and, when STL_RELOCATION_VERIFY is enabled, compared with its build-time CRC-32C.
  *
- * @param[out] err Pointer to error variable.
+ * @param[out] err Pointer to error variable (STL_ERROR_RELOCATION_CRC on a checksum mismatch).
  */
 void STL_relocate_runtime_tests(STL_ERROR_T *err)
 {
@@ -90,29 +406,186 @@ void STL_relocate_runtime_tests(STL_ERROR_T *err)
 #if STL_RELOCATION_TABLE
 
 	// Process each relocation entry from the table
-	for (size_t i = 0; i < sizeof(relocationTable) / sizeof(relocationTable[0]); i++)
+	for (STL_INT32U_T i = 0; i < STL_relocation_table_size; i++)
 	{
-		STL_TSSP_CPU_relocate(relocationTable[i].src, relocationTable[i].dst, relocationTable[i].size, err);
+		STL_relocate_block((STL_SIZE_T)i, STL_relocation_table[i].src, STL_relocation_table[i].dst,
+						   (STL_INT32U_T)STL_relocation_table[i].size, STL_relocation_table[i].crc, err);
 		if (*err != STL_ERROR_NONE)
 		{
 			return;
 		}
 	}
 #else
-	STL_ADDR_T *code_start = (STL_ADDR_T *)&__stl_ram_code_start__;
-	STL_ADDR_T *code_end = (STL_ADDR_T *)&__stl_ram_data_end__;
-	STL_INT32U_T size = code_end - code_start;
-	STL_TSSP_CPU_relocate(stl_src, code_start, size, err);
-	if (*err != STL_ERROR_NONE)
-	{
-		return;
-	}
+	/* Size in bytes of the RAM image, from the start of the code to the end of the data */
+	STL_INT32U_T size = (STL_INT32U_T)((uintptr_t)STL_RELOCATION_RAM_END - (uintptr_t)STL_RELOCATION_RAM_CODE);
+
+	STL_relocate_block(0u, STL_RELOCATION_ROM, STL_RELOCATION_RAM_CODE, size, STL_RELOCATION_CODE_CRC, err);
 #endif /* STL_RELOCATION_TABLE */
 #else
 	*err = STL_ERROR_NOT_IMPLEMENTED;
 #endif /* STL_RELOCATED */
 }
 
+#if (STL_RELOCATED && STL_USE_DMA)
+/**
+ * @brief Start the asynchronous relocation of the runtime tests.
+ *
+ * The relocation blocks are described to the DMA and the function returns immediately.
+ *
+ * @param[out] err Pointer to error variable (STL_ERROR_RELOCATION if a relocation is already running).
+ */
+void STL_relocate_runtime_tests_async(STL_ERROR_T *err)
+{
+	STL_SIZE_T i;
+
+	*err = STL_ERROR_NONE;
+	if (relocation_async.pending == STL_TRUE)
+	{
+		*err = STL_ERROR_RELOCATION;
+		return;
+	}
+
+	if (STL_RELOCATION_COUNT > STL_RELOCATION_BLOCKS)
+	{
+		*err = STL_ERROR_RELOCATION;
+		return;
+	}
+
+	relocation_async.stats.bytes = 0u;
+	relocation_async.count = (STL_SIZE_T)STL_RELOCATION_COUNT;
+#if STL_RELOCATION_TABLE
+	for (i = 0; i < relocation_async.count; i++)
+	{
+		relocation_async.desc[i].src = STL_relocation_table[i].src;
+		relocation_async.desc[i].dst = STL_relocation_table[i].dst;
+		relocation_async.desc[i].size = (STL_INT32U_T)STL_relocation_table[i].size;
+		relocation_async.crc[i] = STL_relocation_table[i].crc;
+		relocation_async.stats.bytes += relocation_async.desc[i].size;
+	}
+#else
+	(void)i;
+	relocation_async.desc[0].src = STL_RELOCATION_ROM;
+	relocation_async.desc[0].dst = STL_RELOCATION_RAM_CODE;
+	relocation_async.desc[0].size =
+		(STL_INT32U_T)((uintptr_t)STL_RELOCATION_RAM_END - (uintptr_t)STL_RELOCATION_RAM_CODE);
+	relocation_async.crc[0] = STL_RELOCATION_CODE_CRC;
+	relocation_async.stats.bytes = relocation_async.desc[0].size;
+#endif /* STL_RELOCATION_TABLE */
+
+	for (i = 0; i < relocation_async.count; i++)
+	{
+		STL_TRACE(0u, STL_TRACE_EV_RELOCATION, i, STL_TRACE_RELOCATION_START, relocation_async.desc[i].size);
+	}
+	relocation_async.start = STL_TSSP_CPU_get_cycles();
+	STL_TSSP_CSP_dma_start(relocation_async.desc, relocation_async.count, err);
+	if (*err != STL_ERROR_NONE)
+	{
+		return;
+	}
+	relocation_async.pending = STL_TRUE;
+}
+
+/**
+ * @brief Complete the asynchronous relocation once the DMA is done.
+ *
+ * Records the transfer time, verifies the blocks and synchronizes the instruction stream.
+ *
+ * @param[in] done_at Cycle counter value at the completion of the DMA.
+ * @param[out] err Pointer to error variable (STL_ERROR_RELOCATION_CRC on a checksum mismatch).
+ */
+STATIC_KEYWORD void STL_relocate_async_complete(STL_CYCLES_T done_at, STL_ERROR_T *err)
+{
+	STL_RELOCATION_STATS_T *stats = &relocation_async.stats;
+	STL_CYCLES_T start;
+	STL_SIZE_T i;
+
+	relocation_async.pending = STL_FALSE;
+	stats->transfer_cycles = done_at - relocation_async.start;
+	stats->overlap_cycles =
+		(stats->transfer_cycles > stats->wait_cycles) ? (stats->transfer_cycles - stats->wait_cycles) : 0u;
+
+	start = STL_TSSP_CPU_get_cycles();
+	for (i = 0; i < relocation_async.count; i++)
+	{
+		const STL_TSSP_DMA_DESC_T *desc = &relocation_async.desc[i];
+
+#if (STL_RELOCATION_VERIFY > 0u)
+		if (STL_CRC32C_FINAL(STL_crc32c_update(STL_CRC32C_INIT, desc->dst, desc->size)) != relocation_async.crc[i])
+		{
+			*err = STL_ERROR_RELOCATION_CRC;
+			STL_TRACE(0u, STL_TRACE_EV_RELOCATION, i, STL_TRACE_RELOCATION_FAIL, relocation_async.crc[i]);
+		}
+		else
+#endif /* STL_RELOCATION_VERIFY */
+		{
+			STL_TRACE(0u, STL_TRACE_EV_RELOCATION, i, STL_TRACE_RELOCATION_DONE, relocation_async.crc[i]);
+		}
+		STL_TSSP_CPU_sync_icache(desc->dst, desc->size);
+	}
+	stats->verify_cycles = STL_TSSP_CPU_get_cycles() - start;
+}
+
+/**
+ * @brief Check whether the asynchronous relocation is complete.
+ *
+ * @param[out] err Pointer to error variable (valid on completion).
+ * @return STL_TRUE when the relocation is complete (or none is running).
+ */
+STL_BOOL STL_relocate_runtime_tests_poll(STL_ERROR_T *err)
+{
+	STL_CYCLES_T done_at;
+
+	*err = STL_ERROR_NONE;
+	if (relocation_async.pending == STL_FALSE)
+	{
+		return STL_TRUE;
+	}
+	if (STL_TSSP_CSP_dma_poll(&done_at, err) == STL_FALSE)
+	{
+		return STL_FALSE;
+	}
+	relocation_async.stats.wait_cycles = 0u;
+	STL_relocate_async_complete(done_at, err);
+	return STL_TRUE;
+}
+
+/**
+ * @brief Wait for the completion of the asynchronous relocation.
+ *
+ * The cycles spent waiting for the DMA are accounted as non-overlapped transfer time.
+ *
+ * @param[out] err Pointer to error variable.
+ */
+void STL_relocate_runtime_tests_wait(STL_ERROR_T *err)
+{
+	STL_CYCLES_T start = STL_TSSP_CPU_get_cycles();
+	STL_CYCLES_T done_at;
+
+	*err = STL_ERROR_NONE;
+	if (relocation_async.pending == STL_FALSE)
+	{
+		return;
+	}
+	while (STL_TSSP_CSP_dma_poll(&done_at, err) == STL_FALSE)
+	{
+	}
+	relocation_async.stats.wait_cycles = (done_at > start) ? (done_at - start) : 0u;
+	STL_relocate_async_complete(done_at, err);
+}
+
+/**
+ * @brief Retrieve the overlap achieved by the last asynchronous relocation.
+ *
+ * @param[out] stats Pointer to the statistics to fill.
+ * @param[out] err Pointer to error variable.
+ */
+void STL_relocate_get_stats(STL_RELOCATION_STATS_T *stats, STL_ERROR_T *err)
+{
+	*err = STL_ERROR_NONE;
+	*stats = relocation_async.stats;
+}
+#endif /* STL_RELOCATED && STL_USE_DMA */
+
 /**
  * @brief Create an OS task for STL runtime.
  *
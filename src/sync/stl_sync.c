@@ -0,0 +1,317 @@
+#if __STL__
+
+/**
+ * @file stl_sync.c
+ * @brief Implementation of the STL synchronized test windows.
+ *
+ * The entry and the exit of a window are the same barrier, built on a single 32-bit word alone
+ * in its cache line, so that checking in is one compare-and-swap and the waiters spin on a line
+ * that is only written at the arrivals and at the release:
+ *
+ *   - bits 31..20: epoch, incremented by the release of the barrier;
+ *   - bits 19..8: tag of the open barrier, the index of the test and the phase (entry or exit);
+ *   - bits 7..0: CPUs checked in.
+ *
+ * The first CPU to check in opens the barrier with its tag, the next ones join it when their
+ * tag matches and wait for it to close otherwise (a CPU that is a window ahead). The last CPU
+ * releases the others by writing the next epoch with no CPU checked in; it is the only write
+ * the waiters observe. A waiter that times out withdraws its arrival while the epoch is
+ * unchanged, so that the barrier never holds the count of an abandoned window.
+ *
+ * @see stl_sync.h
+ */
+
+#ifndef __STL_SYNC_MODULE__
+#define __STL_SYNC_MODULE__
+
+#include "stl_sync.h"
+#include "stl_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+#if (STL_USE_SYNC_WINDOW > 0u)
+
+#include "stl_al_cpu.h"
+
+#if (STL_NUM_CPU > 255u)
+#error "The synchronized windows count at most 255 CPUs."
+#endif
+
+#define STL_SYNC_COUNT_MASK 0x000000FFu /* CPUs checked in */
+#define STL_SYNC_TAG_MASK 0x000FFF00u	/* Tag of the open barrier */
+#define STL_SYNC_TAG_SHIFT 8u
+#define STL_SYNC_EPOCH_MASK 0xFFF00000u /* Releases of the barrier (wraps) */
+#define STL_SYNC_EPOCH_ONE 0x00100000u
+
+#define STL_SYNC_PHASE_ENTER 0u
+#define STL_SYNC_PHASE_LEAVE 1u
+
+/* Tag of the entry or the exit of the window of a test */
+#define STL_SYNC_TAG(index, phase)                                                                                     \
+	(((((STL_INT32U_T)(index)) << 1 | (phase)) << STL_SYNC_TAG_SHIFT) & STL_SYNC_TAG_MASK)
+
+/**
+ * @typedef STL_SYNC_BARRIER_T
+ * @brief Barrier word and release time, alone in their cache line.
+ *
+ * @var STL_SYNC_BARRIER_T::state
+ * Epoch, tag and count (see the file description).
+ * @var STL_SYNC_BARRIER_T::released
+ * Cycle counter of the releasing CPU at the last release.
+ */
+typedef struct
+{
+	STL_INT32U_T state;
+	STL_CYCLES_T released;
+} ALIGNED_KEYWORD(STL_CACHE_LINE_SIZE) STL_SYNC_BARRIER_T;
+
+/**
+ * @typedef STL_SYNC_CONFIG_T
+ * @brief Configuration of the windows, read by all the CPUs and written by STL_sync_configure only.
+ *
+ * @var STL_SYNC_CONFIG_T::participants
+ * CPUs taking part in the windows.
+ * @var STL_SYNC_CONFIG_T::timeout
+ * Longest wait at a barrier, in cycles.
+ */
+typedef struct
+{
+	STL_INT32U_T participants;
+	STL_CYCLES_T timeout;
+} ALIGNED_KEYWORD(STL_CACHE_LINE_SIZE) STL_SYNC_CONFIG_T;
+
+/**
+ * @typedef STL_SYNC_CPU_T
+ * @brief Statistics of a CPU, only written by that CPU.
+ */
+typedef struct
+{
+	STL_SYNC_STATS_T stats;
+} ALIGNED_KEYWORD(STL_CACHE_LINE_SIZE) STL_SYNC_CPU_T;
+
+STATIC_KEYWORD STL_SYNC_BARRIER_T sync_barrier;
+STATIC_KEYWORD STL_SYNC_CONFIG_T sync_config;
+STATIC_KEYWORD STL_SYNC_CPU_T sync_cpu[STL_NUM_CPU];
+
+/**
+ * @brief Checks in at the barrier and waits for the other participants.
+ *
+ * @param tag Tag of the barrier
+ * @param wait Cycles waited
+ * @param wake Cycles between the release and its observation (0 for the releasing CPU)
+ * @return STL_TRUE when all the participants have checked in, STL_FALSE after a timeout
+ */
+STATIC_KEYWORD STL_BOOL STL_sync_barrier(STL_INT32U_T tag, STL_CYCLES_T *wait, STL_CYCLES_T *wake)
+{
+	STL_CYCLES_T start = STL_TSSP_CPU_get_cycles();
+	STL_CYCLES_T now;
+	STL_INT32U_T state = __atomic_load_n(&sync_barrier.state, __ATOMIC_RELAXED);
+	STL_INT32U_T next;
+	STL_INT32U_T epoch;
+
+	*wake = 0u;
+	/* Arrival: open the barrier or join it, wait while the barrier of another window is open */
+	for (;;)
+	{
+		if ((state & STL_SYNC_COUNT_MASK) == 0u)
+		{
+			next = (state & STL_SYNC_EPOCH_MASK) | tag | 1u;
+		}
+		else if ((state & STL_SYNC_TAG_MASK) == tag)
+		{
+			next = state + 1u;
+		}
+		else
+		{
+			now = STL_TSSP_CPU_get_cycles();
+			if (now - start > sync_config.timeout)
+			{
+				*wait = now - start;
+				return STL_FALSE;
+			}
+			STL_TSSP_CPU_relax();
+			state = __atomic_load_n(&sync_barrier.state, __ATOMIC_RELAXED);
+			continue;
+		}
+		if (__atomic_compare_exchange_n(&sync_barrier.state, &state, next, STL_FALSE, __ATOMIC_ACQ_REL,
+										__ATOMIC_RELAXED))
+		{
+			break;
+		}
+	}
+
+	epoch = next & STL_SYNC_EPOCH_MASK;
+	if ((next & STL_SYNC_COUNT_MASK) == sync_config.participants)
+	{
+		/* Last arrival: the release time is published with the release itself */
+		now = STL_TSSP_CPU_get_cycles();
+		sync_barrier.released = now;
+		__atomic_store_n(&sync_barrier.state, epoch + STL_SYNC_EPOCH_ONE, __ATOMIC_RELEASE);
+		*wait = now - start;
+		return STL_TRUE;
+	}
+
+	state = next;
+	while ((state & STL_SYNC_EPOCH_MASK) == epoch)
+	{
+		now = STL_TSSP_CPU_get_cycles();
+		if (now - start > sync_config.timeout)
+		{
+			/* Withdraw, unless the barrier is released meanwhile */
+			do
+			{
+				next = ((state & STL_SYNC_COUNT_MASK) == 1u) ? epoch : state - 1u;
+				if (__atomic_compare_exchange_n(&sync_barrier.state, &state, next, STL_FALSE, __ATOMIC_ACQUIRE,
+												__ATOMIC_ACQUIRE))
+				{
+					*wait = now - start;
+					return STL_FALSE;
+				}
+			} while ((state & STL_SYNC_EPOCH_MASK) == epoch);
+			break;
+		}
+		STL_TSSP_CPU_relax();
+		state = __atomic_load_n(&sync_barrier.state, __ATOMIC_ACQUIRE);
+	}
+	now = STL_TSSP_CPU_get_cycles();
+	*wake = now - sync_barrier.released;
+	*wait = now - start;
+	return STL_TRUE;
+}
+
+/**
+ * @brief Initializes the windows.
+ *
+ * @param err Error code
+ * @return None
+ */
+void STL_sync_init(STL_ERROR_T *err)
+{
+	STL_CPUS cpu;
+
+	for (cpu = 0u; cpu < STL_NUM_CPU; cpu++)
+	{
+		sync_cpu[cpu].stats = (STL_SYNC_STATS_T){0};
+	}
+	STL_sync_configure(STL_NUM_CPU, STL_SYNC_TIMEOUT_CYCLES, err);
+}
+
+/**
+ * @brief Changes the participants and the timeout.
+ *
+ * @param participants Number of CPUs taking part in the windows
+ * @param timeout_cycles Longest wait at the entry or the exit of a window, in cycles
+ * @param err Error code
+ * @return None
+ */
+void STL_sync_configure(STL_INT32U_T participants, STL_CYCLES_T timeout_cycles, STL_ERROR_T *err)
+{
+	if (participants == 0u || participants > STL_NUM_CPU)
+	{
+		*err = STL_CPU_OUT_OF_BOUNDS;
+		return;
+	}
+	if (timeout_cycles == 0u)
+	{
+		*err = STL_INDEX_OUT_OF_BOUNDS;
+		return;
+	}
+	sync_config.participants = participants;
+	sync_config.timeout = timeout_cycles;
+	__atomic_store_n(&sync_barrier.state, 0u, __ATOMIC_RELEASE);
+	*err = STL_ERROR_NONE;
+}
+
+/**
+ * @brief Enters the window of a test.
+ *
+ * @param cpu CPU number
+ * @param index Index of the test
+ * @param wait Cycles waited
+ * @return STL_TRUE if the test may run, STL_FALSE after a timeout
+ */
+STL_BOOL STL_sync_enter(STL_CPUS cpu, STL_SIZE_T index, STL_CYCLES_T *wait)
+{
+	STL_SYNC_STATS_T *stats = &sync_cpu[cpu].stats;
+	STL_CYCLES_T wake;
+
+	*wait = 0u;
+	if (cpu >= sync_config.participants)
+	{
+		return STL_TRUE;
+	}
+	if (STL_sync_barrier(STL_SYNC_TAG(index, STL_SYNC_PHASE_ENTER), wait, &wake) == STL_FALSE)
+	{
+		stats->timeouts++;
+		stats->wait_last = *wait;
+		return STL_FALSE;
+	}
+	stats->windows++;
+	stats->wait_total += *wait;
+	stats->wait_last = *wait;
+	if (*wait > stats->wait_max)
+	{
+		stats->wait_max = *wait;
+	}
+	stats->wake_last = wake;
+	if (wake > stats->wake_max)
+	{
+		stats->wake_max = wake;
+	}
+	return STL_TRUE;
+}
+
+/**
+ * @brief Leaves the window of a test.
+ *
+ * @param cpu CPU number
+ * @param index Index of the test
+ * @param wait Cycles waited
+ * @return STL_TRUE if the participants left together, STL_FALSE after a timeout
+ */
+STL_BOOL STL_sync_leave(STL_CPUS cpu, STL_SIZE_T index, STL_CYCLES_T *wait)
+{
+	STL_SYNC_STATS_T *stats = &sync_cpu[cpu].stats;
+	STL_CYCLES_T wake;
+	STL_BOOL together;
+
+	*wait = 0u;
+	if (cpu >= sync_config.participants)
+	{
+		return STL_TRUE;
+	}
+	together = STL_sync_barrier(STL_SYNC_TAG(index, STL_SYNC_PHASE_LEAVE), wait, &wake);
+	if (together == STL_FALSE)
+	{
+		stats->leave_timeouts++;
+	}
+	stats->leave_wait_last = *wait;
+	if (*wait > stats->leave_wait_max)
+	{
+		stats->leave_wait_max = *wait;
+	}
+	return together;
+}
+
+/**
+ * @brief Retrieves the statistics of the windows of a CPU.
+ *
+ * @param cpu CPU number
+ * @param stats Pointer to the statistics to fill
+ * @param err Error code
+ * @return None
+ */
+void STL_sync_get_stats(STL_CPUS cpu, STL_SYNC_STATS_T *stats, STL_ERROR_T *err)
+{
+	if (cpu >= STL_NUM_CPU)
+	{
+		*err = STL_CPU_OUT_OF_BOUNDS;
+		return;
+	}
+	*stats = sync_cpu[cpu].stats;
+	*err = STL_ERROR_NONE;
+}
+
+#endif /*STL_USE_SYNC_WINDOW*/
+#endif /*__STL_SYNC_MODULE__*/
+#endif /*__STL__*/
@@ -0,0 +1,146 @@
+/**
+ * @file stl_sync.h
+ * @brief Header file for the STL synchronized test windows (multicore).
+ *
+ * Some uncore and interconnect tests are only valid while every core is inside the STL: no
+ * core may be running application code that loads the interconnect or changes the state
+ * under test. The runtime tests flagged in STL_RT_ROUTINE_SYNC_WINDOW run in a window shared by
+ * the participating CPUs (the first participants CPUs):
+ *
+ *   - entry: each CPU checks in when the scheduler reaches the test, then spins on a barrier
+ *     until all the participants have checked in for the same test;
+ *   - test: each CPU runs its part of the test, the CPUs start within the wake-up latency of
+ *     the barrier;
+ *   - exit: each CPU checks out and spins until all the participants have finished their part,
+ *     so that the CPUs go back to the application together.
+ *
+ * A CPU that waits more than the timeout at the entry withdraws: the test is not run on this
+ * CPU and a timeout verdict is recorded. A timeout at the exit is only counted, the test
+ * has run. The barrier is left clean in both cases: the next window is not affected.
+ *
+ * For each CPU the module records the time it waited at the entry of the windows, on its own
+ * cycle counter: the largest wait of the CPUs in a window is the skew between the first and
+ * the last arrival, the scheduling of the flagged tests should keep it small. When the cycle
+ * counters of the CPUs share a time base (TSC on x86_64), the wake-up latency of the barrier
+ * is recorded too.
+ *
+ * @details
+ * - STL_sync_init: All the CPUs participate, with the build-time timeout.
+ * - STL_sync_configure: Changes the participants and the timeout.
+ * - STL_sync_enter / STL_sync_leave: Entry and exit of a window (called by the scheduler).
+ * - STL_sync_get_stats: Returns the windows, the timeouts and the waits of a CPU.
+ *
+ * @note The flagged tests must be scheduled in the same order on every participating CPU, and
+ *       should not be deferred by the throttle (no STL_RT_ROUTINE_MEM_BYTES): a CPU skipping a
+ *       window times the others out.
+ */
+#if __STL__
+#ifndef __STL_SYNC_H__
+#define __STL_SYNC_H__
+
+#include "stl_cfg.h"
+#include "stl_types.h"
+
+#if (STL_USE_SYNC_WINDOW > 0u)
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /*__cplusplus*/
+
+	/**
+	 * @brief Statistics of the synchronized windows of a CPU.
+	 *
+	 * @var STL_SYNC_STATS_T::windows
+	 * Windows entered.
+	 * @var STL_SYNC_STATS_T::timeouts
+	 * Windows abandoned at the entry (test not run).
+	 * @var STL_SYNC_STATS_T::leave_timeouts
+	 * Windows left alone after a timeout at the exit.
+	 * @var STL_SYNC_STATS_T::wait_total
+	 * Cycles waited at the entry of the windows entered.
+	 * @var STL_SYNC_STATS_T::wait_max
+	 * Longest wait at the entry of a window entered.
+	 * @var STL_SYNC_STATS_T::wait_last
+	 * Wait at the entry of the last window (0 for the last CPU to arrive).
+	 * @var STL_SYNC_STATS_T::leave_wait_max
+	 * Longest wait at the exit of a window.
+	 * @var STL_SYNC_STATS_T::leave_wait_last
+	 * Wait at the exit of the last window.
+	 * @var STL_SYNC_STATS_T::wake_max
+	 * Longest delay between the release of the entry barrier and its observation by the CPU.
+	 * @var STL_SYNC_STATS_T::wake_last
+	 * Delay of the last window (only meaningful with a common time base, 0 for the last CPU to arrive).
+	 */
+	typedef struct
+	{
+		STL_INT32U_T windows;
+		STL_INT32U_T timeouts;
+		STL_INT32U_T leave_timeouts;
+		STL_CYCLES_T wait_total;
+		STL_CYCLES_T wait_max;
+		STL_CYCLES_T wait_last;
+		STL_CYCLES_T leave_wait_max;
+		STL_CYCLES_T leave_wait_last;
+		STL_CYCLES_T wake_max;
+		STL_CYCLES_T wake_last;
+	} STL_SYNC_STATS_T;
+
+	/**
+	 * @brief Initializes the windows: all the CPUs participate, with STL_SYNC_TIMEOUT_CYCLES.
+	 *
+	 * @param err Error code
+	 * @return None
+	 */
+	void STL_sync_init(STL_ERROR_T *err);
+
+	/**
+	 * @brief Changes the participants and the timeout; no CPU may be inside a window.
+	 * The statistics are kept.
+	 *
+	 * @param participants Number of CPUs taking part in the windows, 1 to STL_NUM_CPU; the
+	 *                     other CPUs run the flagged tests without a window
+	 * @param timeout_cycles Longest wait at the entry or the exit of a window, in cycles
+	 * @param err Error code, set to STL_CPU_OUT_OF_BOUNDS for an invalid number of participants
+	 *            and to STL_INDEX_OUT_OF_BOUNDS for a null timeout
+	 * @return None
+	 */
+	void STL_sync_configure(STL_INT32U_T participants, STL_CYCLES_T timeout_cycles, STL_ERROR_T *err);
+
+	/**
+	 * @brief Enters the window of a test: waits for all the participants.
+	 *
+	 * @param cpu CPU number (not checked, called by the scheduler)
+	 * @param index Index of the test
+	 * @param wait Cycles waited
+	 * @return STL_TRUE if the test may run, STL_FALSE after a timeout (the CPU has withdrawn)
+	 */
+	STL_BOOL STL_sync_enter(STL_CPUS cpu, STL_SIZE_T index, STL_CYCLES_T *wait);
+
+	/**
+	 * @brief Leaves the window of a test: waits for all the participants to finish it.
+	 *
+	 * @param cpu CPU number (not checked, called by the scheduler)
+	 * @param index Index of the test
+	 * @param wait Cycles waited
+	 * @return STL_TRUE if the participants left together, STL_FALSE after a timeout
+	 */
+	STL_BOOL STL_sync_leave(STL_CPUS cpu, STL_SIZE_T index, STL_CYCLES_T *wait);
+
+	/**
+	 * @brief Retrieves the statistics of the windows of a CPU.
+	 *
+	 * @param cpu CPU number
+	 * @param stats Pointer to the statistics to fill
+	 * @param err Error code, set to STL_CPU_OUT_OF_BOUNDS for an invalid CPU
+	 * @return None
+	 */
+	void STL_sync_get_stats(STL_CPUS cpu, STL_SYNC_STATS_T *stats, STL_ERROR_T *err);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /*STL_USE_SYNC_WINDOW*/
+#endif /*__STL_SYNC_H__*/
+#endif /*__STL__*/
@@ -0,0 +1,23 @@
+#if __STL__
+
+/**
+ * @file stl_rt_relocation_table.c
+ * @brief Relocation table of the runtime tests.
+ *
+ * Default table: a single block, from the start of the relocated code to the end of the
+ * relocated data. Regenerate it from the linked image with scripts/gen_relocation_table.py.
+ */
+
+#include "stl_rt_relocation.h"
+
+#if (STL_RELOCATED > 0u && STL_RELOCATION_TABLE > 0u)
+
+STL_RELOCATION_TABLE_SECTION const STL_RelocationEntry_T STL_relocation_table[] = {
+	{STL_RELOCATION_ROM, STL_RELOCATION_RAM_CODE, (uintptr_t)(&__stl_ram_code_size__), STL_RELOCATION_CODE_CRC},
+};
+
+STL_RELOCATION_TABLE_SECTION const STL_INT32U_T STL_relocation_table_size = 1u;
+
+#endif /* STL_RELOCATED && STL_RELOCATION_TABLE */
+
+#endif /* __STL__ */
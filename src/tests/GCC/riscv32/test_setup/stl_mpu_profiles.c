@@ -0,0 +1,57 @@
+#if __STL__
+
+#include "stl_tssp.h"
+#include "stl_cfg.h"
+#include "stl_types.h"
+#include "stl_sbst_cfg.h"
+
+#ifndef _SBST_MPU_PROFILES_MODULE_
+#define _SBST_MPU_PROFILES_MODULE_
+/**
+ * @file stl_mpu_profiles.c
+ * @brief MPU profiles of the test classes.
+ * Each profile is a constant array of regions, programmed by STL_TSSP_CPU_configure_mpu.
+ * Regions that are common to several profiles should keep the same index, so that switching
+ * between the profiles does not rewrite them.
+ * @warning The memory map below is a template and should be modified to suit the target.
+ * @ingroup TSSP
+ */
+
+#if (STL_USE_MPU > 0u)
+#define STL_MPU_CODE_BASE 0x00000000u	   /* Code (flash) */
+#define STL_MPU_CODE_SIZE 0x00100000u
+#define STL_MPU_RAM_BASE 0x20000000u	   /* Application RAM */
+#define STL_MPU_RAM_SIZE 0x00040000u
+#define STL_MPU_SIGNATURE_BASE 0x2003F000u /* STL signature area */
+#define STL_MPU_SIGNATURE_SIZE 0x00001000u
+#define STL_MPU_TEST_WINDOW_BASE 0x20010000u /* Window of the intrusive memory tests */
+#define STL_MPU_TEST_WINDOW_SIZE 0x00010000u
+#define STL_MPU_PERIPH_BASE 0x40000000u	   /* Peripherals */
+#define STL_MPU_PERIPH_SIZE 0x20000000u
+
+STATIC_KEYWORD const STL_CPU_MPU_CFG_t mpu_application[] = {
+	{STL_MPU_CODE_BASE, STL_MPU_CODE_SIZE, STL_CPU_MPU_ACCESS_READ | STL_CPU_MPU_ACCESS_EXECUTE},
+	{STL_MPU_RAM_BASE, STL_MPU_RAM_SIZE, STL_CPU_MPU_ACCESS_READ | STL_CPU_MPU_ACCESS_WRITE},
+	{STL_MPU_PERIPH_BASE, STL_MPU_PERIPH_SIZE, STL_CPU_MPU_ACCESS_READ | STL_CPU_MPU_ACCESS_WRITE},
+};
+
+STATIC_KEYWORD const STL_CPU_MPU_CFG_t mpu_cpu[] = {
+	{STL_MPU_CODE_BASE, STL_MPU_CODE_SIZE, STL_CPU_MPU_ACCESS_READ | STL_CPU_MPU_ACCESS_EXECUTE},
+	{STL_MPU_SIGNATURE_BASE, STL_MPU_SIGNATURE_SIZE, STL_CPU_MPU_ACCESS_READ | STL_CPU_MPU_ACCESS_WRITE},
+};
+
+STATIC_KEYWORD const STL_CPU_MPU_CFG_t mpu_memory[] = {
+	{STL_MPU_CODE_BASE, STL_MPU_CODE_SIZE, STL_CPU_MPU_ACCESS_READ | STL_CPU_MPU_ACCESS_EXECUTE},
+	{STL_MPU_SIGNATURE_BASE, STL_MPU_SIGNATURE_SIZE, STL_CPU_MPU_ACCESS_READ | STL_CPU_MPU_ACCESS_WRITE},
+	{STL_MPU_TEST_WINDOW_BASE, STL_MPU_TEST_WINDOW_SIZE, STL_CPU_MPU_ACCESS_READ | STL_CPU_MPU_ACCESS_WRITE},
+};
+
+const STL_CPU_MPU_PROFILE_T STL_mpu_profiles[STL_MPU_NUM_PROFILES] = {
+	[STL_MPU_PROFILE_APPLICATION] = {mpu_application, sizeof(mpu_application) / sizeof(mpu_application[0])},
+	[STL_MPU_PROFILE_CPU] = {mpu_cpu, sizeof(mpu_cpu) / sizeof(mpu_cpu[0])},
+	[STL_MPU_PROFILE_MEMORY] = {mpu_memory, sizeof(mpu_memory) / sizeof(mpu_memory[0])},
+};
+#endif /*STL_USE_MPU*/
+
+#endif /*_SBST_MPU_PROFILES_MODULE_*/
+#endif /*__STL__*/
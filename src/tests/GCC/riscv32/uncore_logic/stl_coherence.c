@@ -0,0 +1,537 @@
+#if __STL__
+
+/**
+ * @file stl_coherence.c
+ * @brief Implementation of the atomic and coherence SBSTs (RISC-V).
+ *
+ * The shared state is laid out one object per cache line, so that each kind of atomic
+ * operation moves its own line between the cores: the barrier, the four counters hammered by
+ * the atomic operations, the token line, the line of the per-CPU words and the partial
+ * signature of each participant.
+ *
+ * The atomic operations are written with the A extension instructions: amoadd.w, amoor.w,
+ * amoand.w and amoswap.w, and LR/SC loops for the compare-and-swap and the increments, so that
+ * the test exercises both the AMO unit and the reservation logic whatever the compiler would
+ * emit for the C11 builtins. The failed store-conditionals are counted with the failed
+ * compare-and-swap attempts. The barrier is a sense-reversing barrier on a counter and a
+ * generation word.
+ *
+ * Each participant folds its observations of a round (participant number, final values of the
+ * counters and of the mask word, count of the checks that failed) into a CRC-32C: a fault-free
+ * round only depends on the number of participants, so the expected combined signature is
+ * computed once, at initialization.
+ *
+ * @see stl_coherence.h
+ */
+
+#ifndef __STL_COHERENCE_MODULE__
+#define __STL_COHERENCE_MODULE__
+
+#include <string.h>
+
+#include "stl_coherence.h"
+#include "stl_cfg.h"
+#include "stl_crc.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+#if (STL_USE_COHERENCE_TEST > 0u)
+
+#if !defined(__riscv_atomic)
+#error "The coherence SBSTs need the A extension."
+#endif
+
+/* Spin-wait hint of the barrier: pause (Zihintpause), a fence without effect on other cores */
+#define STL_COHERENCE_RELAX() __asm__ volatile(".insn i 0x0F, 0, x0, x0, 0x010")
+
+/* Pattern of the word of participant p in the shared line at iteration i */
+#define STL_COHERENCE_WORD(p, i) ((((STL_INT32U_T)(p) + 1u) << 24) ^ ((STL_INT32U_T)(i) * 0x9E3779B1u))
+
+/* Token of participant p at iteration i: unique and never 0 (the initial token) */
+#define STL_COHERENCE_TOKEN(p, i) ((((STL_INT32U_T)(p) + 1u) << 16) | ((STL_INT32U_T)(i) + 1u))
+
+/**
+ * @typedef STL_COHERENCE_LINE_T
+ * @brief Word alone in its cache line.
+ */
+typedef struct
+{
+	STL_INT32U_T value;
+} ALIGNED_KEYWORD(STL_CACHE_LINE_SIZE) STL_COHERENCE_LINE_T;
+
+/**
+ * @typedef STL_COHERENCE_SLOT_T
+ * @brief Result and statistics of a participant number, only written by the CPU holding it.
+ *
+ * @var STL_COHERENCE_SLOT_T::partial
+ * Partial signature of the participant.
+ * @var STL_COHERENCE_SLOT_T::tokens
+ * XOR of the tokens swapped in and of the tokens received by the participant.
+ * @var STL_COHERENCE_SLOT_T::faults
+ * Rounds found faulty by the participant.
+ * @var STL_COHERENCE_SLOT_T::timeouts
+ * Barriers timed out by the participant.
+ * @var STL_COHERENCE_SLOT_T::cas_retries
+ * Failed compare-and-swap attempts and store-conditionals of the participant.
+ * @var STL_COHERENCE_SLOT_T::wait_cycles
+ * Cycles waited by the participant at the barriers.
+ * @var STL_COHERENCE_SLOT_T::hammer_cycles
+ * Cycles spent by the participant in the atomic operations.
+ */
+typedef struct
+{
+	STL_SIGNATURE_T partial;
+	STL_INT32U_T tokens;
+	STL_INT32U_T faults;
+	STL_INT32U_T timeouts;
+	STL_CYCLES_T cas_retries;
+	STL_CYCLES_T wait_cycles;
+	STL_CYCLES_T hammer_cycles;
+} ALIGNED_KEYWORD(STL_CACHE_LINE_SIZE) STL_COHERENCE_SLOT_T;
+
+/**
+ * @typedef STL_COHERENCE_OBS_T
+ * @brief Observations of a participant folded into its partial signature.
+ */
+typedef struct
+{
+	STL_INT32U_T participant;
+	STL_INT32U_T added;
+	STL_INT32U_T compared;
+	STL_INT32U_T incremented;
+	STL_INT32U_T mask;
+	STL_INT32U_T errors;
+} STL_COHERENCE_OBS_T;
+
+/**
+ * @typedef STL_COHERENCE_T
+ * @brief Shared state of the coherence SBST.
+ *
+ * @var STL_COHERENCE_T::arrived
+ * CPUs arrived at the current barrier.
+ * @var STL_COHERENCE_T::generation
+ * Barriers completed; the waiting CPUs spin on it.
+ * @var STL_COHERENCE_T::broken
+ * A barrier timed out: the rounds fail until the next initialization.
+ * @var STL_COHERENCE_T::add
+ * Counter of the fetch-and-add operations.
+ * @var STL_COHERENCE_T::cas
+ * Counter of the compare-and-swap increments.
+ * @var STL_COHERENCE_T::inc
+ * Counter of the LR/SC increments.
+ * @var STL_COHERENCE_T::mask
+ * Mask word, one bit per participant.
+ * @var STL_COHERENCE_T::token
+ * Token exchanged by the participants.
+ * @var STL_COHERENCE_T::words
+ * Line of the per-CPU words.
+ * @var STL_COHERENCE_T::slot
+ * Results of the participants.
+ * @var STL_COHERENCE_T::participants
+ * CPUs taking part in each round (0: not initialized).
+ * @var STL_COHERENCE_T::rounds
+ * Rounds completed, counted by participant 0.
+ * @var STL_COHERENCE_T::expected
+ * Combined signature of a fault-free round.
+ */
+typedef struct
+{
+	STL_COHERENCE_LINE_T arrived;
+	STL_COHERENCE_LINE_T generation;
+	STL_COHERENCE_LINE_T broken;
+	STL_COHERENCE_LINE_T add;
+	STL_COHERENCE_LINE_T cas;
+	STL_COHERENCE_LINE_T inc;
+	STL_COHERENCE_LINE_T mask;
+	STL_COHERENCE_LINE_T token;
+	STL_INT32U_T words[STL_COHERENCE_MAX_CPUS] ALIGNED_KEYWORD(STL_CACHE_LINE_SIZE);
+	STL_COHERENCE_SLOT_T slot[STL_COHERENCE_MAX_CPUS];
+	STL_INT32U_T participants;
+	STL_INT32U_T rounds;
+	STL_SIGNATURE_T expected;
+} STL_COHERENCE_T;
+
+STATIC_KEYWORD STL_COHERENCE_T coherence;
+
+/**
+ * @brief amoadd.w: adds a value to a word and returns its previous value.
+ */
+STATIC_KEYWORD INLINE_KEYWORD STL_INT32U_T STL_coherence_fetch_add(STL_INT32U_T *word, STL_INT32U_T value)
+{
+	STL_INT32U_T old;
+
+	__asm__ volatile("amoadd.w.aqrl %0, %2, %1" : "=r"(old), "+A"(*word) : "r"(value) : "memory");
+	return old;
+}
+
+/**
+ * @brief LR/SC loop: replaces a word by desired if it holds expected.
+ *
+ * The loop is a single asm statement, so that nothing but the base instructions of a
+ * constrained LR/SC loop runs between the load-reserved and the store-conditional.
+ *
+ * @param retries Incremented for each failed store-conditional
+ * @return STL_TRUE if the word was replaced
+ */
+STATIC_KEYWORD INLINE_KEYWORD STL_BOOL STL_coherence_cas(STL_INT32U_T *word, STL_INT32U_T expected,
+														STL_INT32U_T desired, STL_CYCLES_T *retries)
+{
+	STL_INT32U_T old;
+	STL_INT32U_T failed;
+	STL_INT32U_T count = 0u;
+
+	__asm__ volatile("1:\n\t"
+					 "lr.w.aqrl %0, %3\n\t"
+					 "bne %0, %4, 2f\n\t"
+					 "sc.w.rl %1, %5, %3\n\t"
+					 "beqz %1, 2f\n\t"
+					 "addi %2, %2, 1\n\t"
+					 "j 1b\n"
+					 "2:"
+					 : "=&r"(old), "=&r"(failed), "+r"(count), "+A"(*word)
+					 : "r"(expected), "r"(desired)
+					 : "memory");
+	*retries += count;
+	return (old == expected) ? STL_TRUE : STL_FALSE;
+}
+
+/**
+ * @brief LR/SC loop: increments a word.
+ *
+ * @param retries Incremented for each failed store-conditional
+ */
+STATIC_KEYWORD INLINE_KEYWORD void STL_coherence_increment(STL_INT32U_T *word, STL_CYCLES_T *retries)
+{
+	STL_INT32U_T value;
+	STL_INT32U_T failed;
+	STL_INT32U_T count = 0u;
+
+	__asm__ volatile("1:\n\t"
+					 "lr.w.aqrl %0, %3\n\t"
+					 "addi %0, %0, 1\n\t"
+					 "sc.w.rl %1, %0, %3\n\t"
+					 "beqz %1, 2f\n\t"
+					 "addi %2, %2, 1\n\t"
+					 "j 1b\n"
+					 "2:"
+					 : "=&r"(value), "=&r"(failed), "+r"(count), "+A"(*word)
+					 :
+					 : "memory");
+	*retries += count;
+}
+
+/**
+ * @brief amoor.w: sets a bit of a word and returns its previous value.
+ */
+STATIC_KEYWORD INLINE_KEYWORD STL_INT32U_T STL_coherence_set_bit(STL_INT32U_T *word, STL_INT32U_T bit)
+{
+	STL_INT32U_T old;
+
+	__asm__ volatile("amoor.w.aqrl %0, %2, %1" : "=r"(old), "+A"(*word) : "r"(1u << bit) : "memory");
+	return (old >> bit) & 1u;
+}
+
+/**
+ * @brief amoand.w: clears a bit of a word and returns its previous value.
+ */
+STATIC_KEYWORD INLINE_KEYWORD STL_INT32U_T STL_coherence_clear_bit(STL_INT32U_T *word, STL_INT32U_T bit)
+{
+	STL_INT32U_T old;
+
+	__asm__ volatile("amoand.w.aqrl %0, %2, %1" : "=r"(old), "+A"(*word) : "r"(~(1u << bit)) : "memory");
+	return (old >> bit) & 1u;
+}
+
+/**
+ * @brief amoswap.w: swaps a value with a word and returns its previous value.
+ */
+STATIC_KEYWORD INLINE_KEYWORD STL_INT32U_T STL_coherence_swap(STL_INT32U_T *word, STL_INT32U_T value)
+{
+	STL_INT32U_T old;
+
+	__asm__ volatile("amoswap.w.aqrl %0, %2, %1" : "=r"(old), "+A"(*word) : "r"(value) : "memory");
+	return old;
+}
+
+/**
+ * @brief Folds the observations of a participant into its partial signature.
+ *
+ * @param obs Observations of the participant
+ * @return Partial signature
+ */
+STATIC_KEYWORD STL_SIGNATURE_T STL_coherence_fold(const STL_COHERENCE_OBS_T *obs)
+{
+	return (STL_SIGNATURE_T)STL_crc32c_update(STL_COHERENCE_SIGNATURE, obs, sizeof(*obs));
+}
+
+/**
+ * @brief Waits until all the participants have arrived at the barrier.
+ *
+ * @param p Participant number of the CPU; at the first barrier of a round, receives the order
+ *          of arrival of the CPU
+ * @return STL_FALSE if the barrier timed out or was aborted by another CPU
+ */
+STATIC_KEYWORD STL_BOOL STL_coherence_barrier(STL_INT32U_T *p)
+{
+	STL_INT32U_T generation = __atomic_load_n(&coherence.generation.value, __ATOMIC_ACQUIRE);
+	STL_CYCLES_T start = STL_TSSP_CPU_get_cycles();
+	STL_INT32U_T arrived = STL_coherence_fetch_add(&coherence.arrived.value, 1u);
+	STL_COHERENCE_SLOT_T *slot;
+	STL_BOOL done = STL_TRUE;
+
+	if (arrived >= coherence.participants)
+	{
+		/* More CPUs than participants run the test */
+		__atomic_store_n(&coherence.broken.value, 1u, __ATOMIC_RELEASE);
+		return STL_FALSE;
+	}
+	if (*p == STL_COHERENCE_MAX_CPUS)
+	{
+		*p = arrived;
+	}
+	slot = &coherence.slot[*p];
+	if (arrived + 1u == coherence.participants)
+	{
+		/* Last one: the counter is reset before the others are released */
+		__atomic_store_n(&coherence.arrived.value, 0u, __ATOMIC_RELAXED);
+		__atomic_store_n(&coherence.generation.value, generation + 1u, __ATOMIC_RELEASE);
+		return STL_TRUE;
+	}
+	while (__atomic_load_n(&coherence.generation.value, __ATOMIC_ACQUIRE) == generation)
+	{
+		if (__atomic_load_n(&coherence.broken.value, __ATOMIC_ACQUIRE) != 0u)
+		{
+			done = STL_FALSE;
+			break;
+		}
+		if (STL_TSSP_CPU_get_cycles() - start > STL_COHERENCE_TIMEOUT_CYCLES)
+		{
+			__atomic_store_n(&coherence.broken.value, 1u, __ATOMIC_RELEASE);
+			slot->timeouts++;
+			done = STL_FALSE;
+			break;
+		}
+		STL_COHERENCE_RELAX();
+	}
+	slot->wait_cycles += STL_TSSP_CPU_get_cycles() - start;
+	return done;
+}
+
+/**
+ * @brief Hammers the shared lines and checks the values returned by the atomic operations.
+ *
+ * @param p Participant number
+ * @param obs Observations of the participant (errors updated)
+ * @return XOR of the tokens swapped in and of the tokens received
+ */
+STATIC_KEYWORD STL_INT32U_T STL_coherence_hammer(STL_INT32U_T p, STL_COHERENCE_OBS_T *obs)
+{
+	STL_INT32U_T i;
+	STL_INT32U_T old;
+	STL_INT32U_T previous = 0u;
+	STL_INT32U_T tokens = 0u;
+	STL_CYCLES_T retries = 0u;
+
+	for (i = 0u; i < STL_COHERENCE_ITERATIONS; i++)
+	{
+		/* The other CPUs only add: the counter grows between two additions of this CPU */
+		old = STL_coherence_fetch_add(&coherence.add.value, p + 1u);
+		if (i > 0u && old < previous + p + 1u)
+		{
+			obs->errors++;
+		}
+		previous = old;
+
+		old = __atomic_load_n(&coherence.cas.value, __ATOMIC_RELAXED);
+		while (STL_coherence_cas(&coherence.cas.value, old, old + 1u, &retries) == STL_FALSE)
+		{
+			retries++;
+			old = __atomic_load_n(&coherence.cas.value, __ATOMIC_RELAXED);
+		}
+
+		STL_coherence_increment(&coherence.inc.value, &retries);
+
+		/* Only this CPU writes its bit of the mask word */
+		if (STL_coherence_set_bit(&coherence.mask.value, p) != 0u)
+		{
+			obs->errors++;
+		}
+		if (STL_coherence_clear_bit(&coherence.mask.value, p) != 1u)
+		{
+			obs->errors++;
+		}
+
+		tokens ^= STL_COHERENCE_TOKEN(p, i) ^ STL_coherence_swap(&coherence.token.value, STL_COHERENCE_TOKEN(p, i));
+
+		/* Own word of the shared line, read back while the other words are written */
+		__atomic_store_n(&coherence.words[p], STL_COHERENCE_WORD(p, i), __ATOMIC_RELAXED);
+		if (__atomic_load_n(&coherence.words[p], __ATOMIC_RELAXED) != STL_COHERENCE_WORD(p, i))
+		{
+			obs->errors++;
+		}
+	}
+	coherence.slot[p].cas_retries += retries;
+	return tokens;
+}
+
+/**
+ * @brief Returns the observations of a participant in a fault-free round.
+ *
+ * @param p Participant number
+ * @param n Number of participants
+ * @param obs Observations to fill
+ * @return None
+ */
+STATIC_KEYWORD void STL_coherence_expected_obs(STL_INT32U_T p, STL_INT32U_T n, STL_COHERENCE_OBS_T *obs)
+{
+	obs->participant = p;
+	obs->added = STL_COHERENCE_ITERATIONS * n * (n + 1u) / 2u;
+	obs->compared = STL_COHERENCE_ITERATIONS * n;
+	obs->incremented = STL_COHERENCE_ITERATIONS * n;
+	obs->mask = 0u;
+	obs->errors = 0u;
+}
+
+/**
+ * @brief Initializes the coherence SBST.
+ *
+ * @param participants Number of CPUs running the test
+ * @param err Error code
+ * @return None
+ */
+void STL_coherence_init(STL_INT32U_T participants, STL_ERROR_T *err)
+{
+	STL_COHERENCE_OBS_T obs;
+	STL_INT32U_T p;
+	STL_SIGNATURE_T partial;
+	STL_SIGNATURE_T expected = STL_COHERENCE_SIGNATURE;
+
+	if (participants == 0u || participants > STL_COHERENCE_MAX_CPUS)
+	{
+		*err = STL_CPU_OUT_OF_BOUNDS;
+		return;
+	}
+	memset(&coherence, 0, sizeof(coherence));
+	for (p = 0u; p < participants; p++)
+	{
+		STL_coherence_expected_obs(p, participants, &obs);
+		partial = STL_coherence_fold(&obs);
+		expected = (STL_SIGNATURE_T)STL_crc32c_update((STL_INT32U_T)expected, &partial, sizeof(partial));
+	}
+	coherence.expected = expected;
+	/* Published last: a CPU calling the test sees either no participant or a complete state */
+	__atomic_store_n(&coherence.participants, participants, __ATOMIC_RELEASE);
+	*err = STL_ERROR_NONE;
+}
+
+/**
+ * @brief Coherence pseudo-test: runs one round with the other participants.
+ *
+ * @return The combined signature, STL_SIGNATURE_MISMATCH or STL_SIGNATURE_SKIPPED
+ */
+STL_SIGNATURE_T STL_coherence_test(void)
+{
+	STL_COHERENCE_OBS_T obs;
+	STL_INT32U_T n = __atomic_load_n(&coherence.participants, __ATOMIC_ACQUIRE);
+	STL_INT32U_T p = STL_COHERENCE_MAX_CPUS;
+	STL_INT32U_T q;
+	STL_INT32U_T tokens;
+	STL_INT32U_T final_token;
+	STL_SIGNATURE_T combined = STL_COHERENCE_SIGNATURE;
+	STL_CYCLES_T start;
+
+	if (n == 0u)
+	{
+		return STL_SIGNATURE_SKIPPED;
+	}
+	if (__atomic_load_n(&coherence.broken.value, __ATOMIC_ACQUIRE) != 0u ||
+		STL_coherence_barrier(&p) == STL_FALSE)
+	{
+		return STL_SIGNATURE_MISMATCH;
+	}
+
+	/* Hammer */
+	memset(&obs, 0, sizeof(obs));
+	obs.participant = p;
+	start = STL_TSSP_CPU_get_cycles();
+	tokens = STL_coherence_hammer(p, &obs);
+	coherence.slot[p].hammer_cycles += STL_TSSP_CPU_get_cycles() - start;
+	if (STL_coherence_barrier(&p) == STL_FALSE)
+	{
+		return STL_SIGNATURE_MISMATCH;
+	}
+
+	/* Check: the final values are read after all the participants are done */
+	obs.added = __atomic_load_n(&coherence.add.value, __ATOMIC_RELAXED);
+	obs.compared = __atomic_load_n(&coherence.cas.value, __ATOMIC_RELAXED);
+	obs.incremented = __atomic_load_n(&coherence.inc.value, __ATOMIC_RELAXED);
+	obs.mask = __atomic_load_n(&coherence.mask.value, __ATOMIC_RELAXED);
+	for (q = 0u; q < n; q++)
+	{
+		if (__atomic_load_n(&coherence.words[q], __ATOMIC_RELAXED) != STL_COHERENCE_WORD(q, STL_COHERENCE_ITERATIONS - 1u))
+		{
+			obs.errors++;
+		}
+	}
+	final_token = __atomic_load_n(&coherence.token.value, __ATOMIC_RELAXED);
+	coherence.slot[p].partial = STL_coherence_fold(&obs);
+	coherence.slot[p].tokens = tokens;
+	if (STL_coherence_barrier(&p) == STL_FALSE)
+	{
+		return STL_SIGNATURE_MISMATCH;
+	}
+
+	/* Combine: every token swapped in is either held by the token word or was received once */
+	for (q = 0u; q < n; q++)
+	{
+		combined = (STL_SIGNATURE_T)STL_crc32c_update((STL_INT32U_T)combined, &coherence.slot[q].partial,
+													  sizeof(coherence.slot[q].partial));
+		final_token ^= coherence.slot[q].tokens;
+	}
+	if (p == 0u)
+	{
+		/* The next round starts after the leader has arrived at its first barrier */
+		coherence.add.value = 0u;
+		coherence.cas.value = 0u;
+		coherence.inc.value = 0u;
+		coherence.mask.value = 0u;
+		coherence.token.value = 0u;
+		memset(coherence.words, 0, sizeof(coherence.words));
+		coherence.rounds++;
+	}
+	if (combined != coherence.expected || final_token != 0u)
+	{
+		coherence.slot[p].faults++;
+		return STL_SIGNATURE_MISMATCH;
+	}
+	return combined;
+}
+
+/**
+ * @brief Retrieves the statistics of the coherence SBST.
+ *
+ * @param stats Pointer to the statistics to fill
+ * @return None
+ */
+void STL_coherence_get_stats(STL_COHERENCE_STATS_T *stats)
+{
+	const STL_COHERENCE_SLOT_T *slot;
+	STL_INT32U_T p;
+
+	memset(stats, 0, sizeof(*stats));
+	stats->participants = coherence.participants;
+	stats->rounds = coherence.rounds;
+	for (p = 0u; p < STL_COHERENCE_MAX_CPUS; p++)
+	{
+		slot = &coherence.slot[p];
+		stats->faults += slot->faults;
+		stats->timeouts += slot->timeouts;
+		stats->cas_retries += slot->cas_retries;
+		stats->wait_cycles += slot->wait_cycles;
+		stats->hammer_cycles += slot->hammer_cycles;
+	}
+}
+
+#endif /*STL_USE_COHERENCE_TEST*/
+#endif /*__STL_COHERENCE_MODULE__*/
+#endif /*__STL__*/
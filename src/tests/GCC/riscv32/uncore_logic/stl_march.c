@@ -0,0 +1,288 @@
+#if __STL__
+
+/**
+ * @file stl_march.c
+ * @brief Implementation of the transparent March RAM test (RISC-V).
+ *
+ * The test walks the regions in order with a cursor (region, offset). Each step takes the
+ * next block of up to STL_MARCH_CHUNK_BYTES bytes, copies it into the save area and runs the
+ * March elements on it, the saved copy giving the expected contents of every read. When the
+ * last block of the last region is done, the sweep is complete.
+ *
+ * The elements work on 32-bit words in loops unrolled by four words: each word is read and
+ * compared with the expected value (the saved contents, or their complement), and the
+ * complement of the value read is written back. The differences are OR-accumulated in a
+ * register and checked once per block.
+ *
+ * @see stl_march.h
+ */
+
+#ifndef __STL_MARCH_MODULE__
+#define __STL_MARCH_MODULE__
+
+#include "stl_march.h"
+#include "stl_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+#if (STL_USE_MARCH > 0u)
+
+/**
+ * @typedef STL_MARCH_T
+ * @brief State of the March test.
+ *
+ * @var STL_MARCH_T::regions
+ * Regions to test (STL_NULL until initialized).
+ * @var STL_MARCH_T::count
+ * Number of regions.
+ * @var STL_MARCH_T::region
+ * Region under test.
+ * @var STL_MARCH_T::offset
+ * Offset of the next block in the region.
+ * @var STL_MARCH_T::sweep_start
+ * Cycle counter value at the first step of the sweep.
+ * @var STL_MARCH_T::sweep_steps
+ * Steps of the sweep in progress.
+ * @var STL_MARCH_T::sweep_busy
+ * Cycles spent in the steps of the sweep in progress.
+ * @var STL_MARCH_T::stats
+ * Statistics of the completed sweeps.
+ */
+typedef struct
+{
+	const STL_MARCH_REGION_T *regions;
+	STL_SIZE_T count;
+	STL_SIZE_T region;
+	STL_INT32U_T offset;
+	STL_CYCLES_T sweep_start;
+	STL_INT32U_T sweep_steps;
+	STL_CYCLES_T sweep_busy;
+	STL_MARCH_STATS_T stats;
+} STL_MARCH_T;
+
+STATIC_KEYWORD STL_MARCH_T march;
+
+/**
+ * @brief Save area of the block under test.
+ */
+STATIC_KEYWORD __attribute__((aligned(STL_MARCH_ALIGN))) uint8_t march_save[STL_MARCH_CHUNK_BYTES];
+
+/*
+ * One March operation on the word i: read and compare with the expected value (saved
+ * contents c, complemented when inv is ~0u), then write the complement of the value read.
+ */
+#define STL_MARCH_RW(i, inv)                                                                                           \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		x = w[i];                                                                                                      \
+		diff |= x ^ c[i] ^ (inv);                                                                                      \
+		w[i] = ~x;                                                                                                     \
+	} while (0)
+
+/**
+ * @brief March C- on 32-bit words, unrolled by four words.
+ * The block is accessed through a volatile pointer, so that the read and the write of each
+ * word are issued in the order of the March element.
+ *
+ * @param block Block under test
+ * @param save Save area
+ * @param size Size of the block in bytes
+ * @return STL_TRUE if every read matched the saved contents
+ */
+STATIC_KEYWORD STL_BOOL STL_march_kernel(void *block, void *save, STL_INT32U_T size)
+{
+	volatile STL_INT32U_T *w = (volatile STL_INT32U_T *)block;
+	STL_INT32U_T *c = (STL_INT32U_T *)save;
+	STL_INT32U_T diff = 0u;
+	STL_INT32U_T x;
+	STL_INT32U_T n = size / sizeof(STL_INT32U_T);
+	STL_INT32U_T i;
+
+	for (i = 0u; i < n; i += 4u)
+	{
+		c[i] = w[i];
+		c[i + 1u] = w[i + 1u];
+		c[i + 2u] = w[i + 2u];
+		c[i + 3u] = w[i + 3u];
+	}
+	/* up(r c, w ~c) */
+	for (i = 0u; i < n; i += 4u)
+	{
+		STL_MARCH_RW(i, 0u);
+		STL_MARCH_RW(i + 1u, 0u);
+		STL_MARCH_RW(i + 2u, 0u);
+		STL_MARCH_RW(i + 3u, 0u);
+	}
+	/* up(r ~c, w c) */
+	for (i = 0u; i < n; i += 4u)
+	{
+		STL_MARCH_RW(i, ~0u);
+		STL_MARCH_RW(i + 1u, ~0u);
+		STL_MARCH_RW(i + 2u, ~0u);
+		STL_MARCH_RW(i + 3u, ~0u);
+	}
+	/* down(r c, w ~c) */
+	for (i = n; i > 0u; i -= 4u)
+	{
+		STL_MARCH_RW(i - 1u, 0u);
+		STL_MARCH_RW(i - 2u, 0u);
+		STL_MARCH_RW(i - 3u, 0u);
+		STL_MARCH_RW(i - 4u, 0u);
+	}
+	/* down(r ~c, w c) */
+	for (i = n; i > 0u; i -= 4u)
+	{
+		STL_MARCH_RW(i - 1u, ~0u);
+		STL_MARCH_RW(i - 2u, ~0u);
+		STL_MARCH_RW(i - 3u, ~0u);
+		STL_MARCH_RW(i - 4u, ~0u);
+	}
+	/* any(r c) */
+	for (i = 0u; i < n; i += 4u)
+	{
+		diff |= (w[i] ^ c[i]) | (w[i + 1u] ^ c[i + 1u]) | (w[i + 2u] ^ c[i + 2u]) | (w[i + 3u] ^ c[i + 3u]);
+	}
+	return (diff == 0u) ? STL_TRUE : STL_FALSE;
+}
+
+/**
+ * @brief Initializes the March test.
+ *
+ * @param regions Regions to test
+ * @param count Number of regions
+ * @param err Error code
+ * @return None
+ */
+void STL_march_init(const STL_MARCH_REGION_T *regions, STL_SIZE_T count, STL_ERROR_T *err)
+{
+	STL_SIZE_T i;
+
+	if (count > STL_MARCH_MAX_REGIONS || (count > 0u && regions == STL_NULL))
+	{
+		*err = STL_INDEX_OUT_OF_BOUNDS;
+		return;
+	}
+	for (i = 0u; i < count; i++)
+	{
+		if (((uintptr_t)regions[i].start % STL_MARCH_ALIGN) != 0u || (regions[i].size % STL_MARCH_ALIGN) != 0u ||
+			regions[i].size == 0u)
+		{
+			*err = STL_INDEX_OUT_OF_BOUNDS;
+			return;
+		}
+	}
+
+	march.regions = regions;
+	march.count = count;
+	march.stats.sweep_bytes = 0u;
+	for (i = 0u; i < count; i++)
+	{
+		march.stats.sweep_bytes += regions[i].size;
+	}
+	march.region = 0u;
+	march.offset = 0u;
+	march.sweep_steps = 0u;
+	march.sweep_busy = 0u;
+	march.stats.sweeps = 0u;
+	march.stats.faults = 0u;
+	march.stats.last_fault = STL_NULL;
+	march.stats.sweep_steps = 0u;
+	march.stats.sweep_busy_cycles = 0u;
+	march.stats.sweep_time_cycles = 0u;
+	march.stats.max_step_cycles = 0u;
+	*err = STL_ERROR_NONE;
+}
+
+/**
+ * @brief March pseudo-test: tests the next block of the regions.
+ *
+ * @return STL_SIGNATURE_MISMATCH if the block tested during this step is faulty,
+ *         STL_MARCH_SIGNATURE otherwise
+ */
+STL_SIGNATURE_T STL_march_test(void)
+{
+	STL_SIGNATURE_T signature = STL_MARCH_SIGNATURE;
+	const STL_MARCH_REGION_T *region;
+	uint8_t *block;
+	STL_INT32U_T size;
+	STL_INT32U_T i;
+	STL_CYCLES_T start;
+	STL_CYCLES_T cycles;
+
+	if (march.count == 0u)
+	{
+		return signature;
+	}
+
+	start = STL_TSSP_CPU_get_cycles();
+	if (march.sweep_steps == 0u)
+	{
+		march.sweep_start = start;
+	}
+	march.sweep_steps++;
+
+	region = &march.regions[march.region];
+	block = (uint8_t *)region->start + march.offset;
+	size = region->size - march.offset;
+	if (size > STL_MARCH_CHUNK_BYTES)
+	{
+		size = STL_MARCH_CHUNK_BYTES;
+	}
+	if (STL_march_kernel(block, march_save, size) == STL_FALSE)
+	{
+		/* Give the block its contents back, as far as the faulty cells allow */
+		for (i = 0u; i < size; i++)
+		{
+			block[i] = march_save[i];
+		}
+		march.stats.faults++;
+		march.stats.last_fault = block;
+		signature = STL_SIGNATURE_MISMATCH;
+	}
+	march.offset += size;
+	if (march.offset == region->size)
+	{
+		march.offset = 0u;
+		march.region++;
+		if (march.region == march.count)
+		{
+			/* Sweep complete: the next step starts a new one */
+			march.region = 0u;
+		}
+	}
+
+	cycles = STL_TSSP_CPU_get_cycles() - start;
+	march.sweep_busy += cycles;
+	if (cycles > march.stats.max_step_cycles)
+	{
+		march.stats.max_step_cycles = cycles;
+	}
+	if (march.region == 0u && march.offset == 0u)
+	{
+		march.stats.sweeps++;
+		march.stats.sweep_steps = march.sweep_steps;
+		march.stats.sweep_busy_cycles = march.sweep_busy;
+		march.stats.sweep_time_cycles = STL_TSSP_CPU_get_cycles() - march.sweep_start;
+		march.sweep_steps = 0u;
+		march.sweep_busy = 0u;
+	}
+
+	return signature;
+}
+
+/**
+ * @brief Retrieves the statistics of the March test.
+ *
+ * @param stats Pointer to the statistics to fill
+ * @param err Error code
+ * @return None
+ */
+void STL_march_get_stats(STL_MARCH_STATS_T *stats, STL_ERROR_T *err)
+{
+	*stats = march.stats;
+	*err = STL_ERROR_NONE;
+}
+
+#endif /*STL_USE_MARCH*/
+#endif /*__STL_MARCH_MODULE__*/
+#endif /*__STL__*/
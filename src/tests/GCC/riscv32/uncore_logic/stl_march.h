@@ -0,0 +1,132 @@
+/**
+ * @file stl_march.h
+ * @brief Header file for the transparent March RAM test.
+ *
+ * The March test checks RAM regions for stuck-at, transition, address-decoder and
+ * intra-word coupling faults without destroying their contents. Each invocation tests the
+ * next block of STL_MARCH_CHUNK_BYTES bytes: the block is saved, goes through the elements of
+ * a transparent March C- with its own contents c as the data background, and is restored:
+ *
+ *     save; up(r c, w ~c); up(r ~c, w c); down(r c, w ~c); down(r ~c, w c); any(r c); restore
+ *
+ * A read that does not match the saved contents is a fault: the block is restored from the
+ * saved copy and the step fails.
+ *
+ * The test runs as a pseudo-test: STL_march_test is registered in the runtime test table
+ * like any SBST, gets its own entry in the budget and watchdog tables, and tests one block
+ * per invocation, so that the cost of a step is bounded by the chunk size.
+ *
+ * On RISC-V the elements work on 32-bit words, four words per iteration of the unrolled loops.
+ *
+ * @details
+ * - STL_march_init: Registers the regions.
+ * - STL_march_test: Tests the next block (pseudo-test entry point).
+ * - STL_march_get_stats: Returns the sweep count, the faults and the time to a full sweep.
+ *
+ * @note The block under test holds inverted data during a step: the regions must not be
+ *       accessed concurrently (interrupt handlers, DMA, other cores), and must not hold the
+ *       stack of the caller.
+ * @note The coupling faults between cells of different blocks are not covered.
+ */
+#if __STL__
+#ifndef __STL_MARCH_H__
+#define __STL_MARCH_H__
+
+#include "stl_cfg.h"
+#include "stl_types.h"
+
+#if (STL_USE_MARCH > 0u)
+
+#define STL_MARCH_SIGNATURE 0x3A2C3A2Cu /* Signature of a March step without fault */
+#define STL_MARCH_ALIGN 16u				/* Alignment of the regions and of the chunk size (bytes) */
+
+#if ((STL_MARCH_CHUNK_BYTES % STL_MARCH_ALIGN) != 0u)
+#error "STL_MARCH_CHUNK_BYTES must be a multiple of STL_MARCH_ALIGN."
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /*__cplusplus*/
+
+	/**
+	 * @brief Region tested by the March test.
+	 *
+	 * @var STL_MARCH_REGION_T::start
+	 * Start address of the region, aligned on STL_MARCH_ALIGN bytes.
+	 * @var STL_MARCH_REGION_T::size
+	 * Size of the region in bytes, a multiple of STL_MARCH_ALIGN.
+	 */
+	typedef struct
+	{
+		void *start;
+		STL_INT32U_T size;
+	} STL_MARCH_REGION_T;
+
+	/**
+	 * @brief Statistics of the March test.
+	 *
+	 * @var STL_MARCH_STATS_T::sweeps
+	 * Number of full sweeps completed.
+	 * @var STL_MARCH_STATS_T::faults
+	 * Number of blocks found faulty.
+	 * @var STL_MARCH_STATS_T::last_fault
+	 * Start address of the last block found faulty.
+	 * @var STL_MARCH_STATS_T::sweep_bytes
+	 * Number of bytes of a full sweep.
+	 * @var STL_MARCH_STATS_T::sweep_steps
+	 * Number of invocations of the last full sweep.
+	 * @var STL_MARCH_STATS_T::sweep_busy_cycles
+	 * Cycles spent testing during the last full sweep.
+	 * @var STL_MARCH_STATS_T::sweep_time_cycles
+	 * Time to a full sweep: cycles elapsed between the first and the last step of the last sweep.
+	 * @var STL_MARCH_STATS_T::max_step_cycles
+	 * Worst duration of a single step, in cycles.
+	 */
+	typedef struct
+	{
+		STL_INT32U_T sweeps;
+		STL_INT32U_T faults;
+		const void *last_fault;
+		STL_INT32U_T sweep_bytes;
+		STL_INT32U_T sweep_steps;
+		STL_CYCLES_T sweep_busy_cycles;
+		STL_CYCLES_T sweep_time_cycles;
+		STL_CYCLES_T max_step_cycles;
+	} STL_MARCH_STATS_T;
+
+	/**
+	 * @brief Initializes the March test.
+	 *
+	 * @param regions Regions to test
+	 * @param count Number of regions (at most STL_MARCH_MAX_REGIONS)
+	 * @param err Error code, set to STL_INDEX_OUT_OF_BOUNDS if there are too many regions or
+	 *            a region is not aligned on STL_MARCH_ALIGN bytes
+	 * @return None
+	 */
+	void STL_march_init(const STL_MARCH_REGION_T *regions, STL_SIZE_T count, STL_ERROR_T *err);
+
+	/**
+	 * @brief March pseudo-test: tests the next block of the regions.
+	 *
+	 * @return STL_SIGNATURE_MISMATCH if the block tested during this step is faulty,
+	 *         STL_MARCH_SIGNATURE otherwise
+	 */
+	STL_SIGNATURE_T STL_march_test(void);
+
+	/**
+	 * @brief Retrieves the statistics of the March test.
+	 *
+	 * @param stats Pointer to the statistics to fill
+	 * @param err Error code
+	 * @return None
+	 */
+	void STL_march_get_stats(STL_MARCH_STATS_T *stats, STL_ERROR_T *err);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /*STL_USE_MARCH*/
+#endif /*__STL_MARCH_H__*/
+#endif /*__STL__*/
@@ -1,4 +1,6 @@
 
+#include <immintrin.h>
+
 #include "stl_types.h"
 
 #define TEST_DATA_LENGTH 32
@@ -29,4 +31,57 @@ STL_SIGNATURE_T test_adder(void)
         sig |= c;
     }
     return sig;
+}
+
+/*
+ * Variants of test_adder per ISA level (see STL_RT_ROUTINE_VARIANTS): the same additions on
+ * 4, 8 and 16 lanes, OR-folded across the lanes, so that every variant returns the
+ * signature of the scalar test. Each variant is compiled for its own ISA level and must
+ * only be called on a CPU reporting it.
+ */
+
+__attribute__((target("sse4.2"))) STL_SIGNATURE_T test_adder_sse42(void)
+{
+    __m128i sig = _mm_setzero_si128();
+    __m128i a;
+    int i;
+
+    for (i = 0; i < TEST_DATA_LENGTH; i += 4)
+    {
+        a = _mm_loadu_si128((const __m128i *)&test_data_patterns[i]);
+        sig = _mm_or_si128(sig, _mm_add_epi32(a, a));
+    }
+    sig = _mm_or_si128(sig, _mm_unpackhi_epi64(sig, sig));
+    return _mm_extract_epi32(sig, 0) | _mm_extract_epi32(sig, 1);
+}
+
+__attribute__((target("avx2"))) STL_SIGNATURE_T test_adder_avx2(void)
+{
+    __m256i sig = _mm256_setzero_si256();
+    __m256i a;
+    __m128i half;
+    int i;
+
+    for (i = 0; i < TEST_DATA_LENGTH; i += 8)
+    {
+        a = _mm256_loadu_si256((const __m256i *)&test_data_patterns[i]);
+        sig = _mm256_or_si256(sig, _mm256_add_epi32(a, a));
+    }
+    half = _mm_or_si128(_mm256_castsi256_si128(sig), _mm256_extracti128_si256(sig, 1));
+    half = _mm_or_si128(half, _mm_unpackhi_epi64(half, half));
+    return _mm_extract_epi32(half, 0) | _mm_extract_epi32(half, 1);
+}
+
+__attribute__((target("avx512f,avx512dq,avx512bw,avx512vl"))) STL_SIGNATURE_T test_adder_avx512(void)
+{
+    __m512i sig = _mm512_setzero_si512();
+    __m512i a;
+    int i;
+
+    for (i = 0; i < TEST_DATA_LENGTH; i += 16)
+    {
+        a = _mm512_loadu_si512((const void *)&test_data_patterns[i]);
+        sig = _mm512_or_si512(sig, _mm512_add_epi32(a, a));
+    }
+    return _mm512_reduce_or_epi32(sig);
 }
\ No newline at end of file
@@ -0,0 +1,361 @@
+/*
+ * Runtime SBSTs of the vector units (AVX2 on ymm, AVX-512 on zmm registers).
+ *
+ * Each test drives one group of vector datapaths with patterns generated in the registers:
+ * - a walking one, its complement and the two checkerboards, rotated by the index of the lane,
+ *   so that over the 32 steps every bit of every lane is toggled and neighbouring lanes differ;
+ * - the results of each step are compacted in a per-lane MISR (rotate left, exclusive or);
+ * - the MISR is reduced across the lanes with a weighted sum (odd weight per lane, so that the
+ *   position of a faulty lane is kept) and compared with the golden signature of the variant.
+ *
+ * The variants are selected by the ISA dispatch (STL_RT_ROUTINE_VARIANTS): each one is compiled
+ * for its own ISA level and has its own golden signature. A test returns its signature when it
+ * matches the golden value, STL_SIGNATURE_MISMATCH otherwise.
+ *
+ * The floating-point test relies on the default rounding mode (round to nearest) of MXCSR.
+ */
+
+#include <immintrin.h>
+
+#include "stl_cfg.h"
+#include "stl_types.h"
+
+#define VEC_STEPS 32
+
+/* Golden signatures of the AVX2 variants */
+#define VEC_ADD_AVX2_GOLDEN 0x3338ADBDu
+#define VEC_MUL_AVX2_GOLDEN 0x95F820D7u
+#define VEC_PERMUTE_AVX2_GOLDEN 0xEA6A3388u
+#define VEC_COMPARE_AVX2_GOLDEN 0xD0FD2EE6u
+#define VEC_FMA_AVX2_GOLDEN 0xF681F19Au
+
+/* Golden signatures of the AVX-512 variants */
+#define VEC_ADD_AVX512_GOLDEN 0xE046C222u
+#define VEC_MUL_AVX512_GOLDEN 0x99A6A080u
+#define VEC_PERMUTE_AVX512_GOLDEN 0xE9E75FA1u
+#define VEC_COMPARE_AVX512_GOLDEN 0x705D06C2u
+#define VEC_FMA_AVX512_GOLDEN 0x38E5B88Bu
+
+#define VEC_CHECK(sig, golden) (((sig) == (STL_SIGNATURE_T)(golden)) ? (sig) : STL_SIGNATURE_MISMATCH)
+
+/****************                    AVX2 (ymm)                                       ****************/
+
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+/* Lane indexes 0..7 */
+AVX2_TARGET static inline __m256i vec_lanes_avx2(void)
+{
+    return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+}
+
+/* Rotates each lane of v left by the matching lane of n (0..31) */
+AVX2_TARGET static inline __m256i vec_rolv_avx2(__m256i v, __m256i n)
+{
+    return _mm256_or_si256(_mm256_sllv_epi32(v, n), _mm256_srlv_epi32(v, _mm256_sub_epi32(_mm256_set1_epi32(32), n)));
+}
+
+/* Compacts r into the per-lane MISR */
+AVX2_TARGET static inline __m256i vec_misr_avx2(__m256i misr, __m256i r)
+{
+    return _mm256_xor_si256(_mm256_or_si256(_mm256_slli_epi32(misr, 1), _mm256_srli_epi32(misr, 31)), r);
+}
+
+/* Folds the MISR across the lanes: sum of misr[j] * (2j + 1) */
+AVX2_TARGET static inline STL_SIGNATURE_T vec_fold_avx2(__m256i misr)
+{
+    __m256i weights = _mm256_add_epi32(_mm256_slli_epi32(vec_lanes_avx2(), 1), _mm256_set1_epi32(1));
+    __m256i w = _mm256_mullo_epi32(misr, weights);
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(w), _mm256_extracti128_si256(w, 1));
+
+    s = _mm_add_epi32(s, _mm_unpackhi_epi64(s, s));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x55));
+    return (STL_SIGNATURE_T)_mm_cvtsi128_si32(s);
+}
+
+/* Pattern of the step: walking one, walking zero and checkerboards, rotated per lane */
+AVX2_TARGET static inline void vec_patterns_avx2(int step, __m256i *a, __m256i *b)
+{
+    __m256i n = _mm256_and_si256(_mm256_add_epi32(vec_lanes_avx2(), _mm256_set1_epi32(step)), _mm256_set1_epi32(31));
+    __m256i one = vec_rolv_avx2(_mm256_set1_epi32(1), n);
+    __m256i checker = vec_rolv_avx2(_mm256_set1_epi32(0x55555555), n);
+
+    *a = _mm256_xor_si256(one, checker);
+    *b = _mm256_xor_si256(_mm256_xor_si256(one, _mm256_set1_epi32(-1)), _mm256_slli_epi32(checker, 1));
+}
+
+/* Adders: 32/64-bit additions with full carry chains, subtractions, saturating 16/8-bit additions */
+AVX2_TARGET STL_SIGNATURE_T sbst_vec_add_avx2(void)
+{
+    __m256i misr = _mm256_setzero_si256();
+    __m256i a, b;
+    int step;
+
+    for (step = 0; step < VEC_STEPS; step++)
+    {
+        vec_patterns_avx2(step, &a, &b);
+        misr = vec_misr_avx2(misr, _mm256_add_epi32(a, b));
+        misr = vec_misr_avx2(misr, _mm256_add_epi32(a, _mm256_set1_epi32(-1)));
+        misr = vec_misr_avx2(misr, _mm256_sub_epi32(b, a));
+        misr = vec_misr_avx2(misr, _mm256_add_epi64(a, _mm256_set1_epi64x(0x00000000FFFFFFFFll)));
+        misr = vec_misr_avx2(misr, _mm256_adds_epi16(a, b));
+        misr = vec_misr_avx2(misr, _mm256_subs_epu8(b, a));
+    }
+    return VEC_CHECK(vec_fold_avx2(misr), VEC_ADD_AVX2_GOLDEN);
+}
+
+/* Multipliers: low 32-bit and 16-bit products, 32x32->64 products, high 16-bit products */
+AVX2_TARGET STL_SIGNATURE_T sbst_vec_mul_avx2(void)
+{
+    __m256i misr = _mm256_setzero_si256();
+    __m256i a, b, p;
+    int step;
+
+    for (step = 0; step < VEC_STEPS; step++)
+    {
+        vec_patterns_avx2(step, &a, &b);
+        b = _mm256_or_si256(b, _mm256_set1_epi32(1));
+        misr = vec_misr_avx2(misr, _mm256_mullo_epi32(a, b));
+        misr = vec_misr_avx2(misr, _mm256_mullo_epi16(a, b));
+        misr = vec_misr_avx2(misr, _mm256_mulhi_epu16(a, b));
+        p = _mm256_mul_epu32(a, b);
+        misr = vec_misr_avx2(misr, _mm256_xor_si256(p, _mm256_srli_epi64(p, 32)));
+        p = _mm256_mul_epi32(b, a);
+        misr = vec_misr_avx2(misr, _mm256_xor_si256(p, _mm256_srli_epi64(p, 32)));
+    }
+    return VEC_CHECK(vec_fold_avx2(misr), VEC_MUL_AVX2_GOLDEN);
+}
+
+/* Shuffle and blend network: byte shuffles, cross-lane permutes, immediate and variable blends */
+AVX2_TARGET STL_SIGNATURE_T sbst_vec_permute_avx2(void)
+{
+    __m256i misr = _mm256_setzero_si256();
+    __m256i bytes = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                     12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    __m256i a, b, perm;
+    int step;
+
+    for (step = 0; step < VEC_STEPS; step++)
+    {
+        vec_patterns_avx2(step, &a, &b);
+        perm = _mm256_and_si256(_mm256_add_epi32(vec_lanes_avx2(), _mm256_set1_epi32(step * 3 + 1)), _mm256_set1_epi32(7));
+        misr = vec_misr_avx2(misr, _mm256_shuffle_epi8(a, bytes));
+        misr = vec_misr_avx2(misr, _mm256_permutevar8x32_epi32(b, perm));
+        misr = vec_misr_avx2(misr, _mm256_permute4x64_epi64(a, 0x1B));
+        misr = vec_misr_avx2(misr, _mm256_permute2x128_si256(a, b, 0x21));
+        misr = vec_misr_avx2(misr, _mm256_blend_epi32(a, b, 0xA5));
+        misr = vec_misr_avx2(misr, _mm256_blendv_epi8(a, b, _mm256_slli_epi32(b, step & 7)));
+        misr = vec_misr_avx2(misr, _mm256_unpacklo_epi16(a, b));
+    }
+    return VEC_CHECK(vec_fold_avx2(misr), VEC_PERMUTE_AVX2_GOLDEN);
+}
+
+/* Comparators: equality and signed ordering on 8/32/64-bit elements, minimum and maximum */
+AVX2_TARGET STL_SIGNATURE_T sbst_vec_compare_avx2(void)
+{
+    __m256i misr = _mm256_setzero_si256();
+    __m256i a, b, c;
+    int step;
+
+    for (step = 0; step < VEC_STEPS; step++)
+    {
+        vec_patterns_avx2(step, &a, &b);
+        /* c differs from a in one bit, shifted across the lanes and steps */
+        c = _mm256_xor_si256(a, vec_rolv_avx2(_mm256_set1_epi32(1 << (step & 7)), vec_lanes_avx2()));
+        misr = vec_misr_avx2(misr, _mm256_cmpeq_epi32(a, c));
+        misr = vec_misr_avx2(misr, _mm256_cmpeq_epi32(a, a));
+        misr = vec_misr_avx2(misr, _mm256_cmpgt_epi32(a, b));
+        misr = vec_misr_avx2(misr, _mm256_cmpgt_epi8(c, b));
+        misr = vec_misr_avx2(misr, _mm256_cmpgt_epi64(b, c));
+        misr = vec_misr_avx2(misr, _mm256_min_epu32(a, b));
+        misr = vec_misr_avx2(misr, _mm256_max_epi32(a, c));
+    }
+    return VEC_CHECK(vec_fold_avx2(misr), VEC_COMPARE_AVX2_GOLDEN);
+}
+
+/* Fused multiply-add units: single and double precision, exact integer-valued operands */
+__attribute__((target("avx2,fma"))) STL_SIGNATURE_T sbst_vec_fma_avx2(void)
+{
+    __m256i misr = _mm256_setzero_si256();
+    __m256i a, b;
+    __m256 fa, fb, fc;
+    __m256d da, db, dc;
+    int step;
+
+    for (step = 0; step < VEC_STEPS; step++)
+    {
+        vec_patterns_avx2(step, &a, &b);
+        /* 24-bit (single) and 32-bit (double) integers are exact in the format */
+        fa = _mm256_cvtepi32_ps(_mm256_srai_epi32(a, 8));
+        fb = _mm256_cvtepi32_ps(_mm256_srai_epi32(b, 8));
+        fc = _mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_xor_si256(a, b), 8));
+        misr = vec_misr_avx2(misr, _mm256_castps_si256(_mm256_fmadd_ps(fa, fb, fc)));
+        misr = vec_misr_avx2(misr, _mm256_castps_si256(_mm256_fnmadd_ps(fb, fc, fa)));
+        da = _mm256_cvtepi32_pd(_mm256_castsi256_si128(a));
+        db = _mm256_cvtepi32_pd(_mm256_extracti128_si256(b, 1));
+        dc = _mm256_cvtepi32_pd(_mm256_castsi256_si128(b));
+        misr = vec_misr_avx2(misr, _mm256_castpd_si256(_mm256_fmadd_pd(da, db, dc)));
+        misr = vec_misr_avx2(misr, _mm256_castpd_si256(_mm256_fmsub_pd(db, dc, da)));
+    }
+    return VEC_CHECK(vec_fold_avx2(misr), VEC_FMA_AVX2_GOLDEN);
+}
+
+/****************                    AVX-512 (zmm)                                    ****************/
+
+#define AVX512_TARGET __attribute__((target("avx512f,avx512dq,avx512bw,avx512vl")))
+
+/* Lane indexes 0..15 */
+AVX512_TARGET static inline __m512i vec_lanes_avx512(void)
+{
+    return _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+}
+
+/* Compacts r into the per-lane MISR */
+AVX512_TARGET static inline __m512i vec_misr_avx512(__m512i misr, __m512i r)
+{
+    return _mm512_xor_si512(_mm512_rol_epi32(misr, 1), r);
+}
+
+/* Compacts a mask register into the per-lane MISR */
+AVX512_TARGET static inline __m512i vec_misr_mask_avx512(__m512i misr, __mmask16 k)
+{
+    return vec_misr_avx512(misr, _mm512_movm_epi32(k));
+}
+
+/* Folds the MISR across the lanes: sum of misr[j] * (2j + 1) */
+AVX512_TARGET static inline STL_SIGNATURE_T vec_fold_avx512(__m512i misr)
+{
+    __m512i weights = _mm512_add_epi32(_mm512_slli_epi32(vec_lanes_avx512(), 1), _mm512_set1_epi32(1));
+
+    return (STL_SIGNATURE_T)_mm512_reduce_add_epi32(_mm512_mullo_epi32(misr, weights));
+}
+
+/* Pattern of the step: walking one, walking zero and checkerboards, rotated per lane */
+AVX512_TARGET static inline void vec_patterns_avx512(int step, __m512i *a, __m512i *b)
+{
+    __m512i n = _mm512_and_si512(_mm512_add_epi32(vec_lanes_avx512(), _mm512_set1_epi32(step)), _mm512_set1_epi32(31));
+    __m512i one = _mm512_rolv_epi32(_mm512_set1_epi32(1), n);
+    __m512i checker = _mm512_rolv_epi32(_mm512_set1_epi32(0x55555555), n);
+
+    *a = _mm512_xor_si512(one, checker);
+    *b = _mm512_xor_si512(_mm512_xor_si512(one, _mm512_set1_epi32(-1)), _mm512_slli_epi32(checker, 1));
+}
+
+/* Adders: 32/64-bit additions with full carry chains, subtractions, saturating 16/8-bit additions */
+AVX512_TARGET STL_SIGNATURE_T sbst_vec_add_avx512(void)
+{
+    __m512i misr = _mm512_setzero_si512();
+    __m512i a, b;
+    int step;
+
+    for (step = 0; step < VEC_STEPS; step++)
+    {
+        vec_patterns_avx512(step, &a, &b);
+        misr = vec_misr_avx512(misr, _mm512_add_epi32(a, b));
+        misr = vec_misr_avx512(misr, _mm512_add_epi32(a, _mm512_set1_epi32(-1)));
+        misr = vec_misr_avx512(misr, _mm512_sub_epi32(b, a));
+        misr = vec_misr_avx512(misr, _mm512_add_epi64(a, _mm512_set1_epi64(0x00000000FFFFFFFFll)));
+        misr = vec_misr_avx512(misr, _mm512_adds_epi16(a, b));
+        misr = vec_misr_avx512(misr, _mm512_subs_epu8(b, a));
+        /* Masked addition: the write mask selects the lanes of the step */
+        misr = vec_misr_avx512(misr, _mm512_mask_add_epi32(b, (__mmask16)(0x5A5Au << (step & 7)), a, b));
+    }
+    return VEC_CHECK(vec_fold_avx512(misr), VEC_ADD_AVX512_GOLDEN);
+}
+
+/* Multipliers: low 32/64-bit and 16-bit products, 32x32->64 products, high 16-bit products */
+AVX512_TARGET STL_SIGNATURE_T sbst_vec_mul_avx512(void)
+{
+    __m512i misr = _mm512_setzero_si512();
+    __m512i a, b, p;
+    int step;
+
+    for (step = 0; step < VEC_STEPS; step++)
+    {
+        vec_patterns_avx512(step, &a, &b);
+        b = _mm512_or_si512(b, _mm512_set1_epi32(1));
+        misr = vec_misr_avx512(misr, _mm512_mullo_epi32(a, b));
+        misr = vec_misr_avx512(misr, _mm512_mullo_epi16(a, b));
+        misr = vec_misr_avx512(misr, _mm512_mulhi_epu16(a, b));
+        misr = vec_misr_avx512(misr, _mm512_mullo_epi64(a, b));
+        p = _mm512_mul_epu32(a, b);
+        misr = vec_misr_avx512(misr, _mm512_xor_si512(p, _mm512_srli_epi64(p, 32)));
+        p = _mm512_mul_epi32(b, a);
+        misr = vec_misr_avx512(misr, _mm512_xor_si512(p, _mm512_srli_epi64(p, 32)));
+    }
+    return VEC_CHECK(vec_fold_avx512(misr), VEC_MUL_AVX512_GOLDEN);
+}
+
+/* Shuffle and blend network: byte shuffles, full-width permutes, mask blends */
+AVX512_TARGET STL_SIGNATURE_T sbst_vec_permute_avx512(void)
+{
+    __m512i misr = _mm512_setzero_si512();
+    __m512i bytes = _mm512_set4_epi32(0x0C0D0E0F, 0x08090A0B, 0x04050607, 0x00010203);
+    __m512i a, b, perm;
+    int step;
+
+    for (step = 0; step < VEC_STEPS; step++)
+    {
+        vec_patterns_avx512(step, &a, &b);
+        perm = _mm512_and_si512(_mm512_add_epi32(vec_lanes_avx512(), _mm512_set1_epi32(step * 5 + 1)),
+                                _mm512_set1_epi32(15));
+        misr = vec_misr_avx512(misr, _mm512_shuffle_epi8(a, bytes));
+        misr = vec_misr_avx512(misr, _mm512_permutexvar_epi32(perm, b));
+        misr = vec_misr_avx512(misr, _mm512_permutex2var_epi32(a, _mm512_xor_si512(perm, _mm512_set1_epi32(0x13)), b));
+        misr = vec_misr_avx512(misr, _mm512_shuffle_i32x4(a, b, 0x4E));
+        misr = vec_misr_avx512(misr, _mm512_mask_blend_epi32((__mmask16)(0xA5C3u ^ (1u << (step & 15))), a, b));
+        misr = vec_misr_avx512(misr, _mm512_mask_blend_epi8(_mm512_movepi8_mask(_mm512_slli_epi32(b, step & 7)), a, b));
+        misr = vec_misr_avx512(misr, _mm512_unpacklo_epi16(a, b));
+    }
+    return VEC_CHECK(vec_fold_avx512(misr), VEC_PERMUTE_AVX512_GOLDEN);
+}
+
+/* Comparators: equality and signed/unsigned ordering into mask registers, minimum and maximum */
+AVX512_TARGET STL_SIGNATURE_T sbst_vec_compare_avx512(void)
+{
+    __m512i misr = _mm512_setzero_si512();
+    __m512i a, b, c;
+    int step;
+
+    for (step = 0; step < VEC_STEPS; step++)
+    {
+        vec_patterns_avx512(step, &a, &b);
+        /* c differs from a in one bit, shifted across the lanes and steps */
+        c = _mm512_xor_si512(a, _mm512_rolv_epi32(_mm512_set1_epi32(1 << (step & 7)), vec_lanes_avx512()));
+        misr = vec_misr_mask_avx512(misr, _mm512_cmpeq_epi32_mask(a, c));
+        misr = vec_misr_mask_avx512(misr, _mm512_cmpeq_epi32_mask(a, a));
+        misr = vec_misr_mask_avx512(misr, _mm512_cmpgt_epi32_mask(a, b));
+        misr = vec_misr_mask_avx512(misr, _mm512_cmplt_epu32_mask(b, c));
+        misr = vec_misr_avx512(misr, _mm512_movm_epi8(_mm512_cmpgt_epi8_mask(c, b)));
+        misr = vec_misr_avx512(misr, _mm512_movm_epi64(_mm512_cmpgt_epi64_mask(b, c)));
+        misr = vec_misr_avx512(misr, _mm512_min_epu32(a, b));
+        misr = vec_misr_avx512(misr, _mm512_max_epi32(a, c));
+    }
+    return VEC_CHECK(vec_fold_avx512(misr), VEC_COMPARE_AVX512_GOLDEN);
+}
+
+/* Fused multiply-add units: single and double precision, exact integer-valued operands */
+AVX512_TARGET STL_SIGNATURE_T sbst_vec_fma_avx512(void)
+{
+    __m512i misr = _mm512_setzero_si512();
+    __m512i a, b;
+    __m512 fa, fb, fc;
+    __m512d da, db, dc;
+    int step;
+
+    for (step = 0; step < VEC_STEPS; step++)
+    {
+        vec_patterns_avx512(step, &a, &b);
+        /* 24-bit (single) and 32-bit (double) integers are exact in the format */
+        fa = _mm512_cvtepi32_ps(_mm512_srai_epi32(a, 8));
+        fb = _mm512_cvtepi32_ps(_mm512_srai_epi32(b, 8));
+        fc = _mm512_cvtepi32_ps(_mm512_srai_epi32(_mm512_xor_si512(a, b), 8));
+        misr = vec_misr_avx512(misr, _mm512_castps_si512(_mm512_fmadd_ps(fa, fb, fc)));
+        misr = vec_misr_avx512(misr, _mm512_castps_si512(_mm512_fnmadd_ps(fb, fc, fa)));
+        da = _mm512_cvtepi32_pd(_mm512_castsi512_si256(a));
+        db = _mm512_cvtepi32_pd(_mm512_extracti64x4_epi64(b, 1));
+        dc = _mm512_cvtepi32_pd(_mm512_castsi512_si256(b));
+        misr = vec_misr_avx512(misr, _mm512_castpd_si512(_mm512_fmadd_pd(da, db, dc)));
+        misr = vec_misr_avx512(misr, _mm512_castpd_si512(_mm512_fmsub_pd(db, dc, da)));
+    }
+    return VEC_CHECK(vec_fold_avx512(misr), VEC_FMA_AVX512_GOLDEN);
+}
@@ -4,7 +4,7 @@
 #define __STL_RT_RELOCATION_H__
 
 // Include common configuration and type definitions
-#include "stl_config.h"
+#include "stl_cfg.h"
 #include "stl_types.h"
 
 #if (STL_RELOCATED > 0u)
@@ -29,40 +29,59 @@ extern STL_ADDR_T __stl_rom_start__;
 
 extern STL_ADDR_T _stl_lib;
 
-// Pointers used to mark the source (ROM) and target (RAM) relocation addresses.
-EXTERN_KEYWORD STL_ADDR_T *stl_src = &__stl_rom_start__;
-EXTERN_KEYWORD STL_ADDR_T *stl_ram_data = &__stl_ram_data_start__;
-EXTERN_KEYWORD STL_ADDR_T *stl_ram_code = &__stl_ram_code_start__;
-EXTERN_KEYWORD STL_ADDR_T *stl_lib = &_stl_lib;
+// Source (ROM) and target (RAM) relocation addresses.
+#define STL_RELOCATION_ROM ((const void *)&__stl_rom_start__)
+#define STL_RELOCATION_RAM_DATA ((void *)&__stl_ram_data_start__)
+#define STL_RELOCATION_RAM_CODE ((void *)&__stl_ram_code_start__)
+#define STL_RELOCATION_RAM_END ((void *)&__stl_ram_data_end__)
 
-#if (STL_RELOCATION_TABLE > 0u)
+/**
+ * @brief Build-time CRC-32C of the relocated image.
+ * It is computed on the linked image (post-link step) and passed to the compiler;
+ * it is checked after the copy when STL_RELOCATION_VERIFY is enabled.
+ */
+#ifndef STL_RELOCATION_CODE_CRC
+#define STL_RELOCATION_CODE_CRC 0u
+#endif /* STL_RELOCATION_CODE_CRC */
 
-#include "stl_types.h" // Ensure STL types are defined
+#if (STL_RELOCATION_TABLE > 0u)
 
 /**
  * @brief Structure defining a relocation entry.
  *
  * Each entry specifies the source address in ROM, the destination address in RAM,
- * and the size of the code/data block to relocate.
+ * the size of the code/data block to relocate and its build-time CRC-32C.
  */
 typedef struct
 {
-	STL_ADDR_T *src;   ///< Source address (ROM)
-	STL_ADDR_T *dst;   ///< Destination address (RAM)
-	STL_INT32U_T size; ///< Size of the block to relocate
+	const void *src;   ///< Source address (ROM)
+	void *dst;		   ///< Destination address (RAM)
+	uintptr_t size;	   ///< Size of the block to relocate, in bytes (may be a linker symbol)
+	STL_INT32U_T crc;  ///< CRC-32C of the block, computed at build time
 } STL_RelocationEntry_T;
 
+/**
+ * @brief Section of the relocation table.
+ * The linker script places it after every other ROM section, so that the table can be
+ * regenerated from the linked image and relinked without moving any other code or data.
+ */
+#define STL_RELOCATION_TABLE_SECTION __attribute__((section(".stl_relocation_table"), used))
+
 /**
  * @brief Table of relocation entries.
  *
  * This table defines the memory blocks that need to be relocated at runtime.
  * For each entry, data is copied from the source (ROM) to the destination (RAM).
+ * It is defined in stl_rt_relocation_table.c, generated from the linked image by
+ * scripts/gen_relocation_table.py (blocks sorted by load address, adjacent blocks merged).
+ */
+extern const STL_RelocationEntry_T STL_relocation_table[];
+
+/**
+ * @brief Number of entries of the relocation table.
+ * It is read from memory, so that the code does not depend on the size of the table.
  */
-EXTERN_KEYWORD STL_RelocationEntry_T relocationTable[] = {
-	// Relocate runtime test code: from ROM (stl_src) to RAM (stl_ram_code)
-	// This can be used to copy code portions that need to be executed from different RAM locations.
-	{stl_src, stl_ram_code, (STL_INT32U_T)(&__stl_ram_code_size__)},
-};
+extern const STL_INT32U_T STL_relocation_table_size;
 
 #endif /* STL_RELOCATION_TABLE */
 
@@ -3,6 +3,9 @@
 #ifndef __STL_SBST_CFG_H__
 #define __STL_SBST_CFG_H__
 
+#include "stl_cfg.h"
+#include "stl_types.h"
+
 /****************                    SBST Configuration                               ****************/
 
 /**
@@ -12,15 +15,175 @@
  * @note This value should be set according to the number of boot-time routines implemented.
  * @ingroup SBST
  */
+#ifndef STL_TOT_BT_ROUTINE
 #define STL_TOT_BT_ROUTINE 0u /* Total number of boot-time routines */
+#endif						  /*STL_TOT_BT_ROUTINE*/
+/**
+ * @brief Number of vector-unit runtime routines (sbst_vector.c).
+ * The vector tests need AVX2 or AVX-512: they are only scheduled with the ISA dispatch
+ * (STL_USE_ISA_DISPATCH), which skips them on a CPU without these extensions. They follow
+ * the scalar routines in the runtime routine table.
+ * @ingroup SBST
+ */
+#if (STL_USE_ISA_DISPATCH > 0u)
+#define STL_TOT_VECTOR_ROUTINE 5u /* Adders, multipliers, shuffle/blend, comparators, FMA */
+#else
+#define STL_TOT_VECTOR_ROUTINE 0u
+#endif /* STL_USE_ISA_DISPATCH */
 /**
  * @brief Total number of runtime routines.
  * This macro defines the total number of runtime routines available in the SBST.
  * It is used to allocate memory and manage the runtime routines in the SBST framework.
  * @note This value should be set according to the number of runtime routines implemented.
+ *       Each per-routine table below (STL_RT_ROUTINE_*) has one entry per runtime routine, in
+ *       the same order as the runtime routine table; their size is checked at build time.
+ * @ingroup SBST
+ */
+#ifndef STL_TOT_RT_ROUTINE
+#define STL_TOT_RT_ROUTINE (1u + STL_TOT_VECTOR_ROUTINE) /* Total number of runtime routines */
+#endif													 /*STL_TOT_RT_ROUTINE*/
+
+/**
+ * @brief Execution budget of each runtime routine, in CPU cycles.
+ * The software deadline monitor aborts a runtime routine that runs longer than its budget
+ * and records a timeout verdict for it.
+ * @ingroup SBST
+ */
+#ifndef STL_RT_ROUTINE_BUDGET
+#if (STL_TOT_VECTOR_ROUTINE > 0u)
+#define STL_RT_ROUTINE_BUDGET {100000u, 100000u, 100000u, 100000u, 100000u, 100000u} /* Budget of each runtime routine (cycles) */
+#else
+#define STL_RT_ROUTINE_BUDGET {100000u} /* Budget of each runtime routine (cycles) */
+#endif
+#endif /*STL_RT_ROUTINE_BUDGET*/
+
+/**
+ * @brief Watchdog timeout of each runtime routine, in watchdog ticks (microseconds on the host).
+ * With the fine-grained watchdog the scheduler arms the watchdog with the timeout of the
+ * routine before dispatching it and stops it afterward.
+ * @ingroup SBST
+ */
+#ifndef STL_RT_ROUTINE_WDG_TIMEOUT
+#if (STL_TOT_VECTOR_ROUTINE > 0u)
+#define STL_RT_ROUTINE_WDG_TIMEOUT {1000, 1000, 1000, 1000, 1000, 1000} /* Watchdog timeout of each runtime routine */
+#else
+#define STL_RT_ROUTINE_WDG_TIMEOUT {1000} /* Watchdog timeout of each runtime routine */
+#endif
+#endif /*STL_RT_ROUTINE_WDG_TIMEOUT*/
+
+/**
+ * @brief MPU profiles (test classes).
+ * Each profile is a constant set of MPU regions defined in stl_mpu_profiles.c.
+ * The application profile is restored after each test; the other profiles isolate
+ * a class of tests (e.g. the intrusive memory tests only see their test window).
+ * @ingroup SBST
+ */
+#define STL_MPU_PROFILE_APPLICATION 0u /* Regions of the application */
+#define STL_MPU_PROFILE_CPU 1u		   /* CPU tests: code and signature area only */
+#define STL_MPU_PROFILE_MEMORY 2u	   /* Intrusive memory tests: test window only */
+#define STL_MPU_NUM_PROFILES 3u		   /* Number of MPU profiles */
+
+/**
+ * @brief MPU profile of each runtime routine.
+ * @ingroup SBST
+ */
+#ifndef STL_RT_ROUTINE_MPU_PROFILE
+#if (STL_TOT_VECTOR_ROUTINE > 0u)
+#define STL_RT_ROUTINE_MPU_PROFILE                                                                                     \
+	{STL_MPU_PROFILE_CPU, STL_MPU_PROFILE_CPU, STL_MPU_PROFILE_CPU,                                                    \
+	 STL_MPU_PROFILE_CPU, STL_MPU_PROFILE_CPU, STL_MPU_PROFILE_CPU} /* MPU profile of each runtime routine */
+#else
+#define STL_RT_ROUTINE_MPU_PROFILE {STL_MPU_PROFILE_CPU} /* MPU profile of each runtime routine */
+#endif
+#endif /*STL_RT_ROUTINE_MPU_PROFILE*/
+
+/**
+ * @brief Memory footprint of each runtime routine, in bytes (STL_USE_THROTTLE).
+ * The bytes a memory-class routine touches per invocation (e.g. STL_MARCH_CHUNK_BYTES for the
+ * March test), taken from the token bucket of the CPU before it is dispatched; 0 for the
+ * routines that are not throttled.
+ * @ingroup SBST
+ */
+#ifndef STL_RT_ROUTINE_MEM_BYTES
+#define STL_RT_ROUTINE_MEM_BYTES {0u} /* Memory footprint of each runtime routine (bytes), none by default */
+#endif									/*STL_RT_ROUTINE_MEM_BYTES*/
+
+/**
+ * @brief Synchronized window of each runtime routine (STL_USE_SYNC_WINDOW).
+ * 1u for the routines that must run while all the participating CPUs are inside the STL
+ * (uncore and interconnect tests): they start and end at a barrier of these CPUs. The flagged
+ * routines must be scheduled in the same order on every participating CPU.
+ * @ingroup SBST
+ */
+#ifndef STL_RT_ROUTINE_SYNC_WINDOW
+#define STL_RT_ROUTINE_SYNC_WINDOW {0u} /* Synchronized window of each runtime routine, none by default */
+#endif									  /*STL_RT_ROUTINE_SYNC_WINDOW*/
+
+/**
+ * @brief Redundancy of each runtime routine (STL_USE_REDUNDANCY).
+ * STL_REDUNDANCY_PAIR for the routines executed once on each CPU of a pair, STL_REDUNDANCY_TWICE
+ * for the routines executed twice on the same CPU, 0u for the others (see stl_redundancy.h).
  * @ingroup SBST
  */
-#define STL_TOT_RT_ROUTINE 1u /* Total number of runtime routines */
+#ifndef STL_RT_ROUTINE_REDUNDANCY
+#define STL_RT_ROUTINE_REDUNDANCY {0u} /* Redundancy of each runtime routine, none by default */
+#endif								   /*STL_RT_ROUTINE_REDUNDANCY*/
+
+/**
+ * @brief Routine tables of the default context, fixed at build time (STL_CONST_TEST_TABLES).
+ * SBST_RT and SBST_BT are then initialized with these routines and placed in read-only memory,
+ * and the sequential scheduler calls the routines directly.
+ * @note STL_TOT_RT_ROUTINE (STL_TOT_BT_ROUTINE) entries per CPU, in the same order as the other
+ *       per-routine tables.
+ * @ingroup SBST
+ */
+#ifndef STL_RT_ROUTINE_TABLE
+#define STL_RT_ROUTINE_TABLE {test_adder} /* Runtime routines */
+#endif										/*STL_RT_ROUTINE_TABLE*/
+#ifndef STL_BT_ROUTINE_TABLE
+#define STL_BT_ROUTINE_TABLE {} /* Boot-time routines (none) */
+#endif							/*STL_BT_ROUTINE_TABLE*/
+
+/**
+ * @brief Variants of each runtime routine per ISA level (STL_USE_ISA_DISPATCH).
+ * The variants of a routine are listed from the widest ISA level to the baseline, each with the
+ * STL_CPU_ISA_* extensions it executes; STL_init keeps the first one the CPU supports, and a
+ * routine without supported variant is skipped. The variants of test_adder compute the same
+ * signature; each variant of a vector test checks its own golden signature.
+ * @ingroup SBST
+ */
+#define STL_SBST_MAX_VARIANTS 4u /* Maximum number of variants of a runtime routine */
+#ifndef STL_RT_ROUTINE_VARIANTS
+#define STL_RT_ROUTINE_VARIANTS                                                                                        \
+	{                                                                                                                  \
+		{{STL_CPU_ISA_AVX512, test_adder_avx512},                                                                      \
+		 {STL_CPU_ISA_AVX2, test_adder_avx2},                                                                          \
+		 {STL_CPU_ISA_SSE42, test_adder_sse42},                                                                        \
+		 {0u, test_adder}},                                                                                            \
+		{{STL_CPU_ISA_AVX512, sbst_vec_add_avx512}, {STL_CPU_ISA_AVX2, sbst_vec_add_avx2}},                            \
+		{{STL_CPU_ISA_AVX512, sbst_vec_mul_avx512}, {STL_CPU_ISA_AVX2, sbst_vec_mul_avx2}},                            \
+		{{STL_CPU_ISA_AVX512, sbst_vec_permute_avx512}, {STL_CPU_ISA_AVX2, sbst_vec_permute_avx2}},                    \
+		{{STL_CPU_ISA_AVX512, sbst_vec_compare_avx512}, {STL_CPU_ISA_AVX2, sbst_vec_compare_avx2}},                    \
+		{{STL_CPU_ISA_AVX512, sbst_vec_fma_avx512}, {STL_CPU_ISA_AVX2 | STL_CPU_ISA_FMA, sbst_vec_fma_avx2}},          \
+	} /* Variants of each runtime routine */
+#endif /*STL_RT_ROUTINE_VARIANTS*/
+
+STL_SIGNATURE_T test_adder(void);
+STL_SIGNATURE_T test_adder_sse42(void);
+STL_SIGNATURE_T test_adder_avx2(void);
+STL_SIGNATURE_T test_adder_avx512(void);
+
+/* Vector-unit tests (sbst_vector.c) */
+STL_SIGNATURE_T sbst_vec_add_avx2(void);
+STL_SIGNATURE_T sbst_vec_mul_avx2(void);
+STL_SIGNATURE_T sbst_vec_permute_avx2(void);
+STL_SIGNATURE_T sbst_vec_compare_avx2(void);
+STL_SIGNATURE_T sbst_vec_fma_avx2(void);
+STL_SIGNATURE_T sbst_vec_add_avx512(void);
+STL_SIGNATURE_T sbst_vec_mul_avx512(void);
+STL_SIGNATURE_T sbst_vec_permute_avx512(void);
+STL_SIGNATURE_T sbst_vec_compare_avx512(void);
+STL_SIGNATURE_T sbst_vec_fma_avx512(void);
 
 #endif /*__STL_SBST_CFG_H__*/
 #endif /*__STL__*/
@@ -0,0 +1,374 @@
+#if __STL__
+
+/**
+ * @file stl_cache.c
+ * @brief Implementation of the cache subsystem SBSTs (x86_64).
+ *
+ * The eviction set of set s of a level is made of the lines at buffer + s x line + i x way size,
+ * i = 0 .. 2 x ways - 1, the buffer being aligned on the way size. The lines are visited in an
+ * order shuffled per set, so that the stride prefetchers cannot follow the walks. The first two
+ * words of a line link the walks (resident half, whole set), the other words hold the patterns.
+ *
+ * The walks are dependent loads timed with the cycle counter between load fences; the cost of
+ * the measurement itself is calibrated at initialization and removed. Each walk is repeated
+ * STL_CACHE_TIMING_REPEATS times and the fastest one is kept: an interrupt or a prefetch can
+ * only slow a walk down.
+ *
+ * @see stl_cache.h
+ */
+
+#ifndef __STL_CACHE_MODULE__
+#define __STL_CACHE_MODULE__
+
+#include <immintrin.h>
+
+#include "stl_cache.h"
+#include "stl_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+#if (STL_USE_CACHE_TEST > 0u)
+
+#define STL_CACHE_WALK_LAPS 4u		 /* Laps of the eviction set per timed walk */
+#define STL_CACHE_LINK_RESIDENT 0u /* Word of a line linking the walk of the resident half */
+#define STL_CACHE_LINK_ALL 1u		 /* Word of a line linking the walk of the whole eviction set */
+#define STL_CACHE_FIRST_PATTERN 2u /* First pattern word of a line */
+#define STL_CACHE_PATTERN 0xA5A5A5A5A5A5A5A5ull
+
+/*
+ * Replacement check: per access, the walk of the whole eviction set must be at least 5/4 of
+ * the walk of the resident half. At least half its accesses miss, so the expected ratio is
+ * (hit + miss) / (2 x hit), above 2 for the L1D and the L2 of current cores.
+ */
+#define STL_CACHE_EVICT_NUM 5u
+#define STL_CACHE_EVICT_DEN 4u
+
+/* The loads of a walk complete between the reads of the cycle counter */
+#define STL_CACHE_FENCE() _mm_lfence()
+
+/**
+ * @typedef STL_CACHE_T
+ * @brief State of the cache SBSTs.
+ *
+ * @var STL_CACHE_T::buffer
+ * Eviction-set buffer (STL_NULL until initialized).
+ * @var STL_CACHE_T::page_size
+ * Physically contiguous granule of the buffer.
+ * @var STL_CACHE_T::overhead
+ * Cycles of an empty timed walk.
+ * @var STL_CACHE_T::levels
+ * State and statistics of each level.
+ */
+typedef struct
+{
+	uint8_t *buffer;
+	STL_INT32U_T page_size;
+	STL_CYCLES_T overhead;
+	STL_CACHE_STATS_T levels[STL_CPU_CACHE_LEVELS];
+} STL_CACHE_T;
+
+STATIC_KEYWORD STL_CACHE_T cache;
+
+/**
+ * @brief Lines of the eviction set under test, in walk order.
+ */
+STATIC_KEYWORD uint64_t *cache_lines[2u * STL_CACHE_MAX_WAYS];
+
+/**
+ * @brief End of the last walk, kept so that the loads are not optimized out.
+ */
+STATIC_KEYWORD uint64_t *volatile cache_sink;
+
+/**
+ * @brief Times the fastest of STL_CACHE_TIMING_REPEATS walks of a linked list of lines.
+ *
+ * @param start First line of the walk
+ * @param link Word of a line holding the address of the next one
+ * @param loads Number of loads of a walk
+ * @return Cycles of the fastest walk, measurement cost removed
+ */
+STATIC_KEYWORD STL_CYCLES_T STL_cache_walk(uint64_t *start, STL_INT32U_T link, STL_INT32U_T loads)
+{
+	STL_CYCLES_T best = ~(STL_CYCLES_T)0u;
+	STL_CYCLES_T t0;
+	STL_CYCLES_T t1;
+	uint64_t *p;
+	STL_INT32U_T r;
+	STL_INT32U_T i;
+
+	for (r = 0u; r < STL_CACHE_TIMING_REPEATS; r++)
+	{
+		p = start;
+		STL_CACHE_FENCE();
+		t0 = STL_TSSP_CPU_get_cycles();
+		STL_CACHE_FENCE();
+		for (i = 0u; i < loads; i++)
+		{
+			p = (uint64_t *)(uintptr_t)p[link];
+		}
+		STL_CACHE_FENCE();
+		t1 = STL_TSSP_CPU_get_cycles();
+		if (t1 - t0 < best)
+		{
+			best = t1 - t0;
+		}
+		cache_sink = p;
+	}
+	return (best > cache.overhead) ? best - cache.overhead : 0u;
+}
+
+/**
+ * @brief Checks the pattern words of the lines of the eviction set.
+ *
+ * @param count Number of lines
+ * @param words Words per line
+ * @param pattern Pattern of the sweep (XORed with the address of each word)
+ * @return STL_TRUE if every word holds its pattern
+ */
+STATIC_KEYWORD STL_BOOL STL_cache_check(STL_INT32U_T count, STL_INT32U_T words, uint64_t pattern)
+{
+	uint64_t diff = 0u;
+	STL_INT32U_T i;
+	STL_INT32U_T w;
+
+	for (i = 0u; i < count; i++)
+	{
+		for (w = STL_CACHE_FIRST_PATTERN; w < words; w++)
+		{
+			diff |= ((volatile uint64_t *)cache_lines[i])[w] ^ ((uint64_t)(uintptr_t)&cache_lines[i][w] ^ pattern);
+		}
+		diff |= cache_lines[i][STL_CACHE_LINK_ALL] ^ (uint64_t)(uintptr_t)cache_lines[(i + 1u) % count];
+	}
+	return (diff == 0u) ? STL_TRUE : STL_FALSE;
+}
+
+/**
+ * @brief Tests one set of a level.
+ *
+ * @param level State of the level
+ * @param set Set under test
+ * @return STL_TRUE if the set passed
+ */
+STATIC_KEYWORD STL_BOOL STL_cache_test_set(STL_CACHE_STATS_T *level, STL_INT32U_T set)
+{
+	STL_INT32U_T line = level->info.line;
+	STL_INT32U_T words = line / sizeof(uint64_t);
+	STL_INT32U_T way_size = level->info.sets * line;
+	STL_INT32U_T resident = level->info.ways / 2u;
+	STL_INT32U_T count = 2u * level->info.ways;
+	uint64_t pattern = ((level->sweeps & 1u) == 0u) ? STL_CACHE_PATTERN : ~STL_CACHE_PATTERN;
+	uint32_t seed = set * 2654435761u + 1u;
+	STL_BOOL pass = STL_TRUE;
+	STL_ERROR_T err;
+	uint64_t *tmp;
+	STL_INT32U_T i;
+	STL_INT32U_T j;
+	STL_INT32U_T w;
+
+	/* Eviction set in a shuffled order */
+	for (i = 0u; i < count; i++)
+	{
+		cache_lines[i] = (uint64_t *)(cache.buffer + set * line + i * way_size);
+	}
+	for (i = count - 1u; i > 0u; i--)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		j = (seed >> 8) % (i + 1u);
+		tmp = cache_lines[i];
+		cache_lines[i] = cache_lines[j];
+		cache_lines[j] = tmp;
+	}
+	for (i = 0u; i < count; i++)
+	{
+		cache_lines[i][STL_CACHE_LINK_RESIDENT] = (uint64_t)(uintptr_t)cache_lines[(i + 1u) % resident];
+		cache_lines[i][STL_CACHE_LINK_ALL] = (uint64_t)(uintptr_t)cache_lines[(i + 1u) % count];
+		for (w = STL_CACHE_FIRST_PATTERN; w < words; w++)
+		{
+			cache_lines[i][w] = (uint64_t)(uintptr_t)&cache_lines[i][w] ^ pattern;
+		}
+		STL_TSSP_CPU_cache_flush(cache_lines[i], line);
+	}
+
+	/* Replacement: the resident half hits, the whole set overflows its ways */
+	(void)STL_cache_walk(cache_lines[0], STL_CACHE_LINK_RESIDENT, resident);
+	level->hit_cycles = STL_cache_walk(cache_lines[0], STL_CACHE_LINK_RESIDENT, resident * STL_CACHE_WALK_LAPS);
+	(void)STL_cache_walk(cache_lines[0], STL_CACHE_LINK_ALL, count);
+	level->evict_cycles = STL_cache_walk(cache_lines[0], STL_CACHE_LINK_ALL, count * STL_CACHE_WALK_LAPS);
+	if (level->congruent == STL_TRUE &&
+		level->evict_cycles * resident * STL_CACHE_EVICT_DEN <= level->hit_cycles * count * STL_CACHE_EVICT_NUM)
+	{
+		level->replacement_faults++;
+		pass = STL_FALSE;
+	}
+
+	/* Data: through the cache, then complemented with dirty evictions and read back from memory */
+	if (STL_cache_check(count, words, pattern) == STL_FALSE)
+	{
+		level->data_faults++;
+		pass = STL_FALSE;
+	}
+	for (i = 0u; i < count; i++)
+	{
+		for (w = STL_CACHE_FIRST_PATTERN; w < words; w++)
+		{
+			cache_lines[i][w] = ~cache_lines[i][w];
+		}
+	}
+	for (i = 0u; i < count; i++)
+	{
+		STL_TSSP_CPU_cache_flush(cache_lines[i], line);
+	}
+	if (STL_cache_check(count, words, ~pattern) == STL_FALSE)
+	{
+		level->data_faults++;
+		pass = STL_FALSE;
+	}
+	for (i = 0u; i < count; i++)
+	{
+		STL_TSSP_CPU_cache_invalidate(cache_lines[i], line, &err);
+	}
+	if (pass == STL_FALSE)
+	{
+		level->last_fault_set = set;
+	}
+	return pass;
+}
+
+/**
+ * @brief Tests the next sets of a level.
+ *
+ * @param level Cache level
+ * @return Signature of the step
+ */
+STATIC_KEYWORD STL_SIGNATURE_T STL_cache_test_level(STL_CPU_CACHE_LEVEL_T level)
+{
+	STL_CACHE_STATS_T *state = &cache.levels[level];
+	STL_BOOL pass = STL_TRUE;
+	STL_INT32U_T n;
+
+	if (cache.buffer == STL_NULL || state->tested == STL_FALSE)
+	{
+		return STL_SIGNATURE_SKIPPED;
+	}
+	for (n = 0u; n < STL_CACHE_SETS_PER_STEP; n++)
+	{
+		if (STL_cache_test_set(state, state->next_set) == STL_FALSE)
+		{
+			pass = STL_FALSE;
+		}
+		state->next_set++;
+		if (state->next_set == state->info.sets)
+		{
+			state->next_set = 0u;
+			state->sweeps++;
+		}
+	}
+	return (pass == STL_TRUE) ? STL_CACHE_SIGNATURE : STL_SIGNATURE_MISMATCH;
+}
+
+/**
+ * @brief Initializes the cache SBSTs.
+ *
+ * @param err Error code
+ * @return None
+ */
+void STL_cache_init(STL_ERROR_T *err)
+{
+	STL_CACHE_STATS_T *state;
+	STL_INT32U_T level;
+	STL_INT32U_T way_size;
+
+	STL_cache_deinit();
+	cache.buffer = STL_TSSP_OS_cache_buffer_map(STL_CACHE_BUFFER_BYTES, &cache.page_size, err);
+	if (*err != STL_ERROR_NONE)
+	{
+		cache.buffer = STL_NULL;
+		return;
+	}
+	for (level = 0u; level < STL_CPU_CACHE_LEVELS; level++)
+	{
+		state = &cache.levels[level];
+		STL_TSSP_CPU_cache_get_info((STL_CPU_CACHE_LEVEL_T)level, &state->info, err);
+		if (*err != STL_ERROR_NONE)
+		{
+			return;
+		}
+		way_size = state->info.sets * state->info.line;
+		/* Two pointers and a pattern per line, a resident half of at least one line */
+		state->tested = (state->info.size > 0u && state->info.line >= 4u * sizeof(uint64_t) &&
+						 state->info.ways >= 2u && state->info.ways <= STL_CACHE_MAX_WAYS &&
+						 2u * state->info.ways * way_size <= STL_CACHE_BUFFER_BYTES)
+							? STL_TRUE
+							: STL_FALSE;
+		state->congruent = (way_size <= cache.page_size) ? STL_TRUE : STL_FALSE;
+		state->laps = STL_CACHE_WALK_LAPS;
+	}
+
+	/* Cost of an empty timed walk */
+	cache.overhead = 0u;
+	cache.overhead = STL_cache_walk(STL_NULL, STL_CACHE_LINK_ALL, 0u);
+	*err = STL_ERROR_NONE;
+}
+
+/**
+ * @brief Unmaps the buffer of the cache SBSTs and clears their statistics.
+ *
+ * @return None
+ */
+void STL_cache_deinit(void)
+{
+	STL_INT32U_T level;
+
+	if (cache.buffer != STL_NULL)
+	{
+		STL_TSSP_OS_cache_buffer_unmap(cache.buffer, STL_CACHE_BUFFER_BYTES);
+		cache.buffer = STL_NULL;
+	}
+	for (level = 0u; level < STL_CPU_CACHE_LEVELS; level++)
+	{
+		cache.levels[level] = (STL_CACHE_STATS_T){0};
+	}
+}
+
+/**
+ * @brief L1 data cache pseudo-test.
+ *
+ * @return Signature of the step
+ */
+STL_SIGNATURE_T STL_cache_l1d_test(void)
+{
+	return STL_cache_test_level(STL_CPU_CACHE_L1D);
+}
+
+/**
+ * @brief L2 cache pseudo-test.
+ *
+ * @return Signature of the step
+ */
+STL_SIGNATURE_T STL_cache_l2_test(void)
+{
+	return STL_cache_test_level(STL_CPU_CACHE_L2);
+}
+
+/**
+ * @brief Retrieves the statistics of the cache SBST of a level.
+ *
+ * @param level Cache level
+ * @param stats Pointer to the statistics to fill
+ * @param err Error code
+ * @return None
+ */
+void STL_cache_get_stats(STL_CPU_CACHE_LEVEL_T level, STL_CACHE_STATS_T *stats, STL_ERROR_T *err)
+{
+	if (level >= STL_CPU_CACHE_LEVELS)
+	{
+		*err = STL_INDEX_OUT_OF_BOUNDS;
+		return;
+	}
+	*stats = cache.levels[level];
+	*err = STL_ERROR_NONE;
+}
+
+#endif /*STL_USE_CACHE_TEST*/
+#endif /*__STL_CACHE_MODULE__*/
+#endif /*__STL__*/
@@ -0,0 +1,142 @@
+/**
+ * @file stl_cache.h
+ * @brief Header file for the cache subsystem SBSTs.
+ *
+ * The cache SBSTs check the L1 data cache and the L2 cache set by set with eviction sets: the
+ * 2 x ways lines of a buffer that map to the set under test (addresses one way size apart).
+ * For each set:
+ *
+ *   - the lines of the eviction set are filled with address-dependent patterns and flushed;
+ *   - half the ways are walked repeatedly (dependent loads): the lines stay resident and the
+ *     walk gives the hit time of the level;
+ *   - the whole eviction set is walked: it overflows the set, so that whatever the replacement
+ *     policy at least half the accesses of a walk miss the level. A walk that is not slower
+ *     than the resident one per access shows that the set does not hold its lines (or holds
+ *     more than its ways): it is a replacement fault;
+ *   - the patterns are checked, complemented while the set is overflowing (dirty evictions),
+ *     flushed to memory and checked again: a mismatch is a data fault;
+ *   - the lines are invalidated, so that the set is left without STL data.
+ *
+ * The set of a line depends on its physical address: the replacement is only checked when the
+ * way size of the level does not exceed the physically contiguous granule of the buffer (huge
+ * pages on the host); otherwise only the data is checked.
+ *
+ * Each invocation tests STL_CACHE_SETS_PER_STEP sets, a full sweep of the level takes
+ * sets / STL_CACHE_SETS_PER_STEP invocations.
+ *
+ * @details
+ * - STL_cache_init: Reads the cache geometry and maps the eviction-set buffer.
+ * - STL_cache_deinit: Unmaps the buffer.
+ * - STL_cache_l1d_test / STL_cache_l2_test: Test the next sets of a level (pseudo-test entry points).
+ * - STL_cache_get_stats: Returns the sweeps, the faults and the timings of a level.
+ *
+ * @note The tests measure timings: they are meant to run with interrupts masked, as the other
+ *       runtime tests. A level absent, or too large for STL_CACHE_BUFFER_BYTES, reads as not run.
+ */
+#if __STL__
+#ifndef __STL_CACHE_H__
+#define __STL_CACHE_H__
+
+#include "stl_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+#if (STL_USE_CACHE_TEST > 0u)
+
+#define STL_CACHE_SIGNATURE 0x5CAC5CACu /* Signature of a cache step without fault */
+#define STL_CACHE_MAX_WAYS 32u		   /* Largest associativity tested */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /*__cplusplus*/
+
+	/**
+	 * @brief Statistics of the cache SBST of a level.
+	 *
+	 * @var STL_CACHE_STATS_T::info
+	 * Geometry of the level.
+	 * @var STL_CACHE_STATS_T::tested
+	 * The level is present and its eviction sets fit in the buffer.
+	 * @var STL_CACHE_STATS_T::congruent
+	 * The eviction sets are congruent in physical memory: the replacement is checked.
+	 * @var STL_CACHE_STATS_T::sweeps
+	 * Number of full sweeps of the sets.
+	 * @var STL_CACHE_STATS_T::next_set
+	 * Next set tested.
+	 * @var STL_CACHE_STATS_T::data_faults
+	 * Number of sets found with corrupted data.
+	 * @var STL_CACHE_STATS_T::replacement_faults
+	 * Number of sets whose eviction set did not evict.
+	 * @var STL_CACHE_STATS_T::last_fault_set
+	 * Last set found faulty.
+	 * @var STL_CACHE_STATS_T::hit_cycles
+	 * Cycles of the fastest walk of the resident half of the last eviction set (ways / 2 loads per lap).
+	 * @var STL_CACHE_STATS_T::evict_cycles
+	 * Cycles of the fastest walk of the last eviction set (2 x ways loads per lap).
+	 * @var STL_CACHE_STATS_T::laps
+	 * Laps of the eviction set per timed walk.
+	 */
+	typedef struct
+	{
+		STL_CPU_CACHE_INFO_T info;
+		STL_BOOL tested;
+		STL_BOOL congruent;
+		STL_INT32U_T sweeps;
+		STL_INT32U_T next_set;
+		STL_INT32U_T data_faults;
+		STL_INT32U_T replacement_faults;
+		STL_INT32U_T last_fault_set;
+		STL_CYCLES_T hit_cycles;
+		STL_CYCLES_T evict_cycles;
+		STL_INT32U_T laps;
+	} STL_CACHE_STATS_T;
+
+	/**
+	 * @brief Initializes the cache SBSTs.
+	 *
+	 * @param err Error code, set to STL_ERROR_CACHE if the buffer cannot be mapped
+	 * @return None
+	 */
+	void STL_cache_init(STL_ERROR_T *err);
+
+	/**
+	 * @brief Unmaps the buffer of the cache SBSTs; the tests read as not run afterwards.
+	 *
+	 * @return None
+	 */
+	void STL_cache_deinit(void);
+
+	/**
+	 * @brief L1 data cache pseudo-test: tests the next sets of the L1D.
+	 *
+	 * @return STL_SIGNATURE_MISMATCH if a set tested during this step is faulty,
+	 *         STL_SIGNATURE_SKIPPED if the level is not tested, STL_CACHE_SIGNATURE otherwise
+	 */
+	STL_SIGNATURE_T STL_cache_l1d_test(void);
+
+	/**
+	 * @brief L2 cache pseudo-test: tests the next sets of the L2.
+	 *
+	 * @return STL_SIGNATURE_MISMATCH if a set tested during this step is faulty,
+	 *         STL_SIGNATURE_SKIPPED if the level is not tested, STL_CACHE_SIGNATURE otherwise
+	 */
+	STL_SIGNATURE_T STL_cache_l2_test(void);
+
+	/**
+	 * @brief Retrieves the statistics of the cache SBST of a level.
+	 *
+	 * @param level Cache level
+	 * @param stats Pointer to the statistics to fill
+	 * @param err Error code, set to STL_INDEX_OUT_OF_BOUNDS for an invalid level
+	 * @return None
+	 */
+	void STL_cache_get_stats(STL_CPU_CACHE_LEVEL_T level, STL_CACHE_STATS_T *stats, STL_ERROR_T *err);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /*STL_USE_CACHE_TEST*/
+#endif /*__STL_CACHE_H__*/
+#endif /*__STL__*/
@@ -0,0 +1,112 @@
+/**
+ * @file stl_coherence.h
+ * @brief Header file for the atomic and coherence SBSTs (multicore).
+ *
+ * The coherence SBST is a cooperative test: the participating CPUs run it at the same time,
+ * each one from its own runtime test table, and hammer a few shared lines with atomic
+ * operations in known patterns. A round of the test is made of three barriers:
+ *
+ *   - arrival: the order of arrival gives each CPU its participant number p;
+ *   - hammer: each CPU runs STL_COHERENCE_ITERATIONS operations of each kind on the shared
+ *     lines: fetch-and-add of p + 1 to a counter, compare-and-swap increments of a second
+ *     counter, lock-prefixed increments of a third one (LR/SC loops on RISC-V), set and clear
+ *     of its own bit of a mask word with the old bit checked, exchanges of unique tokens, and
+ *     stores of its own word of a line shared by all the CPUs;
+ *   - check (second barrier): each CPU checks the final values against their closed forms
+ *     (K x N(N+1)/2, N x K, ...) and publishes its partial signature in its own line;
+ *   - combine (third barrier): each CPU combines the partial signatures of all the participants,
+ *     in participant order, and checks the exchanged tokens for conservation.
+ *
+ * Every CPU returns the combined signature of the round, or STL_SIGNATURE_MISMATCH when it
+ * differs from the one of a fault-free round: STL_em_rt_get_combined then checks that all the
+ * participants recorded the same signature.
+ *
+ * A CPU that waits more than STL_COHERENCE_TIMEOUT_CYCLES at a barrier aborts the round: the
+ * test fails on all the CPUs until STL_coherence_init is called again.
+ *
+ * @details
+ * - STL_coherence_init: Sets the number of participants and resets the shared lines.
+ * - STL_coherence_test: Runs one round (pseudo-test entry point, on each participating CPU).
+ * - STL_coherence_get_stats: Returns the rounds, the faults, the contention and the wait times.
+ *
+ * @note The test must be registered in the runtime table of each participating CPU, and only
+ *       there: a CPU that never arrives times the others out.
+ */
+#if __STL__
+#ifndef __STL_COHERENCE_H__
+#define __STL_COHERENCE_H__
+
+#include "stl_cfg.h"
+#include "stl_types.h"
+
+#if (STL_USE_COHERENCE_TEST > 0u)
+
+#define STL_COHERENCE_SIGNATURE 0xC0DE5EEDu /* Seed of the partial signatures */
+#define STL_COHERENCE_MAX_CPUS 32u		   /* Participants of a round (bits of the mask word) */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /*__cplusplus*/
+
+	/**
+	 * @brief Statistics of the coherence SBST.
+	 *
+	 * @var STL_COHERENCE_STATS_T::participants
+	 * CPUs taking part in each round.
+	 * @var STL_COHERENCE_STATS_T::rounds
+	 * Rounds completed (counted by participant 0).
+	 * @var STL_COHERENCE_STATS_T::faults
+	 * Faulty rounds, counted once by each participant that found the round faulty.
+	 * @var STL_COHERENCE_STATS_T::timeouts
+	 * Barriers aborted after STL_COHERENCE_TIMEOUT_CYCLES.
+	 * @var STL_COHERENCE_STATS_T::cas_retries
+	 * Failed compare-and-swap attempts (contention on the shared lines).
+	 * @var STL_COHERENCE_STATS_T::wait_cycles
+	 * Cycles spent by the participants waiting at the barriers.
+	 * @var STL_COHERENCE_STATS_T::hammer_cycles
+	 * Cycles spent by the participants in the atomic operations.
+	 */
+	typedef struct
+	{
+		STL_INT32U_T participants;
+		STL_INT32U_T rounds;
+		STL_INT32U_T faults;
+		STL_INT32U_T timeouts;
+		STL_CYCLES_T cas_retries;
+		STL_CYCLES_T wait_cycles;
+		STL_CYCLES_T hammer_cycles;
+	} STL_COHERENCE_STATS_T;
+
+	/**
+	 * @brief Initializes the coherence SBST; no participant may be running a round.
+	 *
+	 * @param participants Number of CPUs running the test, 1 to STL_COHERENCE_MAX_CPUS
+	 * @param err Error code, set to STL_CPU_OUT_OF_BOUNDS for an invalid number of participants
+	 * @return None
+	 */
+	void STL_coherence_init(STL_INT32U_T participants, STL_ERROR_T *err);
+
+	/**
+	 * @brief Coherence pseudo-test: runs one round with the other participants.
+	 *
+	 * @return The combined signature of the round, STL_SIGNATURE_MISMATCH if it is wrong or if
+	 *         the round timed out, STL_SIGNATURE_SKIPPED if the test is not initialized
+	 */
+	STL_SIGNATURE_T STL_coherence_test(void);
+
+	/**
+	 * @brief Retrieves the statistics of the coherence SBST.
+	 *
+	 * @param stats Pointer to the statistics to fill
+	 * @return None
+	 */
+	void STL_coherence_get_stats(STL_COHERENCE_STATS_T *stats);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /*STL_USE_COHERENCE_TEST*/
+#endif /*__STL_COHERENCE_H__*/
+#endif /*__STL__*/
@@ -0,0 +1,365 @@
+#if __STL__
+
+/**
+ * @file stl_march.c
+ * @brief Implementation of the transparent March RAM test (x86_64).
+ *
+ * The test walks the regions in order with a cursor (region, offset). Each step takes the
+ * next block of up to STL_MARCH_CHUNK_BYTES bytes, copies it into the save area and runs the
+ * March elements on it, the saved copy giving the expected contents of every read. When the
+ * last block of the last region is done, the sweep is complete.
+ *
+ * The elements work on vector words: each word is read and compared with the expected value
+ * (the saved contents, or their complement), and the complement of the value read is written
+ * back. The differences are OR-accumulated in a register and checked once per element. A
+ * compiler barrier separates the elements so that every read of an element goes to memory.
+ * The kernel is selected at initialization: AVX2 (32-byte words) when the ISA dispatch reports
+ * it, SSE2 (16-byte words, always present on x86_64) otherwise.
+ *
+ * @see stl_march.h
+ */
+
+#ifndef __STL_MARCH_MODULE__
+#define __STL_MARCH_MODULE__
+
+#include <immintrin.h>
+
+#include "stl_march.h"
+#include "stl_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+#if (STL_USE_ISA_DISPATCH > 0u)
+#include "stl_al_cpu.h"
+#endif /* STL_USE_ISA_DISPATCH */
+
+#if (STL_USE_MARCH > 0u)
+
+/* The compiler must not keep the words of the block in registers across the elements */
+#define STL_MARCH_BARRIER() __asm__ volatile("" : : : "memory")
+
+/**
+ * @typedef STL_MARCH_KERNEL_T
+ * @brief March C- on one block: returns STL_TRUE when every read matched the saved contents.
+ */
+typedef STL_BOOL (*STL_MARCH_KERNEL_T)(void *block, void *save, STL_INT32U_T size);
+
+/**
+ * @typedef STL_MARCH_T
+ * @brief State of the March test.
+ *
+ * @var STL_MARCH_T::regions
+ * Regions to test (STL_NULL until initialized).
+ * @var STL_MARCH_T::count
+ * Number of regions.
+ * @var STL_MARCH_T::kernel
+ * March C- kernel of the ISA level of the CPU.
+ * @var STL_MARCH_T::region
+ * Region under test.
+ * @var STL_MARCH_T::offset
+ * Offset of the next block in the region.
+ * @var STL_MARCH_T::sweep_start
+ * Cycle counter value at the first step of the sweep.
+ * @var STL_MARCH_T::sweep_steps
+ * Steps of the sweep in progress.
+ * @var STL_MARCH_T::sweep_busy
+ * Cycles spent in the steps of the sweep in progress.
+ * @var STL_MARCH_T::stats
+ * Statistics of the completed sweeps.
+ */
+typedef struct
+{
+	const STL_MARCH_REGION_T *regions;
+	STL_SIZE_T count;
+	STL_MARCH_KERNEL_T kernel;
+	STL_SIZE_T region;
+	STL_INT32U_T offset;
+	STL_CYCLES_T sweep_start;
+	STL_INT32U_T sweep_steps;
+	STL_CYCLES_T sweep_busy;
+	STL_MARCH_STATS_T stats;
+} STL_MARCH_T;
+
+STATIC_KEYWORD STL_MARCH_T march;
+
+/**
+ * @brief Save area of the block under test.
+ */
+STATIC_KEYWORD __attribute__((aligned(STL_MARCH_ALIGN))) uint8_t march_save[STL_MARCH_CHUNK_BYTES];
+
+/**
+ * @brief March C- on 16-byte words (SSE2).
+ *
+ * @param block Block under test
+ * @param save Save area
+ * @param size Size of the block in bytes
+ * @return STL_TRUE if every read matched the saved contents
+ */
+STATIC_KEYWORD STL_BOOL STL_march_kernel_sse2(void *block, void *save, STL_INT32U_T size)
+{
+	__m128i *w = (__m128i *)block;
+	__m128i *c = (__m128i *)save;
+	const __m128i ones = _mm_set1_epi32(-1);
+	__m128i diff = _mm_setzero_si128();
+	__m128i x;
+	STL_INT32U_T n = size / sizeof(__m128i);
+	STL_INT32U_T i;
+
+	for (i = 0u; i < n; i++)
+	{
+		_mm_store_si128(&c[i], _mm_load_si128(&w[i]));
+	}
+	STL_MARCH_BARRIER();
+	/* up(r c, w ~c) */
+	for (i = 0u; i < n; i++)
+	{
+		x = _mm_load_si128(&w[i]);
+		diff = _mm_or_si128(diff, _mm_xor_si128(x, c[i]));
+		_mm_store_si128(&w[i], _mm_xor_si128(x, ones));
+	}
+	STL_MARCH_BARRIER();
+	/* up(r ~c, w c) */
+	for (i = 0u; i < n; i++)
+	{
+		x = _mm_load_si128(&w[i]);
+		diff = _mm_or_si128(diff, _mm_xor_si128(_mm_xor_si128(x, ones), c[i]));
+		_mm_store_si128(&w[i], _mm_xor_si128(x, ones));
+	}
+	STL_MARCH_BARRIER();
+	/* down(r c, w ~c) */
+	for (i = n; i > 0u; i--)
+	{
+		x = _mm_load_si128(&w[i - 1u]);
+		diff = _mm_or_si128(diff, _mm_xor_si128(x, c[i - 1u]));
+		_mm_store_si128(&w[i - 1u], _mm_xor_si128(x, ones));
+	}
+	STL_MARCH_BARRIER();
+	/* down(r ~c, w c) */
+	for (i = n; i > 0u; i--)
+	{
+		x = _mm_load_si128(&w[i - 1u]);
+		diff = _mm_or_si128(diff, _mm_xor_si128(_mm_xor_si128(x, ones), c[i - 1u]));
+		_mm_store_si128(&w[i - 1u], _mm_xor_si128(x, ones));
+	}
+	STL_MARCH_BARRIER();
+	/* any(r c) */
+	for (i = 0u; i < n; i++)
+	{
+		diff = _mm_or_si128(diff, _mm_xor_si128(_mm_load_si128(&w[i]), c[i]));
+	}
+	return (_mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128())) == 0xFFFF) ? STL_TRUE : STL_FALSE;
+}
+
+#if (STL_USE_ISA_DISPATCH > 0u)
+/**
+ * @brief March C- on 32-byte words (AVX2).
+ *
+ * @param block Block under test
+ * @param save Save area
+ * @param size Size of the block in bytes
+ * @return STL_TRUE if every read matched the saved contents
+ */
+__attribute__((target("avx2"))) STATIC_KEYWORD STL_BOOL STL_march_kernel_avx2(void *block, void *save,
+																			   STL_INT32U_T size)
+{
+	__m256i *w = (__m256i *)block;
+	__m256i *c = (__m256i *)save;
+	const __m256i ones = _mm256_set1_epi32(-1);
+	__m256i diff = _mm256_setzero_si256();
+	__m256i x;
+	STL_INT32U_T n = size / sizeof(__m256i);
+	STL_INT32U_T i;
+
+	for (i = 0u; i < n; i++)
+	{
+		_mm256_store_si256(&c[i], _mm256_load_si256(&w[i]));
+	}
+	STL_MARCH_BARRIER();
+	/* up(r c, w ~c) */
+	for (i = 0u; i < n; i++)
+	{
+		x = _mm256_load_si256(&w[i]);
+		diff = _mm256_or_si256(diff, _mm256_xor_si256(x, c[i]));
+		_mm256_store_si256(&w[i], _mm256_xor_si256(x, ones));
+	}
+	STL_MARCH_BARRIER();
+	/* up(r ~c, w c) */
+	for (i = 0u; i < n; i++)
+	{
+		x = _mm256_load_si256(&w[i]);
+		diff = _mm256_or_si256(diff, _mm256_xor_si256(_mm256_xor_si256(x, ones), c[i]));
+		_mm256_store_si256(&w[i], _mm256_xor_si256(x, ones));
+	}
+	STL_MARCH_BARRIER();
+	/* down(r c, w ~c) */
+	for (i = n; i > 0u; i--)
+	{
+		x = _mm256_load_si256(&w[i - 1u]);
+		diff = _mm256_or_si256(diff, _mm256_xor_si256(x, c[i - 1u]));
+		_mm256_store_si256(&w[i - 1u], _mm256_xor_si256(x, ones));
+	}
+	STL_MARCH_BARRIER();
+	/* down(r ~c, w c) */
+	for (i = n; i > 0u; i--)
+	{
+		x = _mm256_load_si256(&w[i - 1u]);
+		diff = _mm256_or_si256(diff, _mm256_xor_si256(_mm256_xor_si256(x, ones), c[i - 1u]));
+		_mm256_store_si256(&w[i - 1u], _mm256_xor_si256(x, ones));
+	}
+	STL_MARCH_BARRIER();
+	/* any(r c) */
+	for (i = 0u; i < n; i++)
+	{
+		diff = _mm256_or_si256(diff, _mm256_xor_si256(_mm256_load_si256(&w[i]), c[i]));
+	}
+	return _mm256_testz_si256(diff, diff) ? STL_TRUE : STL_FALSE;
+}
+#endif /* STL_USE_ISA_DISPATCH */
+
+/**
+ * @brief Initializes the March test.
+ *
+ * @param regions Regions to test
+ * @param count Number of regions
+ * @param err Error code
+ * @return None
+ */
+void STL_march_init(const STL_MARCH_REGION_T *regions, STL_SIZE_T count, STL_ERROR_T *err)
+{
+	STL_SIZE_T i;
+
+	if (count > STL_MARCH_MAX_REGIONS || (count > 0u && regions == STL_NULL))
+	{
+		*err = STL_INDEX_OUT_OF_BOUNDS;
+		return;
+	}
+	for (i = 0u; i < count; i++)
+	{
+		if (((uintptr_t)regions[i].start % STL_MARCH_ALIGN) != 0u || (regions[i].size % STL_MARCH_ALIGN) != 0u ||
+			regions[i].size == 0u)
+		{
+			*err = STL_INDEX_OUT_OF_BOUNDS;
+			return;
+		}
+	}
+
+	march.kernel = STL_march_kernel_sse2;
+#if (STL_USE_ISA_DISPATCH > 0u)
+	if ((STL_TSSP_CPU_get_isa_features() & STL_CPU_ISA_AVX2) != 0u)
+	{
+		march.kernel = STL_march_kernel_avx2;
+	}
+#endif /* STL_USE_ISA_DISPATCH */
+	march.regions = regions;
+	march.count = count;
+	march.stats.sweep_bytes = 0u;
+	for (i = 0u; i < count; i++)
+	{
+		march.stats.sweep_bytes += regions[i].size;
+	}
+	march.region = 0u;
+	march.offset = 0u;
+	march.sweep_steps = 0u;
+	march.sweep_busy = 0u;
+	march.stats.sweeps = 0u;
+	march.stats.faults = 0u;
+	march.stats.last_fault = STL_NULL;
+	march.stats.sweep_steps = 0u;
+	march.stats.sweep_busy_cycles = 0u;
+	march.stats.sweep_time_cycles = 0u;
+	march.stats.max_step_cycles = 0u;
+	*err = STL_ERROR_NONE;
+}
+
+/**
+ * @brief March pseudo-test: tests the next block of the regions.
+ *
+ * @return STL_SIGNATURE_MISMATCH if the block tested during this step is faulty,
+ *         STL_MARCH_SIGNATURE otherwise
+ */
+STL_SIGNATURE_T STL_march_test(void)
+{
+	STL_SIGNATURE_T signature = STL_MARCH_SIGNATURE;
+	const STL_MARCH_REGION_T *region;
+	uint8_t *block;
+	STL_INT32U_T size;
+	STL_INT32U_T i;
+	STL_CYCLES_T start;
+	STL_CYCLES_T cycles;
+
+	if (march.count == 0u)
+	{
+		return signature;
+	}
+
+	start = STL_TSSP_CPU_get_cycles();
+	if (march.sweep_steps == 0u)
+	{
+		march.sweep_start = start;
+	}
+	march.sweep_steps++;
+
+	region = &march.regions[march.region];
+	block = (uint8_t *)region->start + march.offset;
+	size = region->size - march.offset;
+	if (size > STL_MARCH_CHUNK_BYTES)
+	{
+		size = STL_MARCH_CHUNK_BYTES;
+	}
+	if (march.kernel(block, march_save, size) == STL_FALSE)
+	{
+		/* Give the block its contents back, as far as the faulty cells allow */
+		for (i = 0u; i < size; i++)
+		{
+			block[i] = march_save[i];
+		}
+		march.stats.faults++;
+		march.stats.last_fault = block;
+		signature = STL_SIGNATURE_MISMATCH;
+	}
+	march.offset += size;
+	if (march.offset == region->size)
+	{
+		march.offset = 0u;
+		march.region++;
+		if (march.region == march.count)
+		{
+			/* Sweep complete: the next step starts a new one */
+			march.region = 0u;
+		}
+	}
+
+	cycles = STL_TSSP_CPU_get_cycles() - start;
+	march.sweep_busy += cycles;
+	if (cycles > march.stats.max_step_cycles)
+	{
+		march.stats.max_step_cycles = cycles;
+	}
+	if (march.region == 0u && march.offset == 0u)
+	{
+		march.stats.sweeps++;
+		march.stats.sweep_steps = march.sweep_steps;
+		march.stats.sweep_busy_cycles = march.sweep_busy;
+		march.stats.sweep_time_cycles = STL_TSSP_CPU_get_cycles() - march.sweep_start;
+		march.sweep_steps = 0u;
+		march.sweep_busy = 0u;
+	}
+
+	return signature;
+}
+
+/**
+ * @brief Retrieves the statistics of the March test.
+ *
+ * @param stats Pointer to the statistics to fill
+ * @param err Error code
+ * @return None
+ */
+void STL_march_get_stats(STL_MARCH_STATS_T *stats, STL_ERROR_T *err)
+{
+	*stats = march.stats;
+	*err = STL_ERROR_NONE;
+}
+
+#endif /*STL_USE_MARCH*/
+#endif /*__STL_MARCH_MODULE__*/
+#endif /*__STL__*/
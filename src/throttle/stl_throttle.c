@@ -0,0 +1,211 @@
+#if __STL__
+
+/**
+ * @file stl_throttle.c
+ * @brief Implementation of the STL memory bandwidth throttle.
+ *
+ * Each CPU has a token bucket counted in bytes. The bucket is refilled lazily when a test asks
+ * for bytes: the cycles elapsed since the previous refill are converted into bytes at the rate
+ * of the CPU, the remainder of the division being carried over so that no byte is lost, and the
+ * bucket is capped at one window worth of bytes. A grant may leave the bucket negative (a test
+ * larger than the burst): the debt is paid back by the next refills before any other test runs.
+ *
+ * @see stl_throttle.h
+ */
+
+#ifndef __STL_THROTTLE_MODULE__
+#define __STL_THROTTLE_MODULE__
+
+#include "stl_throttle.h"
+#include "stl_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+#if (STL_USE_THROTTLE > 0u)
+
+#if (STL_MULTICORE_SOC > 0u)
+#include "stl_al_cpu.h"
+#endif /*STL_MULTICORE_SOC*/
+
+/**
+ * @typedef STL_THROTTLE_BUCKET_T
+ * @brief Token bucket of one CPU.
+ *
+ * @var STL_THROTTLE_BUCKET_T::tokens
+ * Bytes available (negative while a large test is paid back).
+ * @var STL_THROTTLE_BUCKET_T::last
+ * Cycle counter value at the previous refill.
+ * @var STL_THROTTLE_BUCKET_T::remainder
+ * Remainder of the conversion of the elapsed cycles into bytes (bytes x cycles).
+ * @var STL_THROTTLE_BUCKET_T::stats
+ * Rate and statistics of the CPU.
+ */
+typedef struct
+{
+	int64_t tokens;
+	STL_CYCLES_T last;
+	STL_CYCLES_T remainder;
+	STL_THROTTLE_STATS_T stats;
+} STL_THROTTLE_BUCKET_T;
+
+#if (STL_MULTICORE_SOC > 0u)
+STATIC_KEYWORD STL_THROTTLE_BUCKET_T throttle_bucket[STL_NUM_CPU];
+#define STL_THROTTLE_BUCKET(cpu) (&throttle_bucket[(cpu)])
+#define STL_THROTTLE_CPUS STL_NUM_CPU
+#else
+STATIC_KEYWORD STL_THROTTLE_BUCKET_T throttle_bucket;
+#define STL_THROTTLE_BUCKET(cpu) ((void)(cpu), &throttle_bucket)
+#define STL_THROTTLE_CPUS 1u
+#endif /*STL_MULTICORE_SOC*/
+
+/**
+ * @brief Sets the rate of a bucket and fills it.
+ *
+ * @param bucket Bucket of the CPU
+ * @param bytes_per_window Bytes per window (0: not throttled)
+ * @param window_cycles Window, in cycles
+ * @return None
+ */
+STATIC_KEYWORD void STL_throttle_reset(STL_THROTTLE_BUCKET_T *bucket, STL_INT32U_T bytes_per_window,
+									   STL_CYCLES_T window_cycles)
+{
+	bucket->stats.bytes_per_window = bytes_per_window;
+	bucket->stats.window_cycles = window_cycles;
+	bucket->tokens = (int64_t)bytes_per_window;
+	bucket->remainder = 0u;
+	bucket->last = STL_TSSP_CPU_get_cycles();
+}
+
+/**
+ * @brief Converts the cycles elapsed since the previous refill into bytes.
+ *
+ * @param bucket Bucket of the CPU
+ * @return None
+ */
+STATIC_KEYWORD INLINE_KEYWORD void STL_throttle_refill(STL_THROTTLE_BUCKET_T *bucket)
+{
+	STL_CYCLES_T now = STL_TSSP_CPU_get_cycles();
+	STL_CYCLES_T rate = bucket->stats.bytes_per_window;
+	STL_CYCLES_T window = bucket->stats.window_cycles;
+	STL_CYCLES_T elapsed = now - bucket->last;
+	STL_CYCLES_T windows = elapsed / window;
+	STL_CYCLES_T partial;
+	STL_CYCLES_T needed;
+
+	bucket->last = now;
+	/* Whole windows beyond the ones that fill the bucket are not counted (no overflow) */
+	needed = (STL_CYCLES_T)((int64_t)rate - bucket->tokens) / rate + 1u;
+	if (windows >= needed)
+	{
+		bucket->tokens = (int64_t)rate;
+		bucket->remainder = 0u;
+		return;
+	}
+	/* Below one window, cycles x bytes fits in 64 bits (window and rate are 32-bit values) */
+	partial = (elapsed % window) * rate + bucket->remainder;
+	bucket->tokens += (int64_t)(windows * rate + partial / window);
+	bucket->remainder = partial % window;
+	if (bucket->tokens >= (int64_t)rate)
+	{
+		bucket->tokens = (int64_t)rate;
+		bucket->remainder = 0u;
+	}
+}
+
+/**
+ * @brief Initializes the throttle.
+ *
+ * @param err Error code
+ * @return None
+ */
+void STL_throttle_init(STL_ERROR_T *err)
+{
+	STL_CPUS cpu;
+	STL_THROTTLE_BUCKET_T *bucket;
+
+	for (cpu = 0u; cpu < STL_THROTTLE_CPUS; cpu++)
+	{
+		bucket = STL_THROTTLE_BUCKET(cpu);
+		bucket->stats.granted_bytes = 0u;
+		bucket->stats.granted = 0u;
+		bucket->stats.deferred = 0u;
+		STL_throttle_reset(bucket, STL_THROTTLE_BYTES_PER_WINDOW, STL_THROTTLE_WINDOW_CYCLES);
+	}
+	*err = STL_ERROR_NONE;
+}
+
+/**
+ * @brief Changes the rate of a CPU.
+ *
+ * @param cpu CPU number
+ * @param bytes_per_window Bytes per window, 0 to disable the throttle of the CPU
+ * @param window_cycles Window, in cycles
+ * @param err Error code
+ * @return None
+ */
+void STL_throttle_configure(STL_CPUS cpu, STL_INT32U_T bytes_per_window, STL_CYCLES_T window_cycles,
+							STL_ERROR_T *err)
+{
+	if (cpu >= STL_THROTTLE_CPUS)
+	{
+		*err = STL_CPU_OUT_OF_BOUNDS;
+		return;
+	}
+	if (window_cycles == 0u || window_cycles > 0xFFFFFFFFu)
+	{
+		*err = STL_INDEX_OUT_OF_BOUNDS;
+		return;
+	}
+	STL_throttle_reset(STL_THROTTLE_BUCKET(cpu), bytes_per_window, window_cycles);
+	*err = STL_ERROR_NONE;
+}
+
+/**
+ * @brief Takes the bytes of a test from the bucket of a CPU.
+ *
+ * @param cpu CPU number
+ * @param bytes Bytes touched by the test
+ * @return STL_TRUE if the test may run, STL_FALSE if it must be deferred
+ */
+STL_BOOL STL_throttle_acquire(STL_CPUS cpu, STL_INT32U_T bytes)
+{
+	STL_THROTTLE_BUCKET_T *bucket = STL_THROTTLE_BUCKET(cpu);
+
+	if (bucket->stats.bytes_per_window > 0u)
+	{
+		STL_throttle_refill(bucket);
+		/* A test larger than the burst runs on a full bucket */
+		if (bucket->tokens < (int64_t)bytes && bucket->tokens < (int64_t)bucket->stats.bytes_per_window)
+		{
+			bucket->stats.deferred++;
+			return STL_FALSE;
+		}
+		bucket->tokens -= (int64_t)bytes;
+	}
+	bucket->stats.granted++;
+	bucket->stats.granted_bytes += bytes;
+	return STL_TRUE;
+}
+
+/**
+ * @brief Retrieves the statistics of the throttle of a CPU.
+ *
+ * @param cpu CPU number
+ * @param stats Pointer to the statistics to fill
+ * @param err Error code
+ * @return None
+ */
+void STL_throttle_get_stats(STL_CPUS cpu, STL_THROTTLE_STATS_T *stats, STL_ERROR_T *err)
+{
+	if (cpu >= STL_THROTTLE_CPUS)
+	{
+		*err = STL_CPU_OUT_OF_BOUNDS;
+		return;
+	}
+	*stats = STL_THROTTLE_BUCKET(cpu)->stats;
+	*err = STL_ERROR_NONE;
+}
+
+#endif /*STL_USE_THROTTLE*/
+#endif /*__STL_THROTTLE_MODULE__*/
+#endif /*__STL__*/
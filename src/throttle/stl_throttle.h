@@ -0,0 +1,110 @@
+/**
+ * @file stl_throttle.h
+ * @brief Header file for the STL memory bandwidth throttle.
+ *
+ * Memory-class tests (RAM tests, scrubbing, cache tests) share the caches and the memory bus
+ * with the application running on the other cores. The throttle caps the bytes these tests
+ * touch per time window on each CPU with a token bucket:
+ *
+ *   - the bucket of a CPU fills at STL_THROTTLE_BYTES_PER_WINDOW bytes per
+ *     STL_THROTTLE_WINDOW_CYCLES cycles, up to one window worth of bytes (the burst);
+ *   - before dispatching a runtime test with a memory footprint (STL_RT_ROUTINE_MEM_BYTES),
+ *     the scheduler takes its bytes from the bucket of the CPU;
+ *   - when the bucket holds too few bytes, the test is deferred: it does not run in this
+ *     scheduling cycle and keeps its previous verdict.
+ *
+ * A test larger than the burst runs when the bucket is full and leaves it in debt, so that
+ * the average rate is kept whatever the footprint of the tests.
+ *
+ * @details
+ * - STL_throttle_init: Fills the buckets, with the build-time rate.
+ * - STL_throttle_configure: Changes the rate of a CPU at run time.
+ * - STL_throttle_acquire: Takes the bytes of a test from the bucket (called by the scheduler).
+ * - STL_throttle_get_stats: Returns the bytes granted and the deferred tests of a CPU.
+ *
+ * @note Each bucket is only used by its own CPU: no locking is needed.
+ */
+#if __STL__
+#ifndef __STL_THROTTLE_H__
+#define __STL_THROTTLE_H__
+
+#include "stl_cfg.h"
+#include "stl_types.h"
+
+#if (STL_USE_THROTTLE > 0u)
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /*__cplusplus*/
+
+	/**
+	 * @brief Statistics of the throttle of a CPU.
+	 *
+	 * @var STL_THROTTLE_STATS_T::bytes_per_window
+	 * Current rate: bytes per window (0: not throttled).
+	 * @var STL_THROTTLE_STATS_T::window_cycles
+	 * Current window, in cycles.
+	 * @var STL_THROTTLE_STATS_T::granted_bytes
+	 * Bytes granted since the initialization.
+	 * @var STL_THROTTLE_STATS_T::granted
+	 * Tests dispatched with their bytes granted.
+	 * @var STL_THROTTLE_STATS_T::deferred
+	 * Tests deferred for lack of bytes in the bucket.
+	 */
+	typedef struct
+	{
+		STL_INT32U_T bytes_per_window;
+		STL_CYCLES_T window_cycles;
+		STL_CYCLES_T granted_bytes;
+		STL_INT32U_T granted;
+		STL_INT32U_T deferred;
+	} STL_THROTTLE_STATS_T;
+
+	/**
+	 * @brief Initializes the throttle: every CPU gets the build-time rate and a full bucket.
+	 *
+	 * @param err Error code
+	 * @return None
+	 */
+	void STL_throttle_init(STL_ERROR_T *err);
+
+	/**
+	 * @brief Changes the rate of a CPU; its bucket is refilled and its statistics are kept.
+	 *
+	 * @param cpu CPU number
+	 * @param bytes_per_window Bytes per window, 0 to disable the throttle of the CPU
+	 * @param window_cycles Window, in cycles (at most 2^32 - 1)
+	 * @param err Error code, set to STL_CPU_OUT_OF_BOUNDS for an invalid CPU and to
+	 *            STL_INDEX_OUT_OF_BOUNDS for an empty or too long window
+	 * @return None
+	 */
+	void STL_throttle_configure(STL_CPUS cpu, STL_INT32U_T bytes_per_window, STL_CYCLES_T window_cycles,
+								STL_ERROR_T *err);
+
+	/**
+	 * @brief Takes the bytes of a test from the bucket of a CPU.
+	 *
+	 * @param cpu CPU number (not checked, called by the scheduler)
+	 * @param bytes Bytes touched by the test
+	 * @return STL_TRUE if the test may run, STL_FALSE if it must be deferred
+	 */
+	STL_BOOL STL_throttle_acquire(STL_CPUS cpu, STL_INT32U_T bytes);
+
+	/**
+	 * @brief Retrieves the statistics of the throttle of a CPU.
+	 *
+	 * @param cpu CPU number
+	 * @param stats Pointer to the statistics to fill
+	 * @param err Error code, set to STL_CPU_OUT_OF_BOUNDS for an invalid CPU
+	 * @return None
+	 */
+	void STL_throttle_get_stats(STL_CPUS cpu, STL_THROTTLE_STATS_T *stats, STL_ERROR_T *err);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /*STL_USE_THROTTLE*/
+#endif /*__STL_THROTTLE_H__*/
+#endif /*__STL__*/
@@ -0,0 +1,280 @@
+#if __STL__
+
+/**
+ * @file stl_trace.c
+ * @brief Implementation of the STL binary trace.
+ *
+ * Each CPU owns a ring of STL_TRACE_RECORDS records indexed by two free-running counters:
+ * head is only written by the producer (the context running the tests of the CPU), tail
+ * only by the consumer (the drain). The producer publishes a record with a release store
+ * of head after writing it, and checks the free space with an acquire load of tail, so
+ * that a slot is never overwritten while it is being drained. The dropped counter is the
+ * only word written by both sides and is updated atomically.
+ *
+ * The previous timestamp is only updated when a record is written: the delta of the first
+ * record after a drop also covers the dropped records, so the timeline stays exact.
+ *
+ * @see stl_trace.h
+ */
+
+#ifndef __STL_TRACE_MODULE__
+#define __STL_TRACE_MODULE__
+
+#include "stl_trace.h"
+#include "stl_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+#if (STL_USE_TRACE > 0u)
+
+#if (STL_MULTICORE_SOC > 0u)
+#include "stl_al_cpu.h"
+#endif /*STL_MULTICORE_SOC*/
+
+#if defined(__unix__)
+#include <unistd.h>
+#endif /*__unix__*/
+
+#if ((STL_TRACE_RECORDS & (STL_TRACE_RECORDS - 1u)) != 0u)
+#error "STL_TRACE_RECORDS must be a power of two"
+#endif
+
+/**
+ * @typedef STL_TRACE_RING_T
+ * @brief Trace ring of one CPU.
+ *
+ * @var STL_TRACE_RING_T::records
+ * Records of the ring.
+ * @var STL_TRACE_RING_T::head
+ * Number of records written (producer).
+ * @var STL_TRACE_RING_T::tail
+ * Number of records drained (consumer).
+ * @var STL_TRACE_RING_T::dropped
+ * Records dropped since the previous drain.
+ * @var STL_TRACE_RING_T::last
+ * Timestamp of the previous record.
+ */
+typedef struct
+{
+	STL_TRACE_RECORD_T records[STL_TRACE_RECORDS];
+	STL_INT32U_T head;
+	STL_INT32U_T tail;
+	STL_INT32U_T dropped;
+	STL_CYCLES_T last;
+} STL_TRACE_RING_T;
+
+#if (STL_MULTICORE_SOC > 0u)
+STATIC_KEYWORD STL_TRACE_RING_T trace_ring[STL_NUM_CPU];
+#define STL_TRACE_RING(cpu) (&trace_ring[(cpu)])
+#define STL_TRACE_CPUS STL_NUM_CPU
+#else
+STATIC_KEYWORD STL_TRACE_RING_T trace_ring;
+#define STL_TRACE_RING(cpu) ((void)(cpu), &trace_ring)
+#define STL_TRACE_CPUS 1u
+#endif /*STL_MULTICORE_SOC*/
+
+/**
+ * @brief Initializes the trace: clears the rings and sets the time origin of every CPU.
+ *
+ * @param err Error code
+ * @return None
+ */
+void STL_trace_init(STL_ERROR_T *err)
+{
+	STL_CYCLES_T now = STL_TSSP_CPU_get_cycles();
+	STL_CPUS cpu;
+
+	for (cpu = 0u; cpu < STL_TRACE_CPUS; cpu++)
+	{
+		STL_TRACE_RING_T *ring = STL_TRACE_RING(cpu);
+
+		ring->head = 0u;
+		ring->tail = 0u;
+		ring->dropped = 0u;
+		ring->last = now;
+	}
+	*err = STL_ERROR_NONE;
+}
+
+/**
+ * @brief Appends a record to the ring of a CPU.
+ *
+ * @param cpu CPU of the event
+ * @param event Event (STL_TRACE_EV_*)
+ * @param index Test or block index
+ * @param arg Event argument
+ * @param data Event data
+ * @return None
+ */
+void STL_trace_emit(STL_CPUS cpu, uint8_t event, uint16_t index, uint8_t arg, STL_INT32U_T data)
+{
+	STL_TRACE_RING_T *ring = STL_TRACE_RING(cpu);
+	STL_CYCLES_T now = STL_TSSP_CPU_get_cycles();
+	STL_CYCLES_T delta = now - ring->last;
+	STL_INT32U_T head = ring->head;
+	STL_INT32U_T needed = ((delta >> 32) != 0u) ? 2u : 1u;
+	STL_TRACE_RECORD_T *record;
+
+	if (head - STL_ATOMIC_LOAD_ACQUIRE(&ring->tail) + needed > STL_TRACE_RECORDS)
+	{
+		(void)STL_ATOMIC_FETCH_ADD(&ring->dropped, 1u);
+		return;
+	}
+
+	if (needed == 2u)
+	{
+		record = &ring->records[head & (STL_TRACE_RECORDS - 1u)];
+		record->delta = 0u;
+		record->data = (STL_INT32U_T)(delta >> 32);
+		record->index = 0u;
+		record->event = STL_TRACE_EV_TIME_EXT;
+		record->arg = 0u;
+		head++;
+	}
+	record = &ring->records[head & (STL_TRACE_RECORDS - 1u)];
+	record->delta = (STL_INT32U_T)delta;
+	record->data = data;
+	record->index = index;
+	record->event = event;
+	record->arg = arg;
+	ring->last = now;
+
+	STL_ATOMIC_STORE_RELEASE(&ring->head, head + 1u);
+}
+
+/**
+ * @brief Exports the pending records of a CPU through a sink.
+ * The pending records are written in at most two runs (the ring wraps around once).
+ *
+ * @param cpu CPU to drain
+ * @param sink Destination of the records
+ * @param err Error code
+ * @return Number of records exported
+ */
+STL_INT32U_T STL_trace_drain(STL_CPUS cpu, const STL_TRACE_SINK_T *sink, STL_ERROR_T *err)
+{
+	STL_TRACE_RING_T *ring;
+	STL_TRACE_RECORD_T block;
+	STL_INT32U_T tail;
+	STL_INT32U_T pending;
+	STL_INT32U_T drained = 0u;
+
+#if (STL_MULTICORE_SOC > 0u)
+	if (cpu >= STL_NUM_CPU)
+	{
+		*err = STL_CPU_OUT_OF_BOUNDS;
+		return 0u;
+	}
+#endif /*STL_MULTICORE_SOC*/
+	ring = STL_TRACE_RING(cpu);
+	tail = ring->tail;
+	pending = STL_ATOMIC_LOAD_ACQUIRE(&ring->head) - tail;
+
+	block.delta = 0u;
+	block.data = STL_ATOMIC_EXCHANGE(&ring->dropped, 0u);
+	block.index = 0u;
+	block.event = STL_TRACE_EV_BLOCK;
+	block.arg = (uint8_t)cpu;
+	if (sink->write(sink->ctx, &block, (STL_INT32U_T)sizeof(block)) == STL_FALSE)
+	{
+		(void)STL_ATOMIC_FETCH_ADD(&ring->dropped, block.data);
+		*err = STL_ERROR_TRACE;
+		return 0u;
+	}
+
+	*err = STL_ERROR_NONE;
+	while (pending > 0u)
+	{
+		STL_INT32U_T first = tail & (STL_TRACE_RECORDS - 1u);
+		STL_INT32U_T run = STL_TRACE_RECORDS - first;
+
+		if (run > pending)
+		{
+			run = pending;
+		}
+		if (sink->write(sink->ctx, &ring->records[first], run * (STL_INT32U_T)sizeof(STL_TRACE_RECORD_T)) ==
+			STL_FALSE)
+		{
+			*err = STL_ERROR_TRACE;
+			break;
+		}
+		tail += run;
+		pending -= run;
+		drained += run;
+		STL_ATOMIC_STORE_RELEASE(&ring->tail, tail);
+	}
+	return drained;
+}
+
+/**
+ * @brief Memory sink: appends the data to a buffer.
+ *
+ * @param ctx Context of the sink (STL_TRACE_MEMORY_T)
+ * @param data Data to write
+ * @param size Size of the data in bytes
+ * @return STL_FALSE if the buffer is full
+ */
+STL_BOOL STL_trace_sink_memory(void *ctx, const void *data, STL_INT32U_T size)
+{
+	STL_TRACE_MEMORY_T *memory = (STL_TRACE_MEMORY_T *)ctx;
+	const uint8_t *src = (const uint8_t *)data;
+	STL_INT32U_T i;
+
+	if (size > memory->size - memory->used)
+	{
+		return STL_FALSE;
+	}
+	for (i = 0u; i < size; i++)
+	{
+		memory->buffer[memory->used + i] = src[i];
+	}
+	memory->used += size;
+	return STL_TRUE;
+}
+
+/**
+ * @brief UART sink: sends the data through the CSP UART service.
+ *
+ * @param ctx Context of the sink (unused)
+ * @param data Data to write
+ * @param size Size of the data in bytes
+ * @return STL_TRUE
+ */
+STL_BOOL STL_trace_sink_uart(void *ctx, const void *data, STL_INT32U_T size)
+{
+	(void)ctx;
+	STL_TSSP_CSP_uart_write((const uint8_t *)data, size);
+	return STL_TRUE;
+}
+
+#if defined(__unix__)
+/**
+ * @brief File sink (host): writes the data to a file descriptor.
+ *
+ * @param ctx Context of the sink (pointer to the int descriptor)
+ * @param data Data to write
+ * @param size Size of the data in bytes
+ * @return STL_FALSE if the data could not be written
+ */
+STL_BOOL STL_trace_sink_fd(void *ctx, const void *data, STL_INT32U_T size)
+{
+	const uint8_t *src = (const uint8_t *)data;
+
+	while (size > 0u)
+	{
+		ssize_t written = write(*(const int *)ctx, src, size);
+
+		if (written <= 0)
+		{
+			return STL_FALSE;
+		}
+		src += written;
+		size -= (STL_INT32U_T)written;
+	}
+	return STL_TRUE;
+}
+#endif /*__unix__*/
+
+#endif /*STL_USE_TRACE*/
+#endif /*__STL_TRACE_MODULE__*/
+#endif /*__STL__*/
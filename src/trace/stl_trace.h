@@ -0,0 +1,224 @@
+/**
+ * @file stl_trace.h
+ * @brief Header file for the STL binary trace.
+ *
+ * The trace records what the scheduler and the error management do, in fixed 12-byte
+ * records, without formatting anything on the target: test start and stop, setup and
+ * restore, verdicts, watchdog and relocation events. Each CPU writes its own ring buffer
+ * (single producer) and any context can drain it (single consumer): the ring is lock-free,
+ * the producer never waits and drops the records that do not fit (the drops are counted).
+ *
+ * The timestamp of a record is the number of cycles elapsed since the previous record of
+ * the same CPU (delta encoding); a delta that does not fit in 32 bits is preceded by a
+ * STL_TRACE_EV_TIME_EXT record carrying its high half. The first record after
+ * STL_trace_init is relative to the initialization, without it relative to cycle 0.
+ *
+ * The drained stream is a flat sequence of records: each drain starts with a
+ * STL_TRACE_EV_BLOCK record naming the CPU of the records that follow and the number of
+ * records dropped since the previous drain. scripts/stl_trace_decode.py rebuilds the
+ * timelines and the per-test statistics from it.
+ *
+ * @details
+ * - STL_trace_init: Clears the rings and sets the time origin.
+ * - STL_trace_emit: Appends a record (use the STL_TRACE macro, compiled out without STL_USE_TRACE).
+ * - STL_trace_drain: Exports the pending records of a CPU through a sink.
+ * - STL_trace_sink_memory, STL_trace_sink_uart, STL_trace_sink_fd: Sinks.
+ */
+#if __STL__
+#ifndef __STL_TRACE_H__
+#define __STL_TRACE_H__
+
+#include "stl_cfg.h"
+#include "stl_types.h"
+
+/**
+ * @brief Events of the trace (STL_TRACE_RECORD_T::event).
+ * The meaning of the index, arg and data fields depends on the event.
+ */
+#define STL_TRACE_EV_BLOCK 0u	   /* Drain header: arg CPU, data records dropped */
+#define STL_TRACE_EV_TIME_EXT 1u   /* data: high 32 bits of the delta of the next record */
+#define STL_TRACE_EV_TEST_START 2u /* index test, arg STL_TRACE_RUNTIME / STL_TRACE_BOOTTIME */
+#define STL_TRACE_EV_TEST_STOP 3u  /* index test, arg as start, data signature */
+#define STL_TRACE_EV_SETUP 4u	   /* index test, arg STL_TRACE_SETUP_* */
+#define STL_TRACE_EV_RESTORE 5u	   /* index test, arg STL_TRACE_SETUP_* */
+#define STL_TRACE_EV_VERDICT 6u	   /* index test, arg STL_VERDICT_T, data signature */
+#define STL_TRACE_EV_WATCHDOG 7u   /* index test, arg STL_TRACE_WDG_*, data budget or timeout */
+#define STL_TRACE_EV_RELOCATION 8u /* index block, arg STL_TRACE_RELOCATION_*, data size or CRC */
+#define STL_TRACE_EV_THROTTLE 9u	   /* index test deferred by the throttle, data bytes requested */
+#define STL_TRACE_EV_SYNC 10u	   /* index test, arg STL_TRACE_SYNC_*, data cycles waited */
+#define STL_TRACE_EV_REDUNDANCY 11u /* index test, arg divergence verdict, data signature compared */
+
+#define STL_TRACE_RUNTIME 0u  /* Runtime test */
+#define STL_TRACE_BOOTTIME 1u /* Boot-time test */
+
+#define STL_TRACE_SETUP_CONFIG 0u /* Test configuration (TSSP set/restore) */
+#define STL_TRACE_SETUP_MPU 1u	  /* MPU profile switch */
+
+#define STL_TRACE_WDG_ARM 0u	/* Deadline armed, data budget (low 32 bits) */
+#define STL_TRACE_WDG_EXPIRE 1u /* Test aborted, budget exceeded */
+#define STL_TRACE_WDG_KICK 2u	/* Hardware watchdog serviced */
+
+#define STL_TRACE_RELOCATION_START 0u /* Copy started, data size in bytes */
+#define STL_TRACE_RELOCATION_DONE 1u  /* Copy verified, data CRC-32C */
+#define STL_TRACE_RELOCATION_FAIL 2u  /* Copy rejected, data CRC-32C */
+
+#define STL_TRACE_SYNC_ENTER 0u			/* Window entered */
+#define STL_TRACE_SYNC_LEAVE 1u			/* Window left with all the participants */
+#define STL_TRACE_SYNC_ENTER_TIMEOUT 2u /* Window abandoned at the entry, test not run */
+#define STL_TRACE_SYNC_LEAVE_TIMEOUT 3u /* Window left alone after a timeout */
+
+#if (STL_USE_TRACE > 0u)
+
+/**
+ * @brief Appends a record to the trace of a CPU (compiled out without STL_USE_TRACE).
+ */
+#define STL_TRACE(cpu, event, index, arg, data)                                                                        \
+	STL_trace_emit((cpu), (uint8_t)(event), (uint16_t)(index), (uint8_t)(arg), (STL_INT32U_T)(data))
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /*__cplusplus*/
+
+	/**
+	 * @brief Trace record (12 bytes, in the byte order of the target).
+	 *
+	 * @var STL_TRACE_RECORD_T::delta
+	 * Cycles elapsed since the previous record of the CPU (low 32 bits).
+	 * @var STL_TRACE_RECORD_T::data
+	 * Event data (signature, budget, size, ...).
+	 * @var STL_TRACE_RECORD_T::index
+	 * Test or block index.
+	 * @var STL_TRACE_RECORD_T::event
+	 * Event (STL_TRACE_EV_*).
+	 * @var STL_TRACE_RECORD_T::arg
+	 * Event argument (verdict, kind, ...).
+	 */
+	typedef struct
+	{
+		STL_INT32U_T delta;
+		STL_INT32U_T data;
+		uint16_t index;
+		uint8_t event;
+		uint8_t arg;
+	} STL_TRACE_RECORD_T;
+
+	/**
+	 * @brief Write function of a sink.
+	 * The data must be accepted entirely or not at all.
+	 *
+	 * @param ctx Context of the sink
+	 * @param data Data to write
+	 * @param size Size of the data in bytes
+	 * @return STL_TRUE if the data has been written
+	 */
+	typedef STL_BOOL (*STL_TRACE_WRITE_PTR_T)(void *ctx, const void *data, STL_INT32U_T size);
+
+	/**
+	 * @brief Destination of the drained records.
+	 *
+	 * @var STL_TRACE_SINK_T::write
+	 * Write function.
+	 * @var STL_TRACE_SINK_T::ctx
+	 * Context passed to the write function.
+	 */
+	typedef struct
+	{
+		STL_TRACE_WRITE_PTR_T write;
+		void *ctx;
+	} STL_TRACE_SINK_T;
+
+	/**
+	 * @brief Context of the memory sink.
+	 *
+	 * @var STL_TRACE_MEMORY_T::buffer
+	 * Destination buffer.
+	 * @var STL_TRACE_MEMORY_T::size
+	 * Size of the buffer in bytes.
+	 * @var STL_TRACE_MEMORY_T::used
+	 * Bytes written so far.
+	 */
+	typedef struct
+	{
+		uint8_t *buffer;
+		STL_INT32U_T size;
+		STL_INT32U_T used;
+	} STL_TRACE_MEMORY_T;
+
+	/**
+	 * @brief Initializes the trace: clears the rings and sets the time origin of every CPU.
+	 *
+	 * @param err Error code
+	 * @return None
+	 */
+	void STL_trace_init(STL_ERROR_T *err);
+
+	/**
+	 * @brief Appends a record to the ring of a CPU.
+	 * It must only be called from the context that runs the tests of the CPU. When the ring is
+	 * full the record is dropped and counted.
+	 *
+	 * @param cpu CPU of the event
+	 * @param event Event (STL_TRACE_EV_*)
+	 * @param index Test or block index
+	 * @param arg Event argument
+	 * @param data Event data
+	 * @return None
+	 */
+	void STL_trace_emit(STL_CPUS cpu, uint8_t event, uint16_t index, uint8_t arg, STL_INT32U_T data);
+
+	/**
+	 * @brief Exports the pending records of a CPU through a sink.
+	 * A STL_TRACE_EV_BLOCK record is written first, then the records in order. The records
+	 * the sink refuses stay in the ring for the next drain.
+	 *
+	 * @param cpu CPU to drain
+	 * @param sink Destination of the records
+	 * @param err Error code, set to STL_ERROR_TRACE if the sink refused the records
+	 * @return Number of records exported (without the block record)
+	 */
+	STL_INT32U_T STL_trace_drain(STL_CPUS cpu, const STL_TRACE_SINK_T *sink, STL_ERROR_T *err);
+
+	/**
+	 * @brief Memory sink: appends the data to a buffer (ctx: STL_TRACE_MEMORY_T).
+	 *
+	 * @param ctx Context of the sink
+	 * @param data Data to write
+	 * @param size Size of the data in bytes
+	 * @return STL_FALSE if the buffer is full
+	 */
+	STL_BOOL STL_trace_sink_memory(void *ctx, const void *data, STL_INT32U_T size);
+
+	/**
+	 * @brief UART sink: sends the data through STL_TSSP_CSP_uart_write (ctx unused).
+	 *
+	 * @param ctx Context of the sink
+	 * @param data Data to write
+	 * @param size Size of the data in bytes
+	 * @return STL_TRUE
+	 */
+	STL_BOOL STL_trace_sink_uart(void *ctx, const void *data, STL_INT32U_T size);
+
+#if defined(__unix__)
+	/**
+	 * @brief File sink (host): writes the data to a file descriptor (ctx: pointer to the int descriptor).
+	 *
+	 * @param ctx Context of the sink
+	 * @param data Data to write
+	 * @param size Size of the data in bytes
+	 * @return STL_FALSE if the data could not be written
+	 */
+	STL_BOOL STL_trace_sink_fd(void *ctx, const void *data, STL_INT32U_T size);
+#endif /*__unix__*/
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#else
+/* The arguments are still evaluated: values computed only for the trace are not left unused */
+#define STL_TRACE(cpu, event, index, arg, data)                                                                        \
+	((void)(cpu), (void)(event), (void)(index), (void)(arg), (void)(data))
+#endif /*STL_USE_TRACE*/
+#endif /*__STL_TRACE_H__*/
+#endif /*__STL__*/
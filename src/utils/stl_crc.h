@@ -0,0 +1,79 @@
+/**
+ * @file stl_crc.h
+ * @brief CRC-32C (Castagnoli) services of the STL.
+ *
+ * The CRC-32C is used to verify the blocks copied by the relocation engine against the
+ * checksums computed at build time. The same polynomial is implemented by the SSE4.2
+ * crc32 instruction, so that the host port can fuse the CRC with the copy.
+ *
+ * @details
+ * - STL_crc32c_update: Updates a CRC with a buffer (byte-wise, table driven).
+ * - STL_crc32c_word: Updates a CRC with a 32-bit little-endian word.
+ * - STL_crc32c_copy: Copies a word-aligned block and computes its CRC in the same pass.
+ *
+ * @note The CRC state is kept raw: start from STL_CRC32C_INIT and apply STL_CRC32C_FINAL
+ *       to obtain the standard CRC-32C value.
+ */
+#if __STL__
+#ifndef __STL_CRC_H__
+#define __STL_CRC_H__
+
+#include "stl_cfg.h"
+#include "stl_types.h"
+
+#define STL_CRC32C_INIT 0xFFFFFFFFu			/* Initial CRC state */
+#define STL_CRC32C_FINAL(crc) ((crc) ^ 0xFFFFFFFFu) /* Final CRC value from the CRC state */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /*__cplusplus*/
+
+	/**
+	 * @brief CRC-32C lookup table (reflected polynomial 0x82F63B78).
+	 */
+	extern const STL_INT32U_T STL_crc32c_table[256];
+
+	/**
+	 * @brief Update a CRC state with a 32-bit little-endian word.
+	 * @param crc CRC state.
+	 * @param word Word, in memory order.
+	 * @return The updated CRC state.
+	 */
+	STATIC_KEYWORD INLINE_KEYWORD STL_INT32U_T STL_crc32c_word(STL_INT32U_T crc, STL_INT32U_T word)
+	{
+		crc ^= word;
+		crc = STL_crc32c_table[crc & 0xFFu] ^ (crc >> 8);
+		crc = STL_crc32c_table[crc & 0xFFu] ^ (crc >> 8);
+		crc = STL_crc32c_table[crc & 0xFFu] ^ (crc >> 8);
+		crc = STL_crc32c_table[crc & 0xFFu] ^ (crc >> 8);
+		return crc;
+	}
+
+	/**
+	 * @brief Update a CRC state with a buffer.
+	 * @param crc CRC state.
+	 * @param data Buffer.
+	 * @param size Size of the buffer in bytes.
+	 * @return The updated CRC state.
+	 */
+	STL_INT32U_T STL_crc32c_update(STL_INT32U_T crc, const void *data, STL_INT32U_T size);
+
+	/**
+	 * @brief Copy a block and compute its CRC in the same pass.
+	 * The block is copied by bursts of four words (unrolled loads/stores) when both
+	 * addresses are word aligned, and byte by byte otherwise.
+	 * @param dst Destination address.
+	 * @param src Source address.
+	 * @param size Size of the block in bytes.
+	 * @param crc CRC state.
+	 * @return The updated CRC state.
+	 */
+	STL_INT32U_T STL_crc32c_copy(void *dst, const void *src, STL_INT32U_T size, STL_INT32U_T crc);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /*__STL_CRC_H__*/
+#endif /*__STL__*/
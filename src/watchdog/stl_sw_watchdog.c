@@ -0,0 +1,206 @@
+#if __STL__
+
+/**
+ * @file stl_sw_watchdog.c
+ * @brief Implementation of the STL software deadline monitor.
+ *
+ * Each CPU owns a monitor made of a recovery point, a deadline and an armed flag.
+ * STL_sw_wdg_run saves the recovery point, arms the deadline (now + budget) and calls
+ * the test. STL_sw_wdg_check, called from the tick context, compares the cycle counter
+ * with the deadline and, on expiry, jumps back to the recovery point, which aborts the test.
+ *
+ * @note The tests are executed without any lock held by the STL, so aborting them from
+ *       the tick context does not leave the library in an inconsistent state. Tests that
+ *       modify the system configuration must be restored through the TSSP restore services.
+ *
+ * @see stl_sw_watchdog.h
+ * @see stl_cfg.h
+ */
+
+#ifndef __STL_SW_WATCHDOG_MODULE__
+#define __STL_SW_WATCHDOG_MODULE__
+
+#include "stl_sw_watchdog.h"
+#include "stl_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+#if (STL_USE_SW_WATCHDOG > 0u)
+
+#if (STL_MULTICORE_SOC > 0u)
+#include "stl_al_cpu.h"
+#endif /*STL_MULTICORE_SOC*/
+
+/**
+ * @typedef STL_SW_WDG_T
+ * @brief Software deadline monitor of one CPU.
+ *
+ * @var STL_SW_WDG_T::recovery
+ * Recovery point restored when the running test is aborted.
+ * @var STL_SW_WDG_T::deadline
+ * Cycle counter value after which the running test is aborted.
+ * @var STL_SW_WDG_T::armed
+ * Flag indicating that a test is running under the monitor.
+ * @var STL_SW_WDG_T::stats
+ * Timeout statistics.
+ */
+typedef struct
+{
+	STL_SW_WDG_JMP_BUF recovery;
+	volatile STL_CYCLES_T deadline;
+	volatile STL_BOOL armed;
+	STL_SW_WDG_STATS_T stats;
+} STL_SW_WDG_T;
+
+#if (STL_MULTICORE_SOC > 0u)
+STATIC_KEYWORD STL_SW_WDG_T sw_wdg[STL_NUM_CPU];
+#define STL_SW_WDG(cpu) (&sw_wdg[(cpu)])
+#else
+STATIC_KEYWORD STL_SW_WDG_T sw_wdg;
+#define STL_SW_WDG(cpu) ((void)(cpu), &sw_wdg)
+#endif /*STL_MULTICORE_SOC*/
+
+#if (STL_MULTICORE_SOC == 0u)
+/**
+ * @brief Tick handler registered through the CSP tick service (single core only).
+ */
+STATIC_KEYWORD void STL_sw_wdg_tick(void)
+{
+	STL_sw_wdg_check(0u);
+}
+#endif /*STL_MULTICORE_SOC*/
+
+/**
+ * @brief Initializes the software deadline monitor.
+ *
+ * @param err Error code
+ * @return None
+ */
+void STL_sw_wdg_init(STL_ERROR_T *err)
+{
+	*err = STL_ERROR_NONE;
+#if (STL_MULTICORE_SOC > 0u)
+	STL_CPUS cpu;
+	for (cpu = 0; cpu < STL_NUM_CPU; cpu++)
+	{
+		sw_wdg[cpu].armed = STL_FALSE;
+		sw_wdg[cpu].stats.timeouts = 0u;
+		sw_wdg[cpu].stats.last_latency = 0u;
+		sw_wdg[cpu].stats.max_latency = 0u;
+	}
+	/* Each core calls STL_sw_wdg_check from its own timer interrupt */
+#else
+	sw_wdg.armed = STL_FALSE;
+	sw_wdg.stats.timeouts = 0u;
+	sw_wdg.stats.last_latency = 0u;
+	sw_wdg.stats.max_latency = 0u;
+	STL_TSSP_CSP_tick_start(STL_SW_WATCHDOG_TICK_US, STL_sw_wdg_tick, err);
+#endif /*STL_MULTICORE_SOC*/
+}
+
+/**
+ * @brief Deinitializes the software deadline monitor.
+ *
+ * @param err Error code
+ * @return None
+ */
+void STL_sw_wdg_deinit(STL_ERROR_T *err)
+{
+	*err = STL_ERROR_NONE;
+#if (STL_MULTICORE_SOC == 0u)
+	sw_wdg.armed = STL_FALSE;
+	STL_TSSP_CSP_tick_stop(err);
+#endif /*STL_MULTICORE_SOC*/
+}
+
+/**
+ * @brief Executes a test under the software deadline monitor.
+ *
+ * @param cpu CPU number (not used in single core)
+ * @param test Test routine to execute
+ * @param budget Execution budget in CPU cycles (0 disables the deadline)
+ * @param err Error code, set to STL_ERROR_TIMEOUT if the test has been aborted
+ * @return The signature computed by the test, STL_SIGNATURE_MISMATCH if the test has been aborted
+ */
+STL_SIGNATURE_T STL_sw_wdg_run(STL_CPUS cpu, STL_FUNCT_PTR_T test, STL_CYCLES_T budget, STL_ERROR_T *err)
+{
+	STL_SW_WDG_T *wdg = STL_SW_WDG(cpu);
+	STL_SIGNATURE_T signature;
+
+	*err = STL_ERROR_NONE;
+	if (budget == 0u)
+	{
+		return test();
+	}
+
+	if (STL_SW_WDG_SETJMP(wdg->recovery) != 0)
+	{
+		/* Resumed from STL_sw_wdg_check: the test overran its budget */
+		*err = STL_ERROR_TIMEOUT;
+		return STL_SIGNATURE_MISMATCH;
+	}
+
+	wdg->deadline = STL_TSSP_CPU_get_cycles() + budget;
+	wdg->armed = STL_TRUE;
+	signature = test();
+	wdg->armed = STL_FALSE;
+
+	return signature;
+}
+
+/**
+ * @brief Checks the deadline of the test running on the given CPU.
+ *
+ * @param cpu CPU number (not used in single core)
+ * @return None
+ */
+void STL_sw_wdg_check(STL_CPUS cpu)
+{
+	STL_SW_WDG_T *wdg = STL_SW_WDG(cpu);
+	STL_CYCLES_T now;
+
+	if (wdg->armed == STL_FALSE)
+	{
+		return;
+	}
+
+	now = STL_TSSP_CPU_get_cycles();
+	if (now < wdg->deadline)
+	{
+		return;
+	}
+
+	wdg->armed = STL_FALSE;
+	wdg->stats.timeouts++;
+	wdg->stats.last_latency = now - wdg->deadline;
+	if (wdg->stats.last_latency > wdg->stats.max_latency)
+	{
+		wdg->stats.max_latency = wdg->stats.last_latency;
+	}
+	STL_SW_WDG_LONGJMP(wdg->recovery);
+}
+
+/**
+ * @brief Retrieves the statistics of the software deadline monitor.
+ *
+ * @param cpu CPU number (not used in single core)
+ * @param stats Pointer to the statistics to fill
+ * @param err Error code
+ * @return None
+ */
+void STL_sw_wdg_get_stats(STL_CPUS cpu, STL_SW_WDG_STATS_T *stats, STL_ERROR_T *err)
+{
+#if (STL_MULTICORE_SOC > 0u)
+	if (cpu >= STL_NUM_CPU)
+	{
+		*err = STL_CPU_OUT_OF_BOUNDS;
+		return;
+	}
+#endif /*STL_MULTICORE_SOC*/
+	*stats = STL_SW_WDG(cpu)->stats;
+	*err = STL_ERROR_NONE;
+}
+
+#endif /*STL_USE_SW_WATCHDOG*/
+#endif /*__STL_SW_WATCHDOG_MODULE__*/
+#endif /*__STL__*/
@@ -0,0 +1,120 @@
+/**
+ * @file stl_sw_watchdog.h
+ * @brief Header file for the STL software deadline monitor.
+ *
+ * The software deadline monitor protects the scheduler against runaway SBSTs
+ * (e.g., a fault that makes a test loop forever). Each test is armed with its own
+ * execution budget, expressed in CPU cycles, and a periodic tick (timer interrupt
+ * on the target, SIGALRM on the host) checks the deadline. When the deadline is
+ * exceeded the test is aborted, the scheduler records a timeout verdict and moves
+ * on to the next test, without waiting for a hardware watchdog reset.
+ *
+ * @details
+ * - STL_sw_wdg_init: Starts the tick used to check the deadlines.
+ * - STL_sw_wdg_run: Executes a test under its deadline.
+ * - STL_sw_wdg_check: Checks the deadline (called from the tick context).
+ *
+ * @note The detection latency is bounded by STL_SW_WATCHDOG_TICK_US.
+ */
+#if __STL__
+#ifndef __STL_SW_WATCHDOG_H__
+#define __STL_SW_WATCHDOG_H__
+
+#include "stl_cfg.h"
+#include "stl_types.h"
+
+#if (STL_USE_SW_WATCHDOG > 0u)
+
+#include <setjmp.h>
+
+#if defined(__unix__)
+/* Restore the signal mask when leaving the tick handler through the recovery point */
+#define STL_SW_WDG_JMP_BUF sigjmp_buf
+#define STL_SW_WDG_SETJMP(buf) sigsetjmp(buf, 1)
+#define STL_SW_WDG_LONGJMP(buf) siglongjmp(buf, 1)
+#else
+#define STL_SW_WDG_JMP_BUF jmp_buf
+#define STL_SW_WDG_SETJMP(buf) setjmp(buf)
+#define STL_SW_WDG_LONGJMP(buf) longjmp(buf, 1)
+#endif /*__unix__*/
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /*__cplusplus*/
+
+	/**
+	 * @brief Statistics of the software deadline monitor for one CPU.
+	 *
+	 * @var STL_SW_WDG_STATS_T::timeouts
+	 * Number of tests aborted because they exceeded their budget.
+	 * @var STL_SW_WDG_STATS_T::last_latency
+	 * Cycles elapsed between the deadline and the detection for the last timeout.
+	 * @var STL_SW_WDG_STATS_T::max_latency
+	 * Worst detection latency observed, in cycles.
+	 */
+	typedef struct
+	{
+		STL_INT32U_T timeouts;
+		STL_CYCLES_T last_latency;
+		STL_CYCLES_T max_latency;
+	} STL_SW_WDG_STATS_T;
+
+	/**
+	 * @brief Initializes the software deadline monitor.
+	 * In single-core configurations the periodic tick is started through the CSP tick service.
+	 * In multicore configurations each core must call STL_sw_wdg_check from its own timer interrupt.
+	 *
+	 * @param err Error code
+	 * @return None
+	 */
+	void STL_sw_wdg_init(STL_ERROR_T *err);
+
+	/**
+	 * @brief Deinitializes the software deadline monitor and stops the periodic tick.
+	 *
+	 * @param err Error code
+	 * @return None
+	 */
+	void STL_sw_wdg_deinit(STL_ERROR_T *err);
+
+	/**
+	 * @brief Executes a test under the software deadline monitor.
+	 * The deadline is armed with the given budget before calling the test and disarmed afterward.
+	 *
+	 * @param cpu CPU number (not used in single core)
+	 * @param test Test routine to execute
+	 * @param budget Execution budget in CPU cycles (0 disables the deadline)
+	 * @param err Error code, set to STL_ERROR_TIMEOUT if the test has been aborted
+	 * @return The signature computed by the test, STL_SIGNATURE_MISMATCH if the test has been aborted
+	 */
+	STL_SIGNATURE_T STL_sw_wdg_run(STL_CPUS cpu, STL_FUNCT_PTR_T test, STL_CYCLES_T budget, STL_ERROR_T *err);
+
+	/**
+	 * @brief Checks the deadline of the test running on the given CPU.
+	 * It must be called from the tick context (timer interrupt or host signal) of the CPU
+	 * executing the test. If the deadline is exceeded, the test is aborted and the execution
+	 * resumes in STL_sw_wdg_run.
+	 *
+	 * @param cpu CPU number (not used in single core)
+	 * @return None
+	 */
+	void STL_sw_wdg_check(STL_CPUS cpu);
+
+	/**
+	 * @brief Retrieves the statistics of the software deadline monitor.
+	 *
+	 * @param cpu CPU number (not used in single core)
+	 * @param stats Pointer to the statistics to fill
+	 * @param err Error code
+	 * @return None
+	 */
+	void STL_sw_wdg_get_stats(STL_CPUS cpu, STL_SW_WDG_STATS_T *stats, STL_ERROR_T *err);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /*STL_USE_SW_WATCHDOG*/
+#endif /*__STL_SW_WATCHDOG_H__*/
+#endif /*__STL__*/
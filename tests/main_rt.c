@@ -1,24 +1,48 @@
 #include "stl.h"
+#include "stl_context.h"
+#include "stl_sbst_cfg.h"
 #include "stl_types.h"
 
+#define SIGNATURE 0x600d
+
+// The default routine table is filled by the application, which cannot reach it through the
+// public API of the library: the runtime tests run in a context with their own routine table.
+static STL_CONTEXT_T ctx;
+static STL_FUNCT_PTR_T routines[STL_TOT_RT_ROUTINE];
+
+static STL_SIGNATURE_T sbst_pass(void)
+{
+    return SIGNATURE;
+}
 
 int main (void){
     STL_ERROR_T err;
-    STL_SIGNATURE_T signature = 0; // Initialize the signature variable
+    STL_CONTEXT_CFG_T cfg = {routines, STL_NULL, STL_TEST_CHUNK_SIZE};
+    STL_SIZE_T i;
 
     STL_init(&err);
     if (err != STL_ERROR_NONE) {
         // Handle initialization error
         return -1;
     }
-    STL_schedule_runtime(0,&err);
+    for (i = 0; i < STL_TOT_RT_ROUTINE; i++) {
+        routines[i] = sbst_pass;
+    }
+    STL_context_init(&ctx, &cfg, &err);
     if (err != STL_ERROR_NONE) {
-        // Handle scheduling error
+        // Handle context error
         return -1;
-    }   
-    STL_em_rt_get_signature(0, 0, &err);
+    }
+    STL_ctx_schedule_runtime(&ctx, 0, &err);
     if (err != STL_ERROR_NONE) {
+        // Handle scheduling error
+        return -1;
+    }
+    if (STL_em_ctx_rt_get_signature(&ctx, 0, 0, &err) != SIGNATURE || err != STL_ERROR_NONE) {
         // Handle error in getting signature
         return -1;
     }
-}
\ No newline at end of file
+    STL_context_deinit(&ctx, &err);
+    STL_deinit(&err);
+    return 0;
+}
@@ -0,0 +1,13 @@
+/*
+ * Image of the relocation table test (linked with relocation_table.ld, see
+ * test_gen_relocation_table.py): three relocated blocks and a RAM section that is not one.
+ */
+
+__attribute__((section(".stl_runtime_a"), used)) const char block_a[6] = "AAAAAA";
+__attribute__((section(".stl_runtime_b"), used)) const char block_b[7] = "BBBBBBB";
+__attribute__((section(".ram_data"), used)) const char ram_data[4] = "DDDD";
+__attribute__((section(".stl_runtime_c"), used)) const char block_c[5] = "CCCCC";
+
+void _start(void)
+{
+}
@@ -0,0 +1,199 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "stl.h"
+#include "stl_cache.h"
+#include "stl_sbst_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * Cache subsystem SBSTs on the host (built with STL_USE_CACHE_TEST).
+ * - the geometry of the L1D and L2 is read from CPUID;
+ * - the L1D test is scheduled as runtime test 0 for a full sweep of its sets, the L2 test is
+ *   called directly for a full sweep: every set passes, the data and the replacement checks
+ *   included when the eviction sets are congruent;
+ * - the TSSP services: a flushed line is slower to load than a cached one, invalidation keeps
+ *   the data on x86_64, locking is not supported;
+ * - benchmark: time per full sweep and hit/evict cycles per load of each level.
+ */
+
+#define CACHE_TEST 0u
+#define FLUSH_REPEATS 64u
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
+
+static const char *const level_names[STL_CPU_CACHE_LEVELS] = {"L1D", "L2"};
+
+static double elapsed_ms(const struct timespec *start)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (double)(end.tv_sec - start->tv_sec) * 1e3 + (double)(end.tv_nsec - start->tv_nsec) * 1e-6;
+}
+
+static int report(STL_CPU_CACHE_LEVEL_T level, double ms)
+{
+    STL_CACHE_STATS_T stats;
+    STL_ERROR_T err;
+    unsigned resident, all;
+
+    STL_cache_get_stats(level, &stats, &err);
+    resident = stats.info.ways / 2u * stats.laps;
+    all = 2u * stats.info.ways * stats.laps;
+    printf("%s: %u KiB, %u ways, %u sets, %u B lines, replacement %s: %u sweep(s) in %.2f ms, "
+           "hit %.1f / evict %.1f cycles per load, %u data / %u replacement faults\n",
+           level_names[level], (unsigned)(stats.info.size / 1024u), (unsigned)stats.info.ways,
+           (unsigned)stats.info.sets, (unsigned)stats.info.line, stats.congruent ? "checked" : "not checked",
+           (unsigned)stats.sweeps, ms, (double)stats.hit_cycles / resident, (double)stats.evict_cycles / all,
+           (unsigned)stats.data_faults, (unsigned)stats.replacement_faults);
+    if (stats.data_faults != 0u || stats.replacement_faults != 0u)
+    {
+        printf("FAIL: %s faults, last in set %u\n", level_names[level], (unsigned)stats.last_fault_set);
+        return 1;
+    }
+    return 0;
+}
+
+static int check_l1d(void)
+{
+    STL_CACHE_STATS_T stats;
+    struct timespec start;
+    STL_ERROR_T err;
+    int failures = 0;
+
+    STL_cache_get_stats(STL_CPU_CACHE_L1D, &stats, &err);
+    if (!stats.tested || stats.info.size == 0u || stats.info.size != stats.info.line * stats.info.ways * stats.info.sets)
+    {
+        printf("FAIL: L1D geometry not reported\n");
+        return 1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do
+    {
+        STL_schedule_runtime(0, &err);
+        if (err != STL_ERROR_NONE || STL_em_rt_get_verdict(0, CACHE_TEST, &err) != STL_VERDICT_PASS)
+        {
+            failures++;
+            break;
+        }
+        STL_cache_get_stats(STL_CPU_CACHE_L1D, &stats, &err);
+    } while (stats.sweeps == 0u);
+    return failures + report(STL_CPU_CACHE_L1D, elapsed_ms(&start));
+}
+
+static int check_l2(void)
+{
+    STL_CACHE_STATS_T stats;
+    struct timespec start;
+    STL_SIGNATURE_T signature;
+    STL_ERROR_T err;
+    int failures = 0;
+
+    STL_cache_get_stats(STL_CPU_CACHE_L2, &stats, &err);
+    if (!stats.tested)
+    {
+        printf("L2 not tested (absent or larger than the buffer)\n");
+        return STL_cache_l2_test() == STL_SIGNATURE_SKIPPED ? 0 : 1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do
+    {
+        signature = STL_cache_l2_test();
+        if (signature != STL_CACHE_SIGNATURE)
+        {
+            failures++;
+            break;
+        }
+        STL_cache_get_stats(STL_CPU_CACHE_L2, &stats, &err);
+    } while (stats.sweeps == 0u);
+    return failures + report(STL_CPU_CACHE_L2, elapsed_ms(&start));
+}
+
+static STL_CYCLES_T time_load(volatile uint64_t *p)
+{
+    STL_CYCLES_T t0, t1;
+
+    __builtin_ia32_lfence();
+    t0 = STL_TSSP_CPU_get_cycles();
+    __builtin_ia32_lfence();
+    (void)*p;
+    __builtin_ia32_lfence();
+    t1 = STL_TSSP_CPU_get_cycles();
+    return t1 - t0;
+}
+
+static int check_services(void)
+{
+    static uint64_t line[8] __attribute__((aligned(64)));
+    STL_CYCLES_T hot = ~(STL_CYCLES_T)0u, cold = ~(STL_CYCLES_T)0u, t;
+    STL_ERROR_T err;
+    unsigned i;
+    int failures = 0;
+
+    for (i = 0; i < FLUSH_REPEATS; i++)
+    {
+        line[0] = i;
+        (void)time_load(line);
+        t = time_load(line);
+        hot = t < hot ? t : hot;
+        STL_TSSP_CPU_cache_flush(line, sizeof(line));
+        t = time_load(line);
+        cold = t < cold ? t : cold;
+    }
+    printf("load: %llu cycles cached, %llu cycles after flush\n", (unsigned long long)hot, (unsigned long long)cold);
+    if (cold <= hot)
+    {
+        printf("FAIL: flushed line not evicted\n");
+        failures++;
+    }
+    line[1] = 0x1234u;
+    STL_TSSP_CPU_cache_invalidate(line, sizeof(line), &err);
+    if (err != STL_ERROR_NONE || line[1] != 0x1234u)
+    {
+        printf("FAIL: invalidation lost the data\n");
+        failures++;
+    }
+    STL_TSSP_CPU_cache_lock(line, sizeof(line), &err);
+    if (err != STL_ERROR_NOT_IMPLEMENTED)
+    {
+        printf("FAIL: cache locking reported on x86_64\n");
+        failures++;
+    }
+    return failures;
+}
+
+int main(void)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+    STL_cache_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        printf("FAIL: cache buffer not mapped\n");
+        return 1;
+    }
+    SBST_RT[CACHE_TEST] = STL_cache_l1d_test;
+
+    failures += check_l1d();
+    failures += check_l2();
+    failures += check_services();
+
+    STL_cache_deinit();
+    if (STL_cache_l1d_test() != STL_SIGNATURE_SKIPPED)
+    {
+        printf("FAIL: cache test run without buffer\n");
+        failures++;
+    }
+    STL_deinit(&err);
+    return failures;
+}
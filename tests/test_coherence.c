@@ -0,0 +1,226 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "stl.h"
+#include "stl_coherence.h"
+#include "stl_sbst_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * Atomic and coherence SBSTs on the host (built with STL_MULTICORE_SOC, STL_NUM_CPU=4 and
+ * STL_USE_COHERENCE_TEST). Each CPU is a thread scheduling its own runtime tests, the
+ * coherence test being runtime test 0 of every CPU.
+ * - with 1, 2 and 4 participants, every round passes on every CPU and the combined verdict
+ *   of the error management is a pass with one signature; no fault, no timeout;
+ * - a round that a participant never joins times out and fails until the next initialization;
+ * - CPUs recording different signatures fail the combined verdict;
+ * - an invalid number of participants is rejected.
+ * The time of a round and of an atomic operation is reported for each number of participants.
+ * On a host with fewer cores than participants the threads share the cores: the barriers
+ * then dominate the time of a round.
+ */
+
+#define COHERENCE_TEST 0u
+#define CPUS 4u
+#define ROUNDS 100u
+#define OPS_PER_ITERATION 7u /* add, CAS, inc, set, clear, swap, store */
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[CPUS * STL_TOT_RT_ROUTINE];
+
+typedef struct
+{
+    STL_CPUS cpu;
+    unsigned failures;
+} WORKER_T;
+
+static STL_SIGNATURE_T sbst_a(void)
+{
+    return 0x1111;
+}
+
+static STL_SIGNATURE_T sbst_b(void)
+{
+    return 0x2222;
+}
+
+static double now_ns(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec * 1e9 + (double)t.tv_nsec;
+}
+
+static void *worker(void *arg)
+{
+    WORKER_T *w = (WORKER_T *)arg;
+    STL_ERROR_T err;
+    unsigned round;
+
+    for (round = 0; round < ROUNDS; round++)
+    {
+        STL_schedule_runtime(w->cpu, &err);
+        if (err != STL_ERROR_NONE || STL_em_rt_get_verdict(w->cpu, COHERENCE_TEST, &err) != STL_VERDICT_PASS)
+        {
+            w->failures++;
+        }
+    }
+    return NULL;
+}
+
+static int check_participants(unsigned n)
+{
+    pthread_t threads[CPUS];
+    WORKER_T workers[CPUS];
+    STL_COHERENCE_STATS_T stats;
+    STL_SIGNATURE_T sig = 0;
+    STL_ERROR_T err;
+    double start, elapsed;
+    unsigned i;
+    int failures = 0;
+
+    STL_coherence_init(n, &err);
+    start = now_ns();
+    for (i = 0; i < n; i++)
+    {
+        workers[i].cpu = (STL_CPUS)i;
+        workers[i].failures = 0;
+        pthread_create(&threads[i], NULL, worker, &workers[i]);
+    }
+    for (i = 0; i < n; i++)
+    {
+        pthread_join(threads[i], NULL);
+        if (workers[i].failures != 0u)
+        {
+            printf("FAIL: %u participants, CPU %u failed %u rounds\n", n, i, workers[i].failures);
+            failures++;
+        }
+    }
+    elapsed = now_ns() - start;
+    STL_coherence_get_stats(&stats);
+
+    if (STL_em_rt_get_combined(COHERENCE_TEST, 0, (STL_CPUS)n, &sig, &err) != STL_VERDICT_PASS)
+    {
+        printf("FAIL: %u participants, combined verdict is not a pass\n", n);
+        failures++;
+    }
+    if (stats.rounds != ROUNDS || stats.faults != 0u || stats.timeouts != 0u)
+    {
+        printf("FAIL: %u participants, %u rounds, %u faults, %u timeouts\n", n, (unsigned)stats.rounds,
+               (unsigned)stats.faults, (unsigned)stats.timeouts);
+        failures++;
+    }
+    printf("%u participant(s): signature %08x, %8.1f us/round, %6.1f cycles/atomic op, %llu CAS retries, "
+           "%4.1f%% of the cycles at the barriers\n",
+           n, (unsigned)sig, elapsed / ROUNDS / 1e3,
+           (double)stats.hammer_cycles / (n * ROUNDS * STL_COHERENCE_ITERATIONS * OPS_PER_ITERATION),
+           (unsigned long long)stats.cas_retries,
+           100.0 * (double)stats.wait_cycles / (double)(stats.hammer_cycles + stats.wait_cycles));
+    return failures;
+}
+
+static int check_timeout(void)
+{
+    STL_COHERENCE_STATS_T stats;
+    STL_ERROR_T err;
+    int failures = 0;
+
+    /* CPU 1 never joins the round of CPU 0 */
+    STL_coherence_init(2u, &err);
+    STL_schedule_runtime(0, &err);
+    STL_coherence_get_stats(&stats);
+    if (STL_em_rt_get_verdict(0, COHERENCE_TEST, &err) != STL_VERDICT_FAIL || stats.timeouts != 1u)
+    {
+        printf("FAIL: missing participant not detected\n");
+        failures++;
+    }
+    /* The next rounds fail at once, the barrier is broken */
+    STL_schedule_runtime(1, &err);
+    STL_coherence_get_stats(&stats);
+    if (STL_em_rt_get_combined(COHERENCE_TEST, 0, 2, STL_NULL, &err) != STL_VERDICT_FAIL || stats.timeouts != 1u)
+    {
+        printf("FAIL: broken round not reported\n");
+        failures++;
+    }
+    return failures;
+}
+
+static int check_combined(void)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+
+    SBST_RT[2u * STL_TOT_RT_ROUTINE + COHERENCE_TEST] = sbst_a;
+    SBST_RT[3u * STL_TOT_RT_ROUTINE + COHERENCE_TEST] = sbst_b;
+    STL_schedule_runtime(2, &err);
+    STL_schedule_runtime(3, &err);
+    if (STL_em_rt_get_combined(COHERENCE_TEST, 2, 2, STL_NULL, &err) != STL_VERDICT_FAIL)
+    {
+        printf("FAIL: different signatures accepted\n");
+        failures++;
+    }
+    if (STL_em_rt_get_combined(COHERENCE_TEST, 3, 1, STL_NULL, &err) != STL_VERDICT_PASS)
+    {
+        printf("FAIL: single CPU range rejected\n");
+        failures++;
+    }
+    STL_em_rt_get_combined(COHERENCE_TEST, 3, 2, STL_NULL, &err);
+    if (err != STL_CPU_OUT_OF_BOUNDS)
+    {
+        printf("FAIL: CPU range out of bounds accepted\n");
+        failures++;
+    }
+    return failures;
+}
+
+static int check_init(void)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+
+    STL_coherence_init(0u, &err);
+    if (err != STL_CPU_OUT_OF_BOUNDS)
+    {
+        printf("FAIL: no participant accepted\n");
+        failures++;
+    }
+    STL_coherence_init(STL_COHERENCE_MAX_CPUS + 1u, &err);
+    if (err != STL_CPU_OUT_OF_BOUNDS)
+    {
+        printf("FAIL: too many participants accepted\n");
+        failures++;
+    }
+    return failures;
+}
+
+int main(void)
+{
+    static const unsigned participants[] = {1u, 2u, 4u};
+    STL_ERROR_T err;
+    unsigned i;
+    int failures = 0;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+    for (i = 0; i < CPUS; i++)
+    {
+        SBST_RT[i * STL_TOT_RT_ROUTINE + COHERENCE_TEST] = STL_coherence_test;
+    }
+
+    for (i = 0; i < sizeof(participants) / sizeof(participants[0]); i++)
+    {
+        failures += check_participants(participants[i]);
+    }
+    failures += check_timeout();
+    failures += check_combined();
+    failures += check_init();
+
+    STL_deinit(&err);
+    return failures;
+}
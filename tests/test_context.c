@@ -0,0 +1,280 @@
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "stl.h"
+#include "stl_context.h"
+#include "stl_sbst_cfg.h"
+#include "stl_types.h"
+
+/*
+ * STL contexts (built with STL_TOT_RT_ROUTINE=64, and again with the chunk-based scheduler).
+ * - two threads run their own routine table in their own context at the same time: each
+ *   context sees only its verdicts and the default context is untouched;
+ * - a context initialized without configuration runs SBST_RT like the default context, and
+ *   an invalid configuration is rejected;
+ * - resetting a context leaves the others alone;
+ * - the per-CPU state is aligned on a cache line;
+ * - with the chunk-based scheduler each call runs cfg.rt_chunk tests from the cursor of
+ *   the context, and the cursors of two contexts are independent.
+ * The time of the parallel and of the sequential runs is reported.
+ */
+
+#define TESTS STL_TOT_RT_ROUTINE
+#define FAILING(i) ((i) % 7u == 3u)
+#define SIG_PASS 0x600d
+#define ROUNDS 2000u
+#define CHUNK 5u
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
+
+static __thread unsigned long runs;
+
+static STL_CONTEXT_T ctx_a;
+static STL_CONTEXT_T ctx_b;
+static STL_FUNCT_PTR_T routines_a[TESTS];
+static STL_FUNCT_PTR_T routines_b[TESTS];
+
+typedef struct
+{
+    STL_CONTEXT_T *ctx;
+    STL_FUNCT_PTR_T *routines;
+    unsigned long runs;
+    STL_ERROR_T err;
+} WORKER_T;
+
+static STL_SIGNATURE_T sbst_pass(void)
+{
+    runs++;
+    return SIG_PASS;
+}
+
+static STL_SIGNATURE_T sbst_fail(void)
+{
+    runs++;
+    return STL_SIGNATURE_MISMATCH;
+}
+
+static void *worker(void *arg)
+{
+    WORKER_T *w = (WORKER_T *)arg;
+    STL_CONTEXT_CFG_T cfg = {w->routines, STL_NULL, CHUNK};
+    unsigned round;
+
+    runs = 0;
+    STL_context_init(w->ctx, &cfg, &w->err);
+    for (round = 0; round < ROUNDS && w->err == STL_ERROR_NONE; round++)
+    {
+        STL_ctx_schedule_runtime(w->ctx, 0, &w->err);
+    }
+    w->runs = runs;
+    return NULL;
+}
+
+static double elapsed_ms(const struct timespec *start, const struct timespec *end)
+{
+    return (end->tv_sec - start->tv_sec) * 1e3 + (double)(end->tv_nsec - start->tv_nsec) / 1e6;
+}
+
+static unsigned count_verdicts(STL_CONTEXT_T *ctx, STL_VERDICT_T verdict)
+{
+    STL_VERDICT_T verdicts[TESTS];
+    STL_ERROR_T err;
+    unsigned n = 0;
+    unsigned i;
+
+    STL_em_ctx_rt_get_range(ctx, 0, 0, TESTS, STL_NULL, verdicts, STL_NULL, &err);
+    for (i = 0; i < TESTS; i++)
+    {
+        n += (verdicts[i] == verdict);
+    }
+    return n;
+}
+
+static int check_parallel(void)
+{
+    WORKER_T a = {&ctx_a, routines_a, 0, STL_ERROR_NONE};
+    WORKER_T b = {&ctx_b, routines_b, 0, STL_ERROR_NONE};
+    STL_FAILED_TEST_T failed[TESTS];
+    struct timespec start;
+    struct timespec end;
+    pthread_t thread_a;
+    pthread_t thread_b;
+    STL_ERROR_T err;
+    unsigned expected = 0;
+    unsigned i;
+
+    for (i = 0; i < TESTS; i++)
+    {
+        routines_a[i] = FAILING(i) ? sbst_fail : sbst_pass;
+        routines_b[i] = sbst_pass;
+        expected += FAILING(i);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (pthread_create(&thread_a, NULL, worker, &a) != 0 || pthread_create(&thread_b, NULL, worker, &b) != 0)
+    {
+        return 1;
+    }
+    pthread_join(thread_a, NULL);
+    pthread_join(thread_b, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    printf("2 contexts in parallel: %.2f ms\n", elapsed_ms(&start, &end));
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    worker(&a);
+    worker(&b);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    printf("2 contexts in sequence: %.2f ms\n", elapsed_ms(&start, &end));
+
+    if (a.err != STL_ERROR_NONE || b.err != STL_ERROR_NONE || a.runs != b.runs || a.runs == 0u)
+    {
+        printf("FAIL: workers ended with %d/%d after %lu/%lu runs\n", (int)a.err, (int)b.err, a.runs, b.runs);
+        return 1;
+    }
+    if (STL_em_ctx_rt_get_failed(&ctx_a, 0, failed, TESTS, &err) != expected || failed[0].index != 3u ||
+        count_verdicts(&ctx_a, STL_VERDICT_PASS) != TESTS - expected)
+    {
+        printf("FAIL: verdicts of context A\n");
+        return 1;
+    }
+    if (STL_em_ctx_rt_get_failed(&ctx_b, 0, failed, TESTS, &err) != 0u ||
+        count_verdicts(&ctx_b, STL_VERDICT_PASS) != TESTS || STL_em_ctx_runtime_failed(&ctx_b, 0, &err) != (STL_SIZE_T)-1)
+    {
+        printf("FAIL: verdicts of context B\n");
+        return 1;
+    }
+    if (count_verdicts(&STL_default_context, STL_VERDICT_NOT_RUN) != TESTS)
+    {
+        printf("FAIL: default context changed\n");
+        return 1;
+    }
+    return 0;
+}
+
+static int check_reset(void)
+{
+    STL_ERROR_T err;
+
+    STL_em_ctx_reset(&ctx_a, 0, &err);
+    if (count_verdicts(&ctx_a, STL_VERDICT_NOT_RUN) != TESTS || count_verdicts(&ctx_b, STL_VERDICT_PASS) != TESTS)
+    {
+        printf("FAIL: reset of context A\n");
+        return 1;
+    }
+    return 0;
+}
+
+static int check_default_cfg(void)
+{
+    STL_CONTEXT_CFG_T invalid = {routines_a, STL_NULL, 0u};
+    STL_CONTEXT_T *ctx = &ctx_a;
+    STL_ERROR_T err;
+    unsigned i;
+
+    STL_context_init(ctx, &invalid, &err);
+    if (err != STL_ERROR_CONTEXT)
+    {
+        printf("FAIL: chunk of 0 tests accepted\n");
+        return 1;
+    }
+    STL_context_init(ctx, STL_NULL, &err);
+    if (err != STL_ERROR_NONE || ctx->cfg.rt_routines != SBST_RT || ctx->cfg.rt_chunk != STL_TEST_CHUNK_SIZE)
+    {
+        printf("FAIL: default configuration\n");
+        return 1;
+    }
+    for (i = 0; i < TESTS; i++)
+    {
+        SBST_RT[i] = sbst_fail;
+    }
+    for (i = 0; i < TESTS; i++)
+    {
+        STL_ctx_schedule_runtime(ctx, 0, &err);
+    }
+    if (count_verdicts(ctx, STL_VERDICT_FAIL) != TESTS || count_verdicts(&STL_default_context, STL_VERDICT_NOT_RUN) != TESTS)
+    {
+        printf("FAIL: context on SBST_RT\n");
+        return 1;
+    }
+    STL_context_deinit(ctx, &err);
+    if (count_verdicts(ctx, STL_VERDICT_NOT_RUN) != TESTS)
+    {
+        printf("FAIL: results kept after STL_context_deinit\n");
+        return 1;
+    }
+    return 0;
+}
+
+static int check_layout(void)
+{
+    if (sizeof(STL_CONTEXT_CPU_T) % STL_CACHE_LINE_SIZE != 0u ||
+        (uintptr_t)&ctx_a.cpu[0] % STL_CACHE_LINE_SIZE != 0u || (uintptr_t)&ctx_b.cpu[0] % STL_CACHE_LINE_SIZE != 0u)
+    {
+        printf("FAIL: per-CPU state not aligned on a cache line\n");
+        return 1;
+    }
+    return 0;
+}
+
+#if (STL_SCHEDULER_TYPE == 1u)
+static int check_chunks(void)
+{
+    STL_CONTEXT_CFG_T cfg_a = {routines_a, STL_NULL, CHUNK};
+    STL_CONTEXT_CFG_T cfg_b = {routines_b, STL_NULL, 1u};
+    STL_ERROR_T err;
+    unsigned call;
+
+    STL_context_init(&ctx_a, &cfg_a, &err);
+    STL_context_init(&ctx_b, &cfg_b, &err);
+    runs = 0;
+    STL_ctx_schedule_runtime(&ctx_a, 0, &err);
+    STL_ctx_schedule_runtime(&ctx_b, 0, &err);
+    if (runs != CHUNK + 1u || count_verdicts(&ctx_a, STL_VERDICT_NOT_RUN) != TESTS - CHUNK ||
+        count_verdicts(&ctx_b, STL_VERDICT_NOT_RUN) != TESTS - 1u ||
+        STL_em_ctx_rt_get_verdict(&ctx_a, 0, CHUNK - 1u, &err) != STL_VERDICT_PASS ||
+        STL_em_ctx_rt_get_verdict(&ctx_a, 0, CHUNK, &err) != STL_VERDICT_NOT_RUN)
+    {
+        printf("FAIL: first chunk (%lu runs)\n", runs);
+        return 1;
+    }
+
+    /* The last chunk of a pass stops at the last test, the next one restarts at the first */
+    runs = 0;
+    for (call = 1; call < (TESTS + CHUNK - 1u) / CHUNK; call++)
+    {
+        STL_ctx_schedule_runtime(&ctx_a, 0, &err);
+    }
+    if (runs != TESTS - CHUNK || count_verdicts(&ctx_a, STL_VERDICT_NOT_RUN) != 0u ||
+        ctx_a.cpu[0].rt_cursor != 0u || ctx_b.cpu[0].rt_cursor != 1u)
+    {
+        printf("FAIL: end of the pass (%lu runs, cursor %u)\n", runs, (unsigned)ctx_a.cpu[0].rt_cursor);
+        return 1;
+    }
+    return 0;
+}
+#endif /*STL_SCHEDULER_TYPE*/
+
+int main(void)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+
+    failures += check_layout();
+    failures += check_parallel();
+    failures += check_reset();
+    failures += check_default_cfg();
+#if (STL_SCHEDULER_TYPE == 1u)
+    failures += check_chunks();
+#endif /*STL_SCHEDULER_TYPE*/
+
+    STL_deinit(&err);
+    return failures;
+}
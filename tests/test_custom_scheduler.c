@@ -0,0 +1,52 @@
+#include <stdio.h>
+
+#include "stl.h"
+#include "stl_context.h"
+#include "stl_sbst_cfg.h"
+#include "stl_types.h"
+
+/*
+ * Custom scheduler of the application (built with STL_SCHEDULER_TYPE=2). Its hook has no
+ * context and records its results in the default context:
+ * - the hook runs for the default context;
+ * - another context is rejected with STL_ERROR_CONTEXT and the hook is not called.
+ */
+
+static STL_CONTEXT_T ctx;
+static unsigned calls;
+
+/* Custom scheduler of the application, in place of the weak one of the STL */
+void STL_scheduler_runtime_singlecore(STL_ERROR_T *err)
+{
+    calls++;
+    *err = STL_ERROR_NONE;
+}
+
+int main(void)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+
+    STL_schedule_runtime(0, &err);
+    if (err != STL_ERROR_NONE || calls != 1u)
+    {
+        printf("FAIL: custom scheduler not called for the default context (error %d)\n", (int)err);
+        failures++;
+    }
+    STL_context_init(&ctx, STL_NULL, &err);
+    STL_ctx_schedule_runtime(&ctx, 0, &err);
+    if (err != STL_ERROR_CONTEXT || calls != 1u)
+    {
+        printf("FAIL: custom scheduler called for another context (error %d)\n", (int)err);
+        failures++;
+    }
+
+    STL_deinit(&err);
+    return failures;
+}
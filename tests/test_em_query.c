@@ -0,0 +1,195 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "stl.h"
+#include "stl_sbst_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * Bulk queries of the error management (built with STL_TOT_RT_ROUTINE=1024).
+ * - one range call returns the signatures, verdicts and timestamps of every test, and
+ *   matches the per-index accessors;
+ * - ranges are clipped to the last test, unused outputs can be NULL, a first index out of
+ *   range is rejected;
+ * - the failed tests are listed compacted, with their total when the list is too short;
+ * - the boot-time queries answer (no boot-time test in this build).
+ * The cost of the per-index accessors and of the range call is reported.
+ */
+
+#define TESTS STL_TOT_RT_ROUTINE
+#define FAILING(i) ((i) % 97u == 5u)
+#define SIG_PASS 0x600d
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
+
+static STL_SIGNATURE_T sig[TESTS];
+static STL_VERDICT_T verdict[TESTS];
+static STL_CYCLES_T updated[TESTS];
+static STL_FAILED_TEST_T failed[TESTS];
+
+static STL_SIGNATURE_T sbst_pass(void)
+{
+    return SIG_PASS;
+}
+
+static STL_SIGNATURE_T sbst_fail(void)
+{
+    return STL_SIGNATURE_MISMATCH;
+}
+
+static int check_range(void)
+{
+    STL_ERROR_T err;
+    STL_SIZE_T n;
+    unsigned i;
+
+    n = STL_em_rt_get_range(0, 0, TESTS, sig, verdict, updated, &err);
+    if (err != STL_ERROR_NONE || n != TESTS)
+    {
+        printf("FAIL: range returned %u\n", (unsigned)n);
+        return 1;
+    }
+    for (i = 0; i < TESTS; i++)
+    {
+        STL_ERROR_T e1;
+        STL_ERROR_T e2;
+
+        if (sig[i] != (FAILING(i) ? STL_SIGNATURE_MISMATCH : SIG_PASS) ||
+            verdict[i] != (FAILING(i) ? STL_VERDICT_FAIL : STL_VERDICT_PASS) || updated[i] == 0u ||
+            (i > 0u && updated[i] < updated[i - 1u]) || sig[i] != STL_em_rt_get_signature(0, i, &e1) ||
+            verdict[i] != STL_em_rt_get_verdict(0, i, &e2))
+        {
+            printf("FAIL: test %u: signature 0x%x verdict %d\n", i, (unsigned)sig[i], (int)verdict[i]);
+            return 1;
+        }
+    }
+
+    memset(verdict, 0xff, sizeof(verdict));
+    n = STL_em_rt_get_range(0, TESTS - 24u, 100u, STL_NULL, verdict, STL_NULL, &err);
+    if (err != STL_ERROR_NONE || n != 24u || verdict[0] != STL_em_rt_get_verdict(0, TESTS - 24u, &err) ||
+        verdict[24] != (STL_VERDICT_T)-1)
+    {
+        printf("FAIL: clipped range returned %u\n", (unsigned)n);
+        return 1;
+    }
+    n = STL_em_rt_get_range(0, TESTS, 1u, sig, STL_NULL, STL_NULL, &err);
+    if (err != STL_INDEX_OUT_OF_BOUNDS || n != 0u)
+    {
+        printf("FAIL: range past the last test accepted\n");
+        return 1;
+    }
+    if (STL_em_rt_get_all(sig, STL_NULL, STL_NULL, &err) != TESTS || sig[5] != STL_SIGNATURE_MISMATCH)
+    {
+        printf("FAIL: all the CPUs\n");
+        return 1;
+    }
+    return 0;
+}
+
+static int check_failed(void)
+{
+    STL_ERROR_T err;
+    STL_SIZE_T n;
+    unsigned expected = 0;
+    unsigned i;
+
+    for (i = 0; i < TESTS; i++)
+    {
+        if (FAILING(i))
+        {
+            expected++;
+        }
+    }
+
+    n = STL_em_rt_get_failed(0, failed, TESTS, &err);
+    if (err != STL_ERROR_NONE || n != expected)
+    {
+        printf("FAIL: %u failed tests listed, %u expected\n", (unsigned)n, expected);
+        return 1;
+    }
+    for (i = 0; i < n; i++)
+    {
+        if (!FAILING(failed[i].index) || (i > 0u && failed[i].index <= failed[i - 1u].index) ||
+            failed[i].signature != STL_SIGNATURE_MISMATCH)
+        {
+            printf("FAIL: failed[%u] = test %u\n", i, (unsigned)failed[i].index);
+            return 1;
+        }
+    }
+
+    failed[2].index = 0xdead;
+    n = STL_em_rt_get_failed(0, failed, 2u, &err);
+    if (n != expected || failed[1].index != 102u || failed[2].index != 0xdead)
+    {
+        printf("FAIL: short list returned %u\n", (unsigned)n);
+        return 1;
+    }
+    return 0;
+}
+
+static int check_boottime(void)
+{
+    STL_ERROR_T err;
+    STL_ERROR_T err_failed;
+    STL_ERROR_T err_all;
+
+    STL_em_bt_get_signature(0, 0, &err);
+    if (err != STL_INDEX_OUT_OF_BOUNDS || STL_em_bt_get_failed(0, failed, TESTS, &err_failed) != 0u ||
+        err_failed != STL_ERROR_NONE || STL_em_bt_get_all(sig, verdict, updated, &err_all) != STL_TOT_BT_ROUTINE)
+    {
+        printf("FAIL: boot-time queries\n");
+        return 1;
+    }
+    return 0;
+}
+
+static void report_cost(void)
+{
+    STL_ERROR_T err;
+    STL_CYCLES_T start;
+    STL_CYCLES_T per_index;
+    STL_CYCLES_T range;
+    unsigned i;
+
+    start = STL_TSSP_CPU_get_cycles();
+    for (i = 0; i < TESTS; i++)
+    {
+        sig[i] = STL_em_rt_get_signature(0, i, &err);
+        verdict[i] = STL_em_rt_get_verdict(0, i, &err);
+    }
+    per_index = STL_TSSP_CPU_get_cycles() - start;
+
+    start = STL_TSSP_CPU_get_cycles();
+    STL_em_rt_get_range(0, 0, TESTS, sig, verdict, STL_NULL, &err);
+    range = STL_TSSP_CPU_get_cycles() - start;
+
+    printf("%u tests: %llu cycles per index, %llu cycles in one range call\n", TESTS, (unsigned long long)per_index,
+           (unsigned long long)range);
+}
+
+int main(void)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+    unsigned i;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+    for (i = 0; i < TESTS; i++)
+    {
+        SBST_RT[i] = FAILING(i) ? sbst_fail : sbst_pass;
+    }
+    STL_schedule_runtime(0, &err);
+
+    failures += check_range();
+    failures += check_failed();
+    failures += check_boottime();
+    report_cost();
+
+    STL_deinit(&err);
+    return failures;
+}
@@ -0,0 +1,149 @@
+#include <stdio.h>
+
+#include "stl.h"
+#include "stl_error_management.h"
+#include "stl_sbst_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * New diagnostic cycles of the error management (built with STL_TOT_RT_ROUTINE=1024).
+ * - after STL_em_reset every test reads as not run, with no failed test and no last failure;
+ * - the tests that run again in the new cycle are visible, the others stay not run;
+ * - STL_em_deinit then STL_em_init clear the results the same way;
+ * - many cycles in a row keep the results of the current cycle only.
+ * The cost of a reset is reported.
+ */
+
+#define TESTS STL_TOT_RT_ROUTINE
+#define FAILING(i) ((i) % 97u == 5u)
+#define SIG_PASS 0x600d
+#define CYCLES 1000u
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
+
+static STL_VERDICT_T verdict[TESTS];
+static STL_FAILED_TEST_T failed[TESTS];
+
+static STL_SIGNATURE_T sbst_pass(void)
+{
+    return SIG_PASS;
+}
+
+static STL_SIGNATURE_T sbst_fail(void)
+{
+    return STL_SIGNATURE_MISMATCH;
+}
+
+static int check_cleared(const char *when)
+{
+    STL_FAILED_TEST_T last;
+    STL_ERROR_T err;
+    unsigned i;
+
+    STL_em_rt_get_range(0, 0, TESTS, STL_NULL, verdict, STL_NULL, &err);
+    for (i = 0; i < TESTS; i++)
+    {
+        if (verdict[i] != STL_VERDICT_NOT_RUN || STL_em_rt_get_signature(0, i, &err) != 0)
+        {
+            printf("FAIL: %s: test %u verdict %d\n", when, i, (int)verdict[i]);
+            return 1;
+        }
+    }
+    STL_em_get_last_failed(0, &last, &err);
+    if (STL_em_rt_get_failed(0, failed, TESTS, &err) != 0u || STL_em_runtime_failed(0, &err) != (STL_SIZE_T)-1 ||
+        last.index != 0u || last.signature != 0)
+    {
+        printf("FAIL: %s: failures still reported\n", when);
+        return 1;
+    }
+    return 0;
+}
+
+static int check_partial(void)
+{
+    STL_ERROR_T err;
+
+    STL_em_reset(0, &err);
+    STL_em_update_sig(5, STL_SIGNATURE_MISMATCH, 0, &err);
+    STL_em_update_sig(7, SIG_PASS, 0, &err);
+    if (STL_em_rt_get_verdict(0, 5, &err) != STL_VERDICT_FAIL || STL_em_rt_get_verdict(0, 7, &err) != STL_VERDICT_PASS ||
+        STL_em_rt_get_verdict(0, 6, &err) != STL_VERDICT_NOT_RUN || STL_em_rt_get_failed(0, failed, TESTS, &err) != 1u ||
+        failed[0].index != 5u || STL_em_runtime_failed(0, &err) != 5u)
+    {
+        printf("FAIL: results of the new cycle\n");
+        return 1;
+    }
+    return 0;
+}
+
+static int check_cycles(void)
+{
+    STL_ERROR_T err;
+    unsigned cycle;
+
+    for (cycle = 0; cycle < CYCLES; cycle++)
+    {
+        STL_SIZE_T index = (STL_SIZE_T)(cycle % TESTS);
+
+        STL_em_reset(0, &err);
+        STL_em_update_sig(index, SIG_PASS, 0, &err);
+        if (STL_em_rt_get_verdict(0, index, &err) != STL_VERDICT_PASS ||
+            STL_em_rt_get_verdict(0, (STL_SIZE_T)((index + 1u) % TESTS), &err) != STL_VERDICT_NOT_RUN)
+        {
+            printf("FAIL: cycle %u\n", cycle);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void report_cost(void)
+{
+    STL_ERROR_T err;
+    STL_CYCLES_T start;
+    STL_CYCLES_T reset;
+
+    start = STL_TSSP_CPU_get_cycles();
+    STL_em_reset(0, &err);
+    reset = STL_TSSP_CPU_get_cycles() - start;
+    printf("%u tests: %llu cycles per reset\n", TESTS, (unsigned long long)reset);
+}
+
+int main(void)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+    unsigned i;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+    for (i = 0; i < TESTS; i++)
+    {
+        SBST_RT[i] = FAILING(i) ? sbst_fail : sbst_pass;
+    }
+    failures += check_cleared("after STL_init");
+
+    STL_schedule_runtime(0, &err);
+    if (STL_em_rt_get_verdict(0, 5, &err) != STL_VERDICT_FAIL)
+    {
+        printf("FAIL: verdicts not recorded\n");
+        failures++;
+    }
+    STL_em_reset(0, &err);
+    failures += check_cleared("after STL_em_reset");
+    failures += check_partial();
+
+    STL_schedule_runtime(0, &err);
+    STL_em_deinit(&err);
+    STL_em_init(&err);
+    failures += check_cleared("after STL_em_deinit");
+    failures += check_cycles();
+    report_cost();
+
+    STL_deinit(&err);
+    return failures;
+}
@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""Relocation table generator on a linked image (tests/relocation_table.c/.ld).
+
+    test_gen_relocation_table.py gen_relocation_table.py relocation_table.elf
+
+- the blocks adjacent with the same gap in ROM and RAM are merged, the merged block is padded
+  to the copy alignment, the other block is kept apart and reported as not aligned;
+- the CRC-32C of each block is the one of its ROM bytes;
+- --check accepts the generated table and rejects a stale one;
+- an image without any relocated block is an error and no table is written.
+"""
+
+import importlib.util
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+ENTRY = re.compile(r'\{\(const void \*\)0x([0-9A-F]+)u\w*, \(void \*\)0x([0-9A-F]+)u\w*, 0x([0-9A-F]+)u, 0x([0-9A-F]+)u\}')
+
+# ROM bytes of the blocks: the gap between the sections and the padding are zero-filled
+EXPECTED = [
+    (0x11000, 0x20000, b'AAAAAA\0\0BBBBBBB\0'),
+    (0x11014, 0x20100, b'CCCCC'),
+]
+
+
+def load(script):
+    spec = importlib.util.spec_from_file_location('gen_relocation_table', script)
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+def generate(script, elf, *args):
+    return subprocess.run([sys.executable, script, elf] + list(args), capture_output=True, text=True)
+
+
+def main():
+    script, elf = sys.argv[1], sys.argv[2]
+    failures = []
+    gen = load(script)
+
+    if gen.crc32c(b'123456789') != 0xE3069283:
+        failures.append('CRC-32C check value')
+
+    run = generate(script, elf)
+    entries = [tuple(int(x, 16) for x in m.groups()) for m in ENTRY.finditer(run.stdout)]
+    expected = [(lma, vma, len(data), gen.crc32c(data)) for (lma, vma, data) in EXPECTED]
+    if run.returncode != 0 or entries != expected:
+        failures.append('table %s instead of %s' % ([tuple(map(hex, e)) for e in entries],
+                                                    [tuple(map(hex, e)) for e in expected]))
+    if 'relocation_table_size = %du;' % len(EXPECTED) not in run.stdout:
+        failures.append('size of the table')
+    warnings = [line for line in run.stderr.splitlines() if 'warning' in line]
+    if len(warnings) != 1 or '.stl_runtime_c: not aligned' not in warnings[0]:
+        failures.append('alignment warnings %s' % warnings)
+
+    with tempfile.TemporaryDirectory() as tmp:
+        table = os.path.join(tmp, 'stl_rt_relocation_table.c')
+        if generate(script, elf, '-o', table).returncode != 0 or \
+                generate(script, elf, '--check', '-o', table).returncode != 0:
+            failures.append('--check rejects the generated table')
+        with open(table, 'a') as f:
+            f.write('\n')
+        if generate(script, elf, '--check', '-o', table).returncode == 0:
+            failures.append('--check accepts a stale table')
+
+        empty = os.path.join(tmp, 'empty.c')
+        run = generate(script, elf, '--section', r'^\.no_such_section', '-o', empty)
+        if run.returncode == 0 or os.path.exists(empty):
+            failures.append('table written for an image without relocated block')
+
+    for f in failures:
+        print('FAIL: %s' % f)
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,171 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "stl.h"
+#include "stl_health_reader.h"
+#include "stl_sbst_cfg.h"
+#include "stl_types.h"
+
+/*
+ * Health export on the host (built with STL_USE_HEALTH_EXPORT=1 and STL_TOT_RT_ROUTINE=2).
+ * - the supervisor side (stl_health_reader) finds the region and its layout;
+ * - the verdicts, runs and failures of the two tests (test 1 fails every other run) are
+ *   published, and the failed count follows the last verdicts;
+ * - a reader thread taking snapshots while the scheduler runs never sees a torn entry
+ *   (test 0 returns its run count as signature);
+ * - after STL_deinit the mapped region says stopped and the name is gone.
+ * The cost of a snapshot is reported.
+ */
+
+#define ROUNDS 10u
+#define STRESS_ROUNDS 200000u
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
+
+static STL_SIGNATURE_T runs0;
+static STL_SIGNATURE_T runs1;
+static volatile int stress_done;
+static unsigned long torn;
+static unsigned long snapshots;
+
+static STL_SIGNATURE_T sbst_count(void)
+{
+    return ++runs0;
+}
+
+static STL_SIGNATURE_T sbst_flaky(void)
+{
+    return (++runs1 & 1) ? STL_SIGNATURE_MISMATCH : 0x1234;
+}
+
+static void *supervisor(void *arg)
+{
+    const STL_HEALTH_READER_T *reader = (const STL_HEALTH_READER_T *)arg;
+    STL_HEALTH_TEST_T test;
+
+    while (!stress_done)
+    {
+        if (STL_health_reader_test(reader, 0, 0, &test) == STL_HEALTH_READER_OK)
+        {
+            snapshots++;
+            if (test.signature != test.runs)
+            {
+                torn++;
+            }
+        }
+    }
+    return NULL;
+}
+
+static int check_layout(const STL_HEALTH_READER_T *reader)
+{
+    const STL_HEALTH_HEADER_T *h = reader->header;
+
+    if (h->cpus != 1u || h->rt_tests != STL_TOT_RT_ROUTINE || h->test_size != sizeof(STL_HEALTH_TEST_T) ||
+        STL_health_reader_state(reader) != STL_HEALTH_STATE_RUNNING || STL_health_reader_generation(reader) != 0u)
+    {
+        printf("FAIL: layout (%u cpus, %u tests, state %u)\n", h->cpus, h->rt_tests, h->state);
+        return 1;
+    }
+    return 0;
+}
+
+static int check_verdicts(const STL_HEALTH_READER_T *reader)
+{
+    STL_HEALTH_TEST_T t0;
+    STL_HEALTH_TEST_T t1;
+    STL_ERROR_T err;
+    unsigned round;
+
+    for (round = 0; round < ROUNDS; round++)
+    {
+        STL_schedule_runtime(0, &err);
+        if (STL_health_reader_test(reader, 0, 1, &t1) != STL_HEALTH_READER_OK ||
+            STL_health_reader_failed(reader) != ((round & 1u) ? 0u : 1u))
+        {
+            printf("FAIL: round %u: %u failed\n", round, STL_health_reader_failed(reader));
+            return 1;
+        }
+    }
+    if (STL_health_reader_test(reader, 1, 0, &t0) != STL_HEALTH_READER_RANGE ||
+        STL_health_reader_test(reader, 0, 0, &t0) != STL_HEALTH_READER_OK || t0.verdict != STL_HEALTH_VERDICT_PASS ||
+        t0.runs != ROUNDS || t0.failures != 0u || t0.signature != ROUNDS || t1.verdict != STL_HEALTH_VERDICT_PASS ||
+        t1.runs != ROUNDS || t1.failures != ROUNDS / 2u || t1.updated <= t0.updated ||
+        STL_health_reader_generation(reader) != ROUNDS * STL_TOT_RT_ROUTINE)
+    {
+        printf("FAIL: test 0: %u runs verdict %u, test 1: %u runs %u failures verdict %u\n", t0.runs, t0.verdict,
+               t1.runs, t1.failures, t1.verdict);
+        return 1;
+    }
+    return 0;
+}
+
+static int check_concurrent(STL_HEALTH_READER_T *reader)
+{
+    pthread_t thread;
+    STL_ERROR_T err;
+    unsigned round;
+
+    if (pthread_create(&thread, NULL, supervisor, reader) != 0)
+    {
+        return 1;
+    }
+    for (round = 0; round < STRESS_ROUNDS; round++)
+    {
+        STL_schedule_runtime(0, &err);
+    }
+    stress_done = 1;
+    pthread_join(thread, NULL);
+    printf("%lu snapshots during %u rounds, %lu torn\n", snapshots, STRESS_ROUNDS, torn);
+    return torn != 0u;
+}
+
+static void report_cost(const STL_HEALTH_READER_T *reader)
+{
+    STL_HEALTH_TEST_T test;
+    struct timespec start;
+    struct timespec end;
+    unsigned i;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < 1000000u; i++)
+    {
+        STL_health_reader_test(reader, 0, i & 1u, &test);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    printf("%.1f ns per snapshot\n",
+           ((end.tv_sec - start.tv_sec) * 1e9 + (double)(end.tv_nsec - start.tv_nsec)) / 1000000.0);
+}
+
+int main(void)
+{
+    STL_HEALTH_READER_T reader;
+    STL_HEALTH_READER_T gone;
+    STL_ERROR_T err;
+    int failures = 0;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE || STL_health_reader_open(&reader, STL_HEALTH_SHM_NAME) != STL_HEALTH_READER_OK)
+    {
+        printf("FAIL: region not published (%d)\n", (int)err);
+        return 1;
+    }
+    SBST_RT[0] = sbst_count;
+    SBST_RT[1] = sbst_flaky;
+
+    failures += check_layout(&reader);
+    failures += check_verdicts(&reader);
+    failures += check_concurrent(&reader);
+    report_cost(&reader);
+
+    STL_deinit(&err);
+    if (STL_health_reader_state(&reader) != STL_HEALTH_STATE_STOPPED ||
+        STL_health_reader_open(&gone, STL_HEALTH_SHM_NAME) != STL_HEALTH_READER_NOT_FOUND)
+    {
+        printf("FAIL: region still published after STL_deinit\n");
+        failures++;
+    }
+    STL_health_reader_close(&reader);
+    return failures;
+}
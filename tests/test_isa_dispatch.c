@@ -0,0 +1,153 @@
+#include <stdio.h>
+
+#include "stl.h"
+#include "stl_al_cpu.h"
+#include "stl_error_management.h"
+#include "stl_sbst_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * Runtime ISA dispatch of the SBST variants (built with STL_USE_ISA_DISPATCH=1).
+ * - the extensions detected by STL_init match the ones reported by the compiler runtime;
+ * - SBST_RT holds the widest variant the CPU supports;
+ * - every supported variant computes the signature of the baseline;
+ * - a scheduled run of the selected variant passes;
+ * - the skipped signature of a routine without supported variant reads as not run.
+ */
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
+
+static STL_ISA_FEATURES_T host_features(void)
+{
+    STL_ISA_FEATURES_T features = 0u;
+
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2"))
+    {
+        features |= STL_CPU_ISA_SSE42;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        features |= STL_CPU_ISA_AVX2;
+    }
+    if (__builtin_cpu_supports("fma"))
+    {
+        features |= STL_CPU_ISA_FMA;
+    }
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+        __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl"))
+    {
+        features |= STL_CPU_ISA_AVX512;
+    }
+    return features;
+}
+
+static int check_features(void)
+{
+    STL_ISA_FEATURES_T features = STL_get_isa_features();
+
+    printf("ISA extensions: 0x%x\n", (unsigned)features);
+    if (features != host_features())
+    {
+        printf("FAIL: detected 0x%x, host reports 0x%x\n", (unsigned)features, (unsigned)host_features());
+        return 1;
+    }
+    return 0;
+}
+
+static int check_selection(void)
+{
+    STL_ISA_FEATURES_T features = STL_get_isa_features();
+    STL_FUNCT_PTR_T expected = test_adder;
+
+    if ((features & STL_CPU_ISA_AVX512) != 0u)
+    {
+        expected = test_adder_avx512;
+    }
+    else if ((features & STL_CPU_ISA_AVX2) != 0u)
+    {
+        expected = test_adder_avx2;
+    }
+    else if ((features & STL_CPU_ISA_SSE42) != 0u)
+    {
+        expected = test_adder_sse42;
+    }
+    if (SBST_RT[0] != expected)
+    {
+        printf("FAIL: the widest supported variant is not selected\n");
+        return 1;
+    }
+    return 0;
+}
+
+static int check_signatures(void)
+{
+    STL_ISA_FEATURES_T features = STL_get_isa_features();
+    STL_SIGNATURE_T sig = test_adder();
+    int failures = 0;
+
+    if ((features & STL_CPU_ISA_SSE42) != 0u && test_adder_sse42() != sig)
+    {
+        printf("FAIL: SSE4.2 variant signature 0x%x, baseline 0x%x\n", (unsigned)test_adder_sse42(), (unsigned)sig);
+        failures++;
+    }
+    if ((features & STL_CPU_ISA_AVX2) != 0u && test_adder_avx2() != sig)
+    {
+        printf("FAIL: AVX2 variant signature 0x%x, baseline 0x%x\n", (unsigned)test_adder_avx2(), (unsigned)sig);
+        failures++;
+    }
+    if ((features & STL_CPU_ISA_AVX512) != 0u && test_adder_avx512() != sig)
+    {
+        printf("FAIL: AVX-512 variant signature 0x%x, baseline 0x%x\n", (unsigned)test_adder_avx512(), (unsigned)sig);
+        failures++;
+    }
+    return failures;
+}
+
+static int check_run(void)
+{
+    STL_ERROR_T err;
+
+    STL_schedule_runtime(0, &err);
+    if (err != STL_ERROR_NONE || STL_em_rt_get_verdict(0, 0, &err) != STL_VERDICT_PASS)
+    {
+        printf("FAIL: the selected variant does not pass\n");
+        return 1;
+    }
+    return 0;
+}
+
+static int check_skipped(void)
+{
+    STL_ERROR_T err;
+
+    STL_em_update_sig(0, STL_SIGNATURE_SKIPPED, 0, &err);
+    if (STL_em_rt_get_verdict(0, 0, &err) != STL_VERDICT_NOT_RUN || STL_em_runtime_failed(0, &err) != (STL_SIZE_T)-1)
+    {
+        printf("FAIL: a skipped routine does not read as not run\n");
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+
+    failures += check_features();
+    failures += check_selection();
+    failures += check_signatures();
+    failures += check_run();
+    failures += check_skipped();
+
+    STL_deinit(&err);
+    return failures;
+}
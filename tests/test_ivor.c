@@ -0,0 +1,221 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <setjmp.h>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "stl.h"
+#include "stl_sbst_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * Exception vector switching on the host (built with STL_MULTICORE_SOC, STL_NUM_CPU=2,
+ * STL_BOOT_TEST and STL_TOT_BT_ROUTINE=1). Each CPU is a thread scheduling its boot-time test,
+ * which traps on purpose (illegal instruction) and resumes from the STL trap hook:
+ * - inside the swapped window every trap reaches the STL hook. In each round CPU 0 enters its
+ *   window while CPU 1 is inside its own, and CPU 1 traps only once CPU 0 has restored its
+ *   vectors: a CPU restoring its vectors does not retarget those of the other one;
+ * - every window is counted by the swap statistics of its CPU, whose cycles are reported;
+ * - after the restore a trap reaches the handler of the application;
+ * - a trap the application ignores is dropped and the dispatcher stays installed;
+ * - a trap with the default action terminates the process with that signal.
+ */
+
+#define CPUS 2u
+#define ROUNDS 100u
+#define SIGNATURE 0x1B0Bu
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_BT[CPUS * STL_TOT_BT_ROUTINE];
+
+typedef struct
+{
+    STL_CPUS cpu;
+    unsigned failures;
+    STL_CPU_IVOR_STATS_T stats;
+} WORKER_T;
+
+static __thread sigjmp_buf resume;
+static __thread unsigned stl_traps;
+static __thread STL_CPUS self;
+static __thread unsigned round_number;
+static unsigned app_traps;
+static unsigned entered;  /* Rounds CPU 1 has entered its window for */
+static unsigned restored; /* Rounds CPU 0 has restored its vectors for */
+
+/* STL trap hook: records the trap and resumes the test */
+void STL_TSSP_CPU_trap(int signo, siginfo_t *info, void *ctx)
+{
+    (void)signo;
+    (void)info;
+    (void)ctx;
+    stl_traps++;
+    siglongjmp(resume, 1);
+}
+
+static void app_handler(int signo)
+{
+    (void)signo;
+    __atomic_add_fetch(&app_traps, 1u, __ATOMIC_RELAXED);
+    siglongjmp(resume, 1);
+}
+
+static STL_SIGNATURE_T sbst_trap(void)
+{
+    if (self == 1u)
+    {
+        __atomic_store_n(&entered, round_number + 1u, __ATOMIC_RELEASE);
+        while (__atomic_load_n(&restored, __ATOMIC_ACQUIRE) <= round_number)
+        {
+            sched_yield();
+        }
+    }
+    else
+    {
+        while (__atomic_load_n(&entered, __ATOMIC_ACQUIRE) <= round_number)
+        {
+            sched_yield();
+        }
+    }
+    if (sigsetjmp(resume, 1) == 0)
+    {
+        __builtin_trap();
+    }
+    return SIGNATURE;
+}
+
+static void *worker(void *arg)
+{
+    WORKER_T *w = (WORKER_T *)arg;
+    STL_ERROR_T err;
+    unsigned r;
+
+    self = w->cpu;
+    for (r = 0; r < ROUNDS; r++)
+    {
+        round_number = r;
+        err = STL_ERROR_NONE;
+        STL_schedule_bootime(w->cpu, &err);
+        if (err != STL_ERROR_NONE || STL_em_bt_get_signature(w->cpu, 0u, &err) != SIGNATURE)
+        {
+            w->failures++;
+        }
+        if (self == 0u)
+        {
+            __atomic_store_n(&restored, r + 1u, __ATOMIC_RELEASE);
+        }
+    }
+    STL_TSSP_CPU_get_ivor_stats(&w->stats);
+    if (stl_traps != ROUNDS || w->stats.swaps != ROUNDS)
+    {
+        printf("FAIL: CPU %u, %u traps in %u windows instead of %u\n", (unsigned)w->cpu, stl_traps,
+               (unsigned)w->stats.swaps, ROUNDS);
+        w->failures++;
+    }
+    return NULL;
+}
+
+static int check_windows(void)
+{
+    pthread_t threads[CPUS];
+    WORKER_T workers[CPUS];
+    unsigned i;
+    int result = 0;
+
+    for (i = 0; i < CPUS; i++)
+    {
+        SBST_BT[i * STL_TOT_BT_ROUTINE] = sbst_trap;
+        workers[i].cpu = (STL_CPUS)i;
+        workers[i].failures = 0;
+        pthread_create(&threads[i], NULL, worker, &workers[i]);
+    }
+    for (i = 0; i < CPUS; i++)
+    {
+        pthread_join(threads[i], NULL);
+        result += (int)workers[i].failures;
+        printf("CPU %u: swap %llu cycles (worst %llu), restore %llu cycles (worst %llu)\n", i,
+               (unsigned long long)workers[i].stats.last_swap_cycles,
+               (unsigned long long)workers[i].stats.max_swap_cycles,
+               (unsigned long long)workers[i].stats.last_restore_cycles,
+               (unsigned long long)workers[i].stats.max_restore_cycles);
+    }
+    if (app_traps != 0u)
+    {
+        printf("FAIL: %u traps of a window reached the application\n", app_traps);
+        result++;
+    }
+    return result;
+}
+
+static int check_forwarding(void)
+{
+    struct sigaction current;
+    pid_t child;
+    int status;
+    int result = 0;
+
+    if (sigsetjmp(resume, 1) == 0)
+    {
+        __builtin_trap();
+    }
+    if (app_traps != 1u || stl_traps != 0u)
+    {
+        printf("FAIL: trap outside a window, %u to the application, %u to the STL\n", app_traps, stl_traps);
+        result++;
+    }
+
+    raise(SIGTRAP);
+    raise(SIGTRAP);
+    sigaction(SIGTRAP, NULL, &current);
+    if ((current.sa_flags & SA_SIGINFO) == 0)
+    {
+        printf("FAIL: dispatcher replaced by an ignored action\n");
+        result++;
+    }
+
+    child = fork();
+    if (child == 0)
+    {
+        struct rlimit no_core = {0, 0};
+
+        setrlimit(RLIMIT_CORE, &no_core);
+        raise(SIGFPE);
+        _exit(0);
+    }
+    waitpid(child, &status, 0);
+    if (!WIFSIGNALED(status) || WTERMSIG(status) != SIGFPE)
+    {
+        printf("FAIL: default action not taken (status 0x%x)\n", status);
+        result++;
+    }
+    return result;
+}
+
+int main(void)
+{
+    struct sigaction app;
+    STL_ERROR_T err;
+    int failures = 0;
+
+    /* Actions of the application, installed before the STL */
+    sigemptyset(&app.sa_mask);
+    app.sa_flags = 0;
+    app.sa_handler = app_handler;
+    sigaction(SIGILL, &app, NULL);
+    app.sa_handler = SIG_IGN;
+    sigaction(SIGTRAP, &app, NULL);
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+    failures += check_windows();
+    failures += check_forwarding();
+    STL_deinit(&err);
+    return failures;
+}
@@ -0,0 +1,224 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "stl.h"
+#include "stl_march.h"
+#include "stl_sbst_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * Transparent March C- RAM test on the host (built with STL_MARCH_CHUNK_BYTES=8192).
+ * - the March test is scheduled as runtime test 0; a full sweep of a buffer takes
+ *   bytes / STL_MARCH_CHUNK_BYTES steps, passes, and leaves the contents unchanged;
+ * - an address-decoder fault (the same page mapped at two addresses of one block) fails the
+ *   step testing that block, and the contents are restored;
+ * - misaligned regions are rejected;
+ * - benchmark: bytes per second and time per full sweep of a 4 MiB buffer.
+ */
+
+#define MARCH_TEST 0u
+#define BUFFER_BYTES (256u * 1024u)
+#define BENCH_BYTES (4u * 1024u * 1024u)
+#define BENCH_SWEEPS 20u
+#define SWEEPS 3u
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
+
+static STL_MARCH_REGION_T regions[1];
+
+static void fill(uint8_t *p, size_t n, uint32_t seed)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        p[i] = (uint8_t)(seed >> 24);
+    }
+}
+
+/* Runs the schedule until the March test completes the given number of sweeps */
+static int run_sweeps(STL_INT32U_T sweeps, STL_VERDICT_T *worst)
+{
+    STL_MARCH_STATS_T stats;
+    STL_ERROR_T err;
+    unsigned guard = 0;
+
+    *worst = STL_VERDICT_PASS;
+    do
+    {
+        STL_schedule_runtime(0, &err);
+        if (err != STL_ERROR_NONE)
+        {
+            return -1;
+        }
+        if (STL_em_rt_get_verdict(0, MARCH_TEST, &err) != STL_VERDICT_PASS)
+        {
+            *worst = STL_VERDICT_FAIL;
+        }
+        STL_march_get_stats(&stats, &err);
+    } while (stats.sweeps < sweeps && ++guard < 1000000u);
+    return 0;
+}
+
+static int check_sweep(void)
+{
+    uint8_t *buffer = aligned_alloc(STL_MARCH_ALIGN, BUFFER_BYTES);
+    uint8_t *copy = malloc(BUFFER_BYTES);
+    STL_MARCH_STATS_T stats;
+    STL_VERDICT_T verdict;
+    STL_ERROR_T err;
+    int failures = 0;
+
+    fill(buffer, BUFFER_BYTES, 1u);
+    memcpy(copy, buffer, BUFFER_BYTES);
+    regions[0].start = buffer;
+    regions[0].size = BUFFER_BYTES;
+    STL_march_init(regions, 1u, &err);
+    if (err != STL_ERROR_NONE || run_sweeps(SWEEPS, &verdict) != 0 || verdict != STL_VERDICT_PASS)
+    {
+        printf("FAIL: fault-free buffer reported as faulty\n");
+        failures++;
+    }
+    STL_march_get_stats(&stats, &err);
+    if (stats.sweeps != SWEEPS || stats.faults != 0u || stats.sweep_bytes != BUFFER_BYTES ||
+        stats.sweep_steps != BUFFER_BYTES / STL_MARCH_CHUNK_BYTES)
+    {
+        printf("FAIL: unexpected sweep (%u sweeps, %u steps)\n", (unsigned)stats.sweeps, (unsigned)stats.sweep_steps);
+        failures++;
+    }
+    if (memcmp(buffer, copy, BUFFER_BYTES) != 0)
+    {
+        printf("FAIL: contents changed by the March test\n");
+        failures++;
+    }
+    free(copy);
+    free(buffer);
+    return failures;
+}
+
+static int check_alias(void)
+{
+    long page = sysconf(_SC_PAGESIZE);
+    int fd = memfd_create("stl_march", 0);
+    uint8_t *base;
+    uint8_t copy[64];
+    STL_MARCH_STATS_T stats;
+    STL_ERROR_T err;
+    int failures = 0;
+
+    if (fd < 0 || ftruncate(fd, page) != 0 || 2 * page > (long)STL_MARCH_CHUNK_BYTES)
+    {
+        printf("alias check skipped\n");
+        return 0;
+    }
+    /* The two pages of the block are the same memory: a write to one changes the other */
+    base = mmap(NULL, 2 * page, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    mmap(base, page, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+    mmap(base + page, page, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+    fill(base, page, 2u);
+    memcpy(copy, base, sizeof(copy));
+
+    regions[0].start = base;
+    regions[0].size = 2 * page;
+    STL_march_init(regions, 1u, &err);
+    if (STL_march_test() != STL_SIGNATURE_MISMATCH)
+    {
+        printf("FAIL: aliased pages not detected\n");
+        failures++;
+    }
+    STL_march_get_stats(&stats, &err);
+    if (stats.faults != 1u || stats.last_fault != base)
+    {
+        printf("FAIL: fault reported at %p (%u faults)\n", stats.last_fault, (unsigned)stats.faults);
+        failures++;
+    }
+    if (memcmp(base, copy, sizeof(copy)) != 0)
+    {
+        printf("FAIL: contents not restored after the fault\n");
+        failures++;
+    }
+    munmap(base, 2 * page);
+    close(fd);
+    return failures;
+}
+
+static int check_alignment(void)
+{
+    static uint8_t buffer[2 * STL_MARCH_ALIGN] __attribute__((aligned(STL_MARCH_ALIGN)));
+    STL_ERROR_T err;
+
+    regions[0].start = buffer + 4;
+    regions[0].size = STL_MARCH_ALIGN;
+    STL_march_init(regions, 1u, &err);
+    if (err != STL_INDEX_OUT_OF_BOUNDS)
+    {
+        printf("FAIL: misaligned region accepted\n");
+        return 1;
+    }
+    regions[0].start = buffer;
+    regions[0].size = STL_MARCH_ALIGN + 4u;
+    STL_march_init(regions, 1u, &err);
+    if (err != STL_INDEX_OUT_OF_BOUNDS)
+    {
+        printf("FAIL: region size not multiple of the alignment accepted\n");
+        return 1;
+    }
+    return 0;
+}
+
+static void bench(void)
+{
+    uint8_t *buffer = aligned_alloc(STL_MARCH_ALIGN, BENCH_BYTES);
+    STL_MARCH_STATS_T stats;
+    struct timespec start, end;
+    STL_ERROR_T err;
+    double s;
+
+    fill(buffer, BENCH_BYTES, 3u);
+    regions[0].start = buffer;
+    regions[0].size = BENCH_BYTES;
+    STL_march_init(regions, 1u, &err);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do
+    {
+        (void)STL_march_test();
+        STL_march_get_stats(&stats, &err);
+    } while (stats.sweeps < BENCH_SWEEPS);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    s = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) * 1e-9;
+
+    printf("March C- on %u bytes, %u bytes per step: %.1f MB/s, %.3f ms per full sweep\n", (unsigned)BENCH_BYTES,
+           (unsigned)STL_MARCH_CHUNK_BYTES, (double)BENCH_BYTES * BENCH_SWEEPS / s / 1e6, s * 1e3 / BENCH_SWEEPS);
+    printf("last sweep: %u steps, %llu busy cycles (%.3f cycles/byte), worst step %llu cycles\n",
+           (unsigned)stats.sweep_steps, (unsigned long long)stats.sweep_busy_cycles,
+           (double)stats.sweep_busy_cycles / stats.sweep_bytes, (unsigned long long)stats.max_step_cycles);
+    free(buffer);
+}
+
+int main(void)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+    SBST_RT[MARCH_TEST] = STL_march_test;
+
+    failures += check_sweep();
+    failures += check_alias();
+    failures += check_alignment();
+    bench();
+
+    STL_deinit(&err);
+    return failures;
+}
@@ -0,0 +1,123 @@
+#include <stdio.h>
+
+#include "stl.h"
+#include "stl_sbst_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * MPU profiles on the host MPU model.
+ * - the first switch programs every register (the shadow copy is not valid yet);
+ * - a switch writes only the registers that differ between the two profiles;
+ * - switching to the current profile writes nothing;
+ * - the scheduler isolates each runtime test with its profile and restores the application one;
+ * - the cost of a switch is reported.
+ */
+
+#define SWITCH_LOOPS 1000
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
+
+static STL_SIGNATURE_T sbst_nop(void)
+{
+    return 0x5a5a5a5a;
+}
+
+static int check_switch(STL_SIZE_T profile, STL_INT32U_T expected_writes)
+{
+    STL_CPU_MPU_STATS_T stats;
+    STL_ERROR_T err;
+
+    STL_TSSP_CPU_configure_mpu(&STL_mpu_profiles[profile], &err);
+    STL_TSSP_CPU_get_mpu_stats(&stats);
+    printf("profile %u: %u register writes, %llu cycles\n", (unsigned)profile, (unsigned)stats.last_writes,
+           (unsigned long long)stats.last_cycles);
+    if (err != STL_ERROR_NONE || stats.last_writes != expected_writes)
+    {
+        printf("FAIL: expected %u register writes\n", (unsigned)expected_writes);
+        return 1;
+    }
+    return 0;
+}
+
+static int check_scheduler(void)
+{
+    STL_CPU_MPU_STATS_T before;
+    STL_CPU_MPU_STATS_T after;
+    STL_ERROR_T err;
+
+    SBST_RT[0] = sbst_nop;
+    STL_TSSP_CPU_get_mpu_stats(&before);
+    STL_schedule_runtime(0, &err);
+    STL_TSSP_CPU_get_mpu_stats(&after);
+    /* CPU profile then application profile, 5 writes each way */
+    if (err != STL_ERROR_NONE || after.switches - before.switches != 2 || after.reg_writes - before.reg_writes != 10)
+    {
+        printf("FAIL: scheduler did not isolate the test (%u switches, %u writes)\n",
+               (unsigned)(after.switches - before.switches), (unsigned)(after.reg_writes - before.reg_writes));
+        return 1;
+    }
+    return 0;
+}
+
+static int check_oversized(void)
+{
+    static const STL_CPU_MPU_CFG_t region = {0x20000000u, 0x1000u, STL_CPU_MPU_ACCESS_READ};
+    const STL_CPU_MPU_PROFILE_T oversized = {&region, 64u};
+    STL_ERROR_T err;
+
+    STL_TSSP_CPU_configure_mpu(&oversized, &err);
+    if (err != STL_ERROR_MPU)
+    {
+        printf("FAIL: oversized profile accepted\n");
+        return 1;
+    }
+    return 0;
+}
+
+static void bench_switch(void)
+{
+    STL_CPU_MPU_STATS_T stats;
+    STL_CYCLES_T start;
+    STL_CYCLES_T cycles;
+    STL_ERROR_T err;
+    int i;
+
+    start = STL_TSSP_CPU_get_cycles();
+    for (i = 0; i < SWITCH_LOOPS; i++)
+    {
+        STL_TSSP_CPU_configure_mpu(&STL_mpu_profiles[STL_MPU_PROFILE_MEMORY], &err);
+        STL_TSSP_CPU_configure_mpu(&STL_mpu_profiles[STL_MPU_PROFILE_APPLICATION], &err);
+    }
+    cycles = STL_TSSP_CPU_get_cycles() - start;
+    STL_TSSP_CPU_get_mpu_stats(&stats);
+    printf("isolate + restore per test: %llu cycles, %u register writes\n",
+           (unsigned long long)(cycles / SWITCH_LOOPS), (unsigned)(2u * stats.last_writes));
+}
+
+int main(void)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+
+    /* 8 regions, base + attributes */
+    failures += check_switch(STL_MPU_PROFILE_APPLICATION, 16);
+    /* Region 1 moved (disable, base, attributes), region 2 disabled (disable, base) */
+    failures += check_switch(STL_MPU_PROFILE_CPU, 5);
+    failures += check_switch(STL_MPU_PROFILE_CPU, 0);
+    /* Region 2 enabled on the test window (base, attributes) */
+    failures += check_switch(STL_MPU_PROFILE_MEMORY, 2);
+    failures += check_switch(STL_MPU_PROFILE_APPLICATION, 0 + 3 + 3);
+    failures += check_scheduler();
+    failures += check_oversized();
+    bench_switch();
+
+    STL_deinit(&err);
+    return failures;
+}
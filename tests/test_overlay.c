@@ -0,0 +1,218 @@
+#include <stdio.h>
+#include <sys/mman.h>
+
+#include "stl.h"
+#include "stl_crc.h"
+#include "stl_overlay.h"
+#include "stl_sbst_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * Overlay manager on the host (built with STL_TOT_RT_ROUTINE=6, with and without the DMA).
+ * - the entry point returned for an overlaid test lies in the slot pool and computes the signature;
+ * - the scheduler runs six tests through three slots: after the first miss every test has been
+ *   prefetched while its predecessor was running, so every other dispatch is a hit;
+ * - a block that does not match its CRC is rejected, a test without a block runs in place;
+ * - the load cycles per dispatch are reported;
+ * - once the manager is stopped, with the prefetch of the next round in flight, the tests run in
+ *   place and the pool can be unmapped.
+ */
+
+#define SLOT_SIZE 256u
+#define NUM_SLOTS 3u
+#define ROUNDS 100u
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
+
+/* Each test lives in its own section, the linker provides its bounds (the ROM image of the block) */
+#define OVERLAY_TEST(n)                                                                              \
+    extern const uint8_t __start_stl_ovl_##n[];                                                      \
+    extern const uint8_t __stop_stl_ovl_##n[];                                                       \
+    __attribute__((section("stl_ovl_" #n), noinline, used)) static STL_SIGNATURE_T sbst_ovl_##n(void) \
+    {                                                                                                \
+        return 0x1000 + n;                                                                           \
+    }
+
+OVERLAY_TEST(0)
+OVERLAY_TEST(1)
+OVERLAY_TEST(2)
+OVERLAY_TEST(3)
+OVERLAY_TEST(4)
+OVERLAY_TEST(5)
+
+static const uint8_t *const block_start[STL_TOT_RT_ROUTINE] = {
+    __start_stl_ovl_0, __start_stl_ovl_1, __start_stl_ovl_2, __start_stl_ovl_3, __start_stl_ovl_4, __start_stl_ovl_5,
+};
+
+static const uint8_t *const block_end[STL_TOT_RT_ROUTINE] = {
+    __stop_stl_ovl_0, __stop_stl_ovl_1, __stop_stl_ovl_2, __stop_stl_ovl_3, __stop_stl_ovl_4, __stop_stl_ovl_5,
+};
+
+static STL_OVERLAY_T overlays[STL_TOT_RT_ROUTINE];
+
+static STL_FUNCT_PTR_T in_place[STL_TOT_RT_ROUTINE] = {
+    sbst_ovl_0, sbst_ovl_1, sbst_ovl_2, sbst_ovl_3, sbst_ovl_4, sbst_ovl_5,
+};
+
+static uint8_t *pool;
+
+static void setup(STL_ERROR_T *err)
+{
+    unsigned i;
+
+    for (i = 0; i < STL_TOT_RT_ROUTINE; i++)
+    {
+        overlays[i].src = block_start[i];
+        overlays[i].size = (STL_INT32U_T)(block_end[i] - block_start[i]);
+        overlays[i].entry = 0u;
+        overlays[i].crc = STL_CRC32C_FINAL(STL_crc32c_update(STL_CRC32C_INIT, overlays[i].src, overlays[i].size));
+        SBST_RT[i] = in_place[i];
+    }
+    STL_overlay_init(0, overlays, pool, NUM_SLOTS * SLOT_SIZE, SLOT_SIZE, err);
+}
+
+static int check_init(void)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+
+    STL_overlay_init(0, overlays, pool, NUM_SLOTS * SLOT_SIZE, SLOT_SIZE + 1u, &err);
+    if (err != STL_ERROR_RELOCATION)
+    {
+        printf("FAIL: unaligned slot size accepted\n");
+        failures++;
+    }
+    STL_overlay_init(0, overlays, pool, SLOT_SIZE - 4u, SLOT_SIZE, &err);
+    if (err != STL_ERROR_RELOCATION)
+    {
+        printf("FAIL: pool smaller than a slot accepted\n");
+        failures++;
+    }
+    return failures;
+}
+
+static int check_get(void)
+{
+    STL_FUNCT_PTR_T entry;
+    STL_ERROR_T err;
+    unsigned i;
+
+    setup(&err);
+    for (i = 0; i < STL_TOT_RT_ROUTINE; i++)
+    {
+        entry = STL_overlay_get(0, i, &err);
+        if (err != STL_ERROR_NONE || (uint8_t *)(uintptr_t)entry < pool ||
+            (uint8_t *)(uintptr_t)entry >= pool + NUM_SLOTS * SLOT_SIZE || entry() != (STL_SIGNATURE_T)(0x1000 + i))
+        {
+            printf("FAIL: test %u not executed from the slot pool\n", i);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int check_scheduler(void)
+{
+    STL_OVERLAY_STATS_T stats;
+    STL_ERROR_T err;
+    unsigned round;
+    unsigned i;
+    int failures = 0;
+
+    setup(&err);
+    for (round = 0; round < ROUNDS; round++)
+    {
+        STL_schedule_runtime(0, &err);
+        for (i = 0; i < STL_TOT_RT_ROUTINE; i++)
+        {
+            if (err != STL_ERROR_NONE || STL_em_rt_get_verdict(0, i, &err) != STL_VERDICT_PASS)
+            {
+                printf("FAIL: round %u test %u did not pass\n", round, i);
+                return 1;
+            }
+        }
+    }
+
+    STL_overlay_get_stats(0, &stats, &err);
+    printf("%u dispatches: %u hits, %u misses, %u prefetches, %u evictions, %llu load cycles (max %llu)\n",
+           ROUNDS * STL_TOT_RT_ROUTINE, (unsigned)stats.hits, (unsigned)stats.misses, (unsigned)stats.prefetches,
+           (unsigned)stats.evictions, (unsigned long long)stats.load_cycles,
+           (unsigned long long)stats.max_load_cycles);
+    printf("hit rate %.1f%%, %llu load cycles per dispatch\n", 100.0 * stats.hits / (stats.hits + stats.misses),
+           (unsigned long long)(stats.load_cycles / (ROUNDS * STL_TOT_RT_ROUTINE)));
+    if (stats.misses != 1u || stats.hits != ROUNDS * STL_TOT_RT_ROUTINE - 1u)
+    {
+        printf("FAIL: expected a single miss\n");
+        failures++;
+    }
+    return failures;
+}
+
+static int check_corruption(void)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+
+    setup(&err);
+    overlays[2].crc ^= 1u;
+    if (STL_overlay_get(0, 2, &err) != STL_NULL || err != STL_ERROR_RELOCATION_CRC)
+    {
+        printf("FAIL: corrupted block accepted\n");
+        failures++;
+    }
+    overlays[2].crc ^= 1u;
+
+    overlays[3].src = STL_NULL;
+    if (STL_overlay_get(0, 3, &err) != STL_NULL || err != STL_ERROR_NONE)
+    {
+        printf("FAIL: test without block not run in place\n");
+        failures++;
+    }
+    overlays[3].src = block_start[3];
+    return failures;
+}
+
+static int check_deinit(void)
+{
+    STL_ERROR_T err;
+
+    setup(&err);
+    STL_schedule_runtime(0, &err);
+    STL_overlay_deinit(0, &err);
+    if (err != STL_ERROR_NONE || STL_overlay_get(0, 0, &err) != STL_NULL || err != STL_ERROR_NONE)
+    {
+        printf("FAIL: test not run in place once the manager is stopped\n");
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+
+    pool = mmap(NULL, NUM_SLOTS * SLOT_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pool == MAP_FAILED)
+    {
+        printf("SKIP: no executable mapping\n");
+        return 77;
+    }
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+
+    failures += check_init();
+    failures += check_get();
+    failures += check_scheduler();
+    failures += check_corruption();
+    failures += check_deinit();
+
+    STL_deinit(&err);
+    munmap(pool, NUM_SLOTS * SLOT_SIZE);
+    return failures;
+}
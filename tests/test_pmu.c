@@ -0,0 +1,140 @@
+#include <stdio.h>
+
+#include "stl.h"
+#include "stl_sbst_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * Performance counters on the host (built with STL_USE_PMU=1 and STL_TOT_RT_ROUTINE=2).
+ * - test 1 runs ten times the loop of test 0: its cycles (and instructions, when the PMU
+ *   is exposed) must be larger, and every execution must be accounted;
+ * - the counters the host cannot open are reported and read as zero;
+ * - an out-of-range test index is rejected.
+ */
+
+#define ROUNDS 50u
+#define LOOPS 20000u
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
+
+static const char *const names[STL_PMU_NUM_COUNTERS] = {"cycles", "instructions", "cache misses", "branch misses",
+                                                        "interrupts"};
+
+static STL_SIGNATURE_T loop(STL_INT32U_T n)
+{
+    volatile STL_INT32U_T acc = 0;
+    STL_INT32U_T i;
+
+    for (i = 0; i < n; i++)
+    {
+        acc += i ^ (acc << 1);
+    }
+    return (STL_SIGNATURE_T)(acc & 0u) + 0x1234;
+}
+
+static STL_SIGNATURE_T sbst_short(void)
+{
+    return loop(LOOPS);
+}
+
+static STL_SIGNATURE_T sbst_long(void)
+{
+    return loop(10u * LOOPS);
+}
+
+static int check_aggregates(STL_INT32U_T mask)
+{
+    STL_PMU_STATS_T stats[STL_TOT_RT_ROUTINE];
+    STL_ERROR_T err;
+    unsigned round;
+    unsigned i;
+    unsigned c;
+    int failures = 0;
+
+    for (round = 0; round < ROUNDS; round++)
+    {
+        STL_schedule_runtime(0, &err);
+        if (err != STL_ERROR_NONE)
+        {
+            printf("FAIL: round %u\n", round);
+            return 1;
+        }
+    }
+
+    for (i = 0; i < STL_TOT_RT_ROUTINE; i++)
+    {
+        STL_em_rt_get_pmu(0, i, &stats[i], &err);
+        if (err != STL_ERROR_NONE || stats[i].runs != ROUNDS)
+        {
+            printf("FAIL: test %u sampled %u times\n", i, (unsigned)stats[i].runs);
+            return 1;
+        }
+        for (c = 0; c < STL_PMU_NUM_COUNTERS; c++)
+        {
+            printf("test %u %-14s %s avg %llu max %llu\n", i, names[c], (mask & (1u << c)) ? "   " : "n/a",
+                   (unsigned long long)(stats[i].sum[c] / stats[i].runs), (unsigned long long)stats[i].max[c]);
+            if ((mask & (1u << c)) == 0u && stats[i].sum[c] != 0u)
+            {
+                printf("FAIL: unavailable counter %u is not zero\n", c);
+                failures++;
+            }
+        }
+    }
+
+    /* The counters 0 (cycles) and 1 (instructions) scale with the loop */
+    for (c = 0; c < 2u; c++)
+    {
+        if ((mask & (1u << c)) != 0u && stats[1].sum[c] <= 2u * stats[0].sum[c])
+        {
+            printf("FAIL: %s of the long test do not scale (%llu vs %llu)\n", names[c],
+                   (unsigned long long)stats[1].sum[c], (unsigned long long)stats[0].sum[c]);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+static int check_bounds(void)
+{
+    STL_PMU_STATS_T stats;
+    STL_ERROR_T err;
+
+    STL_em_rt_get_pmu(0, STL_TOT_RT_ROUTINE, &stats, &err);
+    if (err != STL_INDEX_OUT_OF_BOUNDS)
+    {
+        printf("FAIL: out-of-range test index accepted\n");
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    STL_INT32U_T mask;
+    STL_ERROR_T err;
+    int failures = 0;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+    /* Reprogrammed to learn which counters the host exposes */
+    mask = STL_TSSP_CPU_pmu_init(&err);
+    if (err != STL_ERROR_NONE || (mask & 1u) == 0u)
+    {
+        printf("FAIL: cycles not available (mask 0x%x)\n", (unsigned)mask);
+        return 1;
+    }
+    printf("available counters: 0x%x\n", (unsigned)mask);
+
+    SBST_RT[0] = sbst_short;
+    SBST_RT[1] = sbst_long;
+
+    failures += check_aggregates(mask);
+    failures += check_bounds();
+
+    STL_deinit(&err);
+    return failures;
+}
@@ -0,0 +1,318 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdio.h>
+
+#include "stl.h"
+#include "stl_redundancy.h"
+#include "stl_sbst_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * Software redundancy on the host (built with STL_MULTICORE_SOC, STL_NUM_CPU=4,
+ * STL_TOT_RT_ROUTINE=3, test 0 flagged STL_REDUNDANCY_PAIR, test 1 STL_REDUNDANCY_TWICE and
+ * test 2 not flagged). Each CPU is a thread scheduling its own runtime tests, the pairs being
+ * CPUs 0-1 and 2-3; the threads meet at the end of each round so that the partners stay within
+ * one run of each other.
+ * - without fault every divergence verdict is a pass, nothing is lost;
+ * - a CPU computing another signature than its partner fails the divergence verdict of both
+ *   CPUs, while the verdicts of the error management still pass;
+ * - a transient fault in the second execution of a test on one CPU fails its divergence verdict;
+ * - a CPU running ahead of its partner gets a timeout verdict, the partner catches up and the
+ *   pair compares again;
+ * - invalid CPUs and tests are rejected.
+ * The cycles spent in an exchange are reported, with the partners on different threads and
+ * with the two CPUs of a pair scheduled one after the other by the same thread.
+ */
+
+#define CPUS 4u
+#define ROUNDS 1000u
+#define PAIR_TEST 0u
+#define TWICE_TEST 1u
+#define PLAIN_TEST 2u
+#define SIGNATURE 0x7E57u
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[CPUS * STL_TOT_RT_ROUTINE];
+
+typedef struct
+{
+    STL_CPUS cpu;
+    unsigned rounds;
+    unsigned failures;
+} WORKER_T;
+
+static pthread_barrier_t round_barrier;
+static volatile STL_SIGNATURE_T corrupt[CPUS];
+static volatile int glitch[CPUS];
+
+static __thread STL_CPUS self;
+static __thread unsigned twice_calls;
+
+static STL_SIGNATURE_T sbst_pair(void)
+{
+    return SIGNATURE ^ corrupt[self];
+}
+
+static STL_SIGNATURE_T sbst_twice(void)
+{
+    twice_calls++;
+    if (glitch[self] != 0 && (twice_calls % 2u) == 0u)
+    {
+        glitch[self] = 0;
+        return SIGNATURE ^ 0x100;
+    }
+    return SIGNATURE;
+}
+
+static STL_SIGNATURE_T sbst_plain(void)
+{
+    return SIGNATURE;
+}
+
+static void *worker(void *arg)
+{
+    WORKER_T *w = (WORKER_T *)arg;
+    STL_ERROR_T err;
+    unsigned r;
+
+    self = w->cpu;
+    twice_calls = 0;
+    for (r = 0; r < w->rounds; r++)
+    {
+        STL_schedule_runtime(w->cpu, &err);
+        if (err != STL_ERROR_NONE)
+        {
+            w->failures++;
+        }
+        pthread_barrier_wait(&round_barrier);
+    }
+    return NULL;
+}
+
+/* Runs rounds on all the CPUs, returns the scheduling errors */
+static unsigned run(unsigned rounds)
+{
+    pthread_t threads[CPUS];
+    WORKER_T workers[CPUS];
+    unsigned failures = 0;
+    unsigned i;
+
+    for (i = 0; i < CPUS; i++)
+    {
+        workers[i].cpu = (STL_CPUS)i;
+        workers[i].rounds = rounds;
+        workers[i].failures = 0;
+        pthread_create(&threads[i], NULL, worker, &workers[i]);
+    }
+    for (i = 0; i < CPUS; i++)
+    {
+        pthread_join(threads[i], NULL);
+        failures += workers[i].failures;
+    }
+    return failures;
+}
+
+/* Runs one round of a CPU from the calling thread */
+static void run_on(STL_CPUS cpu)
+{
+    STL_ERROR_T err;
+
+    self = cpu;
+    STL_schedule_runtime(cpu, &err);
+}
+
+static int expect(STL_CPUS cpu, STL_SIZE_T index, STL_VERDICT_T verdict, STL_VERDICT_T golden, const char *what)
+{
+    STL_ERROR_T err;
+
+    if (STL_redundancy_get_verdict(cpu, index, &err) != verdict || STL_em_rt_get_verdict(cpu, index, &err) != golden)
+    {
+        printf("FAIL: %s (CPU %u test %u: divergence %d, golden %d)\n", what, (unsigned)cpu, (unsigned)index,
+               (int)STL_redundancy_get_verdict(cpu, index, &err), (int)STL_em_rt_get_verdict(cpu, index, &err));
+        return 1;
+    }
+    return 0;
+}
+
+static int check_no_fault(void)
+{
+    STL_REDUNDANCY_STATS_T stats;
+    STL_ERROR_T err;
+    STL_CYCLES_T cycles = 0, max = 0;
+    unsigned published = 0, compared = 0;
+    unsigned i;
+    int result = 0;
+
+    STL_redundancy_init(&err);
+    if (run(ROUNDS) != 0u)
+    {
+        printf("FAIL: scheduling errors\n");
+        result++;
+    }
+    for (i = 0; i < CPUS; i++)
+    {
+        result += expect((STL_CPUS)i, PAIR_TEST, STL_VERDICT_PASS, STL_VERDICT_PASS, "pair without fault");
+        result += expect((STL_CPUS)i, TWICE_TEST, STL_VERDICT_PASS, STL_VERDICT_PASS, "twice without fault");
+        result += expect((STL_CPUS)i, PLAIN_TEST, STL_VERDICT_NOT_RUN, STL_VERDICT_PASS, "test not flagged");
+        STL_redundancy_get_stats((STL_CPUS)i, &stats, &err);
+        if (stats.published != ROUNDS || stats.repeated != ROUNDS || stats.diverged != 0u || stats.lost != 0u ||
+            stats.resynced != 0u)
+        {
+            printf("FAIL: CPU %u published %u, repeated %u, diverged %u, lost %u, resynced %u\n", i,
+                   (unsigned)stats.published, (unsigned)stats.repeated, (unsigned)stats.diverged,
+                   (unsigned)stats.lost, (unsigned)stats.resynced);
+            result++;
+        }
+        published += stats.published;
+        compared += stats.compared - stats.repeated;
+        cycles += stats.exchange_cycles;
+        max = stats.exchange_max > max ? stats.exchange_max : max;
+    }
+    /* Each run of a pair is compared at least once, twice when the partners publish together */
+    if (compared < published / 2u)
+    {
+        printf("FAIL: %u pair comparisons for %u runs\n", compared, published / 2u);
+        result++;
+    }
+    printf("pair exchange, partners on different threads: %6.1f cycles mean, %llu max, %u comparisons for %u runs\n",
+           (double)cycles / published, (unsigned long long)max, compared, published / 2u);
+
+    /* Both CPUs of a pair scheduled in turn by this thread: no line moves while it runs */
+    STL_redundancy_init(&err);
+    for (i = 0; i < ROUNDS; i++)
+    {
+        run_on(0u);
+        run_on(1u);
+    }
+    cycles = 0;
+    published = 0;
+    for (i = 0; i < 2u; i++)
+    {
+        STL_redundancy_get_stats((STL_CPUS)i, &stats, &err);
+        cycles += stats.exchange_cycles;
+        published += stats.published;
+    }
+    printf("pair exchange, partners on the same thread:   %6.1f cycles mean; second execution after %u cycles\n",
+           (double)cycles / published, (unsigned)STL_REDUNDANCY_DIVERSITY_CYCLES);
+    return result;
+}
+
+static int check_divergence(void)
+{
+    STL_ERROR_T err;
+    int result = 0;
+
+    STL_redundancy_init(&err);
+    corrupt[3] = 0x10;
+    run(1u);
+    corrupt[3] = 0;
+    result += expect(2u, PAIR_TEST, STL_VERDICT_FAIL, STL_VERDICT_PASS, "divergent partner");
+    result += expect(3u, PAIR_TEST, STL_VERDICT_FAIL, STL_VERDICT_PASS, "divergent CPU");
+    result += expect(0u, PAIR_TEST, STL_VERDICT_PASS, STL_VERDICT_PASS, "other pair");
+    run(1u);
+    result += expect(3u, PAIR_TEST, STL_VERDICT_PASS, STL_VERDICT_PASS, "pair after the fault");
+
+    glitch[0] = 1;
+    run(1u);
+    result += expect(0u, TWICE_TEST, STL_VERDICT_FAIL, STL_VERDICT_PASS, "transient in the second execution");
+    result += expect(1u, TWICE_TEST, STL_VERDICT_PASS, STL_VERDICT_PASS, "twice on the partner");
+    run(1u);
+    result += expect(0u, TWICE_TEST, STL_VERDICT_PASS, STL_VERDICT_PASS, "twice after the transient");
+    return result;
+}
+
+static int check_lag(void)
+{
+    STL_REDUNDANCY_STATS_T stats;
+    STL_ERROR_T err;
+    int result = 0;
+
+    STL_redundancy_init(&err);
+    run(1u);
+    /* CPU 0 runs three times alone: ahead by 2, then by 3 */
+    run_on(0u);
+    run_on(0u);
+    run_on(0u);
+    STL_redundancy_get_stats(0u, &stats, &err);
+    result += expect(1u, PAIR_TEST, STL_VERDICT_TIMEOUT, STL_VERDICT_PASS, "partner lagging");
+    if (stats.lost != 2u)
+    {
+        printf("FAIL: %u runs lost instead of 2\n", (unsigned)stats.lost);
+        result++;
+    }
+    /* CPU 1 compares with the latest run of CPU 0 and catches up */
+    run_on(1u);
+    STL_redundancy_get_stats(1u, &stats, &err);
+    result += expect(0u, PAIR_TEST, STL_VERDICT_PASS, STL_VERDICT_PASS, "lagging CPU back");
+    if (stats.resynced != 1u)
+    {
+        printf("FAIL: lagging CPU not resynchronized\n");
+        result++;
+    }
+    run_on(0u);
+    run_on(1u);
+    STL_redundancy_get_stats(0u, &stats, &err);
+    result += expect(0u, PAIR_TEST, STL_VERDICT_PASS, STL_VERDICT_PASS, "pair after the catch-up");
+    if (stats.lost != 2u)
+    {
+        printf("FAIL: run lost after the catch-up\n");
+        result++;
+    }
+    return result;
+}
+
+static int check_bounds(void)
+{
+    STL_REDUNDANCY_STATS_T stats;
+    STL_ERROR_T err;
+    int result = 0;
+
+    STL_redundancy_get_verdict(CPUS, PAIR_TEST, &err);
+    if (err != STL_CPU_OUT_OF_BOUNDS)
+    {
+        printf("FAIL: verdict of an invalid CPU\n");
+        result++;
+    }
+    STL_redundancy_get_verdict(0u, STL_TOT_RT_ROUTINE, &err);
+    if (err != STL_INDEX_OUT_OF_BOUNDS)
+    {
+        printf("FAIL: verdict of an invalid test\n");
+        result++;
+    }
+    STL_redundancy_get_stats(CPUS, &stats, &err);
+    if (err != STL_CPU_OUT_OF_BOUNDS)
+    {
+        printf("FAIL: statistics of an invalid CPU\n");
+        result++;
+    }
+    return result;
+}
+
+int main(void)
+{
+    STL_ERROR_T err;
+    unsigned i;
+    int failures = 0;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+    pthread_barrier_init(&round_barrier, NULL, CPUS);
+    for (i = 0; i < CPUS; i++)
+    {
+        SBST_RT[i * STL_TOT_RT_ROUTINE + PAIR_TEST] = sbst_pair;
+        SBST_RT[i * STL_TOT_RT_ROUTINE + TWICE_TEST] = sbst_twice;
+        SBST_RT[i * STL_TOT_RT_ROUTINE + PLAIN_TEST] = sbst_plain;
+    }
+
+    failures += check_no_fault();
+    failures += check_divergence();
+    failures += check_lag();
+    failures += check_bounds();
+
+    pthread_barrier_destroy(&round_barrier);
+    STL_deinit(&err);
+    return failures;
+}
@@ -0,0 +1,264 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "stl.h"
+#include "stl_crc.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * Relocation engine on the host.
+ * - the CRC-32C matches the reference value;
+ * - the fused copy + CRC matches memcpy and the byte-wise CRC for all sizes and alignments;
+ * - STL_relocate_runtime_tests copies the image and detects a corrupted image;
+ * - the throughput is compared with memcpy followed by a separate CRC pass;
+ * - the asynchronous relocation (DMA stand-in) overlaps with CPU work standing in for the
+ *   boot-time tests, and the achieved overlap is reported (it depends on the number of
+ *   host CPUs available to the DMA helper thread).
+ *
+ * The image stands in for the linker symbols; its build-time CRC-32C is passed through
+ * STL_RELOCATION_CODE_CRC (tests/meson.build) and matches image_fill below.
+ */
+
+#define IMAGE_SIZE (1u << 20)
+#define BENCH_SIZE (1u << 20)
+#define BENCH_LOOPS 200
+
+__attribute__((aligned(64))) uint8_t __stl_rom_start__[IMAGE_SIZE];
+__attribute__((aligned(64))) uint8_t __stl_ram_code_start__[IMAGE_SIZE];
+/* __stl_ram_data_end__ is defined at link time, at the end of __stl_ram_code_start__ */
+
+static void image_fill(uint8_t *image, STL_INT32U_T size)
+{
+    STL_INT32U_T s = 0x12345678u;
+    STL_INT32U_T i;
+
+    for (i = 0; i < size; i++)
+    {
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+        image[i] = (uint8_t)s;
+    }
+}
+
+static STL_INT32U_T crc_ref(const void *data, STL_INT32U_T size)
+{
+    return STL_CRC32C_FINAL(STL_crc32c_update(STL_CRC32C_INIT, data, size));
+}
+
+static int check_known_answer(void)
+{
+    static const char check[] = "123456789";
+    uint8_t dst[sizeof(check)];
+    STL_ERROR_T err;
+
+    if (crc_ref(check, 9) != 0xE3069283u || STL_TSSP_CPU_relocate(check, dst, 9, &err) != 0xE3069283u)
+    {
+        printf("FAIL: CRC-32C check value\n");
+        return 1;
+    }
+    return 0;
+}
+
+static int check_copy(void)
+{
+    static const STL_INT32U_T sizes[] = {0, 1, 3, 4, 15, 16, 17, 31, 32, 33, 63, 64, 1000, IMAGE_SIZE - 3};
+    static uint8_t dst[IMAGE_SIZE + 8];
+    STL_ERROR_T err;
+    unsigned s;
+    unsigned so;
+    unsigned d;
+    int failures = 0;
+
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        for (so = 0; so < 4; so++)
+        {
+            for (d = 0; d < 4; d++)
+            {
+                const uint8_t *src = __stl_rom_start__ + so;
+                STL_INT32U_T crc;
+
+                memset(dst, 0xA5, sizeof(dst));
+                crc = STL_TSSP_CPU_relocate(src, dst + d, sizes[s], &err);
+                if (err != STL_ERROR_NONE || crc != crc_ref(src, sizes[s]) || memcmp(dst + d, src, sizes[s]) != 0 ||
+                    dst[d + sizes[s]] != 0xA5)
+                {
+                    printf("FAIL: relocation of %u bytes (src +%u, dst +%u)\n", (unsigned)sizes[s], so, d);
+                    failures++;
+                }
+            }
+        }
+    }
+    return failures;
+}
+
+static int check_runtime_relocation(void)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+
+    memset(__stl_ram_code_start__, 0, IMAGE_SIZE);
+    STL_relocate_runtime_tests(&err);
+    if (err != STL_ERROR_NONE || memcmp(__stl_ram_code_start__, __stl_rom_start__, IMAGE_SIZE) != 0)
+    {
+        printf("FAIL: image not relocated (error %d)\n", (int)err);
+        failures++;
+    }
+
+    __stl_rom_start__[IMAGE_SIZE / 2] ^= 0x10u;
+    STL_relocate_runtime_tests(&err);
+    if (err != STL_ERROR_RELOCATION_CRC)
+    {
+        printf("FAIL: corrupted image not detected\n");
+        failures++;
+    }
+    __stl_rom_start__[IMAGE_SIZE / 2] ^= 0x10u;
+    return failures;
+}
+
+#if STL_USE_DMA
+/* CPU work standing in for the boot-time tests executed from flash */
+static STL_INT32U_T boot_tests(STL_CYCLES_T duration)
+{
+    static uint8_t flash[4096];
+    STL_CYCLES_T start = STL_TSSP_CPU_get_cycles();
+    STL_INT32U_T crc = STL_CRC32C_INIT;
+
+    while (STL_TSSP_CPU_get_cycles() - start < duration)
+    {
+        crc = STL_crc32c_update(crc, flash, sizeof(flash));
+    }
+    return crc;
+}
+
+static int check_async(void)
+{
+    STL_RELOCATION_STATS_T stats;
+    STL_CYCLES_T start;
+    STL_CYCLES_T sync_cycles;
+    STL_ERROR_T err;
+    int failures = 0;
+    int polls = 0;
+
+    /* Reference: blocking relocation */
+    start = STL_TSSP_CPU_get_cycles();
+    STL_relocate_runtime_tests(&err);
+    sync_cycles = STL_TSSP_CPU_get_cycles() - start;
+
+    /* Boot-time tests long enough to hide the whole transfer */
+    memset(__stl_ram_code_start__, 0, IMAGE_SIZE);
+    STL_relocate_runtime_tests_async(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        printf("FAIL: asynchronous relocation not started (error %d)\n", (int)err);
+        return 1;
+    }
+    (void)boot_tests(4u * sync_cycles);
+    STL_relocate_runtime_tests_wait(&err);
+    STL_relocate_get_stats(&stats, &err);
+    printf("async relocation of %u bytes: transfer %llu, wait %llu, verify %llu cycles, overlap %.1f%% "
+           "(blocking: %llu cycles)\n",
+           (unsigned)stats.bytes, (unsigned long long)stats.transfer_cycles, (unsigned long long)stats.wait_cycles,
+           (unsigned long long)stats.verify_cycles,
+           100.0 * (double)stats.overlap_cycles / (double)stats.transfer_cycles, (unsigned long long)sync_cycles);
+    if (err != STL_ERROR_NONE || memcmp(__stl_ram_code_start__, __stl_rom_start__, IMAGE_SIZE) != 0 ||
+        stats.bytes != IMAGE_SIZE)
+    {
+        printf("FAIL: asynchronous relocation\n");
+        failures++;
+    }
+
+    /* Polling completes the relocation as well */
+    STL_relocate_runtime_tests_async(&err);
+    while (STL_relocate_runtime_tests_poll(&err) == STL_FALSE)
+    {
+        polls++;
+    }
+    STL_relocate_get_stats(&stats, &err);
+    if (err != STL_ERROR_NONE || stats.wait_cycles != 0u)
+    {
+        printf("FAIL: polled relocation (%d polls)\n", polls);
+        failures++;
+    }
+
+    /* A corrupted image is detected on completion */
+    __stl_rom_start__[IMAGE_SIZE / 2] ^= 0x10u;
+    STL_relocate_runtime_tests_async(&err);
+    STL_relocate_runtime_tests_wait(&err);
+    if (err != STL_ERROR_RELOCATION_CRC)
+    {
+        printf("FAIL: corrupted image not detected by the asynchronous relocation\n");
+        failures++;
+    }
+    __stl_rom_start__[IMAGE_SIZE / 2] ^= 0x10u;
+    return failures;
+}
+#endif /* STL_USE_DMA */
+
+static void bench(void)
+{
+    uint8_t *src = aligned_alloc(64, BENCH_SIZE);
+    uint8_t *dst = aligned_alloc(64, BENCH_SIZE);
+    STL_CYCLES_T start;
+    STL_CYCLES_T fused;
+    STL_CYCLES_T separate;
+    volatile STL_INT32U_T sink = 0;
+    STL_ERROR_T err;
+    int i;
+
+    image_fill(src, BENCH_SIZE);
+    memset(dst, 0, BENCH_SIZE);
+
+    start = STL_TSSP_CPU_get_cycles();
+    for (i = 0; i < BENCH_LOOPS; i++)
+    {
+        sink ^= STL_TSSP_CPU_relocate(src, dst, BENCH_SIZE, &err);
+    }
+    fused = STL_TSSP_CPU_get_cycles() - start;
+
+    start = STL_TSSP_CPU_get_cycles();
+    for (i = 0; i < BENCH_LOOPS; i++)
+    {
+        memcpy(dst, src, BENCH_SIZE);
+        sink ^= crc_ref(dst, BENCH_SIZE);
+    }
+    separate = STL_TSSP_CPU_get_cycles() - start;
+
+    printf("fused copy + CRC:        %.3f cycles/byte\n", (double)fused / ((double)BENCH_SIZE * BENCH_LOOPS));
+    printf("memcpy + separate CRC:   %.3f cycles/byte\n", (double)separate / ((double)BENCH_SIZE * BENCH_LOOPS));
+    free(src);
+    free(dst);
+}
+
+int main(void)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+
+    image_fill(__stl_rom_start__, IMAGE_SIZE);
+    if (crc_ref(__stl_rom_start__, IMAGE_SIZE) != STL_RELOCATION_CODE_CRC)
+    {
+        printf("FAIL: STL_RELOCATION_CODE_CRC does not match the test image\n");
+        return 1;
+    }
+
+    failures += check_known_answer();
+    failures += check_copy();
+    failures += check_runtime_relocation();
+#if STL_USE_DMA
+    failures += check_async();
+#endif /* STL_USE_DMA */
+    bench();
+
+    STL_deinit(&err);
+    return failures;
+}
@@ -0,0 +1,148 @@
+#include <stdio.h>
+
+#include "stl.h"
+#include "stl_sbst_cfg.h"
+#include "stl_scrub.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * Integrity scrubber on the host (built with STL_TOT_RT_ROUTINE=2 and STL_SCRUB_BASELINE=1).
+ * - the scrubber is scheduled as runtime test 1, next to a regular test;
+ * - it covers the code of the test executable and a table of golden values, and a full
+ *   sweep takes ceil(bytes / STL_SCRUB_CHUNK_BYTES) steps without any mismatch;
+ * - a corrupted golden value fails the pseudo-test within one sweep;
+ * - the time to a full sweep and the cost per byte are reported.
+ */
+
+#define SCRUB_TEST 1u
+#define SWEEPS 20u
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
+
+/* Executable bounds provided by the GNU linker */
+extern const uint8_t __executable_start[];
+extern const uint8_t etext[];
+
+static STL_SIGNATURE_T golden[1024];
+
+static STL_SCRUB_REGION_T regions[2];
+
+static STL_SIGNATURE_T sbst_nop(void)
+{
+    return 0x5a5a5a5a;
+}
+
+/* Runs the schedule until the scrubber completes the given number of sweeps */
+static int run_sweeps(STL_INT32U_T sweeps, STL_VERDICT_T *worst)
+{
+    STL_SCRUB_STATS_T stats;
+    STL_ERROR_T err;
+    unsigned guard = 0;
+
+    *worst = STL_VERDICT_PASS;
+    do
+    {
+        STL_schedule_runtime(0, &err);
+        if (err != STL_ERROR_NONE)
+        {
+            return -1;
+        }
+        if (STL_em_rt_get_verdict(0, SCRUB_TEST, &err) != STL_VERDICT_PASS)
+        {
+            *worst = STL_VERDICT_FAIL;
+        }
+        STL_scrub_get_stats(&stats, &err);
+    } while (stats.sweeps < sweeps && ++guard < 1000000u);
+    return 0;
+}
+
+static int check_sweep(void)
+{
+    STL_SCRUB_STATS_T stats;
+    STL_VERDICT_T verdict;
+    STL_ERROR_T err;
+    STL_INT32U_T steps;
+
+    if (run_sweeps(SWEEPS, &verdict) != 0 || verdict != STL_VERDICT_PASS)
+    {
+        printf("FAIL: clean image reported as corrupted\n");
+        return 1;
+    }
+
+    STL_scrub_get_stats(&stats, &err);
+    steps = (stats.sweep_bytes + STL_SCRUB_CHUNK_BYTES - 1u) / STL_SCRUB_CHUNK_BYTES;
+    printf("sweep of %u bytes: %u steps of %u bytes, %llu busy cycles (%.3f cycles/byte), "
+           "time to full sweep %llu cycles, worst step %llu cycles\n",
+           (unsigned)stats.sweep_bytes, (unsigned)stats.sweep_steps, (unsigned)STL_SCRUB_CHUNK_BYTES,
+           (unsigned long long)stats.sweep_busy_cycles, (double)stats.sweep_busy_cycles / stats.sweep_bytes,
+           (unsigned long long)stats.sweep_time_cycles, (unsigned long long)stats.max_step_cycles);
+    /* Region boundaries may take one extra step */
+    if (stats.sweeps != SWEEPS || stats.mismatches != 0u || stats.sweep_steps < steps ||
+        stats.sweep_steps > steps + 1u)
+    {
+        printf("FAIL: unexpected sweep (%u sweeps, %u steps, expected %u)\n", (unsigned)stats.sweeps,
+               (unsigned)stats.sweep_steps, (unsigned)steps);
+        return 1;
+    }
+    return 0;
+}
+
+static int check_corruption(void)
+{
+    STL_SCRUB_STATS_T stats;
+    STL_VERDICT_T verdict;
+    STL_ERROR_T err;
+
+    golden[512] ^= 0x100u;
+    STL_scrub_get_stats(&stats, &err);
+    if (run_sweeps(stats.sweeps + 1u, &verdict) != 0 || verdict != STL_VERDICT_FAIL)
+    {
+        printf("FAIL: corrupted golden value not detected within one sweep\n");
+        return 1;
+    }
+    STL_scrub_get_stats(&stats, &err);
+    if (stats.mismatches != 1u || stats.last_failed_region != 1u)
+    {
+        printf("FAIL: corruption reported in region %u (%u mismatches)\n", (unsigned)stats.last_failed_region,
+               (unsigned)stats.mismatches);
+        return 1;
+    }
+    golden[512] ^= 0x100u;
+    return 0;
+}
+
+int main(void)
+{
+    STL_ERROR_T err;
+    unsigned i;
+    int failures = 0;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+
+    for (i = 0; i < sizeof(golden) / sizeof(golden[0]); i++)
+    {
+        golden[i] = 0x9E3779B9u * (i + 1u);
+    }
+    regions[0].start = __executable_start;
+    regions[0].size = (STL_INT32U_T)(etext - __executable_start);
+    regions[1].start = golden;
+    regions[1].size = sizeof(golden);
+    STL_scrub_init(regions, 2u, &err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+    SBST_RT[0] = sbst_nop;
+    SBST_RT[SCRUB_TEST] = STL_scrub_test;
+
+    failures += check_sweep();
+    failures += check_corruption();
+
+    STL_deinit(&err);
+    return failures;
+}
@@ -0,0 +1,159 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdio.h>
+
+#include "stl.h"
+#include "stl_sbst_cfg.h"
+#include "stl_sw_watchdog.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * Software deadline monitor on the host (built with STL_USE_SW_WATCHDOG, STL_TOT_RT_ROUTINE=2
+ * and a budget of BUDGET cycles per test). Runtime test 0 never returns while it is told to
+ * hang, runtime test 1 checks its own deadline and returns.
+ * - a hanging test is aborted: timeout verdict, one timeout counted, bounded detection latency;
+ * - the scheduler goes on with the next test of the same round, which passes;
+ * - the next round runs the formerly hanging test normally and counts no other timeout;
+ * - a test checking the deadline before it expires is not aborted.
+ * The STL runs on a thread of its own while the main thread and a spinning thread leave
+ * SIGALRM unblocked: the tick must reach the thread running the tests and no other.
+ */
+
+#define SIGNATURE 0x600d
+#define HANG_TEST 0u
+#define PLAIN_TEST 1u
+#define BUDGET 2000000u /* STL_RT_ROUTINE_BUDGET of both tests */
+#define ROUNDS 10u
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
+
+static volatile int hang;
+static volatile int spinning = 1;
+static unsigned plain_runs;
+
+static STL_SIGNATURE_T sbst_hang(void)
+{
+    while (hang != 0)
+    {
+    }
+    return SIGNATURE;
+}
+
+static STL_SIGNATURE_T sbst_plain(void)
+{
+    plain_runs++;
+    STL_sw_wdg_check(0u);
+    return SIGNATURE;
+}
+
+/* Another thread of the process, as the CSP helper threads, with SIGALRM unblocked */
+static void *spinner(void *arg)
+{
+    (void)arg;
+    while (spinning != 0)
+    {
+    }
+    return NULL;
+}
+
+static int expect(STL_SIZE_T index, STL_VERDICT_T verdict, const char *what)
+{
+    STL_ERROR_T err;
+    STL_VERDICT_T got = STL_em_rt_get_verdict(0u, index, &err);
+
+    if (err != STL_ERROR_NONE || got != verdict)
+    {
+        printf("FAIL: %s (test %u: verdict %d instead of %d)\n", what, (unsigned)index, (int)got, (int)verdict);
+        return 1;
+    }
+    return 0;
+}
+
+static int check_timeout(void)
+{
+    STL_SW_WDG_STATS_T stats;
+    STL_ERROR_T err;
+    int result = 0;
+
+    hang = 1;
+    STL_schedule_runtime(0u, &err);
+    hang = 0;
+    result += expect(HANG_TEST, STL_VERDICT_TIMEOUT, "hanging test not aborted");
+    result += expect(PLAIN_TEST, STL_VERDICT_PASS, "test after the aborted one");
+    if (plain_runs != 1u)
+    {
+        printf("FAIL: the round did not go on after the timeout\n");
+        result++;
+    }
+    STL_sw_wdg_get_stats(0u, &stats, &err);
+    if (err != STL_ERROR_NONE || stats.timeouts != 1u)
+    {
+        printf("FAIL: %u timeouts counted instead of 1\n", (unsigned)stats.timeouts);
+        result++;
+    }
+    printf("timeout detected %llu cycles after the deadline (tick %u us, budget %u cycles)\n",
+           (unsigned long long)stats.last_latency, (unsigned)STL_SW_WATCHDOG_TICK_US, BUDGET);
+    return result;
+}
+
+static int check_recovery(void)
+{
+    STL_SW_WDG_STATS_T stats;
+    STL_ERROR_T err;
+    unsigned r;
+    int result = 0;
+
+    for (r = 0; r < ROUNDS; r++)
+    {
+        STL_schedule_runtime(0u, &err);
+        if (err != STL_ERROR_NONE)
+        {
+            printf("FAIL: scheduling error %d after a timeout\n", (int)err);
+            result++;
+        }
+    }
+    result += expect(HANG_TEST, STL_VERDICT_PASS, "test no longer hanging");
+    result += expect(PLAIN_TEST, STL_VERDICT_PASS, "test checking its deadline");
+    STL_sw_wdg_get_stats(0u, &stats, &err);
+    if (stats.timeouts != 1u || plain_runs != 1u + ROUNDS)
+    {
+        printf("FAIL: %u timeouts and %u runs after the recovery\n", (unsigned)stats.timeouts, plain_runs);
+        result++;
+    }
+    return result;
+}
+
+static void *run_stl(void *arg)
+{
+    int *failures = (int *)arg;
+    STL_ERROR_T err;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        *failures = -1;
+        return NULL;
+    }
+    SBST_RT[HANG_TEST] = sbst_hang;
+    SBST_RT[PLAIN_TEST] = sbst_plain;
+
+    *failures += check_timeout();
+    *failures += check_recovery();
+
+    STL_deinit(&err);
+    return NULL;
+}
+
+int main(void)
+{
+    pthread_t stl_thread, spin_thread;
+    int failures = 0;
+
+    pthread_create(&spin_thread, NULL, spinner, NULL);
+    pthread_create(&stl_thread, NULL, run_stl, &failures);
+    pthread_join(stl_thread, NULL);
+    spinning = 0;
+    pthread_join(spin_thread, NULL);
+    return failures;
+}
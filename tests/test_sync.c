@@ -0,0 +1,370 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "stl.h"
+#include "stl_context.h"
+#include "stl_sbst_cfg.h"
+#include "stl_sync.h"
+#include "stl_throttle.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * Synchronized test windows on the host (built with STL_MULTICORE_SOC, STL_NUM_CPU=4,
+ * STL_TOT_RT_ROUTINE=3, runtime test 1 flagged in STL_RT_ROUTINE_SYNC_WINDOW and, for the
+ * throttle, touching WINDOW_BYTES bytes). Each CPU is a thread scheduling its own runtime tests:
+ * - test 0 marks the CPU as having started the round;
+ * - test 1 (windowed) checks that every participant has started the round, then marks the CPU
+ *   as having finished its part;
+ * - test 2 checks that every participant has finished its part of the round.
+ * Without the entry barrier test 1 sees CPUs that have not started the round, without the exit
+ * barrier test 2 sees CPUs that have not finished test 1.
+ * - with 1, 2 and 4 participants every test passes on every CPU in every round;
+ * - a CPU alone at the entry times out and records a timeout, the window is left clean: the
+ *   CPUs meeting afterward pass again;
+ * - a CPU stalled in the window times the others out at the exit, the verdicts are kept;
+ * - a CPU deferring the windowed test (throttled) leaves the window at once: the others run the
+ *   test without a timeout;
+ * - an invalid configuration is rejected, as a context other than the default one: the windows
+ *   are not part of a context.
+ * The entry wait, the wake-up latency and the time of a window are reported for each number
+ * of participants. On a host with fewer cores than participants the threads share the cores:
+ * the waits are then in the order of a scheduler time slice.
+ */
+
+#define CPUS 4u
+#define ROUNDS 50u
+#define BEFORE_TEST 0u
+#define WINDOW_TEST 1u
+#define AFTER_TEST 2u
+#define SIGNATURE 0x5EC0u
+#define TIMEOUT_CYCLES 100000000ull  /* Short timeout of the timeout checks */
+#define WINDOW_BYTES 1024u            /* STL_RT_ROUTINE_MEM_BYTES of the windowed test */
+#define THROTTLE_WINDOW 0xFFFFFFFFull /* Longest window of the throttle, no refill in a round */
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[CPUS * STL_TOT_RT_ROUTINE];
+
+typedef struct
+{
+    STL_CPUS cpu;
+    unsigned first;
+    unsigned rounds;
+    unsigned failures;
+} WORKER_T;
+
+static unsigned participants;
+static unsigned started[CPUS];
+static unsigned finished[CPUS];
+static volatile int stall_cpu = -1;
+
+static __thread STL_CPUS self;
+static __thread unsigned round_number;
+
+static double now_ns(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec * 1e9 + (double)t.tv_nsec;
+}
+
+static STL_SIGNATURE_T sbst_before(void)
+{
+    __atomic_store_n(&started[self], round_number, __ATOMIC_RELEASE);
+    return SIGNATURE;
+}
+
+static STL_SIGNATURE_T sbst_window(void)
+{
+    STL_SIGNATURE_T signature = SIGNATURE;
+    STL_CYCLES_T start;
+    unsigned q;
+
+    for (q = 0; q < participants; q++)
+    {
+        if (__atomic_load_n(&started[q], __ATOMIC_ACQUIRE) != round_number)
+        {
+            signature = STL_SIGNATURE_MISMATCH;
+        }
+    }
+    __atomic_store_n(&finished[self], round_number, __ATOMIC_RELEASE);
+    if (stall_cpu == (int)self)
+    {
+        start = STL_TSSP_CPU_get_cycles();
+        while (STL_TSSP_CPU_get_cycles() - start < 3u * TIMEOUT_CYCLES)
+        {
+        }
+    }
+    return signature;
+}
+
+static STL_SIGNATURE_T sbst_after(void)
+{
+    unsigned q;
+
+    for (q = 0; q < participants; q++)
+    {
+        if (__atomic_load_n(&finished[q], __ATOMIC_ACQUIRE) != round_number)
+        {
+            return STL_SIGNATURE_MISMATCH;
+        }
+    }
+    return SIGNATURE;
+}
+
+static void *worker(void *arg)
+{
+    WORKER_T *w = (WORKER_T *)arg;
+    STL_ERROR_T err;
+    STL_SIZE_T i;
+    unsigned r;
+
+    self = w->cpu;
+    for (r = 0; r < w->rounds; r++)
+    {
+        round_number = w->first + r;
+        STL_schedule_runtime(w->cpu, &err);
+        for (i = 0; i < STL_TOT_RT_ROUTINE; i++)
+        {
+            if (err != STL_ERROR_NONE || STL_em_rt_get_verdict(w->cpu, i, &err) != STL_VERDICT_PASS)
+            {
+                w->failures++;
+            }
+        }
+    }
+    return NULL;
+}
+
+/* Runs rounds first.. on CPUs 0..n-1, returns the failed tests */
+static unsigned run(unsigned n, unsigned first, unsigned rounds)
+{
+    pthread_t threads[CPUS];
+    WORKER_T workers[CPUS];
+    unsigned failures = 0;
+    unsigned i;
+
+    for (i = 0; i < n; i++)
+    {
+        workers[i].cpu = (STL_CPUS)i;
+        workers[i].first = first;
+        workers[i].rounds = rounds;
+        workers[i].failures = 0;
+        pthread_create(&threads[i], NULL, worker, &workers[i]);
+    }
+    for (i = 0; i < n; i++)
+    {
+        pthread_join(threads[i], NULL);
+        failures += workers[i].failures;
+    }
+    return failures;
+}
+
+/* Runs one round on a single CPU, as if the others never came */
+static void run_alone(STL_CPUS cpu, unsigned round)
+{
+    STL_ERROR_T err;
+
+    self = cpu;
+    round_number = round;
+    STL_schedule_runtime(cpu, &err);
+}
+
+static int check_participants(unsigned n)
+{
+    STL_SYNC_STATS_T stats;
+    STL_ERROR_T err;
+    STL_CYCLES_T wait_max = 0, wake_max = 0, wait_total = 0, leave_max = 0;
+    double start, elapsed;
+    unsigned failures, i;
+    int result = 0;
+
+    STL_sync_init(&err);
+    STL_sync_configure(n, STL_SYNC_TIMEOUT_CYCLES, &err);
+    participants = n;
+    start = now_ns();
+    failures = run(n, 100u * n, ROUNDS);
+    elapsed = now_ns() - start;
+    if (failures != 0u)
+    {
+        printf("FAIL: %u participants, %u failed tests\n", n, failures);
+        result++;
+    }
+    for (i = 0; i < n; i++)
+    {
+        STL_sync_get_stats((STL_CPUS)i, &stats, &err);
+        if (stats.windows != ROUNDS || stats.timeouts != 0u || stats.leave_timeouts != 0u)
+        {
+            printf("FAIL: %u participants, CPU %u entered %u windows, %u timeouts, %u at the exit\n", n, i,
+                   (unsigned)stats.windows, (unsigned)stats.timeouts, (unsigned)stats.leave_timeouts);
+            result++;
+        }
+        wait_total += stats.wait_total;
+        wait_max = stats.wait_max > wait_max ? stats.wait_max : wait_max;
+        wake_max = stats.wake_max > wake_max ? stats.wake_max : wake_max;
+        leave_max = stats.leave_wait_max > leave_max ? stats.leave_wait_max : leave_max;
+    }
+    printf("%u participant(s): %8.1f us/round, entry wait %10.0f cycles mean %10llu max, wake-up %8llu cycles max, "
+           "exit wait %10llu cycles max\n",
+           n, elapsed / ROUNDS / 1e3, (double)wait_total / (n * ROUNDS), (unsigned long long)wait_max,
+           (unsigned long long)wake_max, (unsigned long long)leave_max);
+    return result;
+}
+
+static int check_timeout(void)
+{
+    STL_SYNC_STATS_T stats;
+    STL_ERROR_T err;
+    int result = 0;
+
+    STL_sync_init(&err);
+    STL_sync_configure(2u, TIMEOUT_CYCLES, &err);
+    participants = 2u;
+
+    /* CPU 0 alone, then CPU 1 alone: neither runs the windowed test */
+    run_alone(0u, 1000u);
+    run_alone(1u, 1001u);
+    if (STL_em_rt_get_verdict(0u, WINDOW_TEST, &err) != STL_VERDICT_TIMEOUT ||
+        STL_em_rt_get_verdict(1u, WINDOW_TEST, &err) != STL_VERDICT_TIMEOUT)
+    {
+        printf("FAIL: missing participant not detected\n");
+        result++;
+    }
+    STL_sync_get_stats(0u, &stats, &err);
+    if (stats.timeouts != 1u || stats.windows != 0u || stats.wait_last < TIMEOUT_CYCLES)
+    {
+        printf("FAIL: timeout at the entry not counted\n");
+        result++;
+    }
+
+    /* The window is left clean: the CPUs meeting afterward pass */
+    if (run(2u, 1002u, 10u) != 0u)
+    {
+        printf("FAIL: windows after a timeout at the entry\n");
+        result++;
+    }
+
+    /* CPU 1 stalls in the window: both leave alone, the windowed test has run and passed */
+    stall_cpu = 1;
+    run(2u, 1012u, 1u);
+    stall_cpu = -1;
+    if (STL_em_rt_get_verdict(0u, WINDOW_TEST, &err) != STL_VERDICT_PASS ||
+        STL_em_rt_get_verdict(1u, WINDOW_TEST, &err) != STL_VERDICT_PASS)
+    {
+        printf("FAIL: verdict lost after a timeout at the exit\n");
+        result++;
+    }
+    STL_sync_get_stats(0u, &stats, &err);
+    if (stats.leave_timeouts != 1u)
+    {
+        printf("FAIL: timeout at the exit not counted\n");
+        result++;
+    }
+    if (run(2u, 1013u, 10u) != 0u)
+    {
+        printf("FAIL: windows after a timeout at the exit\n");
+        result++;
+    }
+    return result;
+}
+
+static int check_deferred(void)
+{
+    STL_SYNC_STATS_T stats;
+    STL_ERROR_T err;
+    int result = 0;
+
+    STL_sync_init(&err);
+    STL_sync_configure(2u, TIMEOUT_CYCLES, &err);
+    participants = 2u;
+
+    /* The bucket of CPU 1 holds the bytes of a single windowed test: the second one is deferred */
+    STL_throttle_configure(1u, WINDOW_BYTES, THROTTLE_WINDOW, &err);
+    run(2u, 2000u, 2u);
+    STL_throttle_configure(1u, 0u, THROTTLE_WINDOW, &err);
+    STL_sync_get_stats(0u, &stats, &err);
+    if (STL_em_rt_get_verdict(0u, WINDOW_TEST, &err) != STL_VERDICT_PASS || stats.timeouts != 0u ||
+        stats.leave_timeouts != 0u)
+    {
+        printf("FAIL: CPU 0 timed out by a CPU deferring the windowed test\n");
+        result++;
+    }
+    if (run(2u, 2001u, 10u) != 0u)
+    {
+        printf("FAIL: windows after a deferred test\n");
+        result++;
+    }
+    return result;
+}
+
+static int check_configure(void)
+{
+    static STL_CONTEXT_T ctx;
+    STL_SYNC_STATS_T stats;
+    STL_ERROR_T err;
+    int result = 0;
+
+    STL_sync_configure(0u, TIMEOUT_CYCLES, &err);
+    if (err != STL_CPU_OUT_OF_BOUNDS)
+    {
+        printf("FAIL: no participant accepted\n");
+        result++;
+    }
+    STL_sync_configure(CPUS + 1u, TIMEOUT_CYCLES, &err);
+    if (err != STL_CPU_OUT_OF_BOUNDS)
+    {
+        printf("FAIL: too many participants accepted\n");
+        result++;
+    }
+    STL_sync_configure(2u, 0u, &err);
+    if (err != STL_INDEX_OUT_OF_BOUNDS)
+    {
+        printf("FAIL: null timeout accepted\n");
+        result++;
+    }
+    STL_sync_get_stats(CPUS, &stats, &err);
+    if (err != STL_CPU_OUT_OF_BOUNDS)
+    {
+        printf("FAIL: statistics of an invalid CPU\n");
+        result++;
+    }
+    STL_context_init(&ctx, NULL, &err);
+    if (err != STL_ERROR_CONTEXT)
+    {
+        printf("FAIL: context sharing the windows accepted\n");
+        result++;
+    }
+    return result;
+}
+
+int main(void)
+{
+    static const unsigned counts[] = {1u, 2u, 4u};
+    STL_ERROR_T err;
+    unsigned i;
+    int failures = 0;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+    for (i = 0; i < CPUS; i++)
+    {
+        SBST_RT[i * STL_TOT_RT_ROUTINE + BEFORE_TEST] = sbst_before;
+        SBST_RT[i * STL_TOT_RT_ROUTINE + WINDOW_TEST] = sbst_window;
+        SBST_RT[i * STL_TOT_RT_ROUTINE + AFTER_TEST] = sbst_after;
+    }
+
+    for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+    {
+        failures += check_participants(counts[i]);
+    }
+    failures += check_timeout();
+    failures += check_deferred();
+    failures += check_configure();
+
+    STL_deinit(&err);
+    return failures;
+}
@@ -0,0 +1,252 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "stl.h"
+#include "stl_march.h"
+#include "stl_sbst_cfg.h"
+#include "stl_throttle.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * Memory bandwidth throttle on the host (built with STL_USE_THROTTLE, STL_USE_MARCH,
+ * STL_MARCH_CHUNK_BYTES=65536 and STL_RT_ROUTINE_MEM_BYTES={65536}).
+ * - the March test is scheduled as runtime test 0, each step taking 64 KiB from the bucket;
+ * - the bytes granted never exceed the rate times the elapsed time plus the burst;
+ * - deferred steps keep the previous verdict of the test;
+ * - invalid CPU and window are rejected;
+ * - benchmark: a pointer-chasing probe thread runs next to a thread scheduling the STL, the
+ *   p50/p99 latency of the probe is reported against the STL throughput for several rates.
+ *   The latencies are only reported: on a single-core host the threads share the core.
+ */
+
+#define MARCH_TEST 0u
+#define STEP_BYTES 65536u
+#define BUFFER_BYTES (1024u * 1024u)
+#define WINDOW_CYCLES 1000000u
+#define CHECK_LOOPS 200000u
+#define PROBE_BYTES (16u * 1024u * 1024u)
+#define PROBE_BATCH 64u
+#define PROBE_SAMPLES 200000u
+#define BENCH_NS 200000000LL
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
+
+static STL_MARCH_REGION_T regions[1];
+static volatile int stop;
+static volatile size_t sink;
+
+static long long now_ns(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (long long)t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+static int check_rate(void)
+{
+    STL_THROTTLE_STATS_T stats;
+    STL_CYCLES_T start, elapsed;
+    STL_ERROR_T err;
+    unsigned i;
+    int failures = 0;
+
+    STL_throttle_init(&err);
+    STL_throttle_configure(0, STEP_BYTES, WINDOW_CYCLES, &err);
+    start = STL_TSSP_CPU_get_cycles();
+    for (i = 0; i < CHECK_LOOPS; i++)
+    {
+        STL_schedule_runtime(0, &err);
+        /* Deferred or not, the verdict of the March test stays a pass */
+        if (err != STL_ERROR_NONE || STL_em_rt_get_verdict(0, MARCH_TEST, &err) != STL_VERDICT_PASS)
+        {
+            printf("FAIL: verdict lost at loop %u\n", i);
+            return 1;
+        }
+    }
+    elapsed = STL_TSSP_CPU_get_cycles() - start;
+    STL_throttle_get_stats(0, &stats, &err);
+
+    printf("rate %u bytes / %u cycles: %u granted, %u deferred, %llu bytes in %llu cycles (limit %llu)\n",
+           (unsigned)STEP_BYTES, (unsigned)WINDOW_CYCLES, (unsigned)stats.granted, (unsigned)stats.deferred,
+           (unsigned long long)stats.granted_bytes, (unsigned long long)elapsed,
+           (unsigned long long)(elapsed / WINDOW_CYCLES * STEP_BYTES + 2u * STEP_BYTES));
+    /* One burst at the start, plus one window started before the last refill */
+    if (stats.granted_bytes > elapsed / WINDOW_CYCLES * STEP_BYTES + 2u * STEP_BYTES)
+    {
+        printf("FAIL: rate exceeded\n");
+        failures++;
+    }
+    if (stats.deferred == 0u || stats.granted == 0u)
+    {
+        printf("FAIL: no test deferred\n");
+        failures++;
+    }
+    return failures;
+}
+
+static int check_configure(void)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+
+    /* Single-core build: CPU 1 does not exist */
+    STL_throttle_configure(1, STEP_BYTES, WINDOW_CYCLES, &err);
+    if (err != STL_CPU_OUT_OF_BOUNDS)
+    {
+        printf("FAIL: invalid CPU accepted\n");
+        failures++;
+    }
+    STL_throttle_configure(0, STEP_BYTES, 0u, &err);
+    if (err != STL_INDEX_OUT_OF_BOUNDS)
+    {
+        printf("FAIL: empty window accepted\n");
+        failures++;
+    }
+    return failures;
+}
+
+/* Random cyclic permutation: each load depends on the previous one */
+static size_t *make_chain(size_t n)
+{
+    size_t *chain = malloc(n * sizeof(size_t));
+    size_t *order = malloc(n * sizeof(size_t));
+    size_t i, j, t;
+    unsigned seed = 1u;
+
+    for (i = 0; i < n; i++)
+    {
+        order[i] = i;
+    }
+    for (i = n - 1; i > 0; i--)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        j = seed % (i + 1);
+        t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+    for (i = 0; i < n; i++)
+    {
+        chain[order[i]] = order[(i + 1) % n];
+    }
+    free(order);
+    return chain;
+}
+
+static void *stl_thread(void *arg)
+{
+    STL_ERROR_T err;
+
+    (void)arg;
+    while (!stop)
+    {
+        STL_schedule_runtime(0, &err);
+    }
+    return NULL;
+}
+
+static int cmp_ll(const void *a, const void *b)
+{
+    long long x = *(const long long *)a, y = *(const long long *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void bench(const size_t *chain, long long *samples, STL_INT32U_T bytes_per_window, int with_stl)
+{
+    STL_THROTTLE_STATS_T before, after;
+    pthread_t thread;
+    STL_ERROR_T err;
+    long long start, t0, t1, s;
+    size_t p = 0, n = 0, k;
+
+    STL_throttle_configure(0, bytes_per_window, WINDOW_CYCLES, &err);
+    STL_throttle_get_stats(0, &before, &err);
+    stop = 0;
+    if (with_stl)
+    {
+        pthread_create(&thread, NULL, stl_thread, NULL);
+    }
+    start = now_ns();
+    t0 = start;
+    while (n < PROBE_SAMPLES && t0 - start < BENCH_NS)
+    {
+        for (k = 0; k < PROBE_BATCH; k++)
+        {
+            p = chain[p];
+        }
+        t1 = now_ns();
+        samples[n++] = t1 - t0;
+        t0 = t1;
+    }
+    stop = 1;
+    if (with_stl)
+    {
+        pthread_join(thread, NULL);
+    }
+    sink = p;
+    s = t0 - start;
+    STL_throttle_get_stats(0, &after, &err);
+    qsort(samples, n, sizeof(samples[0]), cmp_ll);
+
+    if (!with_stl)
+    {
+        printf("%-24s", "probe alone");
+    }
+    else if (bytes_per_window == 0u)
+    {
+        printf("%-24s", "STL unthrottled");
+    }
+    else
+    {
+        printf("STL %7u B/%u cyc ", (unsigned)bytes_per_window, (unsigned)WINDOW_CYCLES);
+    }
+    printf(" STL %8.1f MB/s  probe p50 %6.1f ns/load  p99 %7.1f ns/load (%zu batches)\n",
+           (double)(after.granted_bytes - before.granted_bytes) * 1e3 / (double)s,
+           (double)samples[n / 2] / PROBE_BATCH, (double)samples[n * 99 / 100] / PROBE_BATCH, n);
+}
+
+int main(void)
+{
+    static const STL_INT32U_T rates[] = {0u, 4u * STEP_BYTES, STEP_BYTES, STEP_BYTES / 4u};
+    uint8_t *buffer = aligned_alloc(STL_MARCH_ALIGN, BUFFER_BYTES);
+    size_t *chain;
+    long long *samples;
+    STL_ERROR_T err;
+    unsigned i;
+    int failures = 0;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+    memset(buffer, 0x5A, BUFFER_BYTES);
+    regions[0].start = buffer;
+    regions[0].size = BUFFER_BYTES;
+    STL_march_init(regions, 1u, &err);
+    SBST_RT[MARCH_TEST] = STL_march_test;
+
+    failures += check_rate();
+    failures += check_configure();
+
+    chain = make_chain(PROBE_BYTES / sizeof(size_t));
+    samples = malloc(PROBE_SAMPLES * sizeof(samples[0]));
+    bench(chain, samples, 0u, 0);
+    for (i = 0; i < sizeof(rates) / sizeof(rates[0]); i++)
+    {
+        bench(chain, samples, rates[i], 1);
+    }
+    free(samples);
+    free(chain);
+    free(buffer);
+
+    STL_deinit(&err);
+    return failures;
+}
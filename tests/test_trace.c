@@ -0,0 +1,203 @@
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "stl.h"
+#include "stl_sbst_cfg.h"
+#include "stl_trace.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * Binary trace on the host (built with STL_USE_TRACE=1 and STL_TOT_RT_ROUTINE=2).
+ * - every dispatch records start, stop and verdict, in order, with the signature and
+ *   increasing timestamps; test 1 fails and its verdict says so;
+ * - a ring that overflows keeps the oldest records and reports the dropped ones;
+ * - a sink that refuses the records leaves them in the ring;
+ * - the cost of a record is reported. With an argument, the trace is also written to
+ *   that file (input for scripts/stl_trace_decode.py).
+ */
+
+#define ROUNDS 10u
+#define RECORDS_PER_DISPATCH 3u
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
+
+static STL_TRACE_RECORD_T stream[4u * STL_TRACE_RECORDS];
+
+static STL_SIGNATURE_T sbst_pass(void)
+{
+    return 0x600d;
+}
+
+static STL_SIGNATURE_T sbst_fail(void)
+{
+    return STL_SIGNATURE_MISMATCH;
+}
+
+static STL_BOOL sink_refuse(void *ctx, const void *data, STL_INT32U_T size)
+{
+    (void)ctx;
+    (void)data;
+    (void)size;
+    return STL_FALSE;
+}
+
+static STL_INT32U_T drain(STL_TRACE_MEMORY_T *memory)
+{
+    STL_TRACE_SINK_T sink = {STL_trace_sink_memory, memory};
+    STL_ERROR_T err;
+
+    memory->buffer = (uint8_t *)stream;
+    memory->size = sizeof(stream);
+    memory->used = 0u;
+    return STL_trace_drain(0, &sink, &err);
+}
+
+static int check_sequence(void)
+{
+    STL_TRACE_MEMORY_T memory;
+    STL_ERROR_T err;
+    STL_INT32U_T n;
+    unsigned round;
+    unsigned i;
+
+    for (round = 0; round < ROUNDS; round++)
+    {
+        STL_schedule_runtime(0, &err);
+    }
+    n = drain(&memory);
+    if (n != ROUNDS * STL_TOT_RT_ROUTINE * RECORDS_PER_DISPATCH ||
+        memory.used != (n + 1u) * sizeof(STL_TRACE_RECORD_T) || stream[0].event != STL_TRACE_EV_BLOCK ||
+        stream[0].data != 0u)
+    {
+        printf("FAIL: %u records drained\n", (unsigned)n);
+        return 1;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        const STL_TRACE_RECORD_T *r = &stream[1u + i];
+        unsigned test = (i / RECORDS_PER_DISPATCH) % STL_TOT_RT_ROUTINE;
+        static const uint8_t expected[RECORDS_PER_DISPATCH] = {STL_TRACE_EV_TEST_START, STL_TRACE_EV_TEST_STOP,
+                                                               STL_TRACE_EV_VERDICT};
+
+        if (r->event != expected[i % RECORDS_PER_DISPATCH] || r->index != test || (i > 0u && r->delta == 0u))
+        {
+            printf("FAIL: record %u: event %u test %u delta %u\n", i, r->event, r->index, (unsigned)r->delta);
+            return 1;
+        }
+        if (r->event == STL_TRACE_EV_VERDICT &&
+            (r->arg != (test == 0u ? STL_VERDICT_PASS : STL_VERDICT_FAIL) ||
+             r->data != (STL_INT32U_T)(test == 0u ? 0x600d : STL_SIGNATURE_MISMATCH)))
+        {
+            printf("FAIL: verdict of test %u: %u 0x%08x\n", test, r->arg, (unsigned)r->data);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int check_overflow(void)
+{
+    STL_TRACE_MEMORY_T memory;
+    STL_ERROR_T err;
+    STL_INT32U_T emitted = 0u;
+    STL_INT32U_T n;
+
+    while (emitted < 2u * STL_TRACE_RECORDS)
+    {
+        STL_schedule_runtime(0, &err);
+        emitted += STL_TOT_RT_ROUTINE * RECORDS_PER_DISPATCH;
+    }
+    n = drain(&memory);
+    if (n != STL_TRACE_RECORDS || n + stream[0].data != emitted || stream[1].event != STL_TRACE_EV_TEST_START)
+    {
+        printf("FAIL: overflow: %u drained, %u dropped, %u emitted\n", (unsigned)n, (unsigned)stream[0].data,
+               (unsigned)emitted);
+        return 1;
+    }
+    return 0;
+}
+
+static int check_refused(void)
+{
+    STL_TRACE_SINK_T refuse = {sink_refuse, STL_NULL};
+    STL_TRACE_MEMORY_T memory;
+    STL_ERROR_T err;
+
+    STL_schedule_runtime(0, &err);
+    if (STL_trace_drain(0, &refuse, &err) != 0u || err != STL_ERROR_TRACE ||
+        drain(&memory) != STL_TOT_RT_ROUTINE * RECORDS_PER_DISPATCH)
+    {
+        printf("FAIL: refused records lost\n");
+        return 1;
+    }
+    return 0;
+}
+
+static void report_cost(void)
+{
+    STL_TRACE_MEMORY_T memory;
+    STL_CYCLES_T start;
+    STL_CYCLES_T cycles;
+    unsigned i;
+
+    drain(&memory);
+    start = STL_TSSP_CPU_get_cycles();
+    for (i = 0; i < STL_TRACE_RECORDS; i++)
+    {
+        STL_TRACE(0, STL_TRACE_EV_TEST_START, i, STL_TRACE_RUNTIME, 0u);
+    }
+    cycles = STL_TSSP_CPU_get_cycles() - start;
+    drain(&memory);
+    printf("%llu cycles per record\n", (unsigned long long)(cycles / STL_TRACE_RECORDS));
+}
+
+static int write_file(const char *path)
+{
+    STL_ERROR_T err;
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    STL_TRACE_SINK_T sink = {STL_trace_sink_fd, &fd};
+    unsigned round;
+
+    if (fd < 0)
+    {
+        return 1;
+    }
+    for (round = 0; round < ROUNDS; round++)
+    {
+        STL_schedule_runtime(0, &err);
+        STL_trace_drain(0, &sink, &err);
+    }
+    close(fd);
+    return err != STL_ERROR_NONE;
+}
+
+int main(int argc, char **argv)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+    STL_trace_init(&err);
+    SBST_RT[0] = sbst_pass;
+    SBST_RT[1] = sbst_fail;
+
+    failures += check_sequence();
+    failures += check_overflow();
+    failures += check_refused();
+    report_cost();
+    if (argc > 1)
+    {
+        failures += write_file(argv[1]);
+    }
+
+    STL_deinit(&err);
+    return failures;
+}
@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <time.h>
+
+#include "stl.h"
+#include "stl_al_cpu.h"
+#include "stl_error_management.h"
+#include "stl_sbst_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * Vector-unit SBSTs (built with STL_USE_ISA_DISPATCH=1).
+ * - every variant the CPU supports matches its golden signature;
+ * - the widest variant of each vector test is selected, and a scheduled run passes all tests;
+ * - a full check of the vector units (one run of each selected vector test) takes microseconds.
+ * The cost of a full check is reported.
+ */
+
+#define FIRST_VECTOR (STL_TOT_RT_ROUTINE - STL_TOT_VECTOR_ROUTINE)
+#define RUNS 10000u
+#define MAX_CHECK_NS 100000.0
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
+
+typedef struct
+{
+    const char *name;
+    STL_FUNCT_PTR_T avx2;
+    STL_FUNCT_PTR_T avx512;
+    STL_ISA_FEATURES_T avx2_features;
+} VECTOR_TEST_T;
+
+static const VECTOR_TEST_T vector_tests[STL_TOT_VECTOR_ROUTINE] = {
+    {"add", sbst_vec_add_avx2, sbst_vec_add_avx512, STL_CPU_ISA_AVX2},
+    {"mul", sbst_vec_mul_avx2, sbst_vec_mul_avx512, STL_CPU_ISA_AVX2},
+    {"permute", sbst_vec_permute_avx2, sbst_vec_permute_avx512, STL_CPU_ISA_AVX2},
+    {"compare", sbst_vec_compare_avx2, sbst_vec_compare_avx512, STL_CPU_ISA_AVX2},
+    {"fma", sbst_vec_fma_avx2, sbst_vec_fma_avx512, STL_CPU_ISA_AVX2 | STL_CPU_ISA_FMA},
+};
+
+static int supports(STL_ISA_FEATURES_T features)
+{
+    return (features & ~STL_get_isa_features()) == 0u;
+}
+
+static int check_variants(void)
+{
+    int failures = 0;
+    unsigned i;
+
+    for (i = 0; i < STL_TOT_VECTOR_ROUTINE; i++)
+    {
+        if (supports(vector_tests[i].avx2_features) && vector_tests[i].avx2() == STL_SIGNATURE_MISMATCH)
+        {
+            printf("FAIL: %s: AVX2 variant does not match its golden signature\n", vector_tests[i].name);
+            failures++;
+        }
+        if (supports(STL_CPU_ISA_AVX512) && vector_tests[i].avx512() == STL_SIGNATURE_MISMATCH)
+        {
+            printf("FAIL: %s: AVX-512 variant does not match its golden signature\n", vector_tests[i].name);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+static int check_selection(void)
+{
+    STL_FUNCT_PTR_T expected;
+    unsigned i;
+
+    for (i = 0; i < STL_TOT_VECTOR_ROUTINE; i++)
+    {
+        expected = supports(STL_CPU_ISA_AVX512) ? vector_tests[i].avx512
+                   : supports(vector_tests[i].avx2_features) ? vector_tests[i].avx2
+                                                             : STL_NULL;
+        if (expected != STL_NULL && SBST_RT[FIRST_VECTOR + i] != expected)
+        {
+            printf("FAIL: %s: the widest supported variant is not selected\n", vector_tests[i].name);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int check_run(void)
+{
+    STL_VERDICT_T verdict;
+    STL_VERDICT_T expected;
+    STL_ERROR_T err;
+    unsigned i;
+
+    STL_schedule_runtime(0, &err);
+    for (i = 0; i < STL_TOT_RT_ROUTINE; i++)
+    {
+        verdict = STL_em_rt_get_verdict(0, i, &err);
+        expected = STL_VERDICT_PASS;
+        if (i >= FIRST_VECTOR && !supports(vector_tests[i - FIRST_VECTOR].avx2_features))
+        {
+            expected = STL_VERDICT_NOT_RUN;
+        }
+        if (verdict != expected)
+        {
+            printf("FAIL: test %u verdict %d, expected %d\n", i, (int)verdict, (int)expected);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int check_cost(void)
+{
+    struct timespec start, end;
+    double ns;
+    unsigned run, i;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (run = 0; run < RUNS; run++)
+    {
+        for (i = FIRST_VECTOR; i < STL_TOT_RT_ROUTINE; i++)
+        {
+            (void)SBST_RT[i]();
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    ns = ((double)(end.tv_sec - start.tv_sec) * 1e9 + (double)(end.tv_nsec - start.tv_nsec)) / RUNS;
+    printf("full vector-unit check: %.0f ns\n", ns);
+    if (ns > MAX_CHECK_NS)
+    {
+        printf("FAIL: full vector-unit check takes %.0f ns\n", ns);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+    printf("ISA extensions: 0x%x\n", (unsigned)STL_get_isa_features());
+
+    failures += check_variants();
+    failures += check_selection();
+    failures += check_run();
+    failures += check_cost();
+
+    STL_deinit(&err);
+    return failures;
+}
@@ -0,0 +1,224 @@
+#include <setjmp.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include <time.h>
+
+#include "stl.h"
+#include "stl_sbst_cfg.h"
+#include "stl_tssp.h"
+#include "stl_types.h"
+
+/*
+ * Fine-grained watchdog on the host stand-in (timerfd).
+ * - a watchdog that cannot be set up (no file descriptor left) is reported by the scheduler,
+ *   the test is not run, and the setup is made again at the next initialization;
+ * - the scheduler arms the watchdog with the timeout of each test and stops it afterward;
+ * - a test running longer than its window is bitten, a shorter one is not;
+ * - the bite arrives after the window and within a bounded latency;
+ * - a window stopped around its expiration never bites the long window started next;
+ * - the cost of arming/servicing the watchdog at the test boundaries is reported.
+ */
+
+#define WINDOW_SLACK_US 2000 /* Accepted detection latency on a loaded host */
+#define SERVICE_LOOPS 1000
+#define BOUNDARY_LOOPS 2000
+#define BOUNDARY_WINDOW_US 20	  /* Window stopped around its expiration */
+#define BOUNDARY_NEXT_US 10000 /* Window started next, never expiring */
+
+EXTERN_KEYWORD STL_FUNCT_PTR_T SBST_RT[STL_TOT_RT_ROUTINE];
+
+static sigjmp_buf bite_env;
+static volatile int bites;
+static volatile long spin_us;
+
+static long now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000L + ts.tv_nsec / 1000L;
+}
+
+/* Overrides the weak reset model: count the bite and abort the spinning test */
+void STL_TSSP_CSP_watchdog_bite(void)
+{
+    bites++;
+    siglongjmp(bite_env, 1);
+}
+
+static STL_SIGNATURE_T sbst_spin(void)
+{
+    long start;
+
+    if (sigsetjmp(bite_env, 1) != 0)
+    {
+        return STL_SIGNATURE_MISMATCH;
+    }
+    start = now_us();
+    while (now_us() - start < spin_us)
+    {
+    }
+    return 0x5a5a5a5a;
+}
+
+static int check_setup(void)
+{
+    struct rlimit saved;
+    struct rlimit no_files = {0, 0};
+    STL_ERROR_T err;
+    int failures = 0;
+
+    SBST_RT[0] = sbst_spin;
+    spin_us = 100;
+    getrlimit(RLIMIT_NOFILE, &saved);
+    no_files.rlim_max = saved.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &no_files);
+    STL_schedule_runtime(0, &err);
+    setrlimit(RLIMIT_NOFILE, &saved);
+    if (err != STL_ERROR_TASK_ALLOCATION || STL_em_rt_get_verdict(0, 0, &err) != STL_VERDICT_NOT_RUN)
+    {
+        printf("FAIL: watchdog setup failure not reported\n");
+        failures++;
+    }
+    STL_TSSP_CSP_watchdog_init(1000, 0, &err);
+    if (err != STL_ERROR_NONE)
+    {
+        printf("FAIL: watchdog setup not made again (error %d)\n", (int)err);
+        failures++;
+    }
+    return failures;
+}
+
+static int check_scheduler(void)
+{
+    STL_ERROR_T err;
+    int failures = 0;
+
+    SBST_RT[0] = sbst_spin;
+
+    /* Shorter than the window of the test: no bite */
+    bites = 0;
+    spin_us = 100;
+    STL_schedule_runtime(0, &err);
+    if (err != STL_ERROR_NONE || bites != 0 || STL_em_rt_get_verdict(0, 0, &err) != STL_VERDICT_PASS)
+    {
+        printf("FAIL: test within its window has been bitten\n");
+        failures++;
+    }
+
+    /* Longer than the window of the test: bitten */
+    bites = 0;
+    spin_us = 20000;
+    STL_schedule_runtime(0, &err);
+    if (err != STL_ERROR_NONE || bites != 1 || STL_em_rt_get_verdict(0, 0, &err) != STL_VERDICT_FAIL)
+    {
+        printf("FAIL: runaway test has not been bitten\n");
+        failures++;
+    }
+    return failures;
+}
+
+static int check_window(int32_t window_us)
+{
+    STL_ERROR_T err;
+    long start;
+    long latency;
+
+    bites = 0;
+    spin_us = window_us * 4L + WINDOW_SLACK_US;
+    STL_TSSP_CSP_watchdog_init(window_us, 0, &err);
+    start = now_us();
+    STL_TSSP_CSP_watchdog_start();
+    (void)sbst_spin();
+    latency = now_us() - start - window_us;
+    STL_TSSP_CSP_watchdog_stop();
+
+    printf("window %6d us: bites %d, detection latency %6ld us\n", (int)window_us, bites, latency);
+    if (bites != 1 || latency < 0 || latency > WINDOW_SLACK_US)
+    {
+        printf("FAIL: window %d us not enforced\n", (int)window_us);
+        return 1;
+    }
+    return 0;
+}
+
+static int check_boundary(void)
+{
+    STL_ERROR_T err;
+    int window_bites = 0;
+    int late_bites = 0;
+    int before;
+    int i;
+
+    bites = 0;
+    for (i = 0; i < BOUNDARY_LOOPS; i++)
+    {
+        STL_TSSP_CSP_watchdog_init(BOUNDARY_WINDOW_US, 0, &err);
+        spin_us = i % (2 * BOUNDARY_WINDOW_US);
+        STL_TSSP_CSP_watchdog_start();
+        (void)sbst_spin();
+        STL_TSSP_CSP_watchdog_stop();
+        window_bites = bites;
+
+        STL_TSSP_CSP_watchdog_init(BOUNDARY_NEXT_US, 0, &err);
+        spin_us = 2 * BOUNDARY_WINDOW_US;
+        before = bites;
+        STL_TSSP_CSP_watchdog_start();
+        (void)sbst_spin();
+        STL_TSSP_CSP_watchdog_stop();
+        late_bites += bites - before;
+        bites = window_bites;
+    }
+    printf("windows stopped around the expiration: %d bitten, %d late bites\n", window_bites, late_bites);
+    if (late_bites != 0)
+    {
+        printf("FAIL: expiration of a stopped window bit the next one\n");
+        return 1;
+    }
+    return 0;
+}
+
+static void bench_service(void)
+{
+    STL_ERROR_T err;
+    STL_CYCLES_T start;
+    STL_CYCLES_T cycles;
+    int i;
+
+    STL_TSSP_CSP_watchdog_init(1000, 0, &err);
+    start = STL_TSSP_CPU_get_cycles();
+    for (i = 0; i < SERVICE_LOOPS; i++)
+    {
+        STL_TSSP_CSP_watchdog_init(1000, 0, &err);
+        STL_TSSP_CSP_watchdog_start();
+        STL_TSSP_CSP_watchdog_stop();
+    }
+    cycles = STL_TSSP_CPU_get_cycles() - start;
+    printf("arm + stop per test: %llu cycles\n", (unsigned long long)(cycles / SERVICE_LOOPS));
+}
+
+int main(void)
+{
+    static const int32_t windows[] = {50, 100, 200, 500, 1000, 5000};
+    STL_ERROR_T err;
+    int failures = 0;
+    unsigned i;
+
+    STL_init(&err);
+    if (err != STL_ERROR_NONE)
+    {
+        return -1;
+    }
+
+    failures += check_setup();
+    failures += check_scheduler();
+    for (i = 0; i < sizeof(windows) / sizeof(windows[0]); i++)
+    {
+        failures += check_window(windows[i]);
+    }
+    failures += check_boundary();
+    bench_service();
+
+    STL_deinit(&err);
+    return failures;
+}